@@ -0,0 +1,2 @@
+// Arduino compiles only the sketch folder; the source lives in communication/
+#include "communication/Alert_Ack.cpp"
@@ -0,0 +1,2 @@
+// Arduino compiles only the sketch folder; the source lives in sensors/
+#include "sensors/Altitude_Filter.cpp"
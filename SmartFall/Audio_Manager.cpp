@@ -0,0 +1,2 @@
+// Arduino compiles only the sketch folder; the source lives in audio/
+#include "audio/Audio_Manager.cpp"
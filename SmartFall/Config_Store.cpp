@@ -0,0 +1,2 @@
+// Arduino compiles only the sketch folder; the source lives in storage/
+#include "storage/Config_Store.cpp"
@@ -0,0 +1,2 @@
+// Arduino compiles only the sketch folder; the source lives in system/
+#include "system/Rate_Scheduler.cpp"
@@ -14,24 +14,54 @@
 #include "sensors/BMP280_Sensor.h"
 #include "sensors/MAX30102_Sensor.h"
 #include "sensors/FSR_Sensor.h"
+#include "sensors/Hardware_Source.h"
+#include "sensors/Sensor_Supervisor.h"
+#include "sensors/Synthetic_Source.h"
+#include "sensors/Altitude_Filter.h"
 #include "detection/fall_detector.h"
 #include "detection/confidence_scorer.h"
+#include "detection/fall_classifier.h"
 #include "communication/WiFi_Manager.h"
 #include "communication/BLE_Server.h"
 #include "communication/Emergency_Comms.h"
 #include "audio/Audio_Manager.h"
+#include "diagnostics/System_Metrics.h"
+#include "diagnostics/Profiler.h"
+#include "diagnostics/Deferred_Log.h"
+#include "system/Rate_Scheduler.h"
+#include "system/Task_Watchdog.h"
+#include "system/Boot_Manager.h"
+#include "system/Event_Bus.h"
+#include "system/Alert_Sequencer.h"
+#include "storage/Data_Logger.h"
+#include "storage/Config_Store.h"
 #include "utils/config.h"
 #include "utils/data_types.h"
 
-// Sensor instances
+// Sensor instances (MPU6050, BMP280 and MAX30102 share one I2C bus)
+Wire_Bus i2cBus(MPU6050_SDA_PIN, MPU6050_SCL_PIN);
 MPU6050_Sensor imuSensor;
 BMP280_Sensor pressureSensor;
 MAX30102_Sensor heartRateSensor;
 FSR_Sensor forceSensor(FSR_ANALOG_PIN);
 
+// Where sensorTask gets its samples (SENSOR_SOURCE in config.h)
+#if SENSOR_SOURCE == SENSOR_SOURCE_SYNTHETIC
+Synthetic_Source sensorSource;
+#else
+Hardware_Source sensorSource(&imuSensor, &pressureSensor, &heartRateSensor, &forceSensor, &i2cBus);
+
+// Re-inits sensors that fail or drop off the bus, in the background
+Sensor_Supervisor sensorSupervisor(&i2cBus);
+#endif
+
+// Altitude lost in an event, against the pressure just before it
+Altitude_Filter altitudeFilter;
+
 // Detection system
 FallDetector fallDetector;
 ConfidenceScorer confidenceScorer;
+FallClassifier fallClassifier;
 
 // Communication system
 WiFi_Manager wifiManager;
@@ -41,11 +71,82 @@ Emergency_Comms emergencyComms(&wifiManager, &bleServer);
 // Audio system
 Audio_Manager audioManager(SPEAKER_PIN);
 
+// Heap/stack telemetry
+System_Metrics systemMetrics;
+
+// Raw sensor trace recorder (spiffs partition ring)
+Partition_Storage logStorage;
+Data_Logger dataLogger(&logStorage);
+
+// Runtime configuration (NVS, written over BLE)
+NVS_Config_Storage configStorage;
+Config_Store configStore(&configStorage);
+
+// Fixed-rate scheduler (base tick = sensor period)
+Rate_Scheduler scheduler(SENSOR_READ_INTERVAL_MS * 1000UL);
+
+// Deadline supervision (ids are taskWatchdog indexes, added in this order)
+enum {
+  WATCH_ACQUISITION,
+  WATCH_DETECTION,
+  WATCH_COMMS,
+  WATCH_AUDIO
+};
+Task_Watchdog taskWatchdog;
+
+// Blocking network work (reconnect, status POST) runs here, off the sensor loop
+TaskHandle_t commsTask = nullptr;
+SystemStatus_t publishedStatus;         // statusTask's copy for the comms task, under statusMux
+bool statusPending = false;
+portMUX_TYPE statusMux = portMUX_INITIALIZER_UNLOCKED;
+volatile bool commsCancelled = false;   // Set by restartComms(); the task exits between steps
+volatile bool commsExited = false;
+
+// Every blocking step between comms checkpoints ends before the watchdog
+// restarts the task. A TLS open may take the connect timeout for TCP and
+// again for the handshake.
+static_assert(1000 + WIFI_TIMEOUT_MS < COMMS_RESTART_MS, "WiFi reconnect outlasts COMMS_RESTART_MS");
+static_assert(2 * HTTP_CONNECT_TIMEOUT_MS + HTTP_HEARTBEAT_TIMEOUT_MS < COMMS_RESTART_MS,
+              "Alert socket warm-up or heartbeat outlasts COMMS_RESTART_MS");
+static_assert(WIFI_LOCK_WAIT_MS + 2 * HTTP_CONNECT_TIMEOUT_MS + HTTP_STATUS_TIMEOUT_MS +
+              BLE_STATUS_LOCK_MS < COMMS_RESTART_MS, "Status update outlasts COMMS_RESTART_MS");
+
+// Boot sequence (step ids double as dependency bits)
+enum {
+  BOOT_CONFIG,
+  BOOT_IMU,
+  BOOT_DETECTOR,
+  BOOT_ALERTS,
+  BOOT_AUDIO,
+  BOOT_PRESSURE,
+  BOOT_HEART,
+  BOOT_FORCE,
+  BOOT_LOGGER,
+  BOOT_WIFI,
+  BOOT_BLE,
+  BOOT_READY
+};
+Boot_Manager bootManager;
+
+// Event bus: producers (detector, SOS interrupt, BLE callbacks) publish and
+// return; alerts and logging react in the events group, audio on its own task
+Event_Bus eventBus;
+int8_t alertSubscriber = -1;
+int8_t audioSubscriber = -1;
+int8_t logSubscriber = -1;
+TaskHandle_t audioTask = nullptr;
+volatile uint32_t lastSOSEdge = 0;
+
+// Alert sequence (alarm, prompt, countdown, escalate), ticked in the events group
+Alert_Sequencer alertSequencer(&eventBus);
+EmergencyData_t alertData;      // Captured when the sequence starts
+bool alertInFlight = false;     // Transmitted, outcome not yet announced
+bool testAlertActive = false;
+uint32_t testAlertStart = 0;
+
 // System state
 SensorData_t currentSensorData;
 SystemStatus_t systemStatus;
-uint32_t lastSensorRead = 0;
-uint32_t lastStatusUpdate = 0;
 bool systemInitialized = false;
 bool alertActive = false;
 
@@ -53,9 +154,8 @@ bool alertActive = false;
 char deviceID[32];
 
 void setup() {
-  // Initialize serial communication
+  // Initialize serial communication (no wait: boot must not stall on a monitor)
   Serial.begin(SERIAL_BAUD_RATE);
-  delay(2000);  // Wait for serial monitor
 
   Serial.println("\n========================================");
   Serial.println("      SmartFall Detection System");
@@ -65,118 +165,298 @@ void setup() {
   // Generate device ID from MAC address
   generateDeviceID();
 
-  // Initialize SOS button
-  pinMode(SOS_BUTTON_PIN, INPUT_PULLUP);
+  // Start heap/stack telemetry before subsystems allocate
+  systemMetrics.begin();
+  Profiler::begin();
 
-  // Initialize haptic and visual alert outputs
-  pinMode(HAPTIC_PIN, OUTPUT);
-  pinMode(VISUAL_ALERT_PIN, OUTPUT);
+  // Hot-path debug lines go through the ring from here on
+  Deferred_Log::begin();
+  systemMetrics.registerTask("dlog", Deferred_Log::getTaskHandle());
 
-  digitalWrite(HAPTIC_PIN, LOW);
-  digitalWrite(VISUAL_ALERT_PIN, LOW);
+  // Subscribers exist before the first producer runs
+  subscribeEvents();
+
+  // Boot graph: fall detection first, everything else in the background
+  defineBootSteps();
+  if (!bootManager.validate()) {
+    Serial.println("ERROR: Invalid boot sequence!");
+  }
+  bootManager.runInline();
 
-  // Initialize audio system
-  Serial.println("--- Initializing Audio System ---");
-  if (audioManager.begin()) {
-    audioManager.setVolume(AUDIO_DEFAULT_VOLUME);
-    Serial.println("✓ PAM8302 amplifier initialized");
+  systemInitialized = true;
+  Serial.println("Monitoring for falls...\n");
 
-    // Play startup melody
-    audioManager.playStartupMelody();
-    delay(500);
-  } else {
-    Serial.println("ERROR: Failed to initialize audio!");
+  // Start fixed-rate scheduling before the slow subsystems come up
+  scheduler.addGroup("sensor", SENSOR_READ_INTERVAL_MS, sensorTask);
+  scheduler.addGroup("service", COMMS_INTERVAL_MS, serviceTask);
+  scheduler.addGroup("status", STATUS_UPDATE_INTERVAL_MS, statusTask);
+  scheduler.addGroup("bulk", BULK_SERVICE_INTERVAL_MS, bulkTask);
+  scheduler.addGroup("events", EVENT_SERVICE_INTERVAL_MS, eventTask);
+  if (!scheduler.begin()) {
+    Serial.println("ERROR: Failed to start scheduler!");
   }
+  bootManager.markMonitoring();
 
-  // Initialize sensors
-  Serial.println("\n--- Initializing Sensors ---");
-  initializeSensors();
+  // Deadlines start with the first sensor tick; comms waits for the WiFi boot step
+  defineWatchdog();
+  startComms();
 
-  // Initialize communication modules
-  Serial.println("\n--- Initializing Communication ---");
-  initializeCommunication();
+  if (!bootManager.startBackground()) {
+    Serial.println("ERROR: Failed to start boot workers!");
+  }
+}
 
-  // Initialize fall detector
-  if (fallDetector.init()) {
-    Serial.println("✓ Fall detector initialized");
-    fallDetector.enableMonitoring();
-  } else {
-    Serial.println("ERROR: Failed to initialize fall detector!");
+void loop() {
+  // Block until the next timer tick, then run every rate group that is due
+  scheduler.waitForTick();
+  scheduler.runPending();
+}
+
+void sensorTask() {
+  PROFILE_PERIOD(PROFILE_PERIOD_SENSOR);
+  PROFILE_SCOPE(PROFILE_SENSOR_CYCLE);
+
+  // Read all sensors
+  {
+    PROFILE_SCOPE(PROFILE_READ_SENSORS);
+    readSensors();
   }
+  taskWatchdog.checkIn(WATCH_ACQUISITION, millis());
 
-  // Initialize system status
-  updateSystemStatus();
+#if SENSOR_SOURCE == SENSOR_SOURCE_HARDWARE
+  // Score with the sensors that are delivering
+  confidenceScorer.setSensorAvailability(sensorSource.getAvailable());
+#endif
 
-  systemInitialized = true;
-  Serial.println("\n========================================");
-  Serial.println("       SmartFall Ready!");
-  Serial.println("========================================");
-  Serial.println("Monitoring for falls...\n");
+  // Record raw trace (RAM only, flushed by the logger task)
+  dataLogger.log(currentSensorData);
 
-  // Play system ready voice alert
-  if (AUDIO_ENABLE_VOICE_ALERTS) {
-    audioManager.playVoiceAlert(VOICE_ALERT_SYSTEM_READY);
+  // Process sensor data through fall detector
+  {
+    PROFILE_SCOPE(PROFILE_PROCESS_DATA);
+    fallDetector.processSensorData(currentSensorData);
   }
 
-  // Print connection info
-  printSystemInfo();
+  // Movement during the response window stands the alert down
+  alertSequencer.addMotion(currentSensorData);
+
+  // Check fall status
+  FallStatus_t status = fallDetector.getCurrentStatus();
+
+  // Score the drop height once the detector completes a potential fall
+  altitudeFilter.update(currentSensorData);
+  if (altitudeFilter.observe(status)) {
+    confidenceScorer.addPressureFilterScore(altitudeFilter.getAltitudeChange());
+  }
+
+  // Classify the impact window once the post-impact samples are in
+  if (FALL_CLASSIFIER_ENABLED && fallClassifier.observe(status)) {
+    PROFILE_SCOPE(PROFILE_CLASSIFIER);
+    static SensorData_t window[FALL_CLASSIFIER_WINDOW];
+    uint8_t count = fallDetector.copyHistory(window, FALL_CLASSIFIER_WINDOW);
+    confidenceScorer.addClassifierScore(fallClassifier.classify(window, count));
+  }
+
+  if (status == FALL_STATUS_FALL_DETECTED && !alertActive) {
+    alertActive = true;
+    eventBus.publish(EVENT_FALL_DETECTED, confidenceScorer.getTotalScore());
+  }
+  taskWatchdog.checkIn(WATCH_DETECTION, millis());
+
+  // Stream sensor data via BLE if enabled
+  if (bleServer.shouldStream()) {
+    bleServer.sendSensorData(currentSensorData);
+  }
+
+  // Debug output
+  if (DEBUG_SENSOR_DATA && (currentSensorData.timestamp % 1000 < SENSOR_READ_INTERVAL_MS)) {
+    printSensorData();
+  }
 }
 
-void loop() {
-  uint32_t currentTime = millis();
+void serviceTask() {
+  // Process emergency alert queue (handle retries); hold retries until both
+  // transports have had their first chance to come up
+  if (bootManager.isSettled(BOOT_WIFI) && bootManager.isSettled(BOOT_BLE)) {
+    emergencyComms.processAlertQueue();
+  }
 
-  // Check WiFi connection (auto-reconnect if enabled)
-  wifiManager.checkConnection();
+  // Sample heap/stack telemetry
+  systemMetrics.update();
 
-  // Process emergency alert queue (handle retries)
-  emergencyComms.processAlertQueue();
+  // Apply a pending BLE config write here, between sensor ticks
+  if (configStore.service()) {
+    publishConfig();
+  }
+}
 
-  // Check SOS button
-  if (digitalRead(SOS_BUTTON_PIN) == LOW) {
-    handleSOSButton();
+void defineWatchdog() {
+  taskWatchdog.add("acquisition", ACQUISITION_DEADLINE_MS);
+  taskWatchdog.add("detection", DETECTION_DEADLINE_MS);
+  taskWatchdog.add("comms", COMMS_DEADLINE_MS, COMMS_RESTART_MS, restartComms);
+  taskWatchdog.add("audio", AUDIO_DEADLINE_MS);
+
+  // Both sensor-loop stages feed the TWDT for loop(); nothing restarts it but a reboot
+  TaskHandle_t loopTask = xTaskGetCurrentTaskHandle();
+  taskWatchdog.attach(WATCH_ACQUISITION, loopTask);
+  taskWatchdog.attach(WATCH_DETECTION, loopTask);
+  if (taskWatchdog.begin()) {
+    systemMetrics.registerTask("watchdog", taskWatchdog.getTaskHandle());
   }
+}
 
-  // Read sensors at configured rate
-  if (currentTime - lastSensorRead >= SENSOR_READ_INTERVAL_MS) {
-    lastSensorRead = currentTime;
+bool startComms() {
+  if (xTaskCreate(commsTaskLoop, "comms", COMMS_TASK_STACK, nullptr, COMMS_TASK_PRIORITY,
+                  &commsTask) != pdPASS) {
+    Serial.println("ERROR: Failed to start comms task!");
+    return false;
+  }
+  taskWatchdog.attach(WATCH_COMMS, commsTask);
+  systemMetrics.registerTask("comms", commsTask);
+  return true;
+}
 
-    // Read all sensors
-    readSensors();
+// Watchdog task context: the stuck comms task is replaced, the sensor loop never stops
+bool restartComms() {
+  // Deleted from outside, it could leave the UART, lwIP, WiFi or HTTP locks
+  // held or leak what it allocated. It is asked to exit at its next
+  // checkpoint instead. Every step between checkpoints has a timeout below
+  // COMMS_RESTART_MS (see the static_asserts above), so this is only reached
+  // when one overran it. Only a call hung inside the network stack never
+  // returns; it stops feeding the TWDT, and the device reboots after
+  // TASK_WDT_TIMEOUT_S.
+  if (!commsExited) {
+    commsCancelled = true;
+    xTaskNotifyGive(commsTask);
+    return false;
+  }
 
-    // Process sensor data through fall detector
-    fallDetector.processSensorData(currentSensorData);
+  commsCancelled = false;
+  commsExited = false;
+  if (!startComms()) {
+    commsExited = true;           // Tried again next check
+    return false;
+  }
+  return true;
+}
 
-    // Check fall status
-    FallStatus_t status = fallDetector.getCurrentStatus();
+// Comms task context, between blocking steps: no lock is held here
+void commsCheckpoint() {
+  if (commsCancelled) {
+    taskWatchdog.detach(WATCH_COMMS);
+    commsExited = true;
+    vTaskDelete(nullptr);
+  }
+  taskWatchdog.checkIn(WATCH_COMMS, millis());
+}
 
-    if (status == FALL_STATUS_FALL_DETECTED && !alertActive) {
-      handleFallDetected();
-    }
+// Comms task context: copies the status statusTask last published
+bool takeStatus(SystemStatus_t& status) {
+  portENTER_CRITICAL(&statusMux);
+  bool pending = statusPending;
+  if (pending) {
+    status = publishedStatus;
+    statusPending = false;
+  }
+  portEXIT_CRITICAL(&statusMux);
+  return pending;
+}
 
-    // Stream sensor data via BLE if enabled
-    if (bleServer.shouldStream()) {
-      bleServer.sendSensorData(currentSensorData);
+void commsTaskLoop(void* arg) {
+  static SystemStatus_t status;
+  while (true) {
+    commsCheckpoint();
+
+    // Check WiFi connection (auto-reconnect if enabled, once the boot connect attempt is over)
+    if (bootManager.isSettled(BOOT_WIFI)) {
+      wifiManager.checkConnection();
+      commsCheckpoint();
     }
 
-    // Debug output
-    if (DEBUG_SENSOR_DATA && (currentTime % 1000 == 0)) {
-      printSensorData();
+    if (takeStatus(status)) {
+      emergencyComms.sendStatusUpdate(status);
     }
+
+    // Woken early by a cancel request
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(COMMS_INTERVAL_MS));
   }
+}
 
-  // Send periodic status updates
-  if (currentTime - lastStatusUpdate >= 60000) {  // Every minute
-    lastStatusUpdate = currentTime;
-    updateSystemStatus();
-    emergencyComms.sendStatusUpdate(systemStatus);
+void bulkTask() {
+  // Pump the BLE log download (no-op when idle)
+  bleServer.serviceBulkTransfer();
+}
 
-    // Check battery level
-    if (systemStatus.battery_percentage < 20.0) {
-      audioManager.playVoiceAlert(VOICE_ALERT_LOW_BATTERY);
-    }
+void eventTask() {
+  eventBus.dispatch(alertSubscriber);
+  alertSequencer.service();
+  reportAlertOutcome();
+  serviceTestAlert();
+  if (logSubscriber >= 0) {
+    eventBus.dispatch(logSubscriber);
   }
+}
+
+uint32_t openLogSource() {
+  // Freeze the ring so offsets stay valid across resumes. The logger task
+  // flushes the partial block; the request is retried until it has.
+  dataLogger.requestStop();
+  if (dataLogger.isJobPending()) {
+    return BULK_SOURCE_BUSY;
+  }
+  return dataLogger.getBlockCount() * LOG_BLOCK_SIZE;
+}
 
-  delay(MAIN_LOOP_DELAY_MS);
+bool readLogSource(uint32_t offset, uint8_t* buffer, size_t length) {
+  return dataLogger.readBytes(offset, buffer, length);
+}
+
+void statusTask() {
+  updateSystemStatus(systemStatus);
+
+  // Posted by the comms task, from its own copy
+  portENTER_CRITICAL(&statusMux);
+  publishedStatus = systemStatus;
+  statusPending = true;
+  portEXIT_CRITICAL(&statusMux);
+
+  // Deadline misses since the last report
+  static uint32_t reportedMisses = 0;
+  if (taskWatchdog.getTotalMisses() != reportedMisses) {
+    reportedMisses = taskWatchdog.getTotalMisses();
+    taskWatchdog.printStats();
+  }
+
+  if (PROFILER_ENABLED && DEBUG_PROFILER) {
+    Profiler::printReport();
+    Deferred_Log::printStats();
+    scheduler.printStats();
+    wifiManager.printHTTPStats();
+    eventBus.printStats();
+    alertSequencer.printStats();
+    altitudeFilter.printStats();
+#if SENSOR_SOURCE == SENSOR_SOURCE_HARDWARE
+    imuSensor.printFifoStats();
+    if (imuSensor.isFifoEnabled()) sensorSource.getDecimator().printStats();
+    sensorSupervisor.printStats();
+#endif
+  }
+
+  // Check battery level
+  if (systemStatus.battery_percentage < 20.0) {
+    eventBus.publish(EVENT_LOW_BATTERY, (uint32_t)systemStatus.battery_percentage);
+  }
+}
+
+void subscribeEvents() {
+  alertSubscriber = eventBus.subscribe("alerts", EVENT_BIT(EVENT_FALL_DETECTED) |
+                                       EVENT_BIT(EVENT_SOS_PRESSED) | EVENT_BIT(EVENT_BLE_COMMAND),
+                                       onAlertEvent);
+  audioSubscriber = eventBus.subscribe("audio", EVENT_ALL & ~EVENT_BIT(EVENT_BLE_COMMAND), onAudioEvent);
+  if (DEBUG_EVENTS) {
+    logSubscriber = eventBus.subscribe("log", EVENT_ALL, onLogEvent);
+  }
+  alertSequencer.onAction(onAlertAction);
 }
 
 void generateDeviceID() {
@@ -188,352 +468,683 @@ void generateDeviceID() {
   Serial.println(deviceID);
 }
 
-void initializeSensors() {
-  systemStatus.sensors_initialized = true;
+void defineBootSteps() {
+  // Critical path (setup): config -> IMU -> detector -> alert outputs
+  bootManager.addStep(BOOT_CONFIG, "config", bootConfig, BOOT_INLINE);
+  bootManager.addStep(BOOT_IMU, "imu", bootIMU, BOOT_INLINE);
+  bootManager.addStep(BOOT_DETECTOR, "detector", bootDetector, BOOT_INLINE,
+                      BOOT_BIT(BOOT_CONFIG) | BOOT_BIT(BOOT_IMU));
+  bootManager.addStep(BOOT_ALERTS, "alerts", bootAlerts, BOOT_INLINE);
+
+  // Background workers, independent steps run concurrently
+  bootManager.addStep(BOOT_AUDIO, "audio", bootAudio, BOOT_BACKGROUND, BOOT_BIT(BOOT_CONFIG));
+  bootManager.addStep(BOOT_PRESSURE, "pressure", bootPressure, BOOT_BACKGROUND);
+  bootManager.addStep(BOOT_HEART, "heart", bootHeart, BOOT_BACKGROUND);
+  bootManager.addStep(BOOT_FORCE, "force", bootForce, BOOT_BACKGROUND);
+  bootManager.addStep(BOOT_LOGGER, "logger", bootLogger, BOOT_BACKGROUND);
+  bootManager.addStep(BOOT_WIFI, "wifi", bootWiFi, BOOT_BACKGROUND, BOOT_BIT(BOOT_CONFIG));
+  bootManager.addStep(BOOT_BLE, "ble", bootBLE, BOOT_BACKGROUND,
+                      BOOT_BIT(BOOT_CONFIG) | BOOT_BIT(BOOT_LOGGER));
+  bootManager.addStep(BOOT_READY, "ready", bootReady, BOOT_BACKGROUND,
+                      BOOT_BIT(BOOT_AUDIO) | BOOT_BIT(BOOT_PRESSURE) | BOOT_BIT(BOOT_HEART) |
+                      BOOT_BIT(BOOT_FORCE) | BOOT_BIT(BOOT_WIFI) | BOOT_BIT(BOOT_BLE));
+}
 
-  if (!imuSensor.begin()) {
-    Serial.println("ERROR: Failed to initialize MPU6050!");
-    systemStatus.sensors_initialized = false;
-    audioManager.playErrorTone();
-  } else {
+bool bootConfig() {
+  // Load runtime configuration before subsystems use it
+  bool ok = configStore.begin();
+  configStore.onApply(applyConfig);
+  return ok;
+}
+
+bool bootIMU() {
+#if SENSOR_SOURCE == SENSOR_SOURCE_HARDWARE
+  // Bus timeout and lock before any driver touches Wire
+  if (!i2cBus.begin()) {
+    Serial.println("ERROR: Failed to start I2C bus!");
+  }
+#endif
+  bool ok = startIMU();
+  if (ok) {
     Serial.println("✓ MPU6050 initialized");
-    imuSensor.configure();
+  } else {
+    Serial.println("ERROR: Failed to initialize MPU6050!");
   }
 
-  if (!pressureSensor.begin()) {
-    Serial.println("ERROR: Failed to initialize BMP280!");
-    systemStatus.sensors_initialized = false;
-    audioManager.playErrorTone();
-  } else {
-    Serial.println("✓ BMP280 initialized");
-    pressureSensor.configure();
-    delay(1000);
-    pressureSensor.resetBaselineAltitude();
+  // A sensor that did not come up is retried by the supervisor
+  sensorSource.begin();
+  Serial.print("✓ Sample source: ");
+  Serial.println(sensorSource.getName());
+#if SENSOR_SOURCE == SENSOR_SOURCE_HARDWARE
+  sensorSupervisor.add(&sensorSource.getIMUHealth(), MPU6050_I2CADDR_DEFAULT, startIMU);
+  sensorSupervisor.add(&sensorSource.getPressureHealth(), BMP280_ADDRESS_ALT, startPressure);
+  if (sensorSupervisor.begin()) {
+    systemMetrics.registerTask("health", sensorSupervisor.getTaskHandle());
   }
+#endif
+  return ok;
+}
 
-  if (!heartRateSensor.begin()) {
-    Serial.println("ERROR: Failed to initialize MAX30102!");
-    systemStatus.sensors_initialized = false;
-    audioManager.playErrorTone();
-  } else {
-    Serial.println("✓ MAX30102 initialized");
-    heartRateSensor.configure();
+// Boot and supervisor re-init: the bus may have been reset since
+bool startIMU() {
+  if (!imuSensor.begin()) {
+    return false;
   }
+  imuSensor.configure();
+#if SENSOR_SOURCE == SENSOR_SOURCE_HARDWARE
+  // High-rate profile: peaks at full rate, one decimated sample per tick
+  if (IMU_SAMPLE_RATE_HZ > SENSOR_SAMPLE_RATE_HZ) {
+    if (imuSensor.beginFifo(IMU_SAMPLE_RATE_HZ)) {
+      Serial.print("✓ MPU6050 FIFO at ");
+      Serial.print(IMU_SAMPLE_RATE_HZ);
+      Serial.println(" Hz");
+    } else {
+      Serial.println("✗ MPU6050 FIFO failed; reading registers at the sample rate");
+    }
+  }
+  sensorSource.getDecimator().reset();
+#endif
+  return true;
+}
 
-  if (!forceSensor.begin()) {
-    Serial.println("ERROR: Failed to initialize FSR!");
-    systemStatus.sensors_initialized = false;
-    audioManager.playErrorTone();
-  } else {
-    Serial.println("✓ FSR initialized");
-    forceSensor.calibrate();
+bool bootDetector() {
+  DetectionThresholds_t thresholds = configStore.get().thresholds;
+  fallDetector.setThresholds(thresholds);
+  confidenceScorer.setScoreTiers(configStore.get().score_tiers);
+  if (!fallDetector.init()) {
+    Serial.println("ERROR: Failed to initialize fall detector!");
+    return false;
   }
+  Serial.println("✓ Fall detector initialized");
+  fallDetector.enableMonitoring();
+  return true;
+}
 
-  if (systemStatus.sensors_initialized) {
-    audioManager.playConfirmationTone();
+bool bootAlerts() {
+  // SOS button, haptic and visual outputs
+  pinMode(SOS_BUTTON_PIN, INPUT_PULLUP);
+  attachInterrupt(digitalPinToInterrupt(SOS_BUTTON_PIN), sosInterrupt, FALLING);
+  pinMode(HAPTIC_PIN, OUTPUT);
+  pinMode(VISUAL_ALERT_PIN, OUTPUT);
+  digitalWrite(HAPTIC_PIN, LOW);
+  digitalWrite(VISUAL_ALERT_PIN, LOW);
+
+  // Queues alerts until WiFi/BLE come up
+  if (!emergencyComms.begin()) {
+    return false;
+  }
+  emergencyComms.setMaxRetries(EMERGENCY_MAX_RETRIES);
+  emergencyComms.setRetryInterval(EMERGENCY_RETRY_INTERVAL_MS);
+
+  Alert_Dispatcher& dispatcher = emergencyComms.getDispatcher();
+  for (uint8_t i = 0; i < dispatcher.getTransportCount(); i++) {
+    TaskHandle_t task = dispatcher.getTaskHandle(i);
+    systemMetrics.registerTask(pcTaskGetName(task), task);
   }
+  return true;
 }
 
-void initializeCommunication() {
-  // Initialize WiFi
-  Serial.println("\n[WiFi] Connecting...");
-  if (wifiManager.begin(WIFI_SSID, WIFI_PASSWORD)) {
-    wifiManager.setServerURL(SERVER_URL);
-    wifiManager.enableAutoReconnect(true);
-    Serial.println("✓ WiFi connected");
-    audioManager.playConfirmationTone();
-  } else {
-    Serial.println("✗ WiFi connection failed (will retry automatically)");
-    audioManager.playErrorTone();
+bool bootAudio() {
+  if (!audioManager.begin()) {
+    Serial.println("ERROR: Failed to initialize audio!");
+    return false;
+  }
+  audioManager.setVolume(configStore.get().alert_volume);
+  Serial.println("✓ PAM8302 amplifier initialized");
+  audioManager.playStartupMelody();
+
+  // From here on audio is driven by events only
+  if (xTaskCreate(audioTaskLoop, "audio", AUDIO_TASK_STACK, nullptr, AUDIO_TASK_PRIORITY,
+                  &audioTask) != pdPASS) {
+    Serial.println("ERROR: Failed to start audio task!");
+    return false;
   }
+  systemMetrics.registerTask("audio", audioTask);
+  taskWatchdog.attach(WATCH_AUDIO, audioTask);
+  return true;
+}
 
-  // Initialize BLE
-  Serial.println("\n[BLE] Starting...");
-  if (bleServer.begin(BLE_DEVICE_NAME)) {
-    bleServer.setStreamingInterval(BLE_STREAMING_INTERVAL_MS);
-    Serial.println("✓ BLE server started");
-    audioManager.playConfirmationTone();
+// Background steps share the bus with the sensor tick and the supervisor
+bool bootPressure() {
+  bool ok = i2cBus.lock(I2C_BOOT_LOCK_MS);
+  if (ok) {
+    ok = startPressure();
+    i2cBus.unlock();
+  }
+  if (!ok) {
+    Serial.println("ERROR: Failed to initialize BMP280!");
+#if SENSOR_SOURCE == SENSOR_SOURCE_HARDWARE
+    sensorSource.getPressureHealth().markDown(millis());
+#endif
+    return false;
+  }
+  Serial.println("✓ BMP280 initialized");
+  delay(1000);  // Let the IIR filter settle before taking the baseline
+  if (i2cBus.lock(I2C_BOOT_LOCK_MS)) {
+    pressureSensor.resetBaselineAltitude();
+    i2cBus.unlock();
+  } else {
+    Serial.println("✗ BMP280 baseline skipped, bus busy");
+  }
+  enableSensor(HARDWARE_PRESSURE);
+  return true;
+}
 
-    // Register BLE callbacks
-    bleServer.onConnect([]() {
-      Serial.println("[BLE] Mobile app connected!");
-      audioManager.playConfirmationTone();
-    });
+// Boot and supervisor re-init (the altitude filter needs no baseline)
+bool startPressure() {
+  if (!pressureSensor.begin()) {
+    return false;
+  }
+  pressureSensor.configure();
+  return true;
+}
 
-    bleServer.onDisconnect([]() {
-      Serial.println("[BLE] Mobile app disconnected");
-      if (AUDIO_ENABLE_VOICE_ALERTS) {
-        audioManager.playVoiceAlert(VOICE_ALERT_CONNECTION_LOST);
-      }
-    });
+bool bootHeart() {
+  if (!i2cBus.lock(I2C_BOOT_LOCK_MS)) {
+    Serial.println("ERROR: MAX30102 init skipped, bus busy");
+    return false;
+  }
+  bool ok = heartRateSensor.begin();
+  if (ok) {
+    heartRateSensor.configure();
+  }
+  i2cBus.unlock();
 
-    bleServer.onCommand(handleBLECommand);
-  } else {
-    Serial.println("✗ BLE initialization failed");
-    audioManager.playErrorTone();
+  if (!ok) {
+    Serial.println("ERROR: Failed to initialize MAX30102!");
+    return false;
   }
+  Serial.println("✓ MAX30102 initialized");
+  enableSensor(HARDWARE_HEART);
+  return true;
+}
 
-  // Initialize emergency communication system
-  if (emergencyComms.begin()) {
-    emergencyComms.setMaxRetries(EMERGENCY_MAX_RETRIES);
-    emergencyComms.setRetryInterval(EMERGENCY_RETRY_INTERVAL_MS);
-    Serial.println("✓ Emergency communication system ready");
-    audioManager.playConfirmationTone();
+bool bootForce() {
+  if (!forceSensor.begin()) {
+    Serial.println("ERROR: Failed to initialize FSR!");
+    return false;
   }
+  Serial.println("✓ FSR initialized");
+  forceSensor.calibrate();
+  enableSensor(HARDWARE_FORCE);
+  return true;
 }
 
-void readSensors() {
-  currentSensorData.timestamp = millis();
-  currentSensorData.valid = true;
-
-  // Read IMU (MPU6050)
-  if (imuSensor.isInitialized()) {
-    float temp;
-    imuSensor.readData(currentSensorData.accel_x,
-                       currentSensorData.accel_y,
-                       currentSensorData.accel_z,
-                       currentSensorData.gyro_x,
-                       currentSensorData.gyro_y,
-                       currentSensorData.gyro_z,
-                       temp);
-  } else {
-    currentSensorData.accel_x = 0;
-    currentSensorData.accel_y = 0;
-    currentSensorData.accel_z = 1.0;  // 1g gravity
-    currentSensorData.gyro_x = 0;
-    currentSensorData.gyro_y = 0;
-    currentSensorData.gyro_z = 0;
-  }
-
-  // Read pressure sensor (BMP280)
-  if (pressureSensor.isInitialized()) {
-    float temp, altitude;
-    pressureSensor.readData(temp, currentSensorData.pressure, altitude);
-  } else {
-    currentSensorData.pressure = 1013.25;  // Sea level pressure
+bool bootLogger() {
+  if (!logStorage.begin(DATA_LOGGER_PARTITION) || !dataLogger.begin(SENSOR_SAMPLE_RATE_HZ)) {
+    Serial.println("✗ Data logger unavailable");
+    return false;
+  }
+  Serial.println("✓ Data logger ready");
+  systemMetrics.registerTask("logger", dataLogger.getTaskHandle());
+  if (DATA_LOGGER_AUTOSTART) {
+    dataLogger.start();
   }
+  return true;
+}
 
-  // Read heart rate (MAX30102)
-  if (heartRateSensor.isInitialized()) {
-    float bpm;
-    bool fingerDetected;
-    if (heartRateSensor.readHeartRate(bpm, fingerDetected)) {
-      currentSensorData.heart_rate = bpm;
-    } else {
-      currentSensorData.heart_rate = 0;
-    }
-  } else {
-    currentSensorData.heart_rate = 0;
+bool bootWiFi() {
+  Serial.println("[WiFi] Connecting...");
+  bool connected = wifiManager.begin(configStore.get().wifi_ssid, configStore.get().wifi_password);
+  wifiManager.setServerURL(SERVER_URL);
+  wifiManager.enableAutoReconnect(true);
+  if (!connected) {
+    Serial.println("✗ WiFi connection failed (will retry automatically)");
+    return false;
   }
+  Serial.println("✓ WiFi connected");
+  return true;
+}
 
-  // Read force sensor (FSR)
-  if (forceSensor.isInitialized()) {
-    currentSensorData.fsr_value = forceSensor.readRaw();
-  } else {
-    currentSensorData.fsr_value = 0;
+bool bootBLE() {
+  Serial.println("[BLE] Starting...");
+  if (!bleServer.begin(BLE_DEVICE_NAME)) {
+    Serial.println("✗ BLE initialization failed");
+    return false;
   }
+  bleServer.setStreamingInterval(BLE_STREAMING_INTERVAL_MS);
+  Serial.println("✓ BLE server started");
+
+  // Register BLE callbacks (BLE stack task: publish only)
+  bleServer.onConnect([]() {
+    Serial.println("[BLE] Mobile app connected!");
+    eventBus.publish(EVENT_BLE_CONNECTED);
+  });
+
+  bleServer.onDisconnect([]() {
+    Serial.println("[BLE] Mobile app disconnected");
+    eventBus.publish(EVENT_BLE_DISCONNECTED);
+  });
+
+  bleServer.onCommand(handleBLECommand);
+  bleServer.onConfigWrite(handleConfigWrite);
+  publishConfig();
+  bleServer.setBulkSource(openLogSource, readLogSource);
+  return true;
 }
 
-void handleFallDetected() {
-  alertActive = true;
+bool bootReady() {
+  bool sensors_ok = sensorsReady();
 
-  Serial.println("\n!!! FALL DETECTED !!!");
+  Serial.println("\n========================================");
+  Serial.println("       SmartFall Ready!");
+  Serial.println("========================================");
 
-  // Get confidence score from fall detector
-  uint8_t confidence = confidenceScorer.getTotalScore();
+  // One cue for the whole boot instead of a tone per subsystem
+  eventBus.publish(EVENT_SYSTEM_READY, sensors_ok ? 1 : 0);
 
-  Serial.print("Confidence Score: ");
-  Serial.print(confidence);
-  Serial.println("/105");
+  printSystemInfo();
+  return true;
+}
 
-  // Prepare emergency data
-  EmergencyData_t emergencyData;
-  emergencyData.timestamp = millis();
-  emergencyData.confidence = confidenceScorer.getConfidenceLevel();
-  emergencyData.confidence_score = confidence;
-  emergencyData.battery_level = readBatteryLevel();
-  emergencyData.sos_triggered = false;
-  strncpy(emergencyData.device_id, deviceID, sizeof(emergencyData.device_id));
+bool sensorsReady() {
+#if SENSOR_SOURCE == SENSOR_SOURCE_HARDWARE
+  // Live: a sensor the supervisor brought back counts, one that dropped out does not
+  return sensorSource.getIMUHealth().isUp() && sensorSource.getAvailable() == HARDWARE_ALL;
+#else
+  return bootManager.isDone(BOOT_IMU) && bootManager.isDone(BOOT_PRESSURE) &&
+         bootManager.isDone(BOOT_HEART) && bootManager.isDone(BOOT_FORCE);
+#endif
+}
 
-  // Copy sensor history (simplified - in full implementation, use detector's history)
-  memcpy(emergencyData.sensor_history, &currentSensorData, sizeof(SensorData_t));
+// Background-initialized sensors are read once their boot step is done
+// (BMP280 baseline is taken after a settle delay)
+void enableSensor(HardwareSensor_t sensor) {
+#if SENSOR_SOURCE == SENSOR_SOURCE_HARDWARE
+  sensorSource.enable(sensor);
+#endif
+}
 
-  // Activate alerts based on confidence
-  if (confidence >= HIGH_CONFIDENCE_THRESHOLD) {
-    Serial.println("HIGH CONFIDENCE FALL - Immediate Alert");
-    activateFullAlert(true);
-  } else if (confidence >= CONFIRMED_THRESHOLD) {
-    Serial.println("CONFIRMED FALL - Delayed Alert");
-    activateFullAlert(false);
-  }
+void readSensors() {
+  sensorSource.read(currentSensorData);
+}
 
-  // Send emergency alert via WiFi/BLE
-  Serial.println("\n--- Transmitting Emergency Alert ---");
+void handleFallDetected(uint8_t confidence) {
+  // Deferred: a blocked UART must not hold up the countdown
+  Deferred_Log::log(DLOG_FALL_DETECTED, confidence, MAX_CONFIDENCE_SCORE,
+                    confidence >= HIGH_CONFIDENCE_THRESHOLD);
 
-  // Audio announcement
-  if (AUDIO_ENABLE_VOICE_ALERTS) {
-    audioManager.playVoiceAlert(VOICE_ALERT_CALLING_HELP);
-  }
+  // Detector history leading up to the fall, before the countdown moves it on
+  captureAlertData(confidence, false);
 
-  bool sent = emergencyComms.sendEmergencyAlert(emergencyData);
+  // Detailed fall information
+  fallDetector.logStageDetails();
+  confidenceScorer.logScoreBreakdown();
 
-  if (sent) {
-    Serial.println("✓ Emergency alert transmitted successfully");
-    if (AUDIO_ENABLE_VOICE_ALERTS) {
-      delay(500);
-      audioManager.playVoiceAlert(VOICE_ALERT_HELP_SENT);
-    }
+  Deferred_Log::log(DLOG_FALL_COUNTDOWN);
+  alertSequencer.startFall(confidence);
+}
+
+void handleSOSButton() {
+  if (alertSequencer.isActive()) {
+    Serial.println("User confirmed emergency!");
   } else {
-    Serial.println("⚠ Emergency alert queued for retry");
-    audioManager.playWarningTone();
+    Serial.println("\n!!! SOS BUTTON PRESSED !!!");
+    alertActive = true;
+    captureAlertData(MAX_CONFIDENCE_SCORE, true);
   }
+  alertSequencer.pressSOS();
+}
 
-  // Print detailed fall information
-  fallDetector.printStageDetails();
-  confidenceScorer.printScoreBreakdown();
+void captureAlertData(uint8_t confidence, bool sos) {
+  alertData.timestamp = millis();
+  alertData.confidence = sos ? CONFIDENCE_HIGH : confidenceScorer.getConfidenceLevel();
+  alertData.confidence_score = confidence;
+  alertData.battery_level = readBatteryLevel();
+  alertData.sos_triggered = sos;
+  strncpy(alertData.device_id, deviceID, sizeof(alertData.device_id));
 
-  // User response countdown
-  Serial.println("\n--- Countdown: Press SOS to confirm or wait to cancel ---");
+  // Detector history leading up to the event, oldest first
+  alertData.history_count = fallDetector.copyHistory(alertData.sensor_history, SENSOR_HISTORY_SIZE);
+}
 
-  if (AUDIO_ENABLE_VOICE_ALERTS) {
-    delay(1000);
-    audioManager.playVoiceAlert(VOICE_ALERT_PRESS_BUTTON);
-  }
+void onAlertAction(AlertAction_t action) {
+  switch (action) {
+    case ALERT_ACTION_ALARM_ON:
+      activateFullAlert();
+      break;
 
-  // Countdown with audio beeps
-  for (int i = COUNTDOWN_DURATION_S; i > 0; i--) {
-    // Check if user cancels
-    if (digitalRead(SOS_BUTTON_PIN) == LOW) {
-      Serial.println("User confirmed emergency!");
+    case ALERT_ACTION_ALARM_OFF:
+      deactivateFullAlert();
       break;
-    }
 
-    // Countdown beep every 10 seconds
-    if (i % 10 == 0 || i <= 5) {
-      audioManager.playTone(1000, 200);
-      Serial.print("Countdown: ");
-      Serial.println(i);
-    }
+    case ALERT_ACTION_TRANSMIT:
+      // Returns at once; reportAlertOutcome() announces the result
+      Serial.println("\n--- Transmitting Emergency Alert ---");
+      alertData.sos_triggered = alertSequencer.isSOS();
+      emergencyComms.startEmergencyAlert(alertData);
+      alertInFlight = true;
+      break;
 
-    delay(1000);
-  }
+    case ALERT_ACTION_WITHDRAW:
+      emergencyComms.clearPendingAlert();
+      alertInFlight = false;
+      break;
 
-  // Reset detection
-  fallDetector.resetDetection();
-  deactivateFullAlert();
-  alertActive = false;
+    case ALERT_ACTION_FINISHED:
+      Serial.print("[Alert] Sequence ended: ");
+      Serial.println(Alert_Sequencer::getResolutionName(alertSequencer.getResolution()));
+      fallDetector.resetDetection();
+      fallClassifier.reset();
+      confidenceScorer.resetScore();
+      alertActive = false;
+      break;
+  }
 }
 
-void handleSOSButton() {
-  alertActive = true;
+void reportAlertOutcome() {
+  if (!alertInFlight) return;
 
-  Serial.println("\n!!! SOS BUTTON PRESSED !!!");
+  AlertStatus_t status = emergencyComms.getAlertStatus();
+  if (status == ALERT_STATUS_SENDING) return;
+  alertInFlight = false;
 
-  // Play SOS audio sequence
-  audioManager.playSOSSequence();
-
-  // Prepare emergency data
-  EmergencyData_t emergencyData;
-  emergencyData.timestamp = millis();
-  emergencyData.confidence = CONFIDENCE_HIGH;
-  emergencyData.confidence_score = MAX_CONFIDENCE_SCORE;
-  emergencyData.battery_level = readBatteryLevel();
-  emergencyData.sos_triggered = true;  // Manual trigger
-  strncpy(emergencyData.device_id, deviceID, sizeof(emergencyData.device_id));
-
-  // Activate alerts immediately
-  activateFullAlert(true);
-
-  // Audio announcement
-  if (AUDIO_ENABLE_VOICE_ALERTS) {
-    audioManager.playVoiceAlert(VOICE_ALERT_CALLING_HELP);
+  if (status == ALERT_STATUS_SENT_WIFI || status == ALERT_STATUS_SENT_BLE ||
+      status == ALERT_STATUS_SENT_BOTH) {
+    Serial.println("✓ Emergency alert transmitted successfully");
+    eventBus.publish(EVENT_ALERT_SENT);
+  } else {
+    Serial.println("⚠ Emergency alert queued for retry");
+    eventBus.publish(EVENT_ALERT_FAILED);
   }
+}
 
-  // Send emergency alert
-  bool sent = emergencyComms.sendEmergencyAlert(emergencyData);
+void serviceTestAlert() {
+  if (!testAlertActive || millis() - testAlertStart < TEST_ALERT_DURATION_MS) return;
+  testAlertActive = false;
 
-  if (sent && AUDIO_ENABLE_VOICE_ALERTS) {
-    delay(500);
-    audioManager.playVoiceAlert(VOICE_ALERT_HELP_SENT);
+  // A real alert that started meanwhile keeps the outputs
+  if (!alertSequencer.isActive()) {
+    deactivateFullAlert();
   }
+}
 
-  // Wait for button release
-  while (digitalRead(SOS_BUTTON_PIN) == LOW) {
-    delay(100);
+void IRAM_ATTR sosInterrupt() {
+  uint32_t now = millis();
+  if (now - lastSOSEdge < SOS_DEBOUNCE_MS) {
+    return;
   }
-
-  delay(5000);  // Keep alerts active
-  deactivateFullAlert();
-  alertActive = false;
+  lastSOSEdge = now;
+  eventBus.publishFromISR(EVENT_SOS_PRESSED);
 }
 
 void handleBLECommand(uint8_t command, uint8_t* data, size_t length) {
+  // BLE task context: queue only, acted on by the alert subscriber
+  if (command == BLE_CMD_SET_CONFIG) {
+    // Same schema as the Config characteristic
+    configStore.submit(data, length);
+    return;
+  }
+  if (command == BLE_CMD_ALERT_ACK) {
+    return;  // Consumed by BLE_Server
+  }
+  eventBus.publish(EVENT_BLE_COMMAND, command);
+}
+
+void handleAppCommand(uint8_t command) {
   switch (command) {
     case BLE_CMD_CANCEL_ALERT:
       Serial.println("[App] Cancel alert command received");
-      deactivateFullAlert();
-      fallDetector.resetDetection();
-      emergencyComms.clearPendingAlert();
-      alertActive = false;
-      audioManager.playPattern(ALERT_PATTERN_CANCEL);
+      if (!alertSequencer.cancel()) {
+        // Nothing running: still drop a queued retry
+        deactivateFullAlert();
+        emergencyComms.clearPendingAlert();
+        alertInFlight = false;
+        eventBus.publish(EVENT_ALERT_CANCELLED);
+      }
       break;
 
     case BLE_CMD_TEST_ALERT:
       Serial.println("[App] Test alert command received");
-      audioManager.playFallDetectedSequence();
-      activateFullAlert(true);
-      delay(2000);
-      deactivateFullAlert();
+      if (alertSequencer.isActive()) {
+        break;   // Never mask a real alert
+      }
+      eventBus.publish(EVENT_TEST_ALERT);
+      activateFullAlert();
+      testAlertActive = true;
+      testAlertStart = millis();
       break;
 
-    case BLE_CMD_GET_STATUS:
+    case BLE_CMD_GET_STATUS: {
       Serial.println("[App] Status request received");
-      updateSystemStatus();
-      bleServer.sendStatusUpdate(systemStatus);
+      static SystemStatus_t status;   // BLE task; systemStatus belongs to loop()
+      updateSystemStatus(status);
+      bleServer.sendStatusUpdate(status);
+      break;
+    }
+
+    case BLE_CMD_GET_PROFILE: {
+      Serial.println("[App] Profile report request received");
+      static char report[JSON_BLE_BUFFER_SIZE];
+      size_t length = Profiler::writeReportJSON(report, sizeof(report));
+      bleServer.sendDiagnostics((const uint8_t*)report, length);
+      break;
+    }
+
+    case BLE_CMD_START_LOGGING:
+      Serial.println("[App] Start logging command");
+      dataLogger.start();
+      eventBus.publish(EVENT_COMMAND_DONE, command);
+      break;
+
+    case BLE_CMD_STOP_LOGGING:
+      Serial.println("[App] Stop logging command");
+      dataLogger.requestStop();  // The logger task flushes the partial block
+      eventBus.publish(EVENT_COMMAND_DONE, command);
+      break;
+
+    case BLE_CMD_DUMP_LOG:
+      // Minutes at the console baud: the logger task sends it
+      if (dataLogger.requestDump()) {
+        Serial.println("[App] Log dump requested (raw blocks follow on Serial)");
+      } else {
+        Serial.println("[App] ✗ Logger busy, dump not started");
+      }
+      break;
+
+    case BLE_CMD_ERASE_LOG:
+      Serial.println("[App] Erase log command");
+      if (!dataLogger.requestErase()) {
+        Serial.println("[App] ✗ Logger busy, erase not started");
+      }
       break;
 
     case BLE_CMD_START_STREAMING:
       Serial.println("[App] Start streaming command");
-      audioManager.playConfirmationTone();
+      eventBus.publish(EVENT_COMMAND_DONE, command);
       break;
 
     case BLE_CMD_STOP_STREAMING:
       Serial.println("[App] Stop streaming command");
+      eventBus.publish(EVENT_COMMAND_DONE, command);
+      break;
+
+    default:
+      break;
+  }
+}
+
+void onAlertEvent(const Event_t& event) {
+  switch (event.type) {
+    case EVENT_FALL_DETECTED:
+      handleFallDetected((uint8_t)event.value);
+      break;
+
+    case EVENT_SOS_PRESSED:
+      handleSOSButton();
+      break;
+
+    case EVENT_BLE_COMMAND:
+      handleAppCommand((uint8_t)event.value);
+      break;
+
+    default:
+      break;
+  }
+}
+
+void onAudioEvent(const Event_t& event) {
+  switch (event.type) {
+    case EVENT_FALL_DETECTED:
+      if (event.value >= HIGH_CONFIDENCE_THRESHOLD) {
+        audioManager.playFallDetectedSequence();
+      } else if (event.value >= CONFIRMED_THRESHOLD) {
+        audioManager.playPattern(ALERT_PATTERN_URGENT, 2);
+      }
+      if (AUDIO_ENABLE_VOICE_ALERTS) {
+        audioManager.playVoiceAlert(VOICE_ALERT_CALLING_HELP);
+      }
+      break;
+
+    case EVENT_SOS_PRESSED:
+      audioManager.playSOSSequence();
+      audioManager.playFallDetectedSequence();
+      if (AUDIO_ENABLE_VOICE_ALERTS) {
+        audioManager.playVoiceAlert(VOICE_ALERT_CALLING_HELP);
+      }
+      break;
+
+    case EVENT_ALERT_SENT:
+      if (AUDIO_ENABLE_VOICE_ALERTS) {
+        audioManager.playVoiceAlert(VOICE_ALERT_HELP_SENT);
+      }
+      break;
+
+    case EVENT_ALERT_FAILED:
+      audioManager.playWarningTone();
+      break;
+
+    case EVENT_COUNTDOWN_STARTED:
+      if (AUDIO_ENABLE_VOICE_ALERTS) {
+        audioManager.playVoiceAlert(VOICE_ALERT_PRESS_BUTTON);
+      }
+      break;
+
+    case EVENT_COUNTDOWN_TICK:
+      audioManager.playTone(1000, 200);
+      break;
+
+    case EVENT_ALERT_CANCELLED:
+      audioManager.playPattern(ALERT_PATTERN_CANCEL);
+      break;
+
+    case EVENT_TEST_ALERT:
+      audioManager.playFallDetectedSequence();
+      break;
+
+    case EVENT_BLE_CONNECTED:
+    case EVENT_COMMAND_DONE:
       audioManager.playConfirmationTone();
       break;
 
+    case EVENT_BLE_DISCONNECTED:
+      if (AUDIO_ENABLE_VOICE_ALERTS) {
+        audioManager.playVoiceAlert(VOICE_ALERT_CONNECTION_LOST);
+      }
+      break;
+
+    case EVENT_LOW_BATTERY:
+      audioManager.playVoiceAlert(VOICE_ALERT_LOW_BATTERY);
+      break;
+
+    case EVENT_SYSTEM_READY:
+      if (event.value == 0) {
+        audioManager.playErrorTone();
+      } else if (AUDIO_ENABLE_VOICE_ALERTS) {
+        audioManager.playVoiceAlert(VOICE_ALERT_SYSTEM_READY);
+      } else {
+        audioManager.playConfirmationTone();
+      }
+      break;
+
     default:
       break;
   }
 }
 
-void activateFullAlert(bool immediate) {
-  // Visual alert
-  digitalWrite(VISUAL_ALERT_PIN, HIGH);
+void onLogEvent(const Event_t& event) {
+  Serial.print("[Event] ");
+  Serial.print(Event_Bus::getEventName(event.type));
+  Serial.print(" (");
+  Serial.print(event.value);
+  Serial.print(") after ");
+  Serial.print(micros() - event.timestamp_us);
+  Serial.println(" us");
+}
 
-  // Haptic alert
-  digitalWrite(HAPTIC_PIN, HIGH);
+void audioTaskLoop(void* arg) {
+  // Cues play back to back here; nothing else waits on them
+  while (true) {
+    taskWatchdog.checkIn(WATCH_AUDIO, millis());
+    if (eventBus.wait(audioSubscriber, 1000)) {
+      eventBus.dispatch(audioSubscriber);
+    }
+  }
+}
 
-  // Audio alert
-  if (immediate) {
-    audioManager.playFallDetectedSequence();
-  } else {
-    audioManager.playPattern(ALERT_PATTERN_URGENT, 2);
+void handleConfigWrite(const uint8_t* data, size_t length) {
+  // BLE task context: queue only, applied in serviceTask()
+  if (!configStore.submit(data, length)) {
+    publishConfig();
+  }
+}
+
+void applyConfig(const Config_t& config, uint8_t changed) {
+  if (changed & CONFIG_CHANGED_THRESHOLDS) {
+    DetectionThresholds_t thresholds = config.thresholds;
+    fallDetector.setThresholds(thresholds);
+  }
+
+  if (changed & CONFIG_CHANGED_SCORING) {
+    confidenceScorer.setScoreTiers(config.score_tiers);
+  }
+
+  if (changed & CONFIG_CHANGED_VOLUME) {
+    audioManager.setVolume(config.alert_volume);
+  }
+
+  if (changed & CONFIG_CHANGED_WIFI) {
+    wifiManager.setCredentials(config.wifi_ssid, config.wifi_password);
+  }
+
+  // Haptic/visual settings are read when an alert starts
+}
+
+void publishConfig() {
+  static uint8_t value[CONFIG_MAX_SIZE + 4];
+  size_t length = configStore.encodeForRead(value, sizeof(value));
+  bleServer.setConfigValue(value, length);
+}
+
+void activateFullAlert() {
+  const Config_t& config = configStore.get();
+
+  // Visual alert
+  if (config.visual_alerts_enabled) {
+    digitalWrite(VISUAL_ALERT_PIN, HIGH);
+  }
+
+  // Haptic alert (on/off driver; 0% disables it)
+  if (config.haptic_intensity > 0) {
+    digitalWrite(HAPTIC_PIN, HIGH);
   }
 }
 
 void deactivateFullAlert() {
   digitalWrite(HAPTIC_PIN, LOW);
   digitalWrite(VISUAL_ALERT_PIN, LOW);
-  audioManager.stopPattern();
+  audioManager.stopPattern();  // Cuts short a cue still playing on the audio task
 }
 
-void updateSystemStatus() {
-  systemStatus.wifi_connected = wifiManager.isConnected();
-  systemStatus.bluetooth_connected = bleServer.isConnected();
-  systemStatus.battery_percentage = readBatteryLevel();
-  systemStatus.current_status = fallDetector.getCurrentStatus();
-  systemStatus.uptime_ms = millis();
+void updateSystemStatus(SystemStatus_t& status) {
+  status.sensors_initialized = sensorsReady();
+  status.wifi_connected = wifiManager.isConnected();
+  status.bluetooth_connected = bleServer.isConnected();
+  status.battery_percentage = readBatteryLevel();
+  status.current_status = fallDetector.getCurrentStatus();
+  status.uptime_ms = millis();
+  systemMetrics.getStats(status.memory);
+  bootManager.getStats(status.boot);
 }
 
 float readBatteryLevel() {
@@ -554,9 +1165,17 @@ void printSystemInfo() {
   Serial.println("========================================");
   Serial.print("Device ID: ");
   Serial.println(deviceID);
+  bootManager.printReport();
   wifiManager.printConnectionInfo();
+  wifiManager.printHTTPStats();
   bleServer.printConnectionInfo();
   emergencyComms.printStatus();
+  systemMetrics.printMetrics();
+  scheduler.printStats();
+  taskWatchdog.printStats();
+  Deferred_Log::printStats();
+  dataLogger.printStatus();
+  configStore.printConfig();
   Serial.print("Audio System: ");
   Serial.println(audioManager.isInitialized() ? "Active" : "Inactive");
   Serial.print("Audio Volume: ");
@@ -0,0 +1,2 @@
+// Arduino compiles only the sketch folder; the source lives in diagnostics/
+#include "diagnostics/System_Metrics.cpp"
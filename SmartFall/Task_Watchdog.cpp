@@ -0,0 +1,2 @@
+// Arduino compiles only the sketch folder; the source lives in system/
+#include "system/Task_Watchdog.cpp"
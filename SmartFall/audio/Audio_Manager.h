@@ -48,7 +48,7 @@ private:
     uint8_t volume_level;  // 0-100 (controls duty cycle for PWM)
 
     // Current playback state
-    bool playing;
+    volatile bool playing;  // Cleared by stopPattern() from other tasks
     uint32_t pattern_start_time;
     AlertPattern_t current_pattern;
 
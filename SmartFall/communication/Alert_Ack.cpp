@@ -0,0 +1,209 @@
+#include "Alert_Ack.h"
+
+Alert_Ack::Alert_Ack(Bulk_Link* transport, BulkClock_t clock)
+    : link(transport), clock_ms(clock), frame(nullptr), frame_length(0), sequence(0),
+      attempt(0), state(ALERT_ACK_IDLE), send_pending(false), start_time(0),
+      rtt_valid(false), srtt(0), rttvar(0), rto(ALERT_ACK_INITIAL_RTO_MS),
+      ack_pending(false), ack_attempt(0), ack_time(0) {
+    memset(sent_time, 0, sizeof(sent_time));
+    memset(&stats, 0, sizeof(stats));
+#ifdef ARDUINO
+    ack_mux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+}
+
+void Alert_Ack::setSequence(uint16_t next) {
+    lock();
+    sequence = next - 1;
+    unlock();
+}
+
+uint16_t Alert_Ack::start(uint8_t* buffer, size_t length) {
+    lock();
+    sequence++;
+    state = ALERT_ACK_WAITING;
+    ack_pending = false;
+    unlock();
+
+    frame = buffer;
+    frame_length = length;
+    attempt = 1;
+    start_time = clock_ms();
+    stats.alerts++;
+
+    frame[0] = ALERT_ACK_FRAME_TYPE;
+    bulkPut16(&frame[1], sequence);
+    frame[3] = attempt;
+
+    send_pending = !sendFrame();
+    return sequence;
+}
+
+void Alert_Ack::submitAck(const uint8_t* data, size_t length) {
+    if (length < ALERT_ACK_SIZE) return;
+
+    uint16_t acked = bulkGet16(data);
+    uint8_t acked_attempt = data[2];
+    uint32_t now = clock_ms();
+
+    lock();
+    if (state != ALERT_ACK_WAITING || acked != sequence) {
+        stats.stale_acks++;
+    } else if (ack_pending) {
+        stats.duplicate_acks++;
+    } else {
+        ack_attempt = acked_attempt;
+        ack_time = now;
+        ack_pending = true;
+    }
+    unlock();
+}
+
+AlertAckState_t Alert_Ack::service() {
+    lock();
+    bool acked = ack_pending;
+    uint8_t acked_attempt = ack_attempt;
+    uint32_t acked_time = ack_time;
+    ack_pending = false;
+    AlertAckState_t current = state;
+    unlock();
+
+    if (current != ALERT_ACK_WAITING) return current;
+
+    if (acked) {
+        // The echoed attempt tells which copy was answered
+        if (acked_attempt >= 1 && acked_attempt <= attempt) {
+            sampleRTT(acked_time - sent_time[acked_attempt - 1]);
+        }
+        stats.confirmed++;
+        stats.last_confirm_ms = acked_time - start_time;
+
+        lock();
+        state = ALERT_ACK_CONFIRMED;
+        unlock();
+        return ALERT_ACK_CONFIRMED;
+    }
+
+    if (send_pending) {
+        send_pending = !sendFrame();
+        return ALERT_ACK_WAITING;
+    }
+
+    uint32_t now = clock_ms();
+    if (now - sent_time[attempt - 1] < rto) {
+        return ALERT_ACK_WAITING;
+    }
+
+    if (attempt >= ALERT_ACK_MAX_ATTEMPTS) {
+        stats.failed++;
+        lock();
+        state = ALERT_ACK_FAILED;
+        unlock();
+        return ALERT_ACK_FAILED;
+    }
+
+    // No ACK in time: back off and resend the same sequence number
+    rto = rto * 2 > ALERT_ACK_MAX_RTO_MS ? ALERT_ACK_MAX_RTO_MS : rto * 2;
+    attempt++;
+    frame[3] = attempt;
+    stats.retransmits++;
+    send_pending = !sendFrame();
+    return ALERT_ACK_WAITING;
+}
+
+void Alert_Ack::cancel() {
+    lock();
+    if (state == ALERT_ACK_WAITING) {
+        state = ALERT_ACK_FAILED;
+        stats.failed++;
+    }
+    ack_pending = false;
+    unlock();
+}
+
+AlertAckState_t Alert_Ack::getState() {
+    lock();
+    AlertAckState_t current = state;
+    unlock();
+    return current;
+}
+
+void Alert_Ack::printStats() {
+    Serial.println("=== BLE Alert ACK ===");
+    Serial.print("Alerts: ");
+    Serial.print(stats.alerts);
+    Serial.print(" | Confirmed: ");
+    Serial.print(stats.confirmed);
+    Serial.print(" | Failed: ");
+    Serial.println(stats.failed);
+    Serial.print("Frames: ");
+    Serial.print(stats.frames_sent);
+    Serial.print(" | Retransmits: ");
+    Serial.print(stats.retransmits);
+    Serial.print(" | Stale ACKs: ");
+    Serial.print(stats.stale_acks);
+    Serial.print(" | Link busy: ");
+    Serial.println(stats.link_busy);
+    Serial.print("RTT: last ");
+    Serial.print(stats.last_rtt_ms);
+    Serial.print(" ms, smoothed ");
+    Serial.print(srtt);
+    Serial.print(" ms | RTO ");
+    Serial.print(rto);
+    Serial.println(" ms");
+    Serial.println("=====================");
+}
+
+const char* Alert_Ack::getStateName(AlertAckState_t state) {
+    switch (state) {
+        case ALERT_ACK_IDLE:       return "idle";
+        case ALERT_ACK_WAITING:    return "waiting";
+        case ALERT_ACK_CONFIRMED:  return "confirmed";
+        case ALERT_ACK_FAILED:     return "failed";
+        default:                   return "unknown";
+    }
+}
+
+// Private helper functions
+
+bool Alert_Ack::sendFrame() {
+    if (link == nullptr || !link->send(frame, frame_length)) {
+        stats.link_busy++;
+        return false;
+    }
+
+    // Timed from the actual send, so a busy link does not eat into the RTO
+    sent_time[attempt - 1] = clock_ms();
+    stats.frames_sent++;
+    return true;
+}
+
+void Alert_Ack::sampleRTT(uint32_t rtt) {
+    stats.last_rtt_ms = rtt;
+
+    if (!rtt_valid) {
+        srtt = rtt;
+        rttvar = rtt / 2;
+        rtt_valid = true;
+    } else {
+        uint32_t deviation = srtt > rtt ? srtt - rtt : rtt - srtt;
+        rttvar = (3 * rttvar + deviation) / 4;
+        srtt = (7 * srtt + rtt) / 8;
+    }
+
+    rto = srtt + 4 * rttvar;
+    if (rto < ALERT_ACK_MIN_RTO_MS) rto = ALERT_ACK_MIN_RTO_MS;
+    if (rto > ALERT_ACK_MAX_RTO_MS) rto = ALERT_ACK_MAX_RTO_MS;
+}
+
+void Alert_Ack::lock() {
+#ifdef ARDUINO
+    portENTER_CRITICAL(&ack_mux);
+#endif
+}
+
+void Alert_Ack::unlock() {
+#ifdef ARDUINO
+    portEXIT_CRITICAL(&ack_mux);
+#endif
+}
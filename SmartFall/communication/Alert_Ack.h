@@ -0,0 +1,127 @@
+#ifndef ALERT_ACK_H
+#define ALERT_ACK_H
+
+#include <Arduino.h>
+#include "../utils/config.h"
+#include "Bulk_Transfer.h"
+
+/*
+ * Acknowledged emergency alerts over BLE.
+ *
+ * A notification only tells us the controller queued the packet, not
+ * that the phone app processed it. Every alert is therefore framed with
+ * a sequence number, and the app confirms it by writing an ACK to the
+ * command characteristic. Until the ACK arrives, the frame is resent on
+ * a retransmission timeout.
+ *
+ * Device -> app (notification on the emergency characteristic):
+ *   ALERT     [0xA5, seq u16, attempt u8, payload...]
+ *
+ * App -> device (write to the command characteristic):
+ *   ACK       [BLE_CMD_ALERT_ACK, seq u16, attempt u8]
+ *
+ * The payload is the binary alert (Alert_Codec.h), trimmed to the MTU,
+ * or the summary alert when the MTU cannot hold its header. A resend keeps the sequence number and increments
+ * the attempt. The app must ACK every copy it receives, and raise the
+ * alert only the first time it sees a sequence number on the current
+ * connection.
+ *
+ * The ACK echoes the attempt, so each ACK yields an unambiguous round
+ * trip sample even after a resend. The timeout follows RFC 6298:
+ * smoothed RTT plus four deviations, clamped to
+ * [ALERT_ACK_MIN_RTO_MS, ALERT_ACK_MAX_RTO_MS], doubling on every
+ * resend. All integers are little-endian.
+ */
+
+#define ALERT_ACK_FRAME_TYPE      0xA5
+#define ALERT_ACK_HEADER_SIZE     4      // type + seq + attempt
+#define ALERT_ACK_SIZE            3      // seq + attempt (after the command byte)
+#define ALERT_ACK_POLL_MS         5      // Blocking senders poll service() at this interval
+
+typedef enum {
+    ALERT_ACK_IDLE,
+    ALERT_ACK_WAITING,        // Sent, no ACK yet
+    ALERT_ACK_CONFIRMED,
+    ALERT_ACK_FAILED          // Out of attempts, or cancelled
+} AlertAckState_t;
+
+typedef struct {
+    uint32_t alerts;
+    uint32_t confirmed;
+    uint32_t failed;
+    uint32_t frames_sent;
+    uint32_t retransmits;
+    uint32_t stale_acks;          // ACK for an old or unknown sequence number
+    uint32_t duplicate_acks;      // Second ACK for the same alert before service()
+    uint32_t link_busy;           // send() refused by the link
+    uint32_t last_rtt_ms;
+    uint32_t last_confirm_ms;     // start() -> ACK, including resends
+} AlertAckStats_t;
+
+class Alert_Ack {
+private:
+    Bulk_Link* link;
+    BulkClock_t clock_ms;
+
+    // Current alert; the frame is owned by the caller until it settles
+    uint8_t* frame;
+    size_t frame_length;
+    uint16_t sequence;
+    uint8_t attempt;              // 1-based, 0 before the first send
+    AlertAckState_t state;
+    bool send_pending;            // Link was busy, send on the next service()
+    uint32_t start_time;
+    uint32_t sent_time[ALERT_ACK_MAX_ATTEMPTS];
+
+    // Retransmission timeout
+    bool rtt_valid;
+    uint32_t srtt;
+    uint32_t rttvar;
+    uint32_t rto;
+
+    // ACK mailbox (written from the BLE task, consumed in service())
+    volatile bool ack_pending;
+    uint8_t ack_attempt;
+    uint32_t ack_time;
+
+    AlertAckStats_t stats;
+
+#ifdef ARDUINO
+    portMUX_TYPE ack_mux;
+#endif
+
+public:
+    Alert_Ack(Bulk_Link* link, BulkClock_t clock = bulkMillis);
+
+    void setSequence(uint16_t next);     // Seed, e.g. random per boot
+
+    // Starts a new alert. frame holds ALERT_ACK_HEADER_SIZE free bytes
+    // followed by the payload; length covers both. Returns the sequence.
+    uint16_t start(uint8_t* frame, size_t length);
+
+    // Called from the command characteristic's write callback (without
+    // the command byte)
+    void submitAck(const uint8_t* data, size_t length);
+
+    // Called periodically while an alert is outstanding
+    AlertAckState_t service();
+    void cancel();
+
+    AlertAckState_t getState();
+    uint16_t getSequence() { return sequence; }
+    uint32_t getRTO() { return rto; }
+    uint32_t getSmoothedRTT() { return srtt; }
+    const AlertAckStats_t& getStats() { return stats; }
+    void printStats();
+
+    static const char* getStateName(AlertAckState_t state);
+
+private:
+    // Private helper functions
+    bool sendFrame();
+    void sampleRTT(uint32_t rtt);
+    void lock();
+    void unlock();
+};
+
+#endif // ALERT_ACK_H
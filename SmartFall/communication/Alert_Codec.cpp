@@ -0,0 +1,296 @@
+#include "Alert_Codec.h"
+#include "../storage/Data_Logger.h"
+
+#define ALERT_LZ_HASH_SIZE  (1 << ALERT_LZ_HASH_BITS)
+
+// Work buffers, shared by the WiFi and BLE alert tasks under encode_mutex
+static LogSample_t alert_window[ALERT_MAX_SAMPLES];
+static uint8_t alert_body[ALERT_MAX_BODY_SIZE];
+static uint16_t lz_head[ALERT_LZ_HASH_SIZE];     // Last position + 1 per hash
+
+#ifdef ARDUINO
+static SemaphoreHandle_t encode_mutex = xSemaphoreCreateMutex();
+#endif
+
+static void put16(uint8_t* out, uint16_t value) {
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+}
+
+static void put32(uint8_t* out, uint32_t value) {
+    put16(out, (uint16_t)value);
+    put16(out + 2, (uint16_t)(value >> 16));
+}
+
+static uint16_t get16(const uint8_t* in) {
+    return (uint16_t)(in[0] | (in[1] << 8));
+}
+
+static uint32_t get32(const uint8_t* in) {
+    return get16(in) | ((uint32_t)get16(in + 2) << 16);
+}
+
+// Field-major delta body for the last `count` samples of the window
+static size_t encodeBody(const LogSample_t* samples, uint8_t count, uint8_t* out) {
+    size_t position = 0;
+    for (uint8_t field = 0; field < LOG_FIELD_COUNT; field++) {
+        int32_t previous = 0;
+        for (uint8_t s = 0; s < count; s++) {
+            int32_t value = samples[s].values[field];
+            int32_t delta = (int32_t)((uint32_t)value - (uint32_t)previous);
+            position += writeVarint(out + position, zigzagEncode(delta));
+            previous = value;
+        }
+    }
+    return position;
+}
+
+static size_t encodeWindow(const EmergencyData_t& data, const LogSample_t* samples, uint8_t count,
+                           uint8_t* out, size_t capacity, bool compress) {
+    size_t id_length = strnlen(data.device_id, sizeof(data.device_id) - 1);
+    size_t header_size = ALERT_FIXED_HEADER_SIZE + id_length;
+    if (capacity < header_size + ALERT_CRC_SIZE) return 0;
+
+    size_t body_bytes = encodeBody(samples, count, alert_body);
+    size_t room = capacity - header_size - ALERT_CRC_SIZE;
+
+    uint8_t flags = data.sos_triggered ? ALERT_FLAG_SOS : 0;
+    size_t payload_bytes = 0;
+    if (compress) {
+        payload_bytes = lzCompress(alert_body, body_bytes, out + header_size, room);
+        if (payload_bytes > 0) flags |= ALERT_FLAG_LZ;
+    }
+    if (payload_bytes == 0) {
+        if (body_bytes > room) return 0;
+        memcpy(out + header_size, alert_body, body_bytes);
+        payload_bytes = body_bytes;
+    }
+
+    float battery = constrain(data.battery_level, 0.0f, 100.0f);
+
+    put16(out, ALERT_MAGIC);
+    out[2] = ALERT_VERSION;
+    out[3] = flags;
+    put32(out + 4, data.timestamp);
+    out[8] = (uint8_t)data.confidence;
+    out[9] = data.confidence_score;
+    put16(out + 10, (uint16_t)lroundf(battery * 10.0f));
+    out[12] = count;
+    put16(out + 13, (uint16_t)body_bytes);
+    put16(out + 15, (uint16_t)payload_bytes);
+    out[17] = (uint8_t)id_length;
+    memcpy(out + ALERT_FIXED_HEADER_SIZE, data.device_id, id_length);
+
+    size_t length = header_size + payload_bytes;
+    put32(out + length, logCrc32(out, length));
+    return length + ALERT_CRC_SIZE;
+}
+
+static size_t encodeNewest(const EmergencyData_t& data, uint8_t* out, size_t capacity, bool compress) {
+    uint8_t available = data.history_count < ALERT_MAX_SAMPLES ? data.history_count : ALERT_MAX_SAMPLES;
+    for (uint8_t s = 0; s < available; s++) {
+        Data_Logger::toLogSample(data.sensor_history[s], alert_window[s]);
+    }
+
+    // Drop the oldest samples until the alert fits
+    uint8_t count = available;
+    while (true) {
+        size_t length = encodeWindow(data, alert_window + (available - count), count, out, capacity, compress);
+        if (length > 0 || count == 0) return length;
+        count -= (count > 8) ? count / 8 : 1;
+    }
+}
+
+size_t encodeAlert(const EmergencyData_t& data, uint8_t* out, size_t capacity, bool compress) {
+#ifdef ARDUINO
+    xSemaphoreTake(encode_mutex, portMAX_DELAY);
+#endif
+    size_t length = encodeNewest(data, out, capacity, compress);
+#ifdef ARDUINO
+    xSemaphoreGive(encode_mutex);
+#endif
+    return length;
+}
+
+size_t encodeAlertSummary(const EmergencyData_t& data, uint8_t* out, size_t capacity) {
+    if (capacity < ALERT_SUMMARY_SIZE) return 0;
+
+    float battery = constrain(data.battery_level, 0.0f, 100.0f);
+
+    put16(out, ALERT_SUMMARY_MAGIC);
+    out[2] = ALERT_VERSION;
+    out[3] = data.sos_triggered ? ALERT_FLAG_SOS : 0;
+    put32(out + 4, data.timestamp);
+    out[8] = (uint8_t)data.confidence;
+    out[9] = data.confidence_score;
+    out[10] = (uint8_t)lroundf(battery);
+    put32(out + 11, logCrc32(out, ALERT_SUMMARY_SIZE - ALERT_CRC_SIZE));
+    return ALERT_SUMMARY_SIZE;
+}
+
+static bool decodeSummary(const uint8_t* in, size_t length, EmergencyData_t& data) {
+    if (length != ALERT_SUMMARY_SIZE || in[2] != ALERT_VERSION) return false;
+    if (get32(in + 11) != logCrc32(in, ALERT_SUMMARY_SIZE - ALERT_CRC_SIZE)) return false;
+
+    memset(&data, 0, sizeof(data));
+    data.timestamp = get32(in + 4);
+    data.confidence = (FallConfidence_t)in[8];
+    data.confidence_score = in[9];
+    data.battery_level = in[10];
+    data.sos_triggered = (in[3] & ALERT_FLAG_SOS) != 0;
+    return true;
+}
+
+bool decodeAlert(const uint8_t* in, size_t length, EmergencyData_t& data) {
+    static uint8_t body[ALERT_MAX_BODY_SIZE];
+
+    if (length >= 2 && get16(in) == ALERT_SUMMARY_MAGIC) return decodeSummary(in, length, data);
+    if (length < ALERT_FIXED_HEADER_SIZE + ALERT_CRC_SIZE) return false;
+    if (get16(in) != ALERT_MAGIC || in[2] != ALERT_VERSION) return false;
+
+    uint8_t flags = in[3];
+    uint8_t count = in[12];
+    size_t body_bytes = get16(in + 13);
+    size_t payload_bytes = get16(in + 15);
+    size_t id_length = in[17];
+    size_t header_size = ALERT_FIXED_HEADER_SIZE + id_length;
+
+    if (count > ALERT_MAX_SAMPLES || body_bytes > ALERT_MAX_BODY_SIZE) return false;
+    if (header_size + payload_bytes + ALERT_CRC_SIZE != length) return false;
+    if (get32(in + length - ALERT_CRC_SIZE) != logCrc32(in, length - ALERT_CRC_SIZE)) return false;
+
+    const uint8_t* payload = in + header_size;
+    if (flags & ALERT_FLAG_LZ) {
+        if (lzDecompress(payload, payload_bytes, body, sizeof(body)) != body_bytes) return false;
+    } else {
+        if (payload_bytes != body_bytes) return false;
+        memcpy(body, payload, body_bytes);
+    }
+
+    memset(&data, 0, sizeof(data));
+    data.timestamp = get32(in + 4);
+    data.confidence = (FallConfidence_t)in[8];
+    data.confidence_score = in[9];
+    data.battery_level = get16(in + 10) / 10.0f;
+    data.sos_triggered = (flags & ALERT_FLAG_SOS) != 0;
+    size_t copy = id_length < sizeof(data.device_id) - 1 ? id_length : sizeof(data.device_id) - 1;
+    memcpy(data.device_id, in + ALERT_FIXED_HEADER_SIZE, copy);
+
+    // Field-major deltas back into samples
+    size_t position = 0;
+    for (uint8_t field = 0; field < LOG_FIELD_COUNT; field++) {
+        int32_t value = 0;
+        for (uint8_t s = 0; s < count; s++) {
+            uint32_t raw;
+            size_t used = readVarint(body + position, body_bytes - position, raw);
+            if (used == 0) return false;
+            position += used;
+            value = (int32_t)((uint32_t)value + (uint32_t)zigzagDecode(raw));
+
+            SensorData_t& sample = data.sensor_history[s];
+            switch (field) {
+                case LOG_FIELD_TIMESTAMP:  sample.timestamp = (uint32_t)value; break;
+                case LOG_FIELD_ACCEL_X:    sample.accel_x = logDequantize(field, value); break;
+                case LOG_FIELD_ACCEL_Y:    sample.accel_y = logDequantize(field, value); break;
+                case LOG_FIELD_ACCEL_Z:    sample.accel_z = logDequantize(field, value); break;
+                case LOG_FIELD_GYRO_X:     sample.gyro_x = logDequantize(field, value); break;
+                case LOG_FIELD_GYRO_Y:     sample.gyro_y = logDequantize(field, value); break;
+                case LOG_FIELD_GYRO_Z:     sample.gyro_z = logDequantize(field, value); break;
+                case LOG_FIELD_PRESSURE:   sample.pressure = logDequantize(field, value); break;
+                case LOG_FIELD_HEART_RATE: sample.heart_rate = logDequantize(field, value); break;
+                case LOG_FIELD_FSR:        sample.fsr_value = (uint16_t)value; break;
+            }
+            sample.valid = true;
+        }
+    }
+    if (position != body_bytes) return false;
+
+    data.history_count = count;
+    return true;
+}
+
+static uint16_t lzHash(const uint8_t* p) {
+    uint32_t v = p[0] | (p[1] << 8) | ((uint32_t)p[2] << 16);
+    return (uint16_t)((uint32_t)(v * 2654435761UL) >> (32 - ALERT_LZ_HASH_BITS));
+}
+
+size_t lzCompress(const uint8_t* in, size_t length, uint8_t* out, size_t capacity) {
+    if (length == 0 || length > 0xFFFF) return 0;
+    size_t limit = capacity < length - 1 ? capacity : length - 1;   // Must shrink
+    memset(lz_head, 0, sizeof(lz_head));
+
+    size_t ip = 0;
+    size_t op = 0;
+    while (ip < length) {
+        if (op + 1 > limit) return 0;
+        size_t flag_position = op++;
+        uint8_t flags = 0;
+
+        for (uint8_t bit = 0; bit < 8 && ip < length; bit++) {
+            size_t match_length = 0;
+            size_t match_offset = 0;
+
+            // Single candidate per hash: cheap, and enough for repeated delta runs
+            if (ip + ALERT_LZ_MIN_MATCH <= length) {
+                uint16_t hash = lzHash(in + ip);
+                size_t candidate = lz_head[hash];
+                lz_head[hash] = (uint16_t)(ip + 1);
+
+                if (candidate != 0 && ip - (candidate - 1) <= ALERT_LZ_WINDOW) {
+                    size_t from = candidate - 1;
+                    size_t max = length - ip < ALERT_LZ_MAX_MATCH ? length - ip : ALERT_LZ_MAX_MATCH;
+                    while (match_length < max && in[from + match_length] == in[ip + match_length]) {
+                        match_length++;
+                    }
+                    match_offset = ip - from;
+                }
+            }
+
+            if (match_length >= ALERT_LZ_MIN_MATCH) {
+                if (op + 2 > limit) return 0;
+                uint16_t token = (uint16_t)(((match_offset - 1) << 4) | (match_length - ALERT_LZ_MIN_MATCH));
+                out[op++] = (uint8_t)token;
+                out[op++] = (uint8_t)(token >> 8);
+                flags |= (uint8_t)(1 << bit);
+
+                // Index the covered positions so later runs can refer back into them
+                for (size_t k = 1; k < match_length && ip + k + ALERT_LZ_MIN_MATCH <= length; k++) {
+                    lz_head[lzHash(in + ip + k)] = (uint16_t)(ip + k + 1);
+                }
+                ip += match_length;
+            } else {
+                if (op + 1 > limit) return 0;
+                out[op++] = in[ip++];
+            }
+        }
+        out[flag_position] = flags;
+    }
+    return op;
+}
+
+size_t lzDecompress(const uint8_t* in, size_t length, uint8_t* out, size_t capacity) {
+    size_t ip = 0;
+    size_t op = 0;
+    while (ip < length) {
+        uint8_t flags = in[ip++];
+        for (uint8_t bit = 0; bit < 8 && ip < length; bit++) {
+            if (flags & (1 << bit)) {
+                if (ip + 2 > length) return 0;
+                uint16_t token = (uint16_t)(in[ip] | (in[ip + 1] << 8));
+                ip += 2;
+                size_t offset = (token >> 4) + 1;
+                size_t match_length = (token & 0x0F) + ALERT_LZ_MIN_MATCH;
+                if (offset > op || op + match_length > capacity) return 0;
+
+                // Byte by byte: a match may overlap its own output
+                for (size_t k = 0; k < match_length; k++, op++) {
+                    out[op] = out[op - offset];
+                }
+            } else {
+                if (op + 1 > capacity) return 0;
+                out[op++] = in[ip++];
+            }
+        }
+    }
+    return op;
+}
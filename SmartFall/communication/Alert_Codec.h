@@ -0,0 +1,85 @@
+#ifndef ALERT_CODEC_H
+#define ALERT_CODEC_H
+
+#include <Arduino.h>
+#include "../storage/Sample_Codec.h"
+#include "../utils/data_types.h"
+#include "../utils/config.h"
+
+/*
+ * Compact binary emergency alert, sent instead of JSON over both HTTP
+ * and BLE so the whole sensor history goes out in one message.
+ *
+ * Layout (little-endian):
+ *   magic u16, version u8, flags u8, timestamp u32,
+ *   confidence u8, confidence_score u8, battery u16 (0.1 %),
+ *   sample_count u8, body_bytes u16, payload_bytes u16,
+ *   device_id_length u8, device_id,
+ *   payload, crc32 u32 (over everything before it)
+ *
+ * The body holds the history field by field (all timestamps, then all
+ * accel_x, ...), in the data logger's quantized units. Each field starts
+ * absolute and continues as zigzag varint deltas, so a quiet channel is
+ * one byte per sample and long runs of identical bytes are left for the
+ * optional LZ pass. If the alert does not fit the caller's buffer, the
+ * oldest samples are dropped until it does.
+ *
+ * Size limit: sensor noise moves the low bits of every channel, so a
+ * 100 Hz sample still costs about 9.5 bytes (10 fields at about one
+ * varint byte each; LZ saves some 10%). The full 100-sample window is
+ * about 950 bytes, and only HTTP carries it whole. A BLE notification
+ * holds the newest samples that fit. That is about 19 (190 ms) at the
+ * common 247-byte MTU, 13 at 185 and 47 at 517 (alert_bench, synthetic
+ * trace). A smaller encoding would not change this much: even one byte
+ * per sample would leave most of the window out at MTU 247. The BLE
+ * alert is therefore a trigger with a short tail of context, and the
+ * history comes over WiFi, or from the log ring when logging is on.
+ *
+ * Where not even the header fits (the 23-byte default BLE MTU), the
+ * summary alert carries the header fields alone:
+ *   magic u16 (0xFA12), version u8, flags u8, timestamp u32,
+ *   confidence u8, confidence_score u8, battery u8 (%), crc32 u32
+ */
+
+#define ALERT_MAGIC              0xFA11
+#define ALERT_SUMMARY_MAGIC      0xFA12
+#define ALERT_VERSION            1
+#define ALERT_CONTENT_TYPE       "application/x-smartfall-alert"
+
+// Header flags
+#define ALERT_FLAG_LZ            0x01  // Payload is LZ-compressed body
+#define ALERT_FLAG_SOS           0x02  // Manual trigger
+
+#define ALERT_FIXED_HEADER_SIZE  18
+#define ALERT_CRC_SIZE           4
+#define ALERT_SUMMARY_SIZE       15
+#define ALERT_MAX_SAMPLES        SENSOR_HISTORY_SIZE
+#define ALERT_MAX_BODY_SIZE      (ALERT_MAX_SAMPLES * LOG_MAX_SAMPLE_BYTES)
+#define ALERT_BLE_MAX_SIZE       512   // Largest ATT attribute value
+
+// LZSS: a flag byte per 8 items; a match is 2 bytes (12-bit offset, 4-bit length)
+#define ALERT_LZ_WINDOW          4096
+#define ALERT_LZ_MIN_MATCH       3
+#define ALERT_LZ_MAX_MATCH       18
+#define ALERT_LZ_HASH_BITS       10
+
+// Encodes the newest samples of data.sensor_history that fit in capacity.
+// Returns the alert size, or 0 if not even the header fits. Calls are
+// serialized (shared static work buffers).
+size_t encodeAlert(const EmergencyData_t& data, uint8_t* out, size_t capacity, bool compress);
+
+// Header fields only, no device id or history. Returns 0 if capacity is
+// below ALERT_SUMMARY_SIZE.
+size_t encodeAlertSummary(const EmergencyData_t& data, uint8_t* out, size_t capacity);
+
+// Decodes an alert or a summary alert (server/host side). Restores
+// sensor_history and history_count; values are the quantized ones, not
+// the original floats. A summary decodes with no history and no device id.
+bool decodeAlert(const uint8_t* in, size_t length, EmergencyData_t& data);
+
+// Byte-level LZSS. compress returns 0 if the output would not be smaller
+// than the input or does not fit; decompress returns 0 on corrupt input.
+size_t lzCompress(const uint8_t* in, size_t length, uint8_t* out, size_t capacity);
+size_t lzDecompress(const uint8_t* in, size_t length, uint8_t* out, size_t capacity);
+
+#endif // ALERT_CODEC_H
@@ -1,5 +1,5 @@
 #include "BLE_Server.h"
-#include <ArduinoJson.h>
+#include "../diagnostics/Profiler.h"
 
 // Server Callbacks Implementation
 void BLE_Server::ServerCallbacks::onConnect(BLEServer* server) {
@@ -13,6 +13,8 @@ void BLE_Server::ServerCallbacks::onConnect(BLEServer* server) {
 
 void BLE_Server::ServerCallbacks::onDisconnect(BLEServer* server) {
     parent->device_connected = false;
+    parent->peer_mtu = BULK_DEFAULT_MTU;
+    parent->bulk_transfer.abort();  // Client resumes with a READ from its last offset
     Serial.println("[BLE] Client disconnected");
 
     if (parent->on_disconnect_callback != nullptr) {
@@ -23,6 +25,15 @@ void BLE_Server::ServerCallbacks::onDisconnect(BLEServer* server) {
     parent->startAdvertising();
 }
 
+void BLE_Server::ServerCallbacks::onMtuChanged(BLEServer* server, esp_ble_gatts_cb_param_t* param) {
+    parent->peer_mtu = param->mtu.mtu;
+
+    if (DEBUG_COMMUNICATION) {
+        Serial.print("[BLE] MTU negotiated: ");
+        Serial.println(parent->peer_mtu);
+    }
+}
+
 // Command Callbacks Implementation
 void BLE_Server::CommandCallbacks::onWrite(BLECharacteristic* characteristic) {
     std::string value = characteristic->getValue();
@@ -41,16 +52,80 @@ void BLE_Server::CommandCallbacks::onWrite(BLECharacteristic* characteristic) {
     }
 }
 
+// Config Callbacks Implementation
+void BLE_Server::ConfigCallbacks::onWrite(BLECharacteristic* characteristic) {
+    std::string value = characteristic->getValue();
+
+    if (DEBUG_COMMUNICATION) {
+        Serial.print("[BLE] Config write: ");
+        Serial.print(value.length());
+        Serial.println(" bytes");
+    }
+
+    if (value.length() > 0 && parent->on_config_callback != nullptr) {
+        parent->on_config_callback((const uint8_t*)value.data(), value.length());
+    }
+}
+
+// Bulk Transfer Implementation
+void BLE_Server::BulkCallbacks::onWrite(BLECharacteristic* characteristic) {
+    std::string value = characteristic->getValue();
+    parent->bulk_transfer.submitRequest((const uint8_t*)value.data(), value.length());
+}
+
+bool BLE_Server::BulkLink::send(const uint8_t* data, size_t length) {
+    if (parent->bulk_char == nullptr || !parent->device_connected) {
+        return false;
+    }
+
+    // notify() silently drops when the controller queue is full
+    if (esp_ble_get_cur_sendable_packets_num(parent->ble_server->getConnId()) == 0) {
+        return false;
+    }
+
+    parent->bulk_char->setValue((uint8_t*)data, length);
+    parent->bulk_char->notify();
+    return true;
+}
+
+uint16_t BLE_Server::BulkLink::getMTU() {
+    return parent->peer_mtu;
+}
+
+bool BLE_Server::EmergencyLink::send(const uint8_t* data, size_t length) {
+    if (parent->emergency_char == nullptr || !parent->device_connected) {
+        return false;
+    }
+
+    // A notification dropped here would only be recovered by the resend timeout
+    if (esp_ble_get_cur_sendable_packets_num(parent->ble_server->getConnId()) == 0) {
+        return false;
+    }
+
+    return parent->notifyCharacteristic(parent->emergency_char, (uint8_t*)data, length);
+}
+
+uint16_t BLE_Server::EmergencyLink::getMTU() {
+    return parent->peer_mtu;
+}
+
 // BLE_Server Implementation
 BLE_Server::BLE_Server() : initialized(false), device_connected(false),
                              streaming_enabled(false), last_notification(0),
-                             notification_interval(1000), device_name("SmartFall"),
+                             notification_interval(1000), peer_mtu(BULK_DEFAULT_MTU),
+                             device_name("SmartFall"),
                              ble_server(nullptr), ble_service(nullptr),
                              emergency_char(nullptr), sensor_char(nullptr),
                              status_char(nullptr), command_char(nullptr),
-                             config_char(nullptr), on_connect_callback(nullptr),
+                             config_char(nullptr), bulk_char(nullptr), on_connect_callback(nullptr),
                              on_disconnect_callback(nullptr), on_command_callback(nullptr),
-                             server_callbacks(nullptr), command_callbacks(nullptr) {
+                             on_config_callback(nullptr),
+                             server_callbacks(nullptr), command_callbacks(nullptr),
+                             config_callbacks(nullptr), bulk_callbacks(nullptr), bulk_link(this), bulk_transfer(&bulk_link),
+                             emergency_link(this), alert_ack(&emergency_link), status_mutex(nullptr) {
+    json_buffer[0] = '\0';
+    status_buffer[0] = '\0';
+    alert_buffer[0] = '\0';
 }
 
 BLE_Server::~BLE_Server() {
@@ -69,12 +144,23 @@ bool BLE_Server::begin(const char* name) {
 
     device_name = String(name);
 
+    if (status_mutex == nullptr) {
+        status_mutex = xSemaphoreCreateMutex();
+    }
+
     Serial.print("[BLE] Initializing as: ");
     Serial.println(device_name);
 
     // Initialize BLE Device
     BLEDevice::init(device_name.c_str());
 
+    // Sequence numbers restart at a random point each boot, so the app
+    // never mistakes a new alert for a copy of one from before a reset
+    alert_ack.setSequence((uint16_t)esp_random());
+
+    // Allow 512-byte notifications; the peer picks the final MTU
+    BLEDevice::setMTU(BLE_LOCAL_MTU);
+
     // Create BLE Server
     ble_server = BLEDevice::createServer();
 
@@ -109,6 +195,8 @@ void BLE_Server::end() {
 
         if (server_callbacks) delete server_callbacks;
         if (command_callbacks) delete command_callbacks;
+        if (config_callbacks) delete config_callbacks;
+        if (bulk_callbacks) delete bulk_callbacks;
 
         Serial.println("[BLE] Service stopped");
     }
@@ -138,7 +226,7 @@ void BLE_Server::stopAdvertising() {
     }
 }
 
-bool BLE_Server::sendEmergencyAlert(const EmergencyData_t& emergency_data) {
+bool BLE_Server::sendEmergencyAlert(const EmergencyData_t& emergency_data, uint32_t timeout_ms) {
     if (!initialized || !device_connected) {
         if (DEBUG_COMMUNICATION) {
             Serial.println("[BLE] Cannot send alert - not connected");
@@ -146,23 +234,58 @@ bool BLE_Server::sendEmergencyAlert(const EmergencyData_t& emergency_data) {
         return false;
     }
 
-    String json_payload = createEmergencyJSON(emergency_data);
+    // One notification, never larger than the MTU: the stack would cut it
+    // short. The binary alert drops its oldest samples to fit (about 19
+    // of 100 at MTU 247, see Alert_Codec.h); where not even its header
+    // fits (or JSON is configured and too long), the summary alert goes
+    // instead
+    size_t capacity = getAlertCapacity();
+    size_t length = 0;
+    if (EMERGENCY_BINARY_PAYLOAD) {
+        length = createEmergencyBinary(emergency_data, capacity);
+    } else {
+        length = createEmergencyJSON(emergency_data);
+        if (length > capacity) length = 0;
+    }
+    if (length == 0) {
+        length = createEmergencySummary(emergency_data, capacity);
+    }
+    if (length == 0) {
+        Serial.println("[BLE] ERROR: MTU too small for the alert summary!");
+        return false;
+    }
+
+    uint16_t sequence = alert_ack.start((uint8_t*)alert_buffer, ALERT_ACK_HEADER_SIZE + length);
 
     if (DEBUG_COMMUNICATION) {
-        Serial.println("[BLE] Sending emergency alert...");
+        Serial.print("[BLE] Sending emergency alert #");
+        Serial.println(sequence);
     }
 
-    bool success = notifyCharacteristic(emergency_char,
-                                       (uint8_t*)json_payload.c_str(),
-                                       json_payload.length());
+    // Resent on the ACK timeout until the app confirms, the link drops,
+    // or the caller's deadline passes
+    uint32_t start = millis();
+    AlertAckState_t state = alert_ack.service();
+    while (state == ALERT_ACK_WAITING) {
+        if (!device_connected || millis() - start >= timeout_ms) {
+            alert_ack.cancel();
+            state = ALERT_ACK_FAILED;
+            break;
+        }
+        delay(ALERT_ACK_POLL_MS);
+        state = alert_ack.service();
+    }
 
-    if (success) {
-        Serial.println("[BLE] ✓ Emergency alert sent");
-    } else {
-        Serial.println("[BLE] ✗ Failed to send alert");
+    if (state == ALERT_ACK_CONFIRMED) {
+        const AlertAckStats_t& stats = alert_ack.getStats();
+        Serial.print("[BLE] ✓ Emergency alert acknowledged in ");
+        Serial.print(stats.last_confirm_ms);
+        Serial.println(" ms");
+        return true;
     }
 
-    return success;
+    Serial.println("[BLE] ✗ Emergency alert not acknowledged");
+    return false;
 }
 
 bool BLE_Server::sendSensorData(const SensorData_t& sensor_data) {
@@ -174,10 +297,10 @@ bool BLE_Server::sendSensorData(const SensorData_t& sensor_data) {
         return false;
     }
 
-    String json_payload = createSensorDataJSON(sensor_data);
-    return notifyCharacteristic(sensor_char,
-                               (uint8_t*)json_payload.c_str(),
-                               json_payload.length());
+    size_t length = createSensorDataJSON(sensor_data);
+    if (length == 0) return false;
+
+    return notifyCharacteristic(sensor_char, (uint8_t*)json_buffer, length);
 }
 
 bool BLE_Server::sendStatusUpdate(const SystemStatus_t& status_data) {
@@ -185,10 +308,22 @@ bool BLE_Server::sendStatusUpdate(const SystemStatus_t& status_data) {
         return false;
     }
 
-    String json_payload = createStatusJSON(status_data);
-    return notifyCharacteristic(status_char,
-                               (uint8_t*)json_payload.c_str(),
-                               json_payload.length());
+    // Skipped rather than queued behind the other sender; status is resent every interval
+    if (status_mutex == nullptr || xSemaphoreTake(status_mutex, pdMS_TO_TICKS(BLE_STATUS_LOCK_MS)) != pdTRUE) {
+        return false;
+    }
+    size_t length = createStatusJSON(status_data);
+    bool success = length > 0 && notifyCharacteristic(status_char, (uint8_t*)status_buffer, length);
+    xSemaphoreGive(status_mutex);
+    return success;
+}
+
+bool BLE_Server::sendDiagnostics(const uint8_t* data, size_t length) {
+    if (!initialized || !device_connected || length == 0) {
+        return false;
+    }
+
+    return notifyCharacteristic(status_char, (uint8_t*)data, length);
 }
 
 void BLE_Server::enableStreaming(bool enable) {
@@ -222,6 +357,23 @@ bool BLE_Server::shouldStream() {
     return false;
 }
 
+void BLE_Server::setBulkSource(BulkOpenFn_t open, BulkReadFn_t read) {
+    bulk_transfer.setSource(open, read);
+}
+
+void BLE_Server::serviceBulkTransfer() {
+    if (!initialized) return;
+    bulk_transfer.service();
+}
+
+bool BLE_Server::isBulkActive() {
+    return bulk_transfer.isActive();
+}
+
+uint16_t BLE_Server::getPeerMTU() {
+    return peer_mtu;
+}
+
 void BLE_Server::onConnect(void (*callback)()) {
     on_connect_callback = callback;
 }
@@ -234,6 +386,15 @@ void BLE_Server::onCommand(void (*callback)(uint8_t, uint8_t*, size_t)) {
     on_command_callback = callback;
 }
 
+void BLE_Server::onConfigWrite(void (*callback)(const uint8_t*, size_t)) {
+    on_config_callback = callback;
+}
+
+void BLE_Server::setConfigValue(const uint8_t* data, size_t length) {
+    if (config_char == nullptr) return;
+    config_char->setValue((uint8_t*)data, length);
+}
+
 String BLE_Server::getDeviceName() {
     return device_name;
 }
@@ -250,7 +411,11 @@ void BLE_Server::printConnectionInfo() {
     Serial.println(device_connected ? "Connected" : "Advertising");
     Serial.print("Streaming: ");
     Serial.println(streaming_enabled ? "Enabled" : "Disabled");
+    Serial.print("MTU: ");
+    Serial.println(peer_mtu);
     Serial.println("===========================");
+    bulk_transfer.printStats();
+    alert_ack.printStats();
 }
 
 // Private helper functions
@@ -290,6 +455,18 @@ void BLE_Server::createCharacteristics() {
         CONFIG_CHARACTERISTIC,
         BLECharacteristic::PROPERTY_READ | BLECharacteristic::PROPERTY_WRITE
     );
+    config_callbacks = new ConfigCallbacks(this);
+    config_char->setCallbacks(config_callbacks);
+
+    // Bulk Transfer Characteristic (Write requests, Notify chunks)
+    bulk_char = ble_service->createCharacteristic(
+        BULK_CHARACTERISTIC,
+        BLECharacteristic::PROPERTY_WRITE | BLECharacteristic::PROPERTY_WRITE_NR |
+        BLECharacteristic::PROPERTY_NOTIFY
+    );
+    bulk_char->addDescriptor(new BLE2902());
+    bulk_callbacks = new BulkCallbacks(this);
+    bulk_char->setCallbacks(bulk_callbacks);
 }
 
 void BLE_Server::handleCommand(uint8_t command, uint8_t* data, size_t length) {
@@ -320,6 +497,30 @@ void BLE_Server::handleCommand(uint8_t command, uint8_t* data, size_t length) {
             enableStreaming(false);
             break;
 
+        case BLE_CMD_GET_PROFILE:
+            Serial.println("[BLE] Command: Get Profile");
+            break;
+
+        case BLE_CMD_START_LOGGING:
+            Serial.println("[BLE] Command: Start Logging");
+            break;
+
+        case BLE_CMD_STOP_LOGGING:
+            Serial.println("[BLE] Command: Stop Logging");
+            break;
+
+        case BLE_CMD_DUMP_LOG:
+            Serial.println("[BLE] Command: Dump Log");
+            break;
+
+        case BLE_CMD_ERASE_LOG:
+            Serial.println("[BLE] Command: Erase Log");
+            break;
+
+        case BLE_CMD_ALERT_ACK:
+            alert_ack.submitAck(data, length);
+            break;
+
         default:
             Serial.print("[BLE] Unknown command: 0x");
             Serial.println(command, HEX);
@@ -337,6 +538,8 @@ bool BLE_Server::notifyCharacteristic(BLECharacteristic* characteristic, uint8_t
         return false;
     }
 
+    PROFILE_SCOPE(PROFILE_BLE_NOTIFY);
+
     try {
         characteristic->setValue(data, length);
         characteristic->notify();
@@ -347,53 +550,31 @@ bool BLE_Server::notifyCharacteristic(BLECharacteristic* characteristic, uint8_t
     }
 }
 
-String BLE_Server::createEmergencyJSON(const EmergencyData_t& data) {
-    DynamicJsonDocument doc(2048);
-
-    doc["type"] = "emergency";
-    doc["timestamp"] = data.timestamp;
-    doc["confidence_score"] = data.confidence_score;
-    doc["confidence_level"] = data.confidence;
-    doc["battery_level"] = data.battery_level;
-    doc["sos_triggered"] = data.sos_triggered;
-    doc["device_id"] = String(data.device_id);
-
-    String json_string;
-    serializeJson(doc, json_string);
-    return json_string;
+size_t BLE_Server::createEmergencyJSON(const EmergencyData_t& data) {
+    return writeBLEEmergencyJSON(data, alert_buffer + ALERT_ACK_HEADER_SIZE,
+                                 sizeof(alert_buffer) - ALERT_ACK_HEADER_SIZE);
 }
 
-String BLE_Server::createSensorDataJSON(const SensorData_t& data) {
-    DynamicJsonDocument doc(512);
-
-    doc["type"] = "sensor";
-    doc["timestamp"] = data.timestamp;
-    doc["accel_x"] = data.accel_x;
-    doc["accel_y"] = data.accel_y;
-    doc["accel_z"] = data.accel_z;
-    doc["gyro_x"] = data.gyro_x;
-    doc["gyro_y"] = data.gyro_y;
-    doc["gyro_z"] = data.gyro_z;
-    doc["heart_rate"] = data.heart_rate;
-    doc["pressure"] = data.pressure;
+size_t BLE_Server::createEmergencyBinary(const EmergencyData_t& data, size_t capacity) {
+    return encodeAlert(data, (uint8_t*)alert_buffer + ALERT_ACK_HEADER_SIZE, capacity, EMERGENCY_PAYLOAD_LZ);
+}
 
-    String json_string;
-    serializeJson(doc, json_string);
-    return json_string;
+size_t BLE_Server::createEmergencySummary(const EmergencyData_t& data, size_t capacity) {
+    return encodeAlertSummary(data, (uint8_t*)alert_buffer + ALERT_ACK_HEADER_SIZE, capacity);
 }
 
-String BLE_Server::createStatusJSON(const SystemStatus_t& data) {
-    DynamicJsonDocument doc(512);
+size_t BLE_Server::getAlertCapacity() {
+    // Notification value: MTU minus the 3-byte ATT header, then the Alert_Ack frame header
+    size_t capacity = peer_mtu > 3 + ALERT_ACK_HEADER_SIZE ? peer_mtu - 3 - ALERT_ACK_HEADER_SIZE : 0;
+    if (capacity > ALERT_BLE_MAX_SIZE - ALERT_ACK_HEADER_SIZE) capacity = ALERT_BLE_MAX_SIZE - ALERT_ACK_HEADER_SIZE;
+    if (capacity > sizeof(alert_buffer) - ALERT_ACK_HEADER_SIZE) capacity = sizeof(alert_buffer) - ALERT_ACK_HEADER_SIZE;
+    return capacity;
+}
 
-    doc["type"] = "status";
-    doc["sensors_initialized"] = data.sensors_initialized;
-    doc["wifi_connected"] = data.wifi_connected;
-    doc["bluetooth_connected"] = data.bluetooth_connected;
-    doc["battery_percentage"] = data.battery_percentage;
-    doc["current_status"] = data.current_status;
-    doc["uptime_ms"] = data.uptime_ms;
+size_t BLE_Server::createSensorDataJSON(const SensorData_t& data) {
+    return writeBLESensorJSON(data, json_buffer, sizeof(json_buffer));
+}
 
-    String json_string;
-    serializeJson(doc, json_string);
-    return json_string;
+size_t BLE_Server::createStatusJSON(const SystemStatus_t& data) {
+    return writeBLEStatusJSON(data, status_buffer, sizeof(status_buffer));
 }
@@ -8,6 +8,10 @@
 #include <BLE2902.h>
 #include "../utils/data_types.h"
 #include "../utils/config.h"
+#include "JSON_Writer.h"
+#include "Bulk_Transfer.h"
+#include "Alert_Codec.h"
+#include "Alert_Ack.h"
 
 // SmartFall BLE Service UUIDs
 #define SERVICE_UUID                "4fafc201-1fb5-459e-8fcc-c5c9c331914b"
@@ -16,6 +20,10 @@
 #define STATUS_CHARACTERISTIC       "beb54840-36e1-4688-b7f5-ea07361b26a8"
 #define COMMAND_CHARACTERISTIC      "beb54841-36e1-4688-b7f5-ea07361b26a8"
 #define CONFIG_CHARACTERISTIC       "beb54842-36e1-4688-b7f5-ea07361b26a8"
+#define BULK_CHARACTERISTIC         "beb54843-36e1-4688-b7f5-ea07361b26a8"
+
+#define BLE_LOCAL_MTU               517   // 512-byte notifications + ATT header
+#define BLE_STATUS_LOCK_MS          100   // Status senders only format and notify under the lock
 
 // BLE Commands
 #define BLE_CMD_CANCEL_ALERT        0x01
@@ -24,6 +32,12 @@
 #define BLE_CMD_SET_CONFIG          0x04
 #define BLE_CMD_START_STREAMING     0x05
 #define BLE_CMD_STOP_STREAMING      0x06
+#define BLE_CMD_GET_PROFILE         0x07
+#define BLE_CMD_START_LOGGING       0x08
+#define BLE_CMD_STOP_LOGGING        0x09
+#define BLE_CMD_DUMP_LOG            0x0A
+#define BLE_CMD_ERASE_LOG           0x0B
+#define BLE_CMD_ALERT_ACK           0x0C   // [seq u16, attempt u8], see Alert_Ack.h
 
 class BLE_Server {
 private:
@@ -32,6 +46,7 @@ private:
     bool streaming_enabled;
     uint32_t last_notification;
     uint32_t notification_interval;
+    uint16_t peer_mtu;
 
     String device_name;
 
@@ -43,11 +58,13 @@ private:
     BLECharacteristic* status_char;
     BLECharacteristic* command_char;
     BLECharacteristic* config_char;
+    BLECharacteristic* bulk_char;
 
     // Callback functions
     void (*on_connect_callback)();
     void (*on_disconnect_callback)();
     void (*on_command_callback)(uint8_t command, uint8_t* data, size_t length);
+    void (*on_config_callback)(const uint8_t* data, size_t length);
 
     // Server callbacks
     class ServerCallbacks : public BLEServerCallbacks {
@@ -57,6 +74,7 @@ private:
         ServerCallbacks(BLE_Server* p) : parent(p) {}
         void onConnect(BLEServer* server);
         void onDisconnect(BLEServer* server);
+        void onMtuChanged(BLEServer* server, esp_ble_gatts_cb_param_t* param);
     };
 
     // Characteristic callbacks
@@ -68,8 +86,57 @@ private:
         void onWrite(BLECharacteristic* characteristic);
     };
 
+    class ConfigCallbacks : public BLECharacteristicCallbacks {
+    private:
+        BLE_Server* parent;
+    public:
+        ConfigCallbacks(BLE_Server* p) : parent(p) {}
+        void onWrite(BLECharacteristic* characteristic);
+    };
+
+    class BulkCallbacks : public BLECharacteristicCallbacks {
+    private:
+        BLE_Server* parent;
+    public:
+        BulkCallbacks(BLE_Server* p) : parent(p) {}
+        void onWrite(BLECharacteristic* characteristic);
+    };
+
+    // Bulk characteristic as a Bulk_Transfer transport
+    class BulkLink : public Bulk_Link {
+    private:
+        BLE_Server* parent;
+    public:
+        BulkLink(BLE_Server* p) : parent(p) {}
+        bool send(const uint8_t* data, size_t length) override;
+        uint16_t getMTU() override;
+    };
+
+    // Emergency characteristic as the Alert_Ack transport
+    class EmergencyLink : public Bulk_Link {
+    private:
+        BLE_Server* parent;
+    public:
+        EmergencyLink(BLE_Server* p) : parent(p) {}
+        bool send(const uint8_t* data, size_t length) override;
+        uint16_t getMTU() override;
+    };
+
     ServerCallbacks* server_callbacks;
     CommandCallbacks* command_callbacks;
+    ConfigCallbacks* config_callbacks;
+    BulkCallbacks* bulk_callbacks;
+
+    BulkLink bulk_link;
+    Bulk_Transfer bulk_transfer;
+    EmergencyLink emergency_link;
+    Alert_Ack alert_ack;
+
+    // Static payload buffers: sensor stream (sensor task) and status (comms task, BLE commands)
+    char json_buffer[JSON_BLE_BUFFER_SIZE];
+    char status_buffer[JSON_BLE_BUFFER_SIZE];
+    SemaphoreHandle_t status_mutex;     // Status has two senders
+    char alert_buffer[ALERT_ACK_HEADER_SIZE + JSON_BLE_BUFFER_SIZE];   // Framed emergency alert (alert dispatch task)
 
 public:
     BLE_Server();
@@ -86,9 +153,11 @@ public:
     void stopAdvertising();
 
     // Data transmission
-    bool sendEmergencyAlert(const EmergencyData_t& emergency_data);
+    bool sendEmergencyAlert(const EmergencyData_t& emergency_data,
+                            uint32_t timeout_ms = ALERT_BLE_DEADLINE_MS);  // Blocks until the app ACKs
     bool sendSensorData(const SensorData_t& sensor_data);
     bool sendStatusUpdate(const SystemStatus_t& status_data);
+    bool sendDiagnostics(const uint8_t* data, size_t length);  // Raw payload on status characteristic
 
     // Streaming mode
     void enableStreaming(bool enable = true);
@@ -96,10 +165,20 @@ public:
     void setStreamingInterval(uint32_t interval_ms);
     bool shouldStream();  // Check if it's time to stream
 
+    // Bulk download (log ring)
+    void setBulkSource(BulkOpenFn_t open, BulkReadFn_t read);
+    void serviceBulkTransfer();   // Call frequently; sends the next window of chunks
+    bool isBulkActive();
+    uint16_t getPeerMTU();
+
     // Callback registration
     void onConnect(void (*callback)());
     void onDisconnect(void (*callback)());
     void onCommand(void (*callback)(uint8_t command, uint8_t* data, size_t length));
+    void onConfigWrite(void (*callback)(const uint8_t* data, size_t length));
+
+    // Config characteristic read value (encoded by Config_Store)
+    void setConfigValue(const uint8_t* data, size_t length);
 
     // Utility functions
     String getDeviceName();
@@ -113,13 +192,20 @@ private:
     bool notifyCharacteristic(BLECharacteristic* characteristic, uint8_t* data, size_t length);
 
     // JSON conversion helpers
-    String createEmergencyJSON(const EmergencyData_t& data);
-    String createSensorDataJSON(const SensorData_t& data);
-    String createStatusJSON(const SystemStatus_t& data);
+    size_t createEmergencyJSON(const EmergencyData_t& data);
+    size_t createEmergencyBinary(const EmergencyData_t& data, size_t capacity);
+    size_t createEmergencySummary(const EmergencyData_t& data, size_t capacity);
+    size_t getAlertCapacity();      // Alert payload bytes one notification can carry
+    size_t createSensorDataJSON(const SensorData_t& data);
+    size_t createStatusJSON(const SystemStatus_t& data);
 
     // Friend classes for callbacks
     friend class ServerCallbacks;
     friend class CommandCallbacks;
+    friend class ConfigCallbacks;
+    friend class BulkCallbacks;
+    friend class BulkLink;
+    friend class EmergencyLink;
 };
 
 #endif // BLE_SERVER_H
@@ -0,0 +1,295 @@
+#include "Bulk_Transfer.h"
+
+uint32_t bulkMillis() {
+    return (uint32_t)millis();
+}
+
+Bulk_Transfer::Bulk_Transfer(Bulk_Link* transport, BulkClock_t clock)
+    : link(transport), open_source(nullptr), read_source(nullptr), clock_ms(clock),
+      active(false), source_size(0), start_offset(0), end_offset(0), next_offset(0), sent_high(0),
+      acked_offset(0), chunk_size(0), window(BULK_DEFAULT_WINDOW),
+      last_progress_time(0), start_time(0), request_length(0), request_pending(false) {
+    memset(&stats, 0, sizeof(stats));
+#ifdef ARDUINO
+    request_mux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+}
+
+void Bulk_Transfer::setSource(BulkOpenFn_t open, BulkReadFn_t read) {
+    open_source = open;
+    read_source = read;
+}
+
+void Bulk_Transfer::submitRequest(const uint8_t* data, size_t length) {
+    if (length == 0 || length > BULK_MAX_REQUEST_SIZE) return;
+
+#ifdef ARDUINO
+    portENTER_CRITICAL(&request_mux);
+#endif
+    // ACKs are cumulative, so a newer one may replace a pending one; other
+    // requests are never overwritten by an ACK
+    if (!request_pending || request[0] == BULK_OP_ACK || data[0] != BULK_OP_ACK) {
+        memcpy(request, data, length);
+        request_length = length;
+        request_pending = true;
+    }
+#ifdef ARDUINO
+    portEXIT_CRITICAL(&request_mux);
+#endif
+}
+
+bool Bulk_Transfer::service() {
+    uint8_t pending[BULK_MAX_REQUEST_SIZE];
+    size_t pending_length = 0;
+
+#ifdef ARDUINO
+    portENTER_CRITICAL(&request_mux);
+#endif
+    if (request_pending) {
+        pending_length = request_length;
+        memcpy(pending, request, pending_length);
+        request_pending = false;
+    }
+#ifdef ARDUINO
+    portEXIT_CRITICAL(&request_mux);
+#endif
+
+    if (pending_length > 0) {
+        handleRequest(pending, pending_length);
+    }
+
+    if (!active) return false;
+
+    // Everything acknowledged
+    if (acked_offset >= end_offset) {
+        sendEnd();
+        return false;
+    }
+
+    // No ACK progress: the tail of the window or the ACK was lost
+    uint32_t now = clock_ms();
+    if (now - last_progress_time >= BULK_ACK_TIMEOUT_MS) {
+        if (next_offset > acked_offset) {
+            stats.rewinds++;
+            next_offset = acked_offset;
+        }
+        last_progress_time = now;
+    }
+
+    uint32_t window_bytes = (uint32_t)window * chunk_size;
+    while (active && next_offset < end_offset && next_offset - acked_offset < window_bytes) {
+        if (!sendChunk()) break;
+    }
+
+    return active;
+}
+
+void Bulk_Transfer::abort() {
+    active = false;
+}
+
+uint16_t Bulk_Transfer::getChunkSize() {
+    uint16_t mtu = link ? link->getMTU() : BULK_DEFAULT_MTU;
+    if (mtu < BULK_DEFAULT_MTU) mtu = BULK_DEFAULT_MTU;
+
+    uint16_t notify_size = mtu - BULK_ATT_OVERHEAD;
+    if (notify_size > BULK_MAX_NOTIFY_SIZE) notify_size = BULK_MAX_NOTIFY_SIZE;
+
+    return notify_size - BULK_CHUNK_HEADER_SIZE;
+}
+
+void Bulk_Transfer::printStats() {
+    Serial.println("=== Bulk Transfer ===");
+    Serial.print("Transfers: ");
+    Serial.print(stats.transfers);
+    Serial.print(" | Chunks: ");
+    Serial.print(stats.chunks_sent);
+    Serial.print(" | Rewinds: ");
+    Serial.println(stats.rewinds);
+    Serial.print("Resent: ");
+    Serial.print(stats.resent_bytes);
+    Serial.print(" B | Link busy: ");
+    Serial.println(stats.link_busy);
+    if (stats.last_duration_ms > 0) {
+        Serial.print("Last: ");
+        Serial.print(stats.last_size);
+        Serial.print(" B in ");
+        Serial.print(stats.last_duration_ms);
+        Serial.print(" ms (");
+        Serial.print(stats.last_size / stats.last_duration_ms);
+        Serial.println(" KB/s)");
+    }
+    Serial.println("=====================");
+}
+
+uint16_t Bulk_Transfer::crc16(const uint8_t* data, size_t length, uint16_t crc) {
+    // CRC-16/CCITT-FALSE
+    for (size_t i = 0; i < length; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+// Private helper functions
+
+void Bulk_Transfer::handleRequest(const uint8_t* data, size_t length) {
+    switch (data[0]) {
+        case BULK_OP_GET_INFO:
+            if (open_source == nullptr) {
+                sendError(BULK_ERROR_NO_SOURCE);
+                break;
+            }
+            source_size = open_source();
+            if (source_size == BULK_SOURCE_BUSY) {
+                retryRequest(data, length);
+                break;
+            }
+            sendInfo();
+            break;
+
+        case BULK_OP_READ: {
+            if (length < 10) break;
+            if (open_source == nullptr || read_source == nullptr) {
+                sendError(BULK_ERROR_NO_SOURCE);
+                break;
+            }
+
+            source_size = open_source();
+            if (source_size == BULK_SOURCE_BUSY) {
+                retryRequest(data, length);
+                break;
+            }
+            uint32_t offset = bulkGet32(data + 1);
+            uint32_t request_length = bulkGet32(data + 5);
+            if (offset > source_size) {
+                sendError(BULK_ERROR_RANGE);
+                active = false;
+                break;
+            }
+
+            uint32_t remaining = source_size - offset;
+            end_offset = offset + ((request_length == 0 || request_length > remaining) ? remaining : request_length);
+            start_offset = offset;
+            next_offset = offset;
+            acked_offset = offset;
+            sent_high = offset;
+
+            window = data[9];
+            if (window == 0) window = BULK_DEFAULT_WINDOW;
+            if (window > BULK_MAX_WINDOW) window = BULK_MAX_WINDOW;
+
+            chunk_size = getChunkSize();
+            start_time = clock_ms();
+            last_progress_time = start_time;
+            active = true;
+            stats.transfers++;
+            break;
+        }
+
+        case BULK_OP_ACK: {
+            if (!active || length < 6) break;
+            uint32_t offset = bulkGet32(data + 1);
+            uint8_t flags = data[5];
+
+            if (offset > sent_high) offset = sent_high;
+            if (offset > acked_offset) {
+                acked_offset = offset;
+                last_progress_time = clock_ms();
+            }
+
+            // Go back to the first missing byte
+            if ((flags & BULK_ACK_FLAG_NAK) && next_offset > acked_offset) {
+                stats.rewinds++;
+                next_offset = acked_offset;
+                last_progress_time = clock_ms();
+            }
+            break;
+        }
+
+        case BULK_OP_ABORT:
+            active = false;
+            break;
+
+        default:
+            break;
+    }
+}
+
+// Back into the mailbox for the next service(), unless a newer request came in
+void Bulk_Transfer::retryRequest(const uint8_t* data, size_t length) {
+#ifdef ARDUINO
+    portENTER_CRITICAL(&request_mux);
+#endif
+    if (!request_pending) {
+        memcpy(request, data, length);
+        request_length = length;
+        request_pending = true;
+    }
+#ifdef ARDUINO
+    portEXIT_CRITICAL(&request_mux);
+#endif
+}
+
+void Bulk_Transfer::sendInfo() {
+    packet[0] = BULK_MSG_INFO;
+    bulkPut32(packet + 1, source_size);
+    bulkPut16(packet + 5, link->getMTU());
+    bulkPut16(packet + 7, getChunkSize());
+    packet[9] = BULK_MAX_WINDOW;
+    link->send(packet, 10);
+}
+
+void Bulk_Transfer::sendEnd() {
+    packet[0] = BULK_MSG_END;
+    bulkPut32(packet + 1, end_offset);
+    if (!link->send(packet, 5)) {
+        stats.link_busy++;
+        return;   // Retried on the next service()
+    }
+
+    active = false;
+    stats.last_duration_ms = clock_ms() - start_time;
+    stats.last_size = end_offset - start_offset;
+}
+
+void Bulk_Transfer::sendError(uint8_t code) {
+    packet[0] = BULK_MSG_ERROR;
+    packet[1] = code;
+    link->send(packet, 2);
+}
+
+bool Bulk_Transfer::sendChunk() {
+    uint32_t remaining = end_offset - next_offset;
+    uint16_t length = remaining < chunk_size ? (uint16_t)remaining : chunk_size;
+    uint8_t* payload = packet + BULK_CHUNK_HEADER_SIZE;
+
+    if (!read_source(next_offset, payload, length)) {
+        sendError(BULK_ERROR_READ);
+        active = false;
+        return false;
+    }
+
+    packet[0] = BULK_MSG_DATA;
+    bulkPut32(packet + 1, next_offset);
+    bulkPut16(packet + 5, crc16(payload, length));
+
+    if (!link->send(packet, BULK_CHUNK_HEADER_SIZE + length)) {
+        stats.link_busy++;
+        return false;
+    }
+
+    if (next_offset < sent_high) {
+        uint32_t resent = sent_high - next_offset;
+        stats.resent_bytes += resent < length ? resent : length;
+    }
+
+    next_offset += length;
+    if (next_offset > sent_high) sent_high = next_offset;
+
+    stats.chunks_sent++;
+    stats.bytes_sent += length;
+    return true;
+}
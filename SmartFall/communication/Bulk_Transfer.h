@@ -0,0 +1,163 @@
+#ifndef BULK_TRANSFER_H
+#define BULK_TRANSFER_H
+
+#include <Arduino.h>
+
+/*
+ * Windowed bulk download protocol (log ring over BLE).
+ *
+ * Client -> device (write to the bulk characteristic):
+ *   GET_INFO  [0x01]
+ *   READ      [0x02, offset u32, length u32 (0 = to end), window u8]
+ *   ACK       [0x03, offset u32 (all bytes below received), flags u8]
+ *   ABORT     [0x04]
+ *
+ * Device -> client (notifications):
+ *   INFO      [0x81, size u32, mtu u16, chunk u16, max window u8]
+ *   DATA      [0x82, offset u32, crc16 u16, payload...]
+ *   END       [0x83, end offset u32]
+ *   ERROR     [0x84, code u8]
+ *
+ * Chunks fill the negotiated MTU (up to 512-byte notifications). At most
+ * `window` chunks are unacknowledged. A NAK or an ACK timeout makes the
+ * device go back to the last acknowledged offset. Resume after a
+ * disconnect is a new READ from the last good offset. All integers are
+ * little-endian. A GET_INFO or READ that arrives while the source is
+ * still settling is held and answered once it is ready.
+ */
+
+#define BULK_OP_GET_INFO          0x01
+#define BULK_OP_READ              0x02
+#define BULK_OP_ACK               0x03
+#define BULK_OP_ABORT             0x04
+
+#define BULK_MSG_INFO             0x81
+#define BULK_MSG_DATA             0x82
+#define BULK_MSG_END              0x83
+#define BULK_MSG_ERROR            0x84
+
+#define BULK_ACK_FLAG_NAK         0x01   // Gap or CRC error: resend from offset
+
+#define BULK_ERROR_NO_SOURCE      0x01
+#define BULK_ERROR_RANGE          0x02
+#define BULK_ERROR_READ           0x03
+
+#define BULK_ATT_OVERHEAD         3      // ATT opcode + handle
+#define BULK_DEFAULT_MTU          23
+#define BULK_MAX_NOTIFY_SIZE      512    // ATT attribute value limit
+#define BULK_CHUNK_HEADER_SIZE    7      // type + offset + crc16
+#define BULK_MAX_CHUNK_SIZE       (BULK_MAX_NOTIFY_SIZE - BULK_CHUNK_HEADER_SIZE)
+#define BULK_DEFAULT_WINDOW       8
+#define BULK_MAX_WINDOW           32
+#define BULK_ACK_TIMEOUT_MS       1000
+#define BULK_MAX_REQUEST_SIZE     16
+#define BULK_SOURCE_BUSY          0xFFFFFFFF   // From open: not ready, retry the request later
+
+typedef uint32_t (*BulkOpenFn_t)();                                   // Snapshot source, return size
+typedef bool (*BulkReadFn_t)(uint32_t offset, uint8_t* buffer, size_t length);
+typedef uint32_t (*BulkClock_t)();
+
+// Default clock: millis() narrowed to 32 bits
+uint32_t bulkMillis();
+
+// Notification transport (BLE characteristic on the device, loopback on the host)
+class Bulk_Link {
+public:
+    virtual ~Bulk_Link() {}
+    virtual bool send(const uint8_t* data, size_t length) = 0;   // False when congested
+    virtual uint16_t getMTU() = 0;
+};
+
+typedef struct {
+    uint32_t transfers;
+    uint32_t chunks_sent;
+    uint32_t bytes_sent;          // Payload bytes, including resends
+    uint32_t rewinds;             // NAKs + ACK timeouts
+    uint32_t resent_bytes;
+    uint32_t link_busy;           // send() refused by the link
+    uint32_t last_duration_ms;
+    uint32_t last_size;
+} BulkStats_t;
+
+class Bulk_Transfer {
+private:
+    Bulk_Link* link;
+    BulkOpenFn_t open_source;
+    BulkReadFn_t read_source;
+    BulkClock_t clock_ms;
+
+    // Active request
+    bool active;
+    uint32_t source_size;
+    uint32_t start_offset;
+    uint32_t end_offset;          // Exclusive end of the requested range
+    uint32_t next_offset;         // Next byte to send
+    uint32_t sent_high;           // Highest offset sent so far (for resend accounting)
+    uint32_t acked_offset;        // Client holds every byte below this
+    uint16_t chunk_size;
+    uint8_t window;
+    uint32_t last_progress_time;
+    uint32_t start_time;
+
+    // Request mailbox (written from the BLE task, consumed in service())
+    uint8_t request[BULK_MAX_REQUEST_SIZE];
+    volatile uint8_t request_length;
+    volatile bool request_pending;
+
+    uint8_t packet[BULK_MAX_NOTIFY_SIZE];
+    BulkStats_t stats;
+
+#ifdef ARDUINO
+    portMUX_TYPE request_mux;
+#endif
+
+public:
+    Bulk_Transfer(Bulk_Link* link, BulkClock_t clock = bulkMillis);
+
+    void setSource(BulkOpenFn_t open, BulkReadFn_t read);
+
+    // Called from the transport's write callback
+    void submitRequest(const uint8_t* data, size_t length);
+
+    // Called periodically: handles requests, then sends up to a window of chunks
+    bool service();
+    void abort();
+
+    bool isActive() { return active; }
+    const BulkStats_t& getStats() { return stats; }
+    uint16_t getChunkSize();
+    void printStats();
+
+    static uint16_t crc16(const uint8_t* data, size_t length, uint16_t crc = 0xFFFF);
+
+private:
+    void handleRequest(const uint8_t* data, size_t length);
+    void retryRequest(const uint8_t* data, size_t length);
+    void sendInfo();
+    void sendEnd();
+    void sendError(uint8_t code);
+    bool sendChunk();
+};
+
+// Little-endian field helpers shared with the host client
+inline void bulkPut16(uint8_t* out, uint16_t value) {
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+}
+
+inline void bulkPut32(uint8_t* out, uint32_t value) {
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+    out[2] = (uint8_t)(value >> 16);
+    out[3] = (uint8_t)(value >> 24);
+}
+
+inline uint16_t bulkGet16(const uint8_t* in) {
+    return (uint16_t)(in[0] | (in[1] << 8));
+}
+
+inline uint32_t bulkGet32(const uint8_t* in) {
+    return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+#endif // BULK_TRANSFER_H
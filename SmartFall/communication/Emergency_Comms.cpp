@@ -1,7 +1,48 @@
 #include "Emergency_Comms.h"
+#include "../diagnostics/Deferred_Log.h"
+
+WiFi_Alert_Transport::WiFi_Alert_Transport(WiFi_Manager* wifi) : wifi_manager(wifi), enabled(true) {
+}
+
+void WiFi_Alert_Transport::setEnabled(bool enable) {
+    enabled = enable;
+}
+
+const char* WiFi_Alert_Transport::getName() {
+    return "wifi";
+}
+
+bool WiFi_Alert_Transport::isAvailable() {
+    return enabled && wifi_manager != nullptr && wifi_manager->isConnected();
+}
+
+bool WiFi_Alert_Transport::deliver(const EmergencyData_t& data, uint32_t timeout_ms) {
+    return wifi_manager->sendEmergencyAlert(data, timeout_ms);
+}
+
+BLE_Alert_Transport::BLE_Alert_Transport(BLE_Server* ble) : ble_server(ble), enabled(true) {
+}
+
+void BLE_Alert_Transport::setEnabled(bool enable) {
+    enabled = enable;
+}
+
+const char* BLE_Alert_Transport::getName() {
+    return "ble";
+}
+
+bool BLE_Alert_Transport::isAvailable() {
+    return enabled && ble_server != nullptr && ble_server->isConnected();
+}
+
+bool BLE_Alert_Transport::deliver(const EmergencyData_t& data, uint32_t timeout_ms) {
+    return ble_server->sendEmergencyAlert(data, timeout_ms);
+}
 
 Emergency_Comms::Emergency_Comms(WiFi_Manager* wifi, BLE_Server* ble)
-    : wifi_manager(wifi), ble_server(ble), wifi_enabled(true), ble_enabled(true),
+    : wifi_manager(wifi), ble_server(ble), wifi_transport(wifi), ble_transport(ble),
+      wifi_slot(-1), ble_slot(-1), dispatched_timestamp(0), awaiting_outcome(false),
+      wifi_enabled(true), ble_enabled(true),
       initialized(false), current_alert_status(ALERT_STATUS_PENDING),
       retry_count(0), max_retries(3), last_alert_time(0), retry_interval(5000),
       alert_pending(false) {
@@ -22,6 +63,16 @@ bool Emergency_Comms::begin() {
         return false;
     }
 
+    if (wifi_manager != nullptr) {
+        wifi_slot = dispatcher.addTransport(&wifi_transport, ALERT_WIFI_DEADLINE_MS, PROFILE_ALERT_WIFI);
+    }
+    if (ble_server != nullptr) {
+        ble_slot = dispatcher.addTransport(&ble_transport, ALERT_BLE_DEADLINE_MS, PROFILE_ALERT_BLE);
+    }
+    if (!dispatcher.begin()) {
+        return false;
+    }
+
     Serial.println("[Emergency] Communication system initialized");
     initialized = true;
 
@@ -36,8 +87,14 @@ void Emergency_Comms::setRetryInterval(uint32_t interval_ms) {
     retry_interval = interval_ms;
 }
 
+void Emergency_Comms::setDeadlines(uint32_t wifi_ms, uint32_t ble_ms) {
+    if (wifi_slot >= 0) dispatcher.setDeadline(wifi_slot, wifi_ms);
+    if (ble_slot >= 0) dispatcher.setDeadline(ble_slot, ble_ms);
+}
+
 void Emergency_Comms::enableWiFi(bool enable) {
     wifi_enabled = enable;
+    wifi_transport.setEnabled(enable);
     if (DEBUG_COMMUNICATION) {
         Serial.print("[Emergency] WiFi alerts: ");
         Serial.println(enable ? "enabled" : "disabled");
@@ -46,6 +103,7 @@ void Emergency_Comms::enableWiFi(bool enable) {
 
 void Emergency_Comms::enableBLE(bool enable) {
     ble_enabled = enable;
+    ble_transport.setEnabled(enable);
     if (DEBUG_COMMUNICATION) {
         Serial.print("[Emergency] BLE alerts: ");
         Serial.println(enable ? "enabled" : "disabled");
@@ -70,71 +128,33 @@ bool Emergency_Comms::sendEmergencyAlert(const EmergencyData_t& emergency_data,
         return false;
     }
 
-    Serial.println("\n!!! SENDING EMERGENCY ALERT !!!");
-    Serial.print("Confidence Score: ");
-    Serial.print(emergency_data.confidence_score);
-    Serial.println("/105");
-    Serial.print("SOS Triggered: ");
-    Serial.println(emergency_data.sos_triggered ? "YES" : "NO");
-
-    bool wifi_success = false;
-    bool ble_success = false;
-
-    // Try WiFi transmission
-    if (wifi_enabled && wifi_manager != nullptr) {
-        Serial.println("[Emergency] Attempting WiFi transmission...");
-        wifi_success = sendViaWiFi(emergency_data);
-
-        if (wifi_success) {
-            Serial.println("[Emergency] ✓ WiFi transmission successful");
-        } else {
-            Serial.println("[Emergency] ✗ WiFi transmission failed");
-        }
+    // Both transports at once; returns on the first confirmation while the
+    // slower one finishes in the background
+    bool delivered = false;
+    if (dispatchAlert(emergency_data)) {
+        delivered = (dispatcher.wait(dispatcher.getLongestDeadline()) == DISPATCH_OUTCOME_DELIVERED);
     }
 
-    // Try BLE transmission
-    if (ble_enabled && ble_server != nullptr) {
-        Serial.println("[Emergency] Attempting BLE transmission...");
-        ble_success = sendViaBLE(emergency_data);
-
-        if (ble_success) {
-            Serial.println("[Emergency] ✓ BLE transmission successful");
-        } else {
-            Serial.println("[Emergency] ✗ BLE transmission failed");
-        }
-    }
+    settleAlert(emergency_data, delivered, urgent);
+    return delivered;
+}
 
-    // Update status based on results
-    if (wifi_success && ble_success) {
-        current_alert_status = ALERT_STATUS_SENT_BOTH;
-        retry_count = 0;
-    } else if (wifi_success) {
-        current_alert_status = ALERT_STATUS_SENT_WIFI;
-        retry_count = 0;
-    } else if (ble_success) {
-        current_alert_status = ALERT_STATUS_SENT_BLE;
-        retry_count = 0;
-    } else {
-        current_alert_status = ALERT_STATUS_FAILED;
-
-        // Queue for retry if urgent
-        if (urgent && retry_count < max_retries) {
-            pending_alert = emergency_data;
-            alert_pending = true;
-            current_alert_status = ALERT_STATUS_RETRY;
-            last_alert_time = millis();
-
-            Serial.print("[Emergency] Queued for retry (");
-            Serial.print(retry_count + 1);
-            Serial.print("/");
-            Serial.print(max_retries);
-            Serial.println(")");
-        }
+bool Emergency_Comms::startEmergencyAlert(const EmergencyData_t& emergency_data) {
+    if (!initialized) {
+        Serial.println("[Emergency] ERROR: Not initialized!");
+        return false;
     }
 
-    updateAlertStatus();
+    // Kept for the retry queue in case neither transport confirms
+    pending_alert = emergency_data;
+    alert_pending = false;
 
-    return (wifi_success || ble_success);
+    if (!dispatchAlert(emergency_data)) {
+        settleAlert(pending_alert, false, true);
+        return false;
+    }
+    awaiting_outcome = true;
+    return true;
 }
 
 bool Emergency_Comms::sendStatusUpdate(const SystemStatus_t& status_data) {
@@ -149,6 +169,8 @@ bool Emergency_Comms::sendStatusUpdate(const SystemStatus_t& status_data) {
     status_packet.system_health = status_data.sensors_initialized;
     status_packet.uptime = status_data.uptime_ms;
     strncpy(status_packet.status_message, "Status update", sizeof(status_packet.status_message));
+    status_packet.memory = status_data.memory;
+    status_packet.boot = status_data.boot;
 
     if (wifi_enabled && wifi_manager != nullptr && wifi_manager->isConnected()) {
         success |= wifi_manager->sendStatusUpdate(status_packet);
@@ -178,7 +200,21 @@ bool Emergency_Comms::sendSensorData(const SensorData_t& sensor_data) {
 }
 
 void Emergency_Comms::processAlertQueue() {
-    if (!alert_pending || current_alert_status != ALERT_STATUS_RETRY) {
+    // Pick up confirmations that arrived after sendEmergencyAlert() returned
+    dispatcher.update();
+    refreshAlertStatus();
+
+    // Settle an alert started without waiting
+    if (awaiting_outcome) {
+        DispatchOutcome_t outcome = dispatcher.getOutcome();
+        if (outcome == DISPATCH_OUTCOME_PENDING) {
+            return;
+        }
+        awaiting_outcome = false;
+        settleAlert(pending_alert, outcome == DISPATCH_OUTCOME_DELIVERED, true);
+    }
+
+    if (!alert_pending || awaiting_outcome || current_alert_status != ALERT_STATUS_RETRY) {
         return;
     }
 
@@ -187,20 +223,11 @@ void Emergency_Comms::processAlertQueue() {
     if (current_time - last_alert_time >= retry_interval) {
         retry_count++;
 
-        Serial.print("[Emergency] Retry attempt ");
-        Serial.print(retry_count);
-        Serial.print("/");
-        Serial.println(max_retries);
+        Deferred_Log::log(DLOG_EMERGENCY_RETRY, retry_count, max_retries);
 
-        if (retryFailedAlert()) {
-            alert_pending = false;
-            Serial.println("[Emergency] ✓ Retry successful!");
-        } else if (retry_count >= max_retries) {
-            alert_pending = false;
-            current_alert_status = ALERT_STATUS_FAILED;
-            Serial.println("[Emergency] ✗ Max retries reached, alert failed");
-        } else {
-            last_alert_time = current_time;
+        // Settled above on a later call, like the first attempt
+        if (!retryFailedAlert()) {
+            settleAlert(pending_alert, false, true);
         }
     }
 }
@@ -215,6 +242,7 @@ bool Emergency_Comms::isAlertPending() {
 
 void Emergency_Comms::clearPendingAlert() {
     alert_pending = false;
+    awaiting_outcome = false;
     retry_count = 0;
     current_alert_status = ALERT_STATUS_PENDING;
 }
@@ -258,6 +286,7 @@ void Emergency_Comms::printStatus() {
         Serial.println(max_retries);
     }
 
+    dispatcher.printStats();
     Serial.println("======================================");
 }
 
@@ -269,22 +298,54 @@ uint8_t Emergency_Comms::getRetryCount() {
     return retry_count;
 }
 
+Alert_Dispatcher& Emergency_Comms::getDispatcher() {
+    return dispatcher;
+}
+
 // Private helper functions
 
-bool Emergency_Comms::sendViaWiFi(const EmergencyData_t& data) {
-    if (wifi_manager == nullptr || !wifi_manager->isConnected()) {
+bool Emergency_Comms::dispatchAlert(const EmergencyData_t& emergency_data) {
+    Deferred_Log::log(DLOG_EMERGENCY_SENDING, emergency_data.confidence_score,
+                      MAX_CONFIDENCE_SCORE, emergency_data.sos_triggered);
+
+    if (!dispatcher.dispatch(emergency_data)) {
         return false;
     }
-
-    return wifi_manager->sendEmergencyAlert(data);
+    dispatched_timestamp = emergency_data.timestamp;
+    current_alert_status = ALERT_STATUS_SENDING;
+    return true;
 }
 
-bool Emergency_Comms::sendViaBLE(const EmergencyData_t& data) {
-    if (ble_server == nullptr || !ble_server->isConnected()) {
-        return false;
+void Emergency_Comms::settleAlert(const EmergencyData_t& emergency_data, bool delivered, bool urgent) {
+    if (delivered) {
+        if (retry_count > 0) {
+            Deferred_Log::log(DLOG_EMERGENCY_RETRY_OK);
+        }
+        retry_count = 0;
+        alert_pending = false;
+        refreshAlertStatus();
+
+        Deferred_Log::log(DLOG_EMERGENCY_DELIVERED, dispatcher.getFirstTransport() == ble_slot,
+                          dispatcher.getFirstLatency());
+        return;
     }
 
-    return ble_server->sendEmergencyAlert(data);
+    current_alert_status = ALERT_STATUS_FAILED;
+    Deferred_Log::log(DLOG_EMERGENCY_UNCONFIRMED);
+
+    // Queue for retry if urgent
+    if (urgent && retry_count < max_retries) {
+        pending_alert = emergency_data;
+        alert_pending = true;
+        current_alert_status = ALERT_STATUS_RETRY;
+        last_alert_time = millis();
+
+        Deferred_Log::log(DLOG_EMERGENCY_QUEUED, retry_count + 1, max_retries);
+    } else if (retry_count > 0) {
+        alert_pending = false;
+        Deferred_Log::log(DLOG_EMERGENCY_RETRY_FAILED);
+    }
+    updateAlertStatus();
 }
 
 bool Emergency_Comms::retryFailedAlert() {
@@ -292,13 +353,41 @@ bool Emergency_Comms::retryFailedAlert() {
         return false;
     }
 
-    return sendEmergencyAlert(pending_alert, false);  // Non-urgent retry
+    // Never wait here: this runs on the loop task
+    if (!dispatchAlert(pending_alert)) {
+        return false;
+    }
+    awaiting_outcome = true;
+    return true;
+}
+
+void Emergency_Comms::refreshAlertStatus() {
+    if (dispatcher.getOutcome() != DISPATCH_OUTCOME_DELIVERED) {
+        return;
+    }
+
+    bool wifi_acked = wifi_slot >= 0 && dispatcher.getState(wifi_slot) == DISPATCH_ACKED;
+    bool ble_acked = ble_slot >= 0 && dispatcher.getState(ble_slot) == DISPATCH_ACKED;
+    AlertStatus_t status = (wifi_acked && ble_acked) ? ALERT_STATUS_SENT_BOTH :
+                           wifi_acked ? ALERT_STATUS_SENT_WIFI : ALERT_STATUS_SENT_BLE;
+    if (status == current_alert_status) {
+        return;
+    }
+
+    // A transport confirmed after its deadline: the queued retry is moot
+    if (alert_pending && !awaiting_outcome && pending_alert.timestamp == dispatched_timestamp) {
+        alert_pending = false;
+        retry_count = 0;
+        Deferred_Log::log(DLOG_EMERGENCY_LATE_ACK);
+    }
+
+    current_alert_status = status;
+    updateAlertStatus();
 }
 
 void Emergency_Comms::updateAlertStatus() {
     if (DEBUG_COMMUNICATION) {
-        Serial.print("[Emergency] Alert status: ");
-        Serial.println(getAlertStatusString(current_alert_status));
+        Deferred_Log::log(DLOG_EMERGENCY_STATUS, current_alert_status);
     }
 }
 
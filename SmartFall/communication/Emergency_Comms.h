@@ -4,6 +4,7 @@
 #include <Arduino.h>
 #include "WiFi_Manager.h"
 #include "BLE_Server.h"
+#include "Alert_Dispatcher.h"
 #include "../utils/data_types.h"
 #include "../utils/config.h"
 
@@ -18,11 +19,49 @@ typedef enum {
     ALERT_STATUS_RETRY
 } AlertStatus_t;
 
+// Alert_Transport adapters over the WiFi and BLE managers
+class WiFi_Alert_Transport : public Alert_Transport {
+private:
+    WiFi_Manager* wifi_manager;
+    bool enabled;
+
+public:
+    WiFi_Alert_Transport(WiFi_Manager* wifi);
+    void setEnabled(bool enable);
+
+    const char* getName() override;
+    bool isAvailable() override;
+    bool deliver(const EmergencyData_t& data, uint32_t timeout_ms) override;  // HTTP 2xx
+};
+
+class BLE_Alert_Transport : public Alert_Transport {
+private:
+    BLE_Server* ble_server;
+    bool enabled;
+
+public:
+    BLE_Alert_Transport(BLE_Server* ble);
+    void setEnabled(bool enable);
+
+    const char* getName() override;
+    bool isAvailable() override;
+    bool deliver(const EmergencyData_t& data, uint32_t timeout_ms) override;  // App ACK (Alert_Ack.h)
+};
+
 class Emergency_Comms {
 private:
     WiFi_Manager* wifi_manager;
     BLE_Server* ble_server;
 
+    // Parallel alert delivery, one task per transport
+    WiFi_Alert_Transport wifi_transport;
+    BLE_Alert_Transport ble_transport;
+    Alert_Dispatcher dispatcher;
+    int8_t wifi_slot;
+    int8_t ble_slot;
+    uint32_t dispatched_timestamp;   // Alert currently held by the dispatcher
+    bool awaiting_outcome;           // Started without waiting, not settled yet
+
     bool wifi_enabled;
     bool ble_enabled;
     bool initialized;
@@ -46,6 +85,7 @@ public:
     bool begin();
     void setMaxRetries(uint8_t retries);
     void setRetryInterval(uint32_t interval_ms);
+    void setDeadlines(uint32_t wifi_ms, uint32_t ble_ms);
 
     // Enable/disable protocols
     void enableWiFi(bool enable = true);
@@ -54,8 +94,10 @@ public:
     bool isBLEEnabled();
 
     // Emergency alert transmission
+    // Blocks up to the longest transport deadline; not for the loop task
     bool sendEmergencyAlert(const EmergencyData_t& emergency_data);
     bool sendEmergencyAlert(const EmergencyData_t& emergency_data, bool urgent);
+    bool startEmergencyAlert(const EmergencyData_t& emergency_data);  // Non-blocking; outcome in processAlertQueue()
 
     // Status updates
     bool sendStatusUpdate(const SystemStatus_t& status_data);
@@ -76,12 +118,14 @@ public:
     void printStatus();
     bool isInitialized();
     uint8_t getRetryCount();
+    Alert_Dispatcher& getDispatcher();
 
 private:
     // Internal transmission functions
-    bool sendViaWiFi(const EmergencyData_t& data);
-    bool sendViaBLE(const EmergencyData_t& data);
-    bool retryFailedAlert();
+    bool dispatchAlert(const EmergencyData_t& emergency_data);
+    void settleAlert(const EmergencyData_t& emergency_data, bool delivered, bool urgent);
+    bool retryFailedAlert();          // Starts the retry; processAlertQueue() settles it
+    void refreshAlertStatus();
     void updateAlertStatus();
 
     // Helper functions
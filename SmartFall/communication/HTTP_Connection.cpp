@@ -0,0 +1,443 @@
+#include "HTTP_Connection.h"
+#include <strings.h>
+
+#ifdef ARDUINO
+WiFi_Socket::WiFi_Socket(const char* ca_cert) : client(nullptr), ca_cert(ca_cert) {
+}
+
+bool WiFi_Socket::open(const char* host, uint16_t port, bool tls, uint32_t timeout_ms) {
+    close();
+    if (tls) {
+        // WiFiClientSecure has no session cache API; the socket is kept
+        // open instead, so the handshake is paid once per connection
+        if (ca_cert != nullptr) {
+            secure_client.setCACert(ca_cert);
+        } else {
+            secure_client.setInsecure();
+        }
+        secure_client.setHandshakeTimeout((timeout_ms + 999) / 1000);
+        client = &secure_client;
+        if (!secure_client.connect(host, port, timeout_ms)) return false;
+    } else {
+        client = &plain_client;
+        if (!plain_client.connect(host, port, timeout_ms)) return false;
+        plain_client.setNoDelay(true);   // Headers and body go out without waiting for an ACK
+    }
+    return true;
+}
+
+bool WiFi_Socket::isOpen() {
+    return client != nullptr && client->connected();
+}
+
+bool WiFi_Socket::send(const uint8_t* data, size_t length) {
+    return client != nullptr && client->write(data, length) == length;
+}
+
+int WiFi_Socket::receive(uint8_t* buffer, size_t length) {
+    if (client == nullptr) return -1;
+    int available = client->available();
+    if (available > 0) {
+        return client->read(buffer, (size_t)available < length ? (size_t)available : length);
+    }
+    return client->connected() ? 0 : -1;
+}
+
+void WiFi_Socket::close() {
+    if (client != nullptr) {
+        client->stop();
+        client = nullptr;
+    }
+}
+#endif
+
+HTTP_Connection::HTTP_Connection(HTTP_Socket* socket)
+    : socket(socket), target_tls(false), target_port(0),
+      keep_alive(HTTP_KEEPALIVE_ENABLED),
+      heartbeat_interval(HTTP_HEARTBEAT_INTERVAL_MS),
+      heartbeat_path(HTTP_HEARTBEAT_PATH),
+      connect_timeout(HTTP_CONNECT_TIMEOUT_MS),
+      response_timeout(HTTP_RESPONSE_TIMEOUT_MS),
+      last_activity(0), rx_position(0), rx_length(0), rx_any(false),
+      request_start_us(0) {
+    target_host[0] = '\0';
+    server_url[0] = '\0';
+    resetStats();
+}
+
+void HTTP_Connection::setServer(const char* url) {
+    strncpy(server_url, url, sizeof(server_url) - 1);
+    server_url[sizeof(server_url) - 1] = '\0';
+}
+
+void HTTP_Connection::setKeepAlive(bool enable) {
+    keep_alive = enable;
+    if (!enable) close();
+}
+
+void HTTP_Connection::setHeartbeat(uint32_t interval_ms, const char* path) {
+    heartbeat_interval = interval_ms;
+    heartbeat_path = path;
+}
+
+void HTTP_Connection::setTimeouts(uint32_t connect_ms, uint32_t response_ms) {
+    connect_timeout = connect_ms;
+    response_timeout = response_ms;
+}
+
+bool HTTP_Connection::warm() {
+    if (!keep_alive || server_url[0] == '\0') return false;
+
+    bool tls;
+    char host[HTTP_HOST_MAX_LENGTH];
+    uint16_t port;
+    const char* path;
+    if (!parseURL(server_url, tls, host, sizeof(host), port, path)) return false;
+
+    bool reused;
+    return ensureOpen(tls, host, port, reused);
+}
+
+void HTTP_Connection::service() {
+    if (!keep_alive || server_url[0] == '\0') return;
+
+    uint32_t now = millis();
+    if (now - last_activity < heartbeat_interval) return;
+    last_activity = now;   // Also paces reopen attempts while the server is down
+
+    if (!socket->isOpen()) {
+        if (target_host[0] != '\0') {
+            stats.server_closes++;
+            if (DEBUG_COMMUNICATION) {
+                Serial.println("[HTTP] Server closed idle connection, reopening");
+            }
+        }
+        warm();
+        return;
+    }
+
+    if (heartbeat_interval == 0) return;
+
+    // HEAD keeps NAT/server idle timers from expiring; any status will do.
+    // A dead socket is replaced by request()'s stale retry.
+    char url[sizeof(server_url) + HTTP_PATH_MAX_LENGTH];
+    snprintf(url, sizeof(url), "%s%s", server_url, heartbeat_path);
+    stats.heartbeats++;
+    request("HEAD", url, nullptr, nullptr, 0);
+}
+
+void HTTP_Connection::close() {
+    socket->close();
+    target_host[0] = '\0';
+    rx_position = 0;
+    rx_length = 0;
+}
+
+bool HTTP_Connection::isOpen() {
+    return target_host[0] != '\0' && socket->isOpen();
+}
+
+int HTTP_Connection::request(const char* method, const char* url, const char* content_type,
+                             const uint8_t* body, size_t length,
+                             char* response, size_t response_size) {
+    bool tls;
+    char host[HTTP_HOST_MAX_LENGTH];
+    uint16_t port;
+    const char* path;
+    if (!parseURL(url, tls, host, sizeof(host), port, path)) return HTTP_ERR_URL;
+
+    stats.requests++;
+    request_start_us = micros();
+    bool head_request = (strcmp(method, "HEAD") == 0);
+
+    for (uint8_t attempt = 0; attempt < 2; attempt++) {
+        bool reused;
+        if (!ensureOpen(tls, host, port, reused)) return HTTP_ERR_CONNECT;
+        if (reused) stats.reuses++;
+
+        int status = HTTP_ERR_SEND;
+        if (sendRequest(method, host, path, content_type, body, length)) {
+            status = readResponse(head_request, response, response_size);
+        }
+        last_activity = millis();
+
+        if (status > 0) {
+            if (!keep_alive) close();
+            return status;
+        }
+        close();
+
+        // Only a reused socket that died before answering is resent: the
+        // server closed it while idle and never saw the request. A fresh
+        // socket failing, a partial answer or a timeout is a real error.
+        if (!reused || rx_any || status == HTTP_ERR_TIMEOUT) return status;
+        stats.stale_retries++;
+    }
+    return HTTP_ERR_RESPONSE;
+}
+
+int HTTP_Connection::post(const char* url, const uint8_t* body, size_t length, const char* content_type) {
+    return request("POST", url, content_type, body, length);
+}
+
+int HTTP_Connection::get(const char* url, char* response, size_t response_size) {
+    return request("GET", url, nullptr, nullptr, 0, response, response_size);
+}
+
+const HttpStats_t& HTTP_Connection::getStats() const {
+    return stats;
+}
+
+void HTTP_Connection::resetStats() {
+    memset(&stats, 0, sizeof(stats));
+}
+
+void HTTP_Connection::printStats() {
+    Serial.println("=== HTTP Connection ===");
+    Serial.print("Requests: ");
+    Serial.print(stats.requests);
+    Serial.print(" | Reused: ");
+    Serial.print(stats.reuses);
+    Serial.print(" | Connects: ");
+    Serial.print(stats.connects);
+    Serial.print(" (");
+    Serial.print(stats.connect_failures);
+    Serial.println(" failed)");
+    Serial.print("Heartbeats: ");
+    Serial.print(stats.heartbeats);
+    Serial.print(" | Server closes: ");
+    Serial.print(stats.server_closes);
+    Serial.print(" | Stale retries: ");
+    Serial.println(stats.stale_retries);
+    Serial.print("Last connect: ");
+    Serial.print(stats.last_connect_ms);
+    Serial.print(" ms | First byte: ");
+    Serial.print(stats.last_first_byte_us / 1000);
+    Serial.print(" ms (max ");
+    Serial.print(stats.max_first_byte_us / 1000);
+    Serial.println(" ms)");
+    Serial.println("=======================");
+}
+
+bool HTTP_Connection::parseURL(const char* url, bool& tls, char* host, size_t host_size,
+                               uint16_t& port, const char*& path) {
+    if (strncmp(url, "http://", 7) == 0) {
+        tls = false;
+        port = 80;
+        url += 7;
+    } else if (strncmp(url, "https://", 8) == 0) {
+        tls = true;
+        port = 443;
+        url += 8;
+    } else {
+        return false;
+    }
+
+    size_t host_length = strcspn(url, ":/");
+    if (host_length == 0 || host_length >= host_size) return false;
+    memcpy(host, url, host_length);
+    host[host_length] = '\0';
+    url += host_length;
+
+    if (*url == ':') {
+        char* end;
+        unsigned long value = strtoul(url + 1, &end, 10);
+        if (end == url + 1 || value == 0 || value > 65535) return false;
+        port = (uint16_t)value;
+        url = end;
+    }
+
+    if (*url != '\0' && *url != '/') return false;
+    path = (*url == '\0') ? "/" : url;
+    return true;
+}
+
+// Private helper functions
+
+bool HTTP_Connection::ensureOpen(bool tls, const char* host, uint16_t port, bool& reused) {
+    reused = false;
+    bool same_target = target_host[0] != '\0' && tls == target_tls && port == target_port &&
+                       strcmp(host, target_host) == 0;
+    if (same_target && socket->isOpen()) {
+        reused = true;
+        return true;
+    }
+    close();
+
+    uint32_t start = millis();
+    if (!socket->open(host, port, tls, connect_timeout)) {
+        socket->close();
+        stats.connect_failures++;
+        if (DEBUG_COMMUNICATION) {
+            Serial.print("[HTTP] ✗ Connect failed: ");
+            Serial.println(host);
+        }
+        return false;
+    }
+
+    stats.connects++;
+    stats.last_connect_ms = millis() - start;
+    target_tls = tls;
+    target_port = port;
+    strncpy(target_host, host, sizeof(target_host) - 1);
+    target_host[sizeof(target_host) - 1] = '\0';
+    last_activity = millis();
+    return true;
+}
+
+bool HTTP_Connection::sendRequest(const char* method, const char* host, const char* path,
+                                  const char* content_type, const uint8_t* body, size_t length) {
+    char head[HTTP_HEAD_MAX_LENGTH];
+    int used = snprintf(head, sizeof(head), "%s %s HTTP/1.1\r\nHost: %s", method, path, host);
+    if (target_port != (target_tls ? 443 : 80)) {
+        used += snprintf(head + used, sizeof(head) - used, ":%u", target_port);
+    }
+    used += snprintf(head + used, sizeof(head) - used, "\r\nConnection: %s\r\n",
+                     keep_alive ? "keep-alive" : "close");
+    if (body != nullptr) {
+        used += snprintf(head + used, sizeof(head) - used,
+                         "Content-Type: %s\r\nContent-Length: %u\r\n",
+                         content_type != nullptr ? content_type : "application/octet-stream",
+                         (unsigned)length);
+    }
+    used += snprintf(head + used, sizeof(head) - used, "\r\n");
+    if (used >= (int)sizeof(head)) return false;
+
+    rx_position = 0;
+    rx_length = 0;
+    rx_any = false;
+    if (!socket->send((const uint8_t*)head, used)) return false;
+    return body == nullptr || length == 0 || socket->send(body, length);
+}
+
+int HTTP_Connection::readResponse(bool head_request, char* response, size_t response_size) {
+    uint32_t deadline = millis() + response_timeout;
+    char line[HTTP_LINE_MAX_LENGTH];
+
+    // Status line: HTTP/1.x NNN reason
+    int result = readLine(line, sizeof(line), deadline);
+    if (result < 0) return result;
+    if (result < 12 || strncmp(line, "HTTP/1.", 7) != 0) return HTTP_ERR_RESPONSE;
+    int status = atoi(line + 9);
+    if (status < 100 || status > 999) return HTTP_ERR_RESPONSE;
+
+    bool server_close = (line[7] == '0');   // HTTP/1.0 closes unless told otherwise
+    bool chunked = false;
+    bool has_length = false;
+    size_t content_length = 0;
+
+    while (true) {
+        result = readLine(line, sizeof(line), deadline);
+        if (result < 0) return result;
+        if (result == 0) break;
+
+        char* value = strchr(line, ':');
+        if (value == nullptr) continue;
+        *value++ = '\0';
+        while (*value == ' ' || *value == '\t') value++;
+
+        if (strcasecmp(line, "Content-Length") == 0) {
+            content_length = strtoul(value, nullptr, 10);
+            has_length = true;
+        } else if (strcasecmp(line, "Transfer-Encoding") == 0) {
+            chunked = (strncasecmp(value, "chunked", 7) == 0);
+        } else if (strcasecmp(line, "Connection") == 0) {
+            if (strncasecmp(value, "close", 5) == 0) server_close = true;
+            if (strncasecmp(value, "keep-alive", 10) == 0) server_close = false;
+        }
+    }
+
+    size_t stored = 0;
+    bool body_ok = true;
+    bool no_body = head_request || status < 200 || status == 204 || status == 304;
+    if (!no_body) {
+        if (chunked) {
+            body_ok = readChunked(response, response_size, stored, deadline);
+        } else if (has_length) {
+            body_ok = readBody(content_length, false, response, response_size, stored, deadline);
+        } else {
+            body_ok = readBody(0, true, response, response_size, stored, deadline);
+            server_close = true;
+        }
+    }
+    if (response != nullptr && response_size > 0) {
+        response[stored] = '\0';
+    }
+    if (!body_ok) return HTTP_ERR_RESPONSE;
+
+    if (server_close) {
+        socket->close();   // Target stays set: service() counts and reopens it
+    }
+    return status;
+}
+
+int HTTP_Connection::readByte(uint32_t deadline) {
+    if (rx_position < rx_length) {
+        return rx_buffer[rx_position++];
+    }
+
+    while (true) {
+        int received = socket->receive(rx_buffer, sizeof(rx_buffer));
+        if (received > 0) {
+            if (!rx_any) {
+                rx_any = true;
+                stats.last_first_byte_us = micros() - request_start_us;
+                if (stats.last_first_byte_us > stats.max_first_byte_us) {
+                    stats.max_first_byte_us = stats.last_first_byte_us;
+                }
+            }
+            rx_length = received;
+            rx_position = 1;
+            return rx_buffer[0];
+        }
+        if (received < 0) return HTTP_ERR_RESPONSE;
+        if ((int32_t)(millis() - deadline) >= 0) return HTTP_ERR_TIMEOUT;
+        delay(1);
+    }
+}
+
+int HTTP_Connection::readLine(char* line, size_t size, uint32_t deadline) {
+    size_t length = 0;
+    while (true) {
+        int c = readByte(deadline);
+        if (c < 0) return c;
+        if (c == '\n') break;
+        if (c != '\r' && length < size - 1) {
+            line[length++] = (char)c;   // Overlong lines are truncated
+        }
+    }
+    line[length] = '\0';
+    return (int)length;
+}
+
+bool HTTP_Connection::readBody(size_t length, bool until_close, char* response, size_t response_size,
+                               size_t& stored, uint32_t deadline) {
+    for (size_t i = 0; until_close || i < length; i++) {
+        int c = readByte(deadline);
+        if (c < 0) return until_close && c == HTTP_ERR_RESPONSE;
+        if (response != nullptr && stored + 1 < response_size) {
+            response[stored++] = (char)c;
+        }
+    }
+    return true;
+}
+
+bool HTTP_Connection::readChunked(char* response, size_t response_size, size_t& stored, uint32_t deadline) {
+    char line[HTTP_LINE_MAX_LENGTH];
+    while (true) {
+        if (readLine(line, sizeof(line), deadline) < 0) return false;
+        char* end;
+        size_t chunk = strtoul(line, &end, 16);
+        if (end == line) return false;
+
+        if (chunk == 0) {
+            // Trailer headers up to the blank line
+            int result;
+            while ((result = readLine(line, sizeof(line), deadline)) > 0) {}
+            return result == 0;
+        }
+
+        if (!readBody(chunk, false, response, response_size, stored, deadline)) return false;
+        if (readLine(line, sizeof(line), deadline) != 0) return false;   // CRLF after data
+    }
+}
@@ -0,0 +1,159 @@
+#ifndef HTTP_CONNECTION_H
+#define HTTP_CONNECTION_H
+
+#include <Arduino.h>
+#include "../utils/config.h"
+
+#ifdef ARDUINO
+#include <WiFiClient.h>
+#include <WiFiClientSecure.h>
+#endif
+
+/*
+ * Persistent HTTP/1.1 connection to the alert server.
+ *
+ * HTTPClient opens a new TCP (and TLS) connection for every request, so
+ * each alert paid the full handshake before the first byte went out.
+ * This keeps one socket open to the server: it is opened ("warmed") as
+ * soon as WiFi comes up, kept alive by a HEAD heartbeat while idle, and
+ * reopened in the background when the server drops it. A request on a
+ * reused socket that dies before any response byte arrives (server
+ * closed it while idle) is retried once on a fresh socket.
+ *
+ * Requests go to whatever URL is given; a different scheme/host/port
+ * closes the current socket and opens one to the new target. Responses
+ * may use Content-Length, chunked encoding, or read-until-close.
+ *
+ * request() returns the HTTP status code, or a negative HTTP_ERR_* code.
+ */
+
+#define HTTP_HOST_MAX_LENGTH      64
+#define HTTP_PATH_MAX_LENGTH      96
+#define HTTP_HEAD_MAX_LENGTH      384    // Request line + headers
+#define HTTP_LINE_MAX_LENGTH      128    // Longest response header line kept
+#define HTTP_RX_BUFFER_SIZE       128
+
+#define HTTP_ERR_URL              -1
+#define HTTP_ERR_CONNECT          -2
+#define HTTP_ERR_SEND             -3
+#define HTTP_ERR_TIMEOUT          -4
+#define HTTP_ERR_RESPONSE         -5     // Malformed, or closed mid-response
+
+// Byte stream to the server (WiFiClient/WiFiClientSecure on the device,
+// POSIX socket on the host)
+class HTTP_Socket {
+public:
+    virtual ~HTTP_Socket() {}
+    virtual bool open(const char* host, uint16_t port, bool tls, uint32_t timeout_ms) = 0;
+    virtual bool isOpen() = 0;                                   // False once the peer closed
+    virtual bool send(const uint8_t* data, size_t length) = 0;  // All or nothing
+    virtual int receive(uint8_t* buffer, size_t length) = 0;    // 0 = nothing yet, -1 = closed
+    virtual void close() = 0;
+};
+
+#ifdef ARDUINO
+class WiFi_Socket : public HTTP_Socket {
+private:
+    WiFiClient plain_client;
+    WiFiClientSecure secure_client;
+    Client* client;
+    const char* ca_cert;
+
+public:
+    WiFi_Socket(const char* ca_cert = nullptr);
+
+    bool open(const char* host, uint16_t port, bool tls, uint32_t timeout_ms) override;
+    bool isOpen() override;
+    bool send(const uint8_t* data, size_t length) override;
+    int receive(uint8_t* buffer, size_t length) override;
+    void close() override;
+};
+#endif
+
+typedef struct {
+    uint32_t requests;
+    uint32_t connects;            // Sockets opened (including warm-ups)
+    uint32_t connect_failures;
+    uint32_t reuses;              // Requests sent on an already-open socket
+    uint32_t stale_retries;       // Reused socket was dead, resent on a new one
+    uint32_t heartbeats;
+    uint32_t server_closes;       // Idle socket found closed by the server
+    uint32_t last_connect_ms;     // TCP (+TLS) handshake time
+    uint32_t last_first_byte_us;  // request() -> first response byte, incl. any connect
+    uint32_t max_first_byte_us;
+} HttpStats_t;
+
+class HTTP_Connection {
+private:
+    HTTP_Socket* socket;
+
+    // Current socket target
+    bool target_tls;
+    char target_host[HTTP_HOST_MAX_LENGTH];
+    uint16_t target_port;
+
+    // Server kept warm by warm()/service()
+    char server_url[HTTP_HOST_MAX_LENGTH + HTTP_PATH_MAX_LENGTH];
+
+    bool keep_alive;
+    uint32_t heartbeat_interval;
+    const char* heartbeat_path;
+    uint32_t connect_timeout;
+    uint32_t response_timeout;
+    uint32_t last_activity;
+
+    // Response read buffer
+    uint8_t rx_buffer[HTTP_RX_BUFFER_SIZE];
+    size_t rx_position;
+    size_t rx_length;
+    bool rx_any;                  // Any byte received for the current response
+    uint32_t request_start_us;
+
+    HttpStats_t stats;
+
+public:
+    HTTP_Connection(HTTP_Socket* socket);
+
+    // Configuration
+    void setServer(const char* url);       // Target for warm() and heartbeats
+    void setKeepAlive(bool enable);        // False: Connection: close, one socket per request
+    void setHeartbeat(uint32_t interval_ms, const char* path);
+    void setTimeouts(uint32_t connect_ms, uint32_t response_ms);
+
+    // Connection lifecycle
+    bool warm();                           // Open the server socket ahead of the first request
+    void service();                        // Call periodically while the network is up
+    void close();
+    bool isOpen();
+
+    // Requests. The response body (if any) is copied NUL-terminated into
+    // response, truncated to response_size - 1.
+    int request(const char* method, const char* url, const char* content_type,
+                const uint8_t* body, size_t length,
+                char* response = nullptr, size_t response_size = 0);
+    int post(const char* url, const uint8_t* body, size_t length, const char* content_type);
+    int get(const char* url, char* response, size_t response_size);
+
+    // Statistics
+    const HttpStats_t& getStats() const;
+    void resetStats();
+    void printStats();
+
+    // Splits http[s]://host[:port][/path]; path points into url ("/" if absent)
+    static bool parseURL(const char* url, bool& tls, char* host, size_t host_size,
+                         uint16_t& port, const char*& path);
+
+private:
+    // Private helper functions
+    bool ensureOpen(bool tls, const char* host, uint16_t port, bool& reused);
+    bool sendRequest(const char* method, const char* host, const char* path,
+                     const char* content_type, const uint8_t* body, size_t length);
+    int readResponse(bool head_request, char* response, size_t response_size);
+    int readByte(uint32_t deadline);
+    int readLine(char* line, size_t size, uint32_t deadline);
+    bool readBody(size_t length, bool until_close, char* response, size_t response_size,
+                  size_t& stored, uint32_t deadline);
+    bool readChunked(char* response, size_t response_size, size_t& stored, uint32_t deadline);
+};
+
+#endif // HTTP_CONNECTION_H
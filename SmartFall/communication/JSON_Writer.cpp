@@ -0,0 +1,441 @@
+#include "JSON_Writer.h"
+
+// ArduinoJson switches to exponent notation outside [1e-5, 1e7)
+#define JSON_POSITIVE_EXPONENT_THRESHOLD  1e7
+#define JSON_NEGATIVE_EXPONENT_THRESHOLD  1e-5
+
+static const double POSITIVE_BINARY_POWERS_OF_TEN[] = {
+    1e1, 1e2, 1e4, 1e8, 1e16, 1e32, 1e64, 1e128, 1e256
+};
+static const double NEGATIVE_BINARY_POWERS_OF_TEN[] = {
+    1e-1, 1e-2, 1e-4, 1e-8, 1e-16, 1e-32, 1e-64, 1e-128, 1e-256
+};
+static const double NEGATIVE_BINARY_POWERS_OF_TEN_PLUS_ONE[] = {
+    1e0, 1e-1, 1e-3, 1e-7, 1e-15, 1e-31, 1e-63, 1e-127, 1e-255
+};
+
+JSON_Writer::JSON_Writer(char* buf, size_t cap)
+    : buffer(buf), capacity(cap), length(0), overflow(false), first_member(true) {
+    reset();
+}
+
+void JSON_Writer::reset() {
+    length = 0;
+    overflow = (buffer == nullptr || capacity == 0);
+    first_member = true;
+    if (!overflow) {
+        buffer[0] = '\0';
+    }
+}
+
+void JSON_Writer::beginObject() {
+    writeSeparator();
+    writeRaw('{');
+    first_member = true;
+}
+
+void JSON_Writer::beginObject(const char* key) {
+    writeKey(key);
+    writeRaw('{');
+    first_member = true;
+}
+
+void JSON_Writer::endObject() {
+    writeRaw('}');
+    first_member = false;
+}
+
+void JSON_Writer::beginArray(const char* key) {
+    writeKey(key);
+    writeRaw('[');
+    first_member = true;
+}
+
+void JSON_Writer::endArray() {
+    writeRaw(']');
+    first_member = false;
+}
+
+void JSON_Writer::addString(const char* key, const char* value) {
+    writeKey(key);
+    writeEscaped(value);
+}
+
+void JSON_Writer::addUInt(const char* key, uint32_t value) {
+    writeKey(key);
+    writeUnsigned(value);
+}
+
+void JSON_Writer::addInt(const char* key, int32_t value) {
+    writeKey(key);
+    writeSigned(value);
+}
+
+void JSON_Writer::addFloat(const char* key, float value) {
+    writeKey(key);
+    // ArduinoJson stores floats as double, so format the widened value
+    writeDouble((double)value);
+}
+
+void JSON_Writer::addBool(const char* key, bool value) {
+    writeKey(key);
+    writeRaw(value ? "true" : "false");
+}
+
+void JSON_Writer::addUInt(uint32_t value) {
+    writeSeparator();
+    writeUnsigned(value);
+}
+
+bool JSON_Writer::ok() {
+    return !overflow;
+}
+
+size_t JSON_Writer::size() {
+    return overflow ? 0 : length;
+}
+
+const char* JSON_Writer::c_str() {
+    return overflow ? "" : buffer;
+}
+
+const uint8_t* JSON_Writer::data() {
+    return (const uint8_t*)c_str();
+}
+
+// Private helper functions
+
+void JSON_Writer::writeRaw(char c) {
+    if (overflow) return;
+
+    // Always keep room for the terminating null
+    if (length + 1 >= capacity) {
+        overflow = true;
+        return;
+    }
+
+    buffer[length++] = c;
+    buffer[length] = '\0';
+}
+
+void JSON_Writer::writeRaw(const char* s) {
+    while (*s) {
+        writeRaw(*s++);
+    }
+}
+
+void JSON_Writer::writeSeparator() {
+    if (!first_member) {
+        writeRaw(',');
+    }
+    first_member = false;
+}
+
+void JSON_Writer::writeKey(const char* key) {
+    writeSeparator();
+    writeEscaped(key);
+    writeRaw(':');
+}
+
+void JSON_Writer::writeEscaped(const char* s) {
+    writeRaw('"');
+    if (s != nullptr) {
+        for (; *s; s++) {
+            char c = *s;
+            switch (c) {
+                case '"':  writeRaw("\\\""); break;
+                case '\\': writeRaw("\\\\"); break;
+                case '\b': writeRaw("\\b"); break;
+                case '\f': writeRaw("\\f"); break;
+                case '\n': writeRaw("\\n"); break;
+                case '\r': writeRaw("\\r"); break;
+                case '\t': writeRaw("\\t"); break;
+                default:   writeRaw(c); break;
+            }
+        }
+    }
+    writeRaw('"');
+}
+
+void JSON_Writer::writeUnsigned(uint32_t value) {
+    char digits[11];
+    int8_t count = 0;
+
+    do {
+        digits[count++] = (char)('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+
+    while (count > 0) {
+        writeRaw(digits[--count]);
+    }
+}
+
+void JSON_Writer::writeSigned(int32_t value) {
+    if (value < 0) {
+        writeRaw('-');
+        writeUnsigned((uint32_t)0 - (uint32_t)value);
+    } else {
+        writeUnsigned((uint32_t)value);
+    }
+}
+
+// Mirrors ArduinoJson's TextFormatter::writeFloat / FloatParts<double>
+void JSON_Writer::writeDouble(double value) {
+    if (isnan(value) || isinf(value)) {
+        writeRaw("null");
+        return;
+    }
+
+    if (value < 0.0) {
+        writeRaw('-');
+        value = -value;
+    }
+
+    uint32_t max_decimal_part = 1000000000;
+    int8_t decimal_places = 9;
+
+    int16_t exponent = normalizeDouble(value);
+
+    uint32_t integral = (uint32_t)value;
+    for (uint32_t tmp = integral; tmp >= 10; tmp /= 10) {
+        max_decimal_part /= 10;
+        decimal_places--;
+    }
+
+    double remainder = (value - (double)integral) * (double)max_decimal_part;
+    uint32_t decimal = (uint32_t)remainder;
+    remainder = remainder - (double)decimal;
+
+    // Round half up
+    decimal += (uint32_t)(remainder * 2);
+    if (decimal >= max_decimal_part) {
+        decimal = 0;
+        integral++;
+        if (exponent && integral >= 10) {
+            exponent++;
+            integral = 1;
+        }
+    }
+
+    // Remove trailing zeros
+    while (decimal % 10 == 0 && decimal_places > 0) {
+        decimal /= 10;
+        decimal_places--;
+    }
+
+    writeUnsigned(integral);
+    if (decimal_places) {
+        writeDecimals(decimal, decimal_places);
+    }
+    if (exponent) {
+        writeRaw('e');
+        writeSigned(exponent);
+    }
+}
+
+void JSON_Writer::writeDecimals(uint32_t value, int8_t width) {
+    char digits[16];
+    char* end = digits + sizeof(digits);
+    char* begin = end;
+
+    while (width--) {
+        *--begin = (char)('0' + value % 10);
+        value /= 10;
+    }
+    *--begin = '.';
+
+    while (begin < end) {
+        writeRaw(*begin++);
+    }
+}
+
+int16_t JSON_Writer::normalizeDouble(double& value) {
+    int16_t powers_of_10 = 0;
+    int8_t index = 8;
+    int bit = 1 << index;
+
+    if (value >= JSON_POSITIVE_EXPONENT_THRESHOLD) {
+        for (; index >= 0; index--) {
+            if (value >= POSITIVE_BINARY_POWERS_OF_TEN[index]) {
+                value *= NEGATIVE_BINARY_POWERS_OF_TEN[index];
+                powers_of_10 = (int16_t)(powers_of_10 + bit);
+            }
+            bit >>= 1;
+        }
+    }
+
+    if (value > 0 && value <= JSON_NEGATIVE_EXPONENT_THRESHOLD) {
+        for (; index >= 0; index--) {
+            if (value < NEGATIVE_BINARY_POWERS_OF_TEN_PLUS_ONE[index]) {
+                value *= POSITIVE_BINARY_POWERS_OF_TEN[index];
+                powers_of_10 = (int16_t)(powers_of_10 - bit);
+            }
+            bit >>= 1;
+        }
+    }
+
+    return powers_of_10;
+}
+
+// Payload layouts
+
+static void writeMemoryStats(JSON_Writer& json, const MemoryStats_t& memory) {
+    json.beginObject("memory");
+    json.addUInt("free_heap", memory.free_heap);
+    json.addUInt("min_free_heap", memory.min_free_heap);
+    json.addUInt("largest_free_block", memory.largest_free_block);
+    json.addUInt("fragmentation_pct", memory.fragmentation_pct);
+    json.addUInt("psram_free", memory.psram_free);
+    json.addUInt("min_stack_headroom", memory.min_stack_headroom);
+    json.addUInt("window_heap_min", memory.window_heap_min);
+    json.addUInt("window_heap_max", memory.window_heap_max);
+    json.addUInt("window_block_min", memory.window_block_min);
+
+    json.beginArray("heap_trend");
+    for (uint8_t i = 0; i < memory.trend_count && i < MEMORY_TREND_WINDOWS; i++) {
+        json.addUInt(memory.heap_trend[i]);
+    }
+    json.endArray();
+    json.endObject();
+}
+
+static void writeBootStats(JSON_Writer& json, const BootStats_t& boot) {
+    json.beginObject("boot");
+    json.addUInt("monitoring_ms", boot.monitoring_ms);
+    json.addUInt("complete_ms", boot.complete_ms);
+    json.addUInt("failed", boot.failed_steps);
+
+    // Per step: [start_ms, duration_ms]
+    json.beginObject("steps");
+    for (uint8_t i = 0; i < boot.step_count && i < BOOT_MAX_STEPS; i++) {
+        json.beginArray(boot.steps[i].name);
+        json.addUInt(boot.steps[i].start_ms);
+        json.addUInt(boot.steps[i].duration_ms);
+        json.endArray();
+    }
+    json.endObject();
+    json.endObject();
+}
+
+size_t writeEmergencyJSON(const EmergencyData_t& data, char* buffer, size_t capacity) {
+    JSON_Writer json(buffer, capacity);
+
+    json.beginObject();
+    json.addUInt("timestamp", data.timestamp);
+    json.addUInt("confidence_score", data.confidence_score);
+    json.addInt("confidence_level", data.confidence);
+    json.addFloat("battery_level", data.battery_level);
+    json.addBool("sos_triggered", data.sos_triggered);
+    json.addString("device_id", data.device_id);
+
+    // Add sensor history (last 10 samples for brevity)
+    json.beginArray("sensor_history");
+    const int history_size = sizeof(data.sensor_history) / sizeof(data.sensor_history[0]);
+    int count = data.history_count < history_size ? data.history_count : history_size;
+    for (int i = count > 10 ? count - 10 : 0; i < count; i++) {
+        const SensorData_t& sample = data.sensor_history[i];
+        json.beginObject();
+        json.addUInt("timestamp", sample.timestamp);
+        json.addFloat("accel_x", sample.accel_x);
+        json.addFloat("accel_y", sample.accel_y);
+        json.addFloat("accel_z", sample.accel_z);
+        json.addFloat("gyro_x", sample.gyro_x);
+        json.addFloat("gyro_y", sample.gyro_y);
+        json.addFloat("gyro_z", sample.gyro_z);
+        json.addFloat("heart_rate", sample.heart_rate);
+        json.endObject();
+    }
+    json.endArray();
+    json.endObject();
+
+    return json.size();
+}
+
+size_t writeStatusJSON(const StatusData_t& data, char* buffer, size_t capacity) {
+    JSON_Writer json(buffer, capacity);
+
+    json.beginObject();
+    json.addUInt("timestamp", data.timestamp);
+    json.addFloat("battery_level", data.battery_level);
+    json.addBool("system_health", data.system_health);
+    json.addUInt("uptime", data.uptime);
+    json.addString("status_message", data.status_message);
+    writeMemoryStats(json, data.memory);
+    writeBootStats(json, data.boot);
+    json.endObject();
+
+    return json.size();
+}
+
+size_t writeSensorJSON(const SensorData_t& data, char* buffer, size_t capacity) {
+    JSON_Writer json(buffer, capacity);
+
+    json.beginObject();
+    json.addUInt("timestamp", data.timestamp);
+    json.addFloat("accel_x", data.accel_x);
+    json.addFloat("accel_y", data.accel_y);
+    json.addFloat("accel_z", data.accel_z);
+    json.addFloat("gyro_x", data.gyro_x);
+    json.addFloat("gyro_y", data.gyro_y);
+    json.addFloat("gyro_z", data.gyro_z);
+    json.addFloat("pressure", data.pressure);
+    json.addFloat("heart_rate", data.heart_rate);
+    json.addUInt("fsr_value", data.fsr_value);
+    json.endObject();
+
+    return json.size();
+}
+
+size_t writeBLEEmergencyJSON(const EmergencyData_t& data, char* buffer, size_t capacity) {
+    JSON_Writer json(buffer, capacity);
+
+    json.beginObject();
+    json.addString("type", "emergency");
+    json.addUInt("timestamp", data.timestamp);
+    json.addUInt("confidence_score", data.confidence_score);
+    json.addInt("confidence_level", data.confidence);
+    json.addFloat("battery_level", data.battery_level);
+    json.addBool("sos_triggered", data.sos_triggered);
+    json.addString("device_id", data.device_id);
+    json.endObject();
+
+    return json.size();
+}
+
+size_t writeBLESensorJSON(const SensorData_t& data, char* buffer, size_t capacity) {
+    JSON_Writer json(buffer, capacity);
+
+    json.beginObject();
+    json.addString("type", "sensor");
+    json.addUInt("timestamp", data.timestamp);
+    json.addFloat("accel_x", data.accel_x);
+    json.addFloat("accel_y", data.accel_y);
+    json.addFloat("accel_z", data.accel_z);
+    json.addFloat("gyro_x", data.gyro_x);
+    json.addFloat("gyro_y", data.gyro_y);
+    json.addFloat("gyro_z", data.gyro_z);
+    json.addFloat("heart_rate", data.heart_rate);
+    json.addFloat("pressure", data.pressure);
+    json.endObject();
+
+    return json.size();
+}
+
+size_t writeBLEStatusJSON(const SystemStatus_t& data, char* buffer, size_t capacity) {
+    JSON_Writer json(buffer, capacity);
+
+    json.beginObject();
+    json.addString("type", "status");
+    json.addBool("sensors_initialized", data.sensors_initialized);
+    json.addBool("wifi_connected", data.wifi_connected);
+    json.addBool("bluetooth_connected", data.bluetooth_connected);
+    json.addFloat("battery_percentage", data.battery_percentage);
+    json.addInt("current_status", data.current_status);
+    json.addUInt("uptime_ms", data.uptime_ms);
+    writeMemoryStats(json, data.memory);
+    writeBootStats(json, data.boot);
+    json.endObject();
+
+    return json.size();
+}
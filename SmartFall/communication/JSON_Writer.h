@@ -0,0 +1,85 @@
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <Arduino.h>
+#include "../utils/data_types.h"
+
+// Worst-case serialized sizes for the fixed payload layouts below.
+// A float is at most 26 chars ("-4294967295.123456789e-308" style),
+// a uint32_t at most 10 and a 32-byte device ID at most 64 once escaped.
+#define JSON_FLOAT_MAX_CHARS        26
+#define JSON_EMERGENCY_BUFFER_SIZE  3072  // WiFi layout, 10 history samples
+#define JSON_BLE_BUFFER_SIZE        1024  // Largest BLE layout (status + memory + boot)
+#define JSON_STATUS_BUFFER_SIZE     1024
+#define JSON_SENSOR_BUFFER_SIZE     512
+
+/*
+ * Streaming JSON writer over a caller-supplied buffer.
+ *
+ * Produces output byte-identical to ArduinoJson 6 serializeJson() for the
+ * value types used by the SmartFall payloads (insertion order, no
+ * whitespace, ArduinoJson float formatting), without touching the heap.
+ * Writes past the end of the buffer are dropped and flagged; check ok()
+ * before using the result.
+ */
+class JSON_Writer {
+private:
+    char* buffer;
+    size_t capacity;
+    size_t length;
+    bool overflow;
+    bool first_member;  // Next member needs no leading comma
+
+public:
+    JSON_Writer(char* buffer, size_t capacity);
+
+    void reset();
+
+    // Structure
+    void beginObject();
+    void beginObject(const char* key);
+    void endObject();
+    void beginArray(const char* key);
+    void endArray();
+
+    // Members (keyed, for objects)
+    void addString(const char* key, const char* value);
+    void addUInt(const char* key, uint32_t value);
+    void addInt(const char* key, int32_t value);
+    void addFloat(const char* key, float value);
+    void addBool(const char* key, bool value);
+
+    // Elements (unkeyed, for arrays)
+    void addUInt(uint32_t value);
+
+    // Result
+    bool ok();
+    size_t size();
+    const char* c_str();
+    const uint8_t* data();
+
+private:
+    void writeRaw(char c);
+    void writeRaw(const char* s);
+    void writeSeparator();
+    void writeKey(const char* key);
+    void writeEscaped(const char* s);
+    void writeUnsigned(uint32_t value);
+    void writeSigned(int32_t value);
+    void writeDouble(double value);
+    void writeDecimals(uint32_t value, int8_t width);
+    static int16_t normalizeDouble(double& value);
+};
+
+// Fixed payload layouts (field order matches the historical ArduinoJson
+// documents so the server and mobile app parsers see identical bytes).
+// Each returns the payload length, or 0 if the buffer was too small.
+size_t writeEmergencyJSON(const EmergencyData_t& data, char* buffer, size_t capacity);
+size_t writeStatusJSON(const StatusData_t& data, char* buffer, size_t capacity);
+size_t writeSensorJSON(const SensorData_t& data, char* buffer, size_t capacity);
+
+size_t writeBLEEmergencyJSON(const EmergencyData_t& data, char* buffer, size_t capacity);
+size_t writeBLESensorJSON(const SensorData_t& data, char* buffer, size_t capacity);
+size_t writeBLEStatusJSON(const SystemStatus_t& data, char* buffer, size_t capacity);
+
+#endif // JSON_WRITER_H
@@ -1,10 +1,20 @@
 #include "WiFi_Manager.h"
-#include <ArduinoJson.h>
+#include "../diagnostics/Profiler.h"
 
 WiFi_Manager::WiFi_Manager() : initialized(false), connected(false),
                                  last_reconnect_attempt(0), reconnect_interval(30000),
                                  connection_attempts(0), auto_reconnect(true),
-                                 last_status_check(0) {
+                                 last_status_check(0), warm_pending(false),
+                                 alert_socket(SERVER_CA_CERT), alert_http(&alert_socket),
+                                 alert_mutex(nullptr),
+                                 http_socket(SERVER_CA_CERT), http(&http_socket),
+                                 http_mutex(nullptr) {
+    server_url[0] = '\0';
+    emergency_endpoint[0] = '\0';
+    status_endpoint[0] = '\0';
+    sensor_endpoint[0] = '\0';
+    alert_buffer[0] = '\0';
+    json_buffer[0] = '\0';
 }
 
 WiFi_Manager::~WiFi_Manager() {
@@ -32,6 +42,22 @@ bool WiFi_Manager::begin(const char* ssid_param, const char* password_param) {
         return false;
     }
 
+    alert_mutex = xSemaphoreCreateRecursiveMutex();
+    http_mutex = xSemaphoreCreateRecursiveMutex();
+    if (alert_mutex == nullptr || http_mutex == nullptr) {
+        Serial.println("[WiFi] ERROR: Failed to create HTTP mutex!");
+        return false;
+    }
+
+    // Only the alert socket stays open: a second one would hold another
+    // TLS session's buffers for a POST every STATUS_UPDATE_INTERVAL_MS.
+    // A heartbeat answers in milliseconds, so it gets a short timeout and
+    // cannot hold an alert back for long. The status POST runs on the
+    // comms task, whose every step must end within COMMS_RESTART_MS.
+    alert_http.setTimeouts(HTTP_CONNECT_TIMEOUT_MS, HTTP_HEARTBEAT_TIMEOUT_MS);
+    http.setTimeouts(HTTP_CONNECT_TIMEOUT_MS, HTTP_STATUS_TIMEOUT_MS);
+    http.setKeepAlive(false);
+
     WiFi.mode(WIFI_STA);
     WiFi.setAutoReconnect(false);  // We handle reconnection manually
 
@@ -42,13 +68,55 @@ bool WiFi_Manager::begin(const char* ssid_param, const char* password_param) {
 }
 
 void WiFi_Manager::setServerURL(const char* url) {
-    server_url = String(url);
+    strncpy(server_url, url, sizeof(server_url) - 1);
+    server_url[sizeof(server_url) - 1] = '\0';
+
+    snprintf(emergency_endpoint, sizeof(emergency_endpoint), "%s/api/emergency", server_url);
+    snprintf(status_endpoint, sizeof(status_endpoint), "%s/api/status", server_url);
+    snprintf(sensor_endpoint, sizeof(sensor_endpoint), "%s/api/sensor", server_url);
+
+    if (lockConnection(alert_mutex)) {
+        alert_http.setServer(server_url);
+        if (connected) {
+            alert_http.warm();
+        }
+        unlockConnection(alert_mutex);
+    }
+
     if (DEBUG_COMMUNICATION) {
         Serial.print("[WiFi] Server URL set to: ");
         Serial.println(server_url);
     }
 }
 
+bool WiFi_Manager::setCredentials(const char* ssid_param, const char* password_param) {
+    if (ssid_param == nullptr || ssid_param[0] == '\0') {
+        return false;
+    }
+
+    if (ssid == ssid_param && password == password_param) {
+        return true;
+    }
+
+    ssid = String(ssid_param);
+    password = String(password_param);
+
+    if (!initialized) {
+        return true;  // Used by the next begin()
+    }
+
+    // Start joining without waiting; checkConnection() picks up the result
+    WiFi.disconnect();
+    connected = false;
+    connection_attempts = 0;
+    last_reconnect_attempt = millis();
+    WiFi.begin(ssid.c_str(), password.c_str());
+
+    Serial.print("[WiFi] Credentials updated, joining: ");
+    Serial.println(ssid);
+    return true;
+}
+
 bool WiFi_Manager::connect() {
     return connect(ssid.c_str(), password.c_str());
 }
@@ -82,6 +150,11 @@ bool WiFi_Manager::connect(const char* ssid_param, const char* password_param) {
         connection_attempts = 0;
         Serial.println("[WiFi] ✓ Connected!");
         printConnectionInfo();
+
+        // The comms task opens the alert socket on its next pass, so the
+        // first alert doesn't pay the handshake and a reconnect doesn't
+        // pay it on top of the WiFi join
+        warm_pending = true;
         return true;
     } else {
         connected = false;
@@ -94,6 +167,16 @@ bool WiFi_Manager::connect(const char* ssid_param, const char* password_param) {
 
 void WiFi_Manager::disconnect() {
     if (connected) {
+        // A request still holding a connection fails with the link, and the
+        // next one finds its socket closed
+        if (lockConnection(alert_mutex, WIFI_LOCK_WAIT_MS)) {
+            alert_http.close();
+            unlockConnection(alert_mutex);
+        }
+        if (lockConnection(http_mutex, WIFI_LOCK_WAIT_MS)) {
+            http.close();
+            unlockConnection(http_mutex);
+        }
         WiFi.disconnect();
         connected = false;
         Serial.println("[WiFi] Disconnected");
@@ -120,15 +203,17 @@ void WiFi_Manager::enableAutoReconnect(bool enable) {
     }
 }
 
+// At most one blocking step per call (reconnect, socket warm-up or
+// heartbeat), so the comms task checks in between them
 void WiFi_Manager::checkConnection() {
-    if (!initialized || !auto_reconnect) {
+    if (!initialized) {
         return;
     }
 
     uint32_t current_time = millis();
 
     // Check status every 5 seconds
-    if (current_time - last_status_check >= 5000) {
+    if (auto_reconnect && current_time - last_status_check >= 5000) {
         last_status_check = current_time;
         updateConnectionStatus();
 
@@ -136,8 +221,21 @@ void WiFi_Manager::checkConnection() {
             last_reconnect_attempt = current_time;
             Serial.println("[WiFi] Connection lost, attempting reconnect...");
             reconnect();
+            return;
         }
     }
+
+    // Open the alert socket after a (re)connect, otherwise heartbeat it or
+    // reopen it after an idle close; skipped while an alert holds it
+    if (connected && lockConnection(alert_mutex, 0)) {
+        if (warm_pending) {
+            warm_pending = false;
+            alert_http.warm();
+        } else {
+            alert_http.service();
+        }
+        unlockConnection(alert_mutex);
+    }
 }
 
 String WiFi_Manager::getSSID() {
@@ -156,28 +254,52 @@ String WiFi_Manager::getMACAddress() {
     return WiFi.macAddress();
 }
 
-bool WiFi_Manager::sendEmergencyAlert(const EmergencyData_t& emergency_data) {
+bool WiFi_Manager::sendEmergencyAlert(const EmergencyData_t& emergency_data, uint32_t timeout_ms) {
     if (!connected) {
         Serial.println("[WiFi] Cannot send alert - not connected");
         return false;
     }
 
-    if (server_url.length() == 0) {
+    if (server_url[0] == '\0') {
         Serial.println("[WiFi] ERROR: Server URL not set!");
         return false;
     }
 
-    String json_payload = createEmergencyJSON(emergency_data);
-    String response;
-
-    String endpoint = server_url + "/api/emergency";
+    // Only a heartbeat or a reopen can hold the alert socket; the wait
+    // comes out of the caller's deadline
+    uint32_t start = millis();
+    if (!lockConnection(alert_mutex, timeout_ms)) {
+        Serial.println("[WiFi] ✗ Alert connection busy past the deadline");
+        return false;
+    }
+    uint32_t waited = millis() - start;
+    timeout_ms = waited < timeout_ms ? timeout_ms - waited : 0;
+
+    bool binary = EMERGENCY_BINARY_PAYLOAD;
+    size_t length = binary ? createEmergencyBinary(emergency_data) : createEmergencyJSON(emergency_data);
+    if (length == 0) {
+        unlockConnection(alert_mutex);
+        Serial.println("[WiFi] ERROR: Emergency payload exceeds buffer!");
+        return false;
+    }
 
     if (DEBUG_COMMUNICATION) {
         Serial.println("[WiFi] Sending emergency alert...");
-        Serial.println(json_payload);
+        if (binary) {
+            Serial.print("[WiFi] Binary alert: ");
+            Serial.print(length);
+            Serial.println(" bytes");
+        } else {
+            Serial.println(alert_buffer);
+        }
     }
 
-    bool success = sendHTTPPost(endpoint.c_str(), json_payload);
+    // Bounded by the caller's deadline rather than the default timeouts
+    alert_http.setTimeouts(timeout_ms < HTTP_CONNECT_TIMEOUT_MS ? timeout_ms : HTTP_CONNECT_TIMEOUT_MS, timeout_ms);
+    bool success = post(alert_http, emergency_endpoint, (const uint8_t*)alert_buffer, length,
+                        binary ? ALERT_CONTENT_TYPE : "application/json");
+    alert_http.setTimeouts(HTTP_CONNECT_TIMEOUT_MS, HTTP_HEARTBEAT_TIMEOUT_MS);
+    unlockConnection(alert_mutex);
 
     if (success) {
         Serial.println("[WiFi] ✓ Emergency alert sent successfully");
@@ -191,62 +313,53 @@ bool WiFi_Manager::sendEmergencyAlert(const EmergencyData_t& emergency_data) {
 bool WiFi_Manager::sendStatusUpdate(const StatusData_t& status_data) {
     if (!connected) return false;
 
-    String json_payload = createStatusJSON(status_data);
-    String endpoint = server_url + "/api/status";
-
-    return sendHTTPPost(endpoint.c_str(), json_payload);
+    if (!lockConnection(http_mutex, WIFI_LOCK_WAIT_MS)) return false;
+    size_t length = createStatusJSON(status_data);
+    bool success = length > 0 && post(http, status_endpoint, (const uint8_t*)json_buffer, length,
+                                      "application/json");
+    unlockConnection(http_mutex);
+    return success;
 }
 
 bool WiFi_Manager::sendSensorData(const SensorData_t& sensor_data) {
     if (!connected) return false;
 
-    String json_payload = createSensorDataJSON(sensor_data);
-    String endpoint = server_url + "/api/sensor";
-
-    return sendHTTPPost(endpoint.c_str(), json_payload);
+    if (!lockConnection(http_mutex, WIFI_LOCK_WAIT_MS)) return false;
+    size_t length = createSensorDataJSON(sensor_data);
+    bool success = length > 0 && post(http, sensor_endpoint, (const uint8_t*)json_buffer, length,
+                                      "application/json");
+    unlockConnection(http_mutex);
+    return success;
 }
 
 bool WiFi_Manager::sendHTTPPost(const char* endpoint, const String& json_payload) {
+    return sendHTTPPost(endpoint, (const uint8_t*)json_payload.c_str(), json_payload.length());
+}
+
+bool WiFi_Manager::sendHTTPPost(const char* endpoint, const uint8_t* payload, size_t length,
+                               const char* content_type) {
     if (!connected) {
         Serial.println("[WiFi] Cannot send POST - not connected");
         return false;
     }
 
-    http.begin(endpoint);
-    http.addHeader("Content-Type", "application/json");
-    http.setTimeout(10000);  // 10-second timeout
-
-    int http_code = http.POST(json_payload);
-
-    bool success = (http_code == HTTP_CODE_OK || http_code == HTTP_CODE_CREATED);
-
-    if (DEBUG_COMMUNICATION) {
-        Serial.print("[WiFi] POST ");
-        Serial.print(endpoint);
-        Serial.print(" - Status: ");
-        Serial.println(http_code);
-    }
-
-    http.end();
+    if (!lockConnection(http_mutex, WIFI_LOCK_WAIT_MS)) return false;
+    bool success = post(http, endpoint, payload, length, content_type);
+    unlockConnection(http_mutex);
     return success;
 }
 
 bool WiFi_Manager::sendHTTPGet(const char* endpoint, String& response) {
     if (!connected) return false;
 
-    http.begin(endpoint);
-    http.setTimeout(10000);
-
-    int http_code = http.GET();
-
-    if (http_code == HTTP_CODE_OK) {
-        response = http.getString();
-        http.end();
-        return true;
+    // Response lands in the status payload buffer
+    if (!lockConnection(http_mutex, WIFI_LOCK_WAIT_MS)) return false;
+    int http_code = http.get(endpoint, json_buffer, sizeof(json_buffer));
+    if (http_code == 200) {
+        response = json_buffer;
     }
-
-    http.end();
-    return false;
+    unlockConnection(http_mutex);
+    return http_code == 200;
 }
 
 void WiFi_Manager::setReconnectInterval(uint32_t interval_ms) {
@@ -288,72 +401,53 @@ void WiFi_Manager::printNetworkStatus() {
     }
 }
 
+void WiFi_Manager::printHTTPStats() {
+    Serial.println("[WiFi] Alert connection:");
+    alert_http.printStats();
+    Serial.println("[WiFi] Status connection:");
+    http.printStats();
+}
+
 bool WiFi_Manager::isInitialized() {
     return initialized;
 }
 
 // Private helper functions
 
-String WiFi_Manager::createEmergencyJSON(const EmergencyData_t& data) {
-    DynamicJsonDocument doc(4096);
-
-    doc["timestamp"] = data.timestamp;
-    doc["confidence_score"] = data.confidence_score;
-    doc["confidence_level"] = data.confidence;
-    doc["battery_level"] = data.battery_level;
-    doc["sos_triggered"] = data.sos_triggered;
-    doc["device_id"] = String(data.device_id);
-
-    // Add sensor history (last 10 samples for brevity)
-    JsonArray history = doc.createNestedArray("sensor_history");
-    for (int i = 90; i < 100; i++) {
-        JsonObject sample = history.createNestedObject();
-        sample["timestamp"] = data.sensor_history[i].timestamp;
-        sample["accel_x"] = data.sensor_history[i].accel_x;
-        sample["accel_y"] = data.sensor_history[i].accel_y;
-        sample["accel_z"] = data.sensor_history[i].accel_z;
-        sample["gyro_x"] = data.sensor_history[i].gyro_x;
-        sample["gyro_y"] = data.sensor_history[i].gyro_y;
-        sample["gyro_z"] = data.sensor_history[i].gyro_z;
-        sample["heart_rate"] = data.sensor_history[i].heart_rate;
+bool WiFi_Manager::post(HTTP_Connection& connection, const char* endpoint, const uint8_t* payload,
+                        size_t length, const char* content_type) {
+    int http_code;
+    {
+        PROFILE_SCOPE(PROFILE_HTTP_POST);
+        http_code = connection.post(endpoint, payload, length, content_type);
     }
 
-    String json_string;
-    serializeJson(doc, json_string);
-    return json_string;
-}
+    bool success = (http_code == 200 || http_code == 201);
 
-String WiFi_Manager::createStatusJSON(const StatusData_t& data) {
-    DynamicJsonDocument doc(512);
+    if (DEBUG_COMMUNICATION) {
+        Serial.print("[WiFi] POST ");
+        Serial.print(endpoint);
+        Serial.print(" - Status: ");
+        Serial.println(http_code);
+    }
 
-    doc["timestamp"] = data.timestamp;
-    doc["battery_level"] = data.battery_level;
-    doc["system_health"] = data.system_health;
-    doc["uptime"] = data.uptime;
-    doc["status_message"] = String(data.status_message);
+    return success;
+}
 
-    String json_string;
-    serializeJson(doc, json_string);
-    return json_string;
+size_t WiFi_Manager::createEmergencyJSON(const EmergencyData_t& data) {
+    return writeEmergencyJSON(data, alert_buffer, sizeof(alert_buffer));
 }
 
-String WiFi_Manager::createSensorDataJSON(const SensorData_t& data) {
-    DynamicJsonDocument doc(512);
+size_t WiFi_Manager::createEmergencyBinary(const EmergencyData_t& data) {
+    return encodeAlert(data, (uint8_t*)alert_buffer, sizeof(alert_buffer), EMERGENCY_PAYLOAD_LZ);
+}
 
-    doc["timestamp"] = data.timestamp;
-    doc["accel_x"] = data.accel_x;
-    doc["accel_y"] = data.accel_y;
-    doc["accel_z"] = data.accel_z;
-    doc["gyro_x"] = data.gyro_x;
-    doc["gyro_y"] = data.gyro_y;
-    doc["gyro_z"] = data.gyro_z;
-    doc["pressure"] = data.pressure;
-    doc["heart_rate"] = data.heart_rate;
-    doc["fsr_value"] = data.fsr_value;
+size_t WiFi_Manager::createStatusJSON(const StatusData_t& data) {
+    return writeStatusJSON(data, json_buffer, sizeof(json_buffer));
+}
 
-    String json_string;
-    serializeJson(doc, json_string);
-    return json_string;
+size_t WiFi_Manager::createSensorDataJSON(const SensorData_t& data) {
+    return writeSensorJSON(data, json_buffer, sizeof(json_buffer));
 }
 
 void WiFi_Manager::updateConnectionStatus() {
@@ -362,7 +456,26 @@ void WiFi_Manager::updateConnectionStatus() {
 
     if (prev_connected && !connected) {
         Serial.println("[WiFi] Connection lost!");
+        if (lockConnection(alert_mutex, 0)) {
+            alert_http.close();
+            unlockConnection(alert_mutex);
+        }
+        if (lockConnection(http_mutex, 0)) {
+            http.close();
+            unlockConnection(http_mutex);
+        }
     } else if (!prev_connected && connected) {
         Serial.println("[WiFi] Connection restored!");
+        warm_pending = true;   // Any task may ask; the comms task opens the socket
     }
 }
+
+bool WiFi_Manager::lockConnection(SemaphoreHandle_t mutex, uint32_t wait_ms) {
+    if (mutex == nullptr) return false;
+    TickType_t ticks = (wait_ms == portMAX_DELAY) ? portMAX_DELAY : pdMS_TO_TICKS(wait_ms);
+    return xSemaphoreTakeRecursive(mutex, ticks) == pdTRUE;
+}
+
+void WiFi_Manager::unlockConnection(SemaphoreHandle_t mutex) {
+    xSemaphoreGiveRecursive(mutex);
+}
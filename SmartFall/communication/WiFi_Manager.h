@@ -3,9 +3,13 @@
 
 #include <Arduino.h>
 #include <WiFi.h>
-#include <HTTPClient.h>
 #include "../utils/data_types.h"
 #include "../utils/config.h"
+#include "JSON_Writer.h"
+#include "Alert_Codec.h"
+#include "HTTP_Connection.h"
+
+#define WIFI_URL_MAX_LENGTH         128
 
 class WiFi_Manager {
 private:
@@ -13,7 +17,14 @@ private:
     bool connected;
     String ssid;
     String password;
-    String server_url;
+
+    // Server endpoints, built once in setServerURL() so sends don't
+    // concatenate Strings on every call
+    char server_url[WIFI_URL_MAX_LENGTH];
+    char emergency_endpoint[WIFI_URL_MAX_LENGTH];
+    char status_endpoint[WIFI_URL_MAX_LENGTH];
+    char sensor_endpoint[WIFI_URL_MAX_LENGTH];
+
     uint32_t last_reconnect_attempt;
     uint32_t reconnect_interval;
     uint8_t connection_attempts;
@@ -21,9 +32,20 @@ private:
     // Connection state
     bool auto_reconnect;
     uint32_t last_status_check;
+    volatile bool warm_pending;     // Alert socket to open on the next checkConnection()
+
+    // Persistent connection for alerts only, so an alert never queues
+    // behind a status POST waiting out its response timeout
+    WiFi_Socket alert_socket;
+    HTTP_Connection alert_http;
+    SemaphoreHandle_t alert_mutex;  // Alert task and the heartbeat share the socket and buffer
+    char alert_buffer[JSON_EMERGENCY_BUFFER_SIZE];
 
-    // HTTP client
-    HTTPClient http;
+    // Status, sensor and GET requests, one socket per request
+    WiFi_Socket http_socket;
+    HTTP_Connection http;
+    SemaphoreHandle_t http_mutex;
+    char json_buffer[JSON_STATUS_BUFFER_SIZE];
 
 public:
     WiFi_Manager();
@@ -33,6 +55,7 @@ public:
     bool begin(const char* ssid, const char* password);
     bool begin();  // Use credentials from config.h
     void setServerURL(const char* url);
+    bool setCredentials(const char* ssid, const char* password);  // Non-blocking network switch
 
     // Connection management
     bool connect();
@@ -52,12 +75,15 @@ public:
     String getMACAddress();
 
     // Emergency alert transmission
-    bool sendEmergencyAlert(const EmergencyData_t& emergency_data);
+    bool sendEmergencyAlert(const EmergencyData_t& emergency_data,
+                            uint32_t timeout_ms = HTTP_RESPONSE_TIMEOUT_MS);
     bool sendStatusUpdate(const StatusData_t& status_data);
     bool sendSensorData(const SensorData_t& sensor_data);
 
     // HTTP requests
     bool sendHTTPPost(const char* endpoint, const String& json_payload);
+    bool sendHTTPPost(const char* endpoint, const uint8_t* payload, size_t length,
+                      const char* content_type = "application/json");
     bool sendHTTPGet(const char* endpoint, String& response);
 
     // Utility functions
@@ -68,15 +94,20 @@ public:
     // Debug functions
     void printConnectionInfo();
     void printNetworkStatus();
+    void printHTTPStats();
     bool isInitialized();
 
 private:
     // Internal helper functions
-    String createEmergencyJSON(const EmergencyData_t& data);
-    String createStatusJSON(const StatusData_t& data);
-    String createSensorDataJSON(const SensorData_t& data);
-    bool performHTTPRequest(const String& url, const String& payload, String& response);
+    size_t createEmergencyJSON(const EmergencyData_t& data);
+    size_t createEmergencyBinary(const EmergencyData_t& data);
+    size_t createStatusJSON(const StatusData_t& data);
+    size_t createSensorDataJSON(const SensorData_t& data);
     void updateConnectionStatus();
+    bool post(HTTP_Connection& connection, const char* endpoint, const uint8_t* payload,
+              size_t length, const char* content_type);
+    static bool lockConnection(SemaphoreHandle_t mutex, uint32_t wait_ms = portMAX_DELAY);
+    static void unlockConnection(SemaphoreHandle_t mutex);
 };
 
 #endif // WIFI_MANAGER_H
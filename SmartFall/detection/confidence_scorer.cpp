@@ -1,7 +1,13 @@
 #include "confidence_scorer.h"
+#include "../diagnostics/Deferred_Log.h"
+
+#define FSR_IMPACT_POINTS   7       // Stage 2: the FSR saw the impact
+#define FSR_STRAP_POINTS    2       // Filter: device attached throughout
+#define FSR_SPIKE_POINTS    3       // Filter: impact spike
 
 ConfidenceScorer::ConfidenceScorer() : stage1_score(0), stage2_score(0), stage3_score(0),
-                                       stage4_score(0), filter_score(0),
+                                       stage4_score(0), filter_score(0), classifier_score(0),
+                                       tiers(DEFAULT_SCORE_TIERS), available_sensors(HARDWARE_ALL),
                                        scoring_active(false), scoring_start_time(0) {
     resetScore();
 }
@@ -16,6 +22,7 @@ void ConfidenceScorer::resetScore() {
     stage3_score = 0;
     stage4_score = 0;
     filter_score = 0;
+    classifier_score = 0;
 
     // Reset detailed breakdowns
     stage1_breakdown = {0, 0};
@@ -36,27 +43,22 @@ void ConfidenceScorer::startScoring() {
 void ConfidenceScorer::addStage1Score(float duration_ms, float min_magnitude_g) {
     if (!scoring_active) startScoring();
 
-    stage1_breakdown.duration_score = calculateDurationScore(duration_ms);
-    stage1_breakdown.magnitude_score = calculateMagnitudeScore(min_magnitude_g);
+    stage1_breakdown.duration_score = scoreTier(tiers.tables[SCORE_FREEFALL_DURATION], duration_ms);
+    stage1_breakdown.magnitude_score = scoreTier(tiers.tables[SCORE_FREEFALL_DEPTH], min_magnitude_g);
 
     stage1_score = stage1_breakdown.duration_score + stage1_breakdown.magnitude_score;
     capScore(stage1_score, 25);
 
     if (DEBUG_ALGORITHM_STEPS) {
-        Serial.print("Stage 1 Score: ");
-        Serial.print(stage1_score);
-        Serial.print("/25 (Duration: ");
-        Serial.print(stage1_breakdown.duration_score);
-        Serial.print(", Magnitude: ");
-        Serial.print(stage1_breakdown.magnitude_score);
-        Serial.println(")");
+        Deferred_Log::log(DLOG_STAGE1_SCORE, stage1_score,
+                          stage1_breakdown.duration_score, stage1_breakdown.magnitude_score);
     }
 }
 
 void ConfidenceScorer::addStage2Score(float impact_g, float timing_ms, bool fsr_detected) {
-    stage2_breakdown.impact_magnitude_score = calculateImpactScore(impact_g);
-    stage2_breakdown.timing_score = calculateTimingScore(timing_ms);
-    stage2_breakdown.fsr_validation_score = fsr_detected ? 7 : 0;
+    stage2_breakdown.impact_magnitude_score = scoreTier(tiers.tables[SCORE_IMPACT], impact_g);
+    stage2_breakdown.timing_score = scoreTier(tiers.tables[SCORE_IMPACT_TIMING], timing_ms);
+    stage2_breakdown.fsr_validation_score = fsr_detected ? FSR_IMPACT_POINTS : 0;
 
     stage2_score = stage2_breakdown.impact_magnitude_score +
                   stage2_breakdown.timing_score +
@@ -64,47 +66,29 @@ void ConfidenceScorer::addStage2Score(float impact_g, float timing_ms, bool fsr_
     capScore(stage2_score, 25);
 
     if (DEBUG_ALGORITHM_STEPS) {
-        Serial.print("Stage 2 Score: ");
-        Serial.print(stage2_score);
-        Serial.print("/25 (Impact: ");
-        Serial.print(stage2_breakdown.impact_magnitude_score);
-        Serial.print(", Timing: ");
-        Serial.print(stage2_breakdown.timing_score);
-        Serial.print(", FSR: ");
-        Serial.print(stage2_breakdown.fsr_validation_score);
-        Serial.println(")");
+        Deferred_Log::log(DLOG_STAGE2_SCORE, stage2_score,
+                          stage2_breakdown.impact_magnitude_score, stage2_breakdown.timing_score,
+                          stage2_breakdown.fsr_validation_score);
     }
 }
 
 void ConfidenceScorer::addStage3Score(float angular_velocity_dps, float orientation_change_deg) {
-    stage3_breakdown.angular_velocity_score = calculateAngularScore(angular_velocity_dps);
-
-    // Orientation change scoring
-    if (orientation_change_deg >= 90.0f) {
-        stage3_breakdown.orientation_change_score = 5;
-    } else if (orientation_change_deg >= 45.0f) {
-        stage3_breakdown.orientation_change_score = 3;
-    } else {
-        stage3_breakdown.orientation_change_score = 0;
-    }
+    stage3_breakdown.angular_velocity_score = scoreTier(tiers.tables[SCORE_ROTATION], angular_velocity_dps);
+    stage3_breakdown.orientation_change_score = scoreTier(tiers.tables[SCORE_ORIENTATION], orientation_change_deg);
 
     stage3_score = stage3_breakdown.angular_velocity_score +
                   stage3_breakdown.orientation_change_score;
     capScore(stage3_score, 20);
 
     if (DEBUG_ALGORITHM_STEPS) {
-        Serial.print("Stage 3 Score: ");
-        Serial.print(stage3_score);
-        Serial.print("/20 (Angular: ");
-        Serial.print(stage3_breakdown.angular_velocity_score);
-        Serial.print(", Orientation: ");
-        Serial.print(stage3_breakdown.orientation_change_score);
-        Serial.println(")");
+        Deferred_Log::log(DLOG_STAGE3_SCORE, stage3_score,
+                          stage3_breakdown.angular_velocity_score,
+                          stage3_breakdown.orientation_change_score);
     }
 }
 
 void ConfidenceScorer::addStage4Score(float inactivity_duration_ms, bool stable) {
-    stage4_breakdown.inactivity_duration_score = calculateInactivityScore(inactivity_duration_ms);
+    stage4_breakdown.inactivity_duration_score = scoreTier(tiers.tables[SCORE_INACTIVITY], inactivity_duration_ms);
     stage4_breakdown.stability_score = stable ? 5 : 0;
 
     stage4_score = stage4_breakdown.inactivity_duration_score +
@@ -112,35 +96,45 @@ void ConfidenceScorer::addStage4Score(float inactivity_duration_ms, bool stable)
     capScore(stage4_score, 20);
 
     if (DEBUG_ALGORITHM_STEPS) {
-        Serial.print("Stage 4 Score: ");
-        Serial.print(stage4_score);
-        Serial.print("/20 (Duration: ");
-        Serial.print(stage4_breakdown.inactivity_duration_score);
-        Serial.print(", Stability: ");
-        Serial.print(stage4_breakdown.stability_score);
-        Serial.println(")");
+        Deferred_Log::log(DLOG_STAGE4_SCORE, stage4_score,
+                          stage4_breakdown.inactivity_duration_score, stage4_breakdown.stability_score);
     }
 }
 
 void ConfidenceScorer::addPressureFilterScore(float altitude_change_m) {
-    filter_breakdown.pressure_filter_score = calculatePressureScore(altitude_change_m);
+    filter_breakdown.pressure_filter_score = scoreTier(tiers.tables[SCORE_PRESSURE], altitude_change_m);
     updateFilterScore();
 }
 
 void ConfidenceScorer::addHeartRateFilterScore(float hr_change_bpm) {
-    filter_breakdown.heart_rate_filter_score = calculateHeartRateScore(hr_change_bpm);
+    filter_breakdown.heart_rate_filter_score = scoreTier(tiers.tables[SCORE_HEART_RATE], fabsf(hr_change_bpm));
     updateFilterScore();
 }
 
 void ConfidenceScorer::addFSRFilterScore(bool impact_detected, bool strap_secure) {
     uint8_t fsr_score = 0;
-    if (strap_secure) fsr_score += 2;  // Device attached throughout sequence
-    if (impact_detected) fsr_score += 3;  // Impact spike detected
+    if (strap_secure) fsr_score += FSR_STRAP_POINTS;  // Device attached throughout sequence
+    if (impact_detected) fsr_score += FSR_SPIKE_POINTS;  // Impact spike detected
 
     filter_breakdown.fsr_filter_score = fsr_score;
     updateFilterScore();
 }
 
+void ConfidenceScorer::addClassifierScore(uint8_t probability_pct) {
+    classifier_score = scoreTier(tiers.tables[SCORE_CLASSIFIER], probability_pct);
+    capScore(classifier_score, 15);
+
+    if (DEBUG_ALGORITHM_STEPS) {
+        Deferred_Log::log(DLOG_CLASSIFIER_SCORE, classifier_score, probability_pct);
+    }
+}
+
+bool ConfidenceScorer::setScoreTiers(const ScoreTiers_t& score_tiers) {
+    if (!isValidScoreTiers(score_tiers)) return false;
+    tiers = score_tiers;
+    return true;
+}
+
 void ConfidenceScorer::updateFilterScore() {
     filter_score = filter_breakdown.pressure_filter_score +
                   filter_breakdown.heart_rate_filter_score +
@@ -148,8 +142,26 @@ void ConfidenceScorer::updateFilterScore() {
     capScore(filter_score, 15);
 }
 
+void ConfidenceScorer::setSensorAvailability(uint8_t available) {
+    available_sensors = available & HARDWARE_ALL;
+}
+
+uint8_t ConfidenceScorer::getReachableScore() {
+    return MAX_CONFIDENCE_SCORE - (filterReach(HARDWARE_ALL) - filterReach(available_sensors)) -
+           (impactReach(HARDWARE_ALL) - impactReach(available_sensors));
+}
+
+uint8_t ConfidenceScorer::getRawScore() {
+    return stage1_score + stage2_score + stage3_score + stage4_score + filter_score + classifier_score;
+}
+
 uint8_t ConfidenceScorer::getTotalScore() {
-    return stage1_score + stage2_score + stage3_score + stage4_score + filter_score;
+    uint16_t raw = getRawScore();
+    uint8_t reachable = getReachableScore();
+    if (reachable >= MAX_CONFIDENCE_SCORE || reachable == 0) return raw;
+
+    uint16_t scaled = (raw * MAX_CONFIDENCE_SCORE + reachable / 2) / reachable;
+    return scaled > MAX_CONFIDENCE_SCORE ? MAX_CONFIDENCE_SCORE : scaled;
 }
 
 FallConfidence_t ConfidenceScorer::getConfidenceLevel() {
@@ -175,6 +187,7 @@ uint8_t ConfidenceScorer::getStageScore(uint8_t stage_number) {
         case 3: return stage3_score;
         case 4: return stage4_score;
         case 5: return filter_score;
+        case 6: return classifier_score;
         default: return 0;
     }
 }
@@ -202,63 +215,6 @@ uint32_t ConfidenceScorer::getScoringDuration() {
     return scoring_active ? (millis() - scoring_start_time) : 0;
 }
 
-// Private calculation functions
-uint8_t ConfidenceScorer::calculateDurationScore(float duration_ms) {
-    if (duration_ms >= 500.0f) return 15;      // Extended fall
-    if (duration_ms >= 200.0f) return 10;      // Typical fall
-    if (duration_ms >= 100.0f) return 5;       // Brief drop
-    return 0;
-}
-
-uint8_t ConfidenceScorer::calculateMagnitudeScore(float magnitude_g) {
-    if (magnitude_g <= 0.1f) return 10;        // True free fall
-    if (magnitude_g <= 0.3f) return 8;         // Significant weightlessness
-    if (magnitude_g <= 0.5f) return 5;         // Partial weightlessness
-    return 0;
-}
-
-uint8_t ConfidenceScorer::calculateImpactScore(float impact_g) {
-    if (impact_g >= 6.0f) return 15;           // Severe impact
-    if (impact_g >= 4.0f) return 12;           // Significant impact
-    if (impact_g >= 3.0f) return 8;            // Moderate impact
-    return 0;
-}
-
-uint8_t ConfidenceScorer::calculateTimingScore(float timing_ms) {
-    if (timing_ms <= 500.0f) return 5;         // Immediate impact
-    if (timing_ms <= 1000.0f) return 3;        // Delayed impact
-    return 0;
-}
-
-uint8_t ConfidenceScorer::calculateAngularScore(float angular_velocity_dps) {
-    if (angular_velocity_dps >= 600.0f) return 15;  // Severe rotation
-    if (angular_velocity_dps >= 400.0f) return 12;  // Significant rotation
-    if (angular_velocity_dps >= 250.0f) return 8;   // Moderate rotation
-    return 0;
-}
-
-uint8_t ConfidenceScorer::calculateInactivityScore(float duration_ms) {
-    if (duration_ms >= 10000.0f) return 15;    // Extended incapacitation
-    if (duration_ms >= 5000.0f) return 12;     // Moderate incapacitation
-    if (duration_ms >= 2000.0f) return 8;      // Brief incapacitation
-    return 0;
-}
-
-uint8_t ConfidenceScorer::calculatePressureScore(float altitude_change_m) {
-    if (altitude_change_m >= 2.0f) return 5;   // Significant fall height
-    if (altitude_change_m >= 1.0f) return 3;   // Moderate fall height
-    if (altitude_change_m >= 0.5f) return 2;   // Minor fall height
-    return 0;
-}
-
-uint8_t ConfidenceScorer::calculateHeartRateScore(float hr_change_bpm) {
-    float abs_change = abs(hr_change_bpm);
-    if (abs_change >= 30.0f) return 5;         // Major stress response
-    if (abs_change >= 10.0f) return 3;         // Moderate stress response
-    if (abs_change >= 2.0f) return 2;          // Minor stress response
-    return 0;
-}
-
 bool ConfidenceScorer::validateScoreRange(uint8_t score, uint8_t max_score) {
     return score <= max_score;
 }
@@ -280,33 +236,14 @@ const char* ConfidenceScorer::getConfidenceString(FallConfidence_t confidence) {
     }
 }
 
-void ConfidenceScorer::printScoreBreakdown() {
-    Serial.println("=== Confidence Score Breakdown ===");
-    Serial.print("Stage 1 (Free Fall): ");
-    Serial.print(stage1_score);
-    Serial.println("/25");
-
-    Serial.print("Stage 2 (Impact): ");
-    Serial.print(stage2_score);
-    Serial.println("/25");
-
-    Serial.print("Stage 3 (Rotation): ");
-    Serial.print(stage3_score);
-    Serial.println("/20");
+void ConfidenceScorer::logScoreBreakdown() {
+    Deferred_Log::log(DLOG_SCORE_STAGES, stage1_score, stage2_score, stage3_score, stage4_score);
+    Deferred_Log::log(DLOG_SCORE_FILTERS, filter_score, classifier_score);
+    Deferred_Log::log(DLOG_SCORE_TOTAL, getTotalScore(), MAX_CONFIDENCE_SCORE, getConfidenceLevel());
 
-    Serial.print("Stage 4 (Inactivity): ");
-    Serial.print(stage4_score);
-    Serial.println("/20");
-
-    Serial.print("Filters: ");
-    Serial.print(filter_score);
-    Serial.println("/15");
-
-    Serial.print("TOTAL SCORE: ");
-    Serial.print(getTotalScore());
-    Serial.print("/105 - ");
-    Serial.println(getConfidenceString(getConfidenceLevel()));
-    Serial.println("===================================");
+    if (getReachableScore() < MAX_CONFIDENCE_SCORE) {
+        Deferred_Log::log(DLOG_SCORE_RESCALED, getRawScore(), getReachableScore());
+    }
 }
 
 void ConfidenceScorer::printDetailedAnalysis() {
@@ -346,5 +283,35 @@ void ConfidenceScorer::printDetailedAnalysis() {
     Serial.print(", FSR: ");
     Serial.println(filter_breakdown.fsr_filter_score);
 
+    Serial.println("Classifier:");
+    Serial.print("  Probability Score: ");
+    Serial.println(classifier_score);
+
     Serial.println("===============================");
-}
\ No newline at end of file
+}
+
+// Strictest tier is listed first and pays the most
+uint8_t ConfidenceScorer::tableMaxPoints(ScoreMetric_t metric) {
+    const ScoreTable_t& table = tiers.tables[metric];
+    uint8_t points = 0;
+    for (uint8_t i = 0; i < table.count; i++) {
+        if (table.tiers[i].points > points) points = table.tiers[i].points;
+    }
+    return points;
+}
+
+// Most the filter stage can score with these sensors, after its cap
+uint8_t ConfidenceScorer::filterReach(uint8_t available) {
+    uint16_t reach = 0;
+    if (available & HARDWARE_BIT(HARDWARE_PRESSURE)) reach += tableMaxPoints(SCORE_PRESSURE);
+    if (available & HARDWARE_BIT(HARDWARE_HEART)) reach += tableMaxPoints(SCORE_HEART_RATE);
+    if (available & HARDWARE_BIT(HARDWARE_FORCE)) reach += FSR_STRAP_POINTS + FSR_SPIKE_POINTS;
+    return reach > 15 ? 15 : reach;
+}
+
+// Most stage 2 can score: the FSR confirms the impact
+uint8_t ConfidenceScorer::impactReach(uint8_t available) {
+    uint16_t reach = tableMaxPoints(SCORE_IMPACT) + tableMaxPoints(SCORE_IMPACT_TIMING);
+    if (available & HARDWARE_BIT(HARDWARE_FORCE)) reach += FSR_IMPACT_POINTS;
+    return reach > 25 ? 25 : reach;
+}
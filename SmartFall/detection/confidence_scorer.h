@@ -3,6 +3,7 @@
 
 #include "../utils/data_types.h"
 #include "../utils/config.h"
+#include "score_tiers.h"
 #include <Arduino.h>
 
 class ConfidenceScorer {
@@ -13,6 +14,7 @@ private:
     uint8_t stage3_score;    // Rotation scoring (max 20 points)
     uint8_t stage4_score;    // Inactivity scoring (max 20 points)
     uint8_t filter_score;    // False positive filters (max 15 points)
+    uint8_t classifier_score; // Fall classifier probability (max 15 points)
 
     // Detailed scoring breakdown
     struct {
@@ -42,6 +44,9 @@ private:
         uint8_t fsr_filter_score;
     } filter_breakdown;
 
+    ScoreTiers_t tiers;      // Breakpoints and points per metric
+    uint8_t available_sensors; // HARDWARE_BIT mask of optional sensors delivering
+
     bool scoring_active;
     uint32_t scoring_start_time;
 
@@ -64,8 +69,24 @@ public:
     void addHeartRateFilterScore(float hr_change_bpm);
     void addFSRFilterScore(bool impact_detected, bool strap_secure);
 
+    // Classifier scoring (see fall_classifier.h)
+    void addClassifierScore(uint8_t probability_pct);
+
+    // Tier tables (DEFAULT_SCORE_TIERS until overridden)
+    bool setScoreTiers(const ScoreTiers_t& score_tiers);
+    const ScoreTiers_t& getScoreTiers() { return tiers; }
+
+    // Optional sensors delivering (HARDWARE_BIT mask, HARDWARE_ALL until
+    // told otherwise). With one down, the total is rescaled to the points
+    // the others can still reach, so the confidence thresholds keep their
+    // meaning instead of a lost barometer costing every fall 5 points.
+    void setSensorAvailability(uint8_t available);
+    uint8_t getSensorAvailability() { return available_sensors; }
+    uint8_t getReachableScore();    // MAX_CONFIDENCE_SCORE with every sensor up
+
     // Results and classification
-    uint8_t getTotalScore();
+    uint8_t getRawScore();          // Plain sum of the stages
+    uint8_t getTotalScore();        // Rescaled to MAX_CONFIDENCE_SCORE
     FallConfidence_t getConfidenceLevel();
     uint8_t getStageScore(uint8_t stage_number);
 
@@ -78,25 +99,18 @@ public:
     uint32_t getScoringDuration();
 
     // Debug functions
-    void printScoreBreakdown();
+    void logScoreBreakdown();           // Deferred: safe on the alert path
     void printDetailedAnalysis();
     const char* getConfidenceString(FallConfidence_t confidence);
 
 private:
-    // Internal scoring calculation functions
-    uint8_t calculateDurationScore(float duration_ms);
-    uint8_t calculateMagnitudeScore(float magnitude_g);
-    uint8_t calculateImpactScore(float impact_g);
-    uint8_t calculateTimingScore(float timing_ms);
-    uint8_t calculateAngularScore(float angular_velocity_dps);
-    uint8_t calculateInactivityScore(float duration_ms);
-    uint8_t calculatePressureScore(float altitude_change_m);
-    uint8_t calculateHeartRateScore(float hr_change_bpm);
-
     // Validation functions
     bool validateScoreRange(uint8_t score, uint8_t max_score);
     void capScore(uint8_t& score, uint8_t max_value);
     void updateFilterScore();
+    uint8_t tableMaxPoints(ScoreMetric_t metric);
+    uint8_t filterReach(uint8_t available);
+    uint8_t impactReach(uint8_t available);
 };
 
 #endif // CONFIDENCE_SCORER_H
\ No newline at end of file
@@ -0,0 +1,229 @@
+#include "fall_classifier.h"
+#include "fall_classifier_model.h"
+#include "../diagnostics/Deferred_Log.h"
+
+#define FALL_FEATURE_LOW_MG         600   // Counts as weightless
+#define FALL_FEATURE_PRE_SAMPLES    50    // Look-back before the peak
+#define FALL_FEATURE_SETTLE_SAMPLES 10    // Skipped after the peak before "settled"
+#define FALL_FEATURE_EDGE_SAMPLES   10    // Averaged for the start/end gravity vectors
+#define FALL_LOGIT_MIN              (-((FALL_MODEL_SIGMOID_SIZE / 2) << FALL_MODEL_SIGMOID_SHIFT))
+#define FALL_LOGIT_MAX              (((FALL_MODEL_SIGMOID_SIZE / 2) << FALL_MODEL_SIGMOID_SHIFT) - 1)
+
+static const char* FEATURE_NAMES[FALL_FEATURE_COUNT] = {
+    "peak_accel", "pre_min_accel", "pre_mean_accel", "pre_low_samples", "pre_gyro",
+    "peak_gyro", "impact_width", "post_deviation", "post_jerk", "post_gyro", "tilt"
+};
+
+static int16_t toInt16(float scaled) {
+    if (!(scaled == scaled)) return 0;   // NaN
+    if (scaled >= 32767.0f) return 32767;
+    if (scaled <= -32767.0f) return -32767;
+    return (int16_t)lroundf(scaled);
+}
+
+// floor(sqrt(value))
+static uint32_t isqrt(uint32_t value) {
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+    while (bit > value) bit >>= 2;
+    while (bit != 0) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+static uint32_t magnitude(const int16_t* v) {
+    return isqrt((uint32_t)((int32_t)v[0] * v[0]) + (uint32_t)((int32_t)v[1] * v[1]) +
+                 (uint32_t)((int32_t)v[2] * v[2]));
+}
+
+static int16_t clampFeature(int32_t value) {
+    return (int16_t)constrain(value, -32767, 32767);
+}
+
+FallClassifier::FallClassifier() {
+    reset();
+}
+
+void FallClassifier::reset() {
+    memset(features, 0, sizeof(features));
+    previous_status = FALL_STATUS_MONITORING;
+    samples_to_go = 0;
+    logit = 0;
+    probability = 0;
+    has_result = false;
+}
+
+bool FallClassifier::observe(FallStatus_t status) {
+    bool impact = status == FALL_STATUS_STAGE2_IMPACT && previous_status != FALL_STATUS_STAGE2_IMPACT;
+    previous_status = status;
+
+    // The window runs to completion even if the detector gives up meanwhile
+    if (impact && samples_to_go == 0) {
+        samples_to_go = FALL_CLASSIFIER_POST_SAMPLES + 1;
+    }
+    if (samples_to_go == 0) return false;
+    return --samples_to_go == 0;
+}
+
+uint8_t FallClassifier::classify(const SensorData_t* samples, uint8_t count) {
+    if (count == 0) return 0;   // No history yet; nothing to score
+    if (count > FALL_CLASSIFIER_WINDOW) {
+        samples += count - FALL_CLASSIFIER_WINDOW;
+        count = FALL_CLASSIFIER_WINDOW;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        quantize(samples[i], window[i]);
+    }
+
+    extractFeatures(window, count, features);
+    logit = predictLogit(features);
+    probability = toProbability(logit);
+    has_result = true;
+
+    if (DEBUG_ALGORITHM_STEPS) {
+        Deferred_Log::log(DLOG_CLASSIFIER_RESULT, probability);
+    }
+    return probability;
+}
+
+void FallClassifier::quantize(const SensorData_t& data, FallImuSample_t& sample) {
+    sample.accel[0] = toInt16(data.accel_x * 1000.0f);
+    sample.accel[1] = toInt16(data.accel_y * 1000.0f);
+    sample.accel[2] = toInt16(data.accel_z * 1000.0f);
+    sample.gyro[0] = toInt16(data.gyro_x);
+    sample.gyro[1] = toInt16(data.gyro_y);
+    sample.gyro[2] = toInt16(data.gyro_z);
+}
+
+void FallClassifier::extractFeatures(const FallImuSample_t* samples, uint8_t count, int16_t* out) {
+    memset(out, 0, FALL_FEATURE_COUNT * sizeof(int16_t));
+    if (count == 0) return;
+
+    // Magnitudes once per sample; the square roots dominate the cost
+    uint16_t accel_mg[FALL_CLASSIFIER_WINDOW], gyro_dps[FALL_CLASSIFIER_WINDOW];
+    if (count > FALL_CLASSIFIER_WINDOW) count = FALL_CLASSIFIER_WINDOW;
+    for (uint8_t i = 0; i < count; i++) {
+        accel_mg[i] = (uint16_t)magnitude(samples[i].accel);
+        gyro_dps[i] = (uint16_t)magnitude(samples[i].gyro);
+    }
+
+    // Peak of the acceleration magnitude splits the window
+    uint8_t peak = 0;
+    uint32_t peak_mg = 0, peak_dps = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        uint32_t mg = accel_mg[i];
+        uint32_t dps = gyro_dps[i];
+        if (mg > peak_mg) {
+            peak_mg = mg;
+            peak = i;
+        }
+        if (dps > peak_dps) peak_dps = dps;
+    }
+    out[FALL_FEATURE_PEAK_ACCEL] = clampFeature(peak_mg);
+    out[FALL_FEATURE_PEAK_GYRO] = clampFeature(peak_dps);
+
+    // Before the peak
+    uint8_t start = peak > FALL_FEATURE_PRE_SAMPLES ? peak - FALL_FEATURE_PRE_SAMPLES : 0;
+    uint32_t pre_min = peak_mg, pre_sum = 0, pre_gyro = 0, low = 0;
+    for (uint8_t i = start; i < peak; i++) {
+        uint32_t mg = accel_mg[i];
+        if (mg < pre_min) pre_min = mg;
+        if (mg < FALL_FEATURE_LOW_MG) low++;
+        pre_sum += mg;
+        pre_gyro += gyro_dps[i];
+    }
+    uint8_t pre_count = peak - start;
+    out[FALL_FEATURE_PRE_MIN_ACCEL] = clampFeature(pre_min);
+    out[FALL_FEATURE_PRE_MEAN_ACCEL] = clampFeature(pre_count ? pre_sum / pre_count : peak_mg);
+    out[FALL_FEATURE_PRE_LOW_SAMPLES] = clampFeature(low);
+    out[FALL_FEATURE_PRE_GYRO] = clampFeature(pre_count ? pre_gyro / pre_count : 0);
+
+    // Width of the impact pulse at half height
+    uint32_t half = peak_mg / 2;
+    uint8_t first = peak, last = peak;
+    while (first > 0 && accel_mg[first - 1] > half) first--;
+    while (last + 1 < count && accel_mg[last + 1] > half) last++;
+    out[FALL_FEATURE_IMPACT_WIDTH] = clampFeature(last - first + 1);
+
+    // Once settled after the impact
+    uint16_t settled = peak + FALL_FEATURE_SETTLE_SAMPLES;
+    if (settled < count) {
+        uint32_t deviation = 0, jerk = 0, gyro = 0;
+        uint32_t previous = accel_mg[settled - 1];
+        for (uint16_t i = settled; i < count; i++) {
+            uint32_t mg = accel_mg[i];
+            deviation += mg > 1000 ? mg - 1000 : 1000 - mg;
+            jerk += mg > previous ? mg - previous : previous - mg;
+            gyro += gyro_dps[i];
+            previous = mg;
+        }
+        uint16_t post_count = count - settled;
+        out[FALL_FEATURE_POST_DEVIATION] = clampFeature(deviation / post_count);
+        out[FALL_FEATURE_POST_JERK] = clampFeature(jerk / post_count);
+        out[FALL_FEATURE_POST_GYRO] = clampFeature(gyro / post_count);
+    }
+
+    // Posture change: gravity at the start against gravity at the end
+    uint8_t edge = count < FALL_FEATURE_EDGE_SAMPLES ? count : FALL_FEATURE_EDGE_SAMPLES;
+    int32_t before[3] = {0, 0, 0}, after[3] = {0, 0, 0};
+    for (uint8_t i = 0; i < edge; i++) {
+        for (uint8_t axis = 0; axis < 3; axis++) {
+            before[axis] += samples[i].accel[axis];
+            after[axis] += samples[count - edge + i].accel[axis];
+        }
+    }
+    int16_t a[3], b[3];
+    int64_t dot = 0;
+    for (uint8_t axis = 0; axis < 3; axis++) {
+        a[axis] = (int16_t)(before[axis] / edge);
+        b[axis] = (int16_t)(after[axis] / edge);
+        dot += (int32_t)a[axis] * b[axis];
+    }
+    uint32_t norms = magnitude(a) * magnitude(b);
+    out[FALL_FEATURE_TILT] = norms ? clampFeature((int32_t)(dot * 1000 / (int64_t)norms)) : 1000;
+}
+
+int32_t FallClassifier::predictLogit(const int16_t* values) {
+    int32_t sum = FALL_MODEL_BIAS;
+    for (uint8_t t = 0; t < FALL_MODEL_TREES; t++) {
+        // Complete tree: node n has children 2n+1 (<=) and 2n+2 (>)
+        uint8_t node = 0;
+        for (uint8_t d = 0; d < FALL_MODEL_DEPTH; d++) {
+            bool right = values[FALL_MODEL_FEATURE[t][node]] > FALL_MODEL_THRESHOLD[t][node];
+            node = 2 * node + 1 + right;
+        }
+        sum += FALL_MODEL_LEAF[t][node - FALL_MODEL_NODES];
+    }
+    return sum;
+}
+
+uint8_t FallClassifier::toProbability(int32_t logit_q8) {
+    int32_t clamped = constrain(logit_q8, FALL_LOGIT_MIN, FALL_LOGIT_MAX);
+    return FALL_MODEL_SIGMOID[(clamped - FALL_LOGIT_MIN) >> FALL_MODEL_SIGMOID_SHIFT];
+}
+
+const char* FallClassifier::getFeatureName(uint8_t feature) {
+    return feature < FALL_FEATURE_COUNT ? FEATURE_NAMES[feature] : "unknown";
+}
+
+void FallClassifier::printFeatures() {
+    Serial.println("=== Fall Classifier ===");
+    for (uint8_t i = 0; i < FALL_FEATURE_COUNT; i++) {
+        Serial.print(getFeatureName(i));
+        Serial.print(": ");
+        Serial.println(features[i]);
+    }
+    Serial.print("Logit (Q8): ");
+    Serial.print(logit);
+    Serial.print(" | Probability: ");
+    Serial.print(probability);
+    Serial.println("%");
+    Serial.println("=======================");
+}
@@ -0,0 +1,118 @@
+#ifndef FALL_CLASSIFIER_MODEL_H
+#define FALL_CLASSIFIER_MODEL_H
+
+// Generated by tools/fall_sim/train_classifier.cpp --write; do not edit.
+// Trained on seed 1, 1000 events per scenario: 4054 impact windows, 2350 falls.
+// Held out (seed 1001): AUC 1.000, accuracy 100.0% at 50%.
+
+#define FALL_MODEL_TREES          24
+#define FALL_MODEL_DEPTH          3
+#define FALL_MODEL_NODES          7     // Split nodes per tree; leaves follow
+#define FALL_MODEL_SIGMOID_SIZE   256
+#define FALL_MODEL_SIGMOID_SHIFT  4     // Q8 logit >> shift indexes the table
+
+static const int32_t FALL_MODEL_BIAS = 82;   // Q8 log-odds
+
+static const uint8_t FALL_MODEL_FEATURE[FALL_MODEL_TREES][FALL_MODEL_NODES] = {
+    {1, 1, 10, 0, 10, 0, 0},
+    {1, 1, 10, 0, 10, 0, 0},
+    {1, 1, 10, 0, 10, 0, 0},
+    {1, 1, 10, 0, 3, 0, 0},
+    {1, 1, 10, 0, 10, 10, 0},
+    {1, 1, 10, 0, 3, 0, 0},
+    {1, 1, 10, 0, 10, 0, 0},
+    {1, 6, 10, 0, 4, 0, 0},
+    {1, 6, 10, 0, 9, 0, 0},
+    {1, 6, 10, 0, 10, 0, 0},
+    {1, 6, 10, 0, 9, 0, 0},
+    {1, 6, 10, 0, 4, 0, 0},
+    {1, 6, 10, 0, 9, 0, 0},
+    {1, 6, 10, 0, 10, 0, 0},
+    {1, 6, 10, 0, 10, 0, 0},
+    {10, 6, 0, 0, 0, 0, 0},
+    {10, 6, 0, 0, 0, 0, 0},
+    {10, 6, 0, 0, 0, 0, 0},
+    {10, 6, 0, 0, 0, 0, 0},
+    {1, 6, 0, 0, 0, 0, 0},
+    {10, 6, 0, 0, 0, 0, 0},
+    {10, 1, 0, 0, 0, 0, 0},
+    {10, 0, 0, 0, 0, 0, 0},
+    {1, 0, 0, 0, 0, 0, 0}
+};
+
+static const int16_t FALL_MODEL_THRESHOLD[FALL_MODEL_TREES][FALL_MODEL_NODES] = {
+    {102, 75, 898, 32767, 767, 32767, 32767},
+    {113, 75, 898, 32767, 767, 32767, 32767},
+    {113, 75, 898, 32767, 845, 32767, 32767},
+    {113, 75, 898, 32767, 45, 32767, 32767},
+    {102, 62, 898, 32767, 799, -13, 32767},
+    {113, 62, 898, 32767, 44, 32767, 32767},
+    {102, 62, 898, 32767, 799, 32767, 32767},
+    {102, 2, 898, 32767, 90, 32767, 32767},
+    {113, 2, 898, 32767, 23, 32767, 32767},
+    {113, 2, 898, 32767, 845, 32767, 32767},
+    {131, 2, 898, 32767, 23, 32767, 32767},
+    {131, 2, 898, 32767, 90, 32767, 32767},
+    {131, 2, 898, 32767, 23, 32767, 32767},
+    {131, 2, 898, 32767, 845, 32767, 32767},
+    {131, 2, 898, 32767, 965, 32767, 32767},
+    {898, 2, 32767, 32767, 32767, 32767, 32767},
+    {898, 2, 32767, 32767, 32767, 32767, 32767},
+    {898, 2, 32767, 32767, 32767, 32767, 32767},
+    {898, 2, 32767, 32767, 32767, 32767, 32767},
+    {160, 2, 32767, 32767, 32767, 32767, 32767},
+    {898, 3, 32767, 32767, 32767, 32767, 32767},
+    {845, 113, 32767, 32767, 32767, 32767, 32767},
+    {784, 32767, 32767, 32767, 32767, 32767, 32767},
+    {131, 32767, 32767, 32767, 32767, 32767, 32767}
+};
+
+// Q8 log-odds
+static const int16_t FALL_MODEL_LEAF[FALL_MODEL_TREES][FALL_MODEL_NODES + 1] = {
+    {-181, 0, 111, -171, 132, 0, -181, 0},
+    {-127, 0, 93, -122, 110, 0, -128, 0},
+    {-106, 0, 75, -106, 98, 0, -107, 0},
+    {-95, 0, -90, 73, 91, 0, -96, 0},
+    {-90, 0, 56, -88, 35, 87, -90, 0},
+    {-85, 0, -82, 52, 84, 0, -85, 0},
+    {-81, 0, 41, -80, 81, 0, -82, 0},
+    {-83, 0, -79, 123, 79, 0, -79, 0},
+    {-82, 0, -77, 107, 79, 0, -77, 0},
+    {-80, 0, 102, -75, 78, 0, -75, 0},
+    {-79, 0, -73, 91, 77, 0, -72, 0},
+    {-77, 0, -71, 86, 76, 0, -69, 0},
+    {-76, 0, -69, 80, 75, 0, -67, 0},
+    {-73, 0, 74, -66, 73, 0, -64, 0},
+    {-71, 0, 60, -63, 72, 0, -61, 0},
+    {-67, 0, 74, 0, -68, 0, 0, 0},
+    {-64, 0, 72, 0, -65, 0, 0, 0},
+    {-60, 0, 70, 0, -62, 0, 0, 0},
+    {-57, 0, 67, 0, -59, 0, 0, 0},
+    {-55, 0, -11, 0, 37, 0, 0, 0},
+    {-36, 0, 62, 0, -56, 0, 0, 0},
+    {-21, 0, 55, 0, -51, 0, 0, 0},
+    {21, 0, 0, 0, -40, 0, 0, 0},
+    {-31, 0, 0, 0, 27, 0, 0, 0}
+};
+
+// Fall probability (%) per logit step
+static const uint8_t FALL_MODEL_SIGMOID[FALL_MODEL_SIGMOID_SIZE] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2,
+    2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4,
+    5, 5, 5, 6, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11,
+    12, 13, 13, 14, 15, 16, 16, 17, 18, 19, 20, 21, 22, 23, 25, 26,
+    27, 28, 29, 31, 32, 33, 35, 36, 38, 39, 41, 42, 44, 45, 47, 48,
+    50, 52, 53, 55, 56, 58, 59, 61, 62, 64, 65, 67, 68, 69, 71, 72,
+    73, 74, 75, 77, 78, 79, 80, 81, 82, 83, 84, 84, 85, 86, 87, 87,
+    88, 89, 89, 90, 90, 91, 91, 92, 92, 93, 93, 94, 94, 94, 95, 95,
+    95, 96, 96, 96, 96, 96, 97, 97, 97, 97, 97, 98, 98, 98, 98, 98,
+    98, 98, 98, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99, 99,
+    99, 99, 99, 99, 99, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,
+    100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100,
+    100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100, 100
+};
+
+#endif // FALL_CLASSIFIER_MODEL_H
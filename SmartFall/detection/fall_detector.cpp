@@ -1,7 +1,10 @@
 #include "fall_detector.h"
+#include "../diagnostics/Deferred_Log.h"
+
+#define ACCEL_CLIP_FRACTION 0.999f   // Of full scale; the ADC tops out one count short
 
 FallDetector::FallDetector() : current_status(FALL_STATUS_MONITORING),
-                               monitoring_active(false),
+                               monitoring_active(false), current_time(0),
                                stage1_start_time(0), stage2_start_time(0),
                                stage3_start_time(0), stage4_start_time(0),
                                detection_window_start(0),
@@ -9,7 +12,7 @@ FallDetector::FallDetector() : current_status(FALL_STATUS_MONITORING),
                                stage3_triggered(false), stage4_triggered(false),
                                history_index(0), history_count(0),
                                freefall_duration(0), min_acceleration_during_fall(10.0f),
-                               max_impact_acceleration(0), impact_timing(0),
+                               max_impact_acceleration(0), impact_clipped(false), impact_timing(0),
                                max_angular_velocity(0), total_orientation_change(0),
                                inactivity_start_time(0), position_stable(false) {
 
@@ -18,7 +21,7 @@ FallDetector::FallDetector() : current_status(FALL_STATUS_MONITORING),
     thresholds.impact_threshold_g = IMPACT_THRESHOLD_G;
     thresholds.rotation_threshold_dps = ROTATION_THRESHOLD_DPS;
     thresholds.inactivity_threshold_ms = INACTIVITY_THRESHOLD_MS;
-    thresholds.pressure_change_threshold_m = 1.0f;
+    thresholds.pressure_change_threshold_m = PRESSURE_CHANGE_THRESHOLD_M;
 
     // Initialize sensor history
     for(int i = 0; i < SENSOR_HISTORY_SIZE; i++) {
@@ -56,6 +59,10 @@ bool FallDetector::init() {
 void FallDetector::processSensorData(SensorData_t& data) {
     if (!monitoring_active || !data.valid) return;
 
+    // Stages are timed on the sample clock, so replayed traces behave
+    // exactly as they did live
+    current_time = data.timestamp;
+
     // Add data to history
     addToHistory(data);
 
@@ -69,10 +76,10 @@ void FallDetector::processSensorData(SensorData_t& data) {
         case FALL_STATUS_MONITORING:
             if (checkStage1_FreeFall(data)) {
                 current_status = FALL_STATUS_STAGE1_FREEFALL;
-                stage1_start_time = millis();
+                stage1_start_time = current_time;
                 detection_window_start = stage1_start_time;
                 if (DEBUG_ALGORITHM_STEPS) {
-                    Serial.println("STAGE 1: Free fall detected!");
+                    Deferred_Log::log(DLOG_STAGE1_FREEFALL);
                 }
             }
             break;
@@ -84,9 +91,9 @@ void FallDetector::processSensorData(SensorData_t& data) {
             // Check for impact
             if (checkStage2_Impact(data)) {
                 current_status = FALL_STATUS_STAGE2_IMPACT;
-                stage2_start_time = millis();
+                stage2_start_time = current_time;
                 if (DEBUG_ALGORITHM_STEPS) {
-                    Serial.println("STAGE 2: Impact detected!");
+                    Deferred_Log::log(DLOG_STAGE2_IMPACT);
                 }
             }
             break;
@@ -95,9 +102,9 @@ void FallDetector::processSensorData(SensorData_t& data) {
             // Check for rotation during impact
             if (checkStage3_Rotation(data)) {
                 current_status = FALL_STATUS_STAGE3_ROTATION;
-                stage3_start_time = millis();
+                stage3_start_time = current_time;
                 if (DEBUG_ALGORITHM_STEPS) {
-                    Serial.println("STAGE 3: Rotation detected!");
+                    Deferred_Log::log(DLOG_STAGE3_ROTATION);
                 }
             }
             break;
@@ -109,10 +116,10 @@ void FallDetector::processSensorData(SensorData_t& data) {
             // Check for inactivity
             if (checkStage4_Inactivity(data)) {
                 current_status = FALL_STATUS_STAGE4_INACTIVITY;
-                stage4_start_time = millis();
+                stage4_start_time = current_time;
                 inactivity_start_time = stage4_start_time;
                 if (DEBUG_ALGORITHM_STEPS) {
-                    Serial.println("STAGE 4: Inactivity detected!");
+                    Deferred_Log::log(DLOG_STAGE4_INACTIVITY);
                 }
             }
             break;
@@ -120,16 +127,16 @@ void FallDetector::processSensorData(SensorData_t& data) {
         case FALL_STATUS_STAGE4_INACTIVITY:
             if (checkStage4_Inactivity(data)) {
                 // Check if inactivity duration is sufficient
-                if ((millis() - inactivity_start_time) >= thresholds.inactivity_threshold_ms) {
+                if ((current_time - inactivity_start_time) >= thresholds.inactivity_threshold_ms) {
                     current_status = FALL_STATUS_POTENTIAL_FALL;
                     if (DEBUG_ALGORITHM_STEPS) {
-                        Serial.println("POTENTIAL FALL: All stages completed!");
+                        Deferred_Log::log(DLOG_POTENTIAL_FALL);
                     }
                 }
             } else {
                 // User recovered, reset detection
                 if (DEBUG_ALGORITHM_STEPS) {
-                    Serial.println("User recovered - resetting detection");
+                    Deferred_Log::log(DLOG_USER_RECOVERED);
                 }
                 resetDetection();
             }
@@ -149,7 +156,7 @@ bool FallDetector::checkStage1_FreeFall(SensorData_t& data) {
     if (total_accel < thresholds.freefall_threshold_g) {
         if (!stage1_triggered) {
             stage1_triggered = true;
-            stage1_start_time = millis();
+            stage1_start_time = current_time;
             min_acceleration_during_fall = total_accel;
         }
 
@@ -159,7 +166,7 @@ bool FallDetector::checkStage1_FreeFall(SensorData_t& data) {
         }
 
         // Update fall duration
-        freefall_duration = millis() - stage1_start_time;
+        freefall_duration = current_time - stage1_start_time;
 
         return freefall_duration >= 200;  // Minimum 200ms free fall
     } else {
@@ -175,18 +182,19 @@ bool FallDetector::checkStage1_FreeFall(SensorData_t& data) {
 }
 
 bool FallDetector::checkStage2_Impact(SensorData_t& data) {
-    float total_accel = calculateTotalAcceleration(data);
+    float total_accel = calculatePeakAcceleration(data);
 
     if (total_accel > thresholds.impact_threshold_g) {
         if (!stage2_triggered) {
             stage2_triggered = true;
-            stage2_start_time = millis();
+            stage2_start_time = current_time;
             impact_timing = stage2_start_time - stage1_start_time;
         }
 
         // Update maximum impact acceleration
         if (total_accel > max_impact_acceleration) {
             max_impact_acceleration = total_accel;
+            impact_clipped = isAccelClipped(data);
         }
 
         // Check if impact occurred within reasonable time after free fall
@@ -197,12 +205,12 @@ bool FallDetector::checkStage2_Impact(SensorData_t& data) {
 }
 
 bool FallDetector::checkStage3_Rotation(SensorData_t& data) {
-    float angular_mag = calculateAngularMagnitude(data);
+    float angular_mag = calculatePeakAngularRate(data);
 
     if (angular_mag > thresholds.rotation_threshold_dps) {
         if (!stage3_triggered) {
             stage3_triggered = true;
-            stage3_start_time = millis();
+            stage3_start_time = current_time;
         }
 
         // Update maximum angular velocity
@@ -227,14 +235,14 @@ bool FallDetector::checkStage4_Inactivity(SensorData_t& data) {
     if (is_inactive) {
         if (!stage4_triggered) {
             stage4_triggered = true;
-            inactivity_start_time = millis();
+            inactivity_start_time = current_time;
         }
         position_stable = true;
         return true;
     } else {
         // Movement detected - user might be recovering
         if (stage4_triggered) {
-            uint32_t inactive_duration = millis() - inactivity_start_time;
+            uint32_t inactive_duration = current_time - inactivity_start_time;
             if (inactive_duration < thresholds.inactivity_threshold_ms) {
                 // Not enough inactivity time - likely recovering
                 stage4_triggered = false;
@@ -253,6 +261,27 @@ float FallDetector::calculateTotalAcceleration(SensorData_t& data) {
                data.accel_z * data.accel_z);
 }
 
+// The high-rate profile holds the largest frame between samples; the
+// sample itself is the mean of the frames and would hide the peak
+float FallDetector::calculatePeakAcceleration(SensorData_t& data) {
+    float total_accel = calculateTotalAcceleration(data);
+    return data.accel_peak_g > total_accel ? data.accel_peak_g : total_accel;
+}
+
+float FallDetector::calculatePeakAngularRate(SensorData_t& data) {
+    float angular_mag = calculateAngularMagnitude(data);
+    return data.gyro_peak_dps > angular_mag ? data.gyro_peak_dps : angular_mag;
+}
+
+// Any axis at the full scale the sample (or its peak frame) was read at;
+// unknown scale never clips
+bool FallDetector::isAccelClipped(SensorData_t& data) {
+    if (data.accel_peak_g > 0) return data.accel_peak_clipped;
+    if (data.accel_range_g == 0) return false;
+    float limit = data.accel_range_g * ACCEL_CLIP_FRACTION;
+    return fabsf(data.accel_x) >= limit || fabsf(data.accel_y) >= limit || fabsf(data.accel_z) >= limit;
+}
+
 float FallDetector::calculateAngularMagnitude(SensorData_t& data) {
     return sqrt(data.gyro_x * data.gyro_x +
                data.gyro_y * data.gyro_y +
@@ -260,7 +289,7 @@ float FallDetector::calculateAngularMagnitude(SensorData_t& data) {
 }
 
 bool FallDetector::isWithinDetectionWindow() {
-    return (millis() - detection_window_start) <= DETECTION_WINDOW_MS;
+    return (current_time - detection_window_start) <= DETECTION_WINDOW_MS;
 }
 
 void FallDetector::addToHistory(SensorData_t& data) {
@@ -281,6 +310,7 @@ void FallDetector::resetStageVariables() {
     freefall_duration = 0;
     min_acceleration_during_fall = 10.0f;
     max_impact_acceleration = 0;
+    impact_clipped = false;
     impact_timing = 0;
     max_angular_velocity = 0;
     total_orientation_change = 0;
@@ -299,7 +329,7 @@ bool FallDetector::checkStageTimeouts() {
 }
 
 void FallDetector::handleDetectionTimeout() {
-    Serial.println("Detection timeout - resetting to monitoring");
+    Deferred_Log::log(DLOG_DETECTION_TIMEOUT);
     resetDetection();
 }
 
@@ -345,18 +375,45 @@ uint8_t FallDetector::getHistoryCount() {
     return history_count;
 }
 
+uint8_t FallDetector::copyHistory(SensorData_t* out, uint8_t max_samples) {
+    uint8_t count = history_count < max_samples ? history_count : max_samples;
+
+    // Newest `count` samples; history_index is the next write slot
+    uint8_t start = (history_index + SENSOR_HISTORY_SIZE - count) % SENSOR_HISTORY_SIZE;
+    for (uint8_t i = 0; i < count; i++) {
+        out[i] = sensor_history[(start + i) % SENSOR_HISTORY_SIZE];
+    }
+    return count;
+}
+
 float FallDetector::getFreefalDuration() {
     return freefall_duration;
 }
 
+float FallDetector::getMinFreefallAccel() {
+    return min_acceleration_during_fall;
+}
+
 float FallDetector::getMaxImpact() {
     return max_impact_acceleration;
 }
 
+bool FallDetector::isImpactClipped() {
+    return impact_clipped;
+}
+
+uint32_t FallDetector::getImpactTiming() {
+    return impact_timing;
+}
+
 float FallDetector::getMaxRotation() {
     return max_angular_velocity;
 }
 
+uint32_t FallDetector::getInactivityDuration() {
+    return stage4_triggered ? current_time - inactivity_start_time : 0;
+}
+
 const char* FallDetector::getStatusString(FallStatus_t status) {
     switch(status) {
         case FALL_STATUS_MONITORING: return "MONITORING";
@@ -376,28 +433,7 @@ void FallDetector::printStatus() {
     Serial.println(getStatusString(current_status));
 }
 
-void FallDetector::printStageDetails() {
-    Serial.println("=== Fall Detection Stage Details ===");
-    Serial.print("Current Status: ");
-    Serial.println(getStatusString(current_status));
-
-    if (freefall_duration > 0) {
-        Serial.print("Free Fall Duration: ");
-        Serial.print(freefall_duration);
-        Serial.println(" ms");
-    }
-
-    if (max_impact_acceleration > 0) {
-        Serial.print("Max Impact: ");
-        Serial.print(max_impact_acceleration);
-        Serial.println(" g");
-    }
-
-    if (max_angular_velocity > 0) {
-        Serial.print("Max Rotation: ");
-        Serial.print(max_angular_velocity);
-        Serial.println(" °/s");
-    }
-
-    Serial.println("=====================================");
+void FallDetector::logStageDetails() {
+    Deferred_Log::log(DLOG_FALL_STAGES, freefall_duration, max_impact_acceleration,
+                      impact_clipped, max_angular_velocity);
 }
\ No newline at end of file
@@ -11,6 +11,7 @@ private:
     FallStatus_t current_status;
     DetectionThresholds_t thresholds;
     bool monitoring_active;
+    uint32_t current_time;          // Timestamp of the sample being processed
 
     // Stage timing variables
     uint32_t stage1_start_time;
@@ -36,6 +37,7 @@ private:
 
     // Impact detection variables
     float max_impact_acceleration;
+    bool impact_clipped;            // Peak sample hit the accelerometer full scale
     uint32_t impact_timing;
 
     // Rotation analysis variables
@@ -66,13 +68,18 @@ public:
     // Data access functions
     SensorData_t* getSensorHistory();
     uint8_t getHistoryCount();
+    uint8_t copyHistory(SensorData_t* out, uint8_t max_samples);   // Oldest first
     float getFreefalDuration();
+    float getMinFreefallAccel();
     float getMaxImpact();
+    bool isImpactClipped();         // Max impact is then only a lower bound
+    uint32_t getImpactTiming();
     float getMaxRotation();
+    uint32_t getInactivityDuration();
 
     // Debug functions
     void printStatus();
-    void printStageDetails();
+    void logStageDetails();             // Deferred: safe on the alert path
     const char* getStatusString(FallStatus_t status);
 
 private:
@@ -84,7 +91,10 @@ private:
 
     // Analysis helper functions
     float calculateTotalAcceleration(SensorData_t& data);
+    float calculatePeakAcceleration(SensorData_t& data);    // Includes the held peak
+    bool isAccelClipped(SensorData_t& data);
     float calculateAngularMagnitude(SensorData_t& data);
+    float calculatePeakAngularRate(SensorData_t& data);
     bool isWithinDetectionWindow();
     void addToHistory(SensorData_t& data);
     void resetStageVariables();
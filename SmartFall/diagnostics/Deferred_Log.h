@@ -0,0 +1,145 @@
+#ifndef DEFERRED_LOG_H
+#define DEFERRED_LOG_H
+
+#include <Arduino.h>
+#include "../utils/config.h"
+
+/*
+ * Deferred binary logger for the hot paths.
+ *
+ * A log call stores a message id, a timestamp and up to DLOG_MAX_ARGS raw
+ * 32-bit arguments in a fixed ring and returns: no formatting, no UART.
+ * A slot is claimed with one compare-and-swap on the write index, so
+ * callers on any task never wait for each other or for the reader, and
+ * a full ring drops the new record (counted) instead of blocking.
+ *
+ * The text lives only in the format table (getFormat()). On the device
+ * an idle-priority task drains the ring every DEFERRED_LOG_INTERVAL_MS
+ * and either formats each record to Serial, or, with DEFERRED_LOG_BINARY,
+ * writes the raw frames so tools/deferred_log/dlog_decode formats them on
+ * the host. Frames start with bytes that never occur in UTF-8, so they
+ * can share the console with ordinary Serial text.
+ *
+ * Conversions: %d %u %x %f (with .N precision), %% and %{a|b|c}, which
+ * prints the word the argument indexes. Strings cannot be passed; the
+ * formatter may run long after the caller's buffers are gone.
+ */
+
+#define DLOG_MAX_ARGS             4
+#define DLOG_FRAME_SYNC_0         0xF5   // Never a UTF-8 byte
+#define DLOG_FRAME_SYNC_1         0xD1
+#define DLOG_FRAME_HEADER_SIZE    9      // Sync, id, arg count, timestamp
+#define DLOG_FRAME_MAX_SIZE       (DLOG_FRAME_HEADER_SIZE + 4 * DLOG_MAX_ARGS + 1)
+#define DLOG_TEXT_MAX_LENGTH      160
+
+// Message ids; the wire format, so append only
+typedef enum {
+    DLOG_STAGE1_FREEFALL,
+    DLOG_STAGE2_IMPACT,
+    DLOG_STAGE3_ROTATION,
+    DLOG_STAGE4_INACTIVITY,
+    DLOG_POTENTIAL_FALL,
+    DLOG_USER_RECOVERED,
+    DLOG_STAGE1_SCORE,         // score, duration, magnitude
+    DLOG_STAGE2_SCORE,         // score, impact, timing, FSR
+    DLOG_STAGE3_SCORE,         // score, angular, orientation
+    DLOG_STAGE4_SCORE,         // score, duration, stability
+    DLOG_CLASSIFIER_SCORE,     // score, probability
+    DLOG_CLASSIFIER_RESULT,    // probability
+    DLOG_EMERGENCY_SENDING,    // confidence, max score, SOS
+    DLOG_EMERGENCY_DELIVERED,  // transport (0 wifi, 1 ble), latency
+    DLOG_EMERGENCY_UNCONFIRMED,
+    DLOG_EMERGENCY_QUEUED,     // attempt, max retries
+    DLOG_EMERGENCY_RETRY,      // attempt, max retries
+    DLOG_EMERGENCY_RETRY_OK,
+    DLOG_EMERGENCY_RETRY_FAILED,
+    DLOG_EMERGENCY_LATE_ACK,
+    DLOG_EMERGENCY_STATUS,     // AlertStatus_t
+    DLOG_DETECTION_TIMEOUT,
+    DLOG_FALL_DETECTED,        // confidence, max score, high confidence
+    DLOG_FALL_STAGES,          // free fall duration, max impact, clipped, max rotation
+    DLOG_SCORE_STAGES,         // stage 1-4 scores
+    DLOG_SCORE_FILTERS,        // filter, classifier
+    DLOG_SCORE_TOTAL,          // total, max score, FallConfidence_t
+    DLOG_SCORE_RESCALED,       // raw, reachable
+    DLOG_FALL_COUNTDOWN,
+    DLOG_MESSAGE_COUNT
+} DlogMessage_t;
+
+typedef struct {
+    uint32_t sequence;        // Slot state, relative to the slot index (see write())
+    uint32_t timestamp_us;
+    uint16_t message;         // DlogMessage_t
+    uint8_t arg_count;
+    uint8_t reserved;
+    uint32_t args[DLOG_MAX_ARGS];
+} DlogRecord_t;
+
+typedef struct {
+    uint32_t logged;
+    uint32_t dropped;         // Ring full
+    uint32_t written;         // Formatted or framed by the reader
+    uint32_t max_backlog;     // Most records waiting at one drain
+} DlogStats_t;
+
+// One argument as raw bits; the format string says how to read it
+struct Dlog_Arg {
+    uint32_t bits;
+
+    // Fundamental types only: uint32_t is unsigned int or unsigned long by toolchain
+    Dlog_Arg(int v) : bits((uint32_t)v) {}
+    Dlog_Arg(unsigned int v) : bits(v) {}
+    Dlog_Arg(long v) : bits((uint32_t)v) {}
+    Dlog_Arg(unsigned long v) : bits((uint32_t)v) {}
+    Dlog_Arg(bool v) : bits(v ? 1 : 0) {}
+    Dlog_Arg(float v) { memcpy(&bits, &v, sizeof(bits)); }
+    Dlog_Arg(double v) { float f = (float)v; memcpy(&bits, &f, sizeof(bits)); }
+};
+
+class Deferred_Log {
+private:
+    static DlogRecord_t ring[DEFERRED_LOG_RING_SIZE];
+    static uint32_t head;         // Next slot to claim (producers)
+    static uint32_t tail;         // Next slot to read (the one reader)
+    static DlogStats_t stats;
+#ifdef ARDUINO
+    static TaskHandle_t task;
+#endif
+
+public:
+    static void begin();          // Clears the ring; starts the drain task (device only)
+
+    // Hot path
+    template <typename... Args>
+    static void log(DlogMessage_t message, Args... args) {
+        static_assert(sizeof...(args) <= DLOG_MAX_ARGS, "too many log arguments");
+        const uint32_t words[] = {0, Dlog_Arg(args).bits...};
+        write(message, words + 1, sizeof...(args));
+    }
+    static bool write(DlogMessage_t message, const uint32_t* args, uint8_t count);
+
+    // Reader side
+    static bool read(DlogRecord_t& record);
+    static uint16_t drain(uint16_t max_records = DEFERRED_LOG_RING_SIZE);  // To Serial
+
+    // Formatting (device drain task and host decoder)
+    static const char* getFormat(uint16_t message);
+    static size_t format(const DlogRecord_t& record, char* buffer, size_t capacity);
+    static size_t encodeFrame(const DlogRecord_t& record, uint8_t* frame);
+    static size_t decodeFrame(const uint8_t* data, size_t length, DlogRecord_t& record);
+
+    // Results
+    static DlogStats_t getStats();
+#ifdef ARDUINO
+    static TaskHandle_t getTaskHandle() { return task; }
+#endif
+    static void printStats();
+
+private:
+    static uint8_t checksum(const uint8_t* data, size_t length);
+#ifdef ARDUINO
+    static void taskEntry(void* arg);
+#endif
+};
+
+#endif // DEFERRED_LOG_H
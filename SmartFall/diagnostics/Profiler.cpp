@@ -0,0 +1,241 @@
+#include "Profiler.h"
+#include "../communication/JSON_Writer.h"
+
+#ifndef ARDUINO
+#include <chrono>
+#endif
+
+ProfileHistogram_t Profiler::scopes[PROFILE_SCOPE_COUNT];
+ProfileHistogram_t Profiler::periods[PROFILE_PERIOD_COUNT];
+ProfileHistogram_t Profiler::jitter[PROFILE_PERIOD_COUNT];
+uint32_t Profiler::nominal_period_us[PROFILE_PERIOD_COUNT];
+uint32_t Profiler::last_period_ticks[PROFILE_PERIOD_COUNT];
+bool Profiler::period_started[PROFILE_PERIOD_COUNT];
+uint32_t Profiler::ticks_per_us = 1;
+
+#ifdef ARDUINO
+// Scopes are recorded from the loop and the alert dispatch tasks
+static portMUX_TYPE profiler_mux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+
+void Profiler::begin() {
+#ifdef ARDUINO
+    ticks_per_us = getCpuFrequencyMhz();  // CCOUNT runs at the CPU clock
+#else
+    ticks_per_us = 1000;                  // Host ticks are nanoseconds
+#endif
+    if (ticks_per_us == 0) ticks_per_us = 1;
+
+    for (uint8_t i = 0; i < PROFILE_PERIOD_COUNT; i++) {
+        nominal_period_us[i] = 0;
+    }
+    nominal_period_us[PROFILE_PERIOD_SENSOR] = SENSOR_READ_INTERVAL_MS * 1000UL;
+
+    reset();
+}
+
+void Profiler::reset() {
+    memset(scopes, 0, sizeof(scopes));
+    memset(periods, 0, sizeof(periods));
+    memset(jitter, 0, sizeof(jitter));
+    memset(period_started, 0, sizeof(period_started));
+}
+
+uint32_t Profiler::ticks() {
+#ifdef ARDUINO
+    return ESP.getCycleCount();
+#else
+    return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+uint32_t Profiler::ticksToMicros(uint32_t elapsed_ticks) {
+    return elapsed_ticks / ticks_per_us;
+}
+
+void Profiler::record(ProfileScope_t scope, uint32_t elapsed_ticks) {
+    if (scope >= PROFILE_SCOPE_COUNT) return;
+    addSample(scopes[scope], ticksToMicros(elapsed_ticks));
+}
+
+void Profiler::recordMicros(ProfileScope_t scope, uint32_t elapsed_us) {
+    if (scope >= PROFILE_SCOPE_COUNT) return;
+    addSample(scopes[scope], elapsed_us);
+}
+
+void Profiler::setNominalPeriod(ProfilePeriod_t period, uint32_t period_us) {
+    if (period >= PROFILE_PERIOD_COUNT) return;
+    nominal_period_us[period] = period_us;
+}
+
+void Profiler::markPeriod(ProfilePeriod_t period) {
+    if (period >= PROFILE_PERIOD_COUNT) return;
+
+    uint32_t now = ticks();
+
+    if (period_started[period]) {
+        uint32_t period_us = ticksToMicros(now - last_period_ticks[period]);
+        addSample(periods[period], period_us);
+
+        uint32_t nominal = nominal_period_us[period];
+        uint32_t deviation = (period_us > nominal) ? (period_us - nominal) : (nominal - period_us);
+        addSample(jitter[period], deviation);
+    }
+
+    last_period_ticks[period] = now;
+    period_started[period] = true;
+}
+
+const ProfileHistogram_t& Profiler::getScope(ProfileScope_t scope) {
+    return scopes[scope];
+}
+
+const ProfileHistogram_t& Profiler::getPeriod(ProfilePeriod_t period) {
+    return periods[period];
+}
+
+const ProfileHistogram_t& Profiler::getJitter(ProfilePeriod_t period) {
+    return jitter[period];
+}
+
+uint32_t Profiler::getPercentile(const ProfileHistogram_t& histogram, uint8_t percentile) {
+    if (histogram.count == 0) return 0;
+
+    // Upper edge of the bucket holding the requested rank
+    uint32_t rank = (uint32_t)(((uint64_t)histogram.count * percentile + 99) / 100);
+    uint32_t seen = 0;
+
+    for (uint8_t i = 0; i < PROFILE_HISTOGRAM_BUCKETS; i++) {
+        seen += histogram.buckets[i];
+        if (seen >= rank) {
+            if (i == PROFILE_HISTOGRAM_BUCKETS - 1) return histogram.max_us;
+            uint32_t upper = (2UL << i) - 1;
+            return upper < histogram.max_us ? upper : histogram.max_us;
+        }
+    }
+
+    return histogram.max_us;
+}
+
+void Profiler::printReport() {
+    Serial.println("=== Latency Profile (us) ===");
+    Serial.println("scope            count   min   avg   p50   p99   max");
+
+    for (uint8_t i = 0; i < PROFILE_SCOPE_COUNT; i++) {
+        printHistogram(getScopeName((ProfileScope_t)i), scopes[i]);
+    }
+
+    for (uint8_t i = 0; i < PROFILE_PERIOD_COUNT; i++) {
+        printHistogram(getPeriodName((ProfilePeriod_t)i), periods[i]);
+        Serial.print("  jitter: max ");
+        Serial.print(jitter[i].max_us);
+        Serial.print(" us, p99 ");
+        Serial.print(getPercentile(jitter[i], 99));
+        Serial.print(" us (nominal ");
+        Serial.print(nominal_period_us[i]);
+        Serial.println(" us)");
+    }
+
+    Serial.println("============================");
+}
+
+size_t Profiler::writeReportJSON(char* buffer, size_t capacity) {
+    JSON_Writer json(buffer, capacity);
+
+    json.beginObject();
+    json.addString("type", "profile");
+
+    json.beginArray("scopes");
+    for (uint8_t i = 0; i < PROFILE_SCOPE_COUNT; i++) {
+        const ProfileHistogram_t& h = scopes[i];
+        json.beginObject();
+        json.addString("name", getScopeName((ProfileScope_t)i));
+        json.addUInt("count", h.count);
+        json.addUInt("max", h.max_us);
+        json.addUInt("p50", getPercentile(h, 50));
+        json.addUInt("p99", getPercentile(h, 99));
+        json.endObject();
+    }
+    json.endArray();
+
+    json.beginArray("periods");
+    for (uint8_t i = 0; i < PROFILE_PERIOD_COUNT; i++) {
+        json.beginObject();
+        json.addString("name", getPeriodName((ProfilePeriod_t)i));
+        json.addUInt("count", periods[i].count);
+        json.addUInt("avg", periods[i].count ? (uint32_t)(periods[i].total_us / periods[i].count) : 0);
+        json.addUInt("jitter_max", jitter[i].max_us);
+        json.addUInt("jitter_p99", getPercentile(jitter[i], 99));
+        json.endObject();
+    }
+    json.endArray();
+
+    json.endObject();
+    return json.size();
+}
+
+const char* Profiler::getScopeName(ProfileScope_t scope) {
+    switch (scope) {
+        case PROFILE_SENSOR_CYCLE:  return "sensor_cycle";
+        case PROFILE_READ_SENSORS:  return "read_sensors";
+        case PROFILE_PROCESS_DATA:  return "process_data";
+        case PROFILE_CLASSIFIER:    return "classifier";
+        case PROFILE_BLE_NOTIFY:    return "ble_notify";
+        case PROFILE_HTTP_POST:     return "http_post";
+        case PROFILE_ALERT_WIFI:    return "alert_wifi";
+        case PROFILE_ALERT_BLE:     return "alert_ble";
+        case PROFILE_ALERT_FIRST:   return "alert_first";
+        case PROFILE_EVENT_LATENCY: return "event_latency";
+        default:                    return "unknown";
+    }
+}
+
+const char* Profiler::getPeriodName(ProfilePeriod_t period) {
+    switch (period) {
+        case PROFILE_PERIOD_SENSOR: return "sensor_period";
+        default:                    return "unknown";
+    }
+}
+
+// Private helper functions
+
+void Profiler::addSample(ProfileHistogram_t& histogram, uint32_t value_us) {
+#ifdef ARDUINO
+    portENTER_CRITICAL(&profiler_mux);
+#endif
+    if (histogram.count == 0 || value_us < histogram.min_us) {
+        histogram.min_us = value_us;
+    }
+    if (value_us > histogram.max_us) {
+        histogram.max_us = value_us;
+    }
+
+    histogram.count++;
+    histogram.total_us += value_us;
+    histogram.buckets[bucketFor(value_us)]++;
+#ifdef ARDUINO
+    portEXIT_CRITICAL(&profiler_mux);
+#endif
+}
+
+uint8_t Profiler::bucketFor(uint32_t value_us) {
+    // Index of the highest set bit, values 0 and 1 share bucket 0
+    uint8_t bucket = 0;
+    while (value_us > 1 && bucket < PROFILE_HISTOGRAM_BUCKETS - 1) {
+        value_us >>= 1;
+        bucket++;
+    }
+    return bucket;
+}
+
+void Profiler::printHistogram(const char* name, const ProfileHistogram_t& histogram) {
+    char line[96];
+    uint32_t avg = histogram.count ? (uint32_t)(histogram.total_us / histogram.count) : 0;
+
+    snprintf(line, sizeof(line), "%-15s %6lu %5lu %5lu %5lu %5lu %5lu",
+             name, (unsigned long)histogram.count, (unsigned long)histogram.min_us,
+             (unsigned long)avg, (unsigned long)getPercentile(histogram, 50),
+             (unsigned long)getPercentile(histogram, 99), (unsigned long)histogram.max_us);
+    Serial.println(line);
+}
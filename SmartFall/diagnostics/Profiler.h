@@ -0,0 +1,113 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <Arduino.h>
+#include "../utils/config.h"
+
+/*
+ * Lightweight latency profiler.
+ *
+ * Scopes are timed with the Xtensa cycle counter (CCOUNT) on the device
+ * and std::chrono on the host, and folded into fixed log2 buckets of
+ * microseconds, so recording costs a few dozen cycles and no heap.
+ * With PROFILER_ENABLED set to 0 the PROFILE_* macros expand to nothing.
+ */
+
+#define PROFILE_HISTOGRAM_BUCKETS  24   // Bucket i: [2^i, 2^(i+1)) us; last (>= 8.4 s) is open-ended
+
+// Timed scopes
+typedef enum {
+    PROFILE_SENSOR_CYCLE,     // Read + detect + stream for one sample
+    PROFILE_READ_SENSORS,     // readSensors()
+    PROFILE_PROCESS_DATA,     // FallDetector::processSensorData()
+    PROFILE_CLASSIFIER,       // FallClassifier::classify() on a completed impact window
+    PROFILE_BLE_NOTIFY,       // BLE setValue + notify
+    PROFILE_HTTP_POST,        // HTTP POST round trip
+    PROFILE_ALERT_WIFI,       // Alert dispatch -> WiFi confirmation
+    PROFILE_ALERT_BLE,        // Alert dispatch -> BLE confirmation
+    PROFILE_ALERT_FIRST,      // Alert dispatch -> first confirmation on any transport
+    PROFILE_EVENT_LATENCY,    // Event_Bus publish -> subscriber handler
+    PROFILE_SCOPE_COUNT
+} ProfileScope_t;
+
+// Periodic events whose spacing (jitter) is tracked
+typedef enum {
+    PROFILE_PERIOD_SENSOR,    // Sensor sample period
+    PROFILE_PERIOD_COUNT
+} ProfilePeriod_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint64_t total_us;
+    uint32_t buckets[PROFILE_HISTOGRAM_BUCKETS];
+} ProfileHistogram_t;
+
+class Profiler {
+private:
+    static ProfileHistogram_t scopes[PROFILE_SCOPE_COUNT];
+    static ProfileHistogram_t periods[PROFILE_PERIOD_COUNT];
+    static ProfileHistogram_t jitter[PROFILE_PERIOD_COUNT];  // |period - nominal|
+    static uint32_t nominal_period_us[PROFILE_PERIOD_COUNT];
+    static uint32_t last_period_ticks[PROFILE_PERIOD_COUNT];
+    static bool period_started[PROFILE_PERIOD_COUNT];
+    static uint32_t ticks_per_us;
+
+public:
+    static void begin();
+    static void reset();
+
+    // Timing source
+    static uint32_t ticks();
+    static uint32_t ticksToMicros(uint32_t ticks);
+
+    // Recording
+    static void record(ProfileScope_t scope, uint32_t elapsed_ticks);
+    static void recordMicros(ProfileScope_t scope, uint32_t elapsed_us);  // Spans across tasks/cores
+    static void setNominalPeriod(ProfilePeriod_t period, uint32_t period_us);
+    static void markPeriod(ProfilePeriod_t period);
+
+    // Results
+    static const ProfileHistogram_t& getScope(ProfileScope_t scope);
+    static const ProfileHistogram_t& getPeriod(ProfilePeriod_t period);
+    static const ProfileHistogram_t& getJitter(ProfilePeriod_t period);
+    static uint32_t getPercentile(const ProfileHistogram_t& histogram, uint8_t percentile);
+
+    // Reporting
+    static void printReport();
+    static size_t writeReportJSON(char* buffer, size_t capacity);
+    static const char* getScopeName(ProfileScope_t scope);
+    static const char* getPeriodName(ProfilePeriod_t period);
+
+private:
+    static void addSample(ProfileHistogram_t& histogram, uint32_t value_us);
+    static uint8_t bucketFor(uint32_t value_us);
+    static void printHistogram(const char* name, const ProfileHistogram_t& histogram);
+};
+
+// RAII helper: times from construction to end of the enclosing block
+class Profile_Scope {
+private:
+    ProfileScope_t scope;
+    uint32_t start_ticks;
+
+public:
+    Profile_Scope(ProfileScope_t s) : scope(s), start_ticks(Profiler::ticks()) {}
+    ~Profile_Scope() { Profiler::record(scope, Profiler::ticks() - start_ticks); }
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#if PROFILER_ENABLED
+#define PROFILE_SCOPE(scope)  Profile_Scope PROFILE_CONCAT(profile_scope_, __LINE__)(scope)
+#define PROFILE_PERIOD(period) Profiler::markPeriod(period)
+#define PROFILE_MICROS(scope, us) Profiler::recordMicros(scope, us)
+#else
+#define PROFILE_SCOPE(scope)
+#define PROFILE_PERIOD(period)
+#define PROFILE_MICROS(scope, us)
+#endif
+
+#endif // PROFILER_H
@@ -0,0 +1,203 @@
+#include "System_Metrics.h"
+#include <esp_heap_caps.h>
+
+#define METRICS_HEAP_CAPS (MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT)
+
+System_Metrics::System_Metrics() : initialized(false), last_sample_time(0),
+                                   sample_interval(METRICS_SAMPLE_INTERVAL_MS),
+                                   free_heap(0), largest_free_block(0),
+                                   psram_free(0), min_stack_headroom(0),
+                                   window_index(0), window_count(0), task_count(0) {
+    memset(windows, 0, sizeof(windows));
+    memset(tasks, 0, sizeof(tasks));
+}
+
+bool System_Metrics::begin() {
+    if (initialized) {
+        return true;
+    }
+
+    registerTask("loop", xTaskGetCurrentTaskHandle());
+
+    initialized = true;
+    openWindow(millis());
+    sample();
+
+    Serial.println("[Metrics] Heap/stack telemetry started");
+    return true;
+}
+
+bool System_Metrics::registerTask(const char* name, TaskHandle_t handle) {
+    if (handle == nullptr) {
+        return false;
+    }
+
+    // A restarted task replaces its old (deleted) handle
+    for (uint8_t i = 0; i < task_count; i++) {
+        if (strcmp(tasks[i].name, name) == 0) {
+            tasks[i].handle = handle;
+            tasks[i].stack_headroom = 0;
+            return true;
+        }
+    }
+
+    if (task_count >= METRICS_MAX_TASKS) {
+        return false;
+    }
+
+    tasks[task_count].name = name;
+    tasks[task_count].handle = handle;
+    tasks[task_count].stack_headroom = 0;
+    task_count++;
+    return true;
+}
+
+void System_Metrics::update() {
+    if (!initialized) return;
+
+    uint32_t current_time = millis();
+    if (current_time - last_sample_time >= sample_interval) {
+        sample();
+    }
+}
+
+void System_Metrics::sample() {
+    uint32_t current_time = millis();
+    last_sample_time = current_time;
+
+    free_heap = heap_caps_get_free_size(METRICS_HEAP_CAPS);
+    largest_free_block = heap_caps_get_largest_free_block(METRICS_HEAP_CAPS);
+    psram_free = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+    sampleTasks();
+
+    if (current_time - windows[window_index].start_time >= METRICS_WINDOW_MS) {
+        window_index = (window_index + 1) % MEMORY_TREND_WINDOWS;
+        openWindow(current_time);
+    }
+
+    MetricsWindow_t& window = windows[window_index];
+    if (window.samples == 0) {
+        window.heap_min = window.heap_max = free_heap;
+        window.block_min = window.block_max = largest_free_block;
+        window.psram_min = psram_free;
+        window.stack_min = min_stack_headroom;
+    } else {
+        if (free_heap < window.heap_min) window.heap_min = free_heap;
+        if (free_heap > window.heap_max) window.heap_max = free_heap;
+        if (largest_free_block < window.block_min) window.block_min = largest_free_block;
+        if (largest_free_block > window.block_max) window.block_max = largest_free_block;
+        if (psram_free < window.psram_min) window.psram_min = psram_free;
+        if (min_stack_headroom < window.stack_min) window.stack_min = min_stack_headroom;
+    }
+    if (window.samples < 0xFFFF) {
+        window.samples++;
+    }
+}
+
+void System_Metrics::getStats(MemoryStats_t& stats) {
+    memset(&stats, 0, sizeof(stats));
+
+    stats.free_heap = free_heap;
+    stats.min_free_heap = heap_caps_get_minimum_free_size(METRICS_HEAP_CAPS);
+    stats.largest_free_block = largest_free_block;
+    stats.fragmentation_pct = getFragmentation();
+    stats.psram_free = psram_free;
+    stats.min_stack_headroom = min_stack_headroom;
+
+    // Walk the ring oldest first
+    bool first = true;
+    for (uint8_t i = 0; i < window_count; i++) {
+        uint8_t slot = (window_index + MEMORY_TREND_WINDOWS - window_count + 1 + i) % MEMORY_TREND_WINDOWS;
+        const MetricsWindow_t& window = windows[slot];
+        if (window.samples == 0) continue;
+
+        if (first) {
+            stats.window_heap_min = window.heap_min;
+            stats.window_heap_max = window.heap_max;
+            stats.window_block_min = window.block_min;
+            first = false;
+        } else {
+            if (window.heap_min < stats.window_heap_min) stats.window_heap_min = window.heap_min;
+            if (window.heap_max > stats.window_heap_max) stats.window_heap_max = window.heap_max;
+            if (window.block_min < stats.window_block_min) stats.window_block_min = window.block_min;
+        }
+
+        stats.heap_trend[stats.trend_count++] = window.heap_min;
+    }
+}
+
+uint32_t System_Metrics::getFreeHeap() {
+    return free_heap;
+}
+
+uint32_t System_Metrics::getLargestFreeBlock() {
+    return largest_free_block;
+}
+
+uint8_t System_Metrics::getFragmentation() {
+    if (free_heap == 0) return 0;
+    return (uint8_t)(100 - (uint64_t)largest_free_block * 100 / free_heap);
+}
+
+uint32_t System_Metrics::getTaskStackHeadroom(const char* name) {
+    for (uint8_t i = 0; i < task_count; i++) {
+        if (strcmp(tasks[i].name, name) == 0) {
+            return tasks[i].stack_headroom;
+        }
+    }
+    return 0;
+}
+
+void System_Metrics::printMetrics() {
+    Serial.println("=== System Metrics ===");
+    Serial.print("Free Heap: ");
+    Serial.print(free_heap);
+    Serial.print(" bytes (min ");
+    Serial.print(heap_caps_get_minimum_free_size(METRICS_HEAP_CAPS));
+    Serial.println(")");
+    Serial.print("Largest Block: ");
+    Serial.print(largest_free_block);
+    Serial.print(" bytes (");
+    Serial.print(getFragmentation());
+    Serial.println("% fragmented)");
+    Serial.print("PSRAM Free: ");
+    Serial.print(psram_free);
+    Serial.println(" bytes");
+
+    for (uint8_t i = 0; i < task_count; i++) {
+        Serial.print("Stack headroom [");
+        Serial.print(tasks[i].name);
+        Serial.print("]: ");
+        Serial.print(tasks[i].stack_headroom);
+        Serial.println(" bytes");
+    }
+    Serial.println("======================");
+}
+
+bool System_Metrics::isInitialized() {
+    return initialized;
+}
+
+// Private helper functions
+
+void System_Metrics::openWindow(uint32_t current_time) {
+    memset(&windows[window_index], 0, sizeof(MetricsWindow_t));
+    windows[window_index].start_time = current_time;
+
+    if (window_count < MEMORY_TREND_WINDOWS) {
+        window_count++;
+    }
+}
+
+void System_Metrics::sampleTasks() {
+    min_stack_headroom = 0;
+
+    for (uint8_t i = 0; i < task_count; i++) {
+        // ESP-IDF reports the high-water mark in bytes
+        tasks[i].stack_headroom = uxTaskGetStackHighWaterMark(tasks[i].handle);
+
+        if (i == 0 || tasks[i].stack_headroom < min_stack_headroom) {
+            min_stack_headroom = tasks[i].stack_headroom;
+        }
+    }
+}
@@ -0,0 +1,73 @@
+#ifndef SYSTEM_METRICS_H
+#define SYSTEM_METRICS_H
+
+#include <Arduino.h>
+#include "../utils/data_types.h"
+#include "../utils/config.h"
+
+// One slot of the telemetry ring: min/max of every sample taken while
+// the window was open
+typedef struct {
+    uint32_t start_time;
+    uint32_t heap_min;
+    uint32_t heap_max;
+    uint32_t block_min;
+    uint32_t block_max;
+    uint32_t psram_min;
+    uint32_t stack_min;
+    uint16_t samples;
+} MetricsWindow_t;
+
+class System_Metrics {
+private:
+    bool initialized;
+    uint32_t last_sample_time;
+    uint32_t sample_interval;
+
+    // Latest sample
+    uint32_t free_heap;
+    uint32_t largest_free_block;
+    uint32_t psram_free;
+    uint32_t min_stack_headroom;
+
+    // Fixed ring of windows (no heap use)
+    MetricsWindow_t windows[MEMORY_TREND_WINDOWS];
+    uint8_t window_index;
+    uint8_t window_count;
+
+    // Monitored tasks
+    struct {
+        const char* name;
+        TaskHandle_t handle;
+        uint32_t stack_headroom;
+    } tasks[METRICS_MAX_TASKS];
+    uint8_t task_count;
+
+public:
+    System_Metrics();
+
+    // Initialization
+    bool begin();  // Registers the calling (loop) task
+    bool registerTask(const char* name, TaskHandle_t handle);
+
+    // Sampling
+    void update();  // Call in loop; samples every METRICS_SAMPLE_INTERVAL_MS
+    void sample();  // Take a sample now
+
+    // Results
+    void getStats(MemoryStats_t& stats);
+    uint32_t getFreeHeap();
+    uint32_t getLargestFreeBlock();
+    uint8_t getFragmentation();
+    uint32_t getTaskStackHeadroom(const char* name);
+
+    // Debug functions
+    void printMetrics();
+    bool isInitialized();
+
+private:
+    void openWindow(uint32_t current_time);
+    void sampleTasks();
+};
+
+#endif // SYSTEM_METRICS_H
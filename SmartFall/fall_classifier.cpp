@@ -0,0 +1,2 @@
+// Arduino compiles only the sketch folder; the source lives in detection/
+#include "detection/fall_classifier.cpp"
@@ -0,0 +1,183 @@
+#include "Altitude_Filter.h"
+
+Altitude_Filter::Altitude_Filter(bool kalman) : use_kalman(kalman) {
+    setSampleRate(SENSOR_SAMPLE_RATE_HZ);
+    reset();
+}
+
+void Altitude_Filter::reset() {
+    started = false;
+    origin_hpa = 0;
+    baseline_hpa = 0;
+    gravity_g = 1.0f;
+    height = 0;
+    speed = 0;
+    p00 = ALTITUDE_BARO_NOISE_M * ALTITUDE_BARO_NOISE_M;
+    p01 = 0;
+    p11 = 1.0f;
+    for (uint8_t i = 0; i < ALTITUDE_RING_BLOCKS; i++) {
+        ring[i] = 0;
+    }
+    ring_head = 0;
+    ring_count = 0;
+    block_sum = 0;
+    pressure_sum = 0;
+    block_fill = 0;
+    previous_status = FALL_STATUS_MONITORING;
+    holding = false;
+    pre_height = 0;
+    last_change = 0;
+    samples = 0;
+    events = 0;
+}
+
+void Altitude_Filter::setSampleRate(uint16_t rate_hz) {
+    if (rate_hz == 0) rate_hz = SENSOR_SAMPLE_RATE_HZ;
+    dt = 1.0f / rate_hz;
+    block_samples = (uint16_t)((uint32_t)ALTITUDE_BLOCK_MS * rate_hz / 1000);
+    if (block_samples < 1) block_samples = 1;
+}
+
+void Altitude_Filter::update(const SensorData_t& data) {
+    if (!data.valid || !(data.pressure > 0)) return;
+
+    float magnitude = sqrtf(data.accel_x * data.accel_x + data.accel_y * data.accel_y +
+                            data.accel_z * data.accel_z);
+    if (!started) {
+        started = true;
+        origin_hpa = data.pressure;
+        gravity_g = magnitude;
+    }
+
+    float pressure = data.pressure - origin_hpa;
+    float measured = barometricHeight(pressure);
+    if (use_kalman) {
+        predict((magnitude - gravity_g) * ALTITUDE_GRAVITY_MS2);
+        correct(measured);
+    } else {
+        height = measured;
+    }
+
+    // At-rest |accel| learns from still samples only, and not during an event
+    if (!holding && fabsf(magnitude - gravity_g) < ALTITUDE_STILL_G) {
+        gravity_g += (dt / ALTITUDE_GRAVITY_TAU_S) * (magnitude - gravity_g);
+    }
+
+    block_sum += height;
+    pressure_sum += pressure;
+    if (++block_fill >= block_samples) closeBlock();
+    samples++;
+}
+
+bool Altitude_Filter::observe(FallStatus_t status) {
+    bool left = previous_status == FALL_STATUS_MONITORING && status != FALL_STATUS_MONITORING;
+    bool completed = status == FALL_STATUS_POTENTIAL_FALL && previous_status != FALL_STATUS_POTENTIAL_FALL;
+    previous_status = status;
+
+    if (left) markEvent();
+    if (status == FALL_STATUS_MONITORING && holding) releaseEvent();
+    return completed;
+}
+
+void Altitude_Filter::markEvent() {
+    // Without a full gap of history the baseline is the best pre-event level
+    pre_height = ring_count > ALTITUDE_GAP_BLOCKS ? windowMean(ALTITUDE_GAP_BLOCKS)
+                                                  : barometricHeight(baseline_hpa);
+    holding = true;
+    events++;
+}
+
+void Altitude_Filter::releaseEvent() {
+    holding = false;
+}
+
+float Altitude_Filter::getAltitudeChange() {
+    float now = ring_count > 0 ? windowMean(0) : height;
+    last_change = (holding ? pre_height : barometricHeight(baseline_hpa)) - now;
+    return last_change;
+}
+
+float Altitude_Filter::getHeight() {
+    return height - barometricHeight(baseline_hpa);
+}
+
+void Altitude_Filter::printStats() {
+    Serial.println("=== Altitude Filter ===");
+    Serial.print("Baseline: ");
+    Serial.print(getBaselinePressure(), 2);
+    Serial.print(" hPa");
+    Serial.println(holding ? " (held)" : "");
+    Serial.print("Height: ");
+    Serial.print(getHeight(), 2);
+    Serial.print(" m, ");
+    Serial.print(speed, 2);
+    Serial.println(" m/s");
+    Serial.print("Events: ");
+    Serial.print(events);
+    Serial.print(" (last change ");
+    Serial.print(last_change, 2);
+    Serial.println(" m)");
+    Serial.print("Samples: ");
+    Serial.println(samples);
+    Serial.println("=======================");
+}
+
+// Private helper functions
+
+float Altitude_Filter::barometricHeight(float pressure_hpa) {
+    // dh = -H dp / p. A fixed p keeps the frame still; the scale is off
+    // by well under 1% for any weather.
+    return -pressure_hpa * ALTITUDE_SCALE_HEIGHT_M / origin_hpa;
+}
+
+void Altitude_Filter::predict(float vertical_ms2) {
+    height += speed * dt + 0.5f * vertical_ms2 * dt * dt;
+    speed += vertical_ms2 * dt;
+
+    // P = F P F' + Q, with Q from white acceleration noise
+    float q = ALTITUDE_ACCEL_NOISE_MS2 * ALTITUDE_ACCEL_NOISE_MS2;
+    float dt2 = dt * dt;
+    p00 += dt * (2.0f * p01 + dt * p11) + 0.25f * q * dt2 * dt2;
+    p01 += dt * p11 + 0.5f * q * dt2 * dt;
+    p11 += q * dt2;
+}
+
+void Altitude_Filter::correct(float measured_m) {
+    float innovation = measured_m - height;
+    float s = p00 + ALTITUDE_BARO_NOISE_M * ALTITUDE_BARO_NOISE_M;
+    float k0 = p00 / s;
+    float k1 = p01 / s;
+    height += k0 * innovation;
+    speed += k1 * innovation;
+
+    // P = (I - K H) P
+    p11 -= k1 * p01;
+    p01 -= k0 * p01;
+    p00 -= k0 * p00;
+}
+
+void Altitude_Filter::closeBlock() {
+    ring[ring_head] = block_sum / block_fill;
+    ring_head = (ring_head + 1) % ALTITUDE_RING_BLOCKS;
+    if (ring_count < ALTITUDE_RING_BLOCKS) ring_count++;
+
+    // The baseline moves far slower than a block; once per block is plenty
+    if (!holding) {
+        float alpha = (ALTITUDE_BLOCK_MS / 1000.0f) / ALTITUDE_BASELINE_TAU_S;
+        baseline_hpa += alpha * (pressure_sum / block_fill - baseline_hpa);
+    }
+
+    block_sum = 0;
+    pressure_sum = 0;
+    block_fill = 0;
+}
+
+float Altitude_Filter::windowMean(uint8_t skip_blocks) {
+    float sum = 0;
+    uint8_t count = 0;
+    for (uint8_t i = skip_blocks; i < skip_blocks + ALTITUDE_WINDOW_BLOCKS && i < ring_count; i++) {
+        sum += ring[(ring_head + ALTITUDE_RING_BLOCKS - 1 - i) % ALTITUDE_RING_BLOCKS];
+        count++;
+    }
+    return count ? sum / count : 0.0f;
+}
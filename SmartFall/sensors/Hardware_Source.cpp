@@ -0,0 +1,108 @@
+#include "Hardware_Source.h"
+
+#define HARDWARE_IMU_LIMIT  2000.0f     // Largest full scale (±2000 °/s); anything past it is garbage
+
+Hardware_Source::Hardware_Source(MPU6050_Sensor* imu_sensor, BMP280_Sensor* pressure_sensor,
+                                 MAX30102_Sensor* heart_sensor, FSR_Sensor* force_sensor,
+                                 I2C_Bus* i2c_bus)
+    : imu(imu_sensor), pressure(pressure_sensor), heart(heart_sensor), force(force_sensor),
+      bus(i2c_bus),
+      imu_health("imu", SENSOR_IMU_STUCK_SAMPLES, -HARDWARE_IMU_LIMIT, HARDWARE_IMU_LIMIT),
+      pressure_health("pressure", SENSOR_PRESSURE_STUCK_SAMPLES, SENSOR_PRESSURE_MIN_HPA,
+                      SENSOR_PRESSURE_MAX_HPA),
+      busy_ticks(0) {
+    for (uint8_t i = 0; i < HARDWARE_OPTIONAL_COUNT; i++) {
+        enabled[i] = false;
+    }
+}
+
+void Hardware_Source::enable(HardwareSensor_t sensor) {
+    if (sensor == HARDWARE_PRESSURE) pressure_health.markUp();
+    enabled[sensor] = true;
+}
+
+uint8_t Hardware_Source::getAvailable() {
+    uint8_t available = 0;
+    if (pressure_health.isUp()) available |= HARDWARE_BIT(HARDWARE_PRESSURE);
+    if (enabled[HARDWARE_HEART]) available |= HARDWARE_BIT(HARDWARE_HEART);
+    if (enabled[HARDWARE_FORCE]) available |= HARDWARE_BIT(HARDWARE_FORCE);
+    return available;
+}
+
+// Drivers are brought up by their own boot steps; an IMU that did not
+// come up is left to the supervisor
+bool Hardware_Source::beginSource() {
+    decimator.reset();
+    if (imu->isInitialized()) {
+        imu_health.markUp();
+    } else {
+        imu_health.markDown(millis());
+    }
+    return imu->isInitialized();
+}
+
+bool Hardware_Source::readSample(SensorData_t& data) {
+    data.timestamp = millis();
+    data.valid = false;
+    data.accel_x = 0;
+    data.accel_y = 0;
+    data.accel_z = 0;
+    data.gyro_x = 0;
+    data.gyro_y = 0;
+    data.gyro_z = 0;
+    data.accel_range_g = 0;
+    data.accel_peak_g = 0;
+    data.accel_peak_clipped = false;
+    data.gyro_peak_dps = 0;
+    data.pressure = 0;
+    data.heart_rate = 0;
+
+    // Bus sensors, unless the supervisor is bringing one back
+    if (bus->lock(0)) {
+        readIMU(data);
+        readPressure(data);
+
+        // Read heart rate (MAX30102)
+        float bpm;
+        bool finger_detected;
+        if (enabled[HARDWARE_HEART] && heart->readHeartRate(bpm, finger_detected)) {
+            data.heart_rate = bpm;
+        }
+        bus->unlock();
+    } else {
+        busy_ticks++;
+    }
+
+    // Read force sensor (FSR)
+    data.fsr_value = enabled[HARDWARE_FORCE] ? force->readRaw() : 0;
+    return true;
+}
+
+// Private helper functions
+
+void Hardware_Source::readIMU(SensorData_t& data) {
+    if (!imu_health.isUp()) return;
+
+    bool ok;
+    if (imu->isFifoEnabled()) {
+        // Every frame since the last tick, as one sample with its peaks
+        ok = imu->readFifo(decimator) && decimator.take(data);
+    } else {
+        float temp;
+        ok = imu->readData(data.accel_x, data.accel_y, data.accel_z,
+                           data.gyro_x, data.gyro_y, data.gyro_z, temp, data.accel_range_g);
+    }
+
+    float values[6] = {data.accel_x, data.accel_y, data.accel_z, data.gyro_x, data.gyro_y, data.gyro_z};
+    data.valid = imu_health.check(ok, values, 6, data.timestamp);
+}
+
+void Hardware_Source::readPressure(SensorData_t& data) {
+    if (!pressure_health.isUp()) return;
+
+    float temp, altitude, hpa = 0;
+    bool ok = pressure->readData(temp, hpa, altitude);
+    if (pressure_health.check(ok, &hpa, 1, data.timestamp)) {
+        data.pressure = hpa;
+    }
+}
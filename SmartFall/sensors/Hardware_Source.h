@@ -0,0 +1,64 @@
+#ifndef HARDWARE_SOURCE_H
+#define HARDWARE_SOURCE_H
+
+#include <Arduino.h>
+#include "Sample_Source.h"
+#include "MPU6050_Sensor.h"
+#include "IMU_Decimator.h"
+#include "BMP280_Sensor.h"
+#include "MAX30102_Sensor.h"
+#include "FSR_Sensor.h"
+#include "I2C_Bus.h"
+#include "Sensor_Health.h"
+
+// The wrist unit's real sensors. The IMU is read whenever it is healthy;
+// in the high-rate profile its FIFO is drained and decimated to one
+// sample per read. The others are read only after enable().
+//
+// The IMU and the barometer pass every read through their Sensor_Health.
+// A failed IMU leaves the sample invalid (the detector skips it) rather
+// than inventing 1 g; a failed or missing barometer reports 0 hPa, as a
+// missing heart rate reports 0 BPM. getAvailable() says which optional
+// sensors are delivering, for the confidence scorer. The sensor
+// supervisor re-inits failed sensors and holds the bus meanwhile; a tick
+// that finds the bus held reads only the FSR.
+class Hardware_Source : public Sample_Source<Hardware_Source> {
+    friend class Sample_Source<Hardware_Source>;
+
+private:
+    MPU6050_Sensor* imu;
+    BMP280_Sensor* pressure;
+    MAX30102_Sensor* heart;
+    FSR_Sensor* force;
+    I2C_Bus* bus;
+    volatile bool enabled[HARDWARE_OPTIONAL_COUNT];
+    IMU_Decimator decimator;
+    Sensor_Health imu_health;
+    Sensor_Health pressure_health;
+    uint32_t busy_ticks;            // Bus held by the supervisor
+
+public:
+    Hardware_Source(MPU6050_Sensor* imu, BMP280_Sensor* pressure, MAX30102_Sensor* heart,
+                    FSR_Sensor* force, I2C_Bus* bus);
+
+    // Called by the boot step once the sensor has settled
+    void enable(HardwareSensor_t sensor);
+    bool isEnabled(HardwareSensor_t sensor) { return enabled[sensor]; }
+    uint8_t getAvailable();         // HARDWARE_BIT mask of optional sensors delivering
+
+    IMU_Decimator& getDecimator() { return decimator; }
+    Sensor_Health& getIMUHealth() { return imu_health; }
+    Sensor_Health& getPressureHealth() { return pressure_health; }
+    uint32_t getBusyTicks() { return busy_ticks; }
+
+private:
+    bool beginSource();
+    bool readSample(SensorData_t& data);
+    const char* sourceName() { return "hardware"; }
+
+    // Private helper functions
+    void readIMU(SensorData_t& data);
+    void readPressure(SensorData_t& data);
+};
+
+#endif // HARDWARE_SOURCE_H
@@ -0,0 +1,84 @@
+#include "I2C_Bus.h"
+
+#ifdef ARDUINO
+
+#define I2C_HALF_CLOCK_US  5        // 100 kHz during recovery
+
+Wire_Bus::Wire_Bus(uint8_t sda, uint8_t scl) : sda_pin(sda), scl_pin(scl), mutex(nullptr) {
+}
+
+bool Wire_Bus::begin() {
+    if (mutex == nullptr) {
+        mutex = xSemaphoreCreateMutex();
+        if (mutex == nullptr) return false;
+    }
+
+    // A stuck slave costs one timeout per transaction, not Wire's 50 ms default
+    if (!Wire.begin(sda_pin, scl_pin)) return false;
+    Wire.setTimeOut(I2C_TIMEOUT_MS);
+    return true;
+}
+
+bool Wire_Bus::probe(uint8_t address) {
+    Wire.beginTransmission(address);
+    return Wire.endTransmission() == 0;
+}
+
+bool Wire_Bus::recover() {
+    uint32_t clock_hz = Wire.getClock();
+    Wire.end();
+
+    // Open-drain by hand: the pull-ups drive high
+    pinMode(sda_pin, INPUT_PULLUP);
+    pinMode(scl_pin, OUTPUT_OPEN_DRAIN);
+    digitalWrite(scl_pin, HIGH);
+    bool released = releaseClock();
+
+    // A slave mid-read lets go of SDA once it has shifted out its byte
+    for (uint8_t i = 0; released && i < I2C_RECOVERY_CLOCKS && digitalRead(sda_pin) == LOW; i++) {
+        digitalWrite(scl_pin, LOW);
+        delayMicroseconds(I2C_HALF_CLOCK_US);
+        digitalWrite(scl_pin, HIGH);
+        released = releaseClock();
+        delayMicroseconds(I2C_HALF_CLOCK_US);
+    }
+
+    // STOP: SDA rises while SCL is high
+    pinMode(sda_pin, OUTPUT_OPEN_DRAIN);
+    digitalWrite(sda_pin, LOW);
+    delayMicroseconds(I2C_HALF_CLOCK_US);
+    digitalWrite(scl_pin, HIGH);
+    delayMicroseconds(I2C_HALF_CLOCK_US);
+    digitalWrite(sda_pin, HIGH);
+    delayMicroseconds(I2C_HALF_CLOCK_US);
+    released = released && digitalRead(sda_pin) == HIGH && digitalRead(scl_pin) == HIGH;
+
+    Wire.begin(sda_pin, scl_pin);
+    Wire.setClock(clock_hz);
+    Wire.setTimeOut(I2C_TIMEOUT_MS);
+    return released;
+}
+
+bool Wire_Bus::lock(uint32_t timeout_ms) {
+    if (mutex == nullptr) return true;      // Before begin(): nothing else uses the bus yet
+    return xSemaphoreTake(mutex, pdMS_TO_TICKS(timeout_ms)) == pdTRUE;
+}
+
+void Wire_Bus::unlock() {
+    if (mutex != nullptr) {
+        xSemaphoreGive(mutex);
+    }
+}
+
+// Private helper functions
+
+// A slave may stretch the clock; wait a bounded time for it
+bool Wire_Bus::releaseClock() {
+    uint32_t start = micros();
+    while (digitalRead(scl_pin) == LOW) {
+        if (micros() - start > I2C_STRETCH_TIMEOUT_US) return false;
+    }
+    return true;
+}
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef IMU_DECIMATOR_H
+#define IMU_DECIMATOR_H
+
+#include <Arduino.h>
+#include "Accel_Ranger.h"
+#include "../utils/data_types.h"
+
+/*
+ * Reduces high-rate MPU6050 FIFO frames to one detector sample.
+ *
+ * Impact pulses last tens of milliseconds. Read at 100 Hz behind the
+ * 94 Hz DLPF, the sample that lands on the pulse is rarely its top. In
+ * the high-rate profile the sensor runs at IMU_SAMPLE_RATE_HZ into its
+ * FIFO and every frame passes through push(). take() then hands the
+ * sensor task one SensorData_t for all frames since the last take():
+ *   - accel and gyro axes are the mean of the frames (a box-car
+ *     anti-alias filter), so the stages and history see 100 Hz data
+ *   - accel_peak_g and gyro_peak_dps are the largest magnitudes of any
+ *     single frame, and accel_peak_clipped says whether that frame
+ *     clipped. The detector scores impact and rotation on these.
+ *
+ * take() runs on the sensor tick, not every N frames, so exactly one
+ * sample comes out per tick however the sensor clock drifts against
+ * millis(). Each frame is converted at the scale it was read at.
+ *
+ * No hardware access, so the same code runs in the host replays.
+ */
+
+class IMU_Decimator {
+private:
+    float accel_sum[3];             // g
+    float gyro_sum[3];              // deg/s
+    float accel_peak_sq;            // g^2
+    float gyro_peak_sq;             // (deg/s)^2
+    bool peak_clipped;
+    uint8_t peak_range_g;           // Scale of the peak frame
+    uint16_t frames;                // Since the last take()
+    uint32_t total_frames;
+    uint32_t outputs;
+    uint16_t max_frames;            // Most frames behind one output
+
+public:
+    IMU_Decimator();
+
+    void reset();
+
+    // One frame of raw counts, read at accel_range_g and gyro_counts_per_dps
+    void push(const int16_t accel[3], const int16_t gyro[3], uint8_t accel_range_g,
+              float gyro_counts_per_dps);
+
+    // Fills the IMU fields of data from the frames since the last take().
+    // False when there were none; data is left alone.
+    bool take(SensorData_t& data);
+
+    uint16_t getPendingFrames() { return frames; }
+    uint32_t getTotalFrames() { return total_frames; }
+    uint32_t getOutputs() { return outputs; }
+    uint16_t getMaxFrames() { return max_frames; }
+
+    void printStats();
+};
+
+#endif // IMU_DECIMATOR_H
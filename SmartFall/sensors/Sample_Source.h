@@ -0,0 +1,61 @@
+#ifndef SAMPLE_SOURCE_H
+#define SAMPLE_SOURCE_H
+
+#include <Arduino.h>
+#include "../utils/data_types.h"
+
+/*
+ * Sensor sample source interface.
+ *
+ * Anything that produces SensorData_t samples derives from
+ * Sample_Source<Self>:
+ *
+ *   Hardware_Source    MPU6050 + BMP280 + MAX30102 + FSR (device only)
+ *   Trace_Source       Replays recorded samples (log_decode CSV, arrays)
+ *   Synthetic_Source   Deterministic rest/walk/fall stream
+ *
+ * The binding is resolved at compile time (CRTP), so read() on the
+ * sensor tick is a direct, inlinable call with no vtable. Code that
+ * must work with any source takes a Sample_Source<S>& template
+ * parameter. The firmware picks one with SENSOR_SOURCE in config.h.
+ *
+ * Every source fills all fields in the units the detector expects
+ * (g, deg/s, hPa, BPM, ADC counts), with timestamp in ms. The detector
+ * times its stages from these timestamps, so a trace replays the same
+ * way at any speed.
+ *
+ * A derived class implements:
+ *   bool beginSource();
+ *   bool readSample(SensorData_t& data);   // False when exhausted
+ *   const char* sourceName();
+ */
+
+template <typename Derived>
+class Sample_Source {
+protected:
+    uint32_t samples_read;
+
+    Sample_Source() : samples_read(0) {}
+
+public:
+    bool begin() {
+        samples_read = 0;
+        return derived().beginSource();
+    }
+
+    bool read(SensorData_t& data) {
+        if (!derived().readSample(data)) {
+            return false;
+        }
+        samples_read++;
+        return true;
+    }
+
+    const char* getName() { return derived().sourceName(); }
+    uint32_t getSamplesRead() { return samples_read; }
+
+private:
+    Derived& derived() { return static_cast<Derived&>(*this); }
+};
+
+#endif // SAMPLE_SOURCE_H
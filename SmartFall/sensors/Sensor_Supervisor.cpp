@@ -0,0 +1,77 @@
+#include "Sensor_Supervisor.h"
+
+Sensor_Supervisor::Sensor_Supervisor(I2C_Bus* i2c_bus)
+    : bus(i2c_bus), sensor_count(0), bus_recoveries(0), bus_recovery_failures(0) {
+#ifdef ARDUINO
+    task = nullptr;
+#endif
+}
+
+bool Sensor_Supervisor::add(Sensor_Health* health, uint8_t address, SensorReinitFn_t reinit) {
+    if (sensor_count >= SENSOR_SUPERVISOR_MAX || health == nullptr || reinit == nullptr) return false;
+    sensors[sensor_count].health = health;
+    sensors[sensor_count].address = address;
+    sensors[sensor_count].reinit = reinit;
+    sensor_count++;
+    return true;
+}
+
+bool Sensor_Supervisor::begin() {
+#ifdef ARDUINO
+    if (xTaskCreate(taskEntry, "health", SENSOR_HEALTH_TASK_STACK, this,
+                    SENSOR_HEALTH_TASK_PRIORITY, &task) != pdPASS) {
+        Serial.println("[Health] ERROR: Failed to create supervisor task!");
+        return false;
+    }
+#endif
+    return true;
+}
+
+uint8_t Sensor_Supervisor::service(uint32_t now_ms) {
+    uint8_t recovered = 0;
+
+    for (uint8_t i = 0; i < sensor_count; i++) {
+        Sensor_Health* health = sensors[i].health;
+        if (!health->reinitDue(now_ms)) continue;
+        if (!bus->lock(SENSOR_HEALTH_INTERVAL_MS)) return recovered;
+
+        // Silence can be a slave holding SDA low; clear it before the driver tries
+        if (!bus->probe(sensors[i].address)) {
+            bus_recoveries++;
+            if (!bus->recover()) bus_recovery_failures++;
+        }
+        bool ok = sensors[i].reinit();
+        bus->unlock();
+
+        health->reinitDone(ok, now_ms);
+        Serial.print(ok ? "[Health] ✓ " : "[Health] ✗ ");
+        Serial.print(health->getName());
+        Serial.println(ok ? " recovered" : " re-init failed");
+        if (ok) recovered++;
+    }
+    return recovered;
+}
+
+void Sensor_Supervisor::printStats() {
+    Serial.println("=== Sensor Supervisor ===");
+    Serial.print("Bus recoveries: ");
+    Serial.print(bus_recoveries);
+    Serial.print(" (");
+    Serial.print(bus_recovery_failures);
+    Serial.println(" left the bus held)");
+    Serial.println("=========================");
+    for (uint8_t i = 0; i < sensor_count; i++) {
+        sensors[i].health->printStats();
+    }
+}
+
+#ifdef ARDUINO
+void Sensor_Supervisor::taskEntry(void* arg) {
+    Sensor_Supervisor* supervisor = static_cast<Sensor_Supervisor*>(arg);
+    TickType_t wake = xTaskGetTickCount();
+    for (;;) {
+        vTaskDelayUntil(&wake, pdMS_TO_TICKS(SENSOR_HEALTH_INTERVAL_MS));
+        supervisor->service(millis());
+    }
+}
+#endif
@@ -0,0 +1,68 @@
+#ifndef SENSOR_SUPERVISOR_H
+#define SENSOR_SUPERVISOR_H
+
+#include <Arduino.h>
+#include "I2C_Bus.h"
+#include "Sensor_Health.h"
+#include "../utils/config.h"
+
+typedef bool (*SensorReinitFn_t)();
+
+typedef struct {
+    Sensor_Health* health;
+    uint8_t address;                // Probed before the re-init
+    SensorReinitFn_t reinit;        // begin() + configure(); false if it did not come up
+} SupervisedSensor_t;
+
+/*
+ * Brings failed sensors back without a reboot.
+ *
+ * service() looks at each registered sensor's health. One whose re-init
+ * is due gets, with the bus locked: a probe of its address and, if that
+ * is not ACKed, bus recovery (I2C_Bus::recover); then its re-init
+ * function, which probes for itself (the BMP280 driver also tries the
+ * alternate address). The outcome goes back to Sensor_Health, which
+ * sets the next attempt. Holding the lock keeps the sensor tick off the
+ * bus meanwhile, so the re-init can take as long as its driver needs
+ * (the MPU6050 reset alone is 100 ms) without racing the reads.
+ *
+ * On the device begin() runs service() on its own task every
+ * SENSOR_HEALTH_INTERVAL_MS, at a priority that never delays the sensor
+ * tick. The host tests call service() directly.
+ */
+class Sensor_Supervisor {
+private:
+    I2C_Bus* bus;
+    SupervisedSensor_t sensors[SENSOR_SUPERVISOR_MAX];
+    uint8_t sensor_count;
+
+    uint32_t bus_recoveries;
+    uint32_t bus_recovery_failures;
+
+#ifdef ARDUINO
+    TaskHandle_t task;
+#endif
+
+public:
+    Sensor_Supervisor(I2C_Bus* bus);
+
+    bool add(Sensor_Health* health, uint8_t address, SensorReinitFn_t reinit);
+    bool begin();                   // Supervisor task (device only)
+
+    // Re-inits every sensor that is due; returns how many came back
+    uint8_t service(uint32_t now_ms);
+
+    uint32_t getBusRecoveries() { return bus_recoveries; }
+    uint32_t getBusRecoveryFailures() { return bus_recovery_failures; }
+#ifdef ARDUINO
+    TaskHandle_t getTaskHandle() { return task; }
+#endif
+    void printStats();
+
+private:
+#ifdef ARDUINO
+    static void taskEntry(void* arg);
+#endif
+};
+
+#endif // SENSOR_SUPERVISOR_H
@@ -0,0 +1,62 @@
+#include "Synthetic_Source.h"
+
+// Hash-based noise, reproducible per (index, field)
+static float noise(uint32_t index, uint32_t field, float amplitude) {
+    uint32_t h = index * 2654435761UL ^ (field + 1) * 40503UL;
+    h ^= h >> 15;
+    h *= 2246822519UL;
+    h ^= h >> 13;
+    return ((h & 0xFFFF) / 32768.0f - 1.0f) * amplitude;
+}
+
+Synthetic_Source::Synthetic_Source(uint16_t rate, uint32_t sample_limit)
+    : rate_hz(rate), index(0), limit(sample_limit) {
+}
+
+void Synthetic_Source::generate(uint32_t index, uint16_t rate_hz, SensorData_t& data) {
+    float t = (float)index / rate_hz;
+    uint32_t phase = (uint32_t)t % 60;    // 60 s cycle: rest, walk, fall, lie
+
+    float ax = 0, ay = 0, az = 1.0f, gx = 0, gy = 0, gz = 0;
+    if (phase >= 20 && phase < 50) {
+        ax = 0.3f * sinf(2 * M_PI * 1.8f * t);
+        az = 1.0f + 0.25f * sinf(2 * M_PI * 3.6f * t);
+        gy = 40.0f * sinf(2 * M_PI * 1.8f * t);
+    } else if (phase == 50) {
+        float u = t - (uint32_t)t;
+        az = (u < 0.3f) ? 0.2f : (u < 0.4f ? 4.0f : 1.0f);
+        gx = (u < 0.5f) ? 280.0f : 0.0f;
+    } else if (phase > 50) {
+        ax = 1.0f;
+        az = 0.0f;
+    }
+
+    data.timestamp = (uint32_t)((uint64_t)index * 1000 / rate_hz);
+    data.accel_x = ax + noise(index, 0, 0.01f);
+    data.accel_y = ay + noise(index, 1, 0.01f);
+    data.accel_z = az + noise(index, 2, 0.01f);
+    data.gyro_x = gx + noise(index, 3, 0.5f);
+    data.gyro_y = gy + noise(index, 4, 0.5f);
+    data.gyro_z = gz + noise(index, 5, 0.5f);
+    data.pressure = 1013.25f + noise(index, 6, 0.02f);
+    data.heart_rate = 72.0f + noise(index / rate_hz, 7, 3.0f);
+    data.fsr_value = 2000 + (int)noise(index, 8, 5.0f);
+    data.valid = true;
+    data.accel_range_g = ACCEL_RANGE_LOW_G;   // Peaks near 4 g, well inside the low scale
+    data.accel_peak_g = 0;
+    data.accel_peak_clipped = false;
+    data.gyro_peak_dps = 0;
+}
+
+bool Synthetic_Source::beginSource() {
+    index = 0;
+    return rate_hz > 0;
+}
+
+bool Synthetic_Source::readSample(SensorData_t& data) {
+    if (limit != 0 && index >= limit) {
+        return false;
+    }
+    generate(index++, rate_hz, data);
+    return true;
+}
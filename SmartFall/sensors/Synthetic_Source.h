@@ -0,0 +1,37 @@
+#ifndef SYNTHETIC_SOURCE_H
+#define SYNTHETIC_SOURCE_H
+
+#include <Arduino.h>
+#include "Sample_Source.h"
+#include "../utils/config.h"
+
+/*
+ * Deterministic synthetic sensor stream: a 60 s cycle of rest (0-20 s),
+ * walking (20-50 s), a fall (50 s) and lying still. The same index
+ * always yields the same sample, so expected data can be regenerated
+ * for round-trip checks.
+ */
+class Synthetic_Source : public Sample_Source<Synthetic_Source> {
+    friend class Sample_Source<Synthetic_Source>;
+
+private:
+    uint16_t rate_hz;
+    uint32_t index;
+    uint32_t limit;             // Samples to produce, 0 = endless
+
+public:
+    Synthetic_Source(uint16_t rate_hz = SENSOR_SAMPLE_RATE_HZ, uint32_t limit = 0);
+
+    void seek(uint32_t sample_index) { index = sample_index; }
+    uint32_t getIndex() { return index; }
+
+    // Sample number index of the stream at rate_hz
+    static void generate(uint32_t index, uint16_t rate_hz, SensorData_t& data);
+
+private:
+    bool beginSource();
+    bool readSample(SensorData_t& data);
+    const char* sourceName() { return "synthetic"; }
+};
+
+#endif // SYNTHETIC_SOURCE_H
@@ -0,0 +1,32 @@
+#include "Trace_Source.h"
+
+Trace_Source::Trace_Source(const SensorData_t* trace, uint32_t length, bool repeat)
+    : samples(trace), count(length), loop(repeat), position(0), offset_ms(0), span_ms(0) {
+    if (count > 1) {
+        uint32_t first = samples[0].timestamp;
+        uint32_t last = samples[count - 1].timestamp;
+        span_ms = (last - first) + (last - first) / (count - 1);
+    }
+}
+
+void Trace_Source::rewind() {
+    position = 0;
+    offset_ms = 0;
+}
+
+bool Trace_Source::beginSource() {
+    rewind();
+    return samples != nullptr && count > 0;
+}
+
+bool Trace_Source::readSample(SensorData_t& data) {
+    if (position >= count) {
+        if (!loop || count == 0) return false;
+        position = 0;
+        offset_ms += span_ms;
+    }
+
+    data = samples[position++];
+    data.timestamp += offset_ms;
+    return true;
+}
@@ -0,0 +1,35 @@
+#ifndef TRACE_SOURCE_H
+#define TRACE_SOURCE_H
+
+#include <Arduino.h>
+#include "Sample_Source.h"
+
+// Replays recorded samples, e.g. a log_decode CSV loaded on the host or
+// a capture compiled into a test. Samples are returned as recorded,
+// except that timestamps are shifted so that a looping replay keeps
+// counting forward.
+class Trace_Source : public Sample_Source<Trace_Source> {
+    friend class Sample_Source<Trace_Source>;
+
+private:
+    const SensorData_t* samples;
+    uint32_t count;
+    bool loop;
+    uint32_t position;
+    uint32_t offset_ms;         // Added to recorded timestamps
+    uint32_t span_ms;           // One pass, including the closing sample period
+
+public:
+    Trace_Source(const SensorData_t* samples, uint32_t count, bool loop = false);
+
+    void rewind();
+    uint32_t getPosition() { return position; }
+    uint32_t getCount() { return count; }
+
+private:
+    bool beginSource();
+    bool readSample(SensorData_t& data);
+    const char* sourceName() { return "trace"; }
+};
+
+#endif // TRACE_SOURCE_H
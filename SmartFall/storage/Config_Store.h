@@ -0,0 +1,126 @@
+#ifndef CONFIG_STORE_H
+#define CONFIG_STORE_H
+
+#include <Arduino.h>
+#include "../utils/data_types.h"
+#include "../utils/config.h"
+#include "../detection/score_tiers.h"
+
+/*
+ * Runtime configuration schema (CONFIG_CHARACTERISTIC and NVS).
+ *
+ * Write:  [version u8, (tag u8, length u8, value)...]
+ * Read:   [version u8, last result u8, generation u16, (tag, length, value)...]
+ *
+ * A write may carry any subset of fields; the rest keep their current
+ * values. The whole write is validated before anything is stored or
+ * applied, so a bad field rejects the entire write. Values are fixed
+ * point and little-endian. The WiFi password is write-only. Score tier
+ * tables are sent one per field and only read back where they differ
+ * from DEFAULT_SCORE_TIERS.
+ */
+
+#define CONFIG_SCHEMA_VERSION       1
+
+// Field tags
+#define CONFIG_TAG_FREEFALL_MG      0x01  // u16, milli-g
+#define CONFIG_TAG_IMPACT_MG        0x02  // u16, milli-g
+#define CONFIG_TAG_ROTATION_DPS     0x03  // u16, deg/s
+#define CONFIG_TAG_INACTIVITY_MS    0x04  // u32, ms
+#define CONFIG_TAG_PRESSURE_CM      0x05  // u16, cm of altitude change
+#define CONFIG_TAG_SCORE_TIERS      0x06  // u8 metric, then (u32 breakpoint x1000, u8 points) x 0-4
+#define CONFIG_TAG_ALERT_VOLUME     0x10  // u8, 0-100
+#define CONFIG_TAG_HAPTIC           0x11  // u8, 0-100
+#define CONFIG_TAG_VISUAL_ALERTS    0x12  // u8, 0/1
+#define CONFIG_TAG_WIFI_SSID        0x20  // 1-31 chars
+#define CONFIG_TAG_WIFI_PASSWORD    0x21  // 0-63 chars, write-only
+
+// Write results (second byte of the read value)
+#define CONFIG_OK                   0x00
+#define CONFIG_ERR_VERSION          0x01  // Schema newer than the firmware
+#define CONFIG_ERR_FORMAT           0x02  // Truncated field or wrong length
+#define CONFIG_ERR_UNKNOWN_TAG      0x03
+#define CONFIG_ERR_RANGE            0x04  // Value out of range
+#define CONFIG_ERR_STORAGE          0x05  // NVS write failed, nothing applied
+#define CONFIG_ERR_BUSY             0x06  // Previous write not yet applied
+
+// Groups passed to the apply callback
+#define CONFIG_CHANGED_THRESHOLDS   0x01
+#define CONFIG_CHANGED_VOLUME       0x02
+#define CONFIG_CHANGED_ALERTS       0x04  // Haptic / visual
+#define CONFIG_CHANGED_WIFI         0x08
+#define CONFIG_CHANGED_SCORING      0x10
+
+#define CONFIG_MAX_SIZE             384   // Largest encoded config (all fields, every tier table overridden)
+#define CONFIG_NVS_NAMESPACE        "smartfall"
+#define CONFIG_NVS_KEY              "config"
+
+// Key-value backend (NVS on the device, in-memory on the host)
+class Config_Storage {
+public:
+    virtual ~Config_Storage() {}
+    virtual bool load(const char* key, uint8_t* buffer, size_t& length) = 0;   // length: in capacity, out size
+    virtual bool store(const char* key, const uint8_t* data, size_t length) = 0;
+};
+
+#ifdef ARDUINO
+// NVS blob via Preferences; a set + commit replaces the blob atomically
+class NVS_Config_Storage : public Config_Storage {
+public:
+    bool load(const char* key, uint8_t* buffer, size_t& length) override;
+    bool store(const char* key, const uint8_t* data, size_t length) override;
+};
+#endif
+
+typedef void (*ConfigApplyFn_t)(const Config_t& config, uint8_t changed);
+
+class Config_Store {
+private:
+    Config_Storage* storage;
+    Config_t config;
+    ConfigApplyFn_t apply_callback;
+    uint16_t generation;          // Incremented on every applied write
+    uint8_t last_result;
+
+    // Write mailbox (filled from the BLE task, consumed in service())
+    uint8_t request[CONFIG_MAX_SIZE];
+    volatile uint16_t request_length;
+    volatile bool request_pending;
+
+#ifdef ARDUINO
+    portMUX_TYPE request_mux;
+#endif
+
+public:
+    Config_Store(Config_Storage* backend);
+
+    // Loads the stored config, falling back to config.h defaults
+    bool begin();
+    const Config_t& get() { return config; }
+    void onApply(ConfigApplyFn_t callback);
+
+    // Queues a write from a transport callback
+    bool submit(const uint8_t* data, size_t length);
+
+    // Called from the main loop between samples: validates, stores and
+    // applies the pending write. Returns true if a write was processed.
+    bool service();
+
+    // Validates, stores and applies a write immediately
+    uint8_t applyWrite(const uint8_t* data, size_t length);
+    bool resetToDefaults();
+
+    size_t encodeForRead(uint8_t* buffer, size_t size);
+    uint8_t getLastResult() { return last_result; }
+    uint16_t getGeneration() { return generation; }
+    void printConfig();
+
+    // Schema
+    static void defaults(Config_t& config);
+    static uint8_t decode(const uint8_t* data, size_t length, Config_t& config, bool strict);
+    static uint8_t validate(const Config_t& config);
+    static size_t encode(const Config_t& config, uint8_t* buffer, size_t size, bool include_secret);
+    static uint8_t diff(const Config_t& before, const Config_t& after);
+};
+
+#endif // CONFIG_STORE_H
@@ -0,0 +1,459 @@
+#include "Data_Logger.h"
+
+Data_Logger::Data_Logger(Flash_Storage* flash)
+    : storage(flash), initialized(false), recording(false), sample_rate_hz(SENSOR_SAMPLE_RATE_HZ),
+      sector_count(0), head_sector(0), block_count(0), next_sequence(1), active(0),
+      pending_job(LOG_JOB_NONE), job_seals_block(false) {
+    memset(&stats, 0, sizeof(stats));
+    for (uint8_t i = 0; i < LOG_BUFFER_COUNT; i++) {
+        sealed[i] = false;
+        sealed_sequence[i] = 0;
+    }
+#ifdef ARDUINO
+    flush_task = nullptr;
+    storage_mutex = nullptr;
+    buffer_mux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+}
+
+bool Data_Logger::begin(uint16_t rate_hz) {
+    if (storage == nullptr) {
+        Serial.println("[Logger] ERROR: No flash storage!");
+        return false;
+    }
+
+    if (storage->getSectorSize() != LOG_BLOCK_SIZE) {
+        Serial.println("[Logger] ERROR: Flash sector size does not match block size!");
+        return false;
+    }
+
+    sample_rate_hz = rate_hz;
+    sector_count = storage->getSize() / LOG_BLOCK_SIZE;
+    if (sector_count < 2) {
+        Serial.println("[Logger] ERROR: Partition too small!");
+        return false;
+    }
+
+#ifdef ARDUINO
+    storage_mutex = xSemaphoreCreateMutex();
+    if (storage_mutex == nullptr) {
+        Serial.println("[Logger] ERROR: Failed to create mutex!");
+        return false;
+    }
+
+    // Same priority as loop(), which blocks between scheduler ticks
+    if (xTaskCreate(flushTaskEntry, "logger", DATA_LOGGER_TASK_STACK, this,
+                    DATA_LOGGER_TASK_PRIORITY, &flush_task) != pdPASS) {
+        Serial.println("[Logger] ERROR: Failed to create flush task!");
+        return false;
+    }
+#endif
+
+    recoverRing();
+    initialized = true;
+
+    Serial.print("[Logger] Ring: ");
+    Serial.print(block_count);
+    Serial.print("/");
+    Serial.print(sector_count);
+    Serial.print(" blocks, next sequence ");
+    Serial.println(next_sequence);
+    return true;
+}
+
+void Data_Logger::start() {
+    if (!initialized || recording) return;
+    if (pending_job != LOG_JOB_NONE) {
+        // A dump uses the block buffers as scratch
+        Serial.println("[Logger] ✗ Busy with a dump or erase, not started");
+        return;
+    }
+
+    encoders[active].begin(buffers[active]);
+    recording = true;
+    Serial.println("[Logger] Recording started");
+}
+
+void Data_Logger::stop() {
+    if (!recording) return;
+    recording = false;
+    finishRecording();
+}
+
+void Data_Logger::finishRecording() {
+    // Wait for the other buffer so the partial block can be sealed
+    if (!encoders[active].isEmpty()) {
+        while (!sealActive()) {
+            waitForFlush();
+        }
+    }
+
+    // Drain both buffers before returning
+    for (uint8_t i = 0; i < LOG_BUFFER_COUNT; i++) {
+        while (sealed[i]) {
+            waitForFlush();
+        }
+    }
+
+    Serial.print("[Logger] Recording stopped, ");
+    Serial.print(stats.samples_logged);
+    Serial.print(" samples, ");
+    Serial.print(stats.samples_dropped);
+    Serial.println(" dropped");
+}
+
+bool Data_Logger::log(const SensorData_t& data) {
+    if (!recording) return false;
+
+    LogSample_t sample;
+    toLogSample(data, sample);
+    return logSample(sample);
+}
+
+bool Data_Logger::logSample(const LogSample_t& sample) {
+    if (!recording) return false;
+
+    if (!encoders[active].add(sample)) {
+        // Block full: hand it to the flush task and continue in the other buffer
+        if (!sealActive()) {
+            stats.samples_dropped++;
+            return false;
+        }
+        encoders[active].add(sample);
+    }
+
+    stats.samples_logged++;
+    return true;
+}
+
+bool Data_Logger::serviceFlush() {
+    // Oldest sealed buffer first
+    int8_t index = -1;
+    for (uint8_t i = 0; i < LOG_BUFFER_COUNT; i++) {
+        if (sealed[i] && (index < 0 || sealed_sequence[i] < sealed_sequence[index])) {
+            index = i;
+        }
+    }
+    if (index < 0) return false;
+
+    uint8_t* block = buffers[index];
+    uint32_t payload = encoders[index].getPayloadBytes();
+    encoders[index].finish(sealed_sequence[index], sample_rate_hz);
+
+    uint32_t start = micros();
+    lockStorage();
+
+    // Erase suspends the flash cache on both cores; the scheduler counts any
+    // sensor periods lost to it as skipped
+    uint32_t offset = head_sector * LOG_BLOCK_SIZE;
+    bool ok = storage->eraseSector(head_sector) &&
+              storage->write(offset, block, LOG_BLOCK_SIZE);
+
+    if (ok) {
+        head_sector = (head_sector + 1) % sector_count;
+        if (block_count < sector_count) block_count++;
+        stats.blocks_written++;
+        stats.encoded_bytes += payload;
+    } else {
+        stats.flash_errors++;
+    }
+
+    unlockStorage();
+    uint32_t elapsed = micros() - start;
+    if (elapsed > stats.max_flush_us) stats.max_flush_us = elapsed;
+
+#ifdef ARDUINO
+    portENTER_CRITICAL(&buffer_mux);
+#endif
+    sealed[index] = false;
+#ifdef ARDUINO
+    portEXIT_CRITICAL(&buffer_mux);
+#endif
+
+    return true;
+}
+
+uint32_t Data_Logger::getBlockCount() {
+    return block_count;
+}
+
+bool Data_Logger::readBlock(uint32_t index, uint8_t* buffer) {
+    if (!initialized || buffer == nullptr) return false;
+
+    lockStorage();
+    bool ok = false;
+    if (index < block_count) {
+        uint32_t sector = (head_sector + sector_count - block_count + index) % sector_count;
+        ok = storage->read(sector * LOG_BLOCK_SIZE, buffer, LOG_BLOCK_SIZE);
+    }
+    unlockStorage();
+
+    return ok;
+}
+
+bool Data_Logger::readBytes(uint32_t offset, uint8_t* buffer, size_t length) {
+    if (!initialized || buffer == nullptr) return false;
+
+    lockStorage();
+    bool ok = (uint64_t)offset + length <= (uint64_t)block_count * LOG_BLOCK_SIZE;
+    uint32_t oldest = (head_sector + sector_count - block_count) % sector_count;
+
+    // Split at block boundaries, which are not contiguous once the ring wraps
+    while (ok && length > 0) {
+        uint32_t index = offset / LOG_BLOCK_SIZE;
+        uint32_t within = offset % LOG_BLOCK_SIZE;
+        size_t part = LOG_BLOCK_SIZE - within;
+        if (part > length) part = length;
+
+        uint32_t sector = (oldest + index) % sector_count;
+        ok = storage->read(sector * LOG_BLOCK_SIZE + within, buffer, part);
+
+        offset += part;
+        buffer += part;
+        length -= part;
+    }
+    unlockStorage();
+
+    return ok;
+}
+
+void Data_Logger::dumpToSerial() {
+    if (!initialized) return;
+    stop();
+
+    // Raw blocks back to back; the host decoder locates them by magic + CRC
+    uint8_t* scratch = buffers[0];
+    uint32_t count = getBlockCount();
+    for (uint32_t i = 0; i < count; i++) {
+        if (readBlock(i, scratch)) {
+            Serial.write(scratch, LOG_BLOCK_SIZE);
+        }
+    }
+    Serial.flush();
+}
+
+bool Data_Logger::eraseAll() {
+    if (!initialized) return false;
+    stop();
+
+    lockStorage();
+    bool ok = true;
+    uint8_t magic[4];
+    for (uint32_t sector = 0; sector < sector_count; sector++) {
+        // Skip sectors that are already erased
+        if (!storage->read(sector * LOG_BLOCK_SIZE, magic, sizeof(magic))) {
+            ok = false;
+            continue;
+        }
+        if (magic[0] == 0xFF && magic[1] == 0xFF && magic[2] == 0xFF && magic[3] == 0xFF) {
+            continue;
+        }
+        if (!storage->eraseSector(sector)) ok = false;
+    }
+    head_sector = 0;
+    block_count = 0;
+    unlockStorage();
+
+    Serial.println(ok ? "[Logger] ✓ Log erased" : "[Logger] ✗ Log erase failed");
+    return ok;
+}
+
+bool Data_Logger::requestStop() {
+    // Not recording: already stopped, or a pending job seals the block
+    if (!recording) return true;
+    return requestJob(LOG_JOB_STOP);
+}
+
+bool Data_Logger::requestDump() {
+    return requestJob(LOG_JOB_DUMP);
+}
+
+bool Data_Logger::requestErase() {
+    return requestJob(LOG_JOB_ERASE);
+}
+
+bool Data_Logger::serviceJob() {
+    LogJob_t job = pending_job;
+    if (job == LOG_JOB_NONE) return false;
+
+    // log() stopped with the request; the partial block is flushed here
+    if (job_seals_block) {
+        job_seals_block = false;
+        finishRecording();
+    }
+
+    if (job == LOG_JOB_DUMP) {
+        dumpToSerial();
+    } else if (job == LOG_JOB_ERASE) {
+        eraseAll();
+    }
+    pending_job = LOG_JOB_NONE;
+    return true;
+}
+
+void Data_Logger::printStatus() {
+    Serial.println("=== Data Logger ===");
+    Serial.print("Recording: ");
+    Serial.println(recording ? "Yes" : "No");
+    Serial.print("Blocks: ");
+    Serial.print(block_count);
+    Serial.print("/");
+    Serial.println(sector_count);
+    Serial.print("Samples: ");
+    Serial.print(stats.samples_logged);
+    Serial.print(" | Dropped: ");
+    Serial.println(stats.samples_dropped);
+    if (stats.samples_logged > 0) {
+        Serial.print("Bytes/sample: ");
+        Serial.println((float)stats.encoded_bytes / stats.samples_logged, 2);
+    }
+    Serial.print("Max flush: ");
+    Serial.print(stats.max_flush_us);
+    Serial.print(" us | Flash errors: ");
+    Serial.println(stats.flash_errors);
+    Serial.println("===================");
+}
+
+void Data_Logger::toLogSample(const SensorData_t& data, LogSample_t& sample) {
+    // Timestamp stays integral; floats lose ms resolution after ~4.6 hours
+    sample.values[LOG_FIELD_TIMESTAMP] = (int32_t)data.timestamp;
+    sample.values[LOG_FIELD_ACCEL_X] = logQuantize(LOG_FIELD_ACCEL_X, data.accel_x);
+    sample.values[LOG_FIELD_ACCEL_Y] = logQuantize(LOG_FIELD_ACCEL_Y, data.accel_y);
+    sample.values[LOG_FIELD_ACCEL_Z] = logQuantize(LOG_FIELD_ACCEL_Z, data.accel_z);
+    sample.values[LOG_FIELD_GYRO_X] = logQuantize(LOG_FIELD_GYRO_X, data.gyro_x);
+    sample.values[LOG_FIELD_GYRO_Y] = logQuantize(LOG_FIELD_GYRO_Y, data.gyro_y);
+    sample.values[LOG_FIELD_GYRO_Z] = logQuantize(LOG_FIELD_GYRO_Z, data.gyro_z);
+    sample.values[LOG_FIELD_PRESSURE] = logQuantize(LOG_FIELD_PRESSURE, data.pressure);
+    sample.values[LOG_FIELD_HEART_RATE] = logQuantize(LOG_FIELD_HEART_RATE, data.heart_rate);
+    sample.values[LOG_FIELD_FSR] = data.fsr_value;
+}
+
+// Private helper functions
+
+void Data_Logger::recoverRing() {
+    LogBlockHeader_t header;
+    uint8_t raw[LOG_BLOCK_HEADER_SIZE];
+    bool found = false;
+    uint32_t newest_sector = 0;
+    uint32_t newest_sequence = 0;
+
+    // Newest block = highest sequence number
+    for (uint32_t sector = 0; sector < sector_count; sector++) {
+        if (!storage->read(sector * LOG_BLOCK_SIZE, raw, sizeof(raw))) continue;
+        if (!readBlockHeader(raw, header)) continue;
+
+        if (!found || header.sequence > newest_sequence) {
+            found = true;
+            newest_sequence = header.sequence;
+            newest_sector = sector;
+        }
+    }
+
+    if (!found) {
+        head_sector = 0;
+        block_count = 0;
+        return;
+    }
+
+    head_sector = (newest_sector + 1) % sector_count;
+    next_sequence = newest_sequence + 1;
+
+    // Walk backwards while the sequence stays contiguous
+    block_count = 0;
+    uint32_t sector = newest_sector;
+    while (block_count < sector_count) {
+        if (!storage->read(sector * LOG_BLOCK_SIZE, raw, sizeof(raw))) break;
+        if (!readBlockHeader(raw, header)) break;
+        if (header.sequence != newest_sequence - block_count) break;
+
+        block_count++;
+        sector = (sector + sector_count - 1) % sector_count;
+    }
+}
+
+bool Data_Logger::sealActive() {
+    uint8_t next = (active + 1) % LOG_BUFFER_COUNT;
+    bool sealed_ok = false;
+
+#ifdef ARDUINO
+    portENTER_CRITICAL(&buffer_mux);
+#endif
+    if (!sealed[next]) {
+        sealed_sequence[active] = next_sequence++;
+        sealed[active] = true;
+        sealed_ok = true;
+    }
+#ifdef ARDUINO
+    portEXIT_CRITICAL(&buffer_mux);
+#endif
+
+    if (!sealed_ok) return false;
+
+    active = next;
+    encoders[active].begin(buffers[active]);
+
+#ifdef ARDUINO
+    if (flush_task != nullptr) {
+        xTaskNotifyGive(flush_task);
+    }
+#endif
+    return true;
+}
+
+bool Data_Logger::requestJob(LogJob_t job) {
+    if (!initialized || pending_job != LOG_JOB_NONE) return false;
+
+    // Stopped on the caller's task, so log() cannot race the job's seal
+    job_seals_block = recording;
+    recording = false;
+    pending_job = job;
+
+#ifdef ARDUINO
+    if (flush_task != nullptr) {
+        xTaskNotifyGive(flush_task);
+    }
+#else
+    serviceJob();
+#endif
+    return true;
+}
+
+// Waiting for a buffer on the flush task itself would never end
+void Data_Logger::waitForFlush() {
+#ifdef ARDUINO
+    if (xTaskGetCurrentTaskHandle() != flush_task) {
+        delay(5);
+        return;
+    }
+#endif
+    serviceFlush();
+}
+
+void Data_Logger::lockStorage() {
+#ifdef ARDUINO
+    if (storage_mutex != nullptr) {
+        xSemaphoreTake(storage_mutex, portMAX_DELAY);
+    }
+#endif
+}
+
+void Data_Logger::unlockStorage() {
+#ifdef ARDUINO
+    if (storage_mutex != nullptr) {
+        xSemaphoreGive(storage_mutex);
+    }
+#endif
+}
+
+#ifdef ARDUINO
+void Data_Logger::flushTaskEntry(void* arg) {
+    Data_Logger* logger = (Data_Logger*)arg;
+
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        while (logger->serviceFlush()) {
+        }
+        logger->serviceJob();
+    }
+}
+#endif
@@ -0,0 +1,127 @@
+#ifndef DATA_LOGGER_H
+#define DATA_LOGGER_H
+
+#include <Arduino.h>
+#include "Flash_Storage.h"
+#include "Sample_Codec.h"
+#include "../utils/data_types.h"
+#include "../utils/config.h"
+
+#define LOG_BUFFER_COUNT  2
+
+// Long-running maintenance, run on the flush task
+typedef enum {
+    LOG_JOB_NONE,
+    LOG_JOB_STOP,                  // Seal and flush the partial block only
+    LOG_JOB_DUMP,
+    LOG_JOB_ERASE
+} LogJob_t;
+
+typedef struct {
+    uint32_t samples_logged;
+    uint32_t samples_dropped;      // Both buffers busy when a block filled
+    uint32_t blocks_written;
+    uint32_t flash_errors;
+    uint32_t encoded_bytes;        // Payload bytes written
+    uint32_t max_flush_us;         // Worst erase + write time
+} LoggerStats_t;
+
+/*
+ * Continuous raw sensor recorder.
+ *
+ * log() quantizes a sample and appends it to the active RAM block; it
+ * never touches flash. When the block fills, it is handed to a
+ * background task that erases the next sector of the ring and writes it,
+ * while acquisition continues into the second buffer. The ring wraps
+ * sequentially over the whole partition, so every sector sees the same
+ * erase count. Blocks carry a sequence number and CRC, so the ring is
+ * recovered after reboot and torn writes are skipped.
+ *
+ * Dumping or erasing the ring takes seconds to minutes, so the loop task
+ * only requests them; the flush task runs the job between flushes.
+ * Stopping waits for a flush, so it goes through the same path.
+ */
+class Data_Logger {
+private:
+    Flash_Storage* storage;
+    bool initialized;
+    bool recording;
+    uint16_t sample_rate_hz;
+
+    // Ring state
+    uint32_t sector_count;
+    uint32_t head_sector;          // Next sector to be written
+    uint32_t block_count;          // Valid blocks in the ring
+    uint32_t next_sequence;
+
+    // Double buffering
+    uint8_t buffers[LOG_BUFFER_COUNT][LOG_BLOCK_SIZE];
+    Block_Encoder encoders[LOG_BUFFER_COUNT];
+    volatile bool sealed[LOG_BUFFER_COUNT];     // Full, waiting for the flush task
+    uint32_t sealed_sequence[LOG_BUFFER_COUNT];
+    uint8_t active;
+
+    LoggerStats_t stats;
+
+    volatile LogJob_t pending_job;
+    bool job_seals_block;          // Recording was stopped by the request
+
+#ifdef ARDUINO
+    TaskHandle_t flush_task;
+    SemaphoreHandle_t storage_mutex;
+    portMUX_TYPE buffer_mux;
+#endif
+
+public:
+    Data_Logger(Flash_Storage* flash);
+
+    bool begin(uint16_t rate_hz = SENSOR_SAMPLE_RATE_HZ);
+
+    // Recording
+    void start();
+    void stop();                                // Seals and flushes the partial block; blocking
+    bool log(const SensorData_t& data);         // Non-blocking, called at sample rate
+    bool logSample(const LogSample_t& sample);
+    bool isRecording() { return recording; }
+
+    // Background flush (runs in the flush task on the device)
+    bool serviceFlush();
+
+    // Bulk download, oldest block first
+    uint32_t getBlockCount();
+    bool readBlock(uint32_t index, uint8_t* buffer);
+    bool readBytes(uint32_t offset, uint8_t* buffer, size_t length);  // Ring as one byte stream
+    void dumpToSerial();                        // Blocking: minutes for a full ring
+    bool eraseAll();                            // Blocking: seconds
+
+    // Same, from the flush task; return at once (false if a job is running)
+    bool requestStop();                         // Block sealed once isJobPending() clears
+    bool requestDump();
+    bool requestErase();
+    bool serviceJob();
+    bool isJobPending() { return pending_job != LOG_JOB_NONE; }
+
+    // Status
+    const LoggerStats_t& getStats() { return stats; }
+    uint32_t getCapacityBlocks() { return sector_count; }
+#ifdef ARDUINO
+    TaskHandle_t getTaskHandle() { return flush_task; }
+#endif
+    void printStatus();
+
+    static void toLogSample(const SensorData_t& data, LogSample_t& sample);
+
+private:
+    void recoverRing();
+    bool sealActive();
+    bool requestJob(LogJob_t job);
+    void finishRecording();
+    void waitForFlush();
+    void lockStorage();
+    void unlockStorage();
+#ifdef ARDUINO
+    static void flushTaskEntry(void* arg);
+#endif
+};
+
+#endif // DATA_LOGGER_H
@@ -0,0 +1,50 @@
+#include "Flash_Storage.h"
+
+#ifdef ARDUINO
+
+Partition_Storage::Partition_Storage() : partition(nullptr) {
+}
+
+bool Partition_Storage::begin(const char* label) {
+    partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+    if (partition == nullptr) {
+        Serial.print("[Storage] ERROR: Partition not found: ");
+        Serial.println(label);
+        return false;
+    }
+
+    Serial.print("[Storage] Using partition '");
+    Serial.print(label);
+    Serial.print("' at 0x");
+    Serial.print(partition->address, HEX);
+    Serial.print(", ");
+    Serial.print(partition->size / 1024);
+    Serial.println(" KB");
+    return true;
+}
+
+bool Partition_Storage::read(uint32_t offset, uint8_t* buffer, size_t length) {
+    if (partition == nullptr) return false;
+    return esp_partition_read(partition, offset, buffer, length) == ESP_OK;
+}
+
+bool Partition_Storage::write(uint32_t offset, const uint8_t* data, size_t length) {
+    if (partition == nullptr) return false;
+    return esp_partition_write(partition, offset, data, length) == ESP_OK;
+}
+
+bool Partition_Storage::eraseSector(uint32_t sector) {
+    if (partition == nullptr) return false;
+    uint32_t sector_size = getSectorSize();
+    return esp_partition_erase_range(partition, sector * sector_size, sector_size) == ESP_OK;
+}
+
+uint32_t Partition_Storage::getSize() {
+    return partition ? partition->size : 0;
+}
+
+uint32_t Partition_Storage::getSectorSize() {
+    return 4096;  // SPI flash erase unit
+}
+
+#endif
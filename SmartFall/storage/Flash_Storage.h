@@ -0,0 +1,47 @@
+#ifndef FLASH_STORAGE_H
+#define FLASH_STORAGE_H
+
+#include <Arduino.h>
+
+#ifdef ARDUINO
+#include <esp_partition.h>
+#endif
+
+/*
+ * Raw NOR flash region used by the data logger. Writes can only clear
+ * bits, so a sector must be erased (to 0xFF) before it is rewritten.
+ * Partition_Storage maps the ESP32 "spiffs" data partition; the host
+ * tools provide a file-backed emulator with the same semantics.
+ */
+class Flash_Storage {
+public:
+    virtual ~Flash_Storage() {}
+
+    virtual bool read(uint32_t offset, uint8_t* buffer, size_t length) = 0;
+    virtual bool write(uint32_t offset, const uint8_t* data, size_t length) = 0;
+    virtual bool eraseSector(uint32_t sector) = 0;
+
+    virtual uint32_t getSize() = 0;
+    virtual uint32_t getSectorSize() = 0;
+};
+
+#ifdef ARDUINO
+class Partition_Storage : public Flash_Storage {
+private:
+    const esp_partition_t* partition;
+
+public:
+    Partition_Storage();
+
+    bool begin(const char* label);
+
+    bool read(uint32_t offset, uint8_t* buffer, size_t length) override;
+    bool write(uint32_t offset, const uint8_t* data, size_t length) override;
+    bool eraseSector(uint32_t sector) override;
+
+    uint32_t getSize() override;
+    uint32_t getSectorSize() override;
+};
+#endif
+
+#endif // FLASH_STORAGE_H
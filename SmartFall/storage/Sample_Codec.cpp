@@ -0,0 +1,157 @@
+#include "Sample_Codec.h"
+#include <string.h>
+#include <math.h>
+
+// Stored units per physical unit, indexed by LogField_t
+static const float field_scale[LOG_FIELD_COUNT] = {
+    1.0f,                       // timestamp (ms)
+    1000.0f, 1000.0f, 1000.0f,  // accel (g -> milli-g)
+    10.0f, 10.0f, 10.0f,        // gyro (deg/s -> 0.1 deg/s)
+    1000.0f,                    // pressure (hPa -> 0.1 Pa)
+    10.0f,                      // heart rate (BPM -> 0.1 BPM)
+    1.0f                        // FSR (counts)
+};
+
+Block_Encoder::Block_Encoder()
+    : block(nullptr), position(LOG_BLOCK_HEADER_SIZE), sample_count(0), first_timestamp(0) {
+    memset(&previous, 0, sizeof(previous));
+}
+
+void Block_Encoder::begin(uint8_t* block_buffer) {
+    block = block_buffer;
+    position = LOG_BLOCK_HEADER_SIZE;
+    sample_count = 0;
+    first_timestamp = 0;
+    memset(&previous, 0, sizeof(previous));
+}
+
+bool Block_Encoder::add(const LogSample_t& sample) {
+    if (block == nullptr || sample_count == 0xFFFF) return false;
+    if (position + LOG_MAX_SAMPLE_BYTES > LOG_BLOCK_SIZE) return false;
+
+    // First sample absolute (previous is zero), later samples as deltas
+    for (uint8_t i = 0; i < LOG_FIELD_COUNT; i++) {
+        int32_t delta = (int32_t)((uint32_t)sample.values[i] - (uint32_t)previous.values[i]);
+        position += writeVarint(block + position, zigzagEncode(delta));
+    }
+
+    if (sample_count == 0) {
+        first_timestamp = (uint32_t)sample.values[LOG_FIELD_TIMESTAMP];
+    }
+
+    previous = sample;
+    sample_count++;
+    return true;
+}
+
+size_t Block_Encoder::finish(uint32_t sequence, uint16_t sample_rate_hz) {
+    if (block == nullptr) return 0;
+
+    // Unused tail stays at the erased-flash value
+    memset(block + position, 0xFF, LOG_BLOCK_SIZE - position);
+
+    LogBlockHeader_t header;
+    header.magic = LOG_BLOCK_MAGIC;
+    header.version = LOG_BLOCK_VERSION;
+    header.sample_count = sample_count;
+    header.sequence = sequence;
+    header.first_timestamp = first_timestamp;
+    header.payload_bytes = (uint16_t)(position - LOG_BLOCK_HEADER_SIZE);
+    header.sample_rate_hz = sample_rate_hz;
+    header.crc32 = 0;
+
+    memcpy(block, &header, sizeof(header));
+    header.crc32 = logCrc32(block, position);
+    memcpy(block, &header, sizeof(header));
+
+    return LOG_BLOCK_SIZE;
+}
+
+int32_t logQuantize(uint8_t field, float value) {
+    if (field >= LOG_FIELD_COUNT || isnan(value)) return 0;
+    float scaled = value * field_scale[field];
+    if (scaled > 2147483520.0f) return INT32_MAX;
+    if (scaled < -2147483520.0f) return INT32_MIN;
+    return (int32_t)lroundf(scaled);
+}
+
+float logDequantize(uint8_t field, int32_t value) {
+    if (field >= LOG_FIELD_COUNT) return 0.0f;
+    return value / field_scale[field];
+}
+
+bool readBlockHeader(const uint8_t* block, LogBlockHeader_t& header) {
+    memcpy(&header, block, sizeof(header));
+    return header.magic == LOG_BLOCK_MAGIC &&
+           header.version == LOG_BLOCK_VERSION &&
+           header.payload_bytes <= LOG_BLOCK_PAYLOAD_SIZE;
+}
+
+bool validateBlock(const uint8_t* block, LogBlockHeader_t& header) {
+    if (!readBlockHeader(block, header)) return false;
+
+    // CRC is computed with the crc32 field zeroed
+    LogBlockHeader_t zeroed = header;
+    zeroed.crc32 = 0;
+    uint32_t crc = logCrc32((const uint8_t*)&zeroed, sizeof(zeroed));
+    crc = logCrc32(block + LOG_BLOCK_HEADER_SIZE, header.payload_bytes, crc);
+
+    return crc == header.crc32;
+}
+
+uint16_t decodeBlock(const uint8_t* block, LogSample_t* samples, uint16_t max_samples) {
+    LogBlockHeader_t header;
+    if (!validateBlock(block, header)) return 0;
+
+    const uint8_t* payload = block + LOG_BLOCK_HEADER_SIZE;
+    size_t position = 0;
+    LogSample_t current;
+    memset(&current, 0, sizeof(current));
+
+    uint16_t decoded = 0;
+    while (decoded < header.sample_count && decoded < max_samples) {
+        for (uint8_t i = 0; i < LOG_FIELD_COUNT; i++) {
+            uint32_t raw;
+            size_t used = readVarint(payload + position, header.payload_bytes - position, raw);
+            if (used == 0) return decoded;
+            position += used;
+            current.values[i] = (int32_t)((uint32_t)current.values[i] + (uint32_t)zigzagDecode(raw));
+        }
+        samples[decoded++] = current;
+    }
+
+    return decoded;
+}
+
+uint32_t logCrc32(const uint8_t* data, size_t length, uint32_t crc) {
+    // CRC-32 (IEEE 802.3), bitwise to avoid a 1 KB table
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320UL & -(crc & 1));
+        }
+    }
+    return ~crc;
+}
+
+size_t writeVarint(uint8_t* out, uint32_t value) {
+    size_t length = 0;
+    while (value >= 0x80) {
+        out[length++] = (uint8_t)(value | 0x80);
+        value >>= 7;
+    }
+    out[length++] = (uint8_t)value;
+    return length;
+}
+
+size_t readVarint(const uint8_t* in, size_t available, uint32_t& value) {
+    value = 0;
+    for (size_t i = 0; i < available && i < LOG_MAX_VARINT_BYTES; i++) {
+        value |= (uint32_t)(in[i] & 0x7F) << (7 * i);
+        if ((in[i] & 0x80) == 0) {
+            return i + 1;
+        }
+    }
+    return 0;  // Truncated or overlong
+}
@@ -0,0 +1,103 @@
+#ifndef SAMPLE_CODEC_H
+#define SAMPLE_CODEC_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Compressed sample block format shared by the on-device Data_Logger and
+ * the host decoder (tools/log_tool). Kept free of Arduino dependencies.
+ *
+ * A block is one flash sector: a 24-byte header followed by samples.
+ * The first sample is stored absolute, every later sample as per-field
+ * deltas from its predecessor; each value is zigzag + LEB128 varint
+ * coded, so a quiet 100 Hz stream costs about one byte per field.
+ */
+
+#define LOG_BLOCK_SIZE         4096          // Must equal the flash sector size
+#define LOG_BLOCK_MAGIC        0x474C4653UL  // "SFLG"
+#define LOG_BLOCK_VERSION      1
+#define LOG_MAX_VARINT_BYTES   5
+
+// Quantized sample fields, in encoding order
+typedef enum {
+    LOG_FIELD_TIMESTAMP,     // ms
+    LOG_FIELD_ACCEL_X,       // milli-g
+    LOG_FIELD_ACCEL_Y,
+    LOG_FIELD_ACCEL_Z,
+    LOG_FIELD_GYRO_X,        // 0.1 deg/s
+    LOG_FIELD_GYRO_Y,
+    LOG_FIELD_GYRO_Z,
+    LOG_FIELD_PRESSURE,      // 0.1 Pa
+    LOG_FIELD_HEART_RATE,    // 0.1 BPM
+    LOG_FIELD_FSR,           // ADC counts
+    LOG_FIELD_COUNT
+} LogField_t;
+
+#define LOG_MAX_SAMPLE_BYTES   (LOG_FIELD_COUNT * LOG_MAX_VARINT_BYTES)
+
+typedef struct {
+    int32_t values[LOG_FIELD_COUNT];
+} LogSample_t;
+
+// Block header (little-endian, no padding)
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t sample_count;
+    uint32_t sequence;          // Monotonic across the ring, survives reboot
+    uint32_t first_timestamp;   // ms, for indexing without decoding
+    uint16_t payload_bytes;
+    uint16_t sample_rate_hz;
+    uint32_t crc32;             // Over header (crc32 = 0) + payload
+} LogBlockHeader_t;
+
+#define LOG_BLOCK_HEADER_SIZE  24
+#define LOG_BLOCK_PAYLOAD_SIZE (LOG_BLOCK_SIZE - LOG_BLOCK_HEADER_SIZE)
+
+static_assert(sizeof(LogBlockHeader_t) == LOG_BLOCK_HEADER_SIZE, "Log block header must be packed");
+
+// Fills one block buffer sample by sample
+class Block_Encoder {
+private:
+    uint8_t* block;
+    size_t position;
+    uint16_t sample_count;
+    uint32_t first_timestamp;
+    LogSample_t previous;
+
+public:
+    Block_Encoder();
+
+    void begin(uint8_t* block_buffer);
+    bool add(const LogSample_t& sample);     // False if the block is full
+    size_t finish(uint32_t sequence, uint16_t sample_rate_hz);
+
+    uint16_t getSampleCount() const { return sample_count; }
+    size_t getPayloadBytes() const { return position - LOG_BLOCK_HEADER_SIZE; }
+    bool isEmpty() const { return sample_count == 0; }
+};
+
+// Quantization between physical units and stored integers
+int32_t logQuantize(uint8_t field, float value);
+float logDequantize(uint8_t field, int32_t value);
+
+// Block inspection and decoding
+bool readBlockHeader(const uint8_t* block, LogBlockHeader_t& header);
+bool validateBlock(const uint8_t* block, LogBlockHeader_t& header);
+uint16_t decodeBlock(const uint8_t* block, LogSample_t* samples, uint16_t max_samples);
+
+// Primitives
+uint32_t logCrc32(const uint8_t* data, size_t length, uint32_t crc = 0);
+size_t writeVarint(uint8_t* out, uint32_t value);
+size_t readVarint(const uint8_t* in, size_t available, uint32_t& value);
+
+inline uint32_t zigzagEncode(int32_t value) {
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+inline int32_t zigzagDecode(uint32_t value) {
+    return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+#endif // SAMPLE_CODEC_H
@@ -0,0 +1,260 @@
+#include "Alert_Sequencer.h"
+
+#define COUNTDOWN_MS           ((uint32_t)COUNTDOWN_DURATION_S * 1000)
+#define MOTION_MAX_STEP_MS     100    // One sample never counts for more than this
+
+uint32_t alertMillis() {
+    return (uint32_t)millis();
+}
+
+Alert_Sequencer::Alert_Sequencer(Event_Bus* event_bus, AlertClock_t clock)
+    : bus(event_bus), clock_ms(clock), handler(nullptr), state(ALERT_SEQ_IDLE),
+      resolution(ALERT_RESOLVED_NONE), start_time(0), state_time(0), score(0), sos(false),
+      transmitted(false), last_tick_s(0), movement_ms(0), last_motion_time(0) {
+    memset(&stats, 0, sizeof(stats));
+}
+
+void Alert_Sequencer::onAction(AlertActionHandler_t action_handler) {
+    handler = action_handler;
+}
+
+bool Alert_Sequencer::startFall(uint8_t confidence_score) {
+    if (state != ALERT_SEQ_IDLE) return false;
+
+    stats.falls++;
+    score = confidence_score;
+    sos = false;
+    transmitted = false;
+    resolution = ALERT_RESOLVED_NONE;
+    start_time = clock_ms();
+    last_tick_s = 0;
+    movement_ms = 0;
+    last_motion_time = start_time;
+
+    enter(ALERT_SEQ_ALARM);
+    act(ALERT_ACTION_ALARM_ON);
+
+    // High confidence goes out now; the countdown can still withdraw it
+    if (score >= HIGH_CONFIDENCE_THRESHOLD) {
+        transmit();
+    }
+    return true;
+}
+
+void Alert_Sequencer::pressSOS() {
+    switch (state) {
+        case ALERT_SEQ_IDLE:
+            stats.sos++;
+            score = MAX_CONFIDENCE_SCORE;
+            sos = true;
+            transmitted = false;
+            resolution = ALERT_RESOLVED_NONE;
+            start_time = clock_ms();
+            act(ALERT_ACTION_ALARM_ON);
+            escalate(ALERT_RESOLVED_SOS);
+            break;
+
+        case ALERT_SEQ_ALARM:
+        case ALERT_SEQ_PROMPT:
+        case ALERT_SEQ_COUNTDOWN:
+            stats.confirmed++;
+            stats.last_response_ms = clock_ms() - start_time;
+            sos = true;
+            escalate(ALERT_RESOLVED_CONFIRMED);
+            break;
+
+        case ALERT_SEQ_ESCALATED:
+            break;   // Already on its way
+    }
+}
+
+bool Alert_Sequencer::cancel() {
+    if (state == ALERT_SEQ_IDLE) return false;
+
+    stats.app_cancels++;
+    stats.last_response_ms = clock_ms() - start_time;
+    act(ALERT_ACTION_WITHDRAW);
+    publish(EVENT_ALERT_CANCELLED, ALERT_RESOLVED_APP_CANCEL);
+    finish(ALERT_RESOLVED_APP_CANCEL);
+    return true;
+}
+
+void Alert_Sequencer::addMotion(const SensorData_t& data) {
+    uint32_t now = clock_ms();
+    uint32_t step = now - last_motion_time;
+    last_motion_time = now;
+    if (step > MOTION_MAX_STEP_MS) step = MOTION_MAX_STEP_MS;
+
+    if (!inResponseWindow() || !data.valid) return;
+
+    float accel = sqrt(data.accel_x * data.accel_x + data.accel_y * data.accel_y +
+                       data.accel_z * data.accel_z);
+    float gyro = sqrt(data.gyro_x * data.gyro_x + data.gyro_y * data.gyro_y +
+                      data.gyro_z * data.gyro_z);
+    bool moving = fabsf(accel - 1.0f) > ALERT_MOVEMENT_G || gyro > ALERT_MOVEMENT_DPS;
+
+    // Walking about adds up; a twitch or a settling arm decays away
+    if (moving) {
+        movement_ms += step;
+    } else {
+        movement_ms -= (step / 2 < movement_ms) ? step / 2 : movement_ms;
+    }
+
+    if (movement_ms >= ALERT_MOVEMENT_CANCEL_MS) {
+        stats.movement_cancels++;
+        stats.last_response_ms = now - start_time;
+        act(ALERT_ACTION_WITHDRAW);
+        publish(EVENT_ALERT_CANCELLED, ALERT_RESOLVED_MOVEMENT);
+        finish(ALERT_RESOLVED_MOVEMENT);
+    }
+}
+
+AlertSeqState_t Alert_Sequencer::service() {
+    uint32_t now = clock_ms();
+    uint32_t in_state = now - state_time;
+
+    switch (state) {
+        case ALERT_SEQ_IDLE:
+            break;
+
+        case ALERT_SEQ_ALARM:
+            if (in_state >= ALERT_ALARM_MS) {
+                enter(ALERT_SEQ_PROMPT);
+                publish(EVENT_COUNTDOWN_STARTED, getSecondsLeft());
+            }
+            break;
+
+        case ALERT_SEQ_PROMPT:
+            if (in_state >= ALERT_PROMPT_MS) {
+                enter(ALERT_SEQ_COUNTDOWN);
+            }
+            break;
+
+        case ALERT_SEQ_COUNTDOWN: {
+            if (now - start_time >= COUNTDOWN_MS) {
+                escalate(ALERT_RESOLVED_TIMEOUT);
+                break;
+            }
+
+            // Beep every 10 seconds, then every second for the last five
+            uint32_t seconds = getSecondsLeft();
+            if (seconds != last_tick_s && (seconds % 10 == 0 || seconds <= 5)) {
+                last_tick_s = seconds;
+                publish(EVENT_COUNTDOWN_TICK, seconds);
+            }
+            break;
+        }
+
+        case ALERT_SEQ_ESCALATED:
+            if (in_state >= ALERT_HOLD_MS) {
+                finish(ALERT_RESOLVED_NONE);
+            }
+            break;
+    }
+    return state;
+}
+
+uint32_t Alert_Sequencer::getSecondsLeft() {
+    if (state == ALERT_SEQ_IDLE || state == ALERT_SEQ_ESCALATED) return 0;
+
+    uint32_t elapsed = clock_ms() - start_time;
+    if (elapsed >= COUNTDOWN_MS) return 0;
+    return (COUNTDOWN_MS - elapsed + 999) / 1000;
+}
+
+void Alert_Sequencer::printStats() {
+    Serial.println("=== Alert Sequence ===");
+    Serial.print("State: ");
+    Serial.print(getStateName(state));
+    Serial.print(" | Last: ");
+    Serial.println(getResolutionName(resolution));
+    Serial.print("Falls: ");
+    Serial.print(stats.falls);
+    Serial.print(" | SOS: ");
+    Serial.print(stats.sos);
+    Serial.print(" | Escalated: ");
+    Serial.print(stats.escalated);
+    Serial.print(" | Confirmed: ");
+    Serial.println(stats.confirmed);
+    Serial.print("Cancelled: app ");
+    Serial.print(stats.app_cancels);
+    Serial.print(", movement ");
+    Serial.print(stats.movement_cancels);
+    Serial.print(" | Last response: ");
+    Serial.print(stats.last_response_ms);
+    Serial.println(" ms");
+    Serial.println("======================");
+}
+
+const char* Alert_Sequencer::getStateName(AlertSeqState_t state) {
+    switch (state) {
+        case ALERT_SEQ_IDLE:       return "idle";
+        case ALERT_SEQ_ALARM:      return "alarm";
+        case ALERT_SEQ_PROMPT:     return "prompt";
+        case ALERT_SEQ_COUNTDOWN:  return "countdown";
+        case ALERT_SEQ_ESCALATED:  return "escalated";
+        default:                   return "unknown";
+    }
+}
+
+const char* Alert_Sequencer::getResolutionName(AlertResolution_t resolution) {
+    switch (resolution) {
+        case ALERT_RESOLVED_NONE:        return "none";
+        case ALERT_RESOLVED_TIMEOUT:     return "no response";
+        case ALERT_RESOLVED_CONFIRMED:   return "confirmed";
+        case ALERT_RESOLVED_SOS:         return "sos";
+        case ALERT_RESOLVED_APP_CANCEL:  return "app cancel";
+        case ALERT_RESOLVED_MOVEMENT:    return "movement";
+        default:                         return "unknown";
+    }
+}
+
+// Private helper functions
+
+void Alert_Sequencer::enter(AlertSeqState_t next) {
+    state = next;
+    state_time = clock_ms();
+    if (DEBUG_ALGORITHM_STEPS) {
+        Serial.print("[Alert] -> ");
+        Serial.println(getStateName(next));
+    }
+}
+
+void Alert_Sequencer::escalate(AlertResolution_t why) {
+    resolution = why;
+    stats.escalated++;
+    if (!transmitted) {
+        transmit();
+    }
+    enter(ALERT_SEQ_ESCALATED);
+}
+
+void Alert_Sequencer::finish(AlertResolution_t why) {
+    if (why != ALERT_RESOLVED_NONE) {
+        resolution = why;
+    }
+    act(ALERT_ACTION_ALARM_OFF);
+    enter(ALERT_SEQ_IDLE);
+    act(ALERT_ACTION_FINISHED);
+}
+
+void Alert_Sequencer::transmit() {
+    transmitted = true;
+    act(ALERT_ACTION_TRANSMIT);
+}
+
+void Alert_Sequencer::act(AlertAction_t action) {
+    if (handler != nullptr) {
+        handler(action);
+    }
+}
+
+void Alert_Sequencer::publish(EventType_t type, uint32_t value) {
+    if (bus != nullptr) {
+        bus->publish(type, value);
+    }
+}
+
+bool Alert_Sequencer::inResponseWindow() {
+    return !sos && (state == ALERT_SEQ_PROMPT || state == ALERT_SEQ_COUNTDOWN);
+}
@@ -0,0 +1,132 @@
+#ifndef ALERT_SEQUENCER_H
+#define ALERT_SEQUENCER_H
+
+#include <Arduino.h>
+#include "../utils/data_types.h"
+#include "../utils/config.h"
+#include "Event_Bus.h"
+
+/*
+ * Tick-driven alert sequence (FallDetectionAlgorithm.md section 8).
+ *
+ *   IDLE -> ALARM -> PROMPT -> COUNTDOWN -> ESCALATED -> IDLE
+ *
+ * ALARM      Beeps, haptic and LED, ALERT_ALARM_MS
+ * PROMPT     "Press button if okay", ALERT_PROMPT_MS
+ * COUNTDOWN  Ticks until COUNTDOWN_DURATION_S after the first alert
+ * ESCALATED  Alert handed to the transports, alarm held ALERT_HOLD_MS
+ *
+ * During the response window an SOS press escalates at once, and
+ * sustained movement or an app cancel ends the sequence. A high
+ * confidence fall is transmitted when it starts. The countdown then
+ * only decides whether to withdraw it. A confirmed fall is transmitted
+ * at escalation. A plain SOS press skips straight to ESCALATED.
+ *
+ * Nothing here blocks. Inputs act on the call that delivers them, and
+ * service() advances the timers. All calls come from the loop task.
+ * Cues go out as events on the bus. Hardware and transport work goes
+ * to the action handler.
+ */
+
+typedef uint32_t (*AlertClock_t)();
+
+// Default clock: millis() narrowed to 32 bits
+uint32_t alertMillis();
+
+typedef enum {
+    ALERT_SEQ_IDLE,
+    ALERT_SEQ_ALARM,
+    ALERT_SEQ_PROMPT,
+    ALERT_SEQ_COUNTDOWN,
+    ALERT_SEQ_ESCALATED
+} AlertSeqState_t;
+
+typedef enum {
+    ALERT_ACTION_ALARM_ON,        // Haptic and LED on
+    ALERT_ACTION_ALARM_OFF,
+    ALERT_ACTION_TRANSMIT,        // Send the alert (see isSOS())
+    ALERT_ACTION_WITHDRAW,        // Cancelled: drop queued retries
+    ALERT_ACTION_FINISHED         // Back to idle: re-arm the detector
+} AlertAction_t;
+
+typedef enum {
+    ALERT_RESOLVED_NONE,          // Still running
+    ALERT_RESOLVED_TIMEOUT,       // No response: escalated at the deadline
+    ALERT_RESOLVED_CONFIRMED,     // SOS during the response window
+    ALERT_RESOLVED_SOS,           // SOS press with no fall
+    ALERT_RESOLVED_APP_CANCEL,
+    ALERT_RESOLVED_MOVEMENT       // Significant movement, user is up
+} AlertResolution_t;
+
+typedef void (*AlertActionHandler_t)(AlertAction_t action);
+
+typedef struct {
+    uint32_t falls;
+    uint32_t sos;
+    uint32_t escalated;
+    uint32_t confirmed;
+    uint32_t app_cancels;
+    uint32_t movement_cancels;
+    uint32_t last_response_ms;    // Start -> SOS or cancel
+} AlertSeqStats_t;
+
+class Alert_Sequencer {
+private:
+    Event_Bus* bus;
+    AlertClock_t clock_ms;
+    AlertActionHandler_t handler;
+
+    AlertSeqState_t state;
+    AlertResolution_t resolution;
+    uint32_t start_time;
+    uint32_t state_time;
+    uint8_t score;
+    bool sos;
+    bool transmitted;
+    uint32_t last_tick_s;         // Last countdown second announced
+
+    // Movement evidence: grows while moving, decays at half rate when still
+    uint32_t movement_ms;
+    uint32_t last_motion_time;
+
+    AlertSeqStats_t stats;
+
+public:
+    Alert_Sequencer(Event_Bus* bus, AlertClock_t clock = alertMillis);
+
+    void onAction(AlertActionHandler_t handler);
+
+    // Inputs
+    bool startFall(uint8_t confidence_score);   // False while a sequence runs
+    void pressSOS();                            // Starts or confirms
+    bool cancel();                              // App cancel; false when idle
+    void addMotion(const SensorData_t& data);   // Every sensor sample
+
+    // Called periodically; advances the timers
+    AlertSeqState_t service();
+
+    AlertSeqState_t getState() { return state; }
+    AlertResolution_t getResolution() { return resolution; }
+    bool isActive() { return state != ALERT_SEQ_IDLE; }
+    bool isSOS() { return sos; }
+    uint8_t getScore() { return score; }
+    uint32_t getSecondsLeft();
+    uint32_t getMovementMs() { return movement_ms; }
+    const AlertSeqStats_t& getStats() { return stats; }
+    void printStats();
+
+    static const char* getStateName(AlertSeqState_t state);
+    static const char* getResolutionName(AlertResolution_t resolution);
+
+private:
+    // Private helper functions
+    void enter(AlertSeqState_t next);
+    void escalate(AlertResolution_t why);
+    void finish(AlertResolution_t why);
+    void transmit();
+    void act(AlertAction_t action);
+    void publish(EventType_t type, uint32_t value);
+    bool inResponseWindow();
+};
+
+#endif // ALERT_SEQUENCER_H
@@ -0,0 +1,279 @@
+#include "Boot_Manager.h"
+
+uint32_t bootMillis() {
+    return (uint32_t)millis();
+}
+
+Boot_Manager::Boot_Manager(BootClock_t clock)
+    : step_count(0), clock_ms(clock), monitoring_ms(0), complete_ms(0),
+      settled_count(0), used_count(0) {
+    memset(steps, 0, sizeof(steps));
+#ifdef ARDUINO
+    state_mux = portMUX_INITIALIZER_UNLOCKED;
+    active_workers = 0;
+#endif
+}
+
+bool Boot_Manager::addStep(uint8_t id, const char* name, BootStepFn_t run, BootMode_t mode, uint32_t after) {
+    if (id >= BOOT_MAX_STEPS || run == nullptr || steps[id].state != BOOT_STEP_UNUSED) {
+        return false;
+    }
+
+    BootStep_t& step = steps[id];
+    step.name = name;
+    step.run = run;
+    step.mode = mode;
+    step.after = after & ~BOOT_BIT(id);
+    step.state = BOOT_STEP_PENDING;
+
+    if (id >= step_count) step_count = id + 1;
+    used_count++;
+    return true;
+}
+
+bool Boot_Manager::validate() {
+    // Unknown dependencies
+    uint32_t defined = 0;
+    for (uint8_t i = 0; i < step_count; i++) {
+        if (steps[i].state != BOOT_STEP_UNUSED) defined |= BOOT_BIT(i);
+    }
+
+    bool ok = true;
+    for (uint8_t i = 0; i < step_count; i++) {
+        if (steps[i].state != BOOT_STEP_UNUSED && (steps[i].after & ~defined)) {
+            Serial.print("[Boot] ERROR: Step '");
+            Serial.print(steps[i].name);
+            Serial.println("' depends on an undefined step");
+            ok = false;
+        }
+    }
+    if (!ok) return false;
+
+    // Kahn's algorithm: every step must become reachable
+    uint32_t resolved = 0;
+    bool progress = true;
+    while (progress) {
+        progress = false;
+        for (uint8_t i = 0; i < step_count; i++) {
+            uint32_t bit = BOOT_BIT(i);
+            if ((defined & bit) && !(resolved & bit) && (steps[i].after & ~resolved) == 0) {
+                resolved |= bit;
+                progress = true;
+            }
+        }
+    }
+
+    if (resolved != defined) {
+        Serial.print("[Boot] ERROR: Dependency cycle between:");
+        for (uint8_t i = 0; i < step_count; i++) {
+            if ((defined & ~resolved) & BOOT_BIT(i)) {
+                Serial.print(" ");
+                Serial.print(steps[i].name);
+            }
+        }
+        Serial.println();
+        return false;
+    }
+    return true;
+}
+
+uint8_t Boot_Manager::runInline() {
+    uint8_t count = 0;
+    int8_t id;
+    while ((id = claimReady(true)) >= 0) {
+        runStep(id);
+        count++;
+    }
+    return count;
+}
+
+bool Boot_Manager::startBackground() {
+#ifdef ARDUINO
+    uint8_t pending = used_count - settled_count;
+    uint8_t workers = pending < BOOT_WORKER_COUNT ? pending : BOOT_WORKER_COUNT;
+    bool ok = true;
+
+    for (uint8_t i = 0; i < workers; i++) {
+        lock();
+        active_workers++;
+        unlock();
+
+        if (xTaskCreate(workerEntry, "boot", BOOT_WORKER_STACK, this,
+                        BOOT_WORKER_PRIORITY, nullptr) != pdPASS) {
+            lock();
+            active_workers--;
+            unlock();
+            ok = false;
+        }
+    }
+
+    // No worker could start: finish on the caller rather than hang
+    if (workers > 0 && active_workers == 0) {
+        Serial.println("[Boot] ERROR: No boot workers, finishing inline");
+        runWorker();
+    }
+    return ok;
+#else
+    return false;
+#endif
+}
+
+void Boot_Manager::runWorker() {
+    while (!isComplete()) {
+        int8_t id = claimReady(false);
+        if (id >= 0) {
+            runStep(id);
+            continue;
+        }
+
+        // Another worker holds a dependency of every remaining step
+#ifdef ARDUINO
+        vTaskDelay(pdMS_TO_TICKS(5));
+#else
+        break;
+#endif
+    }
+}
+
+void Boot_Manager::markMonitoring() {
+    if (monitoring_ms == 0) {
+        monitoring_ms = clock_ms();
+    }
+}
+
+bool Boot_Manager::isDone(uint8_t id) {
+    return id < BOOT_MAX_STEPS && steps[id].state == BOOT_STEP_DONE;
+}
+
+bool Boot_Manager::isSettled(uint8_t id) {
+    if (id >= BOOT_MAX_STEPS) return false;
+    BootState_t state = steps[id].state;
+    return state == BOOT_STEP_DONE || state == BOOT_STEP_FAILED || state == BOOT_STEP_UNUSED;
+}
+
+void Boot_Manager::getStats(BootStats_t& stats) {
+    memset(&stats, 0, sizeof(stats));
+    lock();
+    stats.monitoring_ms = monitoring_ms;
+    stats.complete_ms = complete_ms;
+
+    for (uint8_t i = 0; i < step_count; i++) {
+        const BootStep_t& step = steps[i];
+        if (step.state != BOOT_STEP_DONE && step.state != BOOT_STEP_FAILED) continue;
+
+        BootStepTiming_t& timing = stats.steps[stats.step_count++];
+        timing.name = step.name;
+        timing.start_ms = step.start_ms;
+        timing.duration_ms = step.end_ms - step.start_ms;
+        timing.ok = step.state == BOOT_STEP_DONE;
+        if (!timing.ok) stats.failed_steps++;
+    }
+    unlock();
+}
+
+void Boot_Manager::printReport() {
+    Serial.println("=== Boot Timeline ===");
+    Serial.print("Monitoring at: ");
+    Serial.print(monitoring_ms);
+    Serial.print(" ms | Complete at: ");
+    if (complete_ms != 0) {
+        Serial.print(complete_ms);
+        Serial.println(" ms");
+    } else {
+        Serial.println("(in progress)");
+    }
+
+    for (uint8_t i = 0; i < step_count; i++) {
+        const BootStep_t& step = steps[i];
+        if (step.state == BOOT_STEP_UNUSED) continue;
+
+        Serial.print(step.state == BOOT_STEP_DONE ? "✓ " : (step.state == BOOT_STEP_FAILED ? "✗ " : "… "));
+        Serial.print(step.name);
+        Serial.print(step.mode == BOOT_INLINE ? " [inline]" : " [bg]");
+        if (step.state == BOOT_STEP_DONE || step.state == BOOT_STEP_FAILED) {
+            Serial.print(" @");
+            Serial.print(step.start_ms);
+            Serial.print(" ms, ");
+            Serial.print(step.end_ms - step.start_ms);
+            Serial.print(" ms");
+        }
+        Serial.println();
+    }
+    Serial.println("=====================");
+}
+
+// Private helper functions
+
+int8_t Boot_Manager::claimReady(bool inline_only) {
+    int8_t claimed = -1;
+
+    lock();
+    uint32_t settled = 0;
+    for (uint8_t i = 0; i < step_count; i++) {
+        BootState_t state = steps[i].state;
+        if (state == BOOT_STEP_DONE || state == BOOT_STEP_FAILED || state == BOOT_STEP_UNUSED) {
+            settled |= BOOT_BIT(i);
+        }
+    }
+
+    // Lowest id first, so registration order breaks ties
+    for (uint8_t i = 0; i < step_count; i++) {
+        BootStep_t& step = steps[i];
+        if (step.state != BOOT_STEP_PENDING) continue;
+        if (inline_only && step.mode != BOOT_INLINE) continue;
+        if ((step.after & ~settled) != 0) continue;
+
+        step.state = BOOT_STEP_RUNNING;
+        claimed = (int8_t)i;
+        break;
+    }
+    unlock();
+
+    return claimed;
+}
+
+void Boot_Manager::runStep(uint8_t id) {
+    BootStep_t& step = steps[id];
+    step.start_ms = clock_ms();
+    bool ok = step.run();
+    uint32_t end = clock_ms();
+
+    lock();
+    step.end_ms = end;
+    step.state = ok ? BOOT_STEP_DONE : BOOT_STEP_FAILED;
+    settled_count++;
+    if (settled_count == used_count) {
+        complete_ms = end ? end : 1;
+    }
+    unlock();
+
+    if (!ok) {
+        Serial.print("[Boot] ✗ Step failed: ");
+        Serial.println(step.name);
+    }
+}
+
+void Boot_Manager::lock() {
+#ifdef ARDUINO
+    portENTER_CRITICAL(&state_mux);
+#endif
+}
+
+void Boot_Manager::unlock() {
+#ifdef ARDUINO
+    portEXIT_CRITICAL(&state_mux);
+#endif
+}
+
+#ifdef ARDUINO
+void Boot_Manager::workerEntry(void* arg) {
+    Boot_Manager* self = static_cast<Boot_Manager*>(arg);
+    self->runWorker();
+
+    self->lock();
+    self->active_workers--;
+    self->unlock();
+
+    vTaskDelete(nullptr);
+}
+#endif
@@ -0,0 +1,218 @@
+#include "Task_Watchdog.h"
+
+Task_Watchdog::Task_Watchdog() : task_count(0) {
+    memset(tasks, 0, sizeof(tasks));
+#ifdef ARDUINO
+    task = nullptr;
+    mux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+}
+
+int8_t Task_Watchdog::add(const char* name, uint32_t deadline_ms, uint32_t restart_ms,
+                          WatchdogRestartFn_t restart) {
+    if (task_count >= WATCHDOG_MAX_TASKS || deadline_ms == 0) {
+        return -1;
+    }
+    // A restart time without a way to restart would only ever defer
+    if (restart == nullptr) restart_ms = 0;
+
+    WatchedTask_t& watched = tasks[task_count];
+    memset(&watched, 0, sizeof(watched));
+    watched.name = name;
+    watched.deadline_ms = deadline_ms;
+    watched.restart_ms = restart_ms;
+    watched.restart = restart;
+
+    return (int8_t)task_count++;
+}
+
+bool Task_Watchdog::begin() {
+#ifdef ARDUINO
+    // Reconfigures the TWDT the core started: longer timeout, reboot on expiry
+    if (esp_task_wdt_init(TASK_WDT_TIMEOUT_S, true) != ESP_OK) {
+        Serial.println("[Watchdog] ERROR: Failed to configure task watchdog!");
+        return false;
+    }
+    if (xTaskCreate(taskEntry, "watchdog", WATCHDOG_TASK_STACK, this,
+                    WATCHDOG_TASK_PRIORITY, &task) != pdPASS) {
+        Serial.println("[Watchdog] ERROR: Failed to create watchdog task!");
+        return false;
+    }
+#endif
+    Serial.print("[Watchdog] Supervising ");
+    Serial.print(task_count);
+    Serial.println(" tasks");
+    return true;
+}
+
+#ifdef ARDUINO
+bool Task_Watchdog::attach(uint8_t id, TaskHandle_t handle) {
+    if (id >= task_count || handle == nullptr) return false;
+
+    // Stages of one task share its subscription (already subscribed: ESP_ERR_INVALID_ARG)
+    esp_err_t result = esp_task_wdt_add(handle);
+    if (result != ESP_OK && result != ESP_ERR_INVALID_ARG) {
+        Serial.print("[Watchdog] ✗ Could not subscribe ");
+        Serial.println(tasks[id].name);
+        return false;
+    }
+    tasks[id].handle = handle;
+    return true;
+}
+
+void Task_Watchdog::detach(uint8_t id) {
+    if (id >= task_count || tasks[id].handle == nullptr) return;
+    esp_task_wdt_delete(tasks[id].handle);
+    tasks[id].handle = nullptr;
+}
+#endif
+
+void Task_Watchdog::checkIn(uint8_t id, uint32_t now_ms) {
+    if (id >= task_count) return;
+    WatchedTask_t& watched = tasks[id];
+
+#ifdef ARDUINO
+    portENTER_CRITICAL(&mux);
+#endif
+    if (watched.active) {
+        uint32_t gap = now_ms - watched.last_checkin_ms;
+        if (gap > watched.max_gap_ms) watched.max_gap_ms = gap;
+
+        // A late check-in that service() did not see in time still counts once
+        if (gap > watched.deadline_ms && !watched.late) {
+            watched.misses++;
+        }
+    }
+
+    watched.active = true;
+    watched.late = false;
+    watched.last_checkin_ms = now_ms;
+    watched.checkins++;
+#ifdef ARDUINO
+    portEXIT_CRITICAL(&mux);
+
+    if (watched.handle != nullptr) {
+        esp_task_wdt_reset();
+    }
+#endif
+}
+
+uint8_t Task_Watchdog::service(uint32_t now_ms) {
+    uint8_t late = 0;
+
+    for (uint8_t i = 0; i < task_count; i++) {
+        WatchedTask_t& watched = tasks[i];
+        bool report = false;
+        bool stuck = false;
+
+#ifdef ARDUINO
+        portENTER_CRITICAL(&mux);
+#endif
+        uint32_t gap = now_ms - watched.last_checkin_ms;
+        if (watched.active && gap > watched.deadline_ms) {
+            late++;
+            if (!watched.late) {
+                watched.late = true;
+                watched.misses++;
+                report = true;
+            }
+            stuck = watched.restart_ms > 0 && gap >= watched.restart_ms;
+        }
+#ifdef ARDUINO
+        portEXIT_CRITICAL(&mux);
+#endif
+
+        if (report) {
+            Serial.print("[Watchdog] ✗ ");
+            Serial.print(watched.name);
+            Serial.print(" missed its ");
+            Serial.print(watched.deadline_ms);
+            Serial.println(" ms deadline");
+        }
+        if (!stuck) continue;
+
+        if (!watched.restart()) {
+            watched.restarts_deferred++;
+            continue;
+        }
+
+        // The new instance gets a full deadline to check in
+#ifdef ARDUINO
+        portENTER_CRITICAL(&mux);
+#endif
+        watched.restarts++;
+        if (gap > watched.max_gap_ms) watched.max_gap_ms = gap;
+        watched.late = false;
+        watched.last_checkin_ms = now_ms;
+#ifdef ARDUINO
+        portEXIT_CRITICAL(&mux);
+#endif
+        Serial.print("[Watchdog] ✓ ");
+        Serial.print(watched.name);
+        Serial.println(" restarted");
+    }
+
+    return late;
+}
+
+const WatchedTask_t* Task_Watchdog::getTask(uint8_t id) {
+    return id < task_count ? &tasks[id] : nullptr;
+}
+
+uint32_t Task_Watchdog::getTotalMisses() {
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < task_count; i++) {
+        total += tasks[i].misses;
+    }
+    return total;
+}
+
+void Task_Watchdog::resetStats() {
+    for (uint8_t i = 0; i < task_count; i++) {
+        tasks[i].checkins = 0;
+        tasks[i].misses = 0;
+        tasks[i].max_gap_ms = 0;
+        tasks[i].restarts = 0;
+        tasks[i].restarts_deferred = 0;
+    }
+}
+
+void Task_Watchdog::printStats() {
+    Serial.println("=== Task Watchdog ===");
+    for (uint8_t i = 0; i < task_count; i++) {
+        const WatchedTask_t& watched = tasks[i];
+        Serial.print("[");
+        Serial.print(watched.name);
+        Serial.print("] deadline ");
+        Serial.print(watched.deadline_ms);
+        Serial.print(" ms, check-ins ");
+        Serial.print(watched.checkins);
+        Serial.print(", misses ");
+        Serial.print(watched.misses);
+        Serial.print(", max gap ");
+        Serial.print(watched.max_gap_ms);
+        Serial.print(" ms");
+        if (watched.restart_ms > 0) {
+            Serial.print(", restarts ");
+            Serial.print(watched.restarts);
+            Serial.print(" (");
+            Serial.print(watched.restarts_deferred);
+            Serial.print(" deferred)");
+        }
+        Serial.println();
+    }
+    Serial.println("=====================");
+}
+
+// Private helper functions
+
+#ifdef ARDUINO
+void Task_Watchdog::taskEntry(void* arg) {
+    Task_Watchdog* watchdog = static_cast<Task_Watchdog*>(arg);
+    TickType_t wake = xTaskGetTickCount();
+    for (;;) {
+        vTaskDelayUntil(&wake, pdMS_TO_TICKS(WATCHDOG_INTERVAL_MS));
+        watchdog->service(millis());
+    }
+}
+#endif
@@ -0,0 +1,341 @@
+/*
+ * SmartFall - Alert Sequence Test
+ *
+ * Drives the alert state machine on a virtual clock, one millisecond
+ * per step. A 100 Hz motion feed and a 10 ms service() stand in for the
+ * sensor loop and the events group.
+ *
+ * Hardware: ESP32 HUZZAH32 Feather (no sensors required)
+ *
+ * This test verifies:
+ * - alarm -> prompt -> countdown -> escalate timeline with no response
+ * - Countdown ticks at 20, 10 and the last five seconds
+ * - High confidence transmits at once, and only once
+ * - SOS confirms and transmits in the same call, mid-countdown
+ * - App cancel withdraws the alert in the same call
+ * - Sustained movement cancels; a twitch, lying still, or movement
+ *   during the alarm does not
+ * - A plain SOS press escalates at once and holds the alarm
+ */
+
+#include "Alert_Sequencer.h"
+
+#define LOG_SIZE  16
+
+static uint32_t virtual_ms = 0;
+
+uint32_t virtualClock() {
+    return virtual_ms;
+}
+
+typedef struct {
+    AlertAction_t action;
+    uint32_t time;
+} LoggedAction_t;
+
+LoggedAction_t actions[LOG_SIZE];
+uint8_t action_count = 0;
+
+Event_Bus bus;
+int8_t cues = -1;
+Alert_Sequencer sequencer(&bus, virtualClock);
+
+int passed = 0;
+int failed = 0;
+
+void expect(const char* name, uint32_t expected, uint32_t actual) {
+    if (expected == actual) {
+        passed++;
+        Serial.print("✓ ");
+    } else {
+        failed++;
+        Serial.print("✗ ");
+    }
+    Serial.print(name);
+    Serial.print(": expected ");
+    Serial.print(expected);
+    Serial.print(", got ");
+    Serial.println(actual);
+}
+
+void expectTrue(const char* name, bool condition) {
+    if (condition) {
+        passed++;
+        Serial.print("✓ ");
+    } else {
+        failed++;
+        Serial.print("✗ ");
+    }
+    Serial.println(name);
+}
+
+void recordAction(AlertAction_t action) {
+    if (action_count < LOG_SIZE) {
+        actions[action_count].action = action;
+        actions[action_count].time = virtual_ms;
+        action_count++;
+    }
+}
+
+// Time of the nth logged occurrence of an action, or UINT32_MAX
+uint32_t actionTime(AlertAction_t action, uint8_t nth) {
+    for (uint8_t i = 0; i < action_count; i++) {
+        if (actions[i].action == action && nth-- == 0) return actions[i].time;
+    }
+    return UINT32_MAX;
+}
+
+uint8_t actionCount(AlertAction_t action) {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < action_count; i++) {
+        if (actions[i].action == action) count++;
+    }
+    return count;
+}
+
+SensorData_t sample(float accel_z, float gyro_x) {
+    SensorData_t data;
+    memset(&data, 0, sizeof(data));
+    data.accel_z = accel_z;
+    data.gyro_x = gyro_x;
+    data.valid = true;
+    return data;
+}
+
+// Lying still, 1 g
+SensorData_t still(uint32_t) {
+    return sample(1.0f, 0.0f);
+}
+
+// Walking: 200 ms of step impact and turning, 100 ms of level ground
+SensorData_t walking(uint32_t t) {
+    return (t / 100) % 3 != 2 ? sample(1.6f, 80.0f) : sample(1.0f, 10.0f);
+}
+
+// Runs the loop for duration_ms: motion every 10 ms, service() every 10 ms
+void run(uint32_t duration_ms, SensorData_t (*motion)(uint32_t)) {
+    for (uint32_t i = 0; i < duration_ms; i++) {
+        virtual_ms++;
+        if (virtual_ms % SENSOR_READ_INTERVAL_MS == 0) {
+            sequencer.addMotion(motion(virtual_ms));
+        }
+        if (virtual_ms % EVENT_SERVICE_INTERVAL_MS == 0) {
+            sequencer.service();
+        }
+    }
+}
+
+// Runs until the sequence ends, gives up after a minute
+void runToIdle(SensorData_t (*motion)(uint32_t)) {
+    uint32_t start = virtual_ms;
+    while (sequencer.isActive() && virtual_ms - start < 60000) {
+        run(1, motion);
+    }
+}
+
+void reset() {
+    action_count = 0;
+    Event_t event;
+    while (bus.poll(cues, event)) {}
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(2000);
+
+    Serial.println("\n========================================");
+    Serial.println("     SmartFall Alert Sequence Test");
+    Serial.println("========================================\n");
+
+    Profiler::begin();
+    cues = bus.subscribe("cues", EVENT_BIT(EVENT_COUNTDOWN_STARTED) | EVENT_BIT(EVENT_COUNTDOWN_TICK) |
+                                 EVENT_BIT(EVENT_ALERT_CANCELLED));
+    sequencer.onAction(recordAction);
+    virtual_ms = 1000;
+
+    expect("starts idle", ALERT_SEQ_IDLE, sequencer.service());
+    expectTrue("cancel while idle", !sequencer.cancel());
+    Serial.println();
+
+    // Test 1: No response
+    Serial.println("TEST 1: No Response");
+    Serial.println("-------------------");
+    {
+        reset();
+        uint32_t t0 = virtual_ms;
+        expectTrue("fall accepted", sequencer.startFall(CONFIRMED_THRESHOLD + 5));
+        expect("alarm on at start", t0, actionTime(ALERT_ACTION_ALARM_ON, 0));
+        expect("state", ALERT_SEQ_ALARM, sequencer.getState());
+        expectTrue("second fall refused", !sequencer.startFall(90));
+
+        run(ALERT_ALARM_MS, still);
+        expect("prompt after alarm", ALERT_SEQ_PROMPT, sequencer.getState());
+        Event_t event;
+        expectTrue("prompt cue", bus.poll(cues, event) && event.type == EVENT_COUNTDOWN_STARTED);
+        expect("prompt cue: seconds left", COUNTDOWN_DURATION_S - ALERT_ALARM_MS / 1000, event.value);
+
+        run(ALERT_PROMPT_MS, still);
+        expect("countdown after prompt", ALERT_SEQ_COUNTDOWN, sequencer.getState());
+        expect("not transmitted yet", 0, actionCount(ALERT_ACTION_TRANSMIT));
+
+        run(COUNTDOWN_DURATION_S * 1000 - ALERT_ALARM_MS - ALERT_PROMPT_MS, still);
+        expect("escalated at the deadline", ALERT_SEQ_ESCALATED, sequencer.getState());
+        expect("transmit time", t0 + COUNTDOWN_DURATION_S * 1000, actionTime(ALERT_ACTION_TRANSMIT, 0));
+        expect("resolution", ALERT_RESOLVED_TIMEOUT, sequencer.getResolution());
+
+        const uint32_t expected_ticks[] = {20, 10, 5, 4, 3, 2, 1};
+        bool ticks_ok = true;
+        for (uint32_t seconds : expected_ticks) {
+            if (!bus.poll(cues, event) || event.type != EVENT_COUNTDOWN_TICK || event.value != seconds) {
+                ticks_ok = false;
+            }
+        }
+        expectTrue("ticks 20, 10, 5..1", ticks_ok && !bus.poll(cues, event));
+
+        runToIdle(still);
+        expect("held, then off", t0 + COUNTDOWN_DURATION_S * 1000 + ALERT_HOLD_MS,
+               actionTime(ALERT_ACTION_ALARM_OFF, 0));
+        expect("finished with the alarm", actionTime(ALERT_ACTION_ALARM_OFF, 0),
+               actionTime(ALERT_ACTION_FINISHED, 0));
+        expect("one transmit", 1, actionCount(ALERT_ACTION_TRANSMIT));
+    }
+    Serial.println();
+
+    // Test 2: High confidence
+    Serial.println("TEST 2: High Confidence");
+    Serial.println("-----------------------");
+    {
+        reset();
+        uint32_t t0 = virtual_ms;
+        sequencer.startFall(HIGH_CONFIDENCE_THRESHOLD);
+        expect("transmitted at start", t0, actionTime(ALERT_ACTION_TRANSMIT, 0));
+        runToIdle(still);
+        expect("not sent again at the deadline", 1, actionCount(ALERT_ACTION_TRANSMIT));
+        expect("resolution", ALERT_RESOLVED_TIMEOUT, sequencer.getResolution());
+    }
+    Serial.println();
+
+    // Test 3: SOS confirms
+    Serial.println("TEST 3: SOS Confirmation");
+    Serial.println("------------------------");
+    {
+        reset();
+        uint32_t t0 = virtual_ms;
+        sequencer.startFall(75);
+        run(12345, still);
+        sequencer.pressSOS();
+        expect("transmitted on the press", t0 + 12345, actionTime(ALERT_ACTION_TRANSMIT, 0));
+        expect("state", ALERT_SEQ_ESCALATED, sequencer.getState());
+        expectTrue("flagged as SOS", sequencer.isSOS());
+        expect("resolution", ALERT_RESOLVED_CONFIRMED, sequencer.getResolution());
+        expect("response time", 12345, sequencer.getStats().last_response_ms);
+
+        sequencer.pressSOS();
+        expect("second press ignored", 1, actionCount(ALERT_ACTION_TRANSMIT));
+        runToIdle(still);
+        uint32_t t_off = actionTime(ALERT_ACTION_FINISHED, 0);
+        expectTrue("held after the press", t_off >= t0 + 12345 + ALERT_HOLD_MS &&
+                                           t_off <= t0 + 12345 + ALERT_HOLD_MS + EVENT_SERVICE_INTERVAL_MS);
+    }
+    Serial.println();
+
+    // Test 4: App cancel
+    Serial.println("TEST 4: App Cancel");
+    Serial.println("------------------");
+    {
+        reset();
+        sequencer.startFall(HIGH_CONFIDENCE_THRESHOLD + 10);
+        run(8003, still);
+        uint32_t t_cancel = virtual_ms;
+        expectTrue("cancel accepted", sequencer.cancel());
+        expect("withdrawn on the call", t_cancel, actionTime(ALERT_ACTION_WITHDRAW, 0));
+        expect("alarm off on the call", t_cancel, actionTime(ALERT_ACTION_ALARM_OFF, 0));
+        expect("finished on the call", t_cancel, actionTime(ALERT_ACTION_FINISHED, 0));
+        expect("state", ALERT_SEQ_IDLE, sequencer.getState());
+        expect("resolution", ALERT_RESOLVED_APP_CANCEL, sequencer.getResolution());
+
+        Event_t event;
+        bool cancelled = false;
+        while (bus.poll(cues, event)) {
+            if (event.type == EVENT_ALERT_CANCELLED && event.value == ALERT_RESOLVED_APP_CANCEL) cancelled = true;
+        }
+        expectTrue("cancel cue", cancelled);
+    }
+    Serial.println();
+
+    // Test 5: Movement
+    Serial.println("TEST 5: Movement");
+    Serial.println("----------------");
+    {
+        reset();
+        sequencer.startFall(75);
+        run(ALERT_ALARM_MS - 100, walking);
+        run(200, still);
+        expect("movement during the alarm ignored", ALERT_SEQ_PROMPT, sequencer.getState());
+
+        run(600, walking);
+        run(3000, still);
+        expect("a twitch does not cancel", ALERT_SEQ_COUNTDOWN, sequencer.getState());
+        expect("twitch decayed", 0, sequencer.getMovementMs());
+
+        uint32_t t_walk = virtual_ms;
+        while (sequencer.isActive() && virtual_ms - t_walk < 10000) {
+            run(1, walking);
+        }
+        uint32_t t_cancel = actionTime(ALERT_ACTION_FINISHED, 0);
+        expect("resolution", ALERT_RESOLVED_MOVEMENT, sequencer.getResolution());
+        expect("no transmit", 0, actionCount(ALERT_ACTION_TRANSMIT));
+        expectTrue("cancelled within 5 s of walking", t_cancel - t_walk <= 5000);
+        expectTrue("not before the threshold", t_cancel - t_walk >= ALERT_MOVEMENT_CANCEL_MS);
+        Serial.print("Walking cancelled the alert after ");
+        Serial.print(t_cancel - t_walk);
+        Serial.println(" ms");
+
+        reset();
+        sequencer.startFall(75);
+        runToIdle(still);
+        expect("lying still escalates", ALERT_RESOLVED_TIMEOUT, sequencer.getResolution());
+    }
+    Serial.println();
+
+    // Test 6: SOS with no fall
+    Serial.println("TEST 6: SOS Button");
+    Serial.println("------------------");
+    {
+        reset();
+        uint32_t t0 = virtual_ms;
+        sequencer.pressSOS();
+        expect("alarm on", t0, actionTime(ALERT_ACTION_ALARM_ON, 0));
+        expect("transmitted", t0, actionTime(ALERT_ACTION_TRANSMIT, 0));
+        expect("state", ALERT_SEQ_ESCALATED, sequencer.getState());
+        expect("score", MAX_CONFIDENCE_SCORE, sequencer.getScore());
+
+        run(1000, walking);
+        expect("movement does not cancel SOS", ALERT_SEQ_ESCALATED, sequencer.getState());
+        runToIdle(still);
+        expect("off after the hold", t0 + ALERT_HOLD_MS, actionTime(ALERT_ACTION_ALARM_OFF, 0));
+        expect("resolution", ALERT_RESOLVED_SOS, sequencer.getResolution());
+
+        const AlertSeqStats_t& stats = sequencer.getStats();
+        expect("falls", 6, stats.falls);
+        expect("sos", 1, stats.sos);
+        expect("escalated", 5, stats.escalated);
+        expect("app cancels", 1, stats.app_cancels);
+        expect("movement cancels", 1, stats.movement_cancels);
+        sequencer.printStats();
+    }
+    Serial.println();
+
+    Serial.print("Passed: ");
+    Serial.print(passed);
+    Serial.print("  Failed: ");
+    Serial.println(failed);
+
+    Serial.println("========================================");
+    Serial.println(failed == 0 ? "      ALL TESTS PASSED" : "      TESTS FAILED");
+    Serial.println("========================================");
+}
+
+void loop() {
+    delay(1000);
+}
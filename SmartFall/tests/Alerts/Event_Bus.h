@@ -0,0 +1,132 @@
+#ifndef EVENT_BUS_H
+#define EVENT_BUS_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "Profiler.h"
+
+#ifndef ARDUINO
+#include <mutex>
+#include <condition_variable>
+#endif
+
+/*
+ * Allocation-free publish/subscribe event bus.
+ *
+ * Events are small fixed records in one static ring. Each subscriber
+ * has its own read cursor into the ring, plus a type mask, so every
+ * subscriber sees every matching event in order. That cursor is the
+ * subscriber's queue.
+ *
+ * publish() copies the event into the ring under a short critical
+ * section and returns. Producers never wait for consumers. A subscriber
+ * that falls more than EVENT_RING_SIZE events behind loses the oldest
+ * ones, and they are counted as dropped for that subscriber only.
+ * publishFromISR() is the same for interrupt handlers. It and store()
+ * are IRAM_ATTR, so an edge that arrives while the flash cache is off
+ * (a flash write) is still published.
+ *
+ * A consumer either polls from a periodic task (dispatch()), or blocks
+ * in wait() on its own task and is woken by matching events. The
+ * publish -> handler latency goes into the event_latency profiler
+ * scope.
+ */
+
+#define EVENT_RING_SIZE           32     // Power of two
+#define EVENT_MAX_SUBSCRIBERS     6
+
+typedef enum {
+    EVENT_FALL_DETECTED,      // value: confidence score
+    EVENT_SOS_PRESSED,
+    EVENT_ALERT_SENT,
+    EVENT_ALERT_FAILED,
+    EVENT_ALERT_CANCELLED,    // value: AlertResolution_t (Alert_Sequencer.h), 0 if idle
+    EVENT_COUNTDOWN_STARTED,
+    EVENT_COUNTDOWN_TICK,     // value: seconds left
+    EVENT_TEST_ALERT,
+    EVENT_BLE_CONNECTED,
+    EVENT_BLE_DISCONNECTED,
+    EVENT_BLE_COMMAND,        // value: BLE_CMD_* code
+    EVENT_COMMAND_DONE,       // value: BLE_CMD_* code
+    EVENT_LOW_BATTERY,        // value: percent
+    EVENT_SYSTEM_READY,       // value: 1 if every sensor came up
+    EVENT_TYPE_COUNT
+} EventType_t;
+
+#define EVENT_BIT(type)           (1UL << (type))
+#define EVENT_ALL                 0xFFFFFFFFUL
+
+typedef struct {
+    uint8_t type;                 // EventType_t
+    uint8_t reserved[3];
+    uint32_t value;
+    uint32_t timestamp_us;        // micros() at publish
+} Event_t;
+
+typedef void (*EventHandler_t)(const Event_t& event);
+
+typedef struct {
+    const char* name;
+    uint32_t mask;
+    uint32_t received;
+    uint32_t dropped;             // Matching events overwritten before being read
+    uint32_t max_latency_us;      // Publish -> handler
+} EventSubscriberStats_t;
+
+class Event_Bus {
+private:
+    typedef struct {
+        const char* name;
+        uint32_t mask;
+        EventHandler_t handler;
+        uint32_t cursor;                // Next ring sequence to read
+        EventSubscriberStats_t stats;
+#ifdef ARDUINO
+        TaskHandle_t waiter;            // Task blocked in wait(), if any
+#endif
+    } Subscriber_t;
+
+    Event_t ring[EVENT_RING_SIZE];
+    uint32_t head;                      // Sequence of the next event to publish
+    uint32_t published;
+    Subscriber_t subscribers[EVENT_MAX_SUBSCRIBERS];
+    uint8_t subscriber_count;
+
+#ifdef ARDUINO
+    portMUX_TYPE bus_mux;
+#else
+    std::mutex bus_mutex;
+    std::condition_variable bus_signal;
+#endif
+
+public:
+    Event_Bus();
+
+    // Setup, before any publish
+    int8_t subscribe(const char* name, uint32_t mask, EventHandler_t handler = nullptr);
+
+    // Producers; never block
+    void publish(EventType_t type, uint32_t value = 0);
+    void publishFromISR(EventType_t type, uint32_t value = 0);
+
+    // Consumers
+    bool poll(uint8_t subscriber, Event_t& event);     // Next matching event, if any
+    uint8_t dispatch(uint8_t subscriber, uint8_t max_events = EVENT_RING_SIZE);
+    bool wait(uint8_t subscriber, uint32_t timeout_ms);  // True once an event is pending
+    bool hasPending(uint8_t subscriber);
+
+    // Statistics
+    uint32_t getPublished();
+    const EventSubscriberStats_t& getStats(uint8_t subscriber);
+    void printStats();
+    static const char* getEventName(uint8_t type);
+
+private:
+    // Private helper functions
+    void store(EventType_t type, uint32_t value);
+    bool pendingLocked(Subscriber_t& subscriber);
+    void lock();
+    void unlock();
+};
+
+#endif // EVENT_BUS_H
@@ -0,0 +1,266 @@
+/*
+ * SmartFall - Barometric Altitude Filter Test
+ *
+ * Feeds Altitude_Filter synthetic pressure and acceleration the way
+ * sensorTask does, with the detector status it would report, and checks
+ * the altitude change scored for the event.
+ *
+ * Hardware: ESP32 HUZZAH32 Feather (no sensors required)
+ *
+ * This test verifies:
+ * - The baseline follows hours of weather drift that a boot baseline
+ *   mistakes for metres of altitude
+ * - A drop during drift measures its height to a decimetre, with and
+ *   without the Kalman fusion
+ * - An HVAC step before the event is not part of the drop
+ * - The baseline holds during an event and releases after it
+ * - One update stays well inside its budget at SENSOR_SAMPLE_RATE_HZ
+ */
+
+#include "Altitude_Filter.h"
+
+#define RATE_HZ              SENSOR_SAMPLE_RATE_HZ
+#define NOISE_HPA            0.015f       // BMP280, X16 oversampling
+#define START_HPA            1013.25f
+#define DROP_TOLERANCE_CM    10
+#define TIMING_SAMPLES       10000
+#define UPDATE_BUDGET_US     20           // 2% of a core at 100 Hz
+
+int passed = 0;
+int failed = 0;
+
+void expect(const char* name, int32_t expected, int32_t actual) {
+    if (expected == actual) {
+        passed++;
+        Serial.print("✓ ");
+    } else {
+        failed++;
+        Serial.print("✗ ");
+    }
+    Serial.print(name);
+    Serial.print(": expected ");
+    Serial.print(expected);
+    Serial.print(", got ");
+    Serial.println(actual);
+}
+
+void expectTrue(const char* name, bool condition) {
+    expect(name, 1, condition ? 1 : 0);
+}
+
+int32_t centi(float value) {
+    return (int32_t)lroundf(100.0f * value);
+}
+
+// Deterministic sensor noise
+uint32_t noise_state = 12345;
+float noise() {
+    noise_state ^= noise_state << 13;
+    noise_state ^= noise_state >> 17;
+    noise_state ^= noise_state << 5;
+    return ((noise_state >> 8) * (1.0f / 16777216.0f) - 0.5f) * 3.464f;   // Unit variance
+}
+
+// The world the wrist is in: weather, ventilation and the wearer's height
+typedef struct {
+    float weather_hpa;          // Offset from START_HPA
+    float drift_hpa_per_s;
+    float hvac_hpa;             // Step from ventilation, added on top
+    float height_m;             // Above where the test started
+    uint32_t timestamp;
+} World_t;
+
+void step(Altitude_Filter& filter, World_t& world, float accel_g) {
+    SensorData_t data;
+    memset(&data, 0, sizeof(data));
+    float pressure = START_HPA + world.weather_hpa + world.hvac_hpa;
+    data.pressure = pressure - world.height_m * pressure / ALTITUDE_SCALE_HEIGHT_M + NOISE_HPA * noise();
+    data.accel_z = accel_g + 0.02f * noise();
+    data.timestamp = world.timestamp;
+    data.valid = true;
+    filter.update(data);
+
+    world.weather_hpa += world.drift_hpa_per_s / RATE_HZ;
+    world.timestamp += 1000 / RATE_HZ;
+}
+
+void rest(Altitude_Filter& filter, World_t& world, float seconds) {
+    for (uint32_t i = 0; i < (uint32_t)(seconds * RATE_HZ); i++) step(filter, world, 1.0f);
+}
+
+// A wrist drop from height_m with the statuses the detector reports:
+// free fall is noticed after 3 samples, the fall completes after 2.5 s
+// of lying still. Returns the altitude change scored on completion.
+float dropEvent(Altitude_Filter& filter, World_t& world, float height_m) {
+    // Not quite free: the accelerometer still reads FALL_G on the way down
+    const float FALL_G = 0.05f;
+    float dt = 1.0f / RATE_HZ;
+    float bottom = world.height_m - height_m;
+    float speed = 0;
+    for (uint32_t i = 0; world.height_m > bottom; i++) {
+        speed -= (1.0f - FALL_G) * ALTITUDE_GRAVITY_MS2 * dt;
+        world.height_m += speed * dt;
+        step(filter, world, FALL_G);
+        filter.observe(i >= 3 ? FALL_STATUS_STAGE1_FREEFALL : FALL_STATUS_MONITORING);
+    }
+
+    // Stopped in 50 ms
+    world.height_m = bottom;
+    float impact_g = 1.0f - speed / (0.05f * ALTITUDE_GRAVITY_MS2);
+    for (uint8_t i = 0; i < RATE_HZ / 20; i++) {
+        step(filter, world, impact_g);
+        filter.observe(FALL_STATUS_STAGE2_IMPACT);
+    }
+
+    for (uint32_t i = 0; i < (uint32_t)(2.5f * RATE_HZ); i++) {
+        step(filter, world, 1.0f);
+        if (filter.observe(FALL_STATUS_STAGE4_INACTIVITY)) return -100.0f;   // Too early
+    }
+    step(filter, world, 1.0f);
+    if (!filter.observe(FALL_STATUS_POTENTIAL_FALL)) return -100.0f;
+    return filter.getAltitudeChange();
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(2000);
+
+    Serial.println("\n========================================");
+    Serial.println("    SmartFall Altitude Filter Test");
+    Serial.println("========================================\n");
+
+    Altitude_Filter filter;
+
+    // Test 1: Weather drift
+    Serial.println("TEST 1: Weather Drift");
+    Serial.println("----------------------");
+    {
+        // A falling barometer: -1.5 hPa over two hours, about 13 m
+        World_t world = {0, -1.5f / 7200.0f, 0, 0, 0};
+        rest(filter, world, 10.0f);
+        float boot_hpa = START_HPA + world.weather_hpa;
+        rest(filter, world, 7200.0f);
+
+        float now_hpa = START_HPA + world.weather_hpa;
+        float boot_change = (now_hpa - boot_hpa) * ALTITUDE_SCALE_HEIGHT_M / now_hpa;
+        Serial.print("Boot baseline would report: ");
+        Serial.print(boot_change, 2);
+        Serial.println(" m lost");
+        expectTrue("boot baseline is metres off", fabsf(boot_change) > 10.0f);
+        expectTrue("baseline follows the weather (within 0.02 hPa)",
+                   fabsf(filter.getBaselinePressure() - now_hpa) < 0.02f);
+        expectTrue("no change while resting (within 0.1 m)", fabsf(filter.getAltitudeChange()) < 0.1f);
+        expectTrue("not holding", !filter.isHolding());
+    }
+    Serial.println();
+
+    // Test 2: Drop during drift, barometer only and fused
+    Serial.println("TEST 2: Drop During Drift");
+    Serial.println("--------------------------");
+    for (uint8_t mode = 0; mode < 2; mode++) {
+        const float heights[] = {0.4f, 0.8f, 1.2f};
+        Altitude_Filter drop_filter(mode == 1);
+        World_t world = {0, 2.0f / 3600.0f, 0, 0, 0};     // A rising front
+        rest(drop_filter, world, 600.0f);
+        for (uint8_t i = 0; i < 3; i++) {
+            float change = dropEvent(drop_filter, world, heights[i]);
+            Serial.print(mode ? "Kalman: " : "Window: ");
+            Serial.print("drop ");
+            Serial.print(heights[i], 1);
+            Serial.print(" m measured ");
+            Serial.print(change, 3);
+            Serial.println(" m");
+            expectTrue("drop height within a decimetre",
+                       abs(centi(change) - centi(heights[i])) <= DROP_TOLERANCE_CM);
+
+            // Gets up and carries on
+            drop_filter.observe(FALL_STATUS_MONITORING);
+            world.height_m = 0;
+            rest(drop_filter, world, 300.0f);
+        }
+        expect("events", 3, drop_filter.getEvents());
+    }
+    Serial.println();
+
+    // Test 3: HVAC step
+    Serial.println("TEST 3: HVAC Step");
+    Serial.println("------------------");
+    {
+        World_t world = {0, 0, 0, 0, 0};
+        filter.reset();
+        rest(filter, world, 60.0f);
+        world.hvac_hpa = 0.3f;                   // 2.5 m of apparent climb
+        rest(filter, world, 5.0f);
+        float change = dropEvent(filter, world, 0.8f);
+        Serial.print("Measured ");
+        Serial.print(change, 3);
+        Serial.println(" m after the step");
+        expectTrue("step 5 s before is not part of the drop",
+                   abs(centi(change) - 80) <= DROP_TOLERANCE_CM);
+    }
+    Serial.println();
+
+    // Test 4: Event hold
+    Serial.println("TEST 4: Event Hold");
+    Serial.println("-------------------");
+    {
+        World_t world = {0, 0, 0, 0, 0};
+        filter.reset();
+
+        // Detector leaves MONITORING before there is any history
+        step(filter, world, 1.0f);
+        filter.observe(FALL_STATUS_STAGE1_FREEFALL);
+        expectTrue("holding from the first sample", filter.isHolding());
+        expect("pre-event level falls back to the baseline (cm)", 0, centi(filter.getAltitudeChange()));
+        filter.observe(FALL_STATUS_MONITORING);
+        expectTrue("released on MONITORING", !filter.isHolding());
+
+        // The baseline does not chase the post-fall pressure
+        rest(filter, world, 30.0f);
+        filter.observe(FALL_STATUS_STAGE1_FREEFALL);
+        float held = filter.getBaselinePressure();
+        world.height_m = -1.0f;
+        rest(filter, world, 60.0f);
+        expect("baseline held (0.01 hPa)", 0, (int32_t)lroundf(100.0f * (filter.getBaselinePressure() - held)));
+        expectTrue("full metre after a minute on the floor",
+                   abs(centi(filter.getAltitudeChange()) - 100) <= DROP_TOLERANCE_CM);
+        expectTrue("completion reported once", filter.observe(FALL_STATUS_POTENTIAL_FALL) &&
+                   !filter.observe(FALL_STATUS_POTENTIAL_FALL));
+        filter.observe(FALL_STATUS_MONITORING);
+        rest(filter, world, 600.0f);
+        expectTrue("baseline catches up once released (within 0.1 m)",
+                   fabsf(filter.getAltitudeChange()) < 0.1f);
+        filter.printStats();
+    }
+    Serial.println();
+
+    // Test 5: Update cost
+    Serial.println("TEST 5: Update Cost");
+    Serial.println("--------------------");
+    {
+        World_t world = {0, 0, 0, 0, 0};
+        filter.reset();
+        uint32_t start = micros();
+        for (uint32_t i = 0; i < TIMING_SAMPLES; i++) step(filter, world, 1.0f);
+        float update_us = (float)(micros() - start) / TIMING_SAMPLES;
+
+        Serial.print("Per update:   ");
+        Serial.print(update_us, 3);
+        Serial.println(" us (with the sample synthesis)");
+        expectTrue("update within budget", update_us < UPDATE_BUDGET_US);
+    }
+    Serial.println();
+
+    Serial.print("Passed: ");
+    Serial.print(passed);
+    Serial.print("  Failed: ");
+    Serial.println(failed);
+
+    Serial.println("========================================");
+    Serial.println(failed == 0 ? "      ALL TESTS PASSED" : "      TESTS FAILED");
+    Serial.println("========================================");
+}
+
+void loop() {
+    delay(1000);
+}
@@ -0,0 +1,114 @@
+#ifndef ALTITUDE_FILTER_H
+#define ALTITUDE_FILTER_H
+
+#include <Arduino.h>
+#include "config.h"
+#include "data_types.h"
+
+/*
+ * Altitude lost in a fall, from the barometer.
+ *
+ * A baseline taken once at boot is worthless within hours: weather moves
+ * the pressure by a hectopascal an hour (8 m), and doors and ventilation
+ * add steps of tenths of one. The filter measures each event against the
+ * pressure just before it instead:
+ *   - a slow baseline EMA (ALTITUDE_BASELINE_TAU_S) follows the weather;
+ *     with no event it is the reference
+ *   - heights are averaged into ALTITUDE_BLOCK_MS blocks, with the last
+ *     ALTITUDE_GAP_BLOCKS + ALTITUDE_WINDOW_BLOCKS kept in a ring
+ *   - when the detector leaves MONITORING, the pre-event level is the
+ *     mean of the window that ended ALTITUDE_GAP_BLOCKS before, so the
+ *     descent before free fall was noticed is not part of it. The
+ *     baseline holds until the detector is back to MONITORING.
+ *   - getAltitudeChange() is the pre-event level minus the mean of the
+ *     latest window: metres lost, positive downwards.
+ * A weather front or an HVAC step matters only if it lands between the
+ * two windows, a few seconds apart.
+ *
+ * With ALTITUDE_KALMAN_ENABLED (or kalman set) the heights come from a two-state Kalman
+ * filter (height, vertical speed) that integrates vertical acceleration
+ * and corrects it with each barometer sample. Vertical acceleration is
+ * |accel| less its at-rest value (learnt from still samples, so the
+ * accelerometer bias drops out), which needs no orientation and is
+ * exact for a straight drop. getHeight() and getVerticalSpeed() then
+ * follow the fall as it happens; once the windows have settled the two
+ * modes score within a few centimetres of each other (altitude_eval).
+ *
+ * update() costs a few dozen flops per sample. No hardware access, so
+ * the same code runs in the host replays.
+ */
+
+#define ALTITUDE_RING_BLOCKS     (ALTITUDE_GAP_BLOCKS + ALTITUDE_WINDOW_BLOCKS)
+#define ALTITUDE_SCALE_HEIGHT_M  8434.0f    // R*T/g at 15 °C: metres per unit of dp/p
+#define ALTITUDE_GRAVITY_MS2     9.80665f
+#define ALTITUDE_STILL_G         0.1f       // |accel| this close to its at-rest value is still
+
+class Altitude_Filter {
+private:
+    bool use_kalman;
+    // Baseline (pressures are kept relative to origin for float resolution)
+    bool started;
+    float origin_hpa;               // First pressure seen
+    float baseline_hpa;             // Slow EMA, relative to origin
+    float gravity_g;                // |accel| at rest
+
+    // Kalman state: height above the origin pressure (m) and vertical speed (m/s)
+    float height;
+    float speed;
+    float p00, p01, p11;            // Covariance
+
+    // Block ring of mean heights
+    float ring[ALTITUDE_RING_BLOCKS];
+    uint8_t ring_head;              // Next block written
+    uint8_t ring_count;
+    float block_sum;                // Height, this block so far
+    float pressure_sum;             // Pressure, this block so far
+    uint16_t block_fill;
+    uint16_t block_samples;         // ALTITUDE_BLOCK_MS at the sample rate
+    float dt;                       // Sample period (s)
+
+    // Event
+    FallStatus_t previous_status;
+    bool holding;
+    float pre_height;
+    float last_change;
+
+    uint32_t samples;
+    uint32_t events;
+
+public:
+    Altitude_Filter(bool kalman = ALTITUDE_KALMAN_ENABLED);
+
+    void reset();
+    void setSampleRate(uint16_t rate_hz);   // Rate update() is called at; kept by reset()
+
+    // One sample; uses pressure and acceleration. Invalid samples are skipped.
+    void update(const SensorData_t& data);
+
+    // Detector status after each sample. Leaving MONITORING marks the
+    // event; back to MONITORING releases it. True on the sample a
+    // potential fall completes: score getAltitudeChange() then.
+    bool observe(FallStatus_t status);
+
+    void markEvent();
+    void releaseEvent();
+
+    float getAltitudeChange();      // m lost since the pre-event window (or vs the baseline)
+    float getHeight();                              // Above the baseline, now (m)
+    float getVerticalSpeed() { return speed; }      // m/s, up positive (Kalman only)
+    float getBaselinePressure() { return origin_hpa + baseline_hpa; }
+    bool isHolding() { return holding; }
+    uint32_t getEvents() { return events; }
+
+    void printStats();
+
+private:
+    // Private helper functions
+    float barometricHeight(float pressure_hpa);     // Relative to origin
+    void predict(float vertical_ms2);
+    void correct(float measured_m);
+    void closeBlock();
+    float windowMean(uint8_t skip_blocks);  // Latest window, skip_blocks back
+};
+
+#endif // ALTITUDE_FILTER_H
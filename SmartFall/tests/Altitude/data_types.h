@@ -0,0 +1,198 @@
+#ifndef DATA_TYPES_H
+#define DATA_TYPES_H
+
+#include <Arduino.h>
+
+// Sensor data structure
+typedef struct {
+    float accel_x, accel_y, accel_z;          // Acceleration (g)
+    float gyro_x, gyro_y, gyro_z;             // Angular velocity (°/s)
+    float pressure;                            // Barometric pressure (hPa)
+    float heart_rate;                          // Heart rate (BPM)
+    uint16_t fsr_value;                        // FSR reading (ADC counts)
+    uint32_t timestamp;                        // Timestamp (ms)
+    bool valid;                                // Data validity flag
+    uint8_t accel_range_g;                     // Accel full scale at capture (g); 0 if unknown
+    bool accel_peak_clipped;                   // Peak frame hit the full scale
+    float accel_peak_g;                        // Largest accel magnitude since the last sample; 0 if not held
+    float gyro_peak_dps;                       // Largest angular rate since the last sample; 0 if not held
+} SensorData_t;
+
+// Sensors besides the IMU: brought up in the background, and may drop out
+typedef enum {
+    HARDWARE_PRESSURE,
+    HARDWARE_HEART,
+    HARDWARE_FORCE,
+    HARDWARE_OPTIONAL_COUNT
+} HardwareSensor_t;
+
+#define HARDWARE_BIT(sensor)  (1U << (sensor))
+#define HARDWARE_ALL          (HARDWARE_BIT(HARDWARE_OPTIONAL_COUNT) - 1)
+
+// Fall detection status
+typedef enum {
+    FALL_STATUS_MONITORING,
+    FALL_STATUS_STAGE1_FREEFALL,
+    FALL_STATUS_STAGE2_IMPACT,
+    FALL_STATUS_STAGE3_ROTATION,
+    FALL_STATUS_STAGE4_INACTIVITY,
+    FALL_STATUS_POTENTIAL_FALL,
+    FALL_STATUS_FALL_DETECTED,
+    FALL_STATUS_EMERGENCY_ACTIVE
+} FallStatus_t;
+
+// Confidence levels
+typedef enum {
+    CONFIDENCE_NO_FALL = 0,
+    CONFIDENCE_SUSPICIOUS = 1,
+    CONFIDENCE_POTENTIAL = 2,
+    CONFIDENCE_CONFIRMED = 3,
+    CONFIDENCE_HIGH = 4
+} FallConfidence_t;
+
+// Emergency data payload
+typedef struct {
+    uint32_t timestamp;
+    FallConfidence_t confidence;
+    uint8_t confidence_score;
+    SensorData_t sensor_history[100];  // 10-second history at 10Hz
+    uint8_t history_count;             // Valid samples in sensor_history, oldest first
+    float battery_level;
+    bool sos_triggered;
+    char device_id[32];
+} EmergencyData_t;
+
+// Detection thresholds structure
+typedef struct {
+    float freefall_threshold_g;
+    float impact_threshold_g;
+    float rotation_threshold_dps;
+    uint32_t inactivity_threshold_ms;
+    float pressure_change_threshold_m;
+} DetectionThresholds_t;
+
+// Confidence score tiers (see detection/score_tiers.h)
+#define SCORE_TIER_MAX 4
+
+typedef enum {
+    SCORE_FREEFALL_DURATION,    // ms
+    SCORE_FREEFALL_DEPTH,       // g, lowest magnitude
+    SCORE_IMPACT,               // g
+    SCORE_IMPACT_TIMING,        // ms, free fall end to impact
+    SCORE_ROTATION,             // °/s
+    SCORE_ORIENTATION,          // degrees
+    SCORE_INACTIVITY,           // ms
+    SCORE_PRESSURE,             // m of altitude lost
+    SCORE_HEART_RATE,           // BPM, absolute change
+    SCORE_CLASSIFIER,           // Fall probability, %
+    SCORE_METRIC_COUNT
+} ScoreMetric_t;
+
+typedef struct {
+    float breakpoint;
+    uint8_t points;
+} ScoreTier_t;
+
+typedef struct {
+    uint8_t count;                             // Tiers in use, strictest first
+    bool at_most;                              // Met when value <= breakpoint, else >=
+    ScoreTier_t tiers[SCORE_TIER_MAX];
+} ScoreTable_t;
+
+typedef struct {
+    ScoreTable_t tables[SCORE_METRIC_COUNT];
+} ScoreTiers_t;
+
+// Memory and stack telemetry snapshot (see diagnostics/System_Metrics.h)
+#define MEMORY_TREND_WINDOWS 12
+
+typedef struct {
+    uint32_t free_heap;                        // Current free internal heap (bytes)
+    uint32_t min_free_heap;                    // Lowest free heap since boot (bytes)
+    uint32_t largest_free_block;               // Largest allocatable block (bytes)
+    uint8_t fragmentation_pct;                 // 100 - largest block / free heap
+    uint32_t psram_free;                       // Free PSRAM (0 if not fitted)
+    uint32_t min_stack_headroom;               // Lowest stack high-water mark of monitored tasks
+    uint32_t window_heap_min;                  // Min/max free heap across the ring
+    uint32_t window_heap_max;
+    uint32_t window_block_min;                 // Min largest block across the ring
+    uint32_t heap_trend[MEMORY_TREND_WINDOWS]; // Per-window free heap minimum, oldest first
+    uint8_t trend_count;                       // Valid entries in heap_trend
+} MemoryStats_t;
+
+// Boot-phase timing snapshot (see system/Boot_Manager.h)
+#define BOOT_MAX_STEPS 16
+
+typedef struct {
+    const char* name;
+    uint32_t start_ms;                         // Since app start
+    uint32_t duration_ms;
+    bool ok;
+} BootStepTiming_t;
+
+typedef struct {
+    uint32_t monitoring_ms;                    // Fall detection live
+    uint32_t complete_ms;                      // Last step settled (0 while booting)
+    uint8_t failed_steps;
+    uint8_t step_count;
+    BootStepTiming_t steps[BOOT_MAX_STEPS];
+} BootStats_t;
+
+// System status structure
+typedef struct {
+    bool sensors_initialized;
+    bool wifi_connected;
+    bool bluetooth_connected;
+    float battery_percentage;
+    FallStatus_t current_status;
+    uint32_t uptime_ms;
+    MemoryStats_t memory;
+    BootStats_t boot;
+} SystemStatus_t;
+
+// Voice message types
+typedef enum {
+    VOICE_FALL_DETECTED,
+    VOICE_PRESS_BUTTON,
+    VOICE_EMERGENCY_CONFIRMED,
+    VOICE_SYSTEM_READY
+} VoiceMessage_t;
+
+// Contact list structure
+typedef struct {
+    char name[32];
+    char phone[16];
+    char email[64];
+    bool enabled;
+} Contact_t;
+
+typedef struct {
+    Contact_t contacts[5];
+    uint8_t count;
+} ContactList_t;
+
+// Configuration structure
+typedef struct {
+    char wifi_ssid[32];
+    char wifi_password[64];
+    char device_name[32];
+    ContactList_t emergency_contacts;
+    DetectionThresholds_t thresholds;
+    ScoreTiers_t score_tiers;
+    uint8_t alert_volume;
+    uint8_t haptic_intensity;
+    bool visual_alerts_enabled;
+} Config_t;
+
+// Status update data
+typedef struct {
+    uint32_t timestamp;
+    float battery_level;
+    bool system_health;
+    uint32_t uptime;
+    char status_message[64];
+    MemoryStats_t memory;
+    BootStats_t boot;
+} StatusData_t;
+
+#endif // DATA_TYPES_H
\ No newline at end of file
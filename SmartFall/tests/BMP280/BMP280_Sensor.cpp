@@ -1,16 +1,20 @@
 #include "BMP280_Sensor.h"
 
+#define BMP280_CHIP_ID_REG  0xD0
+#define BMP280_CHIP_ID      0x58
+
 BMP280_Sensor::BMP280_Sensor(uint8_t sda, uint8_t scl)
-    : initialized(false), sda_pin(sda), scl_pin(scl),
+    : initialized(false), address(0x76), sda_pin(sda), scl_pin(scl),
       baselineAltitude(0.0), seaLevelPressure(1013.25) {
 }
 
-bool BMP280_Sensor::begin(uint8_t address) {
+bool BMP280_Sensor::begin(uint8_t i2c_address) {
     Wire.begin(sda_pin, scl_pin);
 
-    if (!bmp.begin(address)) {
+    if (!bmp.begin(i2c_address)) {
         // Try alternate address
-        if (address == 0x76 && bmp.begin(0x77)) {
+        if (i2c_address == 0x76 && bmp.begin(0x77)) {
+            address = 0x77;
             initialized = true;
             return true;
         }
@@ -18,6 +22,7 @@ bool BMP280_Sensor::begin(uint8_t address) {
         return false;
     }
 
+    address = i2c_address;
     initialized = true;
     return true;
 }
@@ -46,7 +51,7 @@ void BMP280_Sensor::resetBaselineAltitude() {
 }
 
 bool BMP280_Sensor::readData(float &temperature, float &pressure, float &altitude) {
-    if (!initialized) return false;
+    if (!initialized || !isResponding()) return false;
 
     temperature = bmp.readTemperature();
     pressure = bmp.readPressure() / 100.0;  // Pa to hPa
@@ -78,3 +83,13 @@ void BMP280_Sensor::printInfo() {
     Serial.println("Temperature oversampling: X2");
     Serial.println("Filter: X16");
 }
+
+// Private helper functions
+
+bool BMP280_Sensor::isResponding() {
+    Wire.beginTransmission(address);
+    Wire.write(BMP280_CHIP_ID_REG);
+    if (Wire.endTransmission(false) != 0) return false;
+    if (Wire.requestFrom(address, (uint8_t)1) != 1) return false;
+    return Wire.read() == BMP280_CHIP_ID;
+}
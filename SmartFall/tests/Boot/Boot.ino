@@ -0,0 +1,341 @@
+/*
+ * SmartFall - Boot Sequence Test
+ *
+ * Runs the SmartFall boot graph with simulated step costs on a virtual
+ * clock, then checks real worker concurrency on the device.
+ *
+ * Hardware: ESP32 HUZZAH32 Feather (no sensors required)
+ *
+ * This test verifies:
+ * - Only the critical path runs inline; monitoring starts well under 200 ms
+ * - Dependencies are respected (BLE after logger, ready after everything)
+ * - A failed step settles and does not block its dependents
+ * - Cycles, unknown dependencies and duplicate ids are rejected
+ * - Per-step timings reported by getStats()
+ * - Background steps overlap on the worker tasks (device only)
+ */
+
+#include "Boot_Manager.h"
+
+#define MONITORING_BUDGET_MS  200
+#define REAL_STEP_MS          300
+
+enum {
+    STEP_CONFIG,
+    STEP_IMU,
+    STEP_DETECTOR,
+    STEP_ALERTS,
+    STEP_AUDIO,
+    STEP_PRESSURE,
+    STEP_HEART,
+    STEP_FORCE,
+    STEP_LOGGER,
+    STEP_WIFI,
+    STEP_BLE,
+    STEP_READY,
+    STEP_COUNT
+};
+
+// Representative costs of the real init calls (ms)
+static const uint32_t step_cost[STEP_COUNT] = {
+    5,      // config: NVS load
+    30,     // imu: begin + configure
+    2,      // detector
+    1,      // alerts: pins + emergency comms
+    800,    // audio: startup melody
+    1100,   // pressure: settle + baseline
+    150,    // heart
+    300,    // force: calibration
+    50,     // logger: partition scan
+    4000,   // wifi: blocking connect
+    600,    // ble: stack bring-up
+    100     // ready: cue + report
+};
+
+static uint32_t virtual_ms = 0;
+static bool step_fails[STEP_COUNT];
+static uint8_t run_order[STEP_COUNT];
+static uint8_t run_count = 0;
+
+uint32_t virtualClock() {
+    return virtual_ms;
+}
+
+bool runCosted(uint8_t id) {
+    run_order[run_count++] = id;
+    virtual_ms += step_cost[id];
+    return !step_fails[id];
+}
+
+bool stepConfig()   { return runCosted(STEP_CONFIG); }
+bool stepIMU()      { return runCosted(STEP_IMU); }
+bool stepDetector() { return runCosted(STEP_DETECTOR); }
+bool stepAlerts()   { return runCosted(STEP_ALERTS); }
+bool stepAudio()    { return runCosted(STEP_AUDIO); }
+bool stepPressure() { return runCosted(STEP_PRESSURE); }
+bool stepHeart()    { return runCosted(STEP_HEART); }
+bool stepForce()    { return runCosted(STEP_FORCE); }
+bool stepLogger()   { return runCosted(STEP_LOGGER); }
+bool stepWiFi()     { return runCosted(STEP_WIFI); }
+bool stepBLE()      { return runCosted(STEP_BLE); }
+bool stepReady()    { return runCosted(STEP_READY); }
+
+// Same graph as SmartFall.ino
+void defineGraph(Boot_Manager& boot) {
+    boot.addStep(STEP_CONFIG, "config", stepConfig, BOOT_INLINE);
+    boot.addStep(STEP_IMU, "imu", stepIMU, BOOT_INLINE);
+    boot.addStep(STEP_DETECTOR, "detector", stepDetector, BOOT_INLINE,
+                 BOOT_BIT(STEP_CONFIG) | BOOT_BIT(STEP_IMU));
+    boot.addStep(STEP_ALERTS, "alerts", stepAlerts, BOOT_INLINE);
+    boot.addStep(STEP_AUDIO, "audio", stepAudio, BOOT_BACKGROUND, BOOT_BIT(STEP_CONFIG));
+    boot.addStep(STEP_PRESSURE, "pressure", stepPressure, BOOT_BACKGROUND);
+    boot.addStep(STEP_HEART, "heart", stepHeart, BOOT_BACKGROUND);
+    boot.addStep(STEP_FORCE, "force", stepForce, BOOT_BACKGROUND);
+    boot.addStep(STEP_LOGGER, "logger", stepLogger, BOOT_BACKGROUND);
+    boot.addStep(STEP_WIFI, "wifi", stepWiFi, BOOT_BACKGROUND, BOOT_BIT(STEP_CONFIG));
+    boot.addStep(STEP_BLE, "ble", stepBLE, BOOT_BACKGROUND,
+                 BOOT_BIT(STEP_CONFIG) | BOOT_BIT(STEP_LOGGER));
+    boot.addStep(STEP_READY, "ready", stepReady, BOOT_BACKGROUND,
+                 BOOT_BIT(STEP_AUDIO) | BOOT_BIT(STEP_PRESSURE) | BOOT_BIT(STEP_HEART) |
+                 BOOT_BIT(STEP_FORCE) | BOOT_BIT(STEP_WIFI) | BOOT_BIT(STEP_BLE));
+}
+
+void resetRun() {
+    virtual_ms = 0;
+    run_count = 0;
+    memset(step_fails, 0, sizeof(step_fails));
+}
+
+int8_t positionOf(uint8_t id) {
+    for (uint8_t i = 0; i < run_count; i++) {
+        if (run_order[i] == id) return i;
+    }
+    return -1;
+}
+
+int passed = 0;
+int failed = 0;
+
+void expect(const char* name, uint32_t expected, uint32_t actual) {
+    if (expected == actual) {
+        passed++;
+        Serial.print("✓ ");
+    } else {
+        failed++;
+        Serial.print("✗ ");
+    }
+    Serial.print(name);
+    Serial.print(": expected ");
+    Serial.print(expected);
+    Serial.print(", got ");
+    Serial.println(actual);
+}
+
+void expectTrue(const char* name, bool condition) {
+    if (condition) {
+        passed++;
+        Serial.print("✓ ");
+    } else {
+        failed++;
+        Serial.print("✗ ");
+    }
+    Serial.println(name);
+}
+
+#ifdef ARDUINO
+volatile uint8_t real_done = 0;
+
+bool realInline() { return true; }
+bool realSlow()   { delay(REAL_STEP_MS); real_done++; return true; }
+#endif
+
+void setup() {
+    Serial.begin(115200);
+    delay(2000);
+
+    Serial.println("\n========================================");
+    Serial.println("     SmartFall Boot Sequence Test");
+    Serial.println("========================================\n");
+
+    // Test 1: Critical path
+    Serial.println("TEST 1: Critical Path (virtual clock)");
+    Serial.println("-------------------------------------");
+    {
+        resetRun();
+        Boot_Manager boot(virtualClock);
+        defineGraph(boot);
+        expectTrue("graph validates", boot.validate());
+
+        uint8_t inline_steps = boot.runInline();
+        boot.markMonitoring();
+
+        expect("inline steps run", 4, inline_steps);
+        expect("first step", STEP_CONFIG, run_order[0]);
+        expectTrue("detector after config and IMU",
+                   positionOf(STEP_DETECTOR) > positionOf(STEP_CONFIG) &&
+                   positionOf(STEP_DETECTOR) > positionOf(STEP_IMU));
+        expectTrue("no background step inline", positionOf(STEP_WIFI) < 0 && positionOf(STEP_AUDIO) < 0);
+        expectTrue("detector done", boot.isDone(STEP_DETECTOR));
+        expectTrue("boot not complete", !boot.isComplete());
+
+        Serial.print("Monitoring at ");
+        Serial.print(boot.getMonitoringTime());
+        Serial.println(" ms");
+        expectTrue("monitoring within budget", boot.getMonitoringTime() <= MONITORING_BUDGET_MS);
+    }
+    Serial.println();
+
+    // Test 2: Background drain respects dependencies
+    Serial.println("TEST 2: Dependency Order");
+    Serial.println("------------------------");
+    {
+        resetRun();
+        Boot_Manager boot(virtualClock);
+        defineGraph(boot);
+        boot.runInline();
+        boot.markMonitoring();
+        boot.runWorker();
+
+        expect("steps run", STEP_COUNT, run_count);
+        expectTrue("boot complete", boot.isComplete());
+        expectTrue("BLE after logger", positionOf(STEP_BLE) > positionOf(STEP_LOGGER));
+        expect("ready runs last", STEP_READY, run_order[run_count - 1]);
+
+        uint32_t total = 0;
+        for (uint8_t i = 0; i < STEP_COUNT; i++) total += step_cost[i];
+        expect("complete time (serial drain)", total, boot.getCompleteTime());
+
+        // Old sequential setup() only began monitoring after everything,
+        // plus its 2 s serial wait
+        Serial.print("Sequential boot would start monitoring at ");
+        Serial.print(total + 2000);
+        Serial.println(" ms");
+        boot.printReport();
+    }
+    Serial.println();
+
+    // Test 3: A failed step settles
+    Serial.println("TEST 3: Failed Step");
+    Serial.println("-------------------");
+    {
+        resetRun();
+        step_fails[STEP_WIFI] = true;
+        Boot_Manager boot(virtualClock);
+        defineGraph(boot);
+        boot.runInline();
+        boot.runWorker();
+
+        expectTrue("wifi not done", !boot.isDone(STEP_WIFI));
+        expectTrue("wifi settled", boot.isSettled(STEP_WIFI));
+        expectTrue("ready still ran", boot.isDone(STEP_READY));
+        expectTrue("boot complete", boot.isComplete());
+
+        BootStats_t stats;
+        boot.getStats(stats);
+        expect("failed steps", 1, stats.failed_steps);
+    }
+    Serial.println();
+
+    // Test 4: Invalid graphs
+    Serial.println("TEST 4: Graph Validation");
+    Serial.println("------------------------");
+    {
+        Boot_Manager cycle(virtualClock);
+        cycle.addStep(0, "a", stepConfig, BOOT_INLINE, BOOT_BIT(2));
+        cycle.addStep(1, "b", stepIMU, BOOT_INLINE, BOOT_BIT(0));
+        cycle.addStep(2, "c", stepDetector, BOOT_INLINE, BOOT_BIT(1));
+        cycle.addStep(3, "d", stepAlerts, BOOT_INLINE);
+        expectTrue("cycle rejected", !cycle.validate());
+
+        Boot_Manager unknown(virtualClock);
+        unknown.addStep(0, "a", stepConfig, BOOT_INLINE, BOOT_BIT(5));
+        expectTrue("unknown dependency rejected", !unknown.validate());
+
+        Boot_Manager duplicate(virtualClock);
+        expectTrue("first add accepted", duplicate.addStep(0, "a", stepConfig, BOOT_INLINE));
+        expectTrue("duplicate id rejected", !duplicate.addStep(0, "b", stepIMU, BOOT_INLINE));
+        expectTrue("out-of-range id rejected", !duplicate.addStep(BOOT_MAX_STEPS, "c", stepIMU, BOOT_INLINE));
+
+        // Inline step waiting on a background step is left for the workers
+        resetRun();
+        Boot_Manager blocked(virtualClock);
+        blocked.addStep(0, "bg", stepConfig, BOOT_BACKGROUND);
+        blocked.addStep(1, "fg", stepIMU, BOOT_INLINE, BOOT_BIT(0));
+        expect("inline blocked on background", 0, blocked.runInline());
+        blocked.runWorker();
+        expectTrue("drained by worker", blocked.isComplete());
+    }
+    Serial.println();
+
+    // Test 5: Reported timings
+    Serial.println("TEST 5: Boot Stats");
+    Serial.println("------------------");
+    {
+        resetRun();
+        virtual_ms = 10;
+        Boot_Manager boot(virtualClock);
+        defineGraph(boot);
+        boot.runInline();
+        boot.markMonitoring();
+        boot.runWorker();
+
+        BootStats_t stats;
+        boot.getStats(stats);
+        expect("step count", STEP_COUNT, stats.step_count);
+        expect("monitoring ms", 10 + 5 + 30 + 2 + 1, stats.monitoring_ms);
+        expect("complete ms", boot.getCompleteTime(), stats.complete_ms);
+
+        bool durations_ok = true;
+        for (uint8_t i = 0; i < stats.step_count; i++) {
+            if (stats.steps[i].duration_ms != step_cost[i]) durations_ok = false;
+        }
+        expectTrue("durations match step costs", durations_ok);
+        expect("config starts at boot", 10, stats.steps[STEP_CONFIG].start_ms);
+    }
+    Serial.println();
+
+#ifdef ARDUINO
+    // Test 6: Background steps overlap on the workers
+    Serial.println("TEST 6: Worker Concurrency");
+    Serial.println("--------------------------");
+    {
+        real_done = 0;
+        Boot_Manager boot;
+        boot.addStep(0, "inline", realInline, BOOT_INLINE);
+        for (uint8_t i = 1; i <= BOOT_WORKER_COUNT; i++) {
+            boot.addStep(i, "slow", realSlow, BOOT_BACKGROUND, BOOT_BIT(0));
+        }
+
+        uint32_t start = millis();
+        boot.runInline();
+        boot.startBackground();
+        while (!boot.isComplete() && millis() - start < 5000) {
+            delay(1);
+        }
+        uint32_t elapsed = millis() - start;
+
+        Serial.print(BOOT_WORKER_COUNT);
+        Serial.print(" x ");
+        Serial.print(REAL_STEP_MS);
+        Serial.print(" ms steps finished in ");
+        Serial.print(elapsed);
+        Serial.println(" ms");
+        expect("slow steps run", BOOT_WORKER_COUNT, real_done);
+        expectTrue("steps overlapped", elapsed < REAL_STEP_MS * 2);
+    }
+    Serial.println();
+#endif
+
+    Serial.print("Passed: ");
+    Serial.print(passed);
+    Serial.print("  Failed: ");
+    Serial.println(failed);
+
+    Serial.println("========================================");
+    Serial.println(failed == 0 ? "      ALL TESTS PASSED" : "      TESTS FAILED");
+    Serial.println("========================================");
+}
+
+void loop() {
+    delay(1000);
+}
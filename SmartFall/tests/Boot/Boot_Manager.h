@@ -0,0 +1,99 @@
+#ifndef BOOT_MANAGER_H
+#define BOOT_MANAGER_H
+
+#include <Arduino.h>
+#include "data_types.h"
+#include "config.h"
+
+#define BOOT_BIT(id)  (1UL << (id))
+
+typedef bool (*BootStepFn_t)();
+typedef uint32_t (*BootClock_t)();
+
+// Default clock: millis() narrowed to 32 bits
+uint32_t bootMillis();
+
+typedef enum {
+    BOOT_INLINE,        // Critical path, run from setup()
+    BOOT_BACKGROUND     // Run on a boot worker task
+} BootMode_t;
+
+typedef enum {
+    BOOT_STEP_UNUSED,
+    BOOT_STEP_PENDING,
+    BOOT_STEP_RUNNING,
+    BOOT_STEP_DONE,
+    BOOT_STEP_FAILED
+} BootState_t;
+
+typedef struct {
+    const char* name;
+    BootStepFn_t run;
+    BootMode_t mode;
+    uint32_t after;             // Steps that must settle (done or failed) first
+    volatile BootState_t state;
+    uint32_t start_ms;
+    uint32_t end_ms;
+} BootStep_t;
+
+/*
+ * Dependency-ordered boot sequence.
+ *
+ * Steps are registered with the steps they must follow. runInline() runs
+ * the critical path (IMU, fall detector) in setup() so monitoring starts
+ * within a few hundred milliseconds. startBackground() hands everything
+ * else (radios, audio, calibration) to a small pool of worker tasks that
+ * run independent steps concurrently and exit when the graph is done.
+ * A failed step still settles, so its dependents run and can check
+ * isDone() themselves. On the host, runWorker() drains the graph on the
+ * caller's thread.
+ */
+class Boot_Manager {
+private:
+    BootStep_t steps[BOOT_MAX_STEPS];
+    uint8_t step_count;
+    BootClock_t clock_ms;
+
+    uint32_t monitoring_ms;
+    volatile uint32_t complete_ms;
+    volatile uint8_t settled_count;
+    uint8_t used_count;
+
+#ifdef ARDUINO
+    portMUX_TYPE state_mux;
+    volatile uint8_t active_workers;
+#endif
+
+public:
+    Boot_Manager(BootClock_t clock = bootMillis);
+
+    // Graph
+    bool addStep(uint8_t id, const char* name, BootStepFn_t run, BootMode_t mode, uint32_t after = 0);
+    bool validate();                    // Unknown dependencies or cycles
+
+    // Execution
+    uint8_t runInline();                // Returns the number of steps run
+    bool startBackground();             // Worker tasks (device only)
+    void runWorker();                   // Worker body; drains the graph on the host
+    void markMonitoring();              // Fall detection is live
+
+    // Status
+    bool isDone(uint8_t id);            // Finished successfully
+    bool isSettled(uint8_t id);         // Finished, successfully or not
+    bool isComplete() { return complete_ms != 0; }
+    uint32_t getMonitoringTime() { return monitoring_ms; }
+    uint32_t getCompleteTime() { return complete_ms; }
+    void getStats(BootStats_t& stats);
+    void printReport();
+
+private:
+    int8_t claimReady(bool inline_only);
+    void runStep(uint8_t id);
+    void lock();
+    void unlock();
+#ifdef ARDUINO
+    static void workerEntry(void* arg);
+#endif
+};
+
+#endif // BOOT_MANAGER_H
@@ -0,0 +1,262 @@
+/*
+ * SmartFall - Fall Classifier Test
+ *
+ * Runs the quantized tree ensemble on the golden windows written by
+ * tools/fall_sim/train_classifier.cpp, then times one inference.
+ *
+ * Hardware: ESP32 HUZZAH32 Feather (no sensors required)
+ *
+ * This test verifies:
+ * - Features, Q8 logits and probabilities of the golden windows match the
+ *   host reference bit for bit, and falls score above ADLs
+ * - observe() completes the window FALL_CLASSIFIER_POST_SAMPLES samples
+ *   after the impact, once per impact, even if the detector gives up
+ * - Empty, oversized, saturated and NaN windows stay well defined
+ * - The probability table is monotonic and centred on 50%
+ * - One inference (quantize, features, trees) stays within its budget
+ */
+
+#include "fall_classifier.h"
+#include "fall_classifier_model.h"
+#include "classifier_golden.h"
+
+#define TIMING_ROUNDS        200
+#define INFERENCE_BUDGET_US  2000   // Well inside the 10 ms sample period
+
+int passed = 0;
+int failed = 0;
+
+void expect(const char* name, int32_t expected, int32_t actual) {
+    if (expected == actual) {
+        passed++;
+        Serial.print("✓ ");
+    } else {
+        failed++;
+        Serial.print("✗ ");
+    }
+    Serial.print(name);
+    Serial.print(": expected ");
+    Serial.print(expected);
+    Serial.print(", got ");
+    Serial.println(actual);
+}
+
+void expectTrue(const char* name, bool condition) {
+    expect(name, 1, condition ? 1 : 0);
+}
+
+// Golden window as the detector history would hold it
+void loadGolden(uint8_t index, SensorData_t* out) {
+    memset(out, 0, FALL_CLASSIFIER_WINDOW * sizeof(SensorData_t));
+    for (uint8_t i = 0; i < FALL_CLASSIFIER_WINDOW; i++) {
+        const int16_t* s = GOLDEN_SAMPLES[index][i];
+        out[i].accel_x = s[0] / 1000.0f;
+        out[i].accel_y = s[1] / 1000.0f;
+        out[i].accel_z = s[2] / 1000.0f;
+        out[i].gyro_x = s[3];
+        out[i].gyro_y = s[4];
+        out[i].gyro_z = s[5];
+        out[i].valid = true;
+    }
+}
+
+// Samples observe() takes from the first impact to a complete window
+int32_t samplesToWindow(FallClassifier& classifier, const FallStatus_t* statuses, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        if (classifier.observe(statuses[i])) return i;
+    }
+    return -1;
+}
+
+SensorData_t window[FALL_CLASSIFIER_WINDOW + 20];
+
+void setup() {
+    Serial.begin(115200);
+    delay(2000);
+
+    Serial.println("\n========================================");
+    Serial.println("     SmartFall Fall Classifier Test");
+    Serial.println("========================================\n");
+
+    FallClassifier classifier;
+
+    // Test 1: Golden windows
+    Serial.println("TEST 1: Golden Windows");
+    Serial.println("-----------------------");
+    {
+        int32_t min_fall = 100, max_adl = 0;
+        for (uint8_t g = 0; g < GOLDEN_WINDOWS; g++) {
+            loadGolden(g, window);
+
+            uint32_t quantize_errors = 0;
+            for (uint8_t i = 0; i < FALL_CLASSIFIER_WINDOW; i++) {
+                FallImuSample_t q;
+                FallClassifier::quantize(window[i], q);
+                for (uint8_t axis = 0; axis < 3; axis++) {
+                    quantize_errors += q.accel[axis] != GOLDEN_SAMPLES[g][i][axis];
+                    quantize_errors += q.gyro[axis] != GOLDEN_SAMPLES[g][i][3 + axis];
+                }
+            }
+            expect(GOLDEN_FALL[g] ? "fall: quantize round trip errors" : "ADL: quantize round trip errors",
+                   0, quantize_errors);
+
+            uint8_t probability = classifier.classify(window, FALL_CLASSIFIER_WINDOW);
+            uint32_t feature_errors = 0;
+            for (uint8_t f = 0; f < FALL_FEATURE_COUNT; f++) {
+                feature_errors += classifier.getFeatures()[f] != GOLDEN_FEATURES[g][f];
+            }
+            expect("  feature mismatches", 0, feature_errors);
+            expect("  logit (Q8)", GOLDEN_LOGIT[g], classifier.getLogit());
+            expect("  probability (%)", GOLDEN_PROBABILITY[g], probability);
+
+            if (GOLDEN_FALL[g] && probability < min_fall) min_fall = probability;
+            if (!GOLDEN_FALL[g] && probability > max_adl) max_adl = probability;
+        }
+        expectTrue("every fall above every ADL", min_fall > max_adl);
+        classifier.printFeatures();
+    }
+    Serial.println();
+
+    // Test 2: Window timing
+    Serial.println("TEST 2: Window Timing");
+    Serial.println("----------------------");
+    {
+        const uint32_t length = FALL_CLASSIFIER_POST_SAMPLES + 20;
+        FallStatus_t statuses[length];
+        for (uint32_t i = 0; i < length; i++) statuses[i] = FALL_STATUS_STAGE3_ROTATION;
+        statuses[0] = FALL_STATUS_STAGE1_FREEFALL;
+        statuses[1] = FALL_STATUS_STAGE2_IMPACT;
+        statuses[2] = FALL_STATUS_STAGE2_IMPACT;
+
+        classifier.reset();
+        expect("completes POST_SAMPLES after impact", 1 + FALL_CLASSIFIER_POST_SAMPLES,
+               samplesToWindow(classifier, statuses, length));
+
+        // Detector resets mid-window; the window still completes
+        for (uint32_t i = 3; i < length; i++) statuses[i] = FALL_STATUS_MONITORING;
+        classifier.reset();
+        expect("completes after detector reset", 1 + FALL_CLASSIFIER_POST_SAMPLES,
+               samplesToWindow(classifier, statuses, length));
+        expect("no second window without impact", -1, samplesToWindow(classifier, statuses + 3, length - 3));
+
+        // A second impact inside the window does not restart it
+        statuses[10] = FALL_STATUS_STAGE2_IMPACT;
+        classifier.reset();
+        expect("second impact ignored", 1 + FALL_CLASSIFIER_POST_SAMPLES,
+               samplesToWindow(classifier, statuses, length));
+
+        classifier.reset();
+        classifier.observe(FALL_STATUS_STAGE2_IMPACT);
+        classifier.reset();
+        expect("reset drops a pending window", -1, samplesToWindow(classifier, statuses + 3, 5));
+        expectTrue("reset clears the result", !classifier.hasResult());
+    }
+    Serial.println();
+
+    // Test 3: Edge cases
+    Serial.println("TEST 3: Edge Cases");
+    Serial.println("-------------------");
+    {
+        int16_t features[FALL_FEATURE_COUNT];
+        classifier.reset();
+        expect("empty window scores 0", 0, classifier.classify(window, 0));
+        expectTrue("empty window leaves no result", !classifier.hasResult());
+
+        // Oversized: only the newest FALL_CLASSIFIER_WINDOW samples count
+        loadGolden(0, window + 20);
+        for (uint8_t i = 0; i < 20; i++) window[i] = window[20];
+        window[0].accel_x = 15.9f;
+        uint8_t newest = classifier.classify(window, FALL_CLASSIFIER_WINDOW + 20);
+        expect("oversized window uses the newest samples", GOLDEN_PROBABILITY[0], newest);
+
+        SensorData_t extreme = window[20];
+        extreme.accel_x = 1e6f;
+        extreme.accel_y = -1e6f;
+        extreme.accel_z = NAN;
+        extreme.gyro_x = INFINITY;
+        FallImuSample_t q;
+        FallClassifier::quantize(extreme, q);
+        expect("accel saturates high", 32767, q.accel[0]);
+        expect("accel saturates low", -32767, q.accel[1]);
+        expect("NaN quantizes to 0", 0, q.accel[2]);
+        expect("infinite gyro saturates", 32767, q.gyro[0]);
+
+        // Full-scale samples on every axis must not overflow the magnitudes
+        FallImuSample_t full[FALL_CLASSIFIER_WINDOW];
+        for (uint8_t i = 0; i < FALL_CLASSIFIER_WINDOW; i++) {
+            for (uint8_t axis = 0; axis < 3; axis++) {
+                full[i].accel[axis] = 32767;
+                full[i].gyro[axis] = -32767;
+            }
+        }
+        FallClassifier::extractFeatures(full, FALL_CLASSIFIER_WINDOW, features);
+        expect("full-scale peak clamps", 32767, features[FALL_FEATURE_PEAK_ACCEL]);
+        expect("full-scale tilt", 1000, features[FALL_FEATURE_TILT]);
+
+        // Zero gravity at both ends leaves tilt undefined; reported level
+        memset(full, 0, sizeof(full));
+        FallClassifier::extractFeatures(full, FALL_CLASSIFIER_WINDOW, features);
+        expect("zero window tilt", 1000, features[FALL_FEATURE_TILT]);
+        expect("zero window peak", 0, features[FALL_FEATURE_PEAK_ACCEL]);
+    }
+    Serial.println();
+
+    // Test 4: Probability table
+    Serial.println("TEST 4: Probability Table");
+    Serial.println("--------------------------");
+    {
+        uint32_t decreases = 0;
+        for (uint16_t i = 1; i < FALL_MODEL_SIGMOID_SIZE; i++) {
+            decreases += FALL_MODEL_SIGMOID[i] < FALL_MODEL_SIGMOID[i - 1];
+        }
+        expect("table decreases", 0, decreases);
+        expect("logit 0", 50, FallClassifier::toProbability(0));
+        expect("very negative logit", 0, FallClassifier::toProbability(-1000000));
+        expect("very positive logit", 100, FallClassifier::toProbability(1000000));
+        expect("INT32_MIN logit", 0, FallClassifier::toProbability(INT32_MIN));
+    }
+    Serial.println();
+
+    // Test 5: Inference time
+    Serial.println("TEST 5: Inference Time");
+    Serial.println("-----------------------");
+    {
+        loadGolden(0, window);
+        volatile uint32_t sink = 0;
+#ifdef ARDUINO
+        uint32_t start_cycles = ESP.getCycleCount();
+#endif
+        uint32_t start = micros();
+        for (uint32_t r = 0; r < TIMING_ROUNDS; r++) {
+            window[r % FALL_CLASSIFIER_WINDOW].gyro_z = (float)(r & 7);
+            sink += classifier.classify(window, FALL_CLASSIFIER_WINDOW);
+        }
+        float inference_us = (float)(micros() - start) / TIMING_ROUNDS;
+
+        Serial.print("Inference:    ");
+        Serial.print(inference_us, 1);
+        Serial.println(" us");
+#ifdef ARDUINO
+        Serial.print("Cycles:       ");
+        Serial.println((ESP.getCycleCount() - start_cycles) / TIMING_ROUNDS);
+#endif
+        Serial.print("(checksum ");
+        Serial.print(sink);
+        Serial.println(")");
+        expectTrue("inference within budget", inference_us < INFERENCE_BUDGET_US);
+    }
+    Serial.println();
+
+    Serial.print("Passed: ");
+    Serial.print(passed);
+    Serial.print("  Failed: ");
+    Serial.println(failed);
+
+    Serial.println("========================================");
+    Serial.println(failed == 0 ? "      ALL TESTS PASSED" : "      TESTS FAILED");
+    Serial.println("========================================");
+}
+
+void loop() {
+    delay(1000);
+}
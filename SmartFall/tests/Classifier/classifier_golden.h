@@ -0,0 +1,433 @@
+#ifndef CLASSIFIER_GOLDEN_H
+#define CLASSIFIER_GOLDEN_H
+
+// Generated by tools/fall_sim/train_classifier.cpp --write; do not edit.
+// Held-out impact windows (mg, dps) and the reference classifier output.
+
+#define GOLDEN_WINDOWS 4
+
+static const bool GOLDEN_FALL[GOLDEN_WINDOWS] = {true, true, false, false};
+
+static const int16_t GOLDEN_SAMPLES[GOLDEN_WINDOWS][FALL_CLASSIFIER_WINDOW][6] = {
+    {  // fall forward
+        {219, -7, 510, -1, 143, -1},
+        {235, -1, 527, -1, 151, -3},
+        {237, -24, 474, -1, 158, -4},
+        {251, -14, 464, -2, 166, -3},
+        {235, -10, 434, -2, 174, -2},
+        {223, -27, 445, -1, 180, -2},
+        {251, -19, 422, 0, 191, -3},
+        {249, -19, 434, -1, 198, -2},
+        {244, -36, 377, -2, 207, -2},
+        {240, -8, 359, -2, 216, -1},
+        {243, -11, 348, -3, 223, -3},
+        {198, 0, 319, -1, 231, -3},
+        {239, -19, 320, -2, 240, -4},
+        {217, -43, 308, -1, 248, -3},
+        {228, -5, 259, -2, 255, -4},
+        {235, -30, 283, -1, 264, -2},
+        {208, -24, 217, -2, 271, -2},
+        {208, -58, 211, -2, 279, -3},
+        {255, 13, 246, 0, 287, -3},
+        {223, -36, 239, -2, 294, -3},
+        {256, -19, 203, -1, 301, 0},
+        {219, -21, 193, -3, 306, -3},
+        {215, -21, 179, -1, 315, -4},
+        {234, -48, 211, -1, 323, -2},
+        {233, -1, 175, -3, 329, -2},
+        {242, -29, 214, -1, 334, -4},
+        {274, -35, 145, -1, 343, -3},
+        {253, -52, 190, -1, 347, -4},
+        {313, -46, 162, -1, 355, -4},
+        {259, -33, 180, -1, 361, -3},
+        {239, -19, 153, -3, 365, -3},
+        {297, 18, 156, -1, 373, -2},
+        {297, 21, 177, -2, 375, -2},
+        {250, -27, 123, -1, 379, -2},
+        {272, 4, 162, -1, 385, -3},
+        {278, -30, 123, 1, 390, -4},
+        {253, 13, 94, -2, 393, -2},
+        {300, -28, 123, 0, 396, -3},
+        {317, -17, 107, -2, 401, -2},
+        {308, -20, 119, -2, 403, -1},
+        {285, -21, 103, -2, 405, -3},
+        {280, -38, 101, -2, 409, -2},
+        {281, -25, 138, -2, 411, -3},
+        {300, -39, 94, -1, 414, -3},
+        {272, -21, 112, 0, 413, -3},
+        {304, -23, 105, -3, 417, -3},
+        {307, -21, 124, -2, 417, -3},
+        {324, -27, 72, 0, 417, -1},
+        {303, -14, 101, -3, 418, -4},
+        {3114, -3, 781, 0, 406, -2},
+        {6506, -51, 1644, 1, 381, -2},
+        {7058, -18, 1803, 1, 358, -3},
+        {4299, -33, 1086, 0, 333, -2},
+        {972, -15, 258, -1, 315, -2},
+        {1064, 2, 268, -1, 290, -3},
+        {1124, -33, 335, -2, 274, -2},
+        {1130, -53, 300, -1, 256, -4},
+        {1070, -28, 294, -2, 241, -2},
+        {988, -17, 289, -1, 222, -2},
+        {878, -27, 278, -1, 210, -4},
+        {877, 5, 224, -2, 195, -3},
+        {845, 4, 244, -2, 182, -2},
+        {838, 11, 220, -2, 170, -3},
+        {850, -31, 206, -1, 160, -5},
+        {909, -11, 265, -1, 148, -3},
+        {920, -37, 252, -2, 140, -2},
+        {980, -55, 237, 0, 131, -4},
+        {976, -36, 253, -1, 122, -3},
+        {996, -4, 261, -2, 115, -2},
+        {966, 3, 264, -2, 108, -2},
+        {941, -21, 260, 0, 99, -3},
+        {950, -12, 235, 0, 93, -3},
+        {915, -1, 247, -1, 88, -4},
+        {926, -49, 234, 1, 84, -3},
+        {910, 11, 252, -2, 76, -3},
+        {955, -43, 206, 0, 71, -3},
+        {902, -9, 257, -3, 68, -3},
+        {945, -22, 283, 0, 61, -2},
+        {937, -20, 268, -1, 60, -1},
+        {955, -14, 236, -2, 54, -1},
+        {941, -35, 255, 0, 51, 0},
+        {936, -27, 267, -1, 48, -2},
+        {904, -61, 289, 0, 43, -4},
+        {964, -3, 273, -3, 42, -4},
+        {916, -9, 245, -1, 37, -1},
+        {945, -27, 259, -1, 37, -4},
+        {954, 5, 267, 0, 33, -1},
+        {926, -46, 259, -1, 33, -1},
+        {937, -19, 251, -1, 31, -3},
+        {899, -40, 223, -2, 27, -4},
+        {984, -30, 237, 1, 26, -2},
+        {929, -34, 285, -2, 26, -3},
+        {934, -34, 281, 0, 22, -3},
+        {951, -18, 274, -1, 22, -3},
+        {908, -10, 256, -1, 18, -5},
+        {898, -21, 237, -2, 19, -2},
+        {935, 1, 254, -1, 18, -2},
+        {914, 7, 246, -2, 16, -3},
+        {925, -13, 248, 0, 14, -3},
+        {911, -21, 284, 0, 16, -3}
+    },
+    {  // fall lateral
+        {16, 261, 599, -109, 1, 0},
+        {12, 309, 578, -119, -1, 0},
+        {-17, 307, 565, -129, -1, 1},
+        {21, 300, 569, -136, 1, 0},
+        {35, 312, 515, -146, -3, -3},
+        {48, 305, 485, -155, 2, -1},
+        {-15, 332, 473, -159, 1, 0},
+        {8, 331, 456, -169, -1, -1},
+        {11, 351, 443, -180, 0, -1},
+        {16, 371, 381, -188, 0, 0},
+        {25, 386, 365, -200, -1, -1},
+        {-9, 354, 344, -206, -1, -1},
+        {40, 341, 409, -213, -2, 0},
+        {7, 355, 324, -221, 0, 0},
+        {12, 384, 334, -233, 0, 0},
+        {5, 328, 334, -243, -2, -1},
+        {17, 341, 320, -251, 2, -1},
+        {-4, 349, 245, -260, 0, -1},
+        {0, 361, 234, -270, 0, -1},
+        {13, 358, 234, -276, 2, 0},
+        {-3, 328, 241, -284, -1, -1},
+        {-9, 340, 233, -292, 1, -1},
+        {7, 349, 203, -302, 2, 0},
+        {27, 351, 203, -311, 0, -2},
+        {24, 368, 200, -316, -2, -2},
+        {-22, 375, 157, -325, 0, -2},
+        {42, 375, 178, -331, -1, -2},
+        {7, 349, 159, -340, -3, -1},
+        {39, 398, 153, -346, 0, 0},
+        {49, 400, 168, -352, 0, -1},
+        {-6, 388, 129, -360, -1, -2},
+        {-2, 372, 90, -367, -1, -1},
+        {14, 368, 128, -372, -1, 0},
+        {-16, 373, 119, -376, 0, 0},
+        {41, 401, 102, -381, 0, -2},
+        {67, 395, 91, -387, 1, -1},
+        {46, 415, 78, -392, 1, 2},
+        {20, 371, 151, -395, 2, -1},
+        {23, 460, 102, -398, 0, 2},
+        {25, 426, 98, -404, 0, -1},
+        {33, 414, 81, -407, -1, -1},
+        {-5, 375, 107, -408, 0, -2},
+        {29, 426, 40, -412, -3, 1},
+        {4, 420, 83, -413, 0, -1},
+        {17, 393, 65, -415, -1, -2},
+        {-30, 395, 124, -416, 0, -1},
+        {28, 399, 52, -418, 1, -3},
+        {-24, 415, 72, -418, 0, 0},
+        {5, 1893, 439, -406, -1, 1},
+        {27, 3846, 885, -381, -1, -2},
+        {24, 4836, 1133, -355, -1, 1},
+        {-33, 4889, 1081, -334, 0, 0},
+        {-30, 3948, 913, -314, 0, -1},
+        {-33, 1869, 379, -289, -1, -1},
+        {18, 1057, 228, -274, 0, 0},
+        {21, 1160, 263, -254, 0, -1},
+        {-10, 1215, 270, -241, 2, -2},
+        {32, 1222, 261, -225, 2, -1},
+        {25, 1109, 235, -210, -1, 0},
+        {39, 1060, 208, -193, 0, -1},
+        {-7, 963, 202, -184, 2, 1},
+        {11, 922, 170, -170, 1, 0},
+        {0, 896, 189, -162, -1, -1},
+        {8, 917, 196, -149, 1, 0},
+        {9, 992, 219, -140, 1, 0},
+        {40, 984, 226, -130, 1, -2},
+        {-13, 1058, 223, -123, 0, 0},
+        {25, 1041, 220, -115, 1, -2},
+        {43, 1064, 265, -107, -1, -1},
+        {2, 1062, 227, -101, 0, -1},
+        {1, 1046, 216, -96, 0, -1},
+        {-4, 1010, 237, -88, 1, -1},
+        {2, 1057, 206, -82, 1, -1},
+        {-15, 985, 212, -76, 0, -1},
+        {37, 985, 188, -72, -1, -1},
+        {23, 1005, 232, -66, 2, 0},
+        {-38, 1022, 180, -63, 0, -1},
+        {-14, 1002, 200, -59, 0, -2},
+        {24, 1002, 229, -54, 0, -1},
+        {26, 1044, 224, -52, -2, 0},
+        {57, 1023, 222, -48, -1, 0},
+        {54, 1042, 225, -46, 0, -1},
+        {18, 1014, 212, -45, 1, -1},
+        {22, 988, 204, -38, 0, 1},
+        {19, 1049, 221, -36, -1, -2},
+        {37, 990, 240, -36, 1, -1},
+        {16, 1025, 223, -33, 1, -1},
+        {9, 985, 229, -31, -1, -1},
+        {-5, 1000, 200, -28, -2, 0},
+        {41, 993, 206, -27, 0, -2},
+        {14, 972, 242, -25, -1, 0},
+        {52, 1047, 238, -23, 0, -1},
+        {4, 1027, 247, -24, 1, 0},
+        {39, 1016, 200, -20, -1, 1},
+        {7, 1029, 217, -20, 0, 1},
+        {25, 1010, 213, -19, -2, -1},
+        {17, 1025, 201, -18, 1, 0},
+        {-25, 1011, 207, -16, 0, -1},
+        {8, 976, 217, -15, -1, -1},
+        {2, 1029, 220, -14, 1, -2}
+    },
+    {  // device drop
+        {-37, 55, 985, -1, -3, 3},
+        {-25, 34, 16, -1, -6, 3},
+        {6, 19, 30, 0, -2, 4},
+        {-30, 41, -24, -3, -4, 3},
+        {-28, 36, -13, -6, -4, 4},
+        {-59, 16, 46, -9, -5, 4},
+        {-18, 20, -4, -14, -5, 3},
+        {7, 53, 17, -19, -8, 4},
+        {3, 24, -4, -25, -11, 4},
+        {-67, 24, -17, -34, -13, 3},
+        {-53, 30, 21, -42, -14, 1},
+        {2, 30, 6, -52, -17, 2},
+        {-32, 38, 25, -64, -20, 3},
+        {-7, 17, 32, -73, -24, 3},
+        {-49, 19, -14, -87, -26, 1},
+        {-59, 47, -4, -100, -31, 3},
+        {-29, 19, -8, -111, -34, 3},
+        {15, 22, 15, -127, -39, 2},
+        {-29, 27, 0, -143, -42, 1},
+        {-28, 79, 42, -159, -44, 1},
+        {-46, 45, 31, -173, -49, 4},
+        {18, 31, -12, -191, -55, 2},
+        {-23, 42, 2, -203, -58, 3},
+        {-53, 59, -5, -222, -64, 3},
+        {12, 25, 15, -237, -68, 3},
+        {-49, 70, -17, -254, -74, 4},
+        {-60, 17, -12, -269, -76, 4},
+        {-56, 48, 5, -286, -82, 3},
+        {-24, 46, 18, -302, -85, 3},
+        {-27, 65, 46, -320, -89, 2},
+        {-51, 49, 31, -334, -94, 3},
+        {-36, 15, -1, -347, -96, 2},
+        {-48, 36, 34, -365, -102, 4},
+        {-19, 64, 27, -379, -105, 4},
+        {-22, 41, 4, -391, -109, 2},
+        {-38, 50, 28, -407, -112, 4},
+        {-20, 38, 9, -417, -116, 3},
+        {-26, 50, 1, -429, -119, 3},
+        {-45, 25, 9, -439, -122, 1},
+        {-39, 32, 28, -448, -124, 4},
+        {0, 37, 32, -458, -127, 5},
+        {-22, 27, 47, -465, -129, 2},
+        {-24, 59, 45, -473, -133, 3},
+        {-24, 54, 32, -479, -135, 4},
+        {-12, 8, -9, -485, -135, 1},
+        {-25, 40, 28, -489, -136, 2},
+        {-20, 45, 31, -492, -137, 1},
+        {-38, 21, 11, -493, -136, 2},
+        {-35, 52, 0, -494, -138, 3},
+        {-88, 311, 3512, -466, -129, 3},
+        {-34, 133, 1060, -438, -123, 3},
+        {-46, 128, 1137, -412, -114, 0},
+        {-53, 119, 1155, -382, -106, 2},
+        {-23, 117, 1131, -359, -98, 2},
+        {-51, 139, 1043, -335, -95, 2},
+        {-44, 107, 959, -312, -86, 2},
+        {-63, 100, 897, -294, -85, 2},
+        {-45, 52, 878, -274, -78, 2},
+        {-71, 105, 875, -258, -72, 2},
+        {-57, 95, 927, -241, -68, 4},
+        {-39, 113, 939, -222, -64, 3},
+        {-62, 82, 987, -210, -60, 3},
+        {-49, 133, 991, -197, -56, 2},
+        {-40, 115, 988, -184, -53, 2},
+        {-44, 89, 1026, -169, -50, 1},
+        {-53, 95, 1012, -159, -45, 2},
+        {-24, 67, 979, -148, -46, 2},
+        {-58, 65, 1005, -139, -40, 4},
+        {-25, 74, 982, -129, -37, 5},
+        {-39, 90, 949, -124, -38, 2},
+        {-69, 116, 960, -114, -35, 2},
+        {-45, 93, 950, -107, -31, 2},
+        {-47, 141, 955, -102, -31, 3},
+        {-11, 77, 951, -94, -28, 3},
+        {-31, 98, 984, -87, -28, 2},
+        {-6, 135, 986, -82, -26, 3},
+        {-61, 128, 1002, -77, -24, 2},
+        {-15, 130, 962, -72, -22, 2},
+        {-63, 130, 972, -68, -22, 2},
+        {-29, 98, 958, -63, -19, 2},
+        {-47, 91, 944, -58, -19, 2},
+        {-29, 86, 988, -55, -19, 0},
+        {-56, 142, 965, -52, -17, 5},
+        {-25, 90, 971, -49, -16, 3},
+        {-45, 118, 987, -45, -15, 2},
+        {-34, 104, 1003, -43, -15, 3},
+        {-33, 137, 982, -39, -13, 3},
+        {-51, 102, 942, -36, -11, 4},
+        {-39, 94, 977, -35, -11, 4},
+        {-31, 105, 966, -32, -12, 1},
+        {-29, 128, 973, -30, -11, 2},
+        {-64, 121, 992, -28, -11, 3},
+        {-55, 117, 980, -25, -9, 4},
+        {-27, 97, 974, -24, -10, 2},
+        {-51, 71, 971, -21, -9, 2},
+        {-55, 119, 962, -21, -9, 3},
+        {-98, 125, 970, -20, -9, 3},
+        {-14, 104, 1004, -16, -6, 2},
+        {-83, 119, 981, -18, -10, 3},
+        {-51, 132, 962, -16, -7, 3}
+    },
+    {  // device drop
+        {16, -15, 52, 0, -1, 3},
+        {46, -31, 89, 0, -1, 2},
+        {56, -52, 90, -4, -1, 0},
+        {59, -52, 66, -7, 4, 0},
+        {57, -33, 14, -13, 6, 2},
+        {52, -25, 46, -21, 12, 2},
+        {47, -34, 58, -28, 17, 2},
+        {99, -42, 59, -38, 25, -2},
+        {24, -21, 19, -47, 32, 0},
+        {46, -39, 50, -60, 41, 0},
+        {72, -31, 51, -76, 52, 2},
+        {64, -49, 30, -90, 63, 2},
+        {51, -26, 10, -106, 72, 1},
+        {19, 12, 25, -125, 87, -1},
+        {51, -4, 69, -141, 98, 3},
+        {23, -26, 35, -163, 113, 1},
+        {104, 7, 42, -181, 128, 0},
+        {49, -22, 48, -203, 143, 2},
+        {77, -14, 35, -225, 158, 1},
+        {89, -28, 57, -245, 171, -1},
+        {76, 10, 58, -269, 187, -1},
+        {91, -14, 40, -292, 203, 1},
+        {92, 6, 39, -315, 223, 1},
+        {70, 20, 15, -343, 241, 0},
+        {81, 5, 17, -366, 257, 0},
+        {108, 36, -1, -387, 272, -1},
+        {93, 8, 36, -414, 291, 1},
+        {62, 17, 30, -437, 310, 0},
+        {104, 11, -17, -460, 324, 1},
+        {67, 32, 15, -482, 341, 0},
+        {90, 15, 3, -507, 361, 1},
+        {80, 10, -9, -529, 374, 0},
+        {102, 20, -55, -550, 388, -1},
+        {89, 21, 2, -572, 404, 1},
+        {93, 12, 12, -589, 416, 1},
+        {100, 10, -46, -612, 432, 1},
+        {84, -27, -38, -626, 443, 0},
+        {88, -24, -16, -644, 456, 1},
+        {76, -9, -81, -663, 465, 2},
+        {74, 8, -58, -676, 480, 1},
+        {60, -6, -73, -690, 489, 0},
+        {93, 16, -54, -702, 497, 0},
+        {83, -14, -42, -714, 504, 2},
+        {86, 8, -48, -720, 511, 2},
+        {79, -23, -54, -732, 516, 1},
+        {35, 9, -98, -738, 521, 1},
+        {88, 10, -62, -740, 527, 1},
+        {57, 31, -67, -746, 526, 0},
+        {76, -19, -70, -749, 530, 1},
+        {2338, 3250, -4017, -742, 525, 0},
+        {475, 531, -770, -690, 489, 1},
+        {527, 626, -840, -645, 454, -1},
+        {511, 664, -871, -608, 431, 1},
+        {483, 635, -817, -568, 399, 1},
+        {541, 604, -792, -526, 372, 1},
+        {459, 555, -733, -494, 348, 0},
+        {440, 515, -704, -464, 326, 1},
+        {421, 492, -657, -436, 307, 2},
+        {438, 471, -670, -407, 288, 0},
+        {437, 510, -653, -381, 270, 3},
+        {463, 455, -681, -356, 250, 0},
+        {485, 542, -678, -330, 234, 1},
+        {508, 570, -685, -310, 217, 0},
+        {439, 514, -742, -293, 206, 0},
+        {485, 539, -767, -268, 191, 1},
+        {477, 586, -753, -255, 179, 0},
+        {441, 545, -714, -239, 165, 1},
+        {462, 547, -710, -224, 156, 1},
+        {475, 504, -718, -210, 147, 3},
+        {444, 502, -685, -195, 136, -1},
+        {451, 530, -717, -183, 129, 2},
+        {446, 522, -699, -173, 119, 0},
+        {438, 516, -716, -160, 111, 1},
+        {449, 554, -716, -150, 106, 0},
+        {476, 530, -722, -140, 97, 0},
+        {458, 520, -768, -131, 90, 1},
+        {447, 539, -670, -124, 86, 1},
+        {436, 546, -715, -115, 79, 1},
+        {461, 542, -727, -107, 73, 1},
+        {433, 531, -706, -99, 69, 2},
+        {449, 542, -699, -95, 64, 1},
+        {465, 563, -691, -89, 61, 0},
+        {446, 555, -680, -83, 57, 2},
+        {450, 530, -745, -78, 53, 1},
+        {462, 529, -729, -73, 50, 0},
+        {455, 518, -703, -68, 46, 1},
+        {483, 563, -692, -63, 42, 2},
+        {457, 523, -715, -60, 40, 1},
+        {485, 536, -733, -55, 38, 0},
+        {463, 521, -711, -52, 34, 0},
+        {444, 530, -706, -48, 32, 2},
+        {498, 576, -730, -45, 31, 0},
+        {437, 497, -710, -43, 29, 2},
+        {448, 534, -700, -39, 27, 1},
+        {441, 539, -740, -37, 24, 1},
+        {435, 524, -721, -36, 23, 1},
+        {463, 524, -723, -32, 22, 2},
+        {420, 550, -732, -31, 19, 1},
+        {491, 536, -717, -29, 17, 1},
+        {456, 500, -729, -27, 18, 0}
+    }
+};
+
+static const int16_t GOLDEN_FEATURES[GOLDEN_WINDOWS][FALL_FEATURE_COUNT] = {
+    {7284, 270, 541, 48, 318, 418, 3, 40, 25, 66, 693},
+    {5007, 382, 650, 43, 304, 418, 4, 42, 28, 63, 699},
+    {3526, 17, 74, 48, 250, 512, 1, 22, 19, 87, 974},
+    {5671, 33, 90, 49, 450, 917, 1, 19, 26, 163, -422}
+};
+
+static const int32_t GOLDEN_LOGIT[GOLDEN_WINDOWS] = {1761, 1859, -1791, -1674};
+
+static const uint8_t GOLDEN_PROBABILITY[GOLDEN_WINDOWS] = {100, 100, 0, 0};
+
+#endif // CLASSIFIER_GOLDEN_H
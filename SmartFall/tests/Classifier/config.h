@@ -0,0 +1,233 @@
+#ifndef CONFIG_H
+#define CONFIG_H
+
+// System configuration constants
+#define SENSOR_SAMPLE_RATE_HZ       100
+#define DETECTION_WINDOW_MS         10000
+#define ALERT_TIMEOUT_MS           30000
+#define BATTERY_LOW_THRESHOLD      3.3f
+
+// Algorithm thresholds
+#define FREEFALL_THRESHOLD_G       0.5f
+#define IMPACT_THRESHOLD_G         3.0f
+#define ROTATION_THRESHOLD_DPS     250.0f
+#define INACTIVITY_THRESHOLD_MS    2000
+#define PRESSURE_CHANGE_THRESHOLD_M 1.0f
+
+// Pin Definitions (ESP32 HUZZAH32 Feather)
+#define MPU6050_SDA_PIN            23    // I2C Data
+#define MPU6050_SCL_PIN            22    // I2C Clock
+#define BMP280_SDA_PIN             23    // I2C Data (shared)
+#define BMP280_SCL_PIN             22    // I2C Clock (shared)
+#define MAX30102_SDA_PIN           23    // I2C Data (shared)
+#define MAX30102_SCL_PIN           22    // I2C Clock (shared)
+#define FSR_ANALOG_PIN             A2    // Force sensor analog input
+#define SOS_BUTTON_PIN             15    // SOS button with pull-up
+#define SPEAKER_PIN                25    // Audio alert output
+#define HAPTIC_PIN                 26    // Haptic motor control
+#define VISUAL_ALERT_PIN           27    // Visual alert LED
+#define BATTERY_SENSE_PIN          A13   // Battery voltage monitoring
+
+// Display pins (I2C shared bus)
+#define DISPLAY_SDA_PIN            23    // I2C Data
+#define DISPLAY_SCL_PIN            22    // I2C Clock
+#define DISPLAY_ADDRESS            0x3C  // OLED I2C address
+
+// WiFi Configuration
+#define WIFI_SSID                  "Your_WiFi_SSID"
+#define WIFI_PASSWORD              "Your_WiFi_Password"
+#define WIFI_TIMEOUT_MS            10000
+#define WIFI_RECONNECT_INTERVAL_MS 30000
+#define WIFI_MAX_RECONNECT_ATTEMPTS 5
+
+// Server Configuration
+#define SERVER_URL                 "http://your-server.com"  // Your alert server URL
+#define SERVER_PORT                80
+#define SERVER_CA_CERT             nullptr  // PEM root CA for https:// (nullptr skips verification)
+
+// HTTP Keep-Alive Configuration
+#define HTTP_KEEPALIVE_ENABLED     true   // Reuse one socket; false opens one per request
+#define HTTP_HEARTBEAT_INTERVAL_MS 20000  // Idle HEAD probe; keep below the server's keep-alive timeout
+#define HTTP_HEARTBEAT_PATH        "/api/ping"
+#define HTTP_CONNECT_TIMEOUT_MS    5000   // TCP + TLS handshake
+#define HTTP_RESPONSE_TIMEOUT_MS   10000
+#define HTTP_HEARTBEAT_TIMEOUT_MS  1000   // Idle HEAD on the alert socket; an alert may wait this long
+#define HTTP_STATUS_TIMEOUT_MS     5000   // Status POST response; keeps the comms task inside COMMS_RESTART_MS
+#define WIFI_LOCK_WAIT_MS          1000   // Comms task wait for a connection in use; then skipped
+
+// BLE Configuration
+#define BLE_DEVICE_NAME            "SmartFall"
+#define BLE_STREAMING_INTERVAL_MS  1000   // Sensor data streaming rate
+
+// Emergency Alert Configuration
+#define EMERGENCY_MAX_RETRIES      3
+#define EMERGENCY_RETRY_INTERVAL_MS 5000
+#define EMERGENCY_BINARY_PAYLOAD   true   // Compact binary alert (Alert_Codec.h); false sends JSON
+#define EMERGENCY_PAYLOAD_LZ       true   // LZ pass over the delta-coded history
+
+// Alert Dispatch Configuration (WiFi and BLE sent in parallel)
+#define ALERT_WIFI_DEADLINE_MS     8000   // Server confirmation (HTTP 2xx)
+#define ALERT_BLE_DEADLINE_MS      3000   // Phone confirmation
+#define ALERT_DISPATCH_TASK_STACK  8192   // TLS handshake runs on the WiFi task
+#define ALERT_DISPATCH_TASK_PRIORITY 2    // Above loop(): alerts go out first
+
+// BLE Alert Acknowledgement (Alert_Ack.h)
+#define ALERT_ACK_INITIAL_RTO_MS   500    // Resend timeout before the first RTT sample
+#define ALERT_ACK_MIN_RTO_MS       100
+#define ALERT_ACK_MAX_RTO_MS       2000
+#define ALERT_ACK_MAX_ATTEMPTS     8      // Copies of one alert before giving up
+
+// System Metrics Configuration
+#define METRICS_SAMPLE_INTERVAL_MS 1000   // Heap/stack sampling rate
+#define METRICS_WINDOW_MS          300000 // Ring window (12 x 5 min = 1 hour)
+#define METRICS_MAX_TASKS          10     // Tasks tracked for stack headroom
+
+// Data Logger Configuration
+#define DATA_LOGGER_PARTITION      "spiffs" // Raw flash ring for sensor traces
+#define DATA_LOGGER_AUTOSTART      false  // Start recording at boot
+#define DATA_LOGGER_TASK_STACK     3072
+#define DATA_LOGGER_TASK_PRIORITY  1
+
+// Sensor Sample Source (see sensors/Sample_Source.h)
+#define SENSOR_SOURCE_HARDWARE     0      // MPU6050/BMP280/MAX30102/FSR
+#define SENSOR_SOURCE_SYNTHETIC    1      // Built-in rest/walk/fall cycle, no sensors needed
+#define SENSOR_SOURCE              SENSOR_SOURCE_HARDWARE
+
+// Accelerometer auto-ranging (see sensors/Accel_Ranger.h)
+#define ACCEL_AUTORANGE_ENABLED    true
+#define ACCEL_RANGE_LOW_G          8      // Full scale while quiet
+#define ACCEL_RANGE_HIGH_G         16     // Full scale around impacts
+#define ACCEL_RANGE_UP_G           4.0f   // Any axis beyond this switches up (half the low scale)
+#define ACCEL_RANGE_DOWN_G         2.0f   // Every axis within this counts as quiet
+#define ACCEL_RANGE_QUIET_SAMPLES  200    // Quiet samples before switching back (2 s)
+#define ACCEL_RANGE_FREEFALL_SAMPLES 3    // Below FREEFALL_THRESHOLD_G; switches up ahead of the impact
+
+// High-rate IMU profile (see sensors/IMU_Decimator.h)
+#define IMU_SAMPLE_RATE_HZ         1000   // MPU6050 FIFO rate (divides 1000); SENSOR_SAMPLE_RATE_HZ reads registers instead
+#define IMU_I2C_CLOCK_HZ           400000 // Fast mode; 1 kHz frames need about a third of it
+#define IMU_FIFO_BURST_FRAMES      10     // Frames per I2C read (ESP32 Wire buffer is 128 bytes)
+
+// Barometric altitude filter (see sensors/Altitude_Filter.h)
+#define ALTITUDE_BLOCK_MS          100    // Heights averaged per history block
+#define ALTITUDE_WINDOW_BLOCKS     10     // Pre- and post-event windows (1 s)
+#define ALTITUDE_GAP_BLOCKS        10     // Pre window ends this long before the event (covers the descent)
+#define ALTITUDE_BASELINE_TAU_S    60.0f  // Slow baseline: follows the weather, not a fall
+#define ALTITUDE_KALMAN_ENABLED    false  // Fuse vertical acceleration into the height (altitude_eval compares)
+#define ALTITUDE_BARO_NOISE_M      0.15f  // Barometer height noise per sample (1 sigma)
+#define ALTITUDE_ACCEL_NOISE_MS2   2.0f   // |accel| is only partly vertical on a wrist (1 sigma)
+#define ALTITUDE_GRAVITY_TAU_S     2.0f   // |accel| at rest, absorbs accelerometer bias
+
+// Sensor health and recovery (see sensors/Sensor_Health.h, sensors/Sensor_Supervisor.h)
+#define SENSOR_FAIL_ERRORS         5      // Bad reads in a row before a sensor is dropped (50 ms)
+#define SENSOR_IMU_STUCK_SAMPLES   50     // Identical IMU readings (noise moves an LSB every sample)
+#define SENSOR_PRESSURE_STUCK_SAMPLES 500 // Identical pressure readings (5 s; the BMP280 converts at ~25 Hz)
+#define SENSOR_PRESSURE_MIN_HPA    300.0f // BMP280 rated range
+#define SENSOR_PRESSURE_MAX_HPA    1100.0f
+#define SENSOR_REINIT_BACKOFF_MS   500    // First re-init attempt; doubles per failure
+#define SENSOR_REINIT_MAX_BACKOFF_MS 30000
+#define SENSOR_SUPERVISOR_MAX      4      // Sensors one supervisor can re-init
+#define SENSOR_HEALTH_INTERVAL_MS  100    // Supervisor period
+#define SENSOR_HEALTH_TASK_STACK   4096   // Driver begin() calls run on it
+#define SENSOR_HEALTH_TASK_PRIORITY 0     // Below loop(): never delays the sensor tick
+#define I2C_TIMEOUT_MS             5      // Per transaction, so a dead bus cannot stall the tick
+#define I2C_RECOVERY_CLOCKS        9      // A byte and its ACK: frees a slave stuck mid-transfer
+#define I2C_STRETCH_TIMEOUT_US     1000   // Longest clock stretch waited out during recovery
+#define I2C_BOOT_LOCK_MS           1000   // Background sensor bring-up waits this long for the bus
+
+// Task watchdog (see system/Task_Watchdog.h)
+#define WATCHDOG_MAX_TASKS         6
+#define WATCHDOG_INTERVAL_MS       100    // Deadline check period
+#define WATCHDOG_TASK_STACK        3072
+#define WATCHDOG_TASK_PRIORITY     3      // Above everything it watches, so a spinning task is still seen
+#define TASK_WDT_TIMEOUT_S         30     // Hardware backstop: reboot. Longer than any restart time
+#define ACQUISITION_DEADLINE_MS    50     // Sensor read, 5 ticks
+#define DETECTION_DEADLINE_MS      50     // Detector and scorer, 5 ticks
+#define COMMS_DEADLINE_MS          12000  // A reconnect: 1 s + WIFI_TIMEOUT_MS
+#define COMMS_RESTART_MS           20000  // Silent this long: the comms task is restarted
+#define COMMS_TASK_STACK           8192   // WiFi reconnect and the status POST run on it
+#define COMMS_TASK_PRIORITY        1      // Same as loop(); it blocks in the network calls
+#define AUDIO_DEADLINE_MS          10000  // Longest cue sequence plus the 1 s event wait
+
+// Deferred logging (see diagnostics/Deferred_Log.h)
+#define DEFERRED_LOG_RING_SIZE     64     // Records (28 B each); power of two
+#define DEFERRED_LOG_BINARY        false  // Raw frames for tools/deferred_log/dlog_decode instead of text
+#define DEFERRED_LOG_INTERVAL_MS   50     // Drain period
+#define DEFERRED_LOG_TASK_STACK    3072
+#define DEFERRED_LOG_TASK_PRIORITY 0      // Below loop(): the UART never delays a sensor tick
+
+// Boot Configuration
+#define BOOT_WORKER_COUNT          3      // Concurrent background init tasks
+#define BOOT_WORKER_STACK          8192   // WiFi/BLE bring-up needs the headroom
+#define BOOT_WORKER_PRIORITY       1
+
+// Timing constants
+#define SENSOR_READ_INTERVAL_MS    10    // 100Hz sensor reading (scheduler base tick)
+#define COMMS_INTERVAL_MS          100   // WiFi/alert queue servicing (comms task and loop)
+#define STATUS_UPDATE_INTERVAL_MS  60000 // Periodic status report
+#define BULK_SERVICE_INTERVAL_MS   10    // BLE log download pump
+#define EVENT_SERVICE_INTERVAL_MS  10    // Alert sequence and event subscribers
+#define HEARTBEAT_INTERVAL_MS      1000  // Status LED blink
+#define SERIAL_BAUD_RATE          115200
+
+// Alert system constants
+#define ALERT_BEEP_DURATION_MS     500
+#define ALERT_BEEP_INTERVAL_MS     1000
+#define HAPTIC_DURATION_MS         5000
+#define COUNTDOWN_DURATION_S       30
+#define SOS_DEBOUNCE_MS            250    // Edges closer than this are contact bounce
+#define ALERT_ALARM_MS             3000   // Beep burst before the voice prompt
+#define ALERT_PROMPT_MS            3000   // "Press button if okay" before the countdown ticks
+#define ALERT_HOLD_MS              5000   // Alarm stays on after escalation
+#define TEST_ALERT_DURATION_MS     2000   // App test alert
+#define ALERT_MOVEMENT_G           0.3f   // |accel| this far from 1 g counts as moving
+#define ALERT_MOVEMENT_DPS         60.0f  // Or rotating faster than this
+#define ALERT_MOVEMENT_CANCEL_MS   1500   // Net moving time that cancels the countdown
+
+// Audio Configuration (PAM8302 Amplifier)
+#define AUDIO_DEFAULT_VOLUME       80     // 0-100, default volume level
+#define AUDIO_PWM_CHANNEL          0      // ESP32 PWM channel for audio
+#define AUDIO_PWM_FREQUENCY        5000   // Base PWM frequency (Hz)
+#define AUDIO_PWM_RESOLUTION       8      // PWM resolution (bits)
+#define AUDIO_ENABLE_VOICE_ALERTS  true   // Enable voice-like alert sequences
+#define AUDIO_TASK_STACK           4096   // Plays event cues off the sensor loop
+#define AUDIO_TASK_PRIORITY        1
+
+// Confidence scoring constants
+#define MAX_CONFIDENCE_SCORE       120   // Four stages + filters + classifier
+#define HIGH_CONFIDENCE_THRESHOLD  80
+#define CONFIRMED_THRESHOLD        70
+#define POTENTIAL_THRESHOLD        50
+#define SUSPICIOUS_THRESHOLD       30
+
+// Fall classifier (see detection/fall_classifier.h)
+#define FALL_CLASSIFIER_ENABLED    true
+#define FALL_CLASSIFIER_WINDOW     100   // History samples per inference (<= SENSOR_HISTORY_SIZE)
+#define FALL_CLASSIFIER_POST_SAMPLES 50  // Collected after the impact before inference
+
+// Buffer sizes
+#define SENSOR_HISTORY_SIZE        100   // 10 seconds at 10Hz
+#define DEVICE_ID_SIZE             32
+#define MESSAGE_BUFFER_SIZE        256
+
+// Debug settings
+#define DEBUG_SENSOR_DATA          false
+#define DEBUG_ALGORITHM_STEPS      false  // Test 5 runs hundreds of inferences
+#define DEBUG_COMMUNICATION        true
+#define DEBUG_PROFILER             false  // Print latency report with each status update
+#define DEBUG_EVENTS               false  // Log every event bus message
+
+// Latency profiler (compiled out entirely when 0). Follows DEBUG_ENABLED, so
+// the release profiles (-DDEBUG_ENABLED=0) leave it out; -D PROFILER_ENABLED
+// overrides either way
+#ifndef PROFILER_ENABLED
+#if defined(DEBUG_ENABLED) && !DEBUG_ENABLED
+#define PROFILER_ENABLED           0
+#else
+#define PROFILER_ENABLED           1
+#endif
+#endif
+
+// Test output configuration
+#define ENABLE_TEST_SERIAL_OUTPUT  false  // Set to false for clean console, logs go to files only
+
+#endif // CONFIG_H
\ No newline at end of file
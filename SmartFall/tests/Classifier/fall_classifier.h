@@ -0,0 +1,85 @@
+#ifndef FALL_CLASSIFIER_H
+#define FALL_CLASSIFIER_H
+
+#include "data_types.h"
+#include "config.h"
+#include <Arduino.h>
+
+/*
+ * Quantized fall classifier that runs alongside the staged detector.
+ *
+ * When FallDetector reports an impact, observe() waits for
+ * FALL_CLASSIFIER_POST_SAMPLES more samples. The caller then passes the
+ * newest FALL_CLASSIFIER_WINDOW samples of the detector history to
+ * classify(). The window is quantized to int16 milli-g and °/s, and
+ * reduced to a few integer features split at the impact peak. A
+ * boosted ensemble of depth-3 trees (fall_classifier_model.h) scores
+ * the features.
+ *
+ * Everything after quantization is integer arithmetic with fixed-size
+ * buffers and no heap. The same source therefore gives bit-identical
+ * features, logits and probabilities on the ESP32 and on the host.
+ * tools/fall_sim/train_classifier.cpp regenerates the model.
+ */
+
+typedef enum {
+    FALL_FEATURE_PEAK_ACCEL,        // mg
+    FALL_FEATURE_PRE_MIN_ACCEL,     // mg, lowest before the peak
+    FALL_FEATURE_PRE_MEAN_ACCEL,    // mg
+    FALL_FEATURE_PRE_LOW_SAMPLES,   // Samples below FALL_FEATURE_LOW_MG before the peak
+    FALL_FEATURE_PRE_GYRO,          // dps, mean before the peak
+    FALL_FEATURE_PEAK_GYRO,         // dps
+    FALL_FEATURE_IMPACT_WIDTH,      // Samples around the peak above half its height
+    FALL_FEATURE_POST_DEVIATION,    // mg, mean |magnitude - 1 g| once settled
+    FALL_FEATURE_POST_JERK,         // mg, mean sample-to-sample change once settled
+    FALL_FEATURE_POST_GYRO,         // dps, mean once settled
+    FALL_FEATURE_TILT,              // cos x 1000 between start and end gravity
+    FALL_FEATURE_COUNT
+} FallFeature_t;
+
+// One quantized IMU sample
+typedef struct {
+    int16_t accel[3];               // mg
+    int16_t gyro[3];                // dps
+} FallImuSample_t;
+
+class FallClassifier {
+private:
+    FallImuSample_t window[FALL_CLASSIFIER_WINDOW];
+    int16_t features[FALL_FEATURE_COUNT];
+    FallStatus_t previous_status;
+    uint8_t samples_to_go;          // Until the window is complete; 0 when idle
+    int32_t logit;                  // Q8 log-odds of the last inference
+    uint8_t probability;            // % of the last inference
+    bool has_result;
+
+public:
+    FallClassifier();
+
+    void reset();
+
+    // Call after FallDetector::processSensorData(); true on the sample
+    // that completes a post-impact window
+    bool observe(FallStatus_t status);
+
+    // Runs one inference over the newest `count` samples, oldest first.
+    // Returns the fall probability in %; an empty window scores 0 and
+    // leaves no result.
+    uint8_t classify(const SensorData_t* samples, uint8_t count);
+
+    bool hasResult() { return has_result; }
+    uint8_t getProbability() { return probability; }
+    int32_t getLogit() { return logit; }
+    const int16_t* getFeatures() { return features; }
+
+    // Reference pipeline, also used by the trainer and the tests
+    static void quantize(const SensorData_t& data, FallImuSample_t& sample);
+    static void extractFeatures(const FallImuSample_t* samples, uint8_t count, int16_t* out);
+    static int32_t predictLogit(const int16_t* values);
+    static uint8_t toProbability(int32_t logit_q8);
+    static const char* getFeatureName(uint8_t feature);
+
+    void printFeatures();
+};
+
+#endif // FALL_CLASSIFIER_H
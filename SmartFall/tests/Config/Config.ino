@@ -0,0 +1,493 @@
+/*
+ * SmartFall - Runtime Configuration Test
+ *
+ * Exercises the Config_Store schema, validation and persistence against
+ * an in-memory NVS, then times a real NVS blob write on the device.
+ *
+ * Hardware: ESP32 HUZZAH32 Feather (no sensors required)
+ *
+ * This test verifies:
+ * - Defaults match config.h when NVS is empty
+ * - Full and partial writes round-trip and survive a reload
+ * - Malformed, out-of-range and newer-schema writes are rejected whole
+ * - Failed NVS writes leave the running config untouched
+ * - Apply callback reports exactly the changed groups
+ * - The WiFi password never appears in the readable value
+ * - Score tier overrides round-trip and reject out-of-order tables
+ * - Apply time stays well inside one 10 ms sensor period
+ */
+
+#include "Config_Store.h"
+#ifdef ARDUINO
+#include <Preferences.h>
+#endif
+
+#define MEMORY_NVS_SIZE     CONFIG_MAX_SIZE
+#define TIMING_ROUNDS       200
+
+// In-memory NVS with write counting and fault injection
+class Memory_Config_Storage : public Config_Storage {
+public:
+    uint8_t blob[MEMORY_NVS_SIZE];
+    size_t blob_length;
+    uint32_t writes;
+    bool fail_writes;
+
+    Memory_Config_Storage() : blob_length(0), writes(0), fail_writes(false) {}
+
+    bool load(const char* key, uint8_t* buffer, size_t& length) override {
+        if (blob_length == 0 || blob_length > length) return false;
+        memcpy(buffer, blob, blob_length);
+        length = blob_length;
+        return true;
+    }
+
+    bool store(const char* key, const uint8_t* data, size_t length) override {
+        if (fail_writes || length > sizeof(blob)) return false;
+        memcpy(blob, data, length);
+        blob_length = length;
+        writes++;
+        return true;
+    }
+};
+
+static uint8_t applied_changes = 0;
+static uint32_t apply_calls = 0;
+static Config_t applied_config;
+
+void recordApply(const Config_t& config, uint8_t changed) {
+    applied_changes = changed;
+    applied_config = config;
+    apply_calls++;
+}
+
+int passed = 0;
+int failed = 0;
+
+void expect(const char* name, uint32_t expected, uint32_t actual) {
+    if (expected == actual) {
+        passed++;
+        Serial.print("✓ ");
+    } else {
+        failed++;
+        Serial.print("✗ ");
+    }
+    Serial.print(name);
+    Serial.print(": expected ");
+    Serial.print(expected);
+    Serial.print(", got ");
+    Serial.println(actual);
+}
+
+void expectTrue(const char* name, bool condition) {
+    expect(name, 1, condition ? 1 : 0);
+}
+
+// Appends a tag/length/value field to a write buffer
+size_t addField(uint8_t* buffer, size_t pos, uint8_t tag, const void* value, uint8_t length) {
+    buffer[pos++] = tag;
+    buffer[pos++] = length;
+    memcpy(buffer + pos, value, length);
+    return pos + length;
+}
+
+size_t addU16(uint8_t* buffer, size_t pos, uint8_t tag, uint16_t value) {
+    uint8_t bytes[2] = {(uint8_t)value, (uint8_t)(value >> 8)};
+    return addField(buffer, pos, tag, bytes, 2);
+}
+
+size_t addU32(uint8_t* buffer, size_t pos, uint8_t tag, uint32_t value) {
+    uint8_t bytes[4] = {(uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24)};
+    return addField(buffer, pos, tag, bytes, 4);
+}
+
+size_t addU8(uint8_t* buffer, size_t pos, uint8_t tag, uint8_t value) {
+    return addField(buffer, pos, tag, &value, 1);
+}
+
+// Tier table field: metric, then (u32 breakpoint x1000, u8 points) per tier
+size_t addTiers(uint8_t* buffer, size_t pos, uint8_t metric, const uint32_t* breakpoints,
+                const uint8_t* points, uint8_t count) {
+    uint8_t bytes[1 + SCORE_TIER_MAX * 5];
+    bytes[0] = metric;
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t* tier = bytes + 1 + i * 5;
+        for (uint8_t b = 0; b < 4; b++) tier[b] = (uint8_t)(breakpoints[i] >> (8 * b));
+        tier[4] = points[i];
+    }
+    return addField(buffer, pos, CONFIG_TAG_SCORE_TIERS, bytes, 1 + count * 5);
+}
+
+// Checks that a rejected write changed nothing
+void expectRejected(const char* name, Config_Store& store, Memory_Config_Storage& nvs,
+                    const uint8_t* data, size_t length, uint8_t expected_error) {
+    Config_t before = store.get();
+    uint16_t generation = store.getGeneration();
+    uint32_t writes = nvs.writes;
+    uint32_t calls = apply_calls;
+
+    uint8_t result = store.applyWrite(data, length);
+    bool untouched = memcmp(&before, &store.get(), sizeof(before)) == 0 &&
+                     generation == store.getGeneration() && writes == nvs.writes && calls == apply_calls;
+
+    Serial.print(name);
+    Serial.println(":");
+    expect("  error code", expected_error, result);
+    expectTrue("  config, NVS and generation untouched", untouched);
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(2000);
+
+    Serial.println("\n========================================");
+    Serial.println("   SmartFall Runtime Configuration Test");
+    Serial.println("========================================\n");
+
+    // Test 1: Empty NVS falls back to config.h
+    Serial.println("TEST 1: Defaults");
+    Serial.println("-----------------");
+    {
+        Memory_Config_Storage nvs;
+        Config_Store store(&nvs);
+        expectTrue("begin with empty NVS", store.begin());
+
+        const Config_t& config = store.get();
+        expect("freefall mg", (uint32_t)(FREEFALL_THRESHOLD_G * 1000), (uint32_t)lroundf(config.thresholds.freefall_threshold_g * 1000));
+        expect("impact mg", (uint32_t)(IMPACT_THRESHOLD_G * 1000), (uint32_t)lroundf(config.thresholds.impact_threshold_g * 1000));
+        expect("inactivity ms", INACTIVITY_THRESHOLD_MS, config.thresholds.inactivity_threshold_ms);
+        expect("volume", AUDIO_DEFAULT_VOLUME, config.alert_volume);
+        expectTrue("ssid", strcmp(config.wifi_ssid, WIFI_SSID) == 0);
+        expect("NVS writes", 0, nvs.writes);
+    }
+    Serial.println();
+
+    // Test 2: Partial writes, apply callback and persistence
+    Serial.println("TEST 2: Partial Writes and Reload");
+    Serial.println("----------------------------------");
+    {
+        Memory_Config_Storage nvs;
+        Config_Store store(&nvs);
+        store.begin();
+        store.onApply(recordApply);
+
+        uint8_t write[CONFIG_MAX_SIZE];
+        size_t length = 0;
+        write[length++] = CONFIG_SCHEMA_VERSION;
+        length = addU8(write, length, CONFIG_TAG_ALERT_VOLUME, 35);
+
+        expect("volume write", CONFIG_OK, store.applyWrite(write, length));
+        expect("changed groups", CONFIG_CHANGED_VOLUME, applied_changes);
+        expect("volume applied", 35, applied_config.alert_volume);
+        expect("thresholds untouched", INACTIVITY_THRESHOLD_MS, store.get().thresholds.inactivity_threshold_ms);
+        expect("generation", 1, store.getGeneration());
+
+        length = 0;
+        write[length++] = CONFIG_SCHEMA_VERSION;
+        length = addU16(write, length, CONFIG_TAG_FREEFALL_MG, 420);
+        length = addU16(write, length, CONFIG_TAG_IMPACT_MG, 2750);
+        length = addU32(write, length, CONFIG_TAG_INACTIVITY_MS, 4500);
+        length = addField(write, length, CONFIG_TAG_WIFI_SSID, "CareHome-5G", 11);
+        length = addField(write, length, CONFIG_TAG_WIFI_PASSWORD, "s3cret-pass", 11);
+
+        expect("threshold + WiFi write", CONFIG_OK, store.applyWrite(write, length));
+        expect("changed groups", CONFIG_CHANGED_THRESHOLDS | CONFIG_CHANGED_WIFI, applied_changes);
+        expect("freefall applied (mg)", 420, (uint32_t)lroundf(applied_config.thresholds.freefall_threshold_g * 1000));
+        expect("impact applied (mg)", 2750, (uint32_t)lroundf(applied_config.thresholds.impact_threshold_g * 1000));
+        expect("volume kept", 35, store.get().alert_volume);
+
+        // Re-sending identical values changes nothing and costs no flash write
+        uint32_t writes = nvs.writes;
+        uint32_t calls = apply_calls;
+        expect("identical write", CONFIG_OK, store.applyWrite(write, length));
+        expect("NVS writes for identical write", writes, nvs.writes);
+        expect("apply calls for identical write", calls, apply_calls);
+
+        // A fresh store on the same NVS sees everything
+        Config_Store reloaded(&nvs);
+        expectTrue("reload", reloaded.begin());
+        expectTrue("reloaded config identical", memcmp(&reloaded.get(), &store.get(), sizeof(Config_t)) == 0);
+        expectTrue("reloaded password", strcmp(reloaded.get().wifi_password, "s3cret-pass") == 0);
+
+        Serial.print("Stored blob: ");
+        Serial.print(nvs.blob_length);
+        Serial.print(" bytes (Config_t is ");
+        Serial.print(sizeof(Config_t));
+        Serial.println(" bytes)");
+    }
+    Serial.println();
+
+    // Test 3: Invalid writes are rejected whole
+    Serial.println("TEST 3: Validation");
+    Serial.println("-------------------");
+    {
+        Memory_Config_Storage nvs;
+        Config_Store store(&nvs);
+        store.begin();
+        store.onApply(recordApply);
+
+        uint8_t write[CONFIG_MAX_SIZE];
+        size_t length;
+
+        write[0] = CONFIG_SCHEMA_VERSION + 1;
+        length = addU8(write, 1, CONFIG_TAG_ALERT_VOLUME, 10);
+        expectRejected("newer schema", store, nvs, write, length, CONFIG_ERR_VERSION);
+
+        write[0] = CONFIG_SCHEMA_VERSION;
+        length = addU16(write, 1, CONFIG_TAG_IMPACT_MG, 2500);
+        expectRejected("truncated field", store, nvs, write, length - 1, CONFIG_ERR_FORMAT);
+
+        length = addU8(write, 1, CONFIG_TAG_IMPACT_MG, 25);
+        expectRejected("wrong field length", store, nvs, write, length, CONFIG_ERR_FORMAT);
+
+        length = addU8(write, 1, 0x7F, 1);
+        expectRejected("unknown tag", store, nvs, write, length, CONFIG_ERR_UNKNOWN_TAG);
+
+        length = addU8(write, 1, CONFIG_TAG_ALERT_VOLUME, 101);
+        expectRejected("volume > 100", store, nvs, write, length, CONFIG_ERR_RANGE);
+
+        length = addU16(write, 1, CONFIG_TAG_IMPACT_MG, 20000);
+        expectRejected("impact beyond sensor range", store, nvs, write, length, CONFIG_ERR_RANGE);
+
+        // Field ranges keep free fall below impact; validate() guards the staged copy too
+        Config_t staged = store.get();
+        staged.thresholds.freefall_threshold_g = 1.0f;
+        staged.thresholds.impact_threshold_g = 0.9f;
+        expect("free fall >= impact fails validation", CONFIG_ERR_RANGE, Config_Store::validate(staged));
+
+        length = addField(write, 1, CONFIG_TAG_WIFI_SSID, "", 0);
+        expectRejected("empty SSID", store, nvs, write, length, CONFIG_ERR_RANGE);
+
+        // One bad field poisons the whole write
+        length = addU8(write, 1, CONFIG_TAG_ALERT_VOLUME, 20);
+        length = addU16(write, length, CONFIG_TAG_ROTATION_DPS, 5000);
+        expectRejected("valid volume + bad rotation", store, nvs, write, length, CONFIG_ERR_RANGE);
+        expect("volume not applied", AUDIO_DEFAULT_VOLUME, store.get().alert_volume);
+        expect("last result", CONFIG_ERR_RANGE, store.getLastResult());
+    }
+    Serial.println();
+
+    // Test 4: NVS failure and forward compatibility
+    Serial.println("TEST 4: Storage Failure and Schema Evolution");
+    Serial.println("---------------------------------------------");
+    {
+        Memory_Config_Storage nvs;
+        Config_Store store(&nvs);
+        store.begin();
+        store.onApply(recordApply);
+
+        uint8_t write[CONFIG_MAX_SIZE];
+        size_t length = addU8(write, 1, CONFIG_TAG_ALERT_VOLUME, 55);
+        write[0] = CONFIG_SCHEMA_VERSION;
+
+        nvs.fail_writes = true;
+        uint32_t calls = apply_calls;
+        expect("write with failing NVS", CONFIG_ERR_STORAGE, store.applyWrite(write, length));
+        expect("volume not applied", AUDIO_DEFAULT_VOLUME, store.get().alert_volume);
+        expect("no apply callback", calls, apply_calls);
+
+        nvs.fail_writes = false;
+        expect("retry succeeds", CONFIG_OK, store.applyWrite(write, length));
+
+        // A blob written by newer firmware with an extra field still loads
+        uint8_t blob[CONFIG_MAX_SIZE];
+        size_t blob_length = Config_Store::encode(store.get(), blob, sizeof(blob), true);
+        blob_length = addU8(blob, blob_length, 0x7F, 1);
+        nvs.store(CONFIG_NVS_KEY, blob, blob_length);
+
+        Config_Store reloaded(&nvs);
+        expectTrue("stored blob with unknown tag loads", reloaded.begin());
+        expect("known fields kept", 55, reloaded.get().alert_volume);
+
+        // A corrupt blob falls back to defaults instead of bricking the config
+        blob[0] = 0;
+        nvs.store(CONFIG_NVS_KEY, blob, blob_length);
+        Config_Store corrupt(&nvs);
+        expectTrue("corrupt blob reported", !corrupt.begin());
+        expect("defaults after corrupt blob", AUDIO_DEFAULT_VOLUME, corrupt.get().alert_volume);
+    }
+    Serial.println();
+
+    // Test 5: Readable value and mailbox
+    Serial.println("TEST 5: Read Value and Mailbox");
+    Serial.println("-------------------------------");
+    {
+        Memory_Config_Storage nvs;
+        Config_Store store(&nvs);
+        store.begin();
+
+        uint8_t value[CONFIG_MAX_SIZE + 4];
+        size_t length = store.encodeForRead(value, sizeof(value));
+        expect("version byte", CONFIG_SCHEMA_VERSION, value[0]);
+
+        bool has_password = false;
+        bool has_ssid = false;
+        for (size_t pos = 4; pos + 2 <= length; pos += 2 + value[pos + 1]) {
+            if (value[pos] == CONFIG_TAG_WIFI_PASSWORD) has_password = true;
+            if (value[pos] == CONFIG_TAG_WIFI_SSID) has_ssid = true;
+        }
+        expectTrue("SSID readable", has_ssid);
+        expectTrue("password not readable", !has_password);
+
+        uint8_t write[8];
+        size_t write_length = addU8(write, 1, CONFIG_TAG_ALERT_VOLUME, 15);
+        write[0] = CONFIG_SCHEMA_VERSION;
+
+        expectTrue("first submit queued", store.submit(write, write_length));
+        expectTrue("second submit refused", !store.submit(write, write_length));
+        expect("busy reported", CONFIG_ERR_BUSY, store.getLastResult());
+        expectTrue("service applies", store.service());
+        expect("volume applied", 15, store.get().alert_volume);
+        expectTrue("mailbox empty", !store.service());
+
+        store.encodeForRead(value, sizeof(value));
+        expect("result in read value", CONFIG_OK, value[1]);
+        expect("generation in read value", 1, value[2] | (value[3] << 8));
+    }
+    Serial.println();
+
+    // Test 6: Score tier overrides
+    Serial.println("TEST 6: Score Tier Overrides");
+    Serial.println("-----------------------------");
+    {
+        Memory_Config_Storage nvs;
+        Config_Store store(&nvs);
+        store.begin();
+        store.onApply(recordApply);
+
+        expectTrue("defaults are DEFAULT_SCORE_TIERS",
+                   sameScoreTable(store.get().score_tiers.tables[SCORE_IMPACT], DEFAULT_SCORE_TIERS.tables[SCORE_IMPACT]));
+
+        // Defaults are not echoed in the readable value
+        uint8_t value[CONFIG_MAX_SIZE + 4];
+        size_t value_length = store.encodeForRead(value, sizeof(value));
+        bool has_tiers = false;
+        for (size_t pos = 4; pos + 2 <= value_length; pos += 2 + value[pos + 1]) {
+            if (value[pos] == CONFIG_TAG_SCORE_TIERS) has_tiers = true;
+        }
+        expectTrue("default tiers not in read value", !has_tiers);
+
+        uint8_t write[CONFIG_MAX_SIZE];
+        const uint32_t impact[] = {7000, 5000, 3500, 2500};   // mg
+        const uint8_t impact_points[] = {15, 12, 8, 4};
+        size_t length = addTiers(write, 1, SCORE_IMPACT, impact, impact_points, 4);
+        write[0] = CONFIG_SCHEMA_VERSION;
+
+        expect("impact tiers write", CONFIG_OK, store.applyWrite(write, length));
+        expect("changed groups", CONFIG_CHANGED_SCORING, applied_changes);
+        const ScoreTable_t& table = applied_config.score_tiers.tables[SCORE_IMPACT];
+        expect("tier count", 4, table.count);
+        expectTrue("direction kept", !table.at_most);
+        expectTrue("breakpoint exact", table.tiers[3].breakpoint == 2.5f);
+        expect("2.6 g scores the new tier", 4, scoreTier(table, 2.6f));
+        expectTrue("other tables untouched",
+                   sameScoreTable(applied_config.score_tiers.tables[SCORE_ROTATION], DEFAULT_SCORE_TIERS.tables[SCORE_ROTATION]));
+
+        // An empty table turns the metric off
+        length = addTiers(write, 1, SCORE_HEART_RATE, nullptr, nullptr, 0);
+        expect("heart rate tiers cleared", CONFIG_OK, store.applyWrite(write, length));
+        expect("heart rate scores nothing", 0, scoreTier(store.get().score_tiers.tables[SCORE_HEART_RATE], 50.0f));
+
+        Config_Store reloaded(&nvs);
+        reloaded.begin();
+        bool same = true;
+        for (uint8_t m = 0; m < SCORE_METRIC_COUNT; m++) {
+            same &= sameScoreTable(reloaded.get().score_tiers.tables[m], store.get().score_tiers.tables[m]);
+        }
+        expectTrue("tiers survive reload", same);
+
+        // Every table overridden with four tiers still fits one write
+        length = 1;
+        for (uint8_t m = 0; m < SCORE_METRIC_COUNT; m++) {
+            const uint32_t ladder[] = {4000, 3000, 2000, 1000};
+            const uint32_t rising[] = {1000, 2000, 3000, 4000};
+            const uint8_t points[] = {4, 3, 2, 1};
+            length = addTiers(write, length, m, DEFAULT_SCORE_TIERS.tables[m].at_most ? rising : ladder, points, 4);
+        }
+        expectTrue("full override fits", length <= CONFIG_MAX_SIZE);
+        expect("full override write", CONFIG_OK, store.applyWrite(write, length));
+        uint8_t blob[CONFIG_MAX_SIZE];
+        expectTrue("full config encodes", Config_Store::encode(store.get(), blob, sizeof(blob), true) > 0);
+        store.resetToDefaults();
+
+        const uint32_t unordered[] = {3000, 4000};
+        const uint8_t two_points[] = {8, 12};
+        length = addTiers(write, 1, SCORE_IMPACT, unordered, two_points, 2);
+        expectRejected("tiers out of order", store, nvs, write, length, CONFIG_ERR_RANGE);
+
+        const uint32_t ordered[] = {4000, 3000};
+        const uint8_t too_many[] = {40, 12};
+        length = addTiers(write, 1, SCORE_IMPACT, ordered, too_many, 2);
+        expectRejected("points over stage cap", store, nvs, write, length, CONFIG_ERR_RANGE);
+
+        length = addTiers(write, 1, SCORE_METRIC_COUNT, ordered, two_points, 2);
+        expectRejected("unknown metric", store, nvs, write, length, CONFIG_ERR_RANGE);
+
+        length = addTiers(write, 1, SCORE_IMPACT, ordered, two_points, 2);
+        write[2]--;
+        expectRejected("partial tier", store, nvs, write, length - 1, CONFIG_ERR_FORMAT);
+    }
+    Serial.println();
+
+    // Test 7: Apply time vs. the sensor period
+    Serial.println("TEST 7: Apply Time");
+    Serial.println("-------------------");
+    {
+        Memory_Config_Storage nvs;
+        Config_Store store(&nvs);
+        store.begin();
+
+        uint8_t write[CONFIG_MAX_SIZE];
+        uint32_t worst_us = 0;
+        for (uint32_t i = 0; i < TIMING_ROUNDS; i++) {
+            size_t length = addU16(write, 1, CONFIG_TAG_FREEFALL_MG, 300 + (i % 2) * 100);
+            length = addU8(write, length, CONFIG_TAG_ALERT_VOLUME, i % 100);
+            write[0] = CONFIG_SCHEMA_VERSION;
+
+            uint32_t start = micros();
+            store.applyWrite(write, length);
+            uint32_t elapsed = micros() - start;
+            if (elapsed > worst_us) worst_us = elapsed;
+        }
+        Serial.print("Worst apply (in-memory NVS): ");
+        Serial.print(worst_us);
+        Serial.println(" us");
+        expectTrue("apply < 1 ms", worst_us < 1000);
+
+#ifdef ARDUINO
+        // Real NVS blob write in a scratch namespace
+        Preferences prefs;
+        uint8_t blob[CONFIG_MAX_SIZE];
+        size_t blob_length = Config_Store::encode(store.get(), blob, sizeof(blob), true);
+        uint32_t nvs_worst_us = 0;
+        prefs.begin("sf_cfg_test", false);
+        for (uint32_t i = 0; i < TIMING_ROUNDS; i++) {
+            blob[blob_length - 1] = (uint8_t)i;
+            uint32_t start = micros();
+            prefs.putBytes("config", blob, blob_length);
+            uint32_t elapsed = micros() - start;
+            if (elapsed > nvs_worst_us) nvs_worst_us = elapsed;
+        }
+        prefs.clear();
+        prefs.end();
+
+        Serial.print("Worst NVS blob write: ");
+        Serial.print(nvs_worst_us);
+        Serial.println(" us (includes page erase on rollover)");
+#endif
+    }
+    Serial.println();
+
+    Serial.print("Passed: ");
+    Serial.print(passed);
+    Serial.print("  Failed: ");
+    Serial.println(failed);
+
+    Serial.println("========================================");
+    Serial.println(failed == 0 ? "      ALL TESTS PASSED" : "      TESTS FAILED");
+    Serial.println("========================================");
+}
+
+void loop() {
+    delay(1000);
+}
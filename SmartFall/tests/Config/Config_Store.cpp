@@ -0,0 +1,478 @@
+#include "Config_Store.h"
+
+#ifdef ARDUINO
+#include <Preferences.h>
+#endif
+
+// Accepted ranges (fixed-point units of the schema)
+#define CONFIG_FREEFALL_MG_MIN      100
+#define CONFIG_FREEFALL_MG_MAX      1000
+#define CONFIG_IMPACT_MG_MIN        1500
+#define CONFIG_IMPACT_MG_MAX        16000   // MPU6050 full scale
+#define CONFIG_ROTATION_DPS_MIN     50
+#define CONFIG_ROTATION_DPS_MAX     2000
+#define CONFIG_INACTIVITY_MS_MIN    500
+#define CONFIG_INACTIVITY_MS_MAX    60000
+#define CONFIG_PRESSURE_CM_MIN      10
+#define CONFIG_PRESSURE_CM_MAX      500
+#define CONFIG_TIER_SCALE           1000.0f // Tier breakpoints in thousandths of their unit
+#define CONFIG_TIER_SIZE            5       // u32 breakpoint + u8 points
+#define CONFIG_READ_HEADER_SIZE     4
+
+static void putU16(uint8_t* out, uint16_t value) {
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+}
+
+static void putU32(uint8_t* out, uint32_t value) {
+    out[0] = (uint8_t)value;
+    out[1] = (uint8_t)(value >> 8);
+    out[2] = (uint8_t)(value >> 16);
+    out[3] = (uint8_t)(value >> 24);
+}
+
+static uint16_t getU16(const uint8_t* in) {
+    return (uint16_t)(in[0] | (in[1] << 8));
+}
+
+static uint32_t getU32(const uint8_t* in) {
+    return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+static uint32_t toFixed(float value, float scale) {
+    return (uint32_t)lroundf(value * scale);
+}
+
+// Appends one field; returns false when the buffer is full
+static bool putField(uint8_t* buffer, size_t size, size_t& pos, uint8_t tag, const uint8_t* value, uint8_t length) {
+    if (pos + 2 + length > size) return false;
+    buffer[pos++] = tag;
+    buffer[pos++] = length;
+    memcpy(buffer + pos, value, length);
+    pos += length;
+    return true;
+}
+
+static size_t encodeFields(const Config_t& config, uint8_t* buffer, size_t size, bool include_secret) {
+    uint8_t value[4];
+    size_t pos = 0;
+    bool ok = true;
+
+    putU16(value, (uint16_t)toFixed(config.thresholds.freefall_threshold_g, 1000.0f));
+    ok &= putField(buffer, size, pos, CONFIG_TAG_FREEFALL_MG, value, 2);
+    putU16(value, (uint16_t)toFixed(config.thresholds.impact_threshold_g, 1000.0f));
+    ok &= putField(buffer, size, pos, CONFIG_TAG_IMPACT_MG, value, 2);
+    putU16(value, (uint16_t)toFixed(config.thresholds.rotation_threshold_dps, 1.0f));
+    ok &= putField(buffer, size, pos, CONFIG_TAG_ROTATION_DPS, value, 2);
+    putU32(value, config.thresholds.inactivity_threshold_ms);
+    ok &= putField(buffer, size, pos, CONFIG_TAG_INACTIVITY_MS, value, 4);
+    putU16(value, (uint16_t)toFixed(config.thresholds.pressure_change_threshold_m, 100.0f));
+    ok &= putField(buffer, size, pos, CONFIG_TAG_PRESSURE_CM, value, 2);
+
+    for (uint8_t metric = 0; metric < SCORE_METRIC_COUNT; metric++) {
+        const ScoreTable_t& table = config.score_tiers.tables[metric];
+        if (sameScoreTable(table, DEFAULT_SCORE_TIERS.tables[metric])) continue;
+
+        uint8_t tiers[1 + SCORE_TIER_MAX * CONFIG_TIER_SIZE];
+        tiers[0] = metric;
+        for (uint8_t i = 0; i < table.count; i++) {
+            uint8_t* tier = tiers + 1 + i * CONFIG_TIER_SIZE;
+            putU32(tier, toFixed(table.tiers[i].breakpoint, CONFIG_TIER_SCALE));
+            tier[4] = table.tiers[i].points;
+        }
+        ok &= putField(buffer, size, pos, CONFIG_TAG_SCORE_TIERS, tiers,
+                       (uint8_t)(1 + table.count * CONFIG_TIER_SIZE));
+    }
+
+    ok &= putField(buffer, size, pos, CONFIG_TAG_ALERT_VOLUME, &config.alert_volume, 1);
+    ok &= putField(buffer, size, pos, CONFIG_TAG_HAPTIC, &config.haptic_intensity, 1);
+    value[0] = config.visual_alerts_enabled ? 1 : 0;
+    ok &= putField(buffer, size, pos, CONFIG_TAG_VISUAL_ALERTS, value, 1);
+
+    ok &= putField(buffer, size, pos, CONFIG_TAG_WIFI_SSID, (const uint8_t*)config.wifi_ssid,
+                   (uint8_t)strnlen(config.wifi_ssid, sizeof(config.wifi_ssid) - 1));
+    if (include_secret) {
+        ok &= putField(buffer, size, pos, CONFIG_TAG_WIFI_PASSWORD, (const uint8_t*)config.wifi_password,
+                       (uint8_t)strnlen(config.wifi_password, sizeof(config.wifi_password) - 1));
+    }
+
+    return ok ? pos : 0;
+}
+
+#ifdef ARDUINO
+bool NVS_Config_Storage::load(const char* key, uint8_t* buffer, size_t& length) {
+    Preferences prefs;
+    if (!prefs.begin(CONFIG_NVS_NAMESPACE, true)) return false;
+
+    size_t stored = prefs.getBytesLength(key);
+    bool ok = stored > 0 && stored <= length && prefs.getBytes(key, buffer, stored) == stored;
+    prefs.end();
+
+    if (ok) length = stored;
+    return ok;
+}
+
+bool NVS_Config_Storage::store(const char* key, const uint8_t* data, size_t length) {
+    Preferences prefs;
+    if (!prefs.begin(CONFIG_NVS_NAMESPACE, false)) return false;
+
+    bool ok = prefs.putBytes(key, data, length) == length;
+    prefs.end();
+    return ok;
+}
+#endif
+
+Config_Store::Config_Store(Config_Storage* backend)
+    : storage(backend), apply_callback(nullptr), generation(0), last_result(CONFIG_OK),
+      request_length(0), request_pending(false) {
+    defaults(config);
+#ifdef ARDUINO
+    request_mux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+}
+
+bool Config_Store::begin() {
+    defaults(config);
+
+    uint8_t blob[CONFIG_MAX_SIZE];
+    size_t length = sizeof(blob);
+    if (storage == nullptr || !storage->load(CONFIG_NVS_KEY, blob, length)) {
+        Serial.println("[Config] No stored config, using defaults");
+        return true;
+    }
+
+    // Unknown tags from a newer firmware are skipped, not fatal
+    Config_t loaded = config;
+    uint8_t result = decode(blob, length, loaded, false);
+    if (result == CONFIG_OK) result = validate(loaded);
+
+    if (result != CONFIG_OK) {
+        Serial.print("[Config] ✗ Stored config rejected (error ");
+        Serial.print(result);
+        Serial.println("), using defaults");
+        return false;
+    }
+
+    config = loaded;
+    Serial.print("[Config] ✓ Loaded ");
+    Serial.print(length);
+    Serial.println(" bytes from NVS");
+    return true;
+}
+
+void Config_Store::onApply(ConfigApplyFn_t callback) {
+    apply_callback = callback;
+}
+
+bool Config_Store::submit(const uint8_t* data, size_t length) {
+    if (length == 0 || length > CONFIG_MAX_SIZE) {
+        last_result = CONFIG_ERR_FORMAT;
+        return false;
+    }
+
+    bool accepted = false;
+#ifdef ARDUINO
+    portENTER_CRITICAL(&request_mux);
+#endif
+    if (!request_pending) {
+        memcpy(request, data, length);
+        request_length = length;
+        request_pending = true;
+        accepted = true;
+    }
+#ifdef ARDUINO
+    portEXIT_CRITICAL(&request_mux);
+#endif
+
+    if (!accepted) last_result = CONFIG_ERR_BUSY;
+    return accepted;
+}
+
+bool Config_Store::service() {
+    uint8_t pending[CONFIG_MAX_SIZE];
+    size_t pending_length = 0;
+
+#ifdef ARDUINO
+    portENTER_CRITICAL(&request_mux);
+#endif
+    if (request_pending) {
+        pending_length = request_length;
+        memcpy(pending, request, pending_length);
+        request_pending = false;
+    }
+#ifdef ARDUINO
+    portEXIT_CRITICAL(&request_mux);
+#endif
+
+    if (pending_length == 0) return false;
+
+    applyWrite(pending, pending_length);
+    return true;
+}
+
+uint8_t Config_Store::applyWrite(const uint8_t* data, size_t length) {
+    // Stage on a copy so a rejected write leaves nothing half-applied
+    Config_t staged = config;
+    uint8_t result = decode(data, length, staged, true);
+    if (result == CONFIG_OK) result = validate(staged);
+
+    uint8_t changed = 0;
+    if (result == CONFIG_OK) {
+        changed = diff(config, staged);
+
+        // Persist before applying; an unchanged write costs no flash wear
+        if (changed != 0 && storage != nullptr) {
+            uint8_t blob[CONFIG_MAX_SIZE];
+            size_t blob_length = encode(staged, blob, sizeof(blob), true);
+            if (blob_length == 0 || !storage->store(CONFIG_NVS_KEY, blob, blob_length)) {
+                result = CONFIG_ERR_STORAGE;
+            }
+        }
+    }
+
+    last_result = result;
+    if (result != CONFIG_OK) {
+        Serial.print("[Config] ✗ Write rejected (error ");
+        Serial.print(result);
+        Serial.println(")");
+        return result;
+    }
+
+    config = staged;
+    generation++;
+
+    if (DEBUG_COMMUNICATION) {
+        Serial.print("[Config] ✓ Applied, changed groups: 0x");
+        Serial.println(changed, HEX);
+    }
+
+    if (changed != 0 && apply_callback != nullptr) {
+        apply_callback(config, changed);
+    }
+    return result;
+}
+
+bool Config_Store::resetToDefaults() {
+    uint8_t blob[CONFIG_MAX_SIZE];
+    Config_t fresh;
+    defaults(fresh);
+
+    size_t length = encode(fresh, blob, sizeof(blob), true);
+    return applyWrite(blob, length) == CONFIG_OK;
+}
+
+size_t Config_Store::encodeForRead(uint8_t* buffer, size_t size) {
+    if (size < CONFIG_READ_HEADER_SIZE) return 0;
+
+    buffer[0] = CONFIG_SCHEMA_VERSION;
+    buffer[1] = last_result;
+    putU16(buffer + 2, generation);
+
+    size_t fields = encodeFields(config, buffer + CONFIG_READ_HEADER_SIZE,
+                                 size - CONFIG_READ_HEADER_SIZE, false);
+    return fields == 0 ? 0 : CONFIG_READ_HEADER_SIZE + fields;
+}
+
+void Config_Store::printConfig() {
+    Serial.println("=== Configuration ===");
+    Serial.print("Schema: v");
+    Serial.print(CONFIG_SCHEMA_VERSION);
+    Serial.print(" | Generation: ");
+    Serial.print(generation);
+    Serial.print(" | Last result: ");
+    Serial.println(last_result);
+    Serial.print("Thresholds: free fall < ");
+    Serial.print(config.thresholds.freefall_threshold_g, 3);
+    Serial.print(" g, impact > ");
+    Serial.print(config.thresholds.impact_threshold_g, 3);
+    Serial.print(" g, rotation > ");
+    Serial.print(config.thresholds.rotation_threshold_dps, 0);
+    Serial.print(" °/s, inactivity > ");
+    Serial.print(config.thresholds.inactivity_threshold_ms);
+    Serial.println(" ms");
+    uint8_t overridden = 0;
+    for (uint8_t metric = 0; metric < SCORE_METRIC_COUNT; metric++) {
+        if (!sameScoreTable(config.score_tiers.tables[metric], DEFAULT_SCORE_TIERS.tables[metric])) overridden++;
+    }
+    Serial.print("Score tiers: ");
+    Serial.print(overridden);
+    Serial.print(" of ");
+    Serial.print(SCORE_METRIC_COUNT);
+    Serial.println(" tables overridden");
+    Serial.print("Volume: ");
+    Serial.print(config.alert_volume);
+    Serial.print("% | Haptic: ");
+    Serial.print(config.haptic_intensity);
+    Serial.print("% | Visual: ");
+    Serial.println(config.visual_alerts_enabled ? "On" : "Off");
+    Serial.print("WiFi SSID: ");
+    Serial.println(config.wifi_ssid);
+    Serial.println("=====================");
+}
+
+void Config_Store::defaults(Config_t& config) {
+    memset(&config, 0, sizeof(config));
+
+    strncpy(config.wifi_ssid, WIFI_SSID, sizeof(config.wifi_ssid) - 1);
+    strncpy(config.wifi_password, WIFI_PASSWORD, sizeof(config.wifi_password) - 1);
+    strncpy(config.device_name, BLE_DEVICE_NAME, sizeof(config.device_name) - 1);
+
+    config.thresholds.freefall_threshold_g = FREEFALL_THRESHOLD_G;
+    config.thresholds.impact_threshold_g = IMPACT_THRESHOLD_G;
+    config.thresholds.rotation_threshold_dps = ROTATION_THRESHOLD_DPS;
+    config.thresholds.inactivity_threshold_ms = INACTIVITY_THRESHOLD_MS;
+    config.thresholds.pressure_change_threshold_m = PRESSURE_CHANGE_THRESHOLD_M;
+    config.score_tiers = DEFAULT_SCORE_TIERS;
+
+    config.alert_volume = AUDIO_DEFAULT_VOLUME;
+    config.haptic_intensity = 100;
+    config.visual_alerts_enabled = true;
+}
+
+uint8_t Config_Store::decode(const uint8_t* data, size_t length, Config_t& config, bool strict) {
+    if (length < 1) return CONFIG_ERR_FORMAT;
+    if (data[0] == 0 || data[0] > CONFIG_SCHEMA_VERSION) return CONFIG_ERR_VERSION;
+
+    size_t pos = 1;
+    while (pos < length) {
+        if (pos + 2 > length) return CONFIG_ERR_FORMAT;
+        uint8_t tag = data[pos];
+        uint8_t field_length = data[pos + 1];
+        const uint8_t* value = data + pos + 2;
+        pos += 2 + field_length;
+        if (pos > length) return CONFIG_ERR_FORMAT;
+
+        switch (tag) {
+            case CONFIG_TAG_FREEFALL_MG:
+            case CONFIG_TAG_IMPACT_MG:
+            case CONFIG_TAG_ROTATION_DPS:
+            case CONFIG_TAG_PRESSURE_CM: {
+                if (field_length != 2) return CONFIG_ERR_FORMAT;
+                uint16_t raw = getU16(value);
+
+                if (tag == CONFIG_TAG_FREEFALL_MG) {
+                    if (raw < CONFIG_FREEFALL_MG_MIN || raw > CONFIG_FREEFALL_MG_MAX) return CONFIG_ERR_RANGE;
+                    config.thresholds.freefall_threshold_g = raw / 1000.0f;
+                } else if (tag == CONFIG_TAG_IMPACT_MG) {
+                    if (raw < CONFIG_IMPACT_MG_MIN || raw > CONFIG_IMPACT_MG_MAX) return CONFIG_ERR_RANGE;
+                    config.thresholds.impact_threshold_g = raw / 1000.0f;
+                } else if (tag == CONFIG_TAG_ROTATION_DPS) {
+                    if (raw < CONFIG_ROTATION_DPS_MIN || raw > CONFIG_ROTATION_DPS_MAX) return CONFIG_ERR_RANGE;
+                    config.thresholds.rotation_threshold_dps = (float)raw;
+                } else {
+                    if (raw < CONFIG_PRESSURE_CM_MIN || raw > CONFIG_PRESSURE_CM_MAX) return CONFIG_ERR_RANGE;
+                    config.thresholds.pressure_change_threshold_m = raw / 100.0f;
+                }
+                break;
+            }
+
+            case CONFIG_TAG_INACTIVITY_MS: {
+                if (field_length != 4) return CONFIG_ERR_FORMAT;
+                uint32_t raw = getU32(value);
+                if (raw < CONFIG_INACTIVITY_MS_MIN || raw > CONFIG_INACTIVITY_MS_MAX) return CONFIG_ERR_RANGE;
+                config.thresholds.inactivity_threshold_ms = raw;
+                break;
+            }
+
+            case CONFIG_TAG_SCORE_TIERS: {
+                if (field_length < 1 || (field_length - 1) % CONFIG_TIER_SIZE != 0) return CONFIG_ERR_FORMAT;
+                uint8_t count = (field_length - 1) / CONFIG_TIER_SIZE;
+                if (value[0] >= SCORE_METRIC_COUNT || count > SCORE_TIER_MAX) return CONFIG_ERR_RANGE;
+
+                // Direction is fixed per metric; only the tiers change
+                ScoreTable_t table;
+                memset(&table, 0, sizeof(table));
+                table.count = count;
+                table.at_most = DEFAULT_SCORE_TIERS.tables[value[0]].at_most;
+                for (uint8_t i = 0; i < count; i++) {
+                    const uint8_t* tier = value + 1 + i * CONFIG_TIER_SIZE;
+                    table.tiers[i].breakpoint = getU32(tier) / CONFIG_TIER_SCALE;
+                    table.tiers[i].points = tier[4];
+                }
+                if (!isValidScoreTable(table)) return CONFIG_ERR_RANGE;
+                config.score_tiers.tables[value[0]] = table;
+                break;
+            }
+
+            case CONFIG_TAG_ALERT_VOLUME:
+            case CONFIG_TAG_HAPTIC:
+                if (field_length != 1) return CONFIG_ERR_FORMAT;
+                if (value[0] > 100) return CONFIG_ERR_RANGE;
+                if (tag == CONFIG_TAG_ALERT_VOLUME) {
+                    config.alert_volume = value[0];
+                } else {
+                    config.haptic_intensity = value[0];
+                }
+                break;
+
+            case CONFIG_TAG_VISUAL_ALERTS:
+                if (field_length != 1) return CONFIG_ERR_FORMAT;
+                if (value[0] > 1) return CONFIG_ERR_RANGE;
+                config.visual_alerts_enabled = value[0] != 0;
+                break;
+
+            case CONFIG_TAG_WIFI_SSID:
+                if (field_length == 0 || field_length >= sizeof(config.wifi_ssid)) return CONFIG_ERR_RANGE;
+                memset(config.wifi_ssid, 0, sizeof(config.wifi_ssid));
+                memcpy(config.wifi_ssid, value, field_length);
+                break;
+
+            case CONFIG_TAG_WIFI_PASSWORD:
+                if (field_length >= sizeof(config.wifi_password)) return CONFIG_ERR_RANGE;
+                memset(config.wifi_password, 0, sizeof(config.wifi_password));
+                memcpy(config.wifi_password, value, field_length);
+                break;
+
+            default:
+                if (strict) return CONFIG_ERR_UNKNOWN_TAG;
+                break;
+        }
+    }
+
+    return CONFIG_OK;
+}
+
+uint8_t Config_Store::validate(const Config_t& config) {
+    // Cross-field checks; per-field ranges are enforced while decoding
+    if (config.thresholds.freefall_threshold_g >= config.thresholds.impact_threshold_g) {
+        return CONFIG_ERR_RANGE;
+    }
+    if (strlen(config.wifi_ssid) == 0) {
+        return CONFIG_ERR_RANGE;
+    }
+    return CONFIG_OK;
+}
+
+size_t Config_Store::encode(const Config_t& config, uint8_t* buffer, size_t size, bool include_secret) {
+    if (size < 1) return 0;
+    buffer[0] = CONFIG_SCHEMA_VERSION;
+
+    size_t fields = encodeFields(config, buffer + 1, size - 1, include_secret);
+    return fields == 0 ? 0 : fields + 1;
+}
+
+uint8_t Config_Store::diff(const Config_t& before, const Config_t& after) {
+    uint8_t changed = 0;
+
+    if (memcmp(&before.thresholds, &after.thresholds, sizeof(before.thresholds)) != 0) {
+        changed |= CONFIG_CHANGED_THRESHOLDS;
+    }
+    for (uint8_t metric = 0; metric < SCORE_METRIC_COUNT; metric++) {
+        if (!sameScoreTable(before.score_tiers.tables[metric], after.score_tiers.tables[metric])) {
+            changed |= CONFIG_CHANGED_SCORING;
+        }
+    }
+    if (before.alert_volume != after.alert_volume) {
+        changed |= CONFIG_CHANGED_VOLUME;
+    }
+    if (before.haptic_intensity != after.haptic_intensity ||
+        before.visual_alerts_enabled != after.visual_alerts_enabled) {
+        changed |= CONFIG_CHANGED_ALERTS;
+    }
+    if (strcmp(before.wifi_ssid, after.wifi_ssid) != 0 ||
+        strcmp(before.wifi_password, after.wifi_password) != 0) {
+        changed |= CONFIG_CHANGED_WIFI;
+    }
+
+    return changed;
+}
@@ -0,0 +1,100 @@
+#ifndef SCORE_TIERS_H
+#define SCORE_TIERS_H
+
+#include "data_types.h"
+#include <Arduino.h>
+
+/*
+ * Confidence score tiers.
+ *
+ * Each metric is scored from a table of (breakpoint, points) pairs, listed
+ * strictest first. The first tier the value meets gives the points, as in
+ * an if-ladder; a value that meets none scores 0. DEFAULT_SCORE_TIERS is
+ * the shipped tuning. A runtime override arrives through Config_Store
+ * (CONFIG_TAG_SCORE_TIERS) and is checked with isValidScoreTable().
+ */
+
+#define SCORE_TIER_POINTS_MAX 25   // Largest stage cap
+
+constexpr ScoreTiers_t DEFAULT_SCORE_TIERS = {{
+    // SCORE_FREEFALL_DURATION: extended fall, typical fall, brief drop
+    {3, false, {{500.0f, 15}, {200.0f, 10}, {100.0f, 5}}},
+    // SCORE_FREEFALL_DEPTH: true free fall, significant, partial weightlessness
+    {3, true, {{0.1f, 10}, {0.3f, 8}, {0.5f, 5}}},
+    // SCORE_IMPACT: severe, significant, moderate impact
+    {3, false, {{6.0f, 15}, {4.0f, 12}, {3.0f, 8}}},
+    // SCORE_IMPACT_TIMING: immediate, delayed impact
+    {2, true, {{500.0f, 5}, {1000.0f, 3}}},
+    // SCORE_ROTATION: severe, significant, moderate rotation
+    {3, false, {{600.0f, 15}, {400.0f, 12}, {250.0f, 8}}},
+    // SCORE_ORIENTATION: lying flat, partly over
+    {2, false, {{90.0f, 5}, {45.0f, 3}}},
+    // SCORE_INACTIVITY: extended, moderate, brief incapacitation
+    {3, false, {{10000.0f, 15}, {5000.0f, 12}, {2000.0f, 8}}},
+    // SCORE_PRESSURE: significant, moderate, minor fall height
+    {3, false, {{2.0f, 5}, {1.0f, 3}, {0.5f, 2}}},
+    // SCORE_HEART_RATE: major, moderate, minor stress response
+    {3, false, {{30.0f, 5}, {10.0f, 3}, {2.0f, 2}}},
+    // SCORE_CLASSIFIER: confident, likely, leaning fall
+    {3, false, {{90.0f, 15}, {75.0f, 10}, {50.0f, 5}}}
+}};
+
+// Each breakpoint strictly looser than the one before it
+constexpr bool isOrderedScoreTable(const ScoreTable_t& table, uint8_t i = 1) {
+    return i >= table.count ||
+           ((table.at_most ? table.tiers[i].breakpoint > table.tiers[i - 1].breakpoint
+                           : table.tiers[i].breakpoint < table.tiers[i - 1].breakpoint) &&
+            isOrderedScoreTable(table, i + 1));
+}
+
+constexpr bool isScoreTablePointsValid(const ScoreTable_t& table, uint8_t i = 0) {
+    return i >= table.count ||
+           (table.tiers[i].points <= SCORE_TIER_POINTS_MAX && isScoreTablePointsValid(table, i + 1));
+}
+
+constexpr bool isValidScoreTable(const ScoreTable_t& table) {
+    return table.count <= SCORE_TIER_MAX && isOrderedScoreTable(table) && isScoreTablePointsValid(table);
+}
+
+constexpr bool isValidScoreTiers(const ScoreTiers_t& tiers, uint8_t metric = 0) {
+    return metric >= SCORE_METRIC_COUNT ||
+           (isValidScoreTable(tiers.tables[metric]) && isValidScoreTiers(tiers, metric + 1));
+}
+
+static_assert(isValidScoreTiers(DEFAULT_SCORE_TIERS), "DEFAULT_SCORE_TIERS out of order");
+
+/*
+ * Walks all SCORE_TIER_MAX slots from the loosest up with a select per
+ * slot, so the loop unrolls to conditional moves instead of a chain of
+ * branches. The last tier met is the strictest, which is the one a
+ * ladder would stop at. The direction test is once per table and always
+ * goes the same way for a given metric.
+ */
+inline uint8_t scoreTier(const ScoreTable_t& table, float value) {
+    uint8_t points = 0;
+    if (table.at_most) {
+        for (int8_t i = SCORE_TIER_MAX - 1; i >= 0; i--) {
+            bool met = (i < table.count) & (value <= table.tiers[i].breakpoint);
+            points = met ? table.tiers[i].points : points;
+        }
+    } else {
+        for (int8_t i = SCORE_TIER_MAX - 1; i >= 0; i--) {
+            bool met = (i < table.count) & (value >= table.tiers[i].breakpoint);
+            points = met ? table.tiers[i].points : points;
+        }
+    }
+    return points;
+}
+
+// Field-wise, so struct padding never reads as a change
+inline bool sameScoreTable(const ScoreTable_t& a, const ScoreTable_t& b) {
+    if (a.count != b.count || a.at_most != b.at_most) return false;
+    for (uint8_t i = 0; i < a.count; i++) {
+        if (a.tiers[i].breakpoint != b.tiers[i].breakpoint || a.tiers[i].points != b.tiers[i].points) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#endif // SCORE_TIERS_H
@@ -0,0 +1,117 @@
+#include "Accel_Ranger.h"
+
+Accel_Ranger::Accel_Ranger(uint8_t low_range_g, uint8_t high_range_g)
+    : low_g(low_range_g), high_g(high_range_g) {
+    setSampleRate(SENSOR_SAMPLE_RATE_HZ);
+    reset();
+}
+
+void Accel_Ranger::reset() {
+    range_g = low_g;
+    quiet_samples = 0;
+    freefall_samples = 0;
+    switches_up = 0;
+    switches_down = 0;
+    samples = 0;
+    high_samples = 0;
+    clipped_samples = 0;
+}
+
+bool Accel_Ranger::update(const int16_t raw[3]) {
+    samples++;
+    if (range_g == high_g) high_samples++;
+
+    // Largest axis and squared magnitude, in counts at the current scale
+    bool clipped = false;
+    int32_t peak = 0;
+    uint32_t magnitude_sq = 0;
+    for (uint8_t axis = 0; axis < 3; axis++) {
+        int32_t value = raw[axis];
+        clipped |= isClipped(raw[axis]);
+        int32_t size = value < 0 ? -value : value;
+        if (size > peak) peak = size;
+        magnitude_sq += (uint32_t)(value * value);
+    }
+    if (clipped) clipped_samples++;
+
+    float counts_per_g = countsPerG(range_g);
+    float peak_g = peak / counts_per_g;
+    float freefall_counts = FREEFALL_THRESHOLD_G * counts_per_g;
+    bool freefall = magnitude_sq < (uint32_t)(freefall_counts * freefall_counts);
+    if (!freefall) {
+        freefall_samples = 0;
+    } else if (freefall_samples < 255) {
+        freefall_samples++;
+    }
+
+    if (range_g != high_g) {
+        if (clipped || peak_g >= ACCEL_RANGE_UP_G || freefall_samples >= freefall_limit) {
+            range_g = high_g;
+            quiet_samples = 0;
+            switches_up++;
+            return true;
+        }
+        return false;
+    }
+
+    // Free fall is never quiet: the impact is still to come
+    if (peak_g > ACCEL_RANGE_DOWN_G || freefall_samples > 0) {
+        quiet_samples = 0;
+        return false;
+    }
+    if (++quiet_samples < quiet_limit) return false;
+
+    range_g = low_g;
+    quiet_samples = 0;
+    switches_down++;
+    return true;
+}
+
+void Accel_Ranger::setSampleRate(uint16_t rate_hz) {
+    uint32_t quiet = (uint32_t)ACCEL_RANGE_QUIET_SAMPLES * rate_hz / SENSOR_SAMPLE_RATE_HZ;
+    uint32_t freefall = (uint32_t)ACCEL_RANGE_FREEFALL_SAMPLES * rate_hz / SENSOR_SAMPLE_RATE_HZ;
+    quiet_limit = quiet < 1 ? 1 : (quiet > 65535 ? 65535 : quiet);
+    freefall_limit = freefall < 1 ? 1 : (freefall > 255 ? 255 : freefall);
+}
+
+int16_t Accel_Ranger::toCounts(float g, uint8_t range_g) {
+    float counts = g * countsPerG(range_g);
+    if (!(counts == counts)) return 0;   // NaN
+    if (counts >= 32767.0f) return 32767;
+    if (counts <= -32768.0f) return -32768;
+    return (int16_t)lroundf(counts);
+}
+
+uint8_t Accel_Ranger::toRegister(uint8_t range_g) {
+    switch (range_g) {
+        case 2:  return 0;
+        case 4:  return 1;
+        case 8:  return 2;
+        case 16: return 3;
+        default: return 2;
+    }
+}
+
+void Accel_Ranger::printStats() {
+    Serial.println("=== Accel Ranger ===");
+    Serial.print("Range: ±");
+    Serial.print(range_g);
+    Serial.print(" g (");
+    Serial.print(low_g);
+    Serial.print("/");
+    Serial.print(high_g);
+    Serial.println(" g)");
+    Serial.print("Switches: ");
+    Serial.print(switches_up);
+    Serial.print(" up, ");
+    Serial.print(switches_down);
+    Serial.println(" down");
+    Serial.print("High range: ");
+    Serial.print(samples ? 100.0f * high_samples / samples : 0.0f, 1);
+    Serial.print("% of ");
+    Serial.print(samples);
+    Serial.println(" samples");
+    Serial.print("Clipped samples: ");
+    Serial.println(clipped_samples);
+    Serial.println("====================");
+}
@@ -0,0 +1,184 @@
+/*
+ * SmartFall - IMU Decimator Test
+ *
+ * Pushes FIFO frames through IMU_Decimator the way
+ * MPU6050_Sensor::readFifo() does and checks the sample the sensor task
+ * gets on each tick.
+ *
+ * Hardware: ESP32 HUZZAH32 Feather (no sensors required)
+ *
+ * This test verifies:
+ * - Axes are the mean of the frames; peaks are the largest single frame
+ * - The clipped flag follows the peak frame, not any frame
+ * - Frames read at different scales convert at their own scale
+ * - A tick with no frames yields no sample; a late tick averages them all
+ * - One frame stays well inside its budget at IMU_SAMPLE_RATE_HZ
+ */
+
+#include "IMU_Decimator.h"
+
+#define GYRO_COUNTS_PER_DPS  32.8f    // ±1000 °/s
+#define TIMING_FRAMES        10000
+#define FRAME_BUDGET_US      20       // 2% of a core at 1 kHz
+
+int passed = 0;
+int failed = 0;
+
+void expect(const char* name, int32_t expected, int32_t actual) {
+    if (expected == actual) {
+        passed++;
+        Serial.print("✓ ");
+    } else {
+        failed++;
+        Serial.print("✗ ");
+    }
+    Serial.print(name);
+    Serial.print(": expected ");
+    Serial.print(expected);
+    Serial.print(", got ");
+    Serial.println(actual);
+}
+
+void expectTrue(const char* name, bool condition) {
+    expect(name, 1, condition ? 1 : 0);
+}
+
+int32_t milli(float value) {
+    return (int32_t)lroundf(1000.0f * value);
+}
+
+// One frame given in g and deg/s, quantized at range_g
+void pushFrame(IMU_Decimator& decimator, float ax, float ay, float az, float gz, uint8_t range_g) {
+    int16_t accel[3] = {Accel_Ranger::toCounts(ax, range_g), Accel_Ranger::toCounts(ay, range_g),
+                        Accel_Ranger::toCounts(az, range_g)};
+    int16_t gyro[3] = {0, 0, (int16_t)lroundf(gz * GYRO_COUNTS_PER_DPS)};
+    decimator.push(accel, gyro, range_g, GYRO_COUNTS_PER_DPS);
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(2000);
+
+    Serial.println("\n========================================");
+    Serial.println("      SmartFall IMU Decimator Test");
+    Serial.println("========================================\n");
+
+    IMU_Decimator decimator;
+    SensorData_t sample;
+    memset(&sample, 0, sizeof(sample));
+
+    // Test 1: Mean and peak
+    Serial.println("TEST 1: Mean and Peak");
+    Serial.println("----------------------");
+    {
+        // Nine frames at rest and one 10 g spike on z, as a 10 ms tick at 1 kHz
+        for (uint8_t i = 0; i < 9; i++) pushFrame(decimator, 0.0f, 0.0f, 1.0f, 10.0f, 16);
+        pushFrame(decimator, 0.0f, 0.0f, 10.0f, 200.0f, 16);
+        expectTrue("sample ready", decimator.take(sample));
+        expect("mean z (mg)", 1900, milli(sample.accel_z));
+        expect("mean x (mg)", 0, milli(sample.accel_x));
+        expect("mean gyro z (0.1 dps)", 290, (int32_t)lroundf(10.0f * sample.gyro_z));
+        expect("accel peak (mg)", 10000, milli(sample.accel_peak_g));
+        expect("gyro peak (dps)", 200, (int32_t)lroundf(sample.gyro_peak_dps));
+        expect("range of the peak frame", 16, sample.accel_range_g);
+        expectTrue("peak not clipped", !sample.accel_peak_clipped);
+    }
+    Serial.println();
+
+    // Test 2: Clipping follows the peak frame
+    Serial.println("TEST 2: Clipped Peak");
+    Serial.println("---------------------");
+    {
+        pushFrame(decimator, 20.0f, 0.0f, 0.0f, 0.0f, 16);     // Clips at 16 g
+        expectTrue("clipped peak flagged", decimator.take(sample) && sample.accel_peak_clipped);
+
+        pushFrame(decimator, 20.0f, 0.0f, 0.0f, 0.0f, 16);     // Clipped, 16 g
+        pushFrame(decimator, 12.0f, 12.0f, 0.0f, 0.0f, 16);    // 17 g, not clipped
+        decimator.take(sample);
+        expect("larger unclipped frame is the peak (mg)", 16971, milli(sample.accel_peak_g));
+        expectTrue("so the sample is not flagged", !sample.accel_peak_clipped);
+
+        pushFrame(decimator, 1.0f, 0.0f, 0.0f, 0.0f, 16);
+        decimator.take(sample);
+        expectTrue("flag cleared by the next take", !sample.accel_peak_clipped);
+    }
+    Serial.println();
+
+    // Test 3: Mixed scales
+    Serial.println("TEST 3: Mixed Scales");
+    Serial.println("---------------------");
+    {
+        pushFrame(decimator, 0.0f, 0.0f, 6.0f, 0.0f, 8);
+        pushFrame(decimator, 0.0f, 0.0f, 14.0f, 0.0f, 16);
+        decimator.take(sample);
+        expect("mean across scales (mg)", 10000, milli(sample.accel_z));
+        expect("peak at the high scale (mg)", 14000, milli(sample.accel_peak_g));
+        expect("range of the peak frame", 16, sample.accel_range_g);
+
+        pushFrame(decimator, 0.0f, 0.0f, 7.0f, 0.0f, 8);
+        pushFrame(decimator, 0.0f, 0.0f, 1.0f, 0.0f, 16);
+        decimator.take(sample);
+        expect("peak frame read at 8 g", 8, sample.accel_range_g);
+    }
+    Serial.println();
+
+    // Test 4: Tick timing
+    Serial.println("TEST 4: Tick Timing");
+    Serial.println("--------------------");
+    {
+        decimator.reset();
+        sample.accel_z = 123.0f;
+        expectTrue("no frames, no sample", !decimator.take(sample));
+        expect("sample left alone (mg)", 123000, milli(sample.accel_z));
+
+        // A late tick: the next one finds 11 frames and averages them all
+        for (uint8_t i = 0; i < 11; i++) pushFrame(decimator, 0.0f, 0.0f, i < 10 ? 1.0f : 12.0f, 0.0f, 16);
+        expect("pending frames", 11, decimator.getPendingFrames());
+        decimator.take(sample);
+        expect("mean of 11 frames (mg)", 2000, milli(sample.accel_z));
+        expect("pending after take", 0, decimator.getPendingFrames());
+        expect("max frames per sample", 11, decimator.getMaxFrames());
+        expect("total frames", 11, decimator.getTotalFrames());
+        expect("outputs", 1, decimator.getOutputs());
+        decimator.printStats();
+    }
+    Serial.println();
+
+    // Test 5: Frame cost
+    Serial.println("TEST 5: Frame Cost");
+    Serial.println("-------------------");
+    {
+        int16_t accel[3] = {100, -200, 4096};
+        int16_t gyro[3] = {10, 20, -30};
+        float sink = 0;
+        uint32_t start = micros();
+        for (uint32_t f = 0; f < TIMING_FRAMES; f++) {
+            accel[0] = (int16_t)(f & 1023);
+            decimator.push(accel, gyro, 16, GYRO_COUNTS_PER_DPS);
+            if (f % 10 == 9 && decimator.take(sample)) sink += sample.accel_peak_g;
+        }
+        float frame_us = (float)(micros() - start) / TIMING_FRAMES;
+
+        Serial.print("Per frame:    ");
+        Serial.print(frame_us, 3);
+        Serial.println(" us");
+        Serial.print("(checksum ");
+        Serial.print(sink, 1);
+        Serial.println(")");
+        expectTrue("frame within budget", frame_us < FRAME_BUDGET_US);
+    }
+    Serial.println();
+
+    Serial.print("Passed: ");
+    Serial.print(passed);
+    Serial.print("  Failed: ");
+    Serial.println(failed);
+
+    Serial.println("========================================");
+    Serial.println(failed == 0 ? "      ALL TESTS PASSED" : "      TESTS FAILED");
+    Serial.println("========================================");
+}
+
+void loop() {
+    delay(1000);
+}
@@ -0,0 +1,410 @@
+#include "Alert_Dispatcher.h"
+
+Alert_Dispatcher::Alert_Dispatcher()
+    : slot_count(0), running(false), alert_count(0), dispatch_ms(0), dispatch_us(0),
+      first_slot(-1), first_latency_ms(0) {
+#ifdef ARDUINO
+    state_mux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+    memset(slots, 0, sizeof(slots));
+}
+
+Alert_Dispatcher::~Alert_Dispatcher() {
+    end();
+}
+
+int8_t Alert_Dispatcher::addTransport(Alert_Transport* transport, uint32_t deadline_ms, ProfileScope_t scope) {
+    if (running || transport == nullptr || slot_count >= DISPATCH_MAX_TRANSPORTS) {
+        return -1;
+    }
+
+    Slot_t& slot = slots[slot_count];
+    memset(&slot, 0, sizeof(slot));
+    slot.transport = transport;
+    slot.deadline_ms = deadline_ms;
+    slot.scope = scope;
+    slot.state = DISPATCH_IDLE;
+    slot.owner = this;
+    slot.index = slot_count;
+    return (int8_t)slot_count++;
+}
+
+void Alert_Dispatcher::setDeadline(uint8_t index, uint32_t deadline_ms) {
+    if (index >= slot_count) return;
+    lock();
+    slots[index].deadline_ms = deadline_ms;
+    unlock();
+}
+
+bool Alert_Dispatcher::begin() {
+    if (running) return true;
+    if (slot_count == 0) {
+        Serial.println("[Dispatch] ERROR: No transports registered!");
+        return false;
+    }
+
+    running = true;
+    for (uint8_t i = 0; i < slot_count; i++) {
+#ifdef ARDUINO
+        char name[16];
+        snprintf(name, sizeof(name), "alert_%s", slots[i].transport->getName());
+
+        // Pinned so Profiler ticks (per-core CCOUNT) stay valid inside deliver()
+        if (xTaskCreatePinnedToCore(taskEntry, name, ALERT_DISPATCH_TASK_STACK, &slots[i],
+                                    ALERT_DISPATCH_TASK_PRIORITY, &slots[i].task,
+                                    ARDUINO_RUNNING_CORE) != pdPASS) {
+            Serial.print("[Dispatch] ERROR: Failed to create task for ");
+            Serial.println(slots[i].transport->getName());
+            return false;
+        }
+#else
+        threads[i] = std::thread(&Alert_Dispatcher::threadLoop, this, i);
+#endif
+    }
+
+    Serial.print("[Dispatch] ✓ ");
+    Serial.print(slot_count);
+    Serial.println(" transport tasks started");
+    return true;
+}
+
+void Alert_Dispatcher::end() {
+    if (!running) return;
+    lock();
+    running = false;
+    unlock();
+
+#ifdef ARDUINO
+    // Each task exits by itself once its deliver() returns (bounded by the
+    // transport's own timeout), so no lock or socket is left behind
+    for (uint8_t i = 0; i < slot_count; i++) {
+        if (slots[i].task != nullptr) xTaskNotifyGive(slots[i].task);
+    }
+    for (uint8_t i = 0; i < slot_count; i++) {
+        while (true) {
+            lock();
+            bool exited = slots[i].task == nullptr;
+            unlock();
+            if (exited) break;
+            delay(1);
+        }
+    }
+#else
+    for (uint8_t i = 0; i < slot_count; i++) {
+        if (threads[i].joinable()) threads[i].join();
+    }
+#endif
+}
+
+bool Alert_Dispatcher::dispatch(const EmergencyData_t& data) {
+    if (!running) return false;
+
+    // Query links before taking the lock; isAvailable() may be slow
+    bool available[DISPATCH_MAX_TRANSPORTS];
+    for (uint8_t i = 0; i < slot_count; i++) {
+        available[i] = slots[i].transport->isAvailable();
+    }
+
+    if (isBusy()) {
+        Serial.println("[Dispatch] Previous alert still in flight");
+        return false;
+    }
+
+    // No task is inside deliver() and none is queued, so the copy is safe
+    alert = data;
+
+    lock();
+    alert_count++;
+    dispatch_ms = millis();
+    dispatch_us = micros();
+    first_slot = -1;
+    first_latency_ms = 0;
+    for (uint8_t i = 0; i < slot_count; i++) {
+        Slot_t& slot = slots[i];
+        if (available[i]) {
+            slot.state = DISPATCH_QUEUED;
+            slot.busy = true;
+            slot.stats.dispatched++;
+        } else {
+            slot.state = DISPATCH_SKIPPED;
+            slot.stats.skipped++;
+        }
+    }
+    unlock();
+
+#ifdef ARDUINO
+    for (uint8_t i = 0; i < slot_count; i++) {
+        if (slots[i].state == DISPATCH_QUEUED) {
+            xTaskNotifyGive(slots[i].task);
+        }
+    }
+#endif
+    return true;
+}
+
+void Alert_Dispatcher::update() {
+    uint32_t elapsed = millis() - dispatch_ms;
+
+    lock();
+    for (uint8_t i = 0; i < slot_count; i++) {
+        Slot_t& slot = slots[i];
+        bool in_flight = (slot.state == DISPATCH_QUEUED || slot.state == DISPATCH_SENDING);
+        if (in_flight && elapsed >= slot.deadline_ms) {
+            slot.state = DISPATCH_TIMED_OUT;
+            slot.stats.timed_out++;
+        }
+    }
+    unlock();
+}
+
+DispatchOutcome_t Alert_Dispatcher::wait(uint32_t timeout_ms) {
+    uint32_t start = millis();
+    while (true) {
+        update();
+        DispatchOutcome_t outcome = getOutcome();
+        if (outcome != DISPATCH_OUTCOME_PENDING || millis() - start >= timeout_ms) {
+            return outcome;
+        }
+        delay(1);
+    }
+}
+
+DispatchOutcome_t Alert_Dispatcher::getOutcome() {
+    DispatchOutcome_t outcome = DISPATCH_OUTCOME_FAILED;
+
+    lock();
+    if (alert_count == 0) {
+        outcome = DISPATCH_OUTCOME_NONE;
+    } else if (first_slot >= 0) {
+        outcome = DISPATCH_OUTCOME_DELIVERED;
+    } else {
+        for (uint8_t i = 0; i < slot_count; i++) {
+            if (slots[i].state == DISPATCH_QUEUED || slots[i].state == DISPATCH_SENDING) {
+                outcome = DISPATCH_OUTCOME_PENDING;
+            }
+        }
+    }
+    unlock();
+    return outcome;
+}
+
+bool Alert_Dispatcher::isBusy() {
+    bool busy = false;
+    lock();
+    for (uint8_t i = 0; i < slot_count; i++) {
+        busy |= slots[i].busy;
+    }
+    unlock();
+    return busy;
+}
+
+uint8_t Alert_Dispatcher::getTransportCount() {
+    return slot_count;
+}
+
+DispatchState_t Alert_Dispatcher::getState(uint8_t index) {
+    if (index >= slot_count) return DISPATCH_IDLE;
+    lock();
+    DispatchState_t state = slots[index].state;
+    unlock();
+    return state;
+}
+
+int8_t Alert_Dispatcher::getFirstTransport() {
+    lock();
+    int8_t first = first_slot;
+    unlock();
+    return first;
+}
+
+uint32_t Alert_Dispatcher::getFirstLatency() {
+    lock();
+    uint32_t latency = first_latency_ms;
+    unlock();
+    return latency;
+}
+
+uint32_t Alert_Dispatcher::getLongestDeadline() {
+    uint32_t longest = 0;
+    for (uint8_t i = 0; i < slot_count; i++) {
+        if (slots[i].deadline_ms > longest) longest = slots[i].deadline_ms;
+    }
+    return longest;
+}
+
+const char* Alert_Dispatcher::getTransportName(uint8_t index) {
+    return index < slot_count ? slots[index].transport->getName() : "none";
+}
+
+#ifdef ARDUINO
+TaskHandle_t Alert_Dispatcher::getTaskHandle(uint8_t index) {
+    return index < slot_count ? slots[index].task : nullptr;
+}
+#endif
+
+const TransportStats_t& Alert_Dispatcher::getStats(uint8_t index) {
+    return slots[index < slot_count ? index : 0].stats;
+}
+
+void Alert_Dispatcher::printStats() {
+    Serial.println("=== Alert Dispatch ===");
+    for (uint8_t i = 0; i < slot_count; i++) {
+        const Slot_t& slot = slots[i];
+        const ProfileHistogram_t& latency = Profiler::getScope(slot.scope);
+
+        Serial.print(slot.transport->getName());
+        Serial.print(": ");
+        Serial.print(getStateName(slot.state));
+        Serial.print(" | acked ");
+        Serial.print(slot.stats.acked);
+        Serial.print("/");
+        Serial.print(slot.stats.dispatched);
+        Serial.print(" (first ");
+        Serial.print(slot.stats.first);
+        Serial.print(", late ");
+        Serial.print(slot.stats.late_acks);
+        Serial.print(") | failed ");
+        Serial.print(slot.stats.failed);
+        Serial.print(" | timed out ");
+        Serial.print(slot.stats.timed_out);
+        Serial.print(" | skipped ");
+        Serial.println(slot.stats.skipped);
+
+        Serial.print("  deadline ");
+        Serial.print(slot.deadline_ms);
+        Serial.print(" ms | latency p50 ");
+        Serial.print(Profiler::getPercentile(latency, 50) / 1000);
+        Serial.print(" ms, p99 ");
+        Serial.print(Profiler::getPercentile(latency, 99) / 1000);
+        Serial.print(" ms, max ");
+        Serial.print(latency.max_us / 1000);
+        Serial.println(" ms");
+    }
+    Serial.println("======================");
+}
+
+const char* Alert_Dispatcher::getStateName(DispatchState_t state) {
+    switch (state) {
+        case DISPATCH_IDLE:       return "idle";
+        case DISPATCH_SKIPPED:    return "skipped";
+        case DISPATCH_QUEUED:     return "queued";
+        case DISPATCH_SENDING:    return "sending";
+        case DISPATCH_ACKED:      return "acked";
+        case DISPATCH_FAILED:     return "failed";
+        case DISPATCH_TIMED_OUT:  return "timed out";
+        default:                  return "unknown";
+    }
+}
+
+bool Alert_Dispatcher::serviceTransport(uint8_t index) {
+    if (index >= slot_count) return false;
+    Slot_t& slot = slots[index];
+
+    lock();
+    bool queued = (slot.state == DISPATCH_QUEUED);
+    if (queued) {
+        slot.state = DISPATCH_SENDING;
+    }
+    uint32_t remaining = slot.deadline_ms - (millis() - dispatch_ms);
+    unlock();
+
+    if (!queued) return false;
+
+    // Deadline may already have been applied by update(); still try, a
+    // late confirmation counts
+    if ((int32_t)remaining <= 0) remaining = 1;
+    bool confirmed = slot.transport->deliver(alert, remaining);
+    finishDelivery(index, confirmed);
+    return true;
+}
+
+// Private helper functions
+
+void Alert_Dispatcher::finishDelivery(uint8_t index, bool confirmed) {
+    Slot_t& slot = slots[index];
+    uint32_t elapsed_us = micros() - dispatch_us;
+    bool first = false;
+
+    lock();
+    bool late = (slot.state == DISPATCH_TIMED_OUT);
+    slot.busy = false;
+    slot.stats.last_latency_ms = elapsed_us / 1000;
+
+    if (confirmed) {
+        slot.state = DISPATCH_ACKED;
+        slot.stats.acked++;
+        if (late) slot.stats.late_acks++;
+        if (first_slot < 0) {
+            first_slot = (int8_t)index;
+            first_latency_ms = elapsed_us / 1000;
+            slot.stats.first++;
+            first = true;
+        }
+    } else if (!late) {
+        slot.state = DISPATCH_FAILED;
+        slot.stats.failed++;
+    }
+    unlock();
+
+    if (confirmed) {
+        PROFILE_MICROS(slot.scope, elapsed_us);
+        if (first) {
+            PROFILE_MICROS(PROFILE_ALERT_FIRST, elapsed_us);
+        }
+    }
+
+    if (DEBUG_COMMUNICATION) {
+        Serial.print("[Dispatch] ");
+        Serial.print(slot.transport->getName());
+        Serial.print(confirmed ? " ✓ confirmed in " : " ✗ failed after ");
+        Serial.print(elapsed_us / 1000);
+        Serial.println(late ? " ms (after deadline)" : " ms");
+    }
+}
+
+void Alert_Dispatcher::lock() {
+#ifdef ARDUINO
+    portENTER_CRITICAL(&state_mux);
+#else
+    state_mutex.lock();
+#endif
+}
+
+void Alert_Dispatcher::unlock() {
+#ifdef ARDUINO
+    portEXIT_CRITICAL(&state_mux);
+#else
+    state_mutex.unlock();
+#endif
+}
+
+#ifdef ARDUINO
+void Alert_Dispatcher::taskEntry(void* arg) {
+    Slot_t* slot = (Slot_t*)arg;
+
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        slot->owner->lock();
+        bool active = slot->owner->running;
+        if (!active) slot->task = nullptr;
+        slot->owner->unlock();
+        if (!active) vTaskDelete(nullptr);
+
+        slot->owner->serviceTransport(slot->index);
+    }
+}
+#else
+void Alert_Dispatcher::threadLoop(uint8_t index) {
+    while (true) {
+        lock();
+        bool active = running;
+        unlock();
+        if (!active) return;
+
+        if (!serviceTransport(index)) {
+            delay(1);
+        }
+    }
+}
+#endif
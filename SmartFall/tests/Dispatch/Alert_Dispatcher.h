@@ -0,0 +1,157 @@
+#ifndef ALERT_DISPATCHER_H
+#define ALERT_DISPATCHER_H
+
+#include <Arduino.h>
+#include "data_types.h"
+#include "config.h"
+#include "Profiler.h"
+
+#ifndef ARDUINO
+#include <mutex>
+#include <thread>
+#endif
+
+/*
+ * Concurrent emergency alert dispatch.
+ *
+ * Every transport (WiFi, BLE) has its own task, which blocks in
+ * deliver() while the others keep going. A dead server therefore no
+ * longer holds up the phone. dispatch() hands the alert to every
+ * available transport at once. wait() returns as soon as the first one
+ * confirms delivery. The others finish in the background, and their
+ * results are still recorded.
+ *
+ * Each transport has its own deadline. A transport that misses it
+ * counts as timed out. A confirmation that arrives after the deadline
+ * still counts as delivered, and is also counted as late.
+ *
+ * A new alert is refused while a transport is still inside deliver()
+ * for the previous one, because the alert copy is shared. On the host
+ * the transport tasks are std::threads.
+ */
+
+#define DISPATCH_MAX_TRANSPORTS   2
+
+typedef enum {
+    DISPATCH_IDLE,
+    DISPATCH_SKIPPED,        // Link down at dispatch time
+    DISPATCH_QUEUED,
+    DISPATCH_SENDING,
+    DISPATCH_ACKED,
+    DISPATCH_FAILED,
+    DISPATCH_TIMED_OUT
+} DispatchState_t;
+
+typedef enum {
+    DISPATCH_OUTCOME_NONE,        // Nothing dispatched yet
+    DISPATCH_OUTCOME_PENDING,     // In flight, no confirmation yet
+    DISPATCH_OUTCOME_DELIVERED,   // At least one transport confirmed
+    DISPATCH_OUTCOME_FAILED       // Every transport failed, timed out or was skipped
+} DispatchOutcome_t;
+
+// One alert path. deliver() runs on the transport's own task.
+class Alert_Transport {
+public:
+    virtual ~Alert_Transport() {}
+    virtual const char* getName() = 0;
+    virtual bool isAvailable() = 0;
+    // Blocks until the receiver confirms (true) or the send fails; should
+    // give up by timeout_ms
+    virtual bool deliver(const EmergencyData_t& data, uint32_t timeout_ms) = 0;
+};
+
+typedef struct {
+    uint32_t dispatched;
+    uint32_t acked;
+    uint32_t failed;
+    uint32_t timed_out;
+    uint32_t late_acks;           // Confirmed after the deadline
+    uint32_t skipped;
+    uint32_t first;               // Alerts this transport confirmed first
+    uint32_t last_latency_ms;     // Dispatch -> result of the latest alert
+} TransportStats_t;
+
+class Alert_Dispatcher {
+private:
+    typedef struct {
+        Alert_Transport* transport;
+        uint32_t deadline_ms;
+        ProfileScope_t scope;           // Latency histogram for confirmations
+        DispatchState_t state;
+        bool busy;                      // Task is inside deliver()
+        TransportStats_t stats;
+        Alert_Dispatcher* owner;
+        uint8_t index;
+#ifdef ARDUINO
+        TaskHandle_t task;
+#endif
+    } Slot_t;
+
+    Slot_t slots[DISPATCH_MAX_TRANSPORTS];
+    uint8_t slot_count;
+    bool running;
+
+    // Current alert
+    EmergencyData_t alert;
+    uint32_t alert_count;
+    uint32_t dispatch_ms;
+    uint32_t dispatch_us;
+    int8_t first_slot;                  // First transport to confirm, -1 if none yet
+    uint32_t first_latency_ms;
+
+#ifdef ARDUINO
+    portMUX_TYPE state_mux;
+#else
+    std::mutex state_mutex;
+    std::thread threads[DISPATCH_MAX_TRANSPORTS];
+#endif
+
+public:
+    Alert_Dispatcher();
+    ~Alert_Dispatcher();
+
+    // Setup: register transports, then start their tasks
+    int8_t addTransport(Alert_Transport* transport, uint32_t deadline_ms, ProfileScope_t scope);
+    void setDeadline(uint8_t index, uint32_t deadline_ms);
+    bool begin();
+    void end();                                     // Waits for each task to finish its delivery
+
+    // Dispatch
+    bool dispatch(const EmergencyData_t& data);     // False while the previous alert is in flight
+    void update();                                  // Applies deadlines
+    DispatchOutcome_t wait(uint32_t timeout_ms);    // Until first confirmation or all settled
+    DispatchOutcome_t getOutcome();
+    bool isBusy();
+
+    // Results for the current alert
+    uint8_t getTransportCount();
+    DispatchState_t getState(uint8_t index);
+    int8_t getFirstTransport();
+    uint32_t getFirstLatency();
+    uint32_t getLongestDeadline();
+    const char* getTransportName(uint8_t index);
+#ifdef ARDUINO
+    TaskHandle_t getTaskHandle(uint8_t index);
+#endif
+
+    // Statistics
+    const TransportStats_t& getStats(uint8_t index);
+    void printStats();
+    static const char* getStateName(DispatchState_t state);
+
+    // Runs one queued delivery for a transport (task body)
+    bool serviceTransport(uint8_t index);
+
+private:
+    // Private helper functions
+    void finishDelivery(uint8_t index, bool confirmed);
+    void lock();
+    void unlock();
+#ifdef ARDUINO
+    static void taskEntry(void* arg);
+#else
+    void threadLoop(uint8_t index);
+#endif
+};
+
+#endif // ALERT_DISPATCHER_H
@@ -0,0 +1,300 @@
+/*
+ * SmartFall - Alert Dispatch Test
+ *
+ * Drives the parallel alert dispatcher with fake transports that block
+ * for a set time and then confirm, fail, or hang past their deadline.
+ *
+ * Hardware: ESP32 HUZZAH32 Feather (no sensors or network required)
+ *
+ * This test verifies:
+ * - Both transports are sent to concurrently, not one after the other
+ * - wait() returns on the first confirmation while the slower one continues
+ * - A dead server does not delay a working BLE link
+ * - An unavailable transport is skipped
+ * - Per-transport deadlines time out, and late confirmations still count
+ * - A new alert is refused while the previous one is in flight
+ * - Per-transport latency histograms in the Profiler
+ */
+
+#include "Alert_Dispatcher.h"
+
+#define SLACK_MS  60    // Scheduling allowance for timing checks
+
+class Fake_Transport : public Alert_Transport {
+public:
+    const char* name;
+    bool available;
+    bool succeed;
+    uint32_t delay_ms;
+    volatile uint32_t calls;
+    volatile uint32_t last_timeout;
+
+    Fake_Transport(const char* name)
+        : name(name), available(true), succeed(true), delay_ms(0), calls(0), last_timeout(0) {}
+
+    void set(bool ok, uint32_t ms, bool up = true) {
+        succeed = ok;
+        delay_ms = ms;
+        available = up;
+    }
+
+    const char* getName() override { return name; }
+    bool isAvailable() override { return available; }
+
+    bool deliver(const EmergencyData_t&, uint32_t timeout_ms) override {
+        calls++;
+        last_timeout = timeout_ms;
+        delay(delay_ms);
+        return succeed;
+    }
+};
+
+Fake_Transport wifi("wifi");
+Fake_Transport ble("ble");
+Alert_Dispatcher dispatcher;
+int8_t wifi_slot = -1;
+int8_t ble_slot = -1;
+EmergencyData_t alert;
+
+int passed = 0;
+int failed = 0;
+
+void expect(const char* name, uint32_t expected, uint32_t actual) {
+    if (expected == actual) {
+        passed++;
+        Serial.print("✓ ");
+    } else {
+        failed++;
+        Serial.print("✗ ");
+    }
+    Serial.print(name);
+    Serial.print(": expected ");
+    Serial.print(expected);
+    Serial.print(", got ");
+    Serial.println(actual);
+}
+
+void expectTrue(const char* name, bool condition) {
+    if (condition) {
+        passed++;
+        Serial.print("✓ ");
+    } else {
+        failed++;
+        Serial.print("✗ ");
+    }
+    Serial.println(name);
+}
+
+// Waits until neither transport is inside deliver()
+void settle() {
+    uint32_t start = millis();
+    while (dispatcher.isBusy() && millis() - start < 5000) {
+        delay(1);
+    }
+}
+
+uint32_t timedWait(DispatchOutcome_t& outcome, uint32_t timeout_ms) {
+    uint32_t start = millis();
+    outcome = dispatcher.wait(timeout_ms);
+    return millis() - start;
+}
+
+void printElapsed(const char* label, uint32_t elapsed) {
+    Serial.print(label);
+    Serial.print(" after ");
+    Serial.print(elapsed);
+    Serial.println(" ms");
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(2000);
+
+    Serial.println("\n========================================");
+    Serial.println("     SmartFall Alert Dispatch Test");
+    Serial.println("========================================\n");
+
+    Profiler::begin();
+    memset(&alert, 0, sizeof(alert));
+    alert.timestamp = 1000;
+
+    wifi_slot = dispatcher.addTransport(&wifi, 500, PROFILE_ALERT_WIFI);
+    ble_slot = dispatcher.addTransport(&ble, 500, PROFILE_ALERT_BLE);
+    expectTrue("transports registered", wifi_slot == 0 && ble_slot == 1);
+    expectTrue("dispatcher started", dispatcher.begin());
+    expectTrue("no transports after begin", dispatcher.addTransport(&wifi, 100, PROFILE_ALERT_WIFI) < 0);
+    expect("outcome before any alert", DISPATCH_OUTCOME_NONE, dispatcher.getOutcome());
+    Serial.println();
+
+    // Test 1: Concurrent delivery
+    Serial.println("TEST 1: Concurrent Delivery");
+    Serial.println("---------------------------");
+    {
+        wifi.set(true, 200);
+        ble.set(true, 200);
+        uint32_t start = millis();
+        expectTrue("dispatch accepted", dispatcher.dispatch(alert));
+        settle();
+        uint32_t elapsed = millis() - start;
+        printElapsed("Both confirmed", elapsed);
+
+        expectTrue("ran in parallel", elapsed < 200 * 2 - SLACK_MS);
+        expect("wifi state", DISPATCH_ACKED, dispatcher.getState(wifi_slot));
+        expect("ble state", DISPATCH_ACKED, dispatcher.getState(ble_slot));
+        expect("outcome", DISPATCH_OUTCOME_DELIVERED, dispatcher.getOutcome());
+    }
+    Serial.println();
+
+    // Test 2: First confirmation short-circuits
+    Serial.println("TEST 2: First Success Short-Circuit");
+    Serial.println("-----------------------------------");
+    {
+        wifi.set(true, 400);
+        ble.set(true, 50);
+        dispatcher.dispatch(alert);
+        DispatchOutcome_t outcome;
+        uint32_t elapsed = timedWait(outcome, 1000);
+        printElapsed("wait() returned", elapsed);
+
+        expect("outcome", DISPATCH_OUTCOME_DELIVERED, outcome);
+        expect("first transport", ble_slot, dispatcher.getFirstTransport());
+        expectTrue("returned with BLE", elapsed < 50 + SLACK_MS);
+        expect("wifi still sending", DISPATCH_SENDING, dispatcher.getState(wifi_slot));
+        expectTrue("busy until wifi finishes", dispatcher.isBusy());
+        expectTrue("refused while in flight", !dispatcher.dispatch(alert));
+
+        settle();
+        expect("wifi confirmed later", DISPATCH_ACKED, dispatcher.getState(wifi_slot));
+        expect("first transport unchanged", ble_slot, dispatcher.getFirstTransport());
+        expectTrue("first latency ~ BLE", dispatcher.getFirstLatency() < 50 + SLACK_MS);
+    }
+    Serial.println();
+
+    // Test 3: Dead server does not hold up BLE
+    Serial.println("TEST 3: WiFi Failure");
+    Serial.println("--------------------");
+    {
+        wifi.set(false, 300);
+        ble.set(true, 100);
+        dispatcher.dispatch(alert);
+        DispatchOutcome_t outcome;
+        uint32_t elapsed = timedWait(outcome, 1000);
+        printElapsed("wait() returned", elapsed);
+
+        expect("outcome", DISPATCH_OUTCOME_DELIVERED, outcome);
+        expectTrue("not held up by wifi", elapsed < 100 + SLACK_MS);
+        settle();
+        expect("wifi state", DISPATCH_FAILED, dispatcher.getState(wifi_slot));
+        expect("wifi failures", 1, dispatcher.getStats(wifi_slot).failed);
+    }
+    Serial.println();
+
+    // Test 4: Everything fails
+    Serial.println("TEST 4: All Transports Fail");
+    Serial.println("---------------------------");
+    {
+        wifi.set(false, 80);
+        ble.set(false, 20);
+        dispatcher.dispatch(alert);
+        DispatchOutcome_t outcome;
+        uint32_t elapsed = timedWait(outcome, 1000);
+        printElapsed("wait() returned", elapsed);
+
+        expect("outcome", DISPATCH_OUTCOME_FAILED, outcome);
+        expectTrue("waited for the slower failure", elapsed >= 80 - 5);
+        expect("first transport", (uint32_t)-1, (uint32_t)dispatcher.getFirstTransport());
+        expect("ble state", DISPATCH_FAILED, dispatcher.getState(ble_slot));
+    }
+    Serial.println();
+
+    // Test 5: Unavailable transport
+    Serial.println("TEST 5: Skipped Transport");
+    Serial.println("-------------------------");
+    {
+        uint32_t ble_calls = ble.calls;
+        wifi.set(true, 30);
+        ble.set(true, 10, false);
+        dispatcher.dispatch(alert);
+        DispatchOutcome_t outcome = dispatcher.wait(1000);
+        settle();
+
+        expect("outcome", DISPATCH_OUTCOME_DELIVERED, outcome);
+        expect("ble state", DISPATCH_SKIPPED, dispatcher.getState(ble_slot));
+        expect("ble not called", ble_calls, ble.calls);
+        expect("ble skipped count", 1, dispatcher.getStats(ble_slot).skipped);
+        expect("first transport", wifi_slot, dispatcher.getFirstTransport());
+
+        wifi.set(true, 10, false);
+        dispatcher.dispatch(alert);
+        expect("nothing available fails at once", DISPATCH_OUTCOME_FAILED, dispatcher.wait(0));
+    }
+    Serial.println();
+
+    // Test 6: Deadlines and late confirmations
+    Serial.println("TEST 6: Deadlines");
+    Serial.println("-----------------");
+    {
+        dispatcher.setDeadline(wifi_slot, 150);
+        dispatcher.setDeadline(ble_slot, 100);
+        expect("longest deadline", 150, dispatcher.getLongestDeadline());
+
+        wifi.set(true, 400);
+        ble.set(false, 300);
+        dispatcher.dispatch(alert);
+        DispatchOutcome_t outcome;
+        uint32_t elapsed = timedWait(outcome, 1000);
+        printElapsed("wait() returned", elapsed);
+
+        expect("outcome", DISPATCH_OUTCOME_FAILED, outcome);
+        expectTrue("returned at the longest deadline", elapsed >= 150 && elapsed < 150 + SLACK_MS);
+        expect("wifi state", DISPATCH_TIMED_OUT, dispatcher.getState(wifi_slot));
+        expect("ble state", DISPATCH_TIMED_OUT, dispatcher.getState(ble_slot));
+
+        settle();
+        expectTrue("deadline passed to deliver()", wifi.last_timeout <= 150 && wifi.last_timeout > 100);
+        expect("late wifi ack delivers", DISPATCH_OUTCOME_DELIVERED, dispatcher.getOutcome());
+        expect("wifi state", DISPATCH_ACKED, dispatcher.getState(wifi_slot));
+        expect("wifi late acks", 1, dispatcher.getStats(wifi_slot).late_acks);
+        expect("ble stays timed out", DISPATCH_TIMED_OUT, dispatcher.getState(ble_slot));
+        expect("ble timeouts", 1, dispatcher.getStats(ble_slot).timed_out);
+
+        dispatcher.setDeadline(wifi_slot, 500);
+        dispatcher.setDeadline(ble_slot, 500);
+    }
+    Serial.println();
+
+    // Test 7: Latency histograms
+    Serial.println("TEST 7: Latency Histograms");
+    Serial.println("--------------------------");
+    {
+        const TransportStats_t& wifi_stats = dispatcher.getStats(wifi_slot);
+        const TransportStats_t& ble_stats = dispatcher.getStats(ble_slot);
+
+        expect("wifi histogram = wifi acks", wifi_stats.acked,
+               Profiler::getScope(PROFILE_ALERT_WIFI).count);
+        expect("ble histogram = ble acks", ble_stats.acked,
+               Profiler::getScope(PROFILE_ALERT_BLE).count);
+        expect("first histogram = alerts delivered", wifi_stats.first + ble_stats.first,
+               Profiler::getScope(PROFILE_ALERT_FIRST).count);
+        expectTrue("wifi max latency >= 400 ms",
+                   Profiler::getScope(PROFILE_ALERT_WIFI).max_us >= 400000);
+
+        dispatcher.printStats();
+    }
+    Serial.println();
+
+    dispatcher.end();
+
+    Serial.print("Passed: ");
+    Serial.print(passed);
+    Serial.print("  Failed: ");
+    Serial.println(failed);
+
+    Serial.println("========================================");
+    Serial.println(failed == 0 ? "      ALL TESTS PASSED" : "      TESTS FAILED");
+    Serial.println("========================================");
+}
+
+void loop() {
+    delay(1000);
+}
@@ -0,0 +1,250 @@
+#include "Event_Bus.h"
+
+#ifdef ARDUINO
+#include <esp_timer.h>
+#endif
+
+#define EVENT_RING_MASK  (EVENT_RING_SIZE - 1)
+
+Event_Bus::Event_Bus() : head(0), published(0), subscriber_count(0) {
+    memset(ring, 0, sizeof(ring));
+    memset(subscribers, 0, sizeof(subscribers));
+#ifdef ARDUINO
+    bus_mux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+}
+
+int8_t Event_Bus::subscribe(const char* name, uint32_t mask, EventHandler_t handler) {
+    lock();
+    if (subscriber_count >= EVENT_MAX_SUBSCRIBERS) {
+        unlock();
+        Serial.println("[Events] ERROR: Too many subscribers!");
+        return -1;
+    }
+
+    Subscriber_t& subscriber = subscribers[subscriber_count];
+    subscriber.name = name;
+    subscriber.mask = mask;
+    subscriber.handler = handler;
+    subscriber.cursor = head;           // Only events published from now on
+    subscriber.stats.name = name;
+    subscriber.stats.mask = mask;
+    int8_t id = (int8_t)subscriber_count++;
+    unlock();
+    return id;
+}
+
+void Event_Bus::publish(EventType_t type, uint32_t value) {
+#ifdef ARDUINO
+    TaskHandle_t wake[EVENT_MAX_SUBSCRIBERS];
+    uint8_t wake_count = 0;
+
+    portENTER_CRITICAL(&bus_mux);
+    store(type, value);
+    for (uint8_t i = 0; i < subscriber_count; i++) {
+        if ((subscribers[i].mask & EVENT_BIT(type)) && subscribers[i].waiter != nullptr) {
+            wake[wake_count++] = subscribers[i].waiter;
+        }
+    }
+    portEXIT_CRITICAL(&bus_mux);
+
+    for (uint8_t i = 0; i < wake_count; i++) {
+        xTaskNotifyGive(wake[i]);
+    }
+#else
+    lock();
+    store(type, value);
+    unlock();
+    bus_signal.notify_all();
+#endif
+}
+
+void IRAM_ATTR Event_Bus::publishFromISR(EventType_t type, uint32_t value) {
+#ifdef ARDUINO
+    BaseType_t woken = pdFALSE;
+
+    portENTER_CRITICAL_ISR(&bus_mux);
+    store(type, value);
+    for (uint8_t i = 0; i < subscriber_count; i++) {
+        if ((subscribers[i].mask & EVENT_BIT(type)) && subscribers[i].waiter != nullptr) {
+            vTaskNotifyGiveFromISR(subscribers[i].waiter, &woken);
+        }
+    }
+    portEXIT_CRITICAL_ISR(&bus_mux);
+
+    if (woken == pdTRUE) {
+        portYIELD_FROM_ISR();
+    }
+#else
+    publish(type, value);
+#endif
+}
+
+bool Event_Bus::poll(uint8_t id, Event_t& event) {
+    if (id >= subscriber_count) return false;
+    Subscriber_t& subscriber = subscribers[id];
+    bool found = false;
+
+    lock();
+    if (pendingLocked(subscriber)) {
+        event = ring[subscriber.cursor & EVENT_RING_MASK];
+        subscriber.cursor++;
+        subscriber.stats.received++;
+        found = true;
+    }
+    unlock();
+    return found;
+}
+
+uint8_t Event_Bus::dispatch(uint8_t id, uint8_t max_events) {
+    if (id >= subscriber_count) return 0;
+    Subscriber_t& subscriber = subscribers[id];
+
+    uint8_t handled = 0;
+    Event_t event;
+    while (handled < max_events && poll(id, event)) {
+        uint32_t latency = micros() - event.timestamp_us;
+        if (latency > subscriber.stats.max_latency_us) {
+            subscriber.stats.max_latency_us = latency;
+        }
+        PROFILE_MICROS(PROFILE_EVENT_LATENCY, latency);
+
+        if (subscriber.handler != nullptr) {
+            subscriber.handler(event);
+        }
+        handled++;
+    }
+    return handled;
+}
+
+bool Event_Bus::wait(uint8_t id, uint32_t timeout_ms) {
+    if (id >= subscriber_count) return false;
+    Subscriber_t& subscriber = subscribers[id];
+
+#ifdef ARDUINO
+    lock();
+    bool pending = pendingLocked(subscriber);
+    subscriber.waiter = xTaskGetCurrentTaskHandle();
+    unlock();
+
+    if (!pending) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeout_ms));
+    }
+    return hasPending(id);
+#else
+    std::unique_lock<std::mutex> guard(bus_mutex);
+    return bus_signal.wait_for(guard, std::chrono::milliseconds(timeout_ms),
+                               [&]() { return pendingLocked(subscriber); });
+#endif
+}
+
+bool Event_Bus::hasPending(uint8_t id) {
+    if (id >= subscriber_count) return false;
+    lock();
+    bool pending = pendingLocked(subscribers[id]);
+    unlock();
+    return pending;
+}
+
+uint32_t Event_Bus::getPublished() {
+    lock();
+    uint32_t count = published;
+    unlock();
+    return count;
+}
+
+const EventSubscriberStats_t& Event_Bus::getStats(uint8_t id) {
+    return subscribers[id < subscriber_count ? id : 0].stats;
+}
+
+void Event_Bus::printStats() {
+    Serial.println("=== Event Bus ===");
+    Serial.print("Published: ");
+    Serial.println(getPublished());
+    for (uint8_t i = 0; i < subscriber_count; i++) {
+        const EventSubscriberStats_t& stats = subscribers[i].stats;
+        Serial.print(stats.name);
+        Serial.print(": received ");
+        Serial.print(stats.received);
+        Serial.print(" | dropped ");
+        Serial.print(stats.dropped);
+        Serial.print(" | max latency ");
+        Serial.print(stats.max_latency_us);
+        Serial.println(" us");
+    }
+    Serial.println("=================");
+}
+
+const char* Event_Bus::getEventName(uint8_t type) {
+    switch (type) {
+        case EVENT_FALL_DETECTED:      return "fall_detected";
+        case EVENT_SOS_PRESSED:        return "sos_pressed";
+        case EVENT_ALERT_SENT:         return "alert_sent";
+        case EVENT_ALERT_FAILED:       return "alert_failed";
+        case EVENT_ALERT_CANCELLED:    return "alert_cancelled";
+        case EVENT_COUNTDOWN_STARTED:  return "countdown_started";
+        case EVENT_COUNTDOWN_TICK:     return "countdown_tick";
+        case EVENT_TEST_ALERT:         return "test_alert";
+        case EVENT_BLE_CONNECTED:      return "ble_connected";
+        case EVENT_BLE_DISCONNECTED:   return "ble_disconnected";
+        case EVENT_BLE_COMMAND:        return "ble_command";
+        case EVENT_COMMAND_DONE:       return "command_done";
+        case EVENT_LOW_BATTERY:        return "low_battery";
+        case EVENT_SYSTEM_READY:       return "system_ready";
+        default:                       return "unknown";
+    }
+}
+
+// Private helper functions
+
+void IRAM_ATTR Event_Bus::store(EventType_t type, uint32_t value) {
+    // A subscriber a full ring behind is about to lose its oldest event
+    for (uint8_t i = 0; i < subscriber_count; i++) {
+        Subscriber_t& subscriber = subscribers[i];
+        if (head - subscriber.cursor >= EVENT_RING_SIZE) {
+            if (subscriber.mask & EVENT_BIT(ring[subscriber.cursor & EVENT_RING_MASK].type)) {
+                subscriber.stats.dropped++;
+            }
+            subscriber.cursor++;
+        }
+    }
+
+    Event_t& event = ring[head & EVENT_RING_MASK];
+    event.type = (uint8_t)type;
+    event.value = value;
+#ifdef ARDUINO
+    event.timestamp_us = (uint32_t)esp_timer_get_time();    // micros() clock, and in IRAM
+#else
+    event.timestamp_us = micros();
+#endif
+    head++;
+    published++;
+}
+
+bool Event_Bus::pendingLocked(Subscriber_t& subscriber) {
+    // Skip events this subscriber does not want
+    while (subscriber.cursor != head) {
+        const Event_t& event = ring[subscriber.cursor & EVENT_RING_MASK];
+        if (subscriber.mask & EVENT_BIT(event.type)) {
+            return true;
+        }
+        subscriber.cursor++;
+    }
+    return false;
+}
+
+void Event_Bus::lock() {
+#ifdef ARDUINO
+    portENTER_CRITICAL(&bus_mux);
+#else
+    bus_mutex.lock();
+#endif
+}
+
+void Event_Bus::unlock() {
+#ifdef ARDUINO
+    portEXIT_CRITICAL(&bus_mux);
+#else
+    bus_mutex.unlock();
+#endif
+}
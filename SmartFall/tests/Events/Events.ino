@@ -0,0 +1,315 @@
+/*
+ * SmartFall - Event Bus Test
+ *
+ * Exercises the publish/subscribe event bus on its own: several
+ * subscribers with different masks, a subscriber that falls behind, and
+ * a consumer task blocked in wait() to measure dispatch latency.
+ *
+ * Hardware: ESP32 HUZZAH32 Feather (no sensors required)
+ *
+ * This test verifies:
+ * - Each subscriber sees its matching events, in publish order
+ * - Every subscriber gets its own copy (fan-out)
+ * - A lagging subscriber loses only the oldest events, counted as dropped
+ * - Producers never block, even with no consumer reading
+ * - dispatch() calls the handler and respects its event limit
+ * - wait() times out when nothing is pending
+ * - Publish -> handler latency for a consumer blocked in wait()
+ */
+
+#include <atomic>
+#include <algorithm>
+#include "Event_Bus.h"
+
+#ifndef ARDUINO
+#include <thread>
+#endif
+
+#define LATENCY_SAMPLES   500
+
+Event_Bus bus;
+int8_t alerts = -1;      // Fall + SOS only
+int8_t everything = -1;  // All events
+int8_t handled = -1;     // Handler, via dispatch()
+int8_t blocked = -1;     // Consumer task, via wait()
+
+uint32_t handler_calls = 0;
+uint32_t handler_last_value = 0;
+
+std::atomic<bool> consumer_running(false);
+std::atomic<uint32_t> consumer_received(0);
+uint32_t latency_us[LATENCY_SAMPLES];
+
+int passed = 0;
+int failed = 0;
+
+void expect(const char* name, uint32_t expected, uint32_t actual) {
+    if (expected == actual) {
+        passed++;
+        Serial.print("✓ ");
+    } else {
+        failed++;
+        Serial.print("✗ ");
+    }
+    Serial.print(name);
+    Serial.print(": expected ");
+    Serial.print(expected);
+    Serial.print(", got ");
+    Serial.println(actual);
+}
+
+void expectTrue(const char* name, bool condition) {
+    if (condition) {
+        passed++;
+        Serial.print("✓ ");
+    } else {
+        failed++;
+        Serial.print("✗ ");
+    }
+    Serial.println(name);
+}
+
+void countingHandler(const Event_t& event) {
+    handler_calls++;
+    handler_last_value = event.value;
+}
+
+void latencyHandler(const Event_t& event) {
+    uint32_t index = consumer_received.load();
+    if (index < LATENCY_SAMPLES) {
+        latency_us[index] = micros() - event.timestamp_us;
+    }
+    consumer_received.store(index + 1);
+}
+
+void consumerLoop() {
+    while (consumer_running.load()) {
+        if (bus.wait(blocked, 100)) {
+            bus.dispatch(blocked);
+        }
+    }
+}
+
+#ifdef ARDUINO
+TaskHandle_t consumer_task = nullptr;
+
+void consumerTask(void* arg) {
+    consumerLoop();
+    consumer_task = nullptr;
+    vTaskDelete(nullptr);
+}
+#else
+std::thread consumer_thread;
+#endif
+
+void startConsumer() {
+    consumer_running.store(true);
+#ifdef ARDUINO
+    xTaskCreatePinnedToCore(consumerTask, "consumer", 4096, nullptr, 2, &consumer_task, 0);
+#else
+    consumer_thread = std::thread(consumerLoop);
+#endif
+}
+
+void stopConsumer() {
+    consumer_running.store(false);
+#ifdef ARDUINO
+    while (consumer_task != nullptr) {
+        delay(10);
+    }
+#else
+    consumer_thread.join();
+#endif
+}
+
+// Empties a subscriber's queue, returns how many events it held
+uint32_t drain(int8_t id) {
+    Event_t event;
+    uint32_t count = 0;
+    while (bus.poll(id, event)) {
+        count++;
+    }
+    return count;
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(2000);
+
+    Serial.println("\n========================================");
+    Serial.println("       SmartFall Event Bus Test");
+    Serial.println("========================================\n");
+
+    Profiler::begin();
+
+    alerts = bus.subscribe("alerts", EVENT_BIT(EVENT_FALL_DETECTED) | EVENT_BIT(EVENT_SOS_PRESSED));
+    everything = bus.subscribe("everything", EVENT_ALL);
+    handled = bus.subscribe("handled", EVENT_BIT(EVENT_COUNTDOWN_TICK), countingHandler);
+    blocked = bus.subscribe("blocked", EVENT_BIT(EVENT_TEST_ALERT), latencyHandler);
+    expectTrue("subscribers registered", alerts == 0 && everything == 1 && handled == 2 && blocked == 3);
+    bus.subscribe("spare", 0);
+    bus.subscribe("spare", 0);
+    expectTrue("subscriber limit", bus.subscribe("extra", EVENT_ALL) < 0);
+    Serial.println();
+
+    // Test 1: Ordering, masks and fan-out
+    Serial.println("TEST 1: Ordering and Masks");
+    Serial.println("--------------------------");
+    {
+        bus.publish(EVENT_FALL_DETECTED, 85);
+        bus.publish(EVENT_BLE_CONNECTED);
+        bus.publish(EVENT_SOS_PRESSED);
+        bus.publish(EVENT_LOW_BATTERY, 15);
+        bus.publish(EVENT_FALL_DETECTED, 72);
+
+        Event_t event;
+        expectTrue("alerts: first", bus.poll(alerts, event) && event.type == EVENT_FALL_DETECTED);
+        expect("alerts: first value", 85, event.value);
+        expectTrue("alerts: second", bus.poll(alerts, event) && event.type == EVENT_SOS_PRESSED);
+        expectTrue("alerts: third", bus.poll(alerts, event) && event.type == EVENT_FALL_DETECTED);
+        expect("alerts: third value", 72, event.value);
+        expectTrue("alerts: empty", !bus.poll(alerts, event));
+
+        const uint8_t order[] = {EVENT_FALL_DETECTED, EVENT_BLE_CONNECTED, EVENT_SOS_PRESSED,
+                                 EVENT_LOW_BATTERY, EVENT_FALL_DETECTED};
+        bool in_order = true;
+        uint32_t last_timestamp = 0;
+        for (uint8_t type : order) {
+            if (!bus.poll(everything, event) || event.type != type) in_order = false;
+            if (event.timestamp_us < last_timestamp) in_order = false;
+            last_timestamp = event.timestamp_us;
+        }
+        expectTrue("everything: all five in order", in_order);
+        expectTrue("everything: empty", !bus.poll(everything, event));
+
+        expect("published", 5, bus.getPublished());
+        expect("alerts received", 3, bus.getStats(alerts).received);
+        expect("everything received", 5, bus.getStats(everything).received);
+        expect("handled untouched", 0, bus.getStats(handled).received);
+    }
+    Serial.println();
+
+    // Test 2: A lagging subscriber
+    Serial.println("TEST 2: Overrun");
+    Serial.println("---------------");
+    {
+        const uint32_t burst = EVENT_RING_SIZE * 3 + 5;
+        for (uint32_t i = 0; i < burst; i++) {
+            bus.publish(EVENT_COUNTDOWN_TICK, i);
+        }
+
+        Event_t event;
+        expectTrue("oldest kept event", bus.poll(everything, event));
+        expect("oldest kept value", burst - EVENT_RING_SIZE, event.value);
+        expect("dropped", burst - EVENT_RING_SIZE, bus.getStats(everything).dropped);
+        expect("rest still queued", EVENT_RING_SIZE - 1, drain(everything));
+        expect("alerts drop nothing it wanted", 0, drain(alerts));
+
+        drain(handled);
+        uint32_t start = micros();
+        const uint32_t count = 20000;
+        for (uint32_t i = 0; i < count; i++) {
+            bus.publish(EVENT_BLE_COMMAND, i);
+        }
+        uint32_t elapsed = micros() - start;
+        Serial.print("Publish cost: ");
+        Serial.print(elapsed * 1000 / count);
+        Serial.println(" ns/event with nobody reading");
+        expectTrue("producer never blocks", elapsed < count * 20);
+        expect("everything lags by the ring", EVENT_RING_SIZE, drain(everything));
+    }
+    Serial.println();
+
+    // Test 3: Handlers
+    Serial.println("TEST 3: Dispatch");
+    Serial.println("----------------");
+    {
+        uint32_t samples = Profiler::getScope(PROFILE_EVENT_LATENCY).count;
+        for (uint32_t i = 1; i <= 5; i++) {
+            bus.publish(EVENT_COUNTDOWN_TICK, i);
+        }
+        bus.publish(EVENT_SOS_PRESSED);
+
+        expect("limited dispatch", 3, bus.dispatch(handled, 3));
+        expect("handler calls", 3, handler_calls);
+        expectTrue("still pending", bus.hasPending(handled));
+        expect("rest dispatched", 2, bus.dispatch(handled));
+        expect("last value", 5, handler_last_value);
+        expectTrue("nothing pending", !bus.hasPending(handled));
+        expect("latency recorded", samples + 5, Profiler::getScope(PROFILE_EVENT_LATENCY).count);
+        expect("no handler: events still consumed", 1, bus.dispatch(alerts));
+        drain(everything);
+    }
+    Serial.println();
+
+    // Test 4: wait() without events
+    Serial.println("TEST 4: Wait Timeout");
+    Serial.println("--------------------");
+    {
+        bus.publish(EVENT_LOW_BATTERY);   // Not in the mask
+        uint32_t start = millis();
+        bool woke = bus.wait(blocked, 50);
+        uint32_t elapsed = millis() - start;
+        expectTrue("no event", !woke);
+        expectTrue("waited for the timeout", elapsed >= 45 && elapsed < 150);
+
+        bus.publish(EVENT_TEST_ALERT, 7);
+        expectTrue("pending event returns at once", bus.wait(blocked, 1000));
+        drain(blocked);
+        drain(everything);
+    }
+    Serial.println();
+
+    // Test 5: Latency to a blocked consumer
+    Serial.println("TEST 5: Dispatch Latency");
+    Serial.println("------------------------");
+    {
+        consumer_received.store(0);
+        startConsumer();
+        delay(50);
+
+        uint32_t missing = 0;
+        for (uint32_t i = 0; i < LATENCY_SAMPLES; i++) {
+            bus.publish(EVENT_TEST_ALERT, i);
+            uint32_t start = millis();
+            while (consumer_received.load() <= i && millis() - start < 100) {
+                delay(0);
+            }
+            if (consumer_received.load() <= i) missing++;
+            drain(everything);
+        }
+        stopConsumer();
+
+        expect("every event delivered", 0, missing);
+        std::sort(latency_us, latency_us + LATENCY_SAMPLES);
+        uint32_t p50 = latency_us[LATENCY_SAMPLES / 2];
+        uint32_t p99 = latency_us[LATENCY_SAMPLES * 99 / 100];
+        uint32_t max = latency_us[LATENCY_SAMPLES - 1];
+        Serial.print("Publish -> handler: p50 ");
+        Serial.print(p50);
+        Serial.print(" us | p99 ");
+        Serial.print(p99);
+        Serial.print(" us | max ");
+        Serial.print(max);
+        Serial.println(" us");
+        expectTrue("p50 under 1 ms", p50 < 1000);
+        expectTrue("p99 under 10 ms", p99 < 10000);
+        expect("consumer dropped nothing", 0, bus.getStats(blocked).dropped);
+    }
+    Serial.println();
+
+    bus.printStats();
+
+    Serial.print("Passed: ");
+    Serial.print(passed);
+    Serial.print("  Failed: ");
+    Serial.println(failed);
+
+    Serial.println("========================================");
+    Serial.println(failed == 0 ? "      ALL TESTS PASSED" : "      TESTS FAILED");
+    Serial.println("========================================");
+}
+
+void loop() {
+    delay(1000);
+}
@@ -0,0 +1,466 @@
+/*
+ * SmartFall - Sensor Health and Recovery Test
+ *
+ * Drives Sensor_Health and Sensor_Supervisor the way Hardware_Source and
+ * the supervisor task do, against a mock I2C bus with injected faults:
+ * NAKs, a slave holding SDA low, a part that stops converting and one
+ * that drops off the bus entirely.
+ *
+ * Hardware: ESP32 HUZZAH32 Feather (no sensors required)
+ *
+ * This test verifies:
+ * - A healthy noisy stream is never flagged
+ * - Short NAK bursts drop samples; SENSOR_FAIL_ERRORS in a row fail the sensor
+ * - Stuck readings (frozen or a reset part reading zeros) and out of
+ *   range values fail it
+ * - A held SDA line is cleared by bus recovery and the sensor re-inited
+ * - Re-init attempts back off up to SENSOR_REINIT_MAX_BACKOFF_MS, and a
+ *   sensor that comes back is picked up
+ * - The sensor tick stays off the bus while a re-init holds it, and
+ *   that is not counted against the sensor
+ * - The confidence score is rescaled to the sensors still delivering
+ * - A check stays well inside its budget at SENSOR_SAMPLE_RATE_HZ
+ */
+
+#include "Sensor_Health.h"
+#include "Sensor_Supervisor.h"
+#include "confidence_scorer.h"
+
+#define TICK_MS              SENSOR_READ_INTERVAL_MS
+#define PRESSURE_ADDRESS     0x76
+#define NOISE_HPA            0.015f
+#define START_HPA            1013.25f
+#define TIMING_CHECKS        100000
+#define CHECK_BUDGET_US      5            // 0.05% of a core at 100 Hz
+
+int passed = 0;
+int failed = 0;
+
+void expect(const char* name, int32_t expected, int32_t actual) {
+    if (expected == actual) {
+        passed++;
+        Serial.print("✓ ");
+    } else {
+        failed++;
+        Serial.print("✗ ");
+    }
+    Serial.print(name);
+    Serial.print(": expected ");
+    Serial.print(expected);
+    Serial.print(", got ");
+    Serial.println(actual);
+}
+
+void expectTrue(const char* name, bool condition) {
+    expect(name, 1, condition ? 1 : 0);
+}
+
+// Deterministic sensor noise
+uint32_t noise_state = 12345;
+float noise() {
+    noise_state ^= noise_state << 13;
+    noise_state ^= noise_state >> 17;
+    noise_state ^= noise_state << 5;
+    return ((noise_state >> 8) * (1.0f / 16777216.0f) - 0.5f) * 3.464f;   // Unit variance
+}
+
+typedef enum {
+    DEVICE_NORMAL,
+    DEVICE_FROZEN,          // Same reading every time
+    DEVICE_ASLEEP           // Reset by a brown-out: registers read zero
+} DeviceMode_t;
+
+// One barometer on the mock bus
+typedef struct {
+    bool present;
+    DeviceMode_t mode;
+    bool configured;        // Cleared by a reset, set by re-init
+    float last_hpa;
+} Mock_Device_t;
+
+// Mock I2C bus with fault injection
+class Mock_I2C_Bus : public I2C_Bus {
+public:
+    Mock_Device_t device;
+    bool sda_held;              // A slave holds SDA: every transaction fails
+    uint8_t held_clocks;        // Clocks the slave needs to let go (> 9: never)
+    uint32_t nak_reads;         // The next reads NAK
+    bool locked;
+    uint32_t probes;
+    uint32_t recoveries;
+    uint32_t transactions;
+
+    Mock_I2C_Bus() { reset(); }
+
+    void reset() {
+        device.present = true;
+        device.mode = DEVICE_NORMAL;
+        device.configured = true;
+        device.last_hpa = START_HPA;
+        sda_held = false;
+        held_clocks = 0;
+        nak_reads = 0;
+        locked = false;
+        probes = 0;
+        recoveries = 0;
+        transactions = 0;
+    }
+
+    bool probe(uint8_t address) override {
+        probes++;
+        return !sda_held && device.present && address == PRESSURE_ADDRESS;
+    }
+
+    bool recover() override {
+        recoveries++;
+        if (sda_held && held_clocks <= I2C_RECOVERY_CLOCKS) sda_held = false;
+        return !sda_held;
+    }
+
+    bool lock(uint32_t timeout_ms) override {
+        if (locked) return false;
+        locked = true;
+        return true;
+    }
+
+    void unlock() override {
+        locked = false;
+    }
+
+    // A pressure read as the driver does it
+    bool readPressure(float& hpa) {
+        transactions++;
+        if (sda_held || !device.present) return false;
+        if (nak_reads > 0) {
+            nak_reads--;
+            return false;
+        }
+        if (!device.configured || device.mode == DEVICE_ASLEEP) {
+            hpa = 0;
+        } else if (device.mode == DEVICE_FROZEN) {
+            hpa = device.last_hpa;
+        } else {
+            device.last_hpa = START_HPA + NOISE_HPA * noise();
+            hpa = device.last_hpa;
+        }
+        return true;
+    }
+};
+
+Mock_I2C_Bus bus;
+Sensor_Health health("pressure", SENSOR_PRESSURE_STUCK_SAMPLES, SENSOR_PRESSURE_MIN_HPA,
+                     SENSOR_PRESSURE_MAX_HPA);
+Sensor_Supervisor supervisor(&bus);
+uint32_t now_ms = 0;
+uint32_t usable = 0;
+uint32_t skipped = 0;
+uint32_t reinit_calls = 0;
+uint32_t reinit_skipped_ticks = 0;
+
+// Hardware_Source::readPressure, as one sensor tick
+void tick() {
+    if (!bus.lock(0)) {
+        skipped++;
+        return;
+    }
+    if (health.isUp()) {
+        float hpa = 0;
+        bool ok = bus.readPressure(hpa);
+        if (health.check(ok, &hpa, 1, now_ms)) usable++;
+    }
+    bus.unlock();
+}
+
+// BMP280 begin() + configure(); a tick lands while it holds the bus
+bool reinitPressure() {
+    reinit_calls++;
+    uint32_t before = skipped;
+    tick();
+    reinit_skipped_ticks += skipped - before;
+
+    float hpa;
+    if (!bus.readPressure(hpa)) return false;
+    bus.device.configured = true;
+    bus.device.mode = DEVICE_NORMAL;
+    return true;
+}
+
+// Ticks at the sensor rate, with the supervisor every SENSOR_HEALTH_INTERVAL_MS
+void run(uint32_t ms) {
+    for (uint32_t t = 0; t < ms; t += TICK_MS) {
+        now_ms += TICK_MS;
+        tick();
+        if (now_ms % SENSOR_HEALTH_INTERVAL_MS == 0) supervisor.service(now_ms);
+    }
+}
+
+void restart() {
+    bus.reset();
+    health.reset();
+    health.markUp();
+    usable = 0;
+    skipped = 0;
+    reinit_calls = 0;
+    reinit_skipped_ticks = 0;
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(2000);
+
+    Serial.println("\n========================================");
+    Serial.println("   SmartFall Sensor Health Test");
+    Serial.println("========================================\n");
+
+    supervisor.add(&health, PRESSURE_ADDRESS, reinitPressure);
+
+    // Test 1: Healthy stream
+    Serial.println("TEST 1: Healthy Stream");
+    Serial.println("-----------------------");
+    {
+        restart();
+        run(600000);
+        expect("usable samples (10 min)", 600000 / TICK_MS, usable);
+        expect("failures", 0, health.getFailures());
+        expect("bus errors", 0, health.getBusErrors());
+
+        // Integer readings repeat often; they are not stuck until the limit
+        Sensor_Health counts("counts", 50, -32768, 32767);
+        counts.markUp();
+        bool ok = true;
+        for (uint32_t i = 0; i < 10000; i++) {
+            float value = (float)(i / 10);          // Each reading held for 10 samples
+            ok = counts.check(true, &value, 1, i) && ok;
+        }
+        expectTrue("slowly changing readings are not stuck", ok && counts.isUp());
+    }
+    Serial.println();
+
+    // Test 2: NAKs
+    Serial.println("TEST 2: NAK Bursts");
+    Serial.println("-------------------");
+    {
+        restart();
+        run(1000);
+        bus.nak_reads = SENSOR_FAIL_ERRORS - 1;
+        run(1000);
+        expect("samples dropped by a short burst", SENSOR_FAIL_ERRORS - 1, 2 * 1000 / TICK_MS - usable);
+        expectTrue("short burst tolerated", health.isUp());
+        expect("bus errors counted", SENSOR_FAIL_ERRORS - 1, health.getBusErrors());
+
+        bus.nak_reads = SENSOR_FAIL_ERRORS;
+        now_ms += TICK_MS;
+        for (uint8_t i = 0; i < SENSOR_FAIL_ERRORS; i++) tick();
+        expect("failed after SENSOR_FAIL_ERRORS NAKs", SENSOR_FAILED, health.getState());
+        expect("fault", SENSOR_FAULT_BUS, health.getLastFault());
+        uint32_t transactions = bus.transactions;
+        tick();
+        expect("failed sensor not read", transactions, bus.transactions);
+    }
+    Serial.println();
+
+    // Test 3: Stuck and out of range
+    Serial.println("TEST 3: Stuck and Out of Range");
+    Serial.println("-------------------------------");
+    {
+        restart();
+        run(1000);
+        bus.device.mode = DEVICE_FROZEN;
+        uint32_t before = usable;
+        for (uint32_t i = 0; i < 2 * SENSOR_PRESSURE_STUCK_SAMPLES && health.isUp(); i++) tick();
+        // The last live reading is the first of the identical ones
+        expect("usable frozen samples before the fault", SENSOR_PRESSURE_STUCK_SAMPLES - 1, usable - before);
+        expect("fault", SENSOR_FAULT_STUCK, health.getLastFault());
+        expect("stuck faults", 1, health.getStuckFaults());
+
+        // A brown-out: the part resets to sleep and reads zero
+        restart();
+        run(1000);
+        bus.device.configured = false;
+        for (uint8_t i = 0; i < SENSOR_FAIL_ERRORS; i++) tick();
+        expect("zero pressure fails on range", SENSOR_FAULT_RANGE, health.getLastFault());
+        expect("range errors", SENSOR_FAIL_ERRORS, health.getRangeErrors());
+
+        Sensor_Health imu("imu", SENSOR_IMU_STUCK_SAMPLES, -2000, 2000);
+        imu.markUp();
+        float nan_sample[6] = {0, 0, NAN, 0, 0, 0};
+        expectTrue("NaN rejected", !imu.check(true, nan_sample, 6, 0));
+        float zeros[6] = {0, 0, 0, 0, 0, 0};
+        uint32_t accepted = 0;
+        for (uint32_t i = 0; i < 1000 && imu.isUp(); i++) {
+            if (imu.check(true, zeros, 6, i)) accepted++;
+        }
+        expect("IMU reading zeros fails after SENSOR_IMU_STUCK_SAMPLES", SENSOR_IMU_STUCK_SAMPLES, accepted);
+    }
+    Serial.println();
+
+    // Test 4: Held SDA
+    Serial.println("TEST 4: Bus Recovery");
+    Serial.println("---------------------");
+    {
+        restart();
+        run(1000);
+        bus.sda_held = true;
+        bus.held_clocks = 3;
+        bus.device.configured = false;
+        run(SENSOR_REINIT_BACKOFF_MS - SENSOR_HEALTH_INTERVAL_MS);
+        expect("failed on the held bus", SENSOR_FAILED, health.getState());
+        expect("no re-init before the backoff", 0, reinit_calls);
+
+        run(2 * SENSOR_HEALTH_INTERVAL_MS);
+        expect("bus recoveries", 1, supervisor.getBusRecoveries());
+        expect("recovery released the bus", 0, supervisor.getBusRecoveryFailures());
+        expect("re-inits", 1, reinit_calls);
+        expectTrue("sensor back", health.isUp());
+        expect("recoveries", 1, health.getRecoveries());
+
+        uint32_t before = usable;
+        run(1000);
+        expect("usable after recovery", 1000 / TICK_MS, usable - before);
+    }
+    Serial.println();
+
+    // Test 5: Backoff
+    Serial.println("TEST 5: Backoff and Late Return");
+    Serial.println("--------------------------------");
+    {
+        restart();
+        run(1000);
+        bus.device.present = false;
+        run(300000);
+        // 0.5, 1, 2, 4, 8, 16 s, then every 30 s
+        uint32_t expected = 6;
+        uint32_t elapsed = SENSOR_REINIT_BACKOFF_MS * 63;
+        while (elapsed + SENSOR_REINIT_MAX_BACKOFF_MS <= 300000) {
+            elapsed += SENSOR_REINIT_MAX_BACKOFF_MS;
+            expected++;
+        }
+        expectTrue("attempts back off to the cap (within 1)",
+                   reinit_calls + 1 >= expected && reinit_calls <= expected + 1);
+        expect("backoff capped", SENSOR_REINIT_MAX_BACKOFF_MS, health.getBackoff());
+        expect("failures (one outage)", 1, health.getFailures());
+
+        bus.device.present = true;
+        run(SENSOR_REINIT_MAX_BACKOFF_MS + SENSOR_HEALTH_INTERVAL_MS);
+        expectTrue("picked up within one backoff", health.isUp());
+        expect("backoff reset", SENSOR_REINIT_BACKOFF_MS, health.getBackoff());
+
+        // Never came up at boot: retried the same way
+        restart();
+        health.reset();
+        health.markDown(now_ms);
+        run(SENSOR_REINIT_BACKOFF_MS + SENSOR_HEALTH_INTERVAL_MS);
+        expectTrue("boot failure retried", health.isUp() && health.getRecoveries() == 1);
+    }
+    Serial.println();
+
+    // Test 6: Bus lock
+    Serial.println("TEST 6: Bus Lock");
+    Serial.println("-----------------");
+    {
+        restart();
+        run(1000);
+        bus.nak_reads = SENSOR_FAIL_ERRORS;
+        run(SENSOR_REINIT_BACKOFF_MS + 2 * SENSOR_HEALTH_INTERVAL_MS);
+        expect("re-inits", 1, reinit_calls);
+        expect("tick skipped during the re-init", 1, reinit_skipped_ticks);
+        expect("skipped tick not a bus error", SENSOR_FAIL_ERRORS, health.getBusErrors());
+        expectTrue("bus released", !bus.locked && health.isUp());
+
+        // The supervisor waits out a bus it cannot get
+        bus.nak_reads = SENSOR_FAIL_ERRORS;
+        run(100);
+        bus.locked = true;
+        uint32_t calls = reinit_calls;
+        supervisor.service(now_ms + SENSOR_REINIT_BACKOFF_MS);
+        expect("no re-init without the bus", calls, reinit_calls);
+        expect("still due", SENSOR_FAILED, health.getState());
+        bus.locked = false;
+        supervisor.printStats();
+    }
+    Serial.println();
+
+    // Test 7: Score reweighting
+    Serial.println("TEST 7: Score Reweighting");
+    Serial.println("--------------------------");
+    {
+        ConfidenceScorer scorer;
+        expect("reachable, all sensors", MAX_CONFIDENCE_SCORE, scorer.getReachableScore());
+        scorer.setSensorAvailability(HARDWARE_ALL & ~HARDWARE_BIT(HARDWARE_PRESSURE));
+        expect("reachable, no barometer", MAX_CONFIDENCE_SCORE - 5, scorer.getReachableScore());
+        scorer.setSensorAvailability(HARDWARE_ALL & ~HARDWARE_BIT(HARDWARE_FORCE));
+        expect("reachable, no FSR (stage 2 and filter)", MAX_CONFIDENCE_SCORE - 10,
+               scorer.getReachableScore());
+        scorer.setSensorAvailability(0);
+        expect("reachable, IMU only", MAX_CONFIDENCE_SCORE - 20, scorer.getReachableScore());
+
+        // The best fall the IMU and barometer can score is a full score
+        scorer.setSensorAvailability(HARDWARE_BIT(HARDWARE_PRESSURE));
+        scorer.addStage1Score(600.0f, 0.05f);
+        scorer.addStage2Score(8.0f, 200.0f, false);
+        scorer.addStage3Score(700.0f, 100.0f);
+        scorer.addStage4Score(12000.0f, true);
+        scorer.addPressureFilterScore(2.5f);
+        scorer.addClassifierScore(95);
+        expect("raw score", MAX_CONFIDENCE_SCORE - 15, scorer.getRawScore());
+        expect("rescaled to full", MAX_CONFIDENCE_SCORE, scorer.getTotalScore());
+
+        // Unchanged with every sensor up
+        scorer.setSensorAvailability(HARDWARE_ALL);
+        expect("all sensors: total is the raw sum", scorer.getRawScore(), scorer.getTotalScore());
+
+        // A fall just short of CONFIRMED on the raw sum crosses it once the
+        // points no sensor could give are taken out
+        scorer.resetScore();
+        scorer.setSensorAvailability(HARDWARE_BIT(HARDWARE_FORCE));
+        scorer.addStage1Score(150.0f, 0.2f);
+        scorer.addStage2Score(4.5f, 300.0f, true);
+        scorer.addStage3Score(450.0f, 50.0f);
+        scorer.addStage4Score(6000.0f, true);
+        Serial.print("Raw ");
+        Serial.print(scorer.getRawScore());
+        Serial.print("/");
+        Serial.print(scorer.getReachableScore());
+        Serial.print(" -> ");
+        Serial.println(scorer.getTotalScore());
+        expectTrue("raw sum below CONFIRMED", scorer.getRawScore() < CONFIRMED_THRESHOLD);
+        expectTrue("rescaled reaches CONFIRMED", scorer.getConfidenceLevel() >= CONFIDENCE_CONFIRMED);
+    }
+    Serial.println();
+
+    // Test 8: Check cost
+    Serial.println("TEST 8: Check Cost");
+    Serial.println("-------------------");
+    {
+        Sensor_Health imu("imu", SENSOR_IMU_STUCK_SAMPLES, -2000, 2000);
+        imu.markUp();
+        float sample[6] = {0.01f, -0.02f, 1.0f, 0.5f, -0.3f, 0.1f};
+        uint32_t accepted = 0;
+        uint32_t start = micros();
+        for (uint32_t i = 0; i < TIMING_CHECKS; i++) {
+            sample[0] = 0.01f * noise();
+            if (imu.check(true, sample, 6, i)) accepted++;
+        }
+        float check_us = (float)(micros() - start) / TIMING_CHECKS;
+
+        Serial.print("Per check:    ");
+        Serial.print(check_us, 3);
+        Serial.println(" us (6 values, with the noise)");
+        expect("all accepted", TIMING_CHECKS, accepted);
+        expectTrue("check within budget", check_us < CHECK_BUDGET_US);
+    }
+    Serial.println();
+
+    Serial.print("Passed: ");
+    Serial.print(passed);
+    Serial.print("  Failed: ");
+    Serial.println(failed);
+
+    Serial.println("========================================");
+    Serial.println(failed == 0 ? "      ALL TESTS PASSED" : "      TESTS FAILED");
+    Serial.println("========================================");
+}
+
+void loop() {
+    delay(1000);
+}
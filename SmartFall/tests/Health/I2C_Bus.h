@@ -0,0 +1,62 @@
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+#include <Arduino.h>
+#include "config.h"
+
+#ifdef ARDUINO
+#include <Wire.h>
+#endif
+
+/*
+ * The shared sensor I2C bus, as the sensor supervisor sees it.
+ *
+ * The drivers keep talking to Wire directly; this is the part recovery
+ * needs: probing an address, bus-level recovery and a lock that keeps
+ * the sensor tick off the bus while a sensor is being brought back.
+ * recover() handles a slave that browned out or lost clocks mid-byte and
+ * now holds SDA low, which a controller reset alone cannot clear: it
+ * clocks SCL by hand (at most I2C_RECOVERY_CLOCKS pulses, waiting at
+ * most I2C_STRETCH_TIMEOUT_US on a stretched clock) until SDA is
+ * released, then sends a STOP and restarts the controller. It is
+ * bounded at about I2C_RECOVERY_CLOCKS * I2C_STRETCH_TIMEOUT_US.
+ *
+ * Wire_Bus is the ESP32 bus; the host tests provide a mock with fault
+ * injection.
+ */
+class I2C_Bus {
+public:
+    virtual ~I2C_Bus() {}
+
+    virtual bool probe(uint8_t address) = 0;        // Address ACKed
+    virtual bool recover() = 0;                     // True when SDA and SCL are both released
+
+    // Sensor tick uses timeout 0 and skips the tick when busy
+    virtual bool lock(uint32_t timeout_ms) = 0;
+    virtual void unlock() = 0;
+};
+
+#ifdef ARDUINO
+class Wire_Bus : public I2C_Bus {
+private:
+    uint8_t sda_pin;
+    uint8_t scl_pin;
+    SemaphoreHandle_t mutex;
+
+public:
+    Wire_Bus(uint8_t sda, uint8_t scl);
+
+    bool begin();                   // Starts Wire with I2C_TIMEOUT_MS
+
+    bool probe(uint8_t address) override;
+    bool recover() override;
+    bool lock(uint32_t timeout_ms) override;
+    void unlock() override;
+
+private:
+    // Private helper functions
+    bool releaseClock();            // SCL high, or false after I2C_STRETCH_TIMEOUT_US
+};
+#endif
+
+#endif // I2C_BUS_H
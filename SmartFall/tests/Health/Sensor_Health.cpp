@@ -0,0 +1,142 @@
+#include "Sensor_Health.h"
+
+Sensor_Health::Sensor_Health(const char* sensor_name, uint16_t stuck, float min_v, float max_v)
+    : name(sensor_name), stuck_samples(stuck), min_value(min_v), max_value(max_v) {
+    reset();
+}
+
+void Sensor_Health::reset() {
+    state = SENSOR_PENDING;
+    last_fault = SENSOR_FAULT_NONE;
+    consecutive_errors = 0;
+    last_signature = 0;
+    repeats = 0;
+    next_attempt_ms = 0;
+    backoff_ms = SENSOR_REINIT_BACKOFF_MS;
+    bus_errors = 0;
+    range_errors = 0;
+    stuck_faults = 0;
+    failures = 0;
+    reinit_attempts = 0;
+    recoveries = 0;
+}
+
+void Sensor_Health::markUp() {
+    consecutive_errors = 0;
+    repeats = 0;
+    backoff_ms = SENSOR_REINIT_BACKOFF_MS;
+    state = SENSOR_OK;
+}
+
+void Sensor_Health::markDown(uint32_t now_ms) {
+    fail(SENSOR_FAULT_BOOT, now_ms);
+}
+
+bool Sensor_Health::check(bool read_ok, const float* values, uint8_t count, uint32_t now_ms) {
+    if (state != SENSOR_OK) return false;
+
+    bool in_range = read_ok;
+    for (uint8_t i = 0; in_range && i < count; i++) {
+        // Written so NaN fails too
+        in_range = values[i] >= min_value && values[i] <= max_value;
+    }
+
+    if (!in_range) {
+        if (read_ok) {
+            range_errors++;
+        } else {
+            bus_errors++;
+        }
+        if (++consecutive_errors >= SENSOR_FAIL_ERRORS) {
+            fail(read_ok ? SENSOR_FAULT_RANGE : SENSOR_FAULT_BUS, now_ms);
+        }
+        return false;
+    }
+    consecutive_errors = 0;
+
+    uint32_t hash = signature(values, count);
+    if (hash == last_signature) {
+        if (++repeats >= stuck_samples) {
+            stuck_faults++;
+            fail(SENSOR_FAULT_STUCK, now_ms);
+            return false;
+        }
+    } else {
+        last_signature = hash;
+        repeats = 0;
+    }
+    return true;
+}
+
+bool Sensor_Health::reinitDue(uint32_t now_ms) {
+    return state == SENSOR_FAILED && (int32_t)(now_ms - next_attempt_ms) >= 0;
+}
+
+void Sensor_Health::reinitDone(bool ok, uint32_t now_ms) {
+    reinit_attempts++;
+    if (ok) {
+        recoveries++;
+        markUp();
+        return;
+    }
+
+    backoff_ms = backoff_ms * 2 > SENSOR_REINIT_MAX_BACKOFF_MS ? SENSOR_REINIT_MAX_BACKOFF_MS
+                                                              : backoff_ms * 2;
+    next_attempt_ms = now_ms + backoff_ms;
+}
+
+const char* Sensor_Health::faultName(SensorFault_t fault) {
+    switch (fault) {
+        case SENSOR_FAULT_NONE: return "none";
+        case SENSOR_FAULT_BOOT: return "boot";
+        case SENSOR_FAULT_BUS: return "bus";
+        case SENSOR_FAULT_RANGE: return "range";
+        case SENSOR_FAULT_STUCK: return "stuck";
+        default: return "unknown";
+    }
+}
+
+void Sensor_Health::printStats() {
+    Serial.print("=== Sensor Health: ");
+    Serial.print(name);
+    Serial.println(" ===");
+    Serial.print("State: ");
+    Serial.print(state == SENSOR_OK ? "ok" : state == SENSOR_FAILED ? "failed" : "pending");
+    Serial.print(" (last fault: ");
+    Serial.print(faultName(last_fault));
+    Serial.println(")");
+    Serial.print("Bus errors: ");
+    Serial.print(bus_errors);
+    Serial.print(", out of range: ");
+    Serial.print(range_errors);
+    Serial.print(", stuck: ");
+    Serial.println(stuck_faults);
+    Serial.print("Failures: ");
+    Serial.print(failures);
+    Serial.print(", re-inits: ");
+    Serial.print(recoveries);
+    Serial.print("/");
+    Serial.println(reinit_attempts);
+    Serial.println("==========================");
+}
+
+// Private helper functions
+
+void Sensor_Health::fail(SensorFault_t fault, uint32_t now_ms) {
+    last_fault = fault;
+    failures++;
+    consecutive_errors = 0;
+    repeats = 0;
+    next_attempt_ms = now_ms + backoff_ms;
+    state = SENSOR_FAILED;
+}
+
+// FNV-1a over the raw float bits: equal readings, equal hash
+uint32_t Sensor_Health::signature(const float* values, uint8_t count) {
+    uint32_t hash = 2166136261UL;
+    const uint8_t* bytes = (const uint8_t*)values;
+    for (size_t i = 0; i < count * sizeof(float); i++) {
+        hash = (hash ^ bytes[i]) * 16777619UL;
+    }
+    return hash;
+}
@@ -0,0 +1,101 @@
+#ifndef SENSOR_HEALTH_H
+#define SENSOR_HEALTH_H
+
+#include <Arduino.h>
+#include "config.h"
+
+typedef enum {
+    SENSOR_PENDING,         // Boot step not finished; not read, not retried
+    SENSOR_OK,
+    SENSOR_FAILED           // Not read; re-init due after the backoff
+} SensorState_t;
+
+typedef enum {
+    SENSOR_FAULT_NONE,
+    SENSOR_FAULT_BOOT,      // Did not come up
+    SENSOR_FAULT_BUS,       // NAK, short read or bus timeout
+    SENSOR_FAULT_RANGE,     // Non-finite or outside the sensor's physical range
+    SENSOR_FAULT_STUCK      // The same reading over and over
+} SensorFault_t;
+
+/*
+ * Health of one bus sensor.
+ *
+ * The read path passes every read result to check(), which says whether
+ * the sample can be used:
+ *   - a failed read (NAK, timeout) or a value out of [min, max] is a bad
+ *     read; SENSOR_FAIL_ERRORS in a row fail the sensor
+ *   - a sensor that repeats the exact same reading stuck_samples times
+ *     has stopped converting (a reset part sits in sleep mode returning
+ *     its last or zeroed registers) and fails at once
+ * A failed sensor is no longer read. The supervisor re-initializes it
+ * when reinitDue() says so, with a backoff that doubles from
+ * SENSOR_REINIT_BACKOFF_MS to SENSOR_REINIT_MAX_BACKOFF_MS, and reports
+ * the outcome with reinitDone(). A boot failure is retried the same way.
+ *
+ * check() runs on the sensor tick and the re-init on the supervisor's
+ * task; each state change has one writer (the tick fails a sensor, the
+ * supervisor brings it back), so no lock is needed. No hardware access,
+ * so the same code runs in the host tests.
+ */
+class Sensor_Health {
+private:
+    const char* name;
+    uint16_t stuck_samples;
+    float min_value;
+    float max_value;
+
+    volatile SensorState_t state;
+    SensorFault_t last_fault;
+    uint8_t consecutive_errors;
+    uint32_t last_signature;        // Hash of the previous reading
+    uint16_t repeats;
+    uint32_t next_attempt_ms;
+    uint32_t backoff_ms;
+
+    // Counters
+    uint32_t bus_errors;
+    uint32_t range_errors;
+    uint32_t stuck_faults;
+    uint32_t failures;
+    uint32_t reinit_attempts;
+    uint32_t recoveries;
+
+public:
+    Sensor_Health(const char* name, uint16_t stuck_samples, float min_value, float max_value);
+
+    void reset();                   // Back to PENDING, counters cleared
+
+    // Boot step outcome
+    void markUp();
+    void markDown(uint32_t now_ms);
+
+    // Every read: false when the read failed. Returns whether the values can be used.
+    bool check(bool read_ok, const float* values, uint8_t count, uint32_t now_ms);
+
+    // Supervisor side
+    bool reinitDue(uint32_t now_ms);
+    void reinitDone(bool ok, uint32_t now_ms);
+
+    bool isUp() { return state == SENSOR_OK; }
+    SensorState_t getState() { return state; }
+    SensorFault_t getLastFault() { return last_fault; }
+    const char* getName() { return name; }
+    uint32_t getBusErrors() { return bus_errors; }
+    uint32_t getRangeErrors() { return range_errors; }
+    uint32_t getStuckFaults() { return stuck_faults; }
+    uint32_t getFailures() { return failures; }
+    uint32_t getReinitAttempts() { return reinit_attempts; }
+    uint32_t getRecoveries() { return recoveries; }
+    uint32_t getBackoff() { return backoff_ms; }
+
+    static const char* faultName(SensorFault_t fault);
+    void printStats();
+
+private:
+    // Private helper functions
+    void fail(SensorFault_t fault, uint32_t now_ms);
+    static uint32_t signature(const float* values, uint8_t count);
+};
+
+#endif // SENSOR_HEALTH_H
@@ -0,0 +1,317 @@
+#include "confidence_scorer.h"
+#include "Deferred_Log.h"
+
+#define FSR_IMPACT_POINTS   7       // Stage 2: the FSR saw the impact
+#define FSR_STRAP_POINTS    2       // Filter: device attached throughout
+#define FSR_SPIKE_POINTS    3       // Filter: impact spike
+
+ConfidenceScorer::ConfidenceScorer() : stage1_score(0), stage2_score(0), stage3_score(0),
+                                       stage4_score(0), filter_score(0), classifier_score(0),
+                                       tiers(DEFAULT_SCORE_TIERS), available_sensors(HARDWARE_ALL),
+                                       scoring_active(false), scoring_start_time(0) {
+    resetScore();
+}
+
+ConfidenceScorer::~ConfidenceScorer() {
+    // Cleanup if needed
+}
+
+void ConfidenceScorer::resetScore() {
+    stage1_score = 0;
+    stage2_score = 0;
+    stage3_score = 0;
+    stage4_score = 0;
+    filter_score = 0;
+    classifier_score = 0;
+
+    // Reset detailed breakdowns
+    stage1_breakdown = {0, 0};
+    stage2_breakdown = {0, 0, 0};
+    stage3_breakdown = {0, 0};
+    stage4_breakdown = {0, 0};
+    filter_breakdown = {0, 0, 0};
+
+    scoring_active = false;
+    scoring_start_time = 0;
+}
+
+void ConfidenceScorer::startScoring() {
+    scoring_active = true;
+    scoring_start_time = millis();
+}
+
+void ConfidenceScorer::addStage1Score(float duration_ms, float min_magnitude_g) {
+    if (!scoring_active) startScoring();
+
+    stage1_breakdown.duration_score = scoreTier(tiers.tables[SCORE_FREEFALL_DURATION], duration_ms);
+    stage1_breakdown.magnitude_score = scoreTier(tiers.tables[SCORE_FREEFALL_DEPTH], min_magnitude_g);
+
+    stage1_score = stage1_breakdown.duration_score + stage1_breakdown.magnitude_score;
+    capScore(stage1_score, 25);
+
+    if (DEBUG_ALGORITHM_STEPS) {
+        Deferred_Log::log(DLOG_STAGE1_SCORE, stage1_score,
+                          stage1_breakdown.duration_score, stage1_breakdown.magnitude_score);
+    }
+}
+
+void ConfidenceScorer::addStage2Score(float impact_g, float timing_ms, bool fsr_detected) {
+    stage2_breakdown.impact_magnitude_score = scoreTier(tiers.tables[SCORE_IMPACT], impact_g);
+    stage2_breakdown.timing_score = scoreTier(tiers.tables[SCORE_IMPACT_TIMING], timing_ms);
+    stage2_breakdown.fsr_validation_score = fsr_detected ? FSR_IMPACT_POINTS : 0;
+
+    stage2_score = stage2_breakdown.impact_magnitude_score +
+                  stage2_breakdown.timing_score +
+                  stage2_breakdown.fsr_validation_score;
+    capScore(stage2_score, 25);
+
+    if (DEBUG_ALGORITHM_STEPS) {
+        Deferred_Log::log(DLOG_STAGE2_SCORE, stage2_score,
+                          stage2_breakdown.impact_magnitude_score, stage2_breakdown.timing_score,
+                          stage2_breakdown.fsr_validation_score);
+    }
+}
+
+void ConfidenceScorer::addStage3Score(float angular_velocity_dps, float orientation_change_deg) {
+    stage3_breakdown.angular_velocity_score = scoreTier(tiers.tables[SCORE_ROTATION], angular_velocity_dps);
+    stage3_breakdown.orientation_change_score = scoreTier(tiers.tables[SCORE_ORIENTATION], orientation_change_deg);
+
+    stage3_score = stage3_breakdown.angular_velocity_score +
+                  stage3_breakdown.orientation_change_score;
+    capScore(stage3_score, 20);
+
+    if (DEBUG_ALGORITHM_STEPS) {
+        Deferred_Log::log(DLOG_STAGE3_SCORE, stage3_score,
+                          stage3_breakdown.angular_velocity_score,
+                          stage3_breakdown.orientation_change_score);
+    }
+}
+
+void ConfidenceScorer::addStage4Score(float inactivity_duration_ms, bool stable) {
+    stage4_breakdown.inactivity_duration_score = scoreTier(tiers.tables[SCORE_INACTIVITY], inactivity_duration_ms);
+    stage4_breakdown.stability_score = stable ? 5 : 0;
+
+    stage4_score = stage4_breakdown.inactivity_duration_score +
+                  stage4_breakdown.stability_score;
+    capScore(stage4_score, 20);
+
+    if (DEBUG_ALGORITHM_STEPS) {
+        Deferred_Log::log(DLOG_STAGE4_SCORE, stage4_score,
+                          stage4_breakdown.inactivity_duration_score, stage4_breakdown.stability_score);
+    }
+}
+
+void ConfidenceScorer::addPressureFilterScore(float altitude_change_m) {
+    filter_breakdown.pressure_filter_score = scoreTier(tiers.tables[SCORE_PRESSURE], altitude_change_m);
+    updateFilterScore();
+}
+
+void ConfidenceScorer::addHeartRateFilterScore(float hr_change_bpm) {
+    filter_breakdown.heart_rate_filter_score = scoreTier(tiers.tables[SCORE_HEART_RATE], fabsf(hr_change_bpm));
+    updateFilterScore();
+}
+
+void ConfidenceScorer::addFSRFilterScore(bool impact_detected, bool strap_secure) {
+    uint8_t fsr_score = 0;
+    if (strap_secure) fsr_score += FSR_STRAP_POINTS;  // Device attached throughout sequence
+    if (impact_detected) fsr_score += FSR_SPIKE_POINTS;  // Impact spike detected
+
+    filter_breakdown.fsr_filter_score = fsr_score;
+    updateFilterScore();
+}
+
+void ConfidenceScorer::addClassifierScore(uint8_t probability_pct) {
+    classifier_score = scoreTier(tiers.tables[SCORE_CLASSIFIER], probability_pct);
+    capScore(classifier_score, 15);
+
+    if (DEBUG_ALGORITHM_STEPS) {
+        Deferred_Log::log(DLOG_CLASSIFIER_SCORE, classifier_score, probability_pct);
+    }
+}
+
+bool ConfidenceScorer::setScoreTiers(const ScoreTiers_t& score_tiers) {
+    if (!isValidScoreTiers(score_tiers)) return false;
+    tiers = score_tiers;
+    return true;
+}
+
+void ConfidenceScorer::updateFilterScore() {
+    filter_score = filter_breakdown.pressure_filter_score +
+                  filter_breakdown.heart_rate_filter_score +
+                  filter_breakdown.fsr_filter_score;
+    capScore(filter_score, 15);
+}
+
+void ConfidenceScorer::setSensorAvailability(uint8_t available) {
+    available_sensors = available & HARDWARE_ALL;
+}
+
+uint8_t ConfidenceScorer::getReachableScore() {
+    return MAX_CONFIDENCE_SCORE - (filterReach(HARDWARE_ALL) - filterReach(available_sensors)) -
+           (impactReach(HARDWARE_ALL) - impactReach(available_sensors));
+}
+
+uint8_t ConfidenceScorer::getRawScore() {
+    return stage1_score + stage2_score + stage3_score + stage4_score + filter_score + classifier_score;
+}
+
+uint8_t ConfidenceScorer::getTotalScore() {
+    uint16_t raw = getRawScore();
+    uint8_t reachable = getReachableScore();
+    if (reachable >= MAX_CONFIDENCE_SCORE || reachable == 0) return raw;
+
+    uint16_t scaled = (raw * MAX_CONFIDENCE_SCORE + reachable / 2) / reachable;
+    return scaled > MAX_CONFIDENCE_SCORE ? MAX_CONFIDENCE_SCORE : scaled;
+}
+
+FallConfidence_t ConfidenceScorer::getConfidenceLevel() {
+    uint8_t total = getTotalScore();
+
+    if (total >= HIGH_CONFIDENCE_THRESHOLD) {
+        return CONFIDENCE_HIGH;
+    } else if (total >= CONFIRMED_THRESHOLD) {
+        return CONFIDENCE_CONFIRMED;
+    } else if (total >= POTENTIAL_THRESHOLD) {
+        return CONFIDENCE_POTENTIAL;
+    } else if (total >= SUSPICIOUS_THRESHOLD) {
+        return CONFIDENCE_SUSPICIOUS;
+    } else {
+        return CONFIDENCE_NO_FALL;
+    }
+}
+
+uint8_t ConfidenceScorer::getStageScore(uint8_t stage_number) {
+    switch(stage_number) {
+        case 1: return stage1_score;
+        case 2: return stage2_score;
+        case 3: return stage3_score;
+        case 4: return stage4_score;
+        case 5: return filter_score;
+        case 6: return classifier_score;
+        default: return 0;
+    }
+}
+
+void ConfidenceScorer::getScoreBreakdown(uint8_t& s1, uint8_t& s2, uint8_t& s3, uint8_t& s4, uint8_t& filters) {
+    s1 = stage1_score;
+    s2 = stage2_score;
+    s3 = stage3_score;
+    s4 = stage4_score;
+    filters = filter_score;
+}
+
+bool ConfidenceScorer::isValidFallSequence() {
+    // Valid fall sequence requires minimum scores in key stages
+    return (stage1_score >= 5) &&   // Minimum free fall detected
+           (stage2_score >= 8) &&   // Minimum impact detected
+           (getTotalScore() >= 30); // Overall minimum threshold
+}
+
+bool ConfidenceScorer::isScoringActive() {
+    return scoring_active;
+}
+
+uint32_t ConfidenceScorer::getScoringDuration() {
+    return scoring_active ? (millis() - scoring_start_time) : 0;
+}
+
+bool ConfidenceScorer::validateScoreRange(uint8_t score, uint8_t max_score) {
+    return score <= max_score;
+}
+
+void ConfidenceScorer::capScore(uint8_t& score, uint8_t max_value) {
+    if (score > max_value) {
+        score = max_value;
+    }
+}
+
+const char* ConfidenceScorer::getConfidenceString(FallConfidence_t confidence) {
+    switch(confidence) {
+        case CONFIDENCE_HIGH: return "HIGH";
+        case CONFIDENCE_CONFIRMED: return "CONFIRMED";
+        case CONFIDENCE_POTENTIAL: return "POTENTIAL";
+        case CONFIDENCE_SUSPICIOUS: return "SUSPICIOUS";
+        case CONFIDENCE_NO_FALL: return "NO_FALL";
+        default: return "UNKNOWN";
+    }
+}
+
+void ConfidenceScorer::logScoreBreakdown() {
+    Deferred_Log::log(DLOG_SCORE_STAGES, stage1_score, stage2_score, stage3_score, stage4_score);
+    Deferred_Log::log(DLOG_SCORE_FILTERS, filter_score, classifier_score);
+    Deferred_Log::log(DLOG_SCORE_TOTAL, getTotalScore(), MAX_CONFIDENCE_SCORE, getConfidenceLevel());
+
+    if (getReachableScore() < MAX_CONFIDENCE_SCORE) {
+        Deferred_Log::log(DLOG_SCORE_RESCALED, getRawScore(), getReachableScore());
+    }
+}
+
+void ConfidenceScorer::printDetailedAnalysis() {
+    Serial.println("=== Detailed Fall Analysis ===");
+
+    Serial.println("Stage 1 - Free Fall:");
+    Serial.print("  Duration Score: ");
+    Serial.print(stage1_breakdown.duration_score);
+    Serial.print(", Magnitude Score: ");
+    Serial.println(stage1_breakdown.magnitude_score);
+
+    Serial.println("Stage 2 - Impact:");
+    Serial.print("  Impact Score: ");
+    Serial.print(stage2_breakdown.impact_magnitude_score);
+    Serial.print(", Timing Score: ");
+    Serial.print(stage2_breakdown.timing_score);
+    Serial.print(", FSR Score: ");
+    Serial.println(stage2_breakdown.fsr_validation_score);
+
+    Serial.println("Stage 3 - Rotation:");
+    Serial.print("  Angular Score: ");
+    Serial.print(stage3_breakdown.angular_velocity_score);
+    Serial.print(", Orientation Score: ");
+    Serial.println(stage3_breakdown.orientation_change_score);
+
+    Serial.println("Stage 4 - Inactivity:");
+    Serial.print("  Duration Score: ");
+    Serial.print(stage4_breakdown.inactivity_duration_score);
+    Serial.print(", Stability Score: ");
+    Serial.println(stage4_breakdown.stability_score);
+
+    Serial.println("Filters:");
+    Serial.print("  Pressure: ");
+    Serial.print(filter_breakdown.pressure_filter_score);
+    Serial.print(", Heart Rate: ");
+    Serial.print(filter_breakdown.heart_rate_filter_score);
+    Serial.print(", FSR: ");
+    Serial.println(filter_breakdown.fsr_filter_score);
+
+    Serial.println("Classifier:");
+    Serial.print("  Probability Score: ");
+    Serial.println(classifier_score);
+
+    Serial.println("===============================");
+}
+
+// Strictest tier is listed first and pays the most
+uint8_t ConfidenceScorer::tableMaxPoints(ScoreMetric_t metric) {
+    const ScoreTable_t& table = tiers.tables[metric];
+    uint8_t points = 0;
+    for (uint8_t i = 0; i < table.count; i++) {
+        if (table.tiers[i].points > points) points = table.tiers[i].points;
+    }
+    return points;
+}
+
+// Most the filter stage can score with these sensors, after its cap
+uint8_t ConfidenceScorer::filterReach(uint8_t available) {
+    uint16_t reach = 0;
+    if (available & HARDWARE_BIT(HARDWARE_PRESSURE)) reach += tableMaxPoints(SCORE_PRESSURE);
+    if (available & HARDWARE_BIT(HARDWARE_HEART)) reach += tableMaxPoints(SCORE_HEART_RATE);
+    if (available & HARDWARE_BIT(HARDWARE_FORCE)) reach += FSR_STRAP_POINTS + FSR_SPIKE_POINTS;
+    return reach > 15 ? 15 : reach;
+}
+
+// Most stage 2 can score: the FSR confirms the impact
+uint8_t ConfidenceScorer::impactReach(uint8_t available) {
+    uint16_t reach = tableMaxPoints(SCORE_IMPACT) + tableMaxPoints(SCORE_IMPACT_TIMING);
+    if (available & HARDWARE_BIT(HARDWARE_FORCE)) reach += FSR_IMPACT_POINTS;
+    return reach > 25 ? 25 : reach;
+}
@@ -0,0 +1,116 @@
+#ifndef CONFIDENCE_SCORER_H
+#define CONFIDENCE_SCORER_H
+
+#include "data_types.h"
+#include "config.h"
+#include "score_tiers.h"
+#include <Arduino.h>
+
+class ConfidenceScorer {
+private:
+    // Scoring components
+    uint8_t stage1_score;    // Free fall scoring (max 25 points)
+    uint8_t stage2_score;    // Impact scoring (max 25 points)
+    uint8_t stage3_score;    // Rotation scoring (max 20 points)
+    uint8_t stage4_score;    // Inactivity scoring (max 20 points)
+    uint8_t filter_score;    // False positive filters (max 15 points)
+    uint8_t classifier_score; // Fall classifier probability (max 15 points)
+
+    // Detailed scoring breakdown
+    struct {
+        uint8_t duration_score;
+        uint8_t magnitude_score;
+    } stage1_breakdown;
+
+    struct {
+        uint8_t impact_magnitude_score;
+        uint8_t timing_score;
+        uint8_t fsr_validation_score;
+    } stage2_breakdown;
+
+    struct {
+        uint8_t angular_velocity_score;
+        uint8_t orientation_change_score;
+    } stage3_breakdown;
+
+    struct {
+        uint8_t inactivity_duration_score;
+        uint8_t stability_score;
+    } stage4_breakdown;
+
+    struct {
+        uint8_t pressure_filter_score;
+        uint8_t heart_rate_filter_score;
+        uint8_t fsr_filter_score;
+    } filter_breakdown;
+
+    ScoreTiers_t tiers;      // Breakpoints and points per metric
+    uint8_t available_sensors; // HARDWARE_BIT mask of optional sensors delivering
+
+    bool scoring_active;
+    uint32_t scoring_start_time;
+
+public:
+    ConfidenceScorer();
+    ~ConfidenceScorer();
+
+    // Core scoring functions
+    void resetScore();
+    void startScoring();
+
+    // Stage scoring functions
+    void addStage1Score(float duration_ms, float min_magnitude_g);
+    void addStage2Score(float impact_g, float timing_ms, bool fsr_detected = false);
+    void addStage3Score(float angular_velocity_dps, float orientation_change_deg);
+    void addStage4Score(float inactivity_duration_ms, bool stable);
+
+    // Filter scoring functions
+    void addPressureFilterScore(float altitude_change_m);
+    void addHeartRateFilterScore(float hr_change_bpm);
+    void addFSRFilterScore(bool impact_detected, bool strap_secure);
+
+    // Classifier scoring (see fall_classifier.h)
+    void addClassifierScore(uint8_t probability_pct);
+
+    // Tier tables (DEFAULT_SCORE_TIERS until overridden)
+    bool setScoreTiers(const ScoreTiers_t& score_tiers);
+    const ScoreTiers_t& getScoreTiers() { return tiers; }
+
+    // Optional sensors delivering (HARDWARE_BIT mask, HARDWARE_ALL until
+    // told otherwise). With one down, the total is rescaled to the points
+    // the others can still reach, so the confidence thresholds keep their
+    // meaning instead of a lost barometer costing every fall 5 points.
+    void setSensorAvailability(uint8_t available);
+    uint8_t getSensorAvailability() { return available_sensors; }
+    uint8_t getReachableScore();    // MAX_CONFIDENCE_SCORE with every sensor up
+
+    // Results and classification
+    uint8_t getRawScore();          // Plain sum of the stages
+    uint8_t getTotalScore();        // Rescaled to MAX_CONFIDENCE_SCORE
+    FallConfidence_t getConfidenceLevel();
+    uint8_t getStageScore(uint8_t stage_number);
+
+    // Detailed breakdown
+    void getScoreBreakdown(uint8_t& s1, uint8_t& s2, uint8_t& s3, uint8_t& s4, uint8_t& filters);
+    bool isValidFallSequence();
+
+    // Utility functions
+    bool isScoringActive();
+    uint32_t getScoringDuration();
+
+    // Debug functions
+    void logScoreBreakdown();           // Deferred: safe on the alert path
+    void printDetailedAnalysis();
+    const char* getConfidenceString(FallConfidence_t confidence);
+
+private:
+    // Validation functions
+    bool validateScoreRange(uint8_t score, uint8_t max_score);
+    void capScore(uint8_t& score, uint8_t max_value);
+    void updateFilterScore();
+    uint8_t tableMaxPoints(ScoreMetric_t metric);
+    uint8_t filterReach(uint8_t available);
+    uint8_t impactReach(uint8_t available);
+};
+
+#endif // CONFIDENCE_SCORER_H
\ No newline at end of file
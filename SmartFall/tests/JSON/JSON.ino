@@ -0,0 +1,306 @@
+/*
+ * SmartFall - Zero-Allocation JSON Serializer Test
+ *
+ * Compares JSON_Writer payloads against the ArduinoJson documents the
+ * WiFi/BLE modules used to build, and checks that serialization does not
+ * touch the heap.
+ *
+ * Hardware: ESP32 HUZZAH32 Feather (no sensors required)
+ *
+ * This test verifies:
+ * - Byte-identical output for emergency, status and sensor payloads
+ * - Float formatting edge cases (tiny, huge, negative, NaN)
+ * - Buffer overflow is detected instead of truncating silently
+ * - Zero heap allocations per message
+ * - Serialization time vs. DynamicJsonDocument
+ */
+
+#include <ArduinoJson.h>
+#include <esp_heap_caps.h>
+#include "JSON_Writer.h"
+
+#define RANDOM_ROUNDS       500
+#define HEAP_TEST_MESSAGES  1000
+
+static char payload[JSON_EMERGENCY_BUFFER_SIZE];
+static EmergencyData_t emergency;
+
+int passed = 0;
+int failed = 0;
+
+// Reference implementations (previous ArduinoJson-based serializers)
+
+String referenceEmergencyJSON(const EmergencyData_t& data) {
+    DynamicJsonDocument doc(4096);
+
+    doc["timestamp"] = data.timestamp;
+    doc["confidence_score"] = data.confidence_score;
+    doc["confidence_level"] = data.confidence;
+    doc["battery_level"] = data.battery_level;
+    doc["sos_triggered"] = data.sos_triggered;
+    doc["device_id"] = String(data.device_id);
+
+    JsonArray history = doc.createNestedArray("sensor_history");
+    int count = data.history_count < 100 ? data.history_count : 100;
+    for (int i = count > 10 ? count - 10 : 0; i < count; i++) {
+        JsonObject sample = history.createNestedObject();
+        sample["timestamp"] = data.sensor_history[i].timestamp;
+        sample["accel_x"] = data.sensor_history[i].accel_x;
+        sample["accel_y"] = data.sensor_history[i].accel_y;
+        sample["accel_z"] = data.sensor_history[i].accel_z;
+        sample["gyro_x"] = data.sensor_history[i].gyro_x;
+        sample["gyro_y"] = data.sensor_history[i].gyro_y;
+        sample["gyro_z"] = data.sensor_history[i].gyro_z;
+        sample["heart_rate"] = data.sensor_history[i].heart_rate;
+    }
+
+    String json_string;
+    serializeJson(doc, json_string);
+    return json_string;
+}
+
+String referenceSensorJSON(const SensorData_t& data) {
+    DynamicJsonDocument doc(512);
+
+    doc["timestamp"] = data.timestamp;
+    doc["accel_x"] = data.accel_x;
+    doc["accel_y"] = data.accel_y;
+    doc["accel_z"] = data.accel_z;
+    doc["gyro_x"] = data.gyro_x;
+    doc["gyro_y"] = data.gyro_y;
+    doc["gyro_z"] = data.gyro_z;
+    doc["pressure"] = data.pressure;
+    doc["heart_rate"] = data.heart_rate;
+    doc["fsr_value"] = data.fsr_value;
+
+    String json_string;
+    serializeJson(doc, json_string);
+    return json_string;
+}
+
+String referenceBLEStatusJSON(const SystemStatus_t& data) {
+    DynamicJsonDocument doc(2048);
+
+    doc["type"] = "status";
+    doc["sensors_initialized"] = data.sensors_initialized;
+    doc["wifi_connected"] = data.wifi_connected;
+    doc["bluetooth_connected"] = data.bluetooth_connected;
+    doc["battery_percentage"] = data.battery_percentage;
+    doc["current_status"] = data.current_status;
+    doc["uptime_ms"] = data.uptime_ms;
+
+    JsonObject memory = doc.createNestedObject("memory");
+    memory["free_heap"] = data.memory.free_heap;
+    memory["min_free_heap"] = data.memory.min_free_heap;
+    memory["largest_free_block"] = data.memory.largest_free_block;
+    memory["fragmentation_pct"] = data.memory.fragmentation_pct;
+    memory["psram_free"] = data.memory.psram_free;
+    memory["min_stack_headroom"] = data.memory.min_stack_headroom;
+    memory["window_heap_min"] = data.memory.window_heap_min;
+    memory["window_heap_max"] = data.memory.window_heap_max;
+    memory["window_block_min"] = data.memory.window_block_min;
+    JsonArray trend = memory.createNestedArray("heap_trend");
+    for (uint8_t i = 0; i < data.memory.trend_count; i++) {
+        trend.add(data.memory.heap_trend[i]);
+    }
+
+    JsonObject boot = doc.createNestedObject("boot");
+    boot["monitoring_ms"] = data.boot.monitoring_ms;
+    boot["complete_ms"] = data.boot.complete_ms;
+    boot["failed"] = data.boot.failed_steps;
+    JsonObject steps = boot.createNestedObject("steps");
+    for (uint8_t i = 0; i < data.boot.step_count; i++) {
+        JsonArray step = steps.createNestedArray(data.boot.steps[i].name);
+        step.add(data.boot.steps[i].start_ms);
+        step.add(data.boot.steps[i].duration_ms);
+    }
+
+    String json_string;
+    serializeJson(doc, json_string);
+    return json_string;
+}
+
+float randomFloat(float range) {
+    // Mix magnitudes so both fixed and exponent notation are exercised
+    float value = (random(-1000000, 1000000) / 1000000.0f) * range;
+    if (random(0, 20) == 0) value *= 1e8f;
+    if (random(0, 20) == 0) value *= 1e-7f;
+    return value;
+}
+
+void randomizeSample(SensorData_t& sample) {
+    sample.timestamp = random(0, 0x7FFFFFFF);
+    sample.accel_x = randomFloat(16.0f);
+    sample.accel_y = randomFloat(16.0f);
+    sample.accel_z = randomFloat(16.0f);
+    sample.gyro_x = randomFloat(1000.0f);
+    sample.gyro_y = randomFloat(1000.0f);
+    sample.gyro_z = randomFloat(1000.0f);
+    sample.pressure = 950.0f + randomFloat(100.0f);
+    sample.heart_rate = randomFloat(200.0f);
+    sample.fsr_value = random(0, 4096);
+    sample.valid = true;
+}
+
+void check(const char* name, const String& expected, size_t length) {
+    bool match = (length == expected.length()) &&
+                 (memcmp(payload, expected.c_str(), length) == 0);
+    if (match) {
+        passed++;
+    } else {
+        failed++;
+        Serial.print("✗ Mismatch in ");
+        Serial.println(name);
+        Serial.print("  Expected: ");
+        Serial.println(expected);
+        Serial.print("  Actual:   ");
+        Serial.println(payload);
+    }
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(2000);
+
+    Serial.println("\n========================================");
+    Serial.println("   SmartFall JSON Serializer Test");
+    Serial.println("========================================\n");
+
+    randomSeed(42);
+
+    // Test 1: Float edge cases
+    Serial.println("TEST 1: Float Formatting Edge Cases");
+    Serial.println("------------------------------------");
+    const float edge_values[] = {
+        0.0f, -0.0f, 1.0f, 0.1f, 9.81f, 1013.25f, 1e7f, 9999999.5f,
+        1e-5f, 1.5e-5f, 3.4e38f, 1.2e-38f, -123.456f, NAN, INFINITY
+    };
+    for (size_t i = 0; i < sizeof(edge_values) / sizeof(edge_values[0]); i++) {
+        SensorData_t sample = {0};
+        sample.accel_x = edge_values[i];
+        check("float edge case", referenceSensorJSON(sample),
+              writeSensorJSON(sample, payload, sizeof(payload)));
+    }
+    Serial.print("✓ Edge cases checked: ");
+    Serial.println(passed);
+    Serial.println();
+
+    // Test 2: Randomized payloads
+    Serial.println("TEST 2: Randomized Payload Comparison");
+    Serial.println("--------------------------------------");
+    for (int round = 0; round < RANDOM_ROUNDS; round++) {
+        for (int i = 0; i < 100; i++) {
+            randomizeSample(emergency.sensor_history[i]);
+        }
+        emergency.history_count = random(0, 101);
+        emergency.timestamp = random(0, 0x7FFFFFFF);
+        emergency.confidence = (FallConfidence_t)random(0, 5);
+        emergency.confidence_score = random(0, 106);
+        emergency.battery_level = randomFloat(100.0f);
+        emergency.sos_triggered = random(0, 2);
+        snprintf(emergency.device_id, sizeof(emergency.device_id),
+                 "SF-%08lX\"\\\t", (unsigned long)random(0, 0x7FFFFFFF));
+
+        check("emergency", referenceEmergencyJSON(emergency),
+              writeEmergencyJSON(emergency, payload, sizeof(payload)));
+        check("sensor", referenceSensorJSON(emergency.sensor_history[0]),
+              writeSensorJSON(emergency.sensor_history[0], payload, sizeof(payload)));
+
+        SystemStatus_t status = {(bool)random(0, 2), (bool)random(0, 2), (bool)random(0, 2),
+                                 randomFloat(100.0f), (FallStatus_t)random(0, 8),
+                                 (uint32_t)random(0, 0x7FFFFFFF)};
+        status.memory.free_heap = random(0, 0x7FFFFFFF);
+        status.memory.largest_free_block = random(0, 0x7FFFFFFF);
+        status.memory.fragmentation_pct = random(0, 101);
+        status.memory.trend_count = random(0, MEMORY_TREND_WINDOWS + 1);
+        for (uint8_t i = 0; i < status.memory.trend_count; i++) {
+            status.memory.heap_trend[i] = random(0, 0x7FFFFFFF);
+        }
+        static const char* const step_names[] = {"config", "imu", "detector", "alerts", "audio", "pressure",
+                                                 "heart", "force", "logger", "wifi", "ble", "ready"};
+        status.boot.monitoring_ms = random(0, 1000);
+        status.boot.complete_ms = random(0, 0x7FFFFFFF);
+        status.boot.failed_steps = random(0, 4);
+        status.boot.step_count = random(0, 13);
+        for (uint8_t i = 0; i < status.boot.step_count; i++) {
+            status.boot.steps[i].name = step_names[i];
+            status.boot.steps[i].start_ms = random(0, 0x7FFFFFFF);
+            status.boot.steps[i].duration_ms = random(0, 0x7FFFFFFF);
+        }
+        check("ble status", referenceBLEStatusJSON(status),
+              writeBLEStatusJSON(status, payload, sizeof(payload)));
+    }
+    Serial.print("Passed: ");
+    Serial.print(passed);
+    Serial.print("  Failed: ");
+    Serial.println(failed);
+    Serial.println(failed == 0 ? "✓ Output is byte-identical\n" : "✗ Output differs\n");
+
+    // Test 3: Overflow detection
+    Serial.println("TEST 3: Overflow Detection");
+    Serial.println("---------------------------");
+    emergency.history_count = 100;  // Full history for the remaining tests
+    size_t truncated = writeEmergencyJSON(emergency, payload, 64);
+    if (truncated == 0) {
+        Serial.println("✓ Undersized buffer reported as failure\n");
+    } else {
+        Serial.println("✗ Undersized buffer not detected\n");
+        failed++;
+    }
+
+    // Test 4: Heap allocations
+    Serial.println("TEST 4: Heap Allocations");
+    Serial.println("-------------------------");
+    multi_heap_info_t before, after;
+    heap_caps_get_info(&before, MALLOC_CAP_8BIT);
+
+    for (int i = 0; i < HEAP_TEST_MESSAGES; i++) {
+        writeEmergencyJSON(emergency, payload, sizeof(payload));
+        writeBLEStatusJSON(SystemStatus_t(), payload, sizeof(payload));
+    }
+
+    heap_caps_get_info(&after, MALLOC_CAP_8BIT);
+    Serial.print("Allocated blocks delta: ");
+    Serial.println((int)after.allocated_blocks - (int)before.allocated_blocks);
+    Serial.print("Free bytes delta: ");
+    Serial.println((int)after.total_free_bytes - (int)before.total_free_bytes);
+    Serial.print("Largest free block delta: ");
+    Serial.println((int)after.largest_free_block - (int)before.largest_free_block);
+    if (after.allocated_blocks == before.allocated_blocks &&
+        after.total_free_bytes == before.total_free_bytes) {
+        Serial.println("✓ Zero heap allocations per message\n");
+    } else {
+        Serial.println("✗ Heap changed during serialization\n");
+        failed++;
+    }
+
+    // Test 5: Timing
+    Serial.println("TEST 5: Serialization Time");
+    Serial.println("---------------------------");
+    uint32_t start = micros();
+    for (int i = 0; i < 100; i++) {
+        writeEmergencyJSON(emergency, payload, sizeof(payload));
+    }
+    uint32_t writer_us = (micros() - start) / 100;
+
+    start = micros();
+    for (int i = 0; i < 100; i++) {
+        referenceEmergencyJSON(emergency);
+    }
+    uint32_t reference_us = (micros() - start) / 100;
+
+    Serial.print("JSON_Writer: ");
+    Serial.print(writer_us);
+    Serial.println(" us/message");
+    Serial.print("ArduinoJson: ");
+    Serial.print(reference_us);
+    Serial.println(" us/message\n");
+
+    Serial.println("========================================");
+    Serial.println(failed == 0 ? "      ALL TESTS PASSED" : "      TESTS FAILED");
+    Serial.println("========================================");
+}
+
+void loop() {
+    delay(1000);
+}
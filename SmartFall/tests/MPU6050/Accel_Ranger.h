@@ -0,0 +1,78 @@
+#ifndef ACCEL_RANGER_H
+#define ACCEL_RANGER_H
+
+#include <Arduino.h>
+#include "config.h"
+
+/*
+ * Accelerometer auto-ranging for the MPU6050.
+ *
+ * A fixed ±8 g scale clips hard falls, and the impact peak the detector
+ * scores clips with them. A fixed ±16 g scale halves the resolution
+ * for the whole time the wearer is still. The ranger keeps the low scale
+ * while quiet and moves to the high scale when either:
+ *   - any axis passes ACCEL_RANGE_UP_G (near saturation, with room left
+ *     for the rest of the pulse), or
+ *   - the magnitude stays below FREEFALL_THRESHOLD_G for
+ *     ACCEL_RANGE_FREEFALL_SAMPLES, since an impact usually follows.
+ * It returns to the low scale after ACCEL_RANGE_QUIET_SAMPLES in a row
+ * with every axis within ACCEL_RANGE_DOWN_G. Both sample counts are at
+ * SENSOR_SAMPLE_RATE_HZ; setSampleRate() scales them for the high-rate
+ * FIFO profile, which updates the ranger on every frame.
+ *
+ * update() sees the raw counts of each sample, read at getRange(). When
+ * it returns true, the caller writes the new scale before the next
+ * read. At 100 Hz the sensor has taken ten samples at the new scale by
+ * then, so every sample converts with the scale it was read at. That
+ * scale travels with the sample as SensorData_t::accel_range_g.
+ *
+ * No hardware access, so the same logic runs in the host simulations.
+ */
+
+#define ACCEL_FULL_SCALE_COUNTS  32768.0f   // Counts per full scale
+#define ACCEL_CLIP_COUNTS        32767      // A reading at or beyond this clipped
+
+class Accel_Ranger {
+private:
+    uint8_t low_g;
+    uint8_t high_g;
+    uint8_t range_g;                // Full scale of the next sample
+    uint16_t quiet_samples;         // Consecutive quiet samples at the high scale
+    uint8_t freefall_samples;
+    uint16_t quiet_limit;           // ACCEL_RANGE_QUIET_SAMPLES at the update rate
+    uint8_t freefall_limit;         // ACCEL_RANGE_FREEFALL_SAMPLES at the update rate
+    uint32_t switches_up;
+    uint32_t switches_down;
+    uint32_t samples;
+    uint32_t high_samples;
+    uint32_t clipped_samples;       // Clipped at the scale they were read at
+
+public:
+    Accel_Ranger(uint8_t low_range_g = ACCEL_RANGE_LOW_G, uint8_t high_range_g = ACCEL_RANGE_HIGH_G);
+
+    void reset();
+    void setSampleRate(uint16_t rate_hz);   // Rate update() is called at; kept by reset()
+
+    // Raw counts of one sample read at getRange(). True when the range
+    // changed and the new one must be written before the next read.
+    bool update(const int16_t raw[3]);
+
+    uint8_t getRange() { return range_g; }
+    bool isHigh() { return range_g == high_g; }
+    uint32_t getSwitchesUp() { return switches_up; }
+    uint32_t getSwitchesDown() { return switches_down; }
+    uint32_t getSamples() { return samples; }
+    uint32_t getHighSamples() { return high_samples; }
+    uint32_t getClippedSamples() { return clipped_samples; }
+
+    // Conversions at a given full scale (2, 4, 8 or 16 g)
+    static float countsPerG(uint8_t range_g) { return ACCEL_FULL_SCALE_COUNTS / range_g; }
+    static float toG(int16_t raw, uint8_t range_g) { return raw / countsPerG(range_g); }
+    static int16_t toCounts(float g, uint8_t range_g);  // Rounds and saturates like the ADC
+    static bool isClipped(int16_t raw) { return raw >= ACCEL_CLIP_COUNTS || raw <= -ACCEL_CLIP_COUNTS; }
+    static uint8_t toRegister(uint8_t range_g);         // AFS_SEL: 0 = ±2 g ... 3 = ±16 g
+
+    void printStats();
+};
+
+#endif // ACCEL_RANGER_H
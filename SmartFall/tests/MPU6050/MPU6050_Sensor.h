@@ -5,6 +5,9 @@
 #include <Wire.h>
 #include <Adafruit_MPU6050.h>
 #include <Adafruit_Sensor.h>
+#include "Accel_Ranger.h"
+#include "IMU_Decimator.h"
+#include "config.h"
 
 class MPU6050_Sensor {
 private:
@@ -12,21 +15,62 @@ private:
     bool initialized;
     uint8_t sda_pin;
     uint8_t scl_pin;
+    bool auto_range;
+    Accel_Ranger ranger;
+    uint8_t accel_range_g;          // Scale the next sample is read at
+    float gyro_counts_per_dps;
+    bool fifo_enabled;
+    uint16_t fifo_rate_hz;
+    uint32_t fifo_start_ms;
+    uint32_t fifo_frames;
+    uint32_t bus_bytes;             // Every byte on the wire since beginFifo(), addresses included
+    uint32_t bus_transactions;
+    uint32_t fifo_overflows;
+    uint32_t fifo_errors;
+    uint16_t fifo_max_backlog;      // Most frames found waiting in one drain
 
 public:
     MPU6050_Sensor(uint8_t sda = 23, uint8_t scl = 22);
 
     bool begin();
+    // With auto_range the accelerometer moves between ACCEL_RANGE_LOW_G
+    // and ACCEL_RANGE_HIGH_G (see Accel_Ranger.h) and accel_range is unused
     void configure(mpu6050_accel_range_t accel_range = MPU6050_RANGE_8_G,
                    mpu6050_gyro_range_t gyro_range = MPU6050_RANGE_1000_DEG,
-                   mpu6050_bandwidth_t bandwidth = MPU6050_BAND_94_HZ);
+                   mpu6050_bandwidth_t bandwidth = MPU6050_BAND_94_HZ,
+                   bool auto_range = ACCEL_AUTORANGE_ENABLED);
 
     bool readData(float &accel_x, float &accel_y, float &accel_z,
                   float &gyro_x, float &gyro_y, float &gyro_z,
                   float &temp);
 
+    // As above; sample_range_g is the full scale the sample was read at
+    bool readData(float &accel_x, float &accel_y, float &accel_z,
+                  float &gyro_x, float &gyro_y, float &gyro_z,
+                  float &temp, uint8_t &sample_range_g);
+
+    // High-rate profile: frames at rate_hz (dividing 1000) go to the
+    // FIFO, and readFifo() drains them. Raises the I2C clock to
+    // IMU_I2C_CLOCK_HZ. Call after configure().
+    bool beginFifo(uint16_t rate_hz = IMU_SAMPLE_RATE_HZ);
+    bool isFifoEnabled() { return fifo_enabled; }
+
+    // Pushes every waiting frame into decimator. False on a bus error or
+    // an overflow (the FIFO is reset and the frames lost).
+    bool readFifo(IMU_Decimator& decimator);
+    void printFifoStats();
+
     bool isInitialized();
+    Accel_Ranger& getRanger() { return ranger; }
     void printInfo();
+
+private:
+    // Private helper functions
+    bool readRaw(int16_t accel[3], int16_t gyro[3], int16_t &temp);
+    void applyAccelRange(uint8_t range_g);
+    bool writeRegister(uint8_t reg, uint8_t value);
+    bool readRegisters(uint8_t reg, uint8_t* buffer, uint8_t length);
+    void resetFifo();
 };
 
 #endif
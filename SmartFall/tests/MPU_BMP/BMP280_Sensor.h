@@ -9,6 +9,7 @@ class BMP280_Sensor {
 private:
     Adafruit_BMP280 bmp;
     bool initialized;
+    uint8_t address;                // 0x76 or 0x77, whichever answered
     uint8_t sda_pin;
     uint8_t scl_pin;
     float baselineAltitude;
@@ -17,16 +18,22 @@ private:
 public:
     BMP280_Sensor(uint8_t sda = 23, uint8_t scl = 22);
 
-    bool begin(uint8_t address = 0x76);
+    bool begin(uint8_t i2c_address = 0x76);
     void configure();
     void setSeaLevelPressure(float pressure_hPa);
     void resetBaselineAltitude();
 
+    // False when the chip does not answer; Adafruit_BMP280 ignores bus
+    // errors, so a dead part would otherwise repeat stale or garbage values
     bool readData(float &temperature, float &pressure, float &altitude);
-    float getAltitudeChange();
+    float getAltitudeChange();      // Since the boot baseline; drifts with the weather (see Altitude_Filter)
 
     bool isInitialized();
     void printInfo();
+
+private:
+    // Private helper functions
+    bool isResponding();            // Chip id readable and right
 };
 
 #endif
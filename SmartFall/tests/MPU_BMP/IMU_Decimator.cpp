@@ -0,0 +1,91 @@
+#include "IMU_Decimator.h"
+
+IMU_Decimator::IMU_Decimator() {
+    reset();
+}
+
+void IMU_Decimator::reset() {
+    for (uint8_t axis = 0; axis < 3; axis++) {
+        accel_sum[axis] = 0;
+        gyro_sum[axis] = 0;
+    }
+    accel_peak_sq = 0;
+    gyro_peak_sq = 0;
+    peak_clipped = false;
+    peak_range_g = 0;
+    frames = 0;
+    total_frames = 0;
+    outputs = 0;
+    max_frames = 0;
+}
+
+void IMU_Decimator::push(const int16_t accel[3], const int16_t gyro[3], uint8_t accel_range_g,
+                         float gyro_counts_per_dps) {
+    float counts_per_g = Accel_Ranger::countsPerG(accel_range_g);
+    float accel_sq = 0;
+    float gyro_sq = 0;
+    bool clipped = false;
+    for (uint8_t axis = 0; axis < 3; axis++) {
+        float a = accel[axis] / counts_per_g;
+        float g = gyro[axis] / gyro_counts_per_dps;
+        accel_sum[axis] += a;
+        gyro_sum[axis] += g;
+        accel_sq += a * a;
+        gyro_sq += g * g;
+        clipped |= Accel_Ranger::isClipped(accel[axis]);
+    }
+
+    if (frames == 0 || accel_sq > accel_peak_sq) {
+        accel_peak_sq = accel_sq;
+        peak_clipped = clipped;
+        peak_range_g = accel_range_g;
+    }
+    if (gyro_sq > gyro_peak_sq) gyro_peak_sq = gyro_sq;
+
+    if (frames < 65535) frames++;
+    total_frames++;
+}
+
+bool IMU_Decimator::take(SensorData_t& data) {
+    if (frames == 0) return false;
+
+    float scale = 1.0f / frames;
+    data.accel_x = accel_sum[0] * scale;
+    data.accel_y = accel_sum[1] * scale;
+    data.accel_z = accel_sum[2] * scale;
+    data.gyro_x = gyro_sum[0] * scale;
+    data.gyro_y = gyro_sum[1] * scale;
+    data.gyro_z = gyro_sum[2] * scale;
+    data.accel_range_g = peak_range_g;
+    data.accel_peak_g = sqrtf(accel_peak_sq);
+    data.accel_peak_clipped = peak_clipped;
+    data.gyro_peak_dps = sqrtf(gyro_peak_sq);
+
+    if (frames > max_frames) max_frames = frames;
+    outputs++;
+
+    for (uint8_t axis = 0; axis < 3; axis++) {
+        accel_sum[axis] = 0;
+        gyro_sum[axis] = 0;
+    }
+    accel_peak_sq = 0;
+    gyro_peak_sq = 0;
+    peak_clipped = false;
+    frames = 0;
+    return true;
+}
+
+void IMU_Decimator::printStats() {
+    Serial.println("=== IMU Decimator ===");
+    Serial.print("Frames: ");
+    Serial.print(total_frames);
+    Serial.print(" into ");
+    Serial.print(outputs);
+    Serial.println(" samples");
+    Serial.print("Frames per sample: ");
+    Serial.print(outputs ? (float)total_frames / outputs : 0.0f, 2);
+    Serial.print(" (max ");
+    Serial.print(max_frames);
+    Serial.println(")");
+    Serial.println("=====================");
+}
@@ -1,7 +1,27 @@
 #include "MPU6050_Sensor.h"
 
+#define MPU6050_BURST_BYTES 14       // Accel, temperature, gyro registers
+
+// FIFO registers (not in Adafruit_MPU6050)
+#define MPU6050_FIFO_EN_REG      0x23
+#define MPU6050_USER_CTRL_REG    0x6A
+#define MPU6050_FIFO_COUNT_REG   0x72
+#define MPU6050_FIFO_DATA_REG    0x74
+#define MPU6050_FIFO_ACCEL_GYRO  0x78    // FIFO_EN: XG, YG, ZG and accel
+#define MPU6050_USER_FIFO_EN     0x40
+#define MPU6050_USER_FIFO_RESET  0x04
+#define MPU6050_FIFO_SIZE        1024
+#define MPU6050_FRAME_BYTES      12      // Accel then gyro, big-endian
+#define MPU6050_GYRO_RATE_HZ     1000    // Output rate with the DLPF on
+
+static_assert(MPU6050_GYRO_RATE_HZ % IMU_SAMPLE_RATE_HZ == 0, "IMU_SAMPLE_RATE_HZ must divide 1000");
+static_assert(IMU_FIFO_BURST_FRAMES * MPU6050_FRAME_BYTES <= 128, "FIFO burst exceeds the Wire buffer");
+
 MPU6050_Sensor::MPU6050_Sensor(uint8_t sda, uint8_t scl)
-    : initialized(false), sda_pin(sda), scl_pin(scl) {
+    : initialized(false), sda_pin(sda), scl_pin(scl), auto_range(false),
+      accel_range_g(8), gyro_counts_per_dps(32.8f), fifo_enabled(false), fifo_rate_hz(0),
+      fifo_start_ms(0), fifo_frames(0), bus_bytes(0), bus_transactions(0), fifo_overflows(0),
+      fifo_errors(0), fifo_max_backlog(0) {
 }
 
 bool MPU6050_Sensor::begin() {
@@ -12,37 +32,59 @@ bool MPU6050_Sensor::begin() {
         return false;
     }
 
+    // Library defaults until configure()
+    accel_range_g = 2;
+    gyro_counts_per_dps = 65.5f;
     initialized = true;
     return true;
 }
 
 void MPU6050_Sensor::configure(mpu6050_accel_range_t accel_range,
                                 mpu6050_gyro_range_t gyro_range,
-                                mpu6050_bandwidth_t bandwidth) {
+                                mpu6050_bandwidth_t bandwidth,
+                                bool auto_ranging) {
     if (!initialized) return;
 
-    mpu.setAccelerometerRange(accel_range);
+    auto_range = auto_ranging;
+    ranger.reset();
+    applyAccelRange(auto_range ? ranger.getRange() : (2 << accel_range));
+
     mpu.setGyroRange(gyro_range);
+    gyro_counts_per_dps = 131.0f / (1 << gyro_range);   // 131 LSB per °/s at ±250 °/s
     mpu.setFilterBandwidth(bandwidth);
 }
 
 bool MPU6050_Sensor::readData(float &accel_x, float &accel_y, float &accel_z,
                                float &gyro_x, float &gyro_y, float &gyro_z,
                                float &temp) {
+    uint8_t sample_range_g;
+    return readData(accel_x, accel_y, accel_z, gyro_x, gyro_y, gyro_z, temp, sample_range_g);
+}
+
+bool MPU6050_Sensor::readData(float &accel_x, float &accel_y, float &accel_z,
+                               float &gyro_x, float &gyro_y, float &gyro_z,
+                               float &temp, uint8_t &sample_range_g) {
     if (!initialized) return false;
 
-    sensors_event_t a, g, t;
-    mpu.getEvent(&a, &g, &t);
+    int16_t accel[3], gyro[3], raw_temp;
+    if (!readRaw(accel, gyro, raw_temp)) return false;
+
+    // Converted at the scale this sample was read at
+    sample_range_g = accel_range_g;
+    accel_x = Accel_Ranger::toG(accel[0], accel_range_g);
+    accel_y = Accel_Ranger::toG(accel[1], accel_range_g);
+    accel_z = Accel_Ranger::toG(accel[2], accel_range_g);
 
-    accel_x = a.acceleration.x / 9.81;  // Convert to g
-    accel_y = a.acceleration.y / 9.81;
-    accel_z = a.acceleration.z / 9.81;
+    gyro_x = gyro[0] / gyro_counts_per_dps;
+    gyro_y = gyro[1] / gyro_counts_per_dps;
+    gyro_z = gyro[2] / gyro_counts_per_dps;
 
-    gyro_x = g.gyro.x;
-    gyro_y = g.gyro.y;
-    gyro_z = g.gyro.z;
+    temp = raw_temp / 340.0f + 36.53f;
 
-    temp = t.temperature;
+    // A new scale takes effect from the next read
+    if (auto_range && ranger.update(accel)) {
+        applyAccelRange(ranger.getRange());
+    }
 
     return true;
 }
@@ -66,6 +108,22 @@ void MPU6050_Sensor::printInfo() {
         case MPU6050_RANGE_16_G: Serial.println("16G"); break;
     }
 
+    if (fifo_enabled) {
+        Serial.print("FIFO: ");
+        Serial.print(fifo_rate_hz);
+        Serial.println(" Hz");
+    }
+
+    if (auto_range) {
+        Serial.print("Auto-ranging: ±");
+        Serial.print(ACCEL_RANGE_LOW_G);
+        Serial.print("/");
+        Serial.print(ACCEL_RANGE_HIGH_G);
+        Serial.print("G, ");
+        Serial.print(ranger.getSwitchesUp());
+        Serial.println(" switches up");
+    }
+
     Serial.print("Gyroscope range: ±");
     switch (mpu.getGyroRange()) {
         case MPU6050_RANGE_250_DEG: Serial.println("250°/s"); break;
@@ -74,3 +132,159 @@ void MPU6050_Sensor::printInfo() {
         case MPU6050_RANGE_2000_DEG: Serial.println("2000°/s"); break;
     }
 }
+
+bool MPU6050_Sensor::beginFifo(uint16_t rate_hz) {
+    if (!initialized || rate_hz == 0 || MPU6050_GYRO_RATE_HZ % rate_hz != 0) return false;
+
+    Wire.setClock(IMU_I2C_CLOCK_HZ);
+    if (!writeRegister(MPU6050_FIFO_EN_REG, MPU6050_FIFO_ACCEL_GYRO)) return false;
+
+    // DLPF below half the frame rate
+    mpu.setFilterBandwidth(rate_hz >= 500 ? MPU6050_BAND_184_HZ : MPU6050_BAND_94_HZ);
+    mpu.setSampleRateDivisor(MPU6050_GYRO_RATE_HZ / rate_hz - 1);
+    ranger.setSampleRate(rate_hz);
+    resetFifo();
+
+    fifo_enabled = true;
+    fifo_rate_hz = rate_hz;
+    fifo_start_ms = millis();
+    fifo_frames = 0;
+    bus_bytes = 0;
+    bus_transactions = 0;
+    fifo_overflows = 0;
+    fifo_errors = 0;
+    fifo_max_backlog = 0;
+    return true;
+}
+
+bool MPU6050_Sensor::readFifo(IMU_Decimator& decimator) {
+    if (!fifo_enabled) return false;
+
+    uint8_t count_bytes[2];
+    if (!readRegisters(MPU6050_FIFO_COUNT_REG, count_bytes, 2)) {
+        fifo_errors++;
+        return false;
+    }
+    uint16_t count = (count_bytes[0] << 8) | count_bytes[1];
+
+    // A full FIFO has dropped bytes, so frame boundaries are lost
+    if (count > MPU6050_FIFO_SIZE - MPU6050_FRAME_BYTES) {
+        fifo_overflows++;
+        resetFifo();
+        return false;
+    }
+
+    uint16_t waiting = count / MPU6050_FRAME_BYTES;
+    if (waiting > fifo_max_backlog) fifo_max_backlog = waiting;
+
+    // Every waiting frame was taken before any range change made here
+    bool switched = false;
+    uint8_t buffer[IMU_FIFO_BURST_FRAMES * MPU6050_FRAME_BYTES];
+    while (waiting > 0) {
+        uint8_t burst = waiting < IMU_FIFO_BURST_FRAMES ? waiting : IMU_FIFO_BURST_FRAMES;
+        if (!readRegisters(MPU6050_FIFO_DATA_REG, buffer, burst * MPU6050_FRAME_BYTES)) {
+            fifo_errors++;
+            resetFifo();
+            return false;
+        }
+
+        for (uint8_t f = 0; f < burst; f++) {
+            const uint8_t* frame = buffer + f * MPU6050_FRAME_BYTES;
+            int16_t accel[3], gyro[3];
+            for (uint8_t axis = 0; axis < 3; axis++) {
+                accel[axis] = (int16_t)((frame[2 * axis] << 8) | frame[2 * axis + 1]);
+                gyro[axis] = (int16_t)((frame[6 + 2 * axis] << 8) | frame[7 + 2 * axis]);
+            }
+            decimator.push(accel, gyro, accel_range_g, gyro_counts_per_dps);
+            if (auto_range && !switched) switched = ranger.update(accel);
+        }
+        waiting -= burst;
+        fifo_frames += burst;
+    }
+
+    // Frames queued since the drain are at the old scale; drop them
+    if (switched) {
+        applyAccelRange(ranger.getRange());
+        resetFifo();
+    }
+    return true;
+}
+
+void MPU6050_Sensor::printFifoStats() {
+    if (!fifo_enabled) return;
+
+    float seconds = (millis() - fifo_start_ms) / 1000.0f;
+    // 9 clocks per byte (with ACK) plus start and stop per transaction
+    float bus_bits = bus_bytes * 9.0f + bus_transactions * 2.0f;
+
+    Serial.println("=== MPU6050 FIFO ===");
+    Serial.print("Rate: ");
+    Serial.print(fifo_rate_hz);
+    Serial.print(" Hz, ");
+    Serial.print(seconds > 0 ? fifo_frames / seconds : 0.0f, 1);
+    Serial.println(" frames/s read");
+    Serial.print("I2C: ");
+    Serial.print(seconds > 0 ? bus_bytes / seconds : 0.0f, 0);
+    Serial.print(" B/s, ");
+    Serial.print(seconds > 0 ? 100.0f * bus_bits / (seconds * IMU_I2C_CLOCK_HZ) : 0.0f, 1);
+    Serial.print("% of ");
+    Serial.print(IMU_I2C_CLOCK_HZ / 1000);
+    Serial.println(" kHz");
+    Serial.print("Max backlog: ");
+    Serial.print(fifo_max_backlog);
+    Serial.println(" frames");
+    Serial.print("Overflows: ");
+    Serial.print(fifo_overflows);
+    Serial.print(", bus errors: ");
+    Serial.println(fifo_errors);
+    Serial.println("====================");
+}
+
+// Private helper functions
+
+// One burst of ACCEL_XOUT_H..GYRO_ZOUT_L, big-endian
+bool MPU6050_Sensor::readRaw(int16_t accel[3], int16_t gyro[3], int16_t &temp) {
+    uint8_t buffer[MPU6050_BURST_BYTES];
+    if (!readRegisters(MPU6050_ACCEL_OUT, buffer, MPU6050_BURST_BYTES)) return false;
+
+    for (uint8_t axis = 0; axis < 3; axis++) {
+        accel[axis] = (int16_t)((buffer[2 * axis] << 8) | buffer[2 * axis + 1]);
+        gyro[axis] = (int16_t)((buffer[8 + 2 * axis] << 8) | buffer[9 + 2 * axis]);
+    }
+    temp = (int16_t)((buffer[6] << 8) | buffer[7]);
+    return true;
+}
+
+void MPU6050_Sensor::applyAccelRange(uint8_t range_g) {
+    mpu.setAccelerometerRange((mpu6050_accel_range_t)Accel_Ranger::toRegister(range_g));
+    accel_range_g = range_g;
+}
+
+bool MPU6050_Sensor::writeRegister(uint8_t reg, uint8_t value) {
+    Wire.beginTransmission(MPU6050_I2CADDR_DEFAULT);
+    Wire.write(reg);
+    Wire.write(value);
+    bus_bytes += 3;
+    bus_transactions++;
+    return Wire.endTransmission() == 0;
+}
+
+// Register pointer write, then a repeated-start read
+bool MPU6050_Sensor::readRegisters(uint8_t reg, uint8_t* buffer, uint8_t length) {
+    Wire.beginTransmission(MPU6050_I2CADDR_DEFAULT);
+    Wire.write(reg);
+    bus_bytes += 3 + length;
+    bus_transactions += 2;
+    if (Wire.endTransmission(false) != 0) return false;
+    if (Wire.requestFrom((uint8_t)MPU6050_I2CADDR_DEFAULT, length) != length) return false;
+
+    for (uint8_t i = 0; i < length; i++) {
+        buffer[i] = Wire.read();
+    }
+    return true;
+}
+
+void MPU6050_Sensor::resetFifo() {
+    writeRegister(MPU6050_USER_CTRL_REG, MPU6050_USER_FIFO_RESET);
+    writeRegister(MPU6050_USER_CTRL_REG, MPU6050_USER_FIFO_EN);
+}
@@ -0,0 +1,207 @@
+/*
+ * SmartFall - Accelerometer Auto-Ranging Test
+ *
+ * Feeds raw counts to Accel_Ranger the way MPU6050_Sensor::readData()
+ * does and checks when the scale moves.
+ *
+ * Hardware: ESP32 HUZZAH32 Feather (no sensors required)
+ *
+ * This test verifies:
+ * - A near-saturation or clipped sample switches up on that sample
+ * - Free fall switches up before the impact arrives
+ * - The scale drops back only after ACCEL_RANGE_QUIET_SAMPLES quiet samples,
+ *   and motion or free fall restarts the count
+ * - Both sample counts scale with the update rate of the FIFO profile
+ * - Count conversions round, saturate and survive NaN
+ * - Clipped samples and time at the high scale are counted
+ */
+
+#include "Accel_Ranger.h"
+
+int passed = 0;
+int failed = 0;
+
+void expect(const char* name, int32_t expected, int32_t actual) {
+    if (expected == actual) {
+        passed++;
+        Serial.print("✓ ");
+    } else {
+        failed++;
+        Serial.print("✗ ");
+    }
+    Serial.print(name);
+    Serial.print(": expected ");
+    Serial.print(expected);
+    Serial.print(", got ");
+    Serial.println(actual);
+}
+
+void expectTrue(const char* name, bool condition) {
+    expect(name, 1, condition ? 1 : 0);
+}
+
+// One sample in g, quantized and clipped at the ranger's current scale
+bool feed(Accel_Ranger& ranger, float x, float y, float z) {
+    int16_t raw[3] = {Accel_Ranger::toCounts(x, ranger.getRange()),
+                      Accel_Ranger::toCounts(y, ranger.getRange()),
+                      Accel_Ranger::toCounts(z, ranger.getRange())};
+    return ranger.update(raw);
+}
+
+// Samples of 1 g at rest until the scale changes; -1 if it never does
+int32_t restUntilSwitch(Accel_Ranger& ranger, uint32_t limit) {
+    for (uint32_t i = 0; i < limit; i++) {
+        if (feed(ranger, 0.0f, 0.0f, 1.0f)) return i + 1;
+    }
+    return -1;
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(2000);
+
+    Serial.println("\n========================================");
+    Serial.println("   SmartFall Accel Auto-Ranging Test");
+    Serial.println("========================================\n");
+
+    Accel_Ranger ranger;
+
+    // Test 1: Switching up
+    Serial.println("TEST 1: Switching Up");
+    Serial.println("---------------------");
+    {
+        expect("starts at the low scale", ACCEL_RANGE_LOW_G, ranger.getRange());
+        expectTrue("walking stays low", !feed(ranger, 1.5f, -2.0f, 3.5f));
+        expectTrue("just under the up threshold stays low",
+                   !feed(ranger, 0.0f, ACCEL_RANGE_UP_G - 0.01f, 0.0f));
+        expectTrue("up threshold on any axis switches", feed(ranger, 0.0f, 0.0f, -ACCEL_RANGE_UP_G));
+        expect("now at the high scale", ACCEL_RANGE_HIGH_G, ranger.getRange());
+        expectTrue("no second switch at the high scale", !feed(ranger, 12.0f, 0.0f, 0.0f));
+
+        ranger.reset();
+        expectTrue("clipped sample switches", feed(ranger, 0.0f, 25.0f, 0.0f));
+        expect("one clipped sample counted", 1, ranger.getClippedSamples());
+        expect("one switch up", 1, ranger.getSwitchesUp());
+    }
+    Serial.println();
+
+    // Test 2: Free fall pre-arms the high scale
+    Serial.println("TEST 2: Free Fall");
+    Serial.println("------------------");
+    {
+        ranger.reset();
+        int32_t switched_after = -1;
+        for (uint8_t i = 0; i < 10 && switched_after < 0; i++) {
+            if (feed(ranger, 0.1f, 0.1f, 0.2f)) switched_after = i + 1;
+        }
+        expect("switches after FREEFALL_SAMPLES", ACCEL_RANGE_FREEFALL_SAMPLES, switched_after);
+
+        // A free-fall run broken by a normal sample starts over
+        ranger.reset();
+        for (uint8_t i = 0; i + 1 < ACCEL_RANGE_FREEFALL_SAMPLES; i++) feed(ranger, 0.0f, 0.0f, 0.1f);
+        feed(ranger, 0.0f, 0.0f, 1.0f);
+        bool early = false;
+        for (uint8_t i = 0; i + 1 < ACCEL_RANGE_FREEFALL_SAMPLES; i++) early |= feed(ranger, 0.0f, 0.0f, 0.1f);
+        expectTrue("interrupted free fall stays low", !early);
+        expectTrue("one more free-fall sample switches", feed(ranger, 0.0f, 0.0f, 0.1f));
+    }
+    Serial.println();
+
+    // Test 3: Switching back down
+    Serial.println("TEST 3: Switching Down");
+    Serial.println("-----------------------");
+    {
+        ranger.reset();
+        feed(ranger, 6.0f, 0.0f, 0.0f);
+        expect("quiet samples before switching down", ACCEL_RANGE_QUIET_SAMPLES,
+               restUntilSwitch(ranger, 1000));
+        expect("back at the low scale", ACCEL_RANGE_LOW_G, ranger.getRange());
+        expect("one switch down", 1, ranger.getSwitchesDown());
+
+        // Motion halfway through restarts the count
+        feed(ranger, 6.0f, 0.0f, 0.0f);
+        restUntilSwitch(ranger, ACCEL_RANGE_QUIET_SAMPLES / 2);
+        expectTrue("motion is not quiet", !feed(ranger, 0.0f, ACCEL_RANGE_DOWN_G + 0.5f, 1.0f));
+        expect("count restarts after motion", ACCEL_RANGE_QUIET_SAMPLES, restUntilSwitch(ranger, 1000));
+
+        // Free fall is low in magnitude but never quiet
+        feed(ranger, 6.0f, 0.0f, 0.0f);
+        restUntilSwitch(ranger, ACCEL_RANGE_QUIET_SAMPLES - 1);
+        expectTrue("free fall is not quiet", !feed(ranger, 0.0f, 0.0f, 0.1f));
+        expect("count restarts after free fall", ACCEL_RANGE_QUIET_SAMPLES, restUntilSwitch(ranger, 1000));
+    }
+    Serial.println();
+
+    // Test 4: Update rate
+    Serial.println("TEST 4: Update Rate");
+    Serial.println("--------------------");
+    {
+        Accel_Ranger fast;
+        fast.setSampleRate(10 * SENSOR_SAMPLE_RATE_HZ);
+        int32_t switched_after = -1;
+        for (uint8_t i = 0; i < 100 && switched_after < 0; i++) {
+            if (feed(fast, 0.0f, 0.0f, 0.1f)) switched_after = i + 1;
+        }
+        expect("free fall frames at 10x rate", 10 * ACCEL_RANGE_FREEFALL_SAMPLES, switched_after);
+        expect("quiet frames at 10x rate", 10 * ACCEL_RANGE_QUIET_SAMPLES, restUntilSwitch(fast, 10000));
+        fast.reset();
+        expectTrue("reset keeps the rate", feed(fast, 6.0f, 0.0f, 0.0f) &&
+                   restUntilSwitch(fast, 10000) == 10 * ACCEL_RANGE_QUIET_SAMPLES);
+
+        // 3 samples at 100 Hz round to none at 10 Hz; one is the floor
+        fast.setSampleRate(SENSOR_SAMPLE_RATE_HZ / 10);
+        fast.reset();
+        expectTrue("free fall count never drops below one", feed(fast, 0.0f, 0.0f, 0.1f));
+    }
+    Serial.println();
+
+    // Test 5: Conversions
+    Serial.println("TEST 5: Conversions");
+    Serial.println("--------------------");
+    {
+        expect("1 g at 8 g", 4096, Accel_Ranger::toCounts(1.0f, 8));
+        expect("1 g at 16 g", 2048, Accel_Ranger::toCounts(1.0f, 16));
+        expect("rounds to nearest", -3, Accel_Ranger::toCounts(-2.6f / 4096.0f, 8));
+        expect("saturates high", 32767, Accel_Ranger::toCounts(9.0f, 8));
+        expect("saturates low", -32768, Accel_Ranger::toCounts(-9.0f, 8));
+        expect("NaN converts to 0", 0, Accel_Ranger::toCounts(NAN, 8));
+        expect("round trip at 16 g (mg)", 12500,
+               (int32_t)lroundf(1000.0f * Accel_Ranger::toG(Accel_Ranger::toCounts(12.5f, 16), 16)));
+        expectTrue("full scale is clipped", Accel_Ranger::isClipped(-32768));
+        expectTrue("one count inside is not", !Accel_Ranger::isClipped(32766));
+        expect("register for 2 g", 0, Accel_Ranger::toRegister(2));
+        expect("register for 16 g", 3, Accel_Ranger::toRegister(16));
+        expect("unknown range falls back to 8 g", 2, Accel_Ranger::toRegister(5));
+    }
+    Serial.println();
+
+    // Test 6: Statistics
+    Serial.println("TEST 6: Statistics");
+    Serial.println("-------------------");
+    {
+        ranger.reset();
+        feed(ranger, 0.0f, 0.0f, 1.0f);
+        feed(ranger, 30.0f, 0.0f, 0.0f);   // Clipped at 8 g, switches up
+        feed(ranger, 30.0f, 0.0f, 0.0f);   // Clipped at 16 g too
+        feed(ranger, 10.0f, 0.0f, 0.0f);
+        expect("samples", 4, ranger.getSamples());
+        expect("samples at the high scale", 2, ranger.getHighSamples());
+        expect("clipped samples", 2, ranger.getClippedSamples());
+        expectTrue("isHigh", ranger.isHigh());
+        ranger.printStats();
+    }
+    Serial.println();
+
+    Serial.print("Passed: ");
+    Serial.print(passed);
+    Serial.print("  Failed: ");
+    Serial.println(failed);
+
+    Serial.println("========================================");
+    Serial.println(failed == 0 ? "      ALL TESTS PASSED" : "      TESTS FAILED");
+    Serial.println("========================================");
+}
+
+void loop() {
+    delay(1000);
+}
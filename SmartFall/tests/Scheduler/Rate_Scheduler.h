@@ -0,0 +1,103 @@
+#ifndef RATE_SCHEDULER_H
+#define RATE_SCHEDULER_H
+
+#include <Arduino.h>
+
+#ifdef ARDUINO
+#include <esp_timer.h>
+#endif
+
+#define SCHEDULER_MAX_GROUPS  6
+
+typedef void (*RateTask_t)();
+typedef uint32_t (*SchedulerClock_t)();
+
+// Default clock: micros() narrowed to 32 bits
+uint32_t schedulerMicros();
+
+// One periodic rate group (e.g. sensor 10 ms, comms 100 ms, status 60 s)
+typedef struct {
+    const char* name;
+    RateTask_t task;
+    uint32_t period_ticks;      // Period in base ticks
+    bool enabled;
+
+    // Accounting
+    uint32_t runs;
+    uint32_t overruns;          // Times the group missed at least one period
+    uint32_t skipped;           // Periods dropped while catching up
+    uint32_t max_exec_us;
+    uint32_t last_exec_us;
+} RateGroup_t;
+
+/*
+ * Drift-free fixed-rate scheduler.
+ *
+ * A periodic esp_timer produces base ticks on an absolute time grid, so
+ * group periods never stretch by the time spent doing work. loop() blocks
+ * in waitForTick() and then calls runPending(), which runs every group
+ * whose period boundary fell inside the ticks that elapsed. If work
+ * overruns, missed periods are counted and skipped rather than replayed
+ * in a burst. On the host, advance() injects ticks from a virtual clock.
+ */
+class Rate_Scheduler {
+private:
+    uint32_t base_period_us;
+    RateGroup_t groups[SCHEDULER_MAX_GROUPS];
+    uint8_t group_count;
+
+    bool running;
+    volatile uint32_t pending_ticks;   // Produced by the timer, consumed by runPending()
+    volatile uint32_t last_tick_us;    // Clock time of the most recent tick
+    uint32_t tick_count;               // Ticks consumed so far
+
+    // Loop-level accounting
+    uint32_t loop_overruns;            // Passes that found more than one tick pending
+    uint32_t missed_ticks;
+    uint32_t max_wake_latency_us;
+
+    SchedulerClock_t clock_us;
+
+#ifdef ARDUINO
+    esp_timer_handle_t timer;
+    TaskHandle_t waiting_task;
+    portMUX_TYPE tick_mux;
+#endif
+
+public:
+    Rate_Scheduler(uint32_t base_period_us, SchedulerClock_t clock = schedulerMicros);
+    ~Rate_Scheduler();
+
+    // Configuration
+    int8_t addGroup(const char* name, uint32_t period_ms, RateTask_t task);
+    void enableGroup(uint8_t index, bool enable = true);
+
+    // Control
+    bool begin();      // Start the hardware tick source
+    void stop();
+    bool waitForTick(uint32_t timeout_ms = 100);
+    uint8_t runPending();
+
+    // Tick source (timer callback on device, virtual clock on host)
+    void advance(uint32_t ticks = 1);
+
+    // Results
+    const RateGroup_t* getGroup(uint8_t index);
+    uint8_t getGroupCount();
+    uint32_t getTickCount();
+    uint32_t getLoopOverruns();
+    uint32_t getMissedTicks();
+    uint32_t getMaxWakeLatency();
+    void resetStats();
+
+    // Debug functions
+    void printStats();
+
+private:
+#ifdef ARDUINO
+    static void onTimer(void* arg);
+#endif
+    uint32_t takePendingTicks();
+};
+
+#endif // RATE_SCHEDULER_H
@@ -0,0 +1,247 @@
+/*
+ * SmartFall - Fixed-Rate Scheduler Test
+ *
+ * Drives Rate_Scheduler from a virtual clock so rate-group timing can be
+ * checked exactly, then runs the real esp_timer tick for a few seconds.
+ *
+ * Hardware: ESP32 HUZZAH32 Feather (no sensors required)
+ *
+ * This test verifies:
+ * - Exact run counts for sensor (10 ms), comms (100 ms), status (60 s) groups
+ * - Groups stay on the tick grid regardless of task execution time
+ * - Overrun/skip accounting when a task blocks for several periods
+ * - Effective rate vs. the old "work + delay(10)" loop
+ * - Real timer-driven rate and wake latency on the device
+ */
+
+#include "Rate_Scheduler.h"
+
+#define BASE_PERIOD_US      10000
+#define VIRTUAL_SECONDS     600     // 10 minutes of virtual time
+#define REAL_RUN_MS         5000
+
+// Virtual clock in microseconds, advanced by the test and by "work"
+static uint32_t virtual_us = 0;
+static uint32_t work_us = 0;        // Simulated execution time per sensor run
+
+uint32_t virtualClock() {
+    return virtual_us;
+}
+
+static uint32_t sensor_runs = 0;
+static uint32_t comms_runs = 0;
+static uint32_t status_runs = 0;
+static uint32_t off_grid = 0;       // Runs that did not start on their period boundary
+static Rate_Scheduler* active = nullptr;
+
+void sensorTask() {
+    sensor_runs++;
+    virtual_us += work_us;
+}
+
+void commsTask() {
+    comms_runs++;
+    if (active->getTickCount() % 10 != 0) off_grid++;
+}
+
+void statusTask() {
+    status_runs++;
+    if (active->getTickCount() % 6000 != 0) off_grid++;
+}
+
+int passed = 0;
+int failed = 0;
+
+void expect(const char* name, uint32_t expected, uint32_t actual) {
+    if (expected == actual) {
+        passed++;
+        Serial.print("✓ ");
+    } else {
+        failed++;
+        Serial.print("✗ ");
+    }
+    Serial.print(name);
+    Serial.print(": expected ");
+    Serial.print(expected);
+    Serial.print(", got ");
+    Serial.println(actual);
+}
+
+void resetCounters() {
+    virtual_us = 0;
+    sensor_runs = comms_runs = status_runs = off_grid = 0;
+}
+
+// Advance the virtual clock one base period at a time and service the scheduler
+void runVirtual(Rate_Scheduler& scheduler, uint32_t ticks) {
+    for (uint32_t i = 0; i < ticks; i++) {
+        virtual_us += BASE_PERIOD_US;
+        scheduler.advance(1);
+        scheduler.runPending();
+    }
+}
+
+void setupGroups(Rate_Scheduler& scheduler) {
+    scheduler.addGroup("sensor", 10, sensorTask);
+    scheduler.addGroup("comms", 100, commsTask);
+    scheduler.addGroup("status", 60000, statusTask);
+    active = &scheduler;
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(2000);
+
+    Serial.println("\n========================================");
+    Serial.println("   SmartFall Fixed-Rate Scheduler Test");
+    Serial.println("========================================\n");
+
+    // Test 1: Exact run counts over a long virtual run
+    Serial.println("TEST 1: Run Counts (virtual clock)");
+    Serial.println("-----------------------------------");
+    {
+        resetCounters();
+        work_us = 3000;
+        Rate_Scheduler scheduler(BASE_PERIOD_US, virtualClock);
+        setupGroups(scheduler);
+        scheduler.begin();
+        runVirtual(scheduler, VIRTUAL_SECONDS * 100UL);
+
+        expect("sensor runs", VIRTUAL_SECONDS * 100UL, sensor_runs);
+        expect("comms runs", VIRTUAL_SECONDS * 10UL, comms_runs);
+        expect("status runs", VIRTUAL_SECONDS / 60, status_runs);
+        expect("off-grid runs", 0, off_grid);
+        expect("missed ticks", 0, scheduler.getMissedTicks());
+        scheduler.stop();
+    }
+    Serial.println();
+
+    // Test 2: A blocking task causes skipped periods, not a burst
+    Serial.println("TEST 2: Overrun Accounting");
+    Serial.println("---------------------------");
+    {
+        resetCounters();
+        work_us = 0;
+        Rate_Scheduler scheduler(BASE_PERIOD_US, virtualClock);
+        setupGroups(scheduler);
+        scheduler.begin();
+
+        runVirtual(scheduler, 5);
+
+        // Loop stalls for 250 ms (e.g. a blocking HTTP POST)
+        virtual_us += 250000;
+        scheduler.advance(25);
+        scheduler.runPending();
+
+        const RateGroup_t* sensor = scheduler.getGroup(0);
+        const RateGroup_t* comms = scheduler.getGroup(1);
+        expect("sensor runs after stall", 6, sensor->runs);
+        expect("sensor overruns", 1, sensor->overruns);
+        expect("sensor skipped", 24, sensor->skipped);
+        expect("comms runs after stall", 1, comms->runs);
+        expect("comms skipped", 2, comms->skipped);
+        expect("loop overruns", 1, scheduler.getLoopOverruns());
+        expect("missed ticks", 24, scheduler.getMissedTicks());
+
+        // Grid is preserved after the stall
+        runVirtual(scheduler, 70);
+        expect("comms runs after recovery", 8, comms->runs);
+        expect("off-grid runs", 0, off_grid);
+        scheduler.stop();
+    }
+    Serial.println();
+
+    // Test 3: Effective rate vs. "work + delay(10)"
+    Serial.println("TEST 3: Effective Sample Rate");
+    Serial.println("------------------------------");
+    {
+        const uint32_t work_cases[] = {0, 1500, 3000, 6000, 9000};
+        for (uint8_t c = 0; c < sizeof(work_cases) / sizeof(work_cases[0]); c++) {
+            resetCounters();
+            work_us = work_cases[c];
+            Rate_Scheduler scheduler(BASE_PERIOD_US, virtualClock);
+            setupGroups(scheduler);
+            scheduler.begin();
+
+            // Ticks arrive on the absolute grid; work only consumes time inside a tick
+            uint32_t next_tick_us = BASE_PERIOD_US;
+            while (virtual_us < 10000000UL) {
+                if (virtual_us < next_tick_us) virtual_us = next_tick_us;
+                while (next_tick_us <= virtual_us) {
+                    scheduler.advance(1);
+                    next_tick_us += BASE_PERIOD_US;
+                }
+                scheduler.runPending();
+            }
+
+            // Old loop: period = work + 10 ms
+            float old_hz = 1000000.0f / (BASE_PERIOD_US + work_us);
+            float new_hz = sensor_runs / 10.0f;
+
+            Serial.print("work ");
+            Serial.print(work_us);
+            Serial.print(" us: delay loop ");
+            Serial.print(old_hz, 1);
+            Serial.print(" Hz, scheduler ");
+            Serial.print(new_hz, 1);
+            Serial.println(" Hz");
+
+            expect("scheduler sensor runs in 10 s", 1000, sensor_runs);
+            scheduler.stop();
+        }
+    }
+    Serial.println();
+
+#ifdef ARDUINO
+    // Test 4: Real esp_timer tick
+    Serial.println("TEST 4: Hardware Timer Rate");
+    Serial.println("----------------------------");
+    {
+        resetCounters();
+        work_us = 0;
+        Rate_Scheduler scheduler(BASE_PERIOD_US);
+        setupGroups(scheduler);
+        scheduler.begin();
+
+        uint32_t start = millis();
+        while (millis() - start < REAL_RUN_MS) {
+            scheduler.waitForTick();
+            scheduler.runPending();
+        }
+        scheduler.stop();
+
+        Serial.print("Sensor runs in ");
+        Serial.print(REAL_RUN_MS);
+        Serial.print(" ms: ");
+        Serial.println(sensor_runs);
+        Serial.print("Max wake latency: ");
+        Serial.print(scheduler.getMaxWakeLatency());
+        Serial.println(" us");
+        scheduler.printStats();
+
+        // Allow one tick of slack at either end of the window
+        uint32_t expected = REAL_RUN_MS * 1000UL / BASE_PERIOD_US;
+        if (sensor_runs + 1 >= expected && sensor_runs <= expected + 1) {
+            passed++;
+            Serial.println("✓ Timer rate within one tick of nominal");
+        } else {
+            failed++;
+            Serial.println("✗ Timer rate off nominal");
+        }
+    }
+    Serial.println();
+#endif
+
+    Serial.print("Passed: ");
+    Serial.print(passed);
+    Serial.print("  Failed: ");
+    Serial.println(failed);
+
+    Serial.println("========================================");
+    Serial.println(failed == 0 ? "      ALL TESTS PASSED" : "      TESTS FAILED");
+    Serial.println("========================================");
+}
+
+void loop() {
+    delay(1000);
+}
@@ -0,0 +1,327 @@
+#include "Deferred_Log.h"
+
+static_assert((DEFERRED_LOG_RING_SIZE & (DEFERRED_LOG_RING_SIZE - 1)) == 0,
+              "DEFERRED_LOG_RING_SIZE must be a power of two");
+
+#define DLOG_RING_MASK  (DEFERRED_LOG_RING_SIZE - 1)
+
+DlogRecord_t Deferred_Log::ring[DEFERRED_LOG_RING_SIZE];
+uint32_t Deferred_Log::head = 0;
+uint32_t Deferred_Log::tail = 0;
+DlogStats_t Deferred_Log::stats = {};
+#ifdef ARDUINO
+TaskHandle_t Deferred_Log::task = nullptr;
+#endif
+
+void Deferred_Log::begin() {
+    memset(ring, 0, sizeof(ring));
+    head = 0;
+    tail = 0;
+    memset(&stats, 0, sizeof(stats));
+
+#ifdef ARDUINO
+    if (task == nullptr &&
+        xTaskCreate(taskEntry, "dlog", DEFERRED_LOG_TASK_STACK, nullptr,
+                    DEFERRED_LOG_TASK_PRIORITY, &task) != pdPASS) {
+        Serial.println("[Log] ERROR: Failed to create drain task!");
+    }
+#endif
+}
+
+/*
+ * Bounded multi-producer ring (after Vyukov). A slot's sequence is kept
+ * relative to its index, so the zeroed ring is valid before begin():
+ * free for the producer at position p when it equals p & ~mask, ready for
+ * the reader at + 1, and free again for the next lap at + RING_SIZE.
+ */
+bool Deferred_Log::write(DlogMessage_t message, const uint32_t* args, uint8_t count) {
+    uint32_t position = __atomic_load_n(&head, __ATOMIC_RELAXED);
+    DlogRecord_t* slot;
+
+    for (;;) {
+        slot = &ring[position & DLOG_RING_MASK];
+        uint32_t sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+        int32_t lag = (int32_t)(sequence - (position & ~DLOG_RING_MASK));
+
+        if (lag == 0) {
+            // On failure position is reloaded with the current head
+            if (__atomic_compare_exchange_n(&head, &position, position + 1, true,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (lag < 0) {
+            // The reader has not freed this slot from the last lap
+            __atomic_fetch_add(&stats.dropped, 1, __ATOMIC_RELAXED);
+            return false;
+        } else {
+            position = __atomic_load_n(&head, __ATOMIC_RELAXED);
+        }
+    }
+
+    slot->timestamp_us = micros();
+    slot->message = message;
+    slot->arg_count = count;
+    for (uint8_t i = 0; i < count; i++) {
+        slot->args[i] = args[i];
+    }
+    __atomic_store_n(&slot->sequence, (position & ~DLOG_RING_MASK) + 1, __ATOMIC_RELEASE);
+    __atomic_fetch_add(&stats.logged, 1, __ATOMIC_RELAXED);
+    return true;
+}
+
+bool Deferred_Log::read(DlogRecord_t& record) {
+    DlogRecord_t& slot = ring[tail & DLOG_RING_MASK];
+    uint32_t lap = tail & ~DLOG_RING_MASK;
+    if (__atomic_load_n(&slot.sequence, __ATOMIC_ACQUIRE) != lap + 1) {
+        return false;
+    }
+
+    record = slot;
+    __atomic_store_n(&slot.sequence, lap + DEFERRED_LOG_RING_SIZE, __ATOMIC_RELEASE);
+    tail++;
+    return true;
+}
+
+uint16_t Deferred_Log::drain(uint16_t max_records) {
+    uint32_t backlog = __atomic_load_n(&head, __ATOMIC_RELAXED) - tail;
+    if (backlog > stats.max_backlog) stats.max_backlog = backlog;
+
+    DlogRecord_t record;
+    uint16_t count = 0;
+    while (count < max_records && read(record)) {
+        if (DEFERRED_LOG_BINARY) {
+            uint8_t frame[DLOG_FRAME_MAX_SIZE];
+            Serial.write(frame, encodeFrame(record, frame));
+        } else {
+            char text[DLOG_TEXT_MAX_LENGTH];
+            format(record, text, sizeof(text));
+            Serial.println(text);
+        }
+        stats.written++;
+        count++;
+    }
+    return count;
+}
+
+const char* Deferred_Log::getFormat(uint16_t message) {
+    switch (message) {
+        case DLOG_STAGE1_FREEFALL:        return "STAGE 1: Free fall detected!";
+        case DLOG_STAGE2_IMPACT:          return "STAGE 2: Impact detected!";
+        case DLOG_STAGE3_ROTATION:        return "STAGE 3: Rotation detected!";
+        case DLOG_STAGE4_INACTIVITY:      return "STAGE 4: Inactivity detected!";
+        case DLOG_POTENTIAL_FALL:         return "POTENTIAL FALL: All stages completed!";
+        case DLOG_USER_RECOVERED:         return "User recovered - resetting detection";
+        case DLOG_STAGE1_SCORE:           return "Stage 1 Score: %u/25 (Duration: %u, Magnitude: %u)";
+        case DLOG_STAGE2_SCORE:           return "Stage 2 Score: %u/25 (Impact: %u, Timing: %u, FSR: %u)";
+        case DLOG_STAGE3_SCORE:           return "Stage 3 Score: %u/20 (Angular: %u, Orientation: %u)";
+        case DLOG_STAGE4_SCORE:           return "Stage 4 Score: %u/20 (Duration: %u, Stability: %u)";
+        case DLOG_CLASSIFIER_SCORE:       return "Classifier Score: %u/15 (Probability: %u%%)";
+        case DLOG_CLASSIFIER_RESULT:      return "Classifier: %u%% fall";
+        case DLOG_EMERGENCY_SENDING:
+            return "\n!!! SENDING EMERGENCY ALERT !!!\nConfidence Score: %u/%u\nSOS Triggered: %{NO|YES}";
+        case DLOG_EMERGENCY_DELIVERED:    return "[Emergency] ✓ Delivered via %{wifi|ble} in %u ms";
+        case DLOG_EMERGENCY_UNCONFIRMED:  return "[Emergency] ✗ No transport confirmed the alert";
+        case DLOG_EMERGENCY_QUEUED:       return "[Emergency] Queued for retry (%u/%u)";
+        case DLOG_EMERGENCY_RETRY:        return "[Emergency] Retry attempt %u/%u";
+        case DLOG_EMERGENCY_RETRY_OK:     return "[Emergency] ✓ Retry successful!";
+        case DLOG_EMERGENCY_RETRY_FAILED: return "[Emergency] ✗ Max retries reached, alert failed";
+        case DLOG_EMERGENCY_LATE_ACK:     return "[Emergency] ✓ Late confirmation, retry cancelled";
+        case DLOG_EMERGENCY_STATUS:
+            return "[Emergency] Alert status: "
+                   "%{Pending|Sending|Sent via WiFi|Sent via BLE|Sent via Both|Failed|Retrying}";
+        case DLOG_DETECTION_TIMEOUT:      return "Detection timeout - resetting to monitoring";
+        case DLOG_FALL_DETECTED:
+            return "\n!!! FALL DETECTED !!!\nConfidence Score: %u/%u\n"
+                   "%{CONFIRMED FALL - Delayed Alert|HIGH CONFIDENCE FALL - Immediate Alert}";
+        case DLOG_FALL_STAGES:
+            return "=== Fall Detection Stage Details ===\nFree Fall Duration: %.0f ms\n"
+                   "Max Impact: %.2f g%{| (clipped)}\nMax Rotation: %.2f °/s";
+        case DLOG_SCORE_STAGES:
+            return "=== Confidence Score Breakdown ===\nStage 1 (Free Fall): %u/25\n"
+                   "Stage 2 (Impact): %u/25\nStage 3 (Rotation): %u/20\nStage 4 (Inactivity): %u/20";
+        case DLOG_SCORE_FILTERS:          return "Filters: %u/15\nClassifier: %u/15";
+        case DLOG_SCORE_TOTAL:
+            return "TOTAL SCORE: %u/%u - %{NO_FALL|SUSPICIOUS|POTENTIAL|CONFIRMED|HIGH}";
+        case DLOG_SCORE_RESCALED:         return "Rescaled from %u/%u (sensors down)";
+        case DLOG_FALL_COUNTDOWN:
+            return "\n--- Countdown: Press SOS to confirm, get up or cancel in the app ---";
+        default:                          return nullptr;
+    }
+}
+
+size_t Deferred_Log::format(const DlogRecord_t& record, char* buffer, size_t capacity) {
+    if (capacity == 0) return 0;
+
+    const char* spec = getFormat(record.message);
+    if (spec == nullptr) {
+        // A newer firmware's message: keep what can be kept
+        int length = snprintf(buffer, capacity, "[Log] message %u (%u args)",
+                              (unsigned)record.message, (unsigned)record.arg_count);
+        return length < 0 ? 0 : ((size_t)length < capacity ? (size_t)length : capacity - 1);
+    }
+
+    size_t length = 0;
+    uint8_t next_arg = 0;
+    while (*spec != '\0' && length + 1 < capacity) {
+        if (*spec != '%') {
+            buffer[length++] = *spec++;
+            continue;
+        }
+        spec++;
+        if (*spec == '%') {
+            buffer[length++] = '%';
+            spec++;
+            continue;
+        }
+
+        uint32_t value = next_arg < record.arg_count ? record.args[next_arg] : 0;
+        next_arg++;
+
+        int precision = 2;                  // Serial.print(float) default
+        if (*spec == '.') {
+            spec++;
+            precision = 0;
+            while (*spec >= '0' && *spec <= '9') {
+                precision = precision * 10 + (*spec++ - '0');
+            }
+        }
+
+        char piece[48];
+        piece[0] = '\0';
+        switch (*spec) {
+            case 'd':
+                snprintf(piece, sizeof(piece), "%ld", (long)(int32_t)value);
+                break;
+            case 'u':
+                snprintf(piece, sizeof(piece), "%lu", (unsigned long)value);
+                break;
+            case 'x':
+                snprintf(piece, sizeof(piece), "%lX", (unsigned long)value);
+                break;
+            case 'f': {
+                float number;
+                memcpy(&number, &value, sizeof(number));
+                snprintf(piece, sizeof(piece), "%.*f", precision, (double)number);
+                break;
+            }
+            case '{': {
+                // Copy word number `value` of "{a|b|c}"
+                const char* word = spec + 1;
+                for (uint32_t i = 0; i < value && *word != '}' && *word != '\0'; word++) {
+                    if (*word == '|') i++;
+                }
+                size_t n = 0;
+                while (word[n] != '|' && word[n] != '}' && word[n] != '\0' && n + 1 < sizeof(piece)) {
+                    piece[n] = word[n];
+                    n++;
+                }
+                piece[n] = '\0';
+                if (n == 0 || *word == '}') strcpy(piece, "?");
+
+                while (*spec != '}' && *spec != '\0') spec++;
+                break;
+            }
+            default:
+                strcpy(piece, "?");
+                break;
+        }
+        if (*spec != '\0') spec++;
+
+        for (const char* p = piece; *p != '\0' && length + 1 < capacity; p++) {
+            buffer[length++] = *p;
+        }
+    }
+
+    buffer[length] = '\0';
+    return length;
+}
+
+size_t Deferred_Log::encodeFrame(const DlogRecord_t& record, uint8_t* frame) {
+    uint8_t count = record.arg_count > DLOG_MAX_ARGS ? DLOG_MAX_ARGS : record.arg_count;
+    size_t length = 0;
+
+    frame[length++] = DLOG_FRAME_SYNC_0;
+    frame[length++] = DLOG_FRAME_SYNC_1;
+    frame[length++] = record.message & 0xFF;
+    frame[length++] = record.message >> 8;
+    frame[length++] = count;
+    for (uint8_t b = 0; b < 4; b++) {
+        frame[length++] = (record.timestamp_us >> (8 * b)) & 0xFF;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        for (uint8_t b = 0; b < 4; b++) {
+            frame[length++] = (record.args[i] >> (8 * b)) & 0xFF;
+        }
+    }
+    frame[length] = checksum(frame + 2, length - 2);
+    return length + 1;
+}
+
+size_t Deferred_Log::decodeFrame(const uint8_t* data, size_t length, DlogRecord_t& record) {
+    if (length < DLOG_FRAME_HEADER_SIZE + 1) return 0;
+    if (data[0] != DLOG_FRAME_SYNC_0 || data[1] != DLOG_FRAME_SYNC_1) return 0;
+
+    uint8_t count = data[4];
+    size_t size = DLOG_FRAME_HEADER_SIZE + 4 * count + 1;
+    if (count > DLOG_MAX_ARGS || length < size) return 0;
+    if (checksum(data + 2, size - 3) != data[size - 1]) return 0;
+
+    memset(&record, 0, sizeof(record));
+    record.message = data[2] | (data[3] << 8);
+    record.arg_count = count;
+    for (uint8_t b = 0; b < 4; b++) {
+        record.timestamp_us |= (uint32_t)data[5 + b] << (8 * b);
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        for (uint8_t b = 0; b < 4; b++) {
+            record.args[i] |= (uint32_t)data[DLOG_FRAME_HEADER_SIZE + 4 * i + b] << (8 * b);
+        }
+    }
+    return size;
+}
+
+DlogStats_t Deferred_Log::getStats() {
+    DlogStats_t copy;
+    copy.logged = __atomic_load_n(&stats.logged, __ATOMIC_RELAXED);
+    copy.dropped = __atomic_load_n(&stats.dropped, __ATOMIC_RELAXED);
+    copy.written = stats.written;
+    copy.max_backlog = stats.max_backlog;
+    return copy;
+}
+
+void Deferred_Log::printStats() {
+    DlogStats_t current = getStats();
+    Serial.println("=== Deferred Log ===");
+    Serial.print("Logged: ");
+    Serial.print(current.logged);
+    Serial.print(" | Written: ");
+    Serial.print(current.written);
+    Serial.print(" | Dropped (ring full): ");
+    Serial.println(current.dropped);
+    Serial.print("Max backlog: ");
+    Serial.print(current.max_backlog);
+    Serial.print("/");
+    Serial.println(DEFERRED_LOG_RING_SIZE);
+    Serial.println("====================");
+}
+
+// Private helper functions
+
+// One's complement of the byte sum over id, count, timestamp and args
+uint8_t Deferred_Log::checksum(const uint8_t* data, size_t length) {
+    uint8_t sum = 0;
+    for (size_t i = 0; i < length; i++) {
+        sum += data[i];
+    }
+    return (uint8_t)~sum;
+}
+
+#ifdef ARDUINO
+void Deferred_Log::taskEntry(void* arg) {
+    TickType_t wake = xTaskGetTickCount();
+    for (;;) {
+        vTaskDelayUntil(&wake, pdMS_TO_TICKS(DEFERRED_LOG_INTERVAL_MS));
+        drain();
+    }
+}
+#endif
@@ -0,0 +1,340 @@
+/*
+ * SmartFall - Confidence Score Tier Test
+ *
+ * Checks the table-driven ConfidenceScorer against the if-ladders it
+ * replaced, then times the generic tier lookup against those ladders.
+ *
+ * Hardware: ESP32 HUZZAH32 Feather (no sensors required)
+ *
+ * This test verifies:
+ * - Every metric scores exactly as the old ladder at, just above and just
+ *   below each breakpoint, across a dense sweep, and for NaN and infinities
+ * - Whole-sequence stage and total scores match the old scorer
+ * - Overrides take effect and out-of-order tables are refused
+ * - A full scoring pass (ten lookups) stays far inside one sensor period
+ */
+
+#include "confidence_scorer.h"
+
+#define SWEEP_STEPS         20000
+#define RANDOM_SEQUENCES    5000
+#define TIMING_VALUES       256
+#define TIMING_ROUNDS       200
+
+int passed = 0;
+int failed = 0;
+
+void expect(const char* name, uint32_t expected, uint32_t actual) {
+    if (expected == actual) {
+        passed++;
+        Serial.print("✓ ");
+    } else {
+        failed++;
+        Serial.print("✗ ");
+    }
+    Serial.print(name);
+    Serial.print(": expected ");
+    Serial.print(expected);
+    Serial.print(", got ");
+    Serial.println(actual);
+}
+
+void expectTrue(const char* name, bool condition) {
+    expect(name, 1, condition ? 1 : 0);
+}
+
+// The if-ladders ConfidenceScorer used before DEFAULT_SCORE_TIERS
+uint8_t ladderScore(uint8_t metric, float value) {
+    switch (metric) {
+        case SCORE_FREEFALL_DURATION:
+            if (value >= 500.0f) return 15;
+            if (value >= 200.0f) return 10;
+            if (value >= 100.0f) return 5;
+            return 0;
+        case SCORE_FREEFALL_DEPTH:
+            if (value <= 0.1f) return 10;
+            if (value <= 0.3f) return 8;
+            if (value <= 0.5f) return 5;
+            return 0;
+        case SCORE_IMPACT:
+            if (value >= 6.0f) return 15;
+            if (value >= 4.0f) return 12;
+            if (value >= 3.0f) return 8;
+            return 0;
+        case SCORE_IMPACT_TIMING:
+            if (value <= 500.0f) return 5;
+            if (value <= 1000.0f) return 3;
+            return 0;
+        case SCORE_ROTATION:
+            if (value >= 600.0f) return 15;
+            if (value >= 400.0f) return 12;
+            if (value >= 250.0f) return 8;
+            return 0;
+        case SCORE_ORIENTATION:
+            if (value >= 90.0f) return 5;
+            if (value >= 45.0f) return 3;
+            return 0;
+        case SCORE_INACTIVITY:
+            if (value >= 10000.0f) return 15;
+            if (value >= 5000.0f) return 12;
+            if (value >= 2000.0f) return 8;
+            return 0;
+        case SCORE_PRESSURE:
+            if (value >= 2.0f) return 5;
+            if (value >= 1.0f) return 3;
+            if (value >= 0.5f) return 2;
+            return 0;
+        case SCORE_HEART_RATE:
+            value = abs(value);
+            if (value >= 30.0f) return 5;
+            if (value >= 10.0f) return 3;
+            if (value >= 2.0f) return 2;
+            return 0;
+        case SCORE_CLASSIFIER:
+            if (value >= 90.0f) return 15;
+            if (value >= 75.0f) return 10;
+            if (value >= 50.0f) return 5;
+            return 0;
+        default:
+            return 0;
+    }
+}
+
+uint8_t tableScore(const ScoreTiers_t& tiers, uint8_t metric, float value) {
+    if (metric == SCORE_HEART_RATE) value = fabsf(value);
+    return scoreTier(tiers.tables[metric], value);
+}
+
+// Returns the number of values that score differently
+uint32_t compareAt(uint8_t metric, const float* values, uint32_t count) {
+    uint32_t mismatches = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (tableScore(DEFAULT_SCORE_TIERS, metric, values[i]) != ladderScore(metric, values[i])) {
+            mismatches++;
+            Serial.print("  mismatch at ");
+            Serial.println(values[i], 6);
+        }
+    }
+    return mismatches;
+}
+
+uint32_t random_state = 12345;
+
+float randomUnit() {
+    random_state = random_state * 1664525UL + 1013904223UL;
+    return (random_state >> 8) / 16777216.0f;
+}
+
+// Scores one synthetic sequence and returns the per-stage results
+void scoreSequence(ConfidenceScorer& scorer, const float* in, uint8_t* stages) {
+    scorer.resetScore();
+    scorer.startScoring();
+    scorer.addStage1Score(in[0], in[1]);
+    scorer.addStage2Score(in[2], in[3], in[9] > 0.5f);
+    scorer.addStage3Score(in[4], in[5]);
+    scorer.addStage4Score(in[6], in[10] > 0.5f);
+    scorer.addPressureFilterScore(in[7]);
+    scorer.addHeartRateFilterScore(in[8]);
+    scorer.addFSRFilterScore(in[9] > 0.5f, in[10] > 0.3f);
+    scorer.addClassifierScore((uint8_t)in[11]);
+    scorer.getScoreBreakdown(stages[0], stages[1], stages[2], stages[3], stages[4]);
+}
+
+uint8_t cap(uint32_t score, uint8_t max_score) {
+    return score > max_score ? max_score : score;
+}
+
+// The same sequence through the old ladders and stage caps
+void ladderSequence(const float* in, uint8_t* stages) {
+    bool strike = in[9] > 0.5f;
+    stages[0] = cap(ladderScore(SCORE_FREEFALL_DURATION, in[0]) + ladderScore(SCORE_FREEFALL_DEPTH, in[1]), 25);
+    stages[1] = cap(ladderScore(SCORE_IMPACT, in[2]) + ladderScore(SCORE_IMPACT_TIMING, in[3]) + (strike ? 7 : 0), 25);
+    stages[2] = cap(ladderScore(SCORE_ROTATION, in[4]) + ladderScore(SCORE_ORIENTATION, in[5]), 20);
+    stages[3] = cap(ladderScore(SCORE_INACTIVITY, in[6]) + (in[10] > 0.5f ? 5 : 0), 20);
+    stages[4] = cap(ladderScore(SCORE_PRESSURE, in[7]) + ladderScore(SCORE_HEART_RATE, in[8]) +
+                        (in[10] > 0.3f ? 2 : 0) + (strike ? 3 : 0), 15);
+}
+
+// Spans each metric's interesting range, a little past the loosest tier
+const float SWEEP_LOW[SCORE_METRIC_COUNT] = {-50, -0.2f, -1, -100, -100, -10, -1000, -1, -60, -10};
+const float SWEEP_HIGH[SCORE_METRIC_COUNT] = {1000, 1.5f, 12, 2000, 1200, 180, 20000, 4, 60, 110};
+const char* METRIC_NAMES[SCORE_METRIC_COUNT] = {
+    "free fall duration", "free fall depth", "impact", "impact timing", "rotation",
+    "orientation", "inactivity", "pressure", "heart rate", "classifier"
+};
+
+void setup() {
+    Serial.begin(115200);
+    delay(2000);
+
+    Serial.println("\n========================================");
+    Serial.println("   SmartFall Confidence Score Tier Test");
+    Serial.println("========================================\n");
+
+    // Test 1: Breakpoint edges
+    Serial.println("TEST 1: Parity at Breakpoints");
+    Serial.println("------------------------------");
+    for (uint8_t m = 0; m < SCORE_METRIC_COUNT; m++) {
+        const ScoreTable_t& table = DEFAULT_SCORE_TIERS.tables[m];
+        float values[SCORE_TIER_MAX * 6 + 6];
+        uint32_t count = 0;
+        for (uint8_t i = 0; i < table.count; i++) {
+            float b = table.tiers[i].breakpoint;
+            values[count++] = b;
+            values[count++] = nextafterf(b, INFINITY);
+            values[count++] = nextafterf(b, -INFINITY);
+            values[count++] = -b;
+            values[count++] = nextafterf(-b, INFINITY);
+            values[count++] = nextafterf(-b, -INFINITY);
+        }
+        values[count++] = 0.0f;
+        values[count++] = -0.0f;
+        values[count++] = INFINITY;
+        values[count++] = -INFINITY;
+        values[count++] = NAN;
+        values[count++] = 1e9f;
+        expect(METRIC_NAMES[m], 0, compareAt(m, values, count));
+    }
+    Serial.println();
+
+    // Test 2: Dense sweep
+    Serial.println("TEST 2: Parity Sweep");
+    Serial.println("---------------------");
+    for (uint8_t m = 0; m < SCORE_METRIC_COUNT; m++) {
+        uint32_t mismatches = 0;
+        float step = (SWEEP_HIGH[m] - SWEEP_LOW[m]) / SWEEP_STEPS;
+        for (uint32_t i = 0; i <= SWEEP_STEPS; i++) {
+            float value = SWEEP_LOW[m] + i * step;
+            mismatches += compareAt(m, &value, 1);
+        }
+        expect(METRIC_NAMES[m], 0, mismatches);
+    }
+    Serial.println();
+
+    // Test 3: Whole sequences through ConfidenceScorer
+    Serial.println("TEST 3: Scorer Parity");
+    Serial.println("----------------------");
+    {
+        ConfidenceScorer scorer;
+        uint32_t stage_mismatches = 0;
+        uint32_t total_mismatches = 0;
+        for (uint32_t n = 0; n < RANDOM_SEQUENCES; n++) {
+            float in[12];
+            for (uint8_t m = 0; m < SCORE_HEART_RATE + 1; m++) {
+                in[m] = SWEEP_LOW[m] + randomUnit() * (SWEEP_HIGH[m] - SWEEP_LOW[m]);
+            }
+            in[9] = randomUnit();
+            in[10] = randomUnit();
+            in[11] = (float)(uint8_t)(randomUnit() * 101.0f);     // Classifier probability, %
+
+            uint8_t got[5], want[5];
+            scoreSequence(scorer, in, got);
+            ladderSequence(in, want);
+            if (memcmp(got, want, sizeof(got)) != 0) stage_mismatches++;
+            uint32_t classifier = ladderScore(SCORE_CLASSIFIER, in[11]);
+            if (scorer.getTotalScore() != want[0] + want[1] + want[2] + want[3] + want[4] + classifier) {
+                total_mismatches++;
+            }
+        }
+        expect("stage score mismatches", 0, stage_mismatches);
+        expect("total score mismatches", 0, total_mismatches);
+    }
+    Serial.println();
+
+    // Test 4: Runtime override
+    Serial.println("TEST 4: Overrides");
+    Serial.println("------------------");
+    {
+        ConfidenceScorer scorer;
+        ScoreTiers_t tiers = DEFAULT_SCORE_TIERS;
+        tiers.tables[SCORE_IMPACT] = {4, false, {{7.0f, 15}, {5.0f, 12}, {3.5f, 8}, {2.5f, 4}}};
+        expectTrue("valid override accepted", scorer.setScoreTiers(tiers));
+
+        uint8_t stages[5];
+        const float in[12] = {0, 1, 2.6f, 5000, 0, 0, 0, 0, 0, 0, 0, 0};
+        scoreSequence(scorer, in, stages);
+        expect("2.6 g impact scores new tier", 4, stages[1]);
+
+        tiers.tables[SCORE_IMPACT].tiers[1].breakpoint = 8.0f;
+        expectTrue("out-of-order table refused", !scorer.setScoreTiers(tiers));
+        tiers = DEFAULT_SCORE_TIERS;
+        tiers.tables[SCORE_ROTATION].count = SCORE_TIER_MAX + 1;
+        expectTrue("too many tiers refused", !scorer.setScoreTiers(tiers));
+        expectTrue("previous override kept", scorer.getScoreTiers().tables[SCORE_IMPACT].count == 4);
+
+        // Direction of an at-most table follows the flag, not the data
+        ScoreTable_t timing = {1, true, {{800.0f, 5}}};
+        expect("700 ms within at-most tier", 5, scoreTier(timing, 700.0f));
+        expect("900 ms outside at-most tier", 0, scoreTier(timing, 900.0f));
+        ScoreTable_t empty = {0, false, {}};
+        expect("empty table scores 0", 0, scoreTier(empty, 1e6f));
+    }
+    Serial.println();
+
+    // Test 5: Lookup time
+    Serial.println("TEST 5: Lookup Time");
+    Serial.println("--------------------");
+    {
+        float values[SCORE_METRIC_COUNT][TIMING_VALUES];
+        for (uint8_t m = 0; m < SCORE_METRIC_COUNT; m++) {
+            for (uint32_t i = 0; i < TIMING_VALUES; i++) {
+                values[m][i] = SWEEP_LOW[m] + randomUnit() * (SWEEP_HIGH[m] - SWEEP_LOW[m]);
+            }
+        }
+
+        // Random inputs defeat the branch predictor, as real detections would
+        volatile uint32_t sink = 0;
+        uint32_t start = micros();
+        for (uint32_t r = 0; r < TIMING_ROUNDS; r++) {
+            uint32_t sum = 0;
+            for (uint32_t i = 0; i < TIMING_VALUES; i++) {
+                for (uint8_t m = 0; m < SCORE_METRIC_COUNT; m++) {
+                    sum += ladderScore(m, values[m][i]);
+                }
+            }
+            sink += sum;
+        }
+        uint32_t ladder_us = micros() - start;
+
+        start = micros();
+        for (uint32_t r = 0; r < TIMING_ROUNDS; r++) {
+            uint32_t sum = 0;
+            for (uint32_t i = 0; i < TIMING_VALUES; i++) {
+                for (uint8_t m = 0; m < SCORE_METRIC_COUNT; m++) {
+                    sum += tableScore(DEFAULT_SCORE_TIERS, m, values[m][i]);
+                }
+            }
+            sink += sum;
+        }
+        uint32_t table_us = micros() - start;
+
+        float lookups = (float)TIMING_ROUNDS * TIMING_VALUES * SCORE_METRIC_COUNT;
+        Serial.print("If-ladder:    ");
+        Serial.print(ladder_us * 1000.0f / lookups, 1);
+        Serial.println(" ns/lookup");
+        Serial.print("Tier table:   ");
+        Serial.print(table_us * 1000.0f / lookups, 1);
+        Serial.println(" ns/lookup");
+        Serial.print("(checksum ");
+        Serial.print(sink);
+        Serial.println(")");
+
+        // A whole detection is scored once; it must not eat into a sample period
+        float pass_us = table_us * SCORE_METRIC_COUNT / lookups;
+        expectTrue("scoring pass < 50 us", pass_us < 50.0f);
+    }
+    Serial.println();
+
+    Serial.print("Passed: ");
+    Serial.print(passed);
+    Serial.print("  Failed: ");
+    Serial.println(failed);
+
+    Serial.println("========================================");
+    Serial.println(failed == 0 ? "      ALL TESTS PASSED" : "      TESTS FAILED");
+    Serial.println("========================================");
+}
+
+void loop() {
+    delay(1000);
+}
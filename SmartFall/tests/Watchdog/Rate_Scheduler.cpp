@@ -0,0 +1,257 @@
+#include "Rate_Scheduler.h"
+
+uint32_t schedulerMicros() {
+    return (uint32_t)micros();
+}
+
+Rate_Scheduler::Rate_Scheduler(uint32_t base_period, SchedulerClock_t clock)
+    : base_period_us(base_period ? base_period : 1), group_count(0), running(false),
+      pending_ticks(0), last_tick_us(0), tick_count(0),
+      loop_overruns(0), missed_ticks(0), max_wake_latency_us(0),
+      clock_us(clock) {
+    memset(groups, 0, sizeof(groups));
+#ifdef ARDUINO
+    timer = nullptr;
+    waiting_task = nullptr;
+    tick_mux = portMUX_INITIALIZER_UNLOCKED;
+#endif
+}
+
+Rate_Scheduler::~Rate_Scheduler() {
+    stop();
+}
+
+int8_t Rate_Scheduler::addGroup(const char* name, uint32_t period_ms, RateTask_t task) {
+    if (group_count >= SCHEDULER_MAX_GROUPS || task == nullptr) {
+        return -1;
+    }
+
+    uint32_t period_ticks = (period_ms * 1000UL) / base_period_us;
+    if (period_ticks == 0) period_ticks = 1;
+
+    RateGroup_t& group = groups[group_count];
+    memset(&group, 0, sizeof(group));
+    group.name = name;
+    group.task = task;
+    group.period_ticks = period_ticks;
+    group.enabled = true;
+
+    return (int8_t)group_count++;
+}
+
+void Rate_Scheduler::enableGroup(uint8_t index, bool enable) {
+    if (index < group_count) {
+        groups[index].enabled = enable;
+    }
+}
+
+bool Rate_Scheduler::begin() {
+    if (running) return true;
+
+    tick_count = 0;
+    pending_ticks = 0;
+    last_tick_us = clock_us ? clock_us() : 0;
+
+#ifdef ARDUINO
+    waiting_task = xTaskGetCurrentTaskHandle();
+
+    esp_timer_create_args_t args = {};
+    args.callback = &Rate_Scheduler::onTimer;
+    args.arg = this;
+    args.dispatch_method = ESP_TIMER_TASK;
+    args.name = "rate_sched";
+
+    if (esp_timer_create(&args, &timer) != ESP_OK) {
+        Serial.println("[Scheduler] ERROR: Failed to create tick timer!");
+        return false;
+    }
+
+    if (esp_timer_start_periodic(timer, base_period_us) != ESP_OK) {
+        Serial.println("[Scheduler] ERROR: Failed to start tick timer!");
+        esp_timer_delete(timer);
+        timer = nullptr;
+        return false;
+    }
+#endif
+
+    running = true;
+    Serial.print("[Scheduler] Started with ");
+    Serial.print(group_count);
+    Serial.print(" rate groups, base tick ");
+    Serial.print(base_period_us);
+    Serial.println(" us");
+    return true;
+}
+
+void Rate_Scheduler::stop() {
+#ifdef ARDUINO
+    if (timer != nullptr) {
+        esp_timer_stop(timer);
+        esp_timer_delete(timer);
+        timer = nullptr;
+    }
+#endif
+    running = false;
+}
+
+bool Rate_Scheduler::waitForTick(uint32_t timeout_ms) {
+#ifdef ARDUINO
+    if (!running) {
+        // Timer unavailable: fall back to sleeping one base period
+        delay(base_period_us / 1000);
+        advance(1);
+        return true;
+    }
+
+    if (pending_ticks == 0) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(timeout_ms));
+    }
+#endif
+    return pending_ticks > 0;
+}
+
+uint8_t Rate_Scheduler::runPending() {
+    uint32_t ticks = takePendingTicks();
+    if (ticks == 0) return 0;
+
+    if (clock_us) {
+        uint32_t latency = clock_us() - last_tick_us;
+        if (latency > max_wake_latency_us) max_wake_latency_us = latency;
+    }
+
+    if (ticks > 1) {
+        loop_overruns++;
+        missed_ticks += ticks - 1;
+    }
+
+    uint32_t previous = tick_count;
+    tick_count += ticks;
+
+    uint8_t ran = 0;
+    for (uint8_t i = 0; i < group_count; i++) {
+        RateGroup_t& group = groups[i];
+        if (!group.enabled) continue;
+
+        // Period boundaries crossed by the ticks consumed in this pass
+        uint32_t boundaries = tick_count / group.period_ticks - previous / group.period_ticks;
+        if (boundaries == 0) continue;
+
+        if (boundaries > 1) {
+            group.overruns++;
+            group.skipped += boundaries - 1;
+        }
+
+        uint32_t start = clock_us ? clock_us() : 0;
+        group.task();
+        uint32_t exec = clock_us ? clock_us() - start : 0;
+
+        group.runs++;
+        group.last_exec_us = exec;
+        if (exec > group.max_exec_us) group.max_exec_us = exec;
+        ran++;
+    }
+
+    return ran;
+}
+
+void Rate_Scheduler::advance(uint32_t ticks) {
+#ifdef ARDUINO
+    portENTER_CRITICAL(&tick_mux);
+#endif
+    pending_ticks += ticks;
+    last_tick_us = clock_us ? clock_us() : 0;
+#ifdef ARDUINO
+    portEXIT_CRITICAL(&tick_mux);
+#endif
+}
+
+const RateGroup_t* Rate_Scheduler::getGroup(uint8_t index) {
+    return index < group_count ? &groups[index] : nullptr;
+}
+
+uint8_t Rate_Scheduler::getGroupCount() {
+    return group_count;
+}
+
+uint32_t Rate_Scheduler::getTickCount() {
+    return tick_count;
+}
+
+uint32_t Rate_Scheduler::getLoopOverruns() {
+    return loop_overruns;
+}
+
+uint32_t Rate_Scheduler::getMissedTicks() {
+    return missed_ticks;
+}
+
+uint32_t Rate_Scheduler::getMaxWakeLatency() {
+    return max_wake_latency_us;
+}
+
+void Rate_Scheduler::resetStats() {
+    loop_overruns = 0;
+    missed_ticks = 0;
+    max_wake_latency_us = 0;
+
+    for (uint8_t i = 0; i < group_count; i++) {
+        groups[i].runs = 0;
+        groups[i].overruns = 0;
+        groups[i].skipped = 0;
+        groups[i].max_exec_us = 0;
+        groups[i].last_exec_us = 0;
+    }
+}
+
+void Rate_Scheduler::printStats() {
+    Serial.println("=== Scheduler Stats ===");
+    Serial.print("Ticks: ");
+    Serial.print(tick_count);
+    Serial.print(" | Missed: ");
+    Serial.print(missed_ticks);
+    Serial.print(" | Max wake latency: ");
+    Serial.print(max_wake_latency_us);
+    Serial.println(" us");
+
+    for (uint8_t i = 0; i < group_count; i++) {
+        Serial.print("[");
+        Serial.print(groups[i].name);
+        Serial.print("] period ");
+        Serial.print(groups[i].period_ticks * base_period_us / 1000);
+        Serial.print(" ms, runs ");
+        Serial.print(groups[i].runs);
+        Serial.print(", overruns ");
+        Serial.print(groups[i].overruns);
+        Serial.print(", skipped ");
+        Serial.print(groups[i].skipped);
+        Serial.print(", max exec ");
+        Serial.print(groups[i].max_exec_us);
+        Serial.println(" us");
+    }
+    Serial.println("=======================");
+}
+
+// Private helper functions
+
+#ifdef ARDUINO
+void Rate_Scheduler::onTimer(void* arg) {
+    Rate_Scheduler* scheduler = (Rate_Scheduler*)arg;
+    scheduler->advance(1);
+
+    if (scheduler->waiting_task != nullptr) {
+        xTaskNotifyGive(scheduler->waiting_task);
+    }
+}
+#endif
+
+uint32_t Rate_Scheduler::takePendingTicks() {
+#ifdef ARDUINO
+    portENTER_CRITICAL(&tick_mux);
+#endif
+    uint32_t ticks = pending_ticks;
+    pending_ticks = 0;
+#ifdef ARDUINO
+    portEXIT_CRITICAL(&tick_mux);
+#endif
+    return ticks;
+}
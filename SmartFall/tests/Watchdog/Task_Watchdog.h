@@ -0,0 +1,103 @@
+#ifndef TASK_WATCHDOG_H
+#define TASK_WATCHDOG_H
+
+#include <Arduino.h>
+#include "config.h"
+
+#ifdef ARDUINO
+#include <esp_task_wdt.h>
+#endif
+
+// Restarts a stuck task; false if it cannot be done yet (retried next check)
+typedef bool (*WatchdogRestartFn_t)();
+
+// One supervised task (or one stage of a task) and its deadline
+typedef struct {
+    const char* name;
+    uint32_t deadline_ms;           // Longest allowed gap between check-ins
+    uint32_t restart_ms;            // Silent this long: restart (0 = report only)
+    WatchdogRestartFn_t restart;
+
+    bool active;                    // Checked in at least once since add/restart
+    bool late;                      // Current gap already counted as a miss
+    uint32_t last_checkin_ms;
+
+    // Accounting
+    uint32_t checkins;
+    uint32_t misses;                // Gaps longer than deadline_ms
+    uint32_t max_gap_ms;
+    uint32_t restarts;
+    uint32_t restarts_deferred;     // restart() declined; tried again next check
+
+#ifdef ARDUINO
+    TaskHandle_t handle;            // Subscribed to the ESP-IDF task watchdog
+#endif
+} WatchedTask_t;
+
+/*
+ * Deadline supervisor for the long-running tasks.
+ *
+ * Each task declares the longest gap it may leave between check-ins and
+ * calls checkIn() once per pass of its loop. service() runs from its own
+ * task every WATCHDOG_INTERVAL_MS and counts a miss as soon as a gap
+ * passes the deadline, so a task that hangs is reported while it is still
+ * hung rather than when (or if) it comes back. A task declared with a
+ * restart time and function is restarted once it has been silent that
+ * long; the others are only reported. A restart function that returns
+ * false (e.g. the task was asked to exit and has not yet) is called again
+ * on the next check.
+ *
+ * On the device attach() also subscribes the task to the ESP-IDF task
+ * watchdog (TWDT) and checkIn() feeds it. TASK_WDT_TIMEOUT_S is longer
+ * than any restart time, so the TWDT only reboots the device when a
+ * restart did not help or the stuck task has no restart (the sensor loop).
+ *
+ * Time is passed in, so the host tests drive it from a virtual clock.
+ */
+class Task_Watchdog {
+private:
+    WatchedTask_t tasks[WATCHDOG_MAX_TASKS];
+    uint8_t task_count;
+
+#ifdef ARDUINO
+    TaskHandle_t task;
+    portMUX_TYPE mux;               // Check-ins race the supervisor task
+#endif
+
+public:
+    Task_Watchdog();
+
+    // Configuration
+    int8_t add(const char* name, uint32_t deadline_ms, uint32_t restart_ms = 0,
+               WatchdogRestartFn_t restart = nullptr);
+    bool begin();                   // Hardware watchdog and supervisor task (device only)
+#ifdef ARDUINO
+    bool attach(uint8_t id, TaskHandle_t handle);
+    void detach(uint8_t id);        // Before the task is deleted
+#endif
+
+    // Called by the supervised task once per pass
+    void checkIn(uint8_t id, uint32_t now_ms);
+
+    // Counts misses and restarts stuck tasks; returns how many are late
+    uint8_t service(uint32_t now_ms);
+
+    // Results
+    const WatchedTask_t* getTask(uint8_t id);
+    uint8_t getTaskCount() { return task_count; }
+    uint32_t getTotalMisses();
+#ifdef ARDUINO
+    TaskHandle_t getTaskHandle() { return task; }
+#endif
+    void resetStats();
+
+    // Debug functions
+    void printStats();
+
+private:
+#ifdef ARDUINO
+    static void taskEntry(void* arg);
+#endif
+};
+
+#endif // TASK_WATCHDOG_H
@@ -0,0 +1,380 @@
+/*
+ * SmartFall - Task Watchdog Test
+ *
+ * Runs the firmware's task layout on a virtual clock: the sensor loop on
+ * Rate_Scheduler ticks (acquisition and detection check-ins), a comms
+ * task every COMMS_INTERVAL_MS, an audio task every second and the
+ * watchdog's service() every WATCHDOG_INTERVAL_MS. service() stands for
+ * the higher-priority watchdog task, so it keeps running while another
+ * task is stuck. Hangs are injected into each task.
+ *
+ * Hardware: ESP32 HUZZAH32 Feather (no sensors required)
+ *
+ * This test verifies:
+ * - Tasks that keep their deadlines are never flagged
+ * - A hung comms task is reported once and asked to exit after
+ *   COMMS_RESTART_MS; it is replaced once its call returns and it has
+ *   exited, and the new task checks in, while every sensor tick still
+ *   runs on time
+ * - A slow but legitimate reconnect fits the comms deadline
+ * - A comms call that never returns is never replaced; it stays silent
+ *   past TASK_WDT_TIMEOUT_S, so the TWDT reboots the device
+ * - A stalled sensor loop is reported while it is stalled, and detection
+ *   picks up again afterwards; report-only tasks are never restarted
+ * - A late check-in between two service() calls still counts once
+ * - A check-in stays well inside its budget at the sensor rate
+ */
+
+#include "Task_Watchdog.h"
+#include "Rate_Scheduler.h"
+
+#define TICK_MS              SENSOR_READ_INTERVAL_MS
+#define AUDIO_PERIOD_MS      1000         // Event wait timeout in audioTaskLoop
+#define RECONNECT_MS         (1000 + WIFI_TIMEOUT_MS)
+#define TIMING_CHECKINS      1000000
+#define CHECKIN_BUDGET_US    1            // 0.02% of a core at 100 Hz (two per tick)
+
+enum {
+    WATCH_ACQUISITION,
+    WATCH_DETECTION,
+    WATCH_COMMS,
+    WATCH_AUDIO
+};
+
+int passed = 0;
+int failed = 0;
+
+void expect(const char* name, int32_t expected, int32_t actual) {
+    if (expected == actual) {
+        passed++;
+        Serial.print("✓ ");
+    } else {
+        failed++;
+        Serial.print("✗ ");
+    }
+    Serial.print(name);
+    Serial.print(": expected ");
+    Serial.print(expected);
+    Serial.print(", got ");
+    Serial.println(actual);
+}
+
+void expectTrue(const char* name, bool condition) {
+    expect(name, 1, condition ? 1 : 0);
+}
+
+// Virtual clock in microseconds
+uint32_t virtual_us = 0;
+
+uint32_t virtualClock() {
+    return virtual_us;
+}
+
+uint32_t nowMs() {
+    return virtual_us / 1000;
+}
+
+Rate_Scheduler scheduler(TICK_MS * 1000UL, virtualClock);
+Task_Watchdog watchdog;
+
+// Injected faults
+uint32_t loop_stalled_until = 0;    // Sensor loop blocked (e.g. a dead bus read)
+uint32_t comms_busy_until = 0;      // Comms blocked in a call that returns
+bool comms_hung = false;            // Comms blocked in a call that never returns
+bool comms_cancelled = false;       // Asked to exit by restartComms()
+bool comms_exited = false;
+bool audio_hung = false;
+
+// Outcomes
+uint32_t acquisitions = 0;
+uint32_t detections = 0;
+uint32_t comms_passes = 0;
+uint32_t comms_instances = 0;
+uint32_t restart_calls = 0;
+
+void sensorTask() {
+    acquisitions++;
+    watchdog.checkIn(WATCH_ACQUISITION, nowMs());
+    detections++;
+    watchdog.checkIn(WATCH_DETECTION, nowMs());
+}
+
+// Watchdog task context, as restartComms() in SmartFall.ino
+bool restartComms() {
+    restart_calls++;
+    if (!comms_exited) {
+        comms_cancelled = true;
+        return false;
+    }
+    comms_cancelled = false;
+    comms_exited = false;
+    comms_hung = false;
+    comms_busy_until = 0;
+    comms_instances++;
+    return true;
+}
+
+void commsStep(uint32_t now) {
+    if (comms_exited || comms_hung || (int32_t)(now - comms_busy_until) < 0) return;
+    if (comms_cancelled) {
+        comms_exited = true;            // Between blocking calls: the task deletes itself
+        return;
+    }
+    watchdog.checkIn(WATCH_COMMS, now);
+    comms_passes++;
+}
+
+void audioStep(uint32_t now) {
+    if (audio_hung) return;
+    watchdog.checkIn(WATCH_AUDIO, now);
+}
+
+// One millisecond of the firmware: timer tick, tasks that are due, then loop()
+void step() {
+    virtual_us += 1000;
+    uint32_t now = nowMs();
+
+    if (now % TICK_MS == 0) scheduler.advance(1);
+    if (now % WATCHDOG_INTERVAL_MS == 0) watchdog.service(now);
+    if (now % COMMS_INTERVAL_MS == 0) commsStep(now);
+    if (now % AUDIO_PERIOD_MS == 0) audioStep(now);
+
+    // A stalled loop leaves ticks pending, as the real timer does
+    if ((int32_t)(now - loop_stalled_until) >= 0) scheduler.runPending();
+}
+
+void run(uint32_t ms) {
+    for (uint32_t i = 0; i < ms; i++) step();
+}
+
+// Fresh watchdog and counters; time keeps running
+void restart() {
+    watchdog = Task_Watchdog();
+    watchdog.add("acquisition", ACQUISITION_DEADLINE_MS);
+    watchdog.add("detection", DETECTION_DEADLINE_MS);
+    watchdog.add("comms", COMMS_DEADLINE_MS, COMMS_RESTART_MS, restartComms);
+    watchdog.add("audio", AUDIO_DEADLINE_MS);
+
+    loop_stalled_until = nowMs();
+    comms_busy_until = nowMs();
+    comms_hung = false;
+    comms_cancelled = false;
+    comms_exited = false;
+    audio_hung = false;
+
+    // Every task has checked in once before the test starts
+    run(AUDIO_PERIOD_MS);
+
+    scheduler.resetStats();
+    acquisitions = detections = comms_passes = 0;
+    comms_instances = restart_calls = 0;
+}
+
+uint32_t misses(uint8_t id) {
+    return watchdog.getTask(id)->misses;
+}
+
+uint32_t restarts(uint8_t id) {
+    return watchdog.getTask(id)->restarts;
+}
+
+void setup() {
+    Serial.begin(115200);
+    delay(2000);
+
+    Serial.println("\n========================================");
+    Serial.println("   SmartFall Task Watchdog Test");
+    Serial.println("========================================\n");
+
+    scheduler.addGroup("sensor", TICK_MS, sensorTask);
+    scheduler.begin();
+
+    // Test 1: Everything on time
+    Serial.println("TEST 1: Deadlines Kept");
+    Serial.println("-----------------------");
+    {
+        restart();
+        run(600000);
+        expect("sensor ticks run (10 min)", 600000 / TICK_MS, acquisitions);
+        expect("detection passes", 600000 / TICK_MS, detections);
+        expect("comms passes", 600000 / COMMS_INTERVAL_MS, comms_passes);
+        expect("misses", 0, watchdog.getTotalMisses());
+        expect("restarts", 0, restarts(WATCH_COMMS));
+        expect("acquisition max gap (ms)", TICK_MS, watchdog.getTask(WATCH_ACQUISITION)->max_gap_ms);
+    }
+    Serial.println();
+
+    // Test 2: Comms hangs in a call that comes back late
+    Serial.println("TEST 2: Hung Comms Task");
+    Serial.println("------------------------");
+    {
+        const uint32_t HANG_MS = COMMS_RESTART_MS + 2000;
+        restart();
+        comms_busy_until = nowMs() + HANG_MS;
+        run(COMMS_DEADLINE_MS + WATCHDOG_INTERVAL_MS);
+        expect("miss reported while hung", 1, misses(WATCH_COMMS));
+        expect("not restarted yet", 0, restarts(WATCH_COMMS));
+
+        run(COMMS_RESTART_MS - COMMS_DEADLINE_MS);
+        expectTrue("asked to exit", comms_cancelled);
+        expect("not replaced while still inside the call", 0, restarts(WATCH_COMMS));
+        expect("no new instance", 0, comms_instances);
+
+        // The call returns, the task exits, the next check replaces it
+        run(HANG_MS - COMMS_RESTART_MS);
+        expect("restarted once it exited", 1, restarts(WATCH_COMMS));
+        expect("new instances", 1, comms_instances);
+        expect("still one miss for the hang", 1, misses(WATCH_COMMS));
+
+        uint32_t before = comms_passes;
+        run(10000);
+        expect("new instance checks in", 10000 / COMMS_INTERVAL_MS, comms_passes - before);
+
+        uint32_t elapsed = HANG_MS + WATCHDOG_INTERVAL_MS + 10000;
+        expect("sensor ticks run throughout", elapsed / TICK_MS, acquisitions);
+        expect("detection passes throughout", elapsed / TICK_MS, detections);
+        expect("acquisition misses", 0, misses(WATCH_ACQUISITION));
+        expect("detection misses", 0, misses(WATCH_DETECTION));
+        expect("sensor ticks skipped", 0, scheduler.getMissedTicks());
+    }
+    Serial.println();
+
+    // Test 3: Slow calls that return
+    Serial.println("TEST 3: Slow Reconnects");
+    Serial.println("------------------------");
+    {
+        restart();
+        comms_busy_until = nowMs() + RECONNECT_MS;
+        run(RECONNECT_MS + 1000);
+        expect("a full reconnect fits the deadline", 0, misses(WATCH_COMMS));
+
+        comms_busy_until = nowMs() + (COMMS_DEADLINE_MS + COMMS_RESTART_MS) / 2;
+        run(COMMS_RESTART_MS + 1000);
+        expect("a longer block is a miss", 1, misses(WATCH_COMMS));
+        expect("but not a restart", 0, restart_calls);
+        expectTrue("gap recorded", watchdog.getTask(WATCH_COMMS)->max_gap_ms > COMMS_DEADLINE_MS);
+    }
+    Serial.println();
+
+    // Test 4: Hung in a call that never returns
+    Serial.println("TEST 4: Comms Call Never Returns");
+    Serial.println("---------------------------------");
+    {
+        restart();
+        comms_hung = true;
+        run(COMMS_RESTART_MS + 1000);
+        expect("not replaced while it may hold a lock", 0, restarts(WATCH_COMMS));
+        expect("deferrals (one per check)", 1000 / WATCHDOG_INTERVAL_MS + 1,
+               watchdog.getTask(WATCH_COMMS)->restarts_deferred);
+
+        run(TASK_WDT_TIMEOUT_S * 1000UL);
+        expect("still not replaced", 0, restarts(WATCH_COMMS));
+        expectTrue("silent past the TWDT timeout (reboot)",
+                   nowMs() - watchdog.getTask(WATCH_COMMS)->last_checkin_ms > TASK_WDT_TIMEOUT_S * 1000UL);
+        expect("one miss for the whole hang", 1, misses(WATCH_COMMS));
+        expect("sensor misses", 0, misses(WATCH_ACQUISITION) + misses(WATCH_DETECTION));
+    }
+    Serial.println();
+
+    // Test 5: The sensor loop stalls
+    Serial.println("TEST 5: Stalled Sensor Loop");
+    Serial.println("----------------------------");
+    {
+        restart();
+        loop_stalled_until = nowMs() + 300;
+        run(200);
+        expect("acquisition miss reported while stalled", 1, misses(WATCH_ACQUISITION));
+        expect("detection miss reported while stalled", 1, misses(WATCH_DETECTION));
+
+        run(1000);
+        expect("one miss each for the stall", 2, misses(WATCH_ACQUISITION) + misses(WATCH_DETECTION));
+        expect("nothing restarts the loop", 0, restart_calls);
+        expect("ticks skipped by the stall", 300 / TICK_MS - 1, scheduler.getMissedTicks());
+
+        uint32_t before = detections;
+        run(1000);
+        expect("detection picks up again", 1000 / TICK_MS, detections - before);
+        expect("comms unaffected", 0, misses(WATCH_COMMS));
+
+        // Report-only tasks are not restarted, however long they hang
+        audio_hung = true;
+        run(COMMS_RESTART_MS * 2);
+        expect("audio miss", 1, misses(WATCH_AUDIO));
+        expect("audio restarts", 0, restarts(WATCH_AUDIO));
+
+        // A restart time without a restart function is ignored
+        Task_Watchdog watch;
+        watch.add("audio", AUDIO_DEADLINE_MS, COMMS_RESTART_MS);
+        watch.checkIn(0, 0);
+        watch.service(COMMS_RESTART_MS * 2);
+        expect("no restart function, no restart", 0, watch.getTask(0)->restarts + watch.getTask(0)->restarts_deferred);
+    }
+    Serial.println();
+
+    // Test 6: Late check-ins between service() calls
+    Serial.println("TEST 6: Late Check-ins");
+    Serial.println("-----------------------");
+    {
+        Task_Watchdog watch;
+        watch.add("detection", DETECTION_DEADLINE_MS);
+        watch.checkIn(0, 0);
+        watch.checkIn(0, DETECTION_DEADLINE_MS);
+        expect("exactly on the deadline", 0, watch.getTask(0)->misses);
+
+        watch.checkIn(0, 2 * DETECTION_DEADLINE_MS + 30);
+        expect("late check-in unseen by service()", 1, watch.getTask(0)->misses);
+
+        uint32_t t = 2 * DETECTION_DEADLINE_MS + 30;
+        expect("service() flags the next gap", 1, watch.service(t + DETECTION_DEADLINE_MS + 1));
+        watch.checkIn(0, t + DETECTION_DEADLINE_MS + 20);
+        expect("counted once, not again at check-in", 2, watch.getTask(0)->misses);
+        expect("max gap (ms)", DETECTION_DEADLINE_MS + 30, watch.getTask(0)->max_gap_ms);
+
+        // Never checked in: not started yet, not late
+        Task_Watchdog idle;
+        idle.add("comms", COMMS_DEADLINE_MS, COMMS_RESTART_MS, restartComms);
+        expect("idle task not late", 0, idle.service(COMMS_RESTART_MS * 10));
+        expect("idle task misses", 0, idle.getTotalMisses());
+
+        Task_Watchdog full;
+        for (uint8_t i = 0; i < WATCHDOG_MAX_TASKS; i++) full.add("task", TICK_MS);
+        expect("add() past WATCHDOG_MAX_TASKS", -1, full.add("task", TICK_MS));
+    }
+    Serial.println();
+
+    // Test 7: Check-in cost
+    Serial.println("TEST 7: Check-in Cost");
+    Serial.println("----------------------");
+    {
+        Task_Watchdog watch;
+        watch.add("acquisition", ACQUISITION_DEADLINE_MS);
+        uint32_t start = micros();
+        for (uint32_t i = 0; i < TIMING_CHECKINS; i++) {
+            watch.checkIn(0, i / 100);
+        }
+        float checkin_us = (float)(micros() - start) / TIMING_CHECKINS;
+
+        Serial.print("Per check-in: ");
+        Serial.print(checkin_us, 3);
+        Serial.println(" us");
+        expectTrue("check-in within budget", checkin_us < CHECKIN_BUDGET_US);
+        expect("check-ins counted", TIMING_CHECKINS, watch.getTask(0)->checkins);
+    }
+    Serial.println();
+
+    watchdog.printStats();
+    Serial.println();
+
+    Serial.print("Passed: ");
+    Serial.print(passed);
+    Serial.print("  Failed: ");
+    Serial.println(failed);
+
+    Serial.println("========================================");
+    Serial.println(failed == 0 ? "      ALL TESTS PASSED" : "      TESTS FAILED");
+    Serial.println("========================================");
+}
+
+void loop() {
+    delay(1000);
+}
@@ -0,0 +1,296 @@
+/*
+ * SmartFall - Emergency Alert Codec Benchmark
+ *
+ * Slides a SENSOR_HISTORY_SIZE window over a sensor trace, builds the
+ * EmergencyData_t the device would send for each window, and compares
+ * the binary alert (delta/varint, with and without LZ) against the raw
+ * struct and the JSON payload. Checks a bit-exact round trip of the
+ * quantized samples, CRC rejection and how many samples fit one BLE
+ * notification at common MTUs, with the summary alert where none do.
+ *
+ * The trace is either a recorded log converted with log_decode:
+ *
+ *   log_decode capture.bin trace.csv
+ *   alert_bench trace.csv
+ *
+ * or, without an argument, 10 minutes of the synthetic 100 Hz stream.
+ *
+ * Build (from the repository root):
+ *   g++ -std=c++17 -O2 -Itools/host -ISmartFall -o alert_bench \
+ *       tools/alert_codec/alert_bench.cpp SmartFall/communication/Alert_Codec.cpp \
+ *       SmartFall/communication/JSON_Writer.cpp SmartFall/storage/Data_Logger.cpp \
+ *       SmartFall/storage/Sample_Codec.cpp SmartFall/sensors/Synthetic_Source.cpp
+ *
+ * Usage: alert_bench [trace.csv]
+ */
+
+#include <Arduino.h>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include "communication/Alert_Codec.h"
+#include "communication/Alert_Ack.h"
+#include "communication/JSON_Writer.h"
+#include "storage/Data_Logger.h"
+#include "sensors/Synthetic_Source.h"
+
+HostSerial Serial;
+
+#define SYNTHETIC_SECONDS  600
+#define SYNTHETIC_RATE_HZ  100
+
+typedef struct {
+    const char* name;
+    uint32_t windows;
+    uint64_t json_bytes;
+    uint64_t delta_bytes;
+    uint64_t lz_bytes;
+} SizeStats_t;
+
+static bool loadCSV(const char* path, std::vector<SensorData_t>& trace) {
+    FILE* in = fopen(path, "r");
+    if (in == nullptr) return false;
+
+    char line[256];
+    if (fgets(line, sizeof(line), in) == nullptr) {   // Header
+        fclose(in);
+        return false;
+    }
+
+    while (fgets(line, sizeof(line), in) != nullptr) {
+        SensorData_t data;
+        unsigned sequence, timestamp, fsr;
+        if (sscanf(line, "%u,%u,%f,%f,%f,%f,%f,%f,%f,%f,%u", &sequence, &timestamp,
+                   &data.accel_x, &data.accel_y, &data.accel_z,
+                   &data.gyro_x, &data.gyro_y, &data.gyro_z,
+                   &data.pressure, &data.heart_rate, &fsr) != 11) {
+            continue;
+        }
+        data.timestamp = timestamp;
+        data.fsr_value = (uint16_t)fsr;
+        data.valid = true;
+        data.accel_range_g = 0;   // Not in the log_decode format
+        data.accel_peak_g = 0;
+        data.accel_peak_clipped = false;
+        data.gyro_peak_dps = 0;
+        trace.push_back(data);
+    }
+    fclose(in);
+    return !trace.empty();
+}
+
+static void buildAlert(const std::vector<SensorData_t>& trace, size_t start, EmergencyData_t& alert) {
+    memset(&alert, 0, sizeof(alert));
+    alert.history_count = SENSOR_HISTORY_SIZE;
+    for (uint8_t i = 0; i < SENSOR_HISTORY_SIZE; i++) {
+        alert.sensor_history[i] = trace[start + i];
+    }
+    alert.timestamp = trace[start + SENSOR_HISTORY_SIZE - 1].timestamp;
+    alert.confidence = CONFIDENCE_HIGH;
+    alert.confidence_score = 92;
+    alert.battery_level = 76.5f;
+    strncpy(alert.device_id, "SF-A1B2C3D4E5F6", sizeof(alert.device_id));
+}
+
+// Decoded samples must re-quantize to exactly what was encoded
+static bool roundTrip(const EmergencyData_t& alert, const uint8_t* encoded, size_t length) {
+    static EmergencyData_t decoded;
+    if (!decodeAlert(encoded, length, decoded)) return false;
+    if (decoded.history_count == 0 || decoded.history_count > alert.history_count) return false;
+    if (decoded.timestamp != alert.timestamp || strcmp(decoded.device_id, alert.device_id) != 0) return false;
+
+    uint8_t skipped = alert.history_count - decoded.history_count;
+    for (uint8_t i = 0; i < decoded.history_count; i++) {
+        LogSample_t expected, actual;
+        Data_Logger::toLogSample(alert.sensor_history[skipped + i], expected);
+        Data_Logger::toLogSample(decoded.sensor_history[i], actual);
+        if (memcmp(&expected, &actual, sizeof(expected)) != 0) return false;
+    }
+    return true;
+}
+
+static const char* windowClass(uint32_t timestamp_ms) {
+    uint32_t phase = (timestamp_ms / 1000) % 60;
+    if (phase < 20) return "rest";
+    if (phase < 50) return "walk";
+    if (phase == 50) return "fall";
+    return "lying";
+}
+
+static void printRow(const char* name, uint32_t windows, double json, double delta, double lz) {
+    double raw = sizeof(SensorData_t) * SENSOR_HISTORY_SIZE;
+    printf("%-8s %6u %9.0f %9.0f %9.0f %9.0f %7.1fx %7.1fx\n", name, windows, raw, json, delta, lz,
+           raw / delta, raw / lz);
+}
+
+static bool lzSelfTest() {
+    static uint8_t input[ALERT_MAX_BODY_SIZE];
+    static uint8_t packed[ALERT_MAX_BODY_SIZE];
+    static uint8_t unpacked[ALERT_MAX_BODY_SIZE];
+    bool ok = true;
+
+    // Incompressible input is refused, not expanded
+    uint32_t state = 12345;
+    for (size_t i = 0; i < sizeof(input); i++) {
+        state = state * 1103515245UL + 12345;
+        input[i] = (uint8_t)(state >> 16);
+    }
+    ok &= lzCompress(input, sizeof(input), packed, sizeof(packed)) == 0;
+
+    // Runs and overlapping matches
+    for (size_t i = 0; i < sizeof(input); i++) {
+        input[i] = (i % 700 < 500) ? 0x14 : (uint8_t)(i % 7);
+    }
+    size_t packed_length = lzCompress(input, sizeof(input), packed, sizeof(packed));
+    ok &= packed_length > 0 && packed_length < sizeof(input) / 4;
+    ok &= lzDecompress(packed, packed_length, unpacked, sizeof(unpacked)) == sizeof(input);
+    ok &= memcmp(input, unpacked, sizeof(input)) == 0;
+
+    // Output limit is honoured
+    ok &= lzCompress(input, sizeof(input), packed, packed_length - 1) == 0;
+
+    // Truncated stream is rejected or short, never overruns
+    ok &= lzDecompress(packed, packed_length - 1, unpacked, sizeof(unpacked)) != sizeof(input);
+
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    std::vector<SensorData_t> trace;
+    bool synthetic = argc < 2;
+
+    if (synthetic) {
+        for (uint32_t i = 0; i < SYNTHETIC_SECONDS * SYNTHETIC_RATE_HZ; i++) {
+            SensorData_t data;
+            Synthetic_Source::generate(i, SYNTHETIC_RATE_HZ, data);
+            trace.push_back(data);
+        }
+        printf("Trace: synthetic, %zu samples at %u Hz\n", trace.size(), SYNTHETIC_RATE_HZ);
+    } else {
+        if (!loadCSV(argv[1], trace)) {
+            fprintf(stderr, "Cannot read trace %s\n", argv[1]);
+            return 1;
+        }
+        printf("Trace: %s, %zu samples\n", argv[1], trace.size());
+    }
+
+    if (trace.size() < SENSOR_HISTORY_SIZE) {
+        fprintf(stderr, "Trace shorter than one alert window\n");
+        return 1;
+    }
+
+    static EmergencyData_t alert;
+    static uint8_t encoded[ALERT_MAX_BODY_SIZE + 256];
+    static char json[JSON_EMERGENCY_BUFFER_SIZE];
+
+    std::vector<SizeStats_t> classes;
+    SizeStats_t total = {"all", 0, 0, 0, 0};
+    std::vector<size_t> lz_sizes;
+    uint32_t round_trip_failures = 0;
+    double encode_ns = 0, encode_lz_ns = 0;
+    size_t worst_start = 0, worst_length = 0;
+
+    for (size_t start = 0; start + SENSOR_HISTORY_SIZE <= trace.size(); start += SENSOR_HISTORY_SIZE) {
+        buildAlert(trace, start, alert);
+
+        size_t json_length = writeEmergencyJSON(alert, json, sizeof(json));
+
+        auto t0 = std::chrono::steady_clock::now();
+        size_t delta_length = encodeAlert(alert, encoded, sizeof(encoded), false);
+        auto t1 = std::chrono::steady_clock::now();
+        if (!roundTrip(alert, encoded, delta_length)) round_trip_failures++;
+
+        auto t2 = std::chrono::steady_clock::now();
+        size_t lz_length = encodeAlert(alert, encoded, sizeof(encoded), true);
+        auto t3 = std::chrono::steady_clock::now();
+        if (!roundTrip(alert, encoded, lz_length)) round_trip_failures++;
+
+        encode_ns += std::chrono::duration<double, std::nano>(t1 - t0).count();
+        encode_lz_ns += std::chrono::duration<double, std::nano>(t3 - t2).count();
+
+        const char* name = synthetic ? windowClass(trace[start].timestamp) : "trace";
+        auto it = std::find_if(classes.begin(), classes.end(),
+                               [name](const SizeStats_t& s) { return strcmp(s.name, name) == 0; });
+        if (it == classes.end()) {
+            classes.push_back({name, 0, 0, 0, 0});
+            it = classes.end() - 1;
+        }
+        for (SizeStats_t* s : {&*it, &total}) {
+            s->windows++;
+            s->json_bytes += json_length;
+            s->delta_bytes += delta_length;
+            s->lz_bytes += lz_length;
+        }
+        lz_sizes.push_back(lz_length);
+        if (lz_length > worst_length) {
+            worst_length = lz_length;
+            worst_start = start;
+        }
+    }
+
+    printf("Window: %u samples; JSON carries only the last 10\n\n", SENSOR_HISTORY_SIZE);
+    printf("%-8s %6s %9s %9s %9s %9s %8s %8s\n", "window", "count", "raw B", "JSON B", "delta B", "+LZ B",
+           "delta", "+LZ");
+    for (const SizeStats_t& s : classes) {
+        printRow(s.name, s.windows, (double)s.json_bytes / s.windows, (double)s.delta_bytes / s.windows,
+                 (double)s.lz_bytes / s.windows);
+    }
+    printRow(total.name, total.windows, (double)total.json_bytes / total.windows,
+             (double)total.delta_bytes / total.windows, (double)total.lz_bytes / total.windows);
+
+    std::sort(lz_sizes.begin(), lz_sizes.end());
+    printf("\n+LZ size: min %zu, median %zu, max %zu B\n", lz_sizes.front(),
+           lz_sizes[lz_sizes.size() / 2], lz_sizes.back());
+    printf("Host encode: %.1f us (delta), %.1f us (+LZ) per alert\n",
+           encode_ns / total.windows / 1000.0, encode_lz_ns / total.windows / 1000.0);
+
+    // Samples that fit one notification (worst window), as BLE_Server frames it
+    printf("\nBLE single notification (worst window):\n");
+    const uint16_t mtus[] = {23, 185, 247, 517};
+    buildAlert(trace, worst_start, alert);
+    uint32_t notification_failures = 0;
+    for (uint16_t mtu : mtus) {
+        size_t capacity = std::min<size_t>(mtu - 3, ALERT_BLE_MAX_SIZE) - ALERT_ACK_HEADER_SIZE;
+        size_t length = encodeAlert(alert, encoded, capacity, true);
+        bool summary = length == 0;
+        if (summary) length = encodeAlertSummary(alert, encoded, capacity);
+        static EmergencyData_t decoded;
+        bool ok = length > 0 && length <= capacity && decodeAlert(encoded, length, decoded) &&
+                  decoded.confidence_score == alert.confidence_score && decoded.timestamp == alert.timestamp;
+        if (!ok) notification_failures++;
+        printf("  MTU %3u: %3zu B, %3u/%u samples%s\n", mtu, length, ok ? decoded.history_count : 0,
+               SENSOR_HISTORY_SIZE, !ok ? " (FAILED)" : (summary ? " (summary)" : ""));
+    }
+
+    // Corruption must be caught by the CRC
+    buildAlert(trace, 0, alert);
+    size_t length = encodeAlert(alert, encoded, sizeof(encoded), true);
+    uint32_t undetected = 0;
+    for (size_t i = 0; i < length; i++) {
+        encoded[i] ^= 0x20;
+        static EmergencyData_t decoded;
+        if (decodeAlert(encoded, length, decoded)) undetected++;
+        encoded[i] ^= 0x20;
+    }
+
+    // The summary is CRC-protected too
+    size_t summary_length = encodeAlertSummary(alert, encoded, sizeof(encoded));
+    for (size_t i = 0; i < summary_length; i++) {
+        encoded[i] ^= 0x20;
+        static EmergencyData_t decoded;
+        if (decodeAlert(encoded, summary_length, decoded)) undetected++;
+        encoded[i] ^= 0x20;
+    }
+
+    bool lz_ok = lzSelfTest();
+
+    printf("\nRound trip:  %s (%u windows x 2)\n", round_trip_failures == 0 ? "bit-exact" : "MISMATCH",
+           total.windows);
+    printf("Corruption:  %u/%zu single-byte flips undetected\n", undetected, length + summary_length);
+    printf("LZ checks:   %s\n", lz_ok ? "ok" : "FAILED");
+    printf("BLE fit:     %s\n", notification_failures == 0 ? "every MTU" : "FAILED");
+
+    bool pass = round_trip_failures == 0 && undetected == 0 && lz_ok && notification_failures == 0;
+    printf(pass ? "ALL CHECKS PASSED\n" : "CHECKS FAILED\n");
+    return pass ? 0 : 1;
+}
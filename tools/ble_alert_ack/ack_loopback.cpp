@@ -0,0 +1,292 @@
+/*
+ * SmartFall - BLE Alert Acknowledgement Loopback Test
+ *
+ * Runs the device-side Alert_Ack against a reference app over a
+ * simulated BLE link on a virtual clock. The link delays notifications
+ * and ACK writes by a one-way latency plus jitter, and drops either at a
+ * configurable rate. The app de-duplicates on the sequence number and
+ * ACKs every copy it receives, as the protocol requires.
+ *
+ * Every scenario sends a series of alerts one after another and checks:
+ * - No alert is raised twice in the app
+ * - Every confirmed alert was raised, with an intact payload
+ * - Nearly all alerts are confirmed within ALERT_ACK_MAX_ATTEMPTS
+ * - The RTO tracks the link's round trip
+ *
+ * "notify" counts alerts whose first copy was lost. Before the ACK,
+ * these were reported as delivered although the app never saw them.
+ *
+ * Build (from the repository root):
+ *   g++ -std=c++17 -O2 -Itools/host -ISmartFall -o ack_loopback \
+ *       tools/ble_alert_ack/ack_loopback.cpp SmartFall/communication/Alert_Ack.cpp
+ *
+ * Usage: ack_loopback
+ */
+
+#include <Arduino.h>
+#include <vector>
+#include <deque>
+#include <algorithm>
+#include "communication/Alert_Ack.h"
+
+HostSerial Serial;
+
+#define ALERTS_PER_SCENARIO  300
+#define PAYLOAD_SIZE         120
+#define ALERT_GAP_MS         2000    // Idle time between alerts
+#define GIVE_UP_MS           60000
+
+static uint32_t virtual_ms = 0;
+
+uint32_t virtualClock() {
+    return virtual_ms;
+}
+
+// Deterministic pseudo-random generator for latency and loss
+static uint32_t rng_state = 1;
+static float randomUnit() {
+    rng_state = rng_state * 1664525UL + 1013904223UL;
+    return (rng_state >> 8) / 16777216.0f;
+}
+
+typedef struct {
+    uint32_t due_ms;
+    std::vector<uint8_t> data;
+} InFlight_t;
+
+class Loopback_Link : public Bulk_Link {
+public:
+    uint32_t latency;               // One-way, ms
+    uint32_t jitter;
+    float loss;
+    uint32_t dropped;
+    std::deque<InFlight_t> to_app;
+
+    Loopback_Link(uint32_t l, uint32_t j, float p) : latency(l), jitter(j), loss(p), dropped(0) {}
+
+    uint32_t delay() {
+        return latency + (uint32_t)(randomUnit() * jitter);
+    }
+
+    bool send(const uint8_t* data, size_t length) override {
+        if (randomUnit() < loss) {
+            dropped++;
+            return true;   // Queued by the controller, lost over the air
+        }
+        InFlight_t packet = {virtual_ms + delay(), std::vector<uint8_t>(data, data + length)};
+        to_app.push_back(packet);
+        return true;
+    }
+
+    uint16_t getMTU() override {
+        return 247;
+    }
+};
+
+// Reference app receiver: raises each sequence number once, ACKs every copy
+class Alert_App {
+public:
+    bool have_last;
+    uint16_t last_sequence;
+    uint32_t duplicates;
+    uint32_t corrupt;
+    std::vector<uint16_t> raised;
+    std::deque<InFlight_t> to_device;
+
+    Alert_App() : have_last(false), last_sequence(0), duplicates(0), corrupt(0) {}
+
+    void onNotify(const std::vector<uint8_t>& frame, uint32_t ack_delay) {
+        if (frame.size() < ALERT_ACK_HEADER_SIZE || frame[0] != ALERT_ACK_FRAME_TYPE) {
+            corrupt++;
+            return;
+        }
+        uint16_t sequence = bulkGet16(&frame[1]);
+        uint8_t attempt = frame[3];
+
+        if (have_last && sequence == last_sequence) {
+            duplicates++;
+        } else {
+            have_last = true;
+            last_sequence = sequence;
+            raised.push_back(sequence);
+            if (!payloadValid(frame, sequence)) corrupt++;
+        }
+
+        uint8_t ack[ALERT_ACK_SIZE];
+        bulkPut16(ack, sequence);
+        ack[2] = attempt;
+        InFlight_t packet = {virtual_ms + ack_delay, std::vector<uint8_t>(ack, ack + sizeof(ack))};
+        to_device.push_back(packet);
+    }
+
+    static bool payloadValid(const std::vector<uint8_t>& frame, uint16_t sequence) {
+        if (frame.size() != ALERT_ACK_HEADER_SIZE + PAYLOAD_SIZE) return false;
+        for (size_t i = 0; i < PAYLOAD_SIZE; i++) {
+            if (frame[ALERT_ACK_HEADER_SIZE + i] != (uint8_t)(sequence * 31 + i)) return false;
+        }
+        return true;
+    }
+};
+
+typedef struct {
+    const char* name;
+    uint32_t latency;      // One-way, ms
+    uint32_t jitter;
+    float loss;            // Notification and ACK loss
+    uint32_t min_confirmed_pct;
+} Scenario_t;
+
+static bool runScenario(const Scenario_t& scenario) {
+    virtual_ms = 0;
+    rng_state = 4242;
+
+    Loopback_Link link(scenario.latency, scenario.jitter, scenario.loss);
+    Alert_Ack ack(&link, virtualClock);
+    ack.setSequence(0xFF80);   // Wraps during the run
+
+    Alert_App app;
+    uint8_t frame[ALERT_ACK_HEADER_SIZE + PAYLOAD_SIZE];
+    std::vector<uint16_t> confirmed;
+    std::vector<uint32_t> latencies;
+    uint32_t first_copy_lost = 0;
+
+    for (uint32_t n = 0; n < ALERTS_PER_SCENARIO; n++) {
+        uint16_t next = ack.getSequence() + 1;
+        for (size_t i = 0; i < PAYLOAD_SIZE; i++) {
+            frame[ALERT_ACK_HEADER_SIZE + i] = (uint8_t)(next * 31 + i);
+        }
+
+        uint32_t dropped_before = link.dropped;
+        uint16_t sequence = ack.start(frame, sizeof(frame));
+        if (link.dropped > dropped_before) first_copy_lost++;
+
+        uint32_t start = virtual_ms;
+        AlertAckState_t state = ALERT_ACK_WAITING;
+        while (state == ALERT_ACK_WAITING && virtual_ms - start < GIVE_UP_MS) {
+            virtual_ms++;
+
+            while (!link.to_app.empty() && link.to_app.front().due_ms <= virtual_ms) {
+                app.onNotify(link.to_app.front().data, link.delay());
+                link.to_app.pop_front();
+            }
+            std::stable_sort(app.to_device.begin(), app.to_device.end(),
+                             [](const InFlight_t& a, const InFlight_t& b) { return a.due_ms < b.due_ms; });
+            while (!app.to_device.empty() && app.to_device.front().due_ms <= virtual_ms) {
+                if (randomUnit() >= scenario.loss) {
+                    ack.submitAck(app.to_device.front().data.data(), app.to_device.front().data.size());
+                }
+                app.to_device.pop_front();
+            }
+
+            state = ack.service();
+        }
+
+        if (state == ALERT_ACK_CONFIRMED) {
+            confirmed.push_back(sequence);
+            latencies.push_back(ack.getStats().last_confirm_ms);
+        }
+
+        // Stragglers from this alert arrive during the gap and must be ignored
+        virtual_ms += ALERT_GAP_MS;
+        while (!link.to_app.empty()) {
+            app.onNotify(link.to_app.front().data, link.delay());
+            link.to_app.pop_front();
+        }
+        while (!app.to_device.empty()) {
+            ack.submitAck(app.to_device.front().data.data(), app.to_device.front().data.size());
+            app.to_device.pop_front();
+        }
+        ack.service();
+    }
+
+    // Raised at most once each, and every confirmed alert was raised
+    std::vector<uint16_t> raised = app.raised;
+    std::sort(raised.begin(), raised.end());
+    bool unique = std::adjacent_find(raised.begin(), raised.end()) == raised.end();
+    bool all_raised = true;
+    for (uint16_t sequence : confirmed) {
+        if (!std::binary_search(raised.begin(), raised.end(), sequence)) all_raised = false;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    uint32_t p50 = latencies.empty() ? 0 : latencies[latencies.size() / 2];
+    uint32_t p99 = latencies.empty() ? 0 : latencies[latencies.size() * 99 / 100];
+    uint32_t confirmed_pct = confirmed.size() * 100 / ALERTS_PER_SCENARIO;
+    uint32_t rtt = scenario.latency * 2 + scenario.jitter;
+    bool rto_tracks = ack.getSmoothedRTT() + 5 >= scenario.latency * 2 && ack.getSmoothedRTT() <= rtt + 5;
+
+    const AlertAckStats_t& stats = ack.getStats();
+    bool ok = unique && all_raised && app.corrupt == 0 && confirmed_pct >= scenario.min_confirmed_pct &&
+              rto_tracks;
+
+    printf("%-20s %5zu/%-4u %6u %6u %7u %5u %5u %6u %6u  %s\n",
+           scenario.name, confirmed.size(), ALERTS_PER_SCENARIO, stats.retransmits,
+           app.duplicates, first_copy_lost, p50, p99, ack.getSmoothedRTT(), ack.getRTO(),
+           ok ? "✓" : "✗");
+    if (!unique) printf("  ✗ alert raised twice\n");
+    if (!all_raised) printf("  ✗ confirmed alert never raised\n");
+    if (app.corrupt > 0) printf("  ✗ %u corrupt frames\n", app.corrupt);
+    if (!rto_tracks) printf("  ✗ smoothed RTT does not match the link\n");
+    return ok;
+}
+
+// The link disappears mid-alert: resends back off, then the alert fails
+static bool runDeadLink() {
+    virtual_ms = 0;
+    Loopback_Link link(20, 0, 1.0f);
+    Alert_Ack ack(&link, virtualClock);
+    uint8_t frame[ALERT_ACK_HEADER_SIZE + PAYLOAD_SIZE] = {0};
+
+    ack.start(frame, sizeof(frame));
+    std::vector<uint32_t> sends(1, 0);
+    uint32_t frames = ack.getStats().frames_sent;
+    AlertAckState_t state = ALERT_ACK_WAITING;
+    while (state == ALERT_ACK_WAITING && virtual_ms < GIVE_UP_MS) {
+        virtual_ms++;
+        state = ack.service();
+        if (ack.getStats().frames_sent != frames) {
+            frames = ack.getStats().frames_sent;
+            sends.push_back(virtual_ms);
+        }
+    }
+
+    // Gaps double from the initial RTO up to the cap
+    bool backoff = true;
+    uint32_t expected_gap = ALERT_ACK_INITIAL_RTO_MS;
+    for (size_t i = 1; i < sends.size(); i++) {
+        if (sends[i] - sends[i - 1] != expected_gap) backoff = false;
+        expected_gap = std::min<uint32_t>(expected_gap * 2, ALERT_ACK_MAX_RTO_MS);
+    }
+
+    bool ok = state == ALERT_ACK_FAILED && ack.getStats().frames_sent == ALERT_ACK_MAX_ATTEMPTS &&
+              backoff;
+    printf("%-20s failed after %u copies in %u ms, backoff %s  %s\n", "dead link",
+           ack.getStats().frames_sent, virtual_ms, backoff ? "ok" : "wrong", ok ? "✓" : "✗");
+    return ok;
+}
+
+int main() {
+    const Scenario_t scenarios[] = {
+        {"clean, 30 ms RTT",      15,  5, 0.00f, 100},
+        {"2% loss",               15,  5, 0.02f, 100},
+        {"10% loss",              15, 10, 0.10f, 100},
+        {"30% loss",              25, 20, 0.30f,  99},
+        {"slow phone, 600 ms",   280, 40, 0.05f, 100},
+    };
+
+    printf("%u alerts per scenario, %u B payload, RTO %u..%u ms (initial %u), %u attempts\n\n",
+           ALERTS_PER_SCENARIO, PAYLOAD_SIZE, ALERT_ACK_MIN_RTO_MS, ALERT_ACK_MAX_RTO_MS,
+           ALERT_ACK_INITIAL_RTO_MS, ALERT_ACK_MAX_ATTEMPTS);
+    printf("%-20s %10s %6s %6s %7s %5s %5s %6s %6s\n",
+           "scenario", "confirmed", "resend", "dups", "notify", "p50", "p99", "srtt", "rto");
+
+    int failures = 0;
+    for (const Scenario_t& scenario : scenarios) {
+        if (!runScenario(scenario)) failures++;
+    }
+    if (!runDeadLink()) failures++;
+
+    printf("\nnotify: alerts whose first copy was lost (reported delivered without the ACK)\n");
+    printf(failures == 0 ? "ALL SCENARIOS PASSED\n" : "SCENARIOS FAILED\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,354 @@
+/*
+ * SmartFall - BLE Bulk Transfer Loopback Test
+ *
+ * Runs the device-side Bulk_Transfer against a reference client over a
+ * simulated BLE link on a virtual clock. The link enforces the ATT MTU,
+ * drops or corrupts notifications and client writes at a configurable
+ * rate, and limits throughput per connection event. The source is a
+ * real Data_Logger ring on the NOR flash emulator, filled past its wrap
+ * point, read through Data_Logger::readBytes. Every scenario must
+ * deliver a byte-identical copy of the ring, including one where the
+ * source reports busy (the logger still sealing its partial block) for
+ * the first few hundred milliseconds.
+ *
+ * Link model: 15 ms connection interval, 6 link-layer packets per event,
+ * 251-byte LL payload (data length extension). A notification costs
+ * ceil((ATT value + 7) / 251) LL packets.
+ *
+ * Build (from the repository root):
+ *   g++ -std=c++17 -O2 -Itools/host -ISmartFall -o bulk_loopback \
+ *       tools/ble_bulk/bulk_loopback.cpp SmartFall/communication/Bulk_Transfer.cpp \
+ *       SmartFall/storage/Data_Logger.cpp SmartFall/storage/Sample_Codec.cpp
+ *
+ * Usage: bulk_loopback [image.bin]
+ */
+
+#include <Arduino.h>
+#include <vector>
+#include <deque>
+#include "communication/Bulk_Transfer.h"
+#include "storage/Data_Logger.h"
+#include "../log_tool/File_Flash.h"
+
+HostSerial Serial;
+
+#define PARTITION_SIZE       0x160000
+#define CONN_INTERVAL_MS     15
+#define LL_PACKETS_PER_EVENT 6
+#define LL_PAYLOAD           251
+#define L2CAP_ATT_OVERHEAD   7
+#define CLIENT_WINDOW        16
+#define CLIENT_TIMEOUT_MS    500
+#define DAY_OF_SAMPLES_BYTES (86400ULL * 100 * 10)   // 100 Hz x ~10 B/sample
+
+static uint32_t virtual_ms = 0;
+static Data_Logger* ring = nullptr;
+static std::vector<uint8_t> source;     // Reference copy, block by block
+static uint32_t source_busy_ms = 0;     // openSource() reports busy until then
+
+uint32_t virtualClock() {
+    return virtual_ms;
+}
+
+uint32_t openSource() {
+    if (virtual_ms < source_busy_ms) return BULK_SOURCE_BUSY;
+    return ring->getBlockCount() * LOG_BLOCK_SIZE;
+}
+
+bool readSource(uint32_t offset, uint8_t* buffer, size_t length) {
+    return ring->readBytes(offset, buffer, length);
+}
+
+// Deterministic pseudo-random generator for loss decisions
+static uint32_t rng_state = 1;
+static float randomUnit() {
+    rng_state = rng_state * 1664525UL + 1013904223UL;
+    return (rng_state >> 8) / 16777216.0f;
+}
+
+class Loopback_Link : public Bulk_Link {
+public:
+    uint16_t mtu;
+    float loss;
+    float corruption;
+    uint32_t event_packets;         // LL packets used in the current connection event
+    uint32_t oversize;
+    uint64_t air_bytes;
+    std::deque<std::vector<uint8_t>> to_client;
+
+    Loopback_Link(uint16_t m, float l, float c)
+        : mtu(m), loss(l), corruption(c), event_packets(0), oversize(0), air_bytes(0) {}
+
+    bool send(const uint8_t* data, size_t length) override {
+        if (length > (size_t)(mtu - BULK_ATT_OVERHEAD)) {
+            oversize++;
+            return true;   // Dropped by the stack
+        }
+
+        uint32_t packets = (length + L2CAP_ATT_OVERHEAD + LL_PAYLOAD - 1) / LL_PAYLOAD;
+        if (event_packets + packets > LL_PACKETS_PER_EVENT) {
+            return false;  // Congested until the next connection event
+        }
+        event_packets += packets;
+        air_bytes += length + L2CAP_ATT_OVERHEAD;
+
+        if (randomUnit() < loss) return true;
+
+        std::vector<uint8_t> packet(data, data + length);
+        if (randomUnit() < corruption) {
+            packet[packet.size() - 1] ^= 0x5A;
+        }
+        to_client.push_back(packet);
+        return true;
+    }
+
+    uint16_t getMTU() override {
+        return mtu;
+    }
+};
+
+// Reference client, as a mobile app would implement it
+class Bulk_Client {
+public:
+    std::vector<uint8_t> received;
+    uint32_t expected;
+    uint32_t end;
+    uint32_t chunks_since_ack;
+    uint32_t nak_offset;
+    uint32_t last_progress;
+    uint32_t crc_errors;
+    bool have_info;
+    bool started;                   // First chunk of the current READ received
+    bool done;
+    std::deque<std::vector<uint8_t>> to_device;
+
+    Bulk_Client() : expected(0), end(0), chunks_since_ack(0), nak_offset(UINT32_MAX),
+                    last_progress(0), crc_errors(0),
+                    have_info(false), started(false), done(false) {}
+
+    void requestInfo() {
+        uint8_t request = BULK_OP_GET_INFO;
+        to_device.push_back(std::vector<uint8_t>(&request, &request + 1));
+        last_progress = virtual_ms;
+    }
+
+    void requestRead(uint32_t offset, uint32_t length) {
+        uint8_t request[10];
+        request[0] = BULK_OP_READ;
+        bulkPut32(request + 1, offset);
+        bulkPut32(request + 5, length);
+        request[9] = CLIENT_WINDOW;
+        to_device.push_back(std::vector<uint8_t>(request, request + sizeof(request)));
+        last_progress = virtual_ms;
+        started = false;
+    }
+
+    void sendAck(uint8_t flags) {
+        uint8_t ack[6];
+        ack[0] = BULK_OP_ACK;
+        bulkPut32(ack + 1, expected);
+        ack[5] = flags;
+        to_device.push_back(std::vector<uint8_t>(ack, ack + sizeof(ack)));
+        chunks_since_ack = 0;
+    }
+
+    void onNotify(const std::vector<uint8_t>& packet) {
+        if (packet.empty()) return;
+
+        if (packet[0] == BULK_MSG_INFO && packet.size() >= 10 && !have_info) {
+            have_info = true;
+            end = bulkGet32(&packet[1]);
+            requestRead(0, 0);
+        } else if (packet[0] == BULK_MSG_DATA && packet.size() > BULK_CHUNK_HEADER_SIZE) {
+            uint32_t offset = bulkGet32(&packet[1]);
+            uint16_t crc = bulkGet16(&packet[5]);
+            const uint8_t* payload = &packet[BULK_CHUNK_HEADER_SIZE];
+            size_t length = packet.size() - BULK_CHUNK_HEADER_SIZE;
+
+            bool crc_ok = Bulk_Transfer::crc16(payload, length) == crc;
+            if (!crc_ok) crc_errors++;
+
+            if (offset == expected && crc_ok) {
+                started = true;
+                received.insert(received.end(), payload, payload + length);
+                expected += length;
+                last_progress = virtual_ms;
+                nak_offset = UINT32_MAX;
+                if (++chunks_since_ack >= CLIENT_WINDOW / 2 || expected >= end) {
+                    sendAck(0);
+                }
+            } else if (offset >= expected && nak_offset != expected) {
+                // Gap or corrupt chunk: one NAK per missing offset
+                nak_offset = expected;
+                sendAck(BULK_ACK_FLAG_NAK);
+            }
+        } else if (packet[0] == BULK_MSG_END) {
+            done = bulkGet32(&packet[1]) == end && expected == end;
+        }
+    }
+
+    void checkTimeout() {
+        if (done || virtual_ms - last_progress < CLIENT_TIMEOUT_MS) return;
+
+        // Lost request, lost ACK, or lost END: repeat the last step
+        if (!have_info) {
+            requestInfo();
+        } else if (!started || expected >= end) {
+            requestRead(expected, end - expected);   // Empty range re-sends END
+        } else {
+            sendAck(expected < end ? BULK_ACK_FLAG_NAK : 0);
+            last_progress = virtual_ms;
+        }
+    }
+};
+
+typedef struct {
+    const char* name;
+    uint16_t mtu;
+    float loss;            // Notification and write loss
+    float corruption;
+    bool disconnect;       // Drop the connection at 40% and resume
+    uint32_t busy_ms;      // Source not ready for this long
+} Scenario_t;
+
+static bool runScenario(const Scenario_t& scenario) {
+    virtual_ms = 0;
+    rng_state = 12345;
+    source_busy_ms = scenario.busy_ms;
+
+    Loopback_Link link(scenario.mtu, scenario.loss, scenario.corruption);
+    Bulk_Transfer transfer(&link, virtualClock);
+    transfer.setSource(openSource, readSource);
+
+    Bulk_Client client;
+    client.requestInfo();
+
+    bool disconnected = false;
+    uint32_t limit_ms = 3600000;
+
+    while (!client.done && virtual_ms < limit_ms) {
+        // Client writes (lossy uplink)
+        while (!client.to_device.empty()) {
+            if (randomUnit() >= scenario.loss) {
+                transfer.submitRequest(client.to_device.front().data(), client.to_device.front().size());
+                transfer.service();
+            }
+            client.to_device.pop_front();
+        }
+
+        // Device pump within this connection event
+        link.event_packets = 0;
+        transfer.service();
+
+        while (!link.to_client.empty()) {
+            client.onNotify(link.to_client.front());
+            link.to_client.pop_front();
+        }
+        client.checkTimeout();
+
+        if (scenario.disconnect && !disconnected && client.expected > client.end * 2 / 5) {
+            disconnected = true;
+            transfer.abort();
+            link.to_client.clear();
+            client.to_device.clear();
+            virtual_ms += 2000;  // Reconnect time
+            client.requestRead(client.expected, client.end - client.expected);
+        }
+
+        virtual_ms += CONN_INTERVAL_MS;
+    }
+
+    bool identical = client.done && client.end == source.size() && client.received == source;
+    const BulkStats_t& stats = transfer.getStats();
+    double seconds = virtual_ms / 1000.0;
+    double kbps = source.size() / 1024.0 / seconds;
+    double day_minutes = DAY_OF_SAMPLES_BYTES / 1024.0 / kbps / 60.0;
+
+    printf("%-22s %4u %5u %7.1f %7.1f %7.1f %6u %8u %6.1f  %s\n",
+           scenario.name, scenario.mtu, transfer.getChunkSize(), seconds, kbps,
+           100.0 * source.size() / link.air_bytes, stats.rewinds, stats.resent_bytes,
+           day_minutes, identical ? "✓" : "✗");
+
+    return identical && link.oversize == 0;
+}
+
+// Fills the ring past its wrap point so readBytes has to stitch sectors
+static bool fillRing(Data_Logger& logger) {
+    if (!logger.begin(100)) return false;
+    logger.start();
+
+    uint32_t seed = 7;
+    uint32_t index = 0;
+    while (logger.getStats().blocks_written < logger.getCapacityBlocks() + 37) {
+        seed = seed * 1103515245UL + 12345UL;
+        SensorData_t data;
+        memset(&data, 0, sizeof(data));
+        data.timestamp = index * 10;
+        data.accel_x = ((seed >> 8) & 0xFF) / 256.0f - 0.5f;
+        data.accel_z = 1.0f + ((seed >> 16) & 0xFF) / 512.0f;
+        data.gyro_y = (float)((int32_t)(seed >> 20) % 300);
+        data.pressure = 1013.25f;
+        data.heart_rate = 72.0f;
+        data.valid = true;
+        logger.log(data);
+        logger.serviceFlush();
+        index++;
+    }
+    logger.stop();
+
+    // Reference: readBlock concatenation, oldest first
+    source.resize(logger.getBlockCount() * LOG_BLOCK_SIZE);
+    for (uint32_t b = 0; b < logger.getBlockCount(); b++) {
+        if (!logger.readBlock(b, &source[b * LOG_BLOCK_SIZE])) return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    const char* image = argc > 1 ? argv[1] : "bulk_loopback_flash.bin";
+    remove(image);
+
+    File_Flash flash;
+    if (!flash.open(image, PARTITION_SIZE)) {
+        printf("Cannot create %s\n", image);
+        return 1;
+    }
+
+    Data_Logger logger(&flash);
+    ring = &logger;
+    if (!fillRing(logger)) {
+        printf("Ring setup failed\n");
+        return 1;
+    }
+
+    const Scenario_t scenarios[] = {
+        {"default MTU",         23, 0.00f, 0.000f, false, 0},
+        {"MTU 185",            185, 0.00f, 0.000f, false, 0},
+        {"MTU 247",            247, 0.00f, 0.000f, false, 0},
+        {"MTU 517",            517, 0.00f, 0.000f, false, 0},
+        {"MTU 247, 2% loss",   247, 0.02f, 0.000f, false, 0},
+        {"MTU 247, 10% loss",  247, 0.10f, 0.000f, false, 0},
+        {"MTU 517, 5% loss",   517, 0.05f, 0.000f, false, 0},
+        {"MTU 247, corruption", 247, 0.00f, 0.020f, false, 0},
+        {"MTU 247, resume",    247, 0.02f, 0.000f, true, 0},
+        {"MTU 247, busy source", 247, 0.00f, 0.000f, false, 300},
+    };
+
+    printf("Source: %lu bytes (%u blocks, wrapped log ring)\n",
+           (unsigned long)source.size(), logger.getBlockCount());
+    printf("Link: %u ms interval, %u LL packets/event, %u B LL payload\n\n",
+           CONN_INTERVAL_MS, LL_PACKETS_PER_EVENT, LL_PAYLOAD);
+    printf("%-22s %4s %5s %7s %7s %7s %6s %8s %6s\n",
+           "scenario", "mtu", "chunk", "time_s", "KB/s", "eff_%", "rewind", "resent_B", "day_m");
+
+    int failures = 0;
+    for (const Scenario_t& scenario : scenarios) {
+        if (!runScenario(scenario)) failures++;
+    }
+
+    printf("\nday_m: minutes to pull one day of 100 Hz samples (~%.0f MB)\n",
+           DAY_OF_SAMPLES_BYTES / 1048576.0);
+    remove(image);
+    printf(failures == 0 ? "ALL SCENARIOS PASSED\n" : "SCENARIOS FAILED\n");
+    return failures == 0 ? 0 : 1;
+}
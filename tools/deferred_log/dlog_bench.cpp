@@ -0,0 +1,407 @@
+/*
+ * SmartFall - Deferred Log Benchmark
+ *
+ * Compares the cost of one hot-path debug line printed synchronously,
+ * the way fall_detector/confidence_scorer/Emergency_Comms used to, with
+ * Deferred_Log::log(), and with the reader's formatting that replaces
+ * it off the sampling path. Host cost is reported in ns and, on x86, TSC
+ * cycles per call. The UART cost the old path paid on the device is
+ * modelled: Arduino-ESP32 writes block once the 128-byte TX FIFO is
+ * full, so a burst of lines stalls the caller for the bytes beyond it at
+ * 10 bits each.
+ *
+ * Then checks that the deferred text matches the old Serial output, that
+ * frames round-trip and reject corruption, that concurrent producers
+ * neither lose nor duplicate records across many laps of the ring, and
+ * that a full ring drops (and counts) new records instead of overwriting.
+ *
+ * Build (from the repository root):
+ *   g++ -std=c++17 -O2 -pthread -Itools/host -ISmartFall -o dlog_bench \
+ *       tools/deferred_log/dlog_bench.cpp SmartFall/diagnostics/Deferred_Log.cpp
+ *
+ * Usage: dlog_bench
+ */
+
+#include <Arduino.h>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <string>
+#include "diagnostics/Deferred_Log.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#endif
+
+HostSerial Serial;
+
+#define BENCH_CALLS        200000
+#define UART_TX_FIFO       128        // ESP32 hardware FIFO; no driver TX buffer in the core
+#define PRODUCER_THREADS   4
+#define PRODUCER_RECORDS   50000      // Per thread
+
+typedef struct {
+    double ns;
+    double cycles;                    // 0 without a TSC
+} CallCost_t;
+
+// The old synchronous output, statement for statement
+static void printStage2Score(uint8_t score, uint8_t impact, uint8_t timing, uint8_t fsr) {
+    Serial.print("Stage 2 Score: ");
+    Serial.print(score);
+    Serial.print("/25 (Impact: ");
+    Serial.print(impact);
+    Serial.print(", Timing: ");
+    Serial.print(timing);
+    Serial.print(", FSR: ");
+    Serial.print(fsr);
+    Serial.println(")");
+}
+
+static void printStageScore(uint8_t stage, uint8_t score, uint8_t max, const char* first,
+                            uint8_t a, const char* second, uint8_t b) {
+    Serial.print("Stage ");
+    Serial.print(stage);
+    Serial.print(" Score: ");
+    Serial.print(score);
+    Serial.print("/");
+    Serial.print(max);
+    Serial.print(" (");
+    Serial.print(first);
+    Serial.print(": ");
+    Serial.print(a);
+    Serial.print(", ");
+    Serial.print(second);
+    Serial.print(": ");
+    Serial.print(b);
+    Serial.println(")");
+}
+
+// The lines one detected fall produces, old path and new
+static void printFallBurst() {
+    Serial.println("POTENTIAL FALL: All stages completed!");
+    printStageScore(1, 22, 25, "Duration", 15, "Magnitude", 7);
+    printStage2Score(18, 8, 3, 7);
+    printStageScore(3, 15, 20, "Angular", 10, "Orientation", 5);
+    printStageScore(4, 20, 20, "Duration", 15, "Stability", 5);
+    Serial.print("Classifier: ");
+    Serial.print((uint8_t)87);
+    Serial.println("% fall");
+    Serial.print("Classifier Score: ");
+    Serial.print((uint8_t)12);
+    Serial.print("/15 (Probability: ");
+    Serial.print((uint8_t)87);
+    Serial.println("%)");
+}
+
+static void logFallBurst() {
+    Deferred_Log::log(DLOG_POTENTIAL_FALL);
+    Deferred_Log::log(DLOG_STAGE1_SCORE, (uint8_t)22, (uint8_t)15, (uint8_t)7);
+    Deferred_Log::log(DLOG_STAGE2_SCORE, (uint8_t)18, (uint8_t)8, (uint8_t)3, (uint8_t)7);
+    Deferred_Log::log(DLOG_STAGE3_SCORE, (uint8_t)15, (uint8_t)10, (uint8_t)5);
+    Deferred_Log::log(DLOG_STAGE4_SCORE, (uint8_t)20, (uint8_t)15, (uint8_t)5);
+    Deferred_Log::log(DLOG_CLASSIFIER_RESULT, (uint8_t)87);
+    Deferred_Log::log(DLOG_CLASSIFIER_SCORE, (uint8_t)12, (uint8_t)87);
+}
+
+static std::string captureSerial(void (*print)()) {
+    char* text = nullptr;
+    size_t length = 0;
+    FILE* memory = open_memstream(&text, &length);
+    FILE* saved = Serial.stream;
+    Serial.stream = memory;
+    print();
+    Serial.stream = saved;
+    fclose(memory);
+    std::string result(text, length);
+    free(text);
+    return result;
+}
+
+static std::string drainText() {
+    std::string result;
+    DlogRecord_t record;
+    char text[DLOG_TEXT_MAX_LENGTH];
+    while (Deferred_Log::read(record)) {
+        Deferred_Log::format(record, text, sizeof(text));
+        result += text;
+        result += '\n';
+    }
+    return result;
+}
+
+template <typename Fn>
+static CallCost_t measure(uint32_t calls, Fn fn) {
+    auto start = std::chrono::steady_clock::now();
+#ifdef HAVE_TSC
+    uint64_t cycles_start = __rdtsc();
+#endif
+    for (uint32_t i = 0; i < calls; i++) {
+        fn(i);
+    }
+    CallCost_t cost;
+#ifdef HAVE_TSC
+    cost.cycles = (double)(__rdtsc() - cycles_start) / calls;
+#else
+    cost.cycles = 0;
+#endif
+    cost.ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / calls;
+    return cost;
+}
+
+static void printCost(const char* label, const CallCost_t& cost) {
+    printf("%-34s %7.1f ns", label, cost.ns);
+    if (cost.cycles > 0) printf("  %7.0f TSC cycles", cost.cycles);
+    printf("\n");
+}
+
+// Caller stall on the device: bytes past the TX FIFO at 10 bits per byte
+static double uartStallMs(size_t bytes) {
+    if (bytes <= UART_TX_FIFO) return 0.0;
+    return (bytes - UART_TX_FIFO) * 10.0 * 1000.0 / SERIAL_BAUD_RATE;
+}
+
+static bool checkFrames() {
+    uint8_t frame[DLOG_FRAME_MAX_SIZE];
+    DlogRecord_t record;
+    DlogRecord_t decoded;
+    uint32_t seed = 12345;
+
+    for (uint16_t m = 0; m < DLOG_MESSAGE_COUNT; m++) {
+        if (Deferred_Log::getFormat(m) == nullptr) return false;
+
+        for (uint8_t count = 0; count <= DLOG_MAX_ARGS; count++) {
+            memset(&record, 0, sizeof(record));
+            record.message = m;
+            record.arg_count = count;
+            record.timestamp_us = seed = seed * 1103515245u + 12345u;
+            for (uint8_t i = 0; i < count; i++) {
+                record.args[i] = seed = seed * 1103515245u + 12345u;
+            }
+
+            size_t size = Deferred_Log::encodeFrame(record, frame);
+            if (size != DLOG_FRAME_HEADER_SIZE + 4u * count + 1) return false;
+            if (Deferred_Log::decodeFrame(frame, size, decoded) != size) return false;
+            if (decoded.message != m || decoded.arg_count != count ||
+                decoded.timestamp_us != record.timestamp_us ||
+                memcmp(decoded.args, record.args, sizeof(record.args)) != 0) {
+                return false;
+            }
+
+            // Truncated, and every single-bit error past the sync bytes
+            if (Deferred_Log::decodeFrame(frame, size - 1, decoded) != 0) return false;
+            for (size_t byte = 2; byte < size; byte++) {
+                for (uint8_t bit = 0; bit < 8; bit++) {
+                    frame[byte] ^= 1 << bit;
+                    bool accepted = Deferred_Log::decodeFrame(frame, size, decoded) == size &&
+                                    memcmp(&decoded, &record, sizeof(record)) == 0;
+                    frame[byte] ^= 1 << bit;
+                    if (accepted) return false;
+                }
+            }
+        }
+    }
+    return true;
+}
+
+static bool checkFormat() {
+    DlogRecord_t record = {};
+    char text[DLOG_TEXT_MAX_LENGTH];
+
+    record.message = DLOG_EMERGENCY_STATUS;
+    record.arg_count = 1;
+    record.args[0] = 4;
+    Deferred_Log::format(record, text, sizeof(text));
+    if (strcmp(text, "[Emergency] Alert status: Sent via Both") != 0) return false;
+
+    record.args[0] = 9;               // Out of range: no word
+    Deferred_Log::format(record, text, sizeof(text));
+    if (strcmp(text, "[Emergency] Alert status: ?") != 0) return false;
+
+    record.message = DLOG_EMERGENCY_DELIVERED;
+    record.arg_count = 2;
+    record.args[0] = 1;
+    record.args[1] = 640;
+    Deferred_Log::format(record, text, sizeof(text));
+    if (strcmp(text, "[Emergency] ✓ Delivered via ble in 640 ms") != 0) return false;
+
+    // Output never overruns a short buffer
+    char small[12];
+    memset(small, 'x', sizeof(small));
+    size_t length = Deferred_Log::format(record, small, 8);
+    if (length != 7 || small[7] != '\0' || small[8] != 'x') return false;
+
+    record.message = DLOG_MESSAGE_COUNT + 7;
+    Deferred_Log::format(record, text, sizeof(text));
+    return strncmp(text, "[Log] message", 13) == 0;
+}
+
+// Producers tag each record (thread, index) and retry while the ring is
+// full; the one reader must see every record exactly once, in order per thread
+static bool checkConcurrent(uint32_t& received, uint32_t& full) {
+    Deferred_Log::begin();
+
+    std::atomic<bool> go(false);
+    std::atomic<uint32_t> finished(0);
+    std::vector<std::thread> producers;
+    for (uint32_t t = 0; t < PRODUCER_THREADS; t++) {
+        producers.emplace_back([t, &go, &finished]() {
+            while (!go.load()) std::this_thread::yield();
+            for (uint32_t i = 0; i < PRODUCER_RECORDS; i++) {
+                const uint32_t args[] = {t, i};
+                while (!Deferred_Log::write(DLOG_STAGE1_SCORE, args, 2)) {
+                    std::this_thread::yield();
+                }
+            }
+            finished++;
+        });
+    }
+
+    uint32_t next[PRODUCER_THREADS] = {};
+    bool ordered = true;
+    received = 0;
+    go = true;
+
+    DlogRecord_t record;
+    for (;;) {
+        // Checked before reading, so nothing logged after the last read is missed
+        bool done = finished.load() == PRODUCER_THREADS;
+        if (!Deferred_Log::read(record)) {
+            if (done) break;
+            std::this_thread::yield();
+            continue;
+        }
+        uint32_t t = record.args[0];
+        uint32_t i = record.args[1];
+        if (t >= PRODUCER_THREADS || i < next[t]) {
+            ordered = false;       // Duplicate or out of order
+        } else {
+            next[t] = i + 1;
+        }
+        received++;
+    }
+    for (auto& producer : producers) producer.join();
+
+    DlogStats_t stats = Deferred_Log::getStats();
+    full = stats.dropped;
+    bool complete = true;
+    for (uint32_t t = 0; t < PRODUCER_THREADS; t++) {
+        if (next[t] != PRODUCER_RECORDS) complete = false;
+    }
+    return ordered && complete && stats.logged == received &&
+           received == (uint32_t)PRODUCER_THREADS * PRODUCER_RECORDS;
+}
+
+int main() {
+    int failures = 0;
+    FILE* sink = fopen("/dev/null", "w");
+    Serial.stream = sink;
+
+    printf("Record: %zu B in RAM, %u..%u B framed; ring %u records (%zu B)\n\n",
+           sizeof(DlogRecord_t), DLOG_FRAME_HEADER_SIZE + 1, DLOG_FRAME_MAX_SIZE,
+           DEFERRED_LOG_RING_SIZE, sizeof(DlogRecord_t) * DEFERRED_LOG_RING_SIZE);
+
+    // Cost per Stage 2 score line, the heaviest of the detector lines
+    Deferred_Log::begin();
+    CallCost_t sync_cost = measure(BENCH_CALLS, [](uint32_t i) {
+        printStage2Score(18, (uint8_t)i, 3, 7);
+    });
+    // Timed a ring at a time; the reader empties it between rounds, untimed
+    CallCost_t log_cost = {0, 0};
+    for (uint32_t round = 0; round < BENCH_CALLS / DEFERRED_LOG_RING_SIZE; round++) {
+        CallCost_t cost = measure(DEFERRED_LOG_RING_SIZE, [](uint32_t i) {
+            Deferred_Log::log(DLOG_STAGE2_SCORE, (uint8_t)18, (uint8_t)i, (uint8_t)3, (uint8_t)7);
+        });
+        log_cost.ns += cost.ns;
+        log_cost.cycles += cost.cycles;
+        DlogRecord_t record;
+        while (Deferred_Log::read(record)) {}
+    }
+    log_cost.ns /= BENCH_CALLS / DEFERRED_LOG_RING_SIZE;
+    log_cost.cycles /= BENCH_CALLS / DEFERRED_LOG_RING_SIZE;
+    DlogStats_t stats = Deferred_Log::getStats();
+
+    DlogRecord_t record = {};
+    record.message = DLOG_STAGE2_SCORE;
+    record.arg_count = 4;
+    record.args[0] = 18;
+    record.args[2] = 3;
+    record.args[3] = 7;
+    char text[DLOG_TEXT_MAX_LENGTH];
+    CallCost_t format_cost = measure(BENCH_CALLS, [&](uint32_t i) {
+        record.args[1] = i & 0xFF;
+        Deferred_Log::format(record, text, sizeof(text));
+    });
+    uint8_t frame[DLOG_FRAME_MAX_SIZE];
+    CallCost_t frame_cost = measure(BENCH_CALLS, [&](uint32_t i) {
+        record.args[1] = i & 0xFF;
+        Deferred_Log::encodeFrame(record, frame);
+    });
+
+    printf("=== Host cost per Stage 2 score line ===\n");
+    printCost("Serial.print (stdio sink):", sync_cost);
+    printCost("Deferred_Log::log:", log_cost);
+    printCost("Reader: format to text:", format_cost);
+    printCost("Reader: encode frame:", frame_cost);
+    printf("Speedup on the caller:             %.1fx\n", sync_cost.ns / log_cost.ns);
+    printf("Dropped while benchmarking:        %u\n\n", stats.dropped);
+
+    // Device stall for the lines one fall produces
+    Serial.stream = sink;
+    std::string old_text = captureSerial(printFallBurst);
+    Deferred_Log::begin();
+    logFallBurst();
+    std::string new_text = drainText();
+
+    Deferred_Log::begin();
+    logFallBurst();
+    size_t frame_bytes = 0;
+    while (Deferred_Log::read(record)) {
+        frame_bytes += Deferred_Log::encodeFrame(record, frame);
+    }
+
+    printf("=== Device model: one fall, 7 lines at %u baud ===\n", SERIAL_BAUD_RATE);
+    printf("Synchronous:  %4zu B, sampling task blocked %.1f ms (%u ms sample period)\n",
+           old_text.size(), uartStallMs(old_text.size()), SENSOR_READ_INTERVAL_MS);
+    printf("Deferred:     7 records; drain task sends %zu B text or %zu B frames\n",
+           new_text.size(), frame_bytes);
+    printf("              in %.1f / %.1f ms of UART time at idle priority\n\n",
+           new_text.size() * 10.0 * 1000.0 / SERIAL_BAUD_RATE,
+           frame_bytes * 10.0 * 1000.0 / SERIAL_BAUD_RATE);
+
+    bool same_text = old_text == new_text;
+    bool frames_ok = checkFrames();
+    bool format_ok = checkFormat();
+    uint32_t received = 0;
+    uint32_t full_retries = 0;
+    bool concurrent_ok = checkConcurrent(received, full_retries);
+
+    // No reader: the ring fills and the rest is counted, never overwritten
+    Deferred_Log::begin();
+    for (uint32_t i = 0; i < DEFERRED_LOG_RING_SIZE + 10; i++) {
+        Deferred_Log::log(DLOG_USER_RECOVERED);
+    }
+    DlogStats_t full = Deferred_Log::getStats();
+    bool overflow_ok = full.logged == DEFERRED_LOG_RING_SIZE && full.dropped == 10;
+
+    printf("Text matches Serial output:  %s\n", same_text ? "yes" : "NO");
+    printf("Frame round trip/corruption: %s\n", frames_ok ? "ok" : "FAILED");
+    printf("Format conversions:          %s\n", format_ok ? "ok" : "FAILED");
+    printf("%u producers, 1 reader:       %s (%u records, %u retries on a full ring)\n",
+           PRODUCER_THREADS, concurrent_ok ? "ok" : "FAILED", received, full_retries);
+    printf("Full ring:                   %s\n\n", overflow_ok ? "ok" : "FAILED");
+
+    if (!same_text) {
+        printf("--- Serial ---\n%s--- Deferred ---\n%s\n", old_text.c_str(), new_text.c_str());
+    }
+    if (!same_text || !frames_ok || !format_ok || !concurrent_ok || !overflow_ok) failures++;
+    if (log_cost.ns >= sync_cost.ns) {
+        printf("Deferred call is not cheaper than the synchronous print\n");
+        failures++;
+    }
+
+    fclose(sink);
+    printf(failures == 0 ? "ALL CHECKS PASSED\n" : "CHECKS FAILED\n");
+    return failures == 0 ? 0 : 1;
+}
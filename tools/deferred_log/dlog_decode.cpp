@@ -0,0 +1,108 @@
+/*
+ * SmartFall - Deferred Log Decoder
+ *
+ * Formats a Serial capture taken with DEFERRED_LOG_BINARY set. Deferred
+ * log frames are decoded with the firmware's own format table and
+ * printed as "[seconds] text"; everything else in the capture (boot
+ * banner, status reports, other modules' Serial text) passes through
+ * unchanged. Frames with a bad checksum are counted and skipped.
+ *
+ * Build (from the repository root):
+ *   g++ -std=c++17 -O2 -Itools/host -ISmartFall -o dlog_decode \
+ *       tools/deferred_log/dlog_decode.cpp SmartFall/diagnostics/Deferred_Log.cpp
+ *
+ * Usage: dlog_decode <capture.bin | -> [out.txt]
+ */
+
+#include <Arduino.h>
+#include <vector>
+#include "diagnostics/Deferred_Log.h"
+
+HostSerial Serial;
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <capture.bin | -> [out.txt]\n", argv[0]);
+        return 1;
+    }
+
+    FILE* in = strcmp(argv[1], "-") == 0 ? stdin : fopen(argv[1], "rb");
+    if (in == nullptr) {
+        fprintf(stderr, "Cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    std::vector<uint8_t> data;
+    uint8_t chunk[65536];
+    size_t got;
+    while ((got = fread(chunk, 1, sizeof(chunk), in)) > 0) {
+        data.insert(data.end(), chunk, chunk + got);
+    }
+    if (in != stdin) fclose(in);
+
+    FILE* out = stdout;
+    if (argc >= 3) {
+        out = fopen(argv[2], "w");
+        if (out == nullptr) {
+            fprintf(stderr, "Cannot create %s\n", argv[2]);
+            return 1;
+        }
+    }
+
+    uint32_t frames = 0;
+    uint32_t rejected = 0;
+    uint32_t unknown = 0;
+    uint32_t counts[DLOG_MESSAGE_COUNT] = {};
+    bool line_start = true;
+
+    size_t offset = 0;
+    while (offset < data.size()) {
+        // The sync byte never occurs in UTF-8, so text cannot start a frame
+        if (data[offset] != DLOG_FRAME_SYNC_0) {
+            fputc(data[offset], out);
+            line_start = data[offset] == '\n';
+            offset++;
+            continue;
+        }
+
+        DlogRecord_t record;
+        size_t size = Deferred_Log::decodeFrame(&data[offset], data.size() - offset, record);
+        if (size == 0) {
+            // A damaged frame is still not text: skip what its header claims
+            rejected++;
+            size_t remaining = data.size() - offset;
+            bool header = remaining >= DLOG_FRAME_HEADER_SIZE && data[offset + 1] == DLOG_FRAME_SYNC_1 &&
+                          data[offset + 4] <= DLOG_MAX_ARGS;
+            size_t claimed = header ? DLOG_FRAME_HEADER_SIZE + 4 * data[offset + 4] + 1 : 1;
+            offset += claimed < remaining ? claimed : remaining;
+            continue;
+        }
+        offset += size;
+        frames++;
+        if (record.message < DLOG_MESSAGE_COUNT) {
+            counts[record.message]++;
+        } else {
+            unknown++;
+        }
+
+        char text[DLOG_TEXT_MAX_LENGTH];
+        Deferred_Log::format(record, text, sizeof(text));
+        if (!line_start) fputc('\n', out);
+        fprintf(out, "[%11.6f] %s\n", record.timestamp_us / 1e6, text);
+        line_start = true;
+    }
+
+    if (out != stdout) fclose(out);
+
+    fprintf(stderr, "Frames: %u decoded, %u rejected, %u with unknown ids\n", frames, rejected, unknown);
+    for (uint16_t m = 0; m < DLOG_MESSAGE_COUNT; m++) {
+        if (counts[m] == 0) continue;
+        // First line of the format, for a per-message count
+        const char* format = Deferred_Log::getFormat(m);
+        if (format[0] == '\n') format++;
+        const char* end = strchr(format, '\n');
+        int length = end ? (int)(end - format) : (int)strlen(format);
+        fprintf(stderr, "  %6u  %.*s\n", counts[m], length, format);
+    }
+    return 0;
+}
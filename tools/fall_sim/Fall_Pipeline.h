@@ -0,0 +1,155 @@
+#ifndef FALL_PIPELINE_H
+#define FALL_PIPELINE_H
+
+#include <Arduino.h>
+#include "detection/fall_detector.h"
+#include "detection/confidence_scorer.h"
+#include "detection/fall_classifier.h"
+#include "sensors/Altitude_Filter.h"
+
+/*
+ * FallDetector followed by ConfidenceScorer, for host evaluation.
+ *
+ * When the detector reaches POTENTIAL_FALL, its stage metrics are scored.
+ * The filter inputs come from references taken while the detector was
+ * still monitoring:
+ *   pressure     altitude lost, from Altitude_Filter's pre-event window
+ *   heart rate   change from the pre-fall average
+ *   FSR          impact spike over the strap baseline; strap stayed on
+ *   posture      angle between the pre-fall and current gravity vectors
+ * The classifier runs on the impact window as soon as it is complete,
+ * and its probability is scored with the rest when that happened first.
+ */
+
+#define PIPELINE_REF_ALPHA        0.05f   // Reference averaging per sample
+#define PIPELINE_FSR_IMPACT_DELTA 300     // Counts over baseline that count as a strike
+#define PIPELINE_FSR_STRAP_MIN    500     // Below this the device is off the wrist
+
+typedef struct {
+    bool detected;              // Detector reached POTENTIAL_FALL
+    uint8_t score;              // ConfidenceScorer total
+    FallConfidence_t confidence;
+    uint32_t timestamp;         // Sample that completed the detection
+} FallVerdict_t;
+
+class Fall_Pipeline {
+private:
+    FallDetector detector;
+    ConfidenceScorer scorer;
+    FallClassifier classifier;
+    Altitude_Filter altitude;
+    SensorData_t window[FALL_CLASSIFIER_WINDOW];
+    FallStatus_t previous;
+    bool have_reference;
+    float ref_heart;
+    float ref_fsr;
+    float ref_gravity[3];
+    uint16_t fsr_peak;
+    uint16_t fsr_low;
+
+public:
+    Fall_Pipeline() : previous(FALL_STATUS_MONITORING), have_reference(false) {}
+
+    // Tiers are set on every begin so a reused pipeline never keeps the last run's
+    void begin(DetectionThresholds_t& thresholds, const ScoreTiers_t& tiers = DEFAULT_SCORE_TIERS) {
+        scorer.setScoreTiers(tiers);
+        detector.setThresholds(thresholds);
+        detector.init();
+        reset();
+    }
+
+    void reset() {
+        detector.resetDetection();
+        scorer.resetScore();
+        classifier.reset();
+        altitude.reset();
+        previous = FALL_STATUS_MONITORING;
+        have_reference = false;
+    }
+
+    // True on the sample that completes a detection
+    bool process(SensorData_t& data, FallVerdict_t& verdict) {
+        detector.processSensorData(data);
+        FallStatus_t status = detector.getCurrentStatus();
+        altitude.update(data);
+        altitude.observe(status);
+        if (FALL_CLASSIFIER_ENABLED && classifier.observe(status)) {
+            classifier.classify(window, detector.copyHistory(window, FALL_CLASSIFIER_WINDOW));
+        }
+
+        if (status == FALL_STATUS_MONITORING) {
+            track(data);
+        } else {
+            if (data.fsr_value > fsr_peak) fsr_peak = data.fsr_value;
+            if (data.fsr_value < fsr_low) fsr_low = data.fsr_value;
+        }
+        if (previous == FALL_STATUS_MONITORING && status != FALL_STATUS_MONITORING) {
+            fsr_peak = data.fsr_value;
+            fsr_low = data.fsr_value;
+        }
+
+        bool completed = status == FALL_STATUS_POTENTIAL_FALL && previous != FALL_STATUS_POTENTIAL_FALL;
+        previous = status;
+        if (!completed) return false;
+
+        score(data);
+        verdict.detected = true;
+        verdict.score = scorer.getTotalScore();
+        verdict.confidence = scorer.getConfidenceLevel();
+        verdict.timestamp = data.timestamp;
+        return true;
+    }
+
+    FallDetector& getDetector() { return detector; }
+    ConfidenceScorer& getScorer() { return scorer; }
+    FallClassifier& getClassifier() { return classifier; }
+    Altitude_Filter& getAltitudeFilter() { return altitude; }
+
+private:
+    void track(const SensorData_t& data) {
+        float gravity[3] = {data.accel_x, data.accel_y, data.accel_z};
+        if (!have_reference) {
+            have_reference = true;
+            ref_heart = data.heart_rate;
+            ref_fsr = data.fsr_value;
+            memcpy(ref_gravity, gravity, sizeof(ref_gravity));
+            return;
+        }
+        ref_heart += PIPELINE_REF_ALPHA * (data.heart_rate - ref_heart);
+        ref_fsr += PIPELINE_REF_ALPHA * (data.fsr_value - ref_fsr);
+        for (uint8_t i = 0; i < 3; i++) {
+            ref_gravity[i] += PIPELINE_REF_ALPHA * (gravity[i] - ref_gravity[i]);
+        }
+    }
+
+    void score(const SensorData_t& data) {
+        scorer.resetScore();
+        scorer.startScoring();
+
+        bool strike = fsr_peak > ref_fsr + PIPELINE_FSR_IMPACT_DELTA;
+        scorer.addStage1Score(detector.getFreefalDuration(), detector.getMinFreefallAccel());
+        scorer.addStage2Score(detector.getMaxImpact(), detector.getImpactTiming(), strike);
+        scorer.addStage3Score(detector.getMaxRotation(), postureChange(data));
+        scorer.addStage4Score(detector.getInactivityDuration(), true);
+
+        scorer.addPressureFilterScore(altitude.getAltitudeChange());
+        bool heart_valid = data.heart_rate > 0 && ref_heart > 0;
+        scorer.addHeartRateFilterScore(heart_valid ? data.heart_rate - ref_heart : 0);
+        scorer.addFSRFilterScore(strike, fsr_low >= PIPELINE_FSR_STRAP_MIN);
+        if (classifier.hasResult()) scorer.addClassifierScore(classifier.getProbability());
+    }
+
+    float postureChange(const SensorData_t& data) {
+        float now[3] = {data.accel_x, data.accel_y, data.accel_z};
+        float dot = 0, a = 0, b = 0;
+        for (uint8_t i = 0; i < 3; i++) {
+            dot += now[i] * ref_gravity[i];
+            a += now[i] * now[i];
+            b += ref_gravity[i] * ref_gravity[i];
+        }
+        if (a <= 0 || b <= 0) return 0;
+        return acosf(constrain(dot / sqrtf(a * b), -1.0f, 1.0f)) * (float)RAD_TO_DEG;
+    }
+};
+
+#endif // FALL_PIPELINE_H
@@ -0,0 +1,336 @@
+#include "Motion_Generator.h"
+
+#define HPA_PER_METRE      0.12f     // Pressure gradient near sea level
+#define HEART_RISE_TAU_MS  5000.0f
+#define REBOUND_MS         300.0f    // Body settling after the impact
+#define WALK_RESUME_MS     500.0f    // Pause before walking on after a jump
+#define ROTATION_DECAY_MS  150.0f    // Angular rate after the impact
+
+static float clamp01(float x) {
+    return x < 0 ? 0 : (x > 1 ? 1 : x);
+}
+
+static float clip(float x, float range) {
+    return x < -range ? -range : (x > range ? range : x);
+}
+
+static uint32_t xorshift(uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// [0, 1)
+static float unit(uint32_t& state) {
+    return (xorshift(state) >> 8) * (1.0f / 16777216.0f);
+}
+
+Motion_Generator::Motion_Generator(const MotionParams_t& motion_params, uint32_t seed)
+    : params(motion_params), plan_state(seed ? seed : 1), noise_state(1), index(0),
+      last_timestamp(0), period_ms(1000.0f / motion_params.rate_hz) {
+    memset(&event, 0, sizeof(event));
+    ranger.setSampleRate(params.rate_hz);
+}
+
+void Motion_Generator::defaultParams(MotionParams_t& p) {
+    p.rate_hz = SENSOR_SAMPLE_RATE_HZ;
+    p.jitter_ms = 1.0f;
+    p.noise_g = 0.02f;
+    p.noise_dps = 1.0f;
+    p.bias_g = 0.05f;
+    p.bias_dps = 3.0f;
+    p.accel_range_g = ACCEL_RANGE_LOW_G;
+    p.accel_autorange = ACCEL_AUTORANGE_ENABLED;   // As configured by MPU6050_Sensor::configure()
+    p.gyro_range_dps = 1000.0f;
+    p.lead_ms = 3000;
+    p.tail_ms = 12000;              // Past inactivity and the detection window
+}
+
+void Motion_Generator::plan(MotionScenario_t scenario, uint32_t start_ms) {
+    MotionEvent_t& e = event;
+    memset(&e, 0, sizeof(e));
+    e.scenario = scenario;
+    e.fall = isFall(scenario);
+    e.start_ms = start_ms;
+
+    // Which way the wrist ends up, before the scenario narrows it down
+    float side = (xorshift(plan_state) & 1) ? 1.0f : -1.0f;
+    e.tilt_dir[0] = 1.0f;
+    e.tilt_dir[1] = 0.0f;
+
+    switch (scenario) {
+        case MOTION_FALL_FORWARD:
+        case MOTION_FALL_BACKWARD:
+        case MOTION_FALL_LATERAL:
+            e.descent_ms = uniform(550, 900);
+            e.freefall_ms = uniform(150, 450);
+            e.freefall_g = uniform(0.15f, 0.6f);
+            e.impact_g = uniform(3.0f, 9.0f);
+            e.impact_ms = uniform(40, 100);
+            e.rotation_dps = uniform(200, 550);
+            e.tilt_deg = uniform(70, 100);
+            e.height_m = uniform(0.6f, 1.1f);
+            e.heart_rise_bpm = uniform(5, 30);
+            if (scenario == MOTION_FALL_BACKWARD) {
+                e.tilt_dir[0] = -1.0f;
+            } else if (scenario == MOTION_FALL_LATERAL) {
+                e.tilt_dir[0] = 0.0f;
+                e.tilt_dir[1] = side;
+            }
+            break;
+
+        case MOTION_FALL_FROM_CHAIR:
+            e.descent_ms = uniform(400, 700);
+            e.freefall_ms = uniform(80, 300);
+            e.freefall_g = uniform(0.3f, 0.7f);
+            e.impact_g = uniform(2.0f, 6.0f);
+            e.impact_ms = uniform(50, 110);
+            e.rotation_dps = uniform(120, 400);
+            e.tilt_deg = uniform(45, 90);
+            e.tilt_dir[0] = side;
+            e.height_m = uniform(0.3f, 0.6f);
+            e.heart_rise_bpm = uniform(5, 25);
+            break;
+
+        case MOTION_FALL_FROM_BED:
+            e.descent_ms = uniform(300, 500);
+            e.freefall_ms = uniform(60, 250);
+            e.freefall_g = uniform(0.35f, 0.75f);
+            e.impact_g = uniform(1.8f, 4.5f);
+            e.impact_ms = uniform(50, 120);
+            e.rotation_dps = uniform(100, 350);
+            e.tilt_deg = uniform(70, 100);
+            e.tilt_dir[0] = 0.0f;
+            e.tilt_dir[1] = side;
+            e.height_m = uniform(0.4f, 0.7f);
+            e.heart_rise_bpm = uniform(5, 25);
+            break;
+
+        case MOTION_ADL_SIT_HARD:
+            e.descent_ms = uniform(400, 700);
+            e.freefall_ms = uniform(50, 200);
+            e.freefall_g = uniform(0.5f, 0.8f);
+            e.impact_g = uniform(1.8f, 3.5f);
+            e.impact_ms = uniform(60, 120);
+            e.rotation_dps = uniform(40, 180);
+            e.tilt_deg = uniform(0, 30);
+            e.height_m = uniform(0.3f, 0.5f);
+            break;
+
+        case MOTION_ADL_JUMP:
+            e.pushoff_ms = uniform(150, 250);
+            e.pushoff_g = uniform(1.6f, 2.4f);
+            e.descent_ms = uniform(250, 450);
+            e.freefall_ms = e.descent_ms;
+            e.freefall_g = uniform(0.02f, 0.3f);
+            e.impact_g = uniform(2.5f, 6.0f);
+            e.impact_ms = uniform(60, 120);
+            e.rotation_dps = uniform(20, 120);
+            e.tilt_deg = uniform(0, 15);
+            e.heart_rise_bpm = uniform(5, 15);
+            e.walks_after = true;
+            break;
+
+        case MOTION_ADL_DEVICE_DROP: {
+            // Dropped from hand height: ballistic, hard landing, tumbling
+            e.height_m = uniform(0.7f, 1.3f);
+            e.descent_ms = sqrtf(2.0f * e.height_m / 9.81f) * 1000.0f;
+            e.freefall_ms = e.descent_ms;
+            e.freefall_g = uniform(0.0f, 0.08f);
+            e.impact_g = uniform(6.0f, 25.0f);
+            e.impact_ms = uniform(5, 20);
+            e.rotation_dps = uniform(300, 1500);
+            e.tilt_deg = uniform(0, 180);
+            float heading = uniform(0, 2 * M_PI);
+            e.tilt_dir[0] = cosf(heading);
+            e.tilt_dir[1] = sinf(heading);
+            e.detached = true;
+            break;
+        }
+
+        case MOTION_ADL_WALK:
+        default:
+            e.walks_after = true;
+            break;
+    }
+
+    e.gait_hz = uniform(1.6f, 2.1f);
+    for (uint8_t i = 0; i < 3; i++) {
+        e.accel_bias[i] = uniform(-params.bias_g, params.bias_g);
+        e.gyro_bias[i] = uniform(-params.bias_dps, params.bias_dps);
+    }
+    e.pressure_base = uniform(980.0f, 1030.0f);
+    e.heart_base = uniform(60.0f, 90.0f);
+    e.strap_fsr = uniform(1500.0f, 2500.0f);
+    e.seed = xorshift(plan_state) | 1;
+
+    float length_ms = params.lead_ms + e.descent_ms + e.impact_ms + params.tail_ms;
+    e.samples = (uint32_t)(length_ms / period_ms);
+
+    beginSource();
+}
+
+bool Motion_Generator::isFall(MotionScenario_t scenario) {
+    return scenario <= MOTION_FALL_FROM_BED;
+}
+
+const char* Motion_Generator::getScenarioName(MotionScenario_t scenario) {
+    switch (scenario) {
+        case MOTION_FALL_FORWARD:     return "fall forward";
+        case MOTION_FALL_BACKWARD:    return "fall backward";
+        case MOTION_FALL_LATERAL:     return "fall lateral";
+        case MOTION_FALL_FROM_CHAIR:  return "fall from chair";
+        case MOTION_FALL_FROM_BED:    return "fall from bed";
+        case MOTION_ADL_SIT_HARD:     return "sit down hard";
+        case MOTION_ADL_JUMP:         return "jump";
+        case MOTION_ADL_DEVICE_DROP:  return "device drop";
+        case MOTION_ADL_WALK:         return "walk";
+        default:                      return "unknown";
+    }
+}
+
+bool Motion_Generator::beginSource() {
+    index = 0;
+    last_timestamp = 0;
+    noise_state = event.seed;
+    ranger.reset();
+    return event.samples > 0;
+}
+
+bool Motion_Generator::readSample(SensorData_t& data) {
+    if (index >= event.samples) return false;
+
+    // Jittered sample instant; physics is evaluated at the real time
+    float t_ms = index * period_ms + (2.0f * unit(noise_state) - 1.0f) * params.jitter_ms;
+    if (t_ms < 0) t_ms = 0;
+
+    uint32_t timestamp = event.start_ms + (uint32_t)(t_ms + 0.5f);
+    if (index > 0 && timestamp <= last_timestamp) {
+        timestamp = last_timestamp + 1;
+    }
+    last_timestamp = timestamp;
+    index++;
+
+    render(t_ms, data);
+    data.timestamp = timestamp;
+    data.valid = true;
+    return true;
+}
+
+// Private helper functions
+
+float Motion_Generator::uniform(float low, float high) {
+    return low + (high - low) * unit(plan_state);
+}
+
+float Motion_Generator::gaussian() {
+    // Sum of four uniforms: cheap, smooth enough for sensor noise
+    float sum = 0;
+    for (uint8_t i = 0; i < 4; i++) {
+        sum += unit(noise_state);
+    }
+    return (sum - 2.0f) * 1.7320508f;
+}
+
+void Motion_Generator::render(float t_ms, SensorData_t& data) {
+    const MotionEvent_t& e = event;
+    float u = t_ms - params.lead_ms;           // Time since the onset
+    float impact_at = e.descent_ms;
+    float settled_at = impact_at + e.impact_ms;
+
+    // Posture swings from upright to the final one over the descent
+    float s = (e.descent_ms > 0) ? clamp01(u / e.descent_ms) : 0;
+    s = s * s * (3.0f - 2.0f * s);
+    float tilt = e.tilt_deg * (float)DEG_TO_RAD * s;
+    float lean = sinf(tilt);
+    float up[3] = {lean * e.tilt_dir[0], lean * e.tilt_dir[1], cosf(tilt)};
+
+    // Specific force along the body's up axis
+    float magnitude = 1.0f;
+    float impact_pulse = 0;
+    if (u < 0) {
+        if (u >= -e.pushoff_ms) magnitude = e.pushoff_g;
+    } else if (u < impact_at) {
+        float ramp = e.descent_ms - e.freefall_ms;
+        magnitude = (u < ramp) ? 1.0f + (e.freefall_g - 1.0f) * (u / ramp) : e.freefall_g;
+    } else if (u < settled_at) {
+        impact_pulse = sinf((float)M_PI * (u - impact_at) / e.impact_ms);
+        magnitude = 1.0f + (e.impact_g - 1.0f) * impact_pulse;
+    } else if (u < settled_at + REBOUND_MS && e.descent_ms > 0) {
+        float r = u - settled_at;
+        magnitude = 1.0f + 0.3f * expf(-r / 80.0f) * sinf(2.0f * (float)M_PI * r / 120.0f);
+    }
+
+    bool walking = e.scenario == MOTION_ADL_WALK ||
+                   (e.walks_after && u > settled_at + WALK_RESUME_MS);
+    bool resting = e.detached && u >= settled_at;
+
+    float accel[3] = {up[0] * magnitude, up[1] * magnitude, up[2] * magnitude};
+    float gyro[3] = {0, 0, 0};
+
+    // Rotation builds up to the impact and dies away as the body settles
+    if (u >= 0 && e.descent_ms > 0) {
+        float rate;
+        if (u < impact_at) {
+            float rise = sinf(0.5f * (float)M_PI * u / impact_at);
+            rate = e.rotation_dps * rise * rise;
+        } else {
+            rate = e.rotation_dps * expf(-(u - impact_at) / ROTATION_DECAY_MS);
+        }
+        gyro[0] = -e.tilt_dir[1] * rate;
+        gyro[1] = e.tilt_dir[0] * rate;
+    }
+
+    if (walking) {
+        float phase = 2.0f * (float)M_PI * e.gait_hz * t_ms / 1000.0f;
+        accel[0] += 0.3f * sinf(0.5f * phase);
+        accel[2] += 0.25f * sinf(phase);
+        gyro[1] += 50.0f * sinf(0.5f * phase);
+    } else if (!resting) {
+        accel[2] += 0.01f * sinf(2.0f * (float)M_PI * 0.25f * t_ms / 1000.0f);  // Breathing
+    }
+
+    float sensed[3];
+    for (uint8_t i = 0; i < 3; i++) {
+        sensed[i] = accel[i] + e.accel_bias[i] + params.noise_g * gaussian();
+    }
+    if (params.accel_autorange) {
+        // Read at the current scale; the ranger sets the next one
+        uint8_t range_g = ranger.getRange();
+        int16_t raw[3];
+        for (uint8_t i = 0; i < 3; i++) {
+            raw[i] = Accel_Ranger::toCounts(sensed[i], range_g);
+        }
+        data.accel_x = Accel_Ranger::toG(raw[0], range_g);
+        data.accel_y = Accel_Ranger::toG(raw[1], range_g);
+        data.accel_z = Accel_Ranger::toG(raw[2], range_g);
+        data.accel_range_g = range_g;
+        ranger.update(raw);
+    } else {
+        data.accel_x = clip(sensed[0], params.accel_range_g);
+        data.accel_y = clip(sensed[1], params.accel_range_g);
+        data.accel_z = clip(sensed[2], params.accel_range_g);
+        data.accel_range_g = (uint8_t)params.accel_range_g;
+    }
+    data.accel_peak_g = 0;             // Point samples; no peak held between them
+    data.accel_peak_clipped = false;
+    data.gyro_peak_dps = 0;
+    data.gyro_x = clip(gyro[0] + e.gyro_bias[0] + params.noise_dps * gaussian(), params.gyro_range_dps);
+    data.gyro_y = clip(gyro[1] + e.gyro_bias[1] + params.noise_dps * gaussian(), params.gyro_range_dps);
+    data.gyro_z = clip(gyro[2] + e.gyro_bias[2] + params.noise_dps * gaussian(), params.gyro_range_dps);
+
+    data.pressure = e.pressure_base + HPA_PER_METRE * e.height_m * s + 0.015f * gaussian();
+
+    // Off the wrist there is no pulse and no strap pressure
+    if (e.detached && u >= 0) {
+        data.heart_rate = 0;
+        data.fsr_value = (uint16_t)(15.0f + 5.0f * clamp01(0.5f + gaussian()));
+    } else {
+        float rise = (u > 0) ? e.heart_rise_bpm * (1.0f - expf(-u / HEART_RISE_TAU_MS)) : 0;
+        data.heart_rate = e.heart_base + rise + 0.5f * gaussian();
+        float fsr = e.strap_fsr + 10.0f * gaussian();
+        if (e.fall) fsr += 150.0f * e.impact_g * impact_pulse;   // Wrist strikes the floor
+        data.fsr_value = (uint16_t)constrain(fsr, 0.0f, 4095.0f);
+    }
+}
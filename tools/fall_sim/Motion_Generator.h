@@ -0,0 +1,120 @@
+#ifndef MOTION_GENERATOR_H
+#define MOTION_GENERATOR_H
+
+#include <Arduino.h>
+#include "sensors/Sample_Source.h"
+#include "sensors/Accel_Ranger.h"
+#include "utils/config.h"
+
+/*
+ * Parametric wrist-motion generator for detector evaluation on the host.
+ *
+ * plan() draws one labelled event: a fall (forward, backward, lateral,
+ * from a chair or a bed) or an activity of daily living that looks
+ * like one (sitting down hard, jumping, dropping the device, walking).
+ * Each event gets its own descent, freefall depth, impact, rotation,
+ * final posture and altitude loss from the scenario's ranges, plus a
+ * per-event sensor bias. read() then renders the event sample by sample
+ * with white noise, sample-time jitter and sensor clipping, in the units
+ * of SensorData_t. With accel_autorange the accelerometer is read as the
+ * device reads it: quantized to counts at the scale Accel_Ranger picks.
+ *
+ * Everything comes from one seed, so an event can be replayed exactly
+ * with begin().
+ */
+
+typedef enum {
+    MOTION_FALL_FORWARD,
+    MOTION_FALL_BACKWARD,
+    MOTION_FALL_LATERAL,
+    MOTION_FALL_FROM_CHAIR,
+    MOTION_FALL_FROM_BED,
+    MOTION_ADL_SIT_HARD,
+    MOTION_ADL_JUMP,
+    MOTION_ADL_DEVICE_DROP,
+    MOTION_ADL_WALK,
+    MOTION_SCENARIO_COUNT
+} MotionScenario_t;
+
+typedef struct {
+    uint16_t rate_hz;           // Nominal sample rate
+    float jitter_ms;            // Sample time jitter, uniform +/-
+    float noise_g;              // Accelerometer white noise (1 sigma)
+    float noise_dps;            // Gyro white noise (1 sigma)
+    float bias_g;               // Per-event accelerometer bias, up to +/- per axis
+    float bias_dps;             // Per-event gyro bias, up to +/- per axis
+    float accel_range_g;        // Full scale; readings clip here
+    bool accel_autorange;       // Accel_Ranger picks the scale instead
+    float gyro_range_dps;
+    uint32_t lead_ms;           // Recorded before the onset
+    uint32_t tail_ms;           // Recorded after the impact
+} MotionParams_t;
+
+typedef struct {
+    MotionScenario_t scenario;
+    bool fall;                  // Ground truth label
+    uint32_t start_ms;          // Timestamp of the first sample
+    uint32_t samples;           // Event length in samples
+
+    float pushoff_ms;           // Take-off before the onset (jump)
+    float pushoff_g;
+    float descent_ms;           // Onset to impact
+    float freefall_ms;          // Final part of the descent near freefall
+    float freefall_g;           // Acceleration magnitude while falling
+    float impact_g;             // Peak of the impact pulse
+    float impact_ms;            // Impact pulse width
+    float rotation_dps;         // Peak angular rate during the descent
+    float tilt_deg;             // Posture change, upright to final
+    float tilt_dir[2];          // Horizontal direction of the tilt (unit)
+    float height_m;             // Altitude lost
+    float heart_rise_bpm;       // Heart rate rise after the event
+    float gait_hz;              // Step rate when walking
+    bool detached;              // Device left the wrist
+    bool walks_after;           // Carries on walking after the event
+
+    float accel_bias[3];
+    float gyro_bias[3];
+    float pressure_base;        // hPa
+    float heart_base;           // BPM
+    float strap_fsr;            // FSR counts with the strap on
+    uint32_t seed;              // Noise stream for this event
+} MotionEvent_t;
+
+class Motion_Generator : public Sample_Source<Motion_Generator> {
+    friend class Sample_Source<Motion_Generator>;
+
+private:
+    MotionParams_t params;
+    MotionEvent_t event;
+    uint32_t plan_state;        // Draws event parameters
+    uint32_t noise_state;       // Draws per-sample noise
+    uint32_t index;
+    uint32_t last_timestamp;
+    float period_ms;
+    Accel_Ranger ranger;
+
+public:
+    Motion_Generator(const MotionParams_t& params, uint32_t seed);
+
+    static void defaultParams(MotionParams_t& params);
+
+    // Draws the next event; read() renders it from begin()
+    void plan(MotionScenario_t scenario, uint32_t start_ms);
+    const MotionEvent_t& getEvent() { return event; }
+    Accel_Ranger& getRanger() { return ranger; }
+
+    static bool isFall(MotionScenario_t scenario);
+    static const char* getScenarioName(MotionScenario_t scenario);
+
+private:
+    bool beginSource();
+    bool readSample(SensorData_t& data);
+    const char* sourceName() { return "motion"; }
+
+    // Private helper functions
+    float uniform(float low, float high);      // Event parameters
+    float gaussian();                          // Sample noise
+    void render(float t_ms, SensorData_t& data);
+};
+
+#endif // MOTION_GENERATOR_H
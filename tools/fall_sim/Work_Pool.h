@@ -0,0 +1,102 @@
+#ifndef WORK_POOL_H
+#define WORK_POOL_H
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * Work-stealing thread pool for the host sweep tools.
+ *
+ * run() deals the tasks out in contiguous runs, one run per worker
+ * queue. A worker takes from the back of its own queue. When that is
+ * empty it steals from the front of the others, so workers that get
+ * cheap tasks help out on the expensive ones. The calling thread works
+ * as worker 0. Tasks receive their worker index for per-thread scratch.
+ */
+
+class Work_Pool {
+public:
+    typedef std::function<void(unsigned worker)> Task_t;
+
+private:
+    struct Worker_Queue {
+        std::mutex lock;
+        std::deque<Task_t*> tasks;
+    };
+
+    unsigned thread_count;
+    std::vector<std::unique_ptr<Worker_Queue>> queues;
+    std::atomic<size_t> remaining;
+    std::atomic<uint64_t> steals;
+
+public:
+    explicit Work_Pool(unsigned threads)
+        : thread_count(threads ? threads : 1), remaining(0), steals(0) {
+        for (unsigned i = 0; i < thread_count; i++) {
+            queues.emplace_back(new Worker_Queue());
+        }
+    }
+
+    unsigned getThreadCount() { return thread_count; }
+    uint64_t getSteals() { return steals.load(); }
+
+    // Returns once every task has run
+    void run(std::vector<Task_t>& tasks) {
+        remaining = tasks.size();
+        size_t per_worker = (tasks.size() + thread_count - 1) / thread_count;
+        for (size_t i = 0; i < tasks.size(); i++) {
+            queues[i / per_worker]->tasks.push_back(&tasks[i]);
+        }
+
+        std::vector<std::thread> workers;
+        for (unsigned w = 1; w < thread_count; w++) {
+            workers.emplace_back([this, w] { work(w); });
+        }
+        work(0);
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+private:
+    void work(unsigned worker) {
+        Task_t* task;
+        while (remaining.load() > 0) {
+            if (popLocal(worker, task) || steal(worker, task)) {
+                (*task)(worker);
+                remaining--;
+            } else {
+                std::this_thread::yield();   // Last tasks are still running elsewhere
+            }
+        }
+    }
+
+    bool popLocal(unsigned worker, Task_t*& task) {
+        Worker_Queue& queue = *queues[worker];
+        std::lock_guard<std::mutex> guard(queue.lock);
+        if (queue.tasks.empty()) return false;
+        task = queue.tasks.back();
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(unsigned worker, Task_t*& task) {
+        for (unsigned i = 1; i < thread_count; i++) {
+            Worker_Queue& victim = *queues[(worker + i) % thread_count];
+            std::lock_guard<std::mutex> guard(victim.lock);
+            if (victim.tasks.empty()) continue;
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            steals++;
+            return true;
+        }
+        return false;
+    }
+};
+
+#endif // WORK_POOL_H
@@ -0,0 +1,306 @@
+/*
+ * SmartFall - Barometric Altitude Evaluation
+ *
+ * Measures how well each altitude-change estimate recovers the height
+ * lost in an event when the weather does not hold still:
+ *   boot      pressure now against the pressure at boot (the old
+ *             BMP280_Sensor::getAltitudeChange())
+ *   EMA       fast per-sample EMA frozen while the detector is busy
+ *             (the old Fall_Pipeline reference)
+ *   window    Altitude_Filter, barometer only
+ *   Kalman    Altitude_Filter fusing vertical acceleration
+ *
+ * Each Motion_Generator event happens 1 to 12 hours after boot, in a
+ * weather front moving the pressure by up to WEATHER_HPA_PER_H, with a
+ * ventilation square wave of up to HVAC_HPA on top. The filters see
+ * LEAD_S of the wearer at rest before it. The estimates are read when
+ * the detector completes a potential fall, as Fall_Pipeline scores
+ * them, and compared with the event's true altitude loss. The tool also
+ * times Altitude_Filter::update() in both modes.
+ *
+ * Build (from the repository root):
+ *   g++ -std=c++17 -O2 -Itools/host -ISmartFall -o altitude_eval \
+ *       tools/fall_sim/altitude_eval.cpp tools/fall_sim/Motion_Generator.cpp \
+ *       SmartFall/sensors/Accel_Ranger.cpp SmartFall/sensors/Altitude_Filter.cpp \
+ *       SmartFall/detection/fall_detector.cpp SmartFall/diagnostics/Deferred_Log.cpp
+ *
+ * Usage: altitude_eval [events_per_scenario] [seed]
+ */
+
+#include <Arduino.h>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include "Motion_Generator.h"
+#include "sensors/Altitude_Filter.h"
+#include "detection/fall_detector.h"
+
+HostSerial Serial;
+
+#define DEFAULT_EVENTS        100
+#define DEFAULT_SEED          1
+#define LEAD_S                600       // At rest before each event (ten baseline time constants)
+#define WEATHER_HPA_PER_H     1.0f      // Steady front, either way
+#define HVAC_HPA              0.3f      // Largest ventilation swing, peak to peak
+#define HVAC_PERIOD_MIN_S     60.0f
+#define HVAC_PERIOD_MAX_S     600.0f
+#define NOISE_HPA             0.015f    // As Motion_Generator
+#define OLD_REF_ALPHA         0.05f     // Fall_Pipeline before Altitude_Filter
+#define OLD_METRES_PER_HPA    8.3f
+#define MAX_FILTER_ERROR_M    0.1f      // Mean error allowed for Altitude_Filter
+#define TIMING_SAMPLES        2000000
+
+typedef enum {
+    EST_BOOT,
+    EST_EMA,
+    EST_WINDOW,
+    EST_KALMAN,
+    EST_COUNT
+} Estimate_t;
+
+static const char* ESTIMATE_NAMES[EST_COUNT] = {"boot", "EMA", "window", "Kalman"};
+
+typedef struct {
+    float hours;                // Since boot
+    float slope_hpa_s;
+    float hvac_hpa;             // Peak to peak
+    float hvac_period_s;
+    float hvac_phase;           // Fraction of a period
+} Weather_t;
+
+static uint32_t rng_state = 1;
+
+static float unit() {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return (rng_state >> 8) * (1.0f / 16777216.0f);
+}
+
+static float uniform(float low, float high) {
+    return low + (high - low) * unit();
+}
+
+static float gaussian() {
+    float sum = 0;
+    for (uint8_t i = 0; i < 4; i++) sum += unit();
+    return (sum - 2.0f) * 1.7320508f;
+}
+
+static double elapsedSeconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Pressure offset from weather and ventilation, t seconds after the event starts
+static float ambient(const Weather_t& w, float t) {
+    float cycle = t / w.hvac_period_s + w.hvac_phase;
+    float hvac = (cycle - floorf(cycle) < 0.5f) ? 0.5f * w.hvac_hpa : -0.5f * w.hvac_hpa;
+    return w.slope_hpa_s * t + hvac;
+}
+
+// Every estimator over one event; false when the detector never completed
+class Estimators {
+private:
+    Altitude_Filter window;
+    Altitude_Filter kalman;
+    float boot_hpa;
+    float ema_hpa;
+    bool ema_started;
+    float recent[SENSOR_SAMPLE_RATE_HZ];    // Last second, for the boot estimate
+    uint16_t recent_head;
+
+public:
+    Estimators() : window(false), kalman(true) {}
+
+    void begin(float boot_pressure) {
+        window.reset();
+        kalman.reset();
+        boot_hpa = boot_pressure;
+        ema_started = false;
+        for (uint16_t i = 0; i < SENSOR_SAMPLE_RATE_HZ; i++) recent[i] = boot_pressure;
+        recent_head = 0;
+    }
+
+    // True on the sample the detector completes a potential fall
+    bool update(const SensorData_t& data, FallStatus_t status) {
+        window.update(data);
+        kalman.update(data);
+        recent[recent_head] = data.pressure;
+        recent_head = (recent_head + 1) % SENSOR_SAMPLE_RATE_HZ;
+        if (status == FALL_STATUS_MONITORING) {
+            ema_hpa = ema_started ? ema_hpa + OLD_REF_ALPHA * (data.pressure - ema_hpa) : data.pressure;
+            ema_started = true;
+        }
+        window.observe(status);
+        return kalman.observe(status);
+    }
+
+    void read(const SensorData_t& data, float* estimates) {
+        float mean = 0;
+        for (uint16_t i = 0; i < SENSOR_SAMPLE_RATE_HZ; i++) mean += recent[i];
+        mean /= SENSOR_SAMPLE_RATE_HZ;
+        estimates[EST_BOOT] = (mean - boot_hpa) * ALTITUDE_SCALE_HEIGHT_M / mean;
+        estimates[EST_EMA] = (data.pressure - ema_hpa) * OLD_METRES_PER_HPA;
+        estimates[EST_WINDOW] = window.getAltitudeChange();
+        estimates[EST_KALMAN] = kalman.getAltitudeChange();
+    }
+};
+
+static void printErrors(const char* name, std::vector<float>* errors) {
+    printf("%-8s", name);
+    for (uint8_t k = 0; k < EST_COUNT; k++) {
+        std::vector<float>& e = errors[k];
+        if (e.empty()) {
+            printf(" %23s", "-");
+            continue;
+        }
+        double sum = 0, bias = 0;
+        for (float x : e) {
+            sum += fabsf(x);
+            bias += x;
+        }
+        std::vector<float> sorted(e.size());
+        for (size_t i = 0; i < e.size(); i++) sorted[i] = fabsf(e[i]);
+        std::sort(sorted.begin(), sorted.end());
+        printf(" %7.3f %7.3f %7.3f", sum / e.size(), bias / e.size(), sorted[sorted.size() * 95 / 100]);
+    }
+    printf("\n");
+}
+
+static double meanAbs(const std::vector<float>& e) {
+    double sum = 0;
+    for (float x : e) sum += fabsf(x);
+    return e.empty() ? 0 : sum / e.size();
+}
+
+int main(int argc, char** argv) {
+    uint32_t events = argc > 1 ? (uint32_t)atoi(argv[1]) : DEFAULT_EVENTS;
+    uint32_t seed = argc > 2 ? (uint32_t)atoi(argv[2]) : DEFAULT_SEED;
+    if (events == 0) events = DEFAULT_EVENTS;
+    rng_state = seed ? seed : 1;
+    Serial.stream = nullptr;   // Detector debug output
+
+    MotionParams_t params;
+    Motion_Generator::defaultParams(params);
+    Motion_Generator generator(params, seed);
+
+    DetectionThresholds_t thresholds = {FREEFALL_THRESHOLD_G, IMPACT_THRESHOLD_G,
+                                        ROTATION_THRESHOLD_DPS, INACTIVITY_THRESHOLD_MS,
+                                        PRESSURE_CHANGE_THRESHOLD_M};
+    static FallDetector detector;
+    detector.setThresholds(thresholds);
+    detector.init();
+    static Estimators estimators;
+
+    printf("Events: %u per scenario, seed %u; fronts up to %.1f hPa/h, ventilation up to %.2f hPa\n\n",
+           events, seed, WEATHER_HPA_PER_H, HVAC_HPA);
+
+    std::vector<float> scenario_errors[MOTION_SCENARIO_COUNT][EST_COUNT];
+    std::vector<float> fall_errors[EST_COUNT], adl_errors[EST_COUNT];
+    uint32_t completed = 0, planned = 0;
+    uint32_t clock_ms = LEAD_S * 1000;
+    float period_s = 1.0f / SENSOR_SAMPLE_RATE_HZ;
+
+    for (uint32_t n = 0; n < events; n++) {
+        for (uint8_t s = 0; s < MOTION_SCENARIO_COUNT; s++) {
+            generator.plan((MotionScenario_t)s, clock_ms);
+            const MotionEvent_t& e = generator.getEvent();
+            planned++;
+
+            Weather_t w;
+            w.hours = uniform(1.0f, 12.0f);
+            w.slope_hpa_s = uniform(-WEATHER_HPA_PER_H, WEATHER_HPA_PER_H) / 3600.0f;
+            w.hvac_hpa = uniform(0.0f, HVAC_HPA);
+            w.hvac_period_s = uniform(HVAC_PERIOD_MIN_S, HVAC_PERIOD_MAX_S);
+            w.hvac_phase = unit();
+            estimators.begin(e.pressure_base + ambient(w, -3600.0f * w.hours));
+            detector.resetDetection();
+
+            // The wearer at rest, then the event
+            SensorData_t data;
+            memset(&data, 0, sizeof(data));
+            for (uint32_t i = 0; i < LEAD_S * SENSOR_SAMPLE_RATE_HZ; i++) {
+                float t = -(float)LEAD_S + i * period_s;
+                data.accel_x = e.accel_bias[0] + params.noise_g * gaussian();
+                data.accel_y = e.accel_bias[1] + params.noise_g * gaussian();
+                data.accel_z = 1.0f + e.accel_bias[2] + params.noise_g * gaussian();
+                data.pressure = e.pressure_base + ambient(w, t) + NOISE_HPA * gaussian();
+                data.timestamp = clock_ms - LEAD_S * 1000 + i * (1000 / SENSOR_SAMPLE_RATE_HZ);
+                data.valid = true;
+                estimators.update(data, FALL_STATUS_MONITORING);
+            }
+
+            float estimates[EST_COUNT];
+            bool scored = false;
+            while (generator.read(data)) {
+                data.pressure += ambient(w, (data.timestamp - clock_ms) / 1000.0f);
+                detector.processSensorData(data);
+                if (estimators.update(data, detector.getCurrentStatus()) && !scored) {
+                    estimators.read(data, estimates);
+                    scored = true;
+                }
+            }
+            clock_ms = data.timestamp + LEAD_S * 1000;
+            if (!scored) continue;
+
+            completed++;
+            for (uint8_t k = 0; k < EST_COUNT; k++) {
+                float error = estimates[k] - e.height_m;
+                scenario_errors[s][k].push_back(error);
+                (e.fall ? fall_errors : adl_errors)[k].push_back(error);
+            }
+        }
+    }
+
+    printf("Completed detections: %u of %u events; error against the true altitude loss (m)\n\n",
+           completed, planned);
+    printf("%-16s", "");
+    for (uint8_t k = 0; k < EST_COUNT; k++) printf(" %-23s", ESTIMATE_NAMES[k]);
+    printf("\n%-16s", "Scenario");
+    for (uint8_t k = 0; k < EST_COUNT; k++) printf(" %7s %7s %7s", "|err|", "bias", "p95");
+    printf("\n");
+    for (uint8_t s = 0; s < MOTION_SCENARIO_COUNT; s++) {
+        if (scenario_errors[s][0].empty()) continue;
+        char label[24];
+        snprintf(label, sizeof(label), "%-16s", Motion_Generator::getScenarioName((MotionScenario_t)s));
+        printErrors(label, scenario_errors[s]);
+    }
+    printErrors("all falls       ", fall_errors);
+    printErrors("all ADLs        ", adl_errors);
+
+    // Update cost per sample, both modes
+    double update_ns[2];
+    for (uint8_t mode = 0; mode < 2; mode++) {
+        Altitude_Filter filter(mode == 1);
+        SensorData_t sample;
+        memset(&sample, 0, sizeof(sample));
+        sample.valid = true;
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < TIMING_SAMPLES; i++) {
+            sample.accel_z = 1.0f + 0.001f * (i & 15);
+            sample.pressure = 1013.0f + 0.01f * (i & 7);
+            filter.update(sample);
+        }
+        update_ns[mode] = 1e9 * elapsedSeconds(start) / TIMING_SAMPLES;
+        if (filter.getEvents() != 0) return 1;   // Keeps the loop from being optimised out
+    }
+    printf("\nAltitude_Filter::update(): %.1f ns window, %.1f ns Kalman per sample on the host\n",
+           update_ns[0], update_ns[1]);
+
+    double boot_error = meanAbs(fall_errors[EST_BOOT]);
+    double window_error = meanAbs(fall_errors[EST_WINDOW]);
+    double kalman_error = meanAbs(fall_errors[EST_KALMAN]);
+    bool detected_ok = !fall_errors[EST_KALMAN].empty();
+    bool window_ok = detected_ok && window_error <= MAX_FILTER_ERROR_M;
+    bool kalman_ok = detected_ok && kalman_error <= MAX_FILTER_ERROR_M;
+    bool boot_ok = boot_error > 10 * window_error;
+
+    printf("\nFalls detected:                   %s\n", detected_ok ? "ok" : "FAILED");
+    printf("Window mean error <= %.1f m:       %s\n", MAX_FILTER_ERROR_M, window_ok ? "ok" : "FAILED");
+    printf("Kalman mean error <= %.1f m:       %s\n", MAX_FILTER_ERROR_M, kalman_ok ? "ok" : "FAILED");
+    printf("Boot baseline 10x worse:          %s\n", boot_ok ? "ok" : "FAILED");
+    bool ok = detected_ok && window_ok && kalman_ok && boot_ok;
+
+    printf("\n%s\n", ok ? "ALL CHECKS PASSED" : "CHECKS FAILED");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,256 @@
+/*
+ * SmartFall - Synthetic Fall / ADL Evaluation
+ *
+ * Generates labelled wrist-motion events with Motion_Generator (falls
+ * forward, backward, lateral, from a chair and from a bed; sitting down
+ * hard, jumping, dropping the device, walking) and runs each through the
+ * device FallDetector and ConfidenceScorer (Fall_Pipeline.h). Reports,
+ * per scenario, how often the detector fired and how the scores fall
+ * against the confidence thresholds, then sensitivity and false alarms
+ * at each threshold. Also reports generator and pipeline throughput and
+ * checks that events replay exactly, timestamps stay monotonic under
+ * jitter and readings respect the sensor ranges.
+ *
+ * Optionally writes one event of each scenario as CSV in the log_decode
+ * format, for pipeline_bench or alert_bench.
+ *
+ * Build (from the repository root):
+ *   g++ -std=c++17 -O2 -Itools/host -ISmartFall -o fall_eval \
+ *       tools/fall_sim/fall_eval.cpp tools/fall_sim/Motion_Generator.cpp \
+ *       SmartFall/sensors/Accel_Ranger.cpp SmartFall/detection/fall_detector.cpp \
+ *       SmartFall/detection/confidence_scorer.cpp SmartFall/detection/fall_classifier.cpp \
+ *       SmartFall/sensors/Altitude_Filter.cpp SmartFall/diagnostics/Deferred_Log.cpp
+ *
+ * Usage: fall_eval [events_per_scenario] [seed] [trace.csv]
+ */
+
+#include <Arduino.h>
+#include <chrono>
+#include <vector>
+#include "Motion_Generator.h"
+#include "Fall_Pipeline.h"
+
+HostSerial Serial;
+
+#define DEFAULT_EVENTS      500
+#define DEFAULT_SEED        1
+#define EVENT_GAP_MS        1000       // Between consecutive events' timestamps
+#define MIN_SAMPLE_RATE     1e6        // Generator must sustain this (samples/s)
+
+typedef struct {
+    uint32_t events;
+    uint32_t detected;
+    uint32_t potential;                // Score >= POTENTIAL_THRESHOLD
+    uint32_t confirmed;                // Score >= CONFIRMED_THRESHOLD
+    uint32_t high;                     // Score >= HIGH_CONFIDENCE_THRESHOLD
+    uint64_t score_sum;
+} ScenarioStats_t;
+
+static double elapsedSeconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static double percent(uint32_t part, uint32_t whole) {
+    return whole ? 100.0 * part / whole : 0.0;
+}
+
+static bool writeCSV(const char* path, Motion_Generator& generator, uint32_t seed) {
+    FILE* out = fopen(path, "w");
+    if (out == nullptr) return false;
+
+    fprintf(out, "sequence,timestamp,accel_x,accel_y,accel_z,gyro_x,gyro_y,gyro_z,"
+                 "pressure,heart_rate,fsr_value\n");
+    uint32_t start_ms = 0;
+    for (uint8_t s = 0; s < MOTION_SCENARIO_COUNT; s++) {
+        generator.plan((MotionScenario_t)s, start_ms);
+        SensorData_t data;
+        while (generator.read(data)) {
+            fprintf(out, "%u,%u,%.3f,%.3f,%.3f,%.1f,%.1f,%.1f,%.3f,%.1f,%u\n", s, data.timestamp,
+                    data.accel_x, data.accel_y, data.accel_z, data.gyro_x, data.gyro_y, data.gyro_z,
+                    data.pressure, data.heart_rate, data.fsr_value);
+            start_ms = data.timestamp;
+        }
+        start_ms += EVENT_GAP_MS;
+    }
+    fclose(out);
+    printf("Wrote one event per scenario to %s (seed %u)\n", path, seed);
+    return true;
+}
+
+// An event read twice from begin() must match bit for bit
+static bool checkReplay(Motion_Generator& generator) {
+    std::vector<SensorData_t> first, second;
+    SensorData_t data;
+    for (uint8_t s = 0; s < MOTION_SCENARIO_COUNT; s++) {
+        generator.plan((MotionScenario_t)s, 0);
+        first.clear();
+        second.clear();
+        while (generator.read(data)) first.push_back(data);
+        generator.begin();
+        while (generator.read(data)) second.push_back(data);
+        if (first.size() != second.size() ||
+            memcmp(first.data(), second.data(), first.size() * sizeof(SensorData_t)) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Jittered timestamps keep increasing and average the nominal period
+static bool checkTiming(Motion_Generator& generator, const MotionParams_t& params) {
+    SensorData_t data;
+    generator.plan(MOTION_ADL_WALK, 5000);
+    uint32_t first = 0, last = 0, count = 0;
+    while (generator.read(data)) {
+        if (count > 0 && data.timestamp <= last) return false;
+        if (count == 0) first = data.timestamp;
+        last = data.timestamp;
+        count++;
+    }
+    double period = (double)(last - first) / (count - 1);
+    double nominal = 1000.0 / params.rate_hz;
+    return fabs(period - nominal) < nominal * 0.02;
+}
+
+static bool inRange(const SensorData_t& d, const MotionParams_t& params) {
+    float a = d.accel_range_g, g = params.gyro_range_dps;   // Scale the sample was read at
+    return fabsf(d.accel_x) <= a && fabsf(d.accel_y) <= a && fabsf(d.accel_z) <= a &&
+           fabsf(d.gyro_x) <= g && fabsf(d.gyro_y) <= g && fabsf(d.gyro_z) <= g &&
+           d.fsr_value <= 4095 && d.heart_rate >= 0;
+}
+
+int main(int argc, char** argv) {
+    uint32_t events = argc > 1 ? (uint32_t)atoi(argv[1]) : DEFAULT_EVENTS;
+    uint32_t seed = argc > 2 ? (uint32_t)atoi(argv[2]) : DEFAULT_SEED;
+    if (events == 0) events = DEFAULT_EVENTS;
+
+    MotionParams_t params;
+    Motion_Generator::defaultParams(params);
+    Serial.stream = nullptr;   // Detector debug output
+
+    if (argc > 3) {
+        Motion_Generator writer(params, seed);
+        if (!writeCSV(argv[3], writer, seed)) {
+            fprintf(stderr, "Cannot create %s\n", argv[3]);
+            return 1;
+        }
+    }
+
+    printf("Events: %u per scenario, seed %u, %u Hz, jitter +/-%.1f ms, noise %.3f g / %.1f dps\n\n",
+           events, seed, params.rate_hz, params.jitter_ms, params.noise_g, params.noise_dps);
+
+    bool ok = true;
+    SensorData_t data;
+
+    // Generator alone
+    Motion_Generator generator(params, seed);
+    uint64_t generated = 0;
+    bool ranges_ok = true;
+    float checksum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t e = 0; e < events; e++) {
+        for (uint8_t s = 0; s < MOTION_SCENARIO_COUNT; s++) {
+            generator.plan((MotionScenario_t)s, 0);
+            while (generator.read(data)) {
+                checksum += data.accel_z;
+                ranges_ok &= inRange(data, params);
+                generated++;
+            }
+        }
+    }
+    double generate_s = elapsedSeconds(start);
+
+    // Generator + FallDetector + ConfidenceScorer
+    DetectionThresholds_t thresholds = {FREEFALL_THRESHOLD_G, IMPACT_THRESHOLD_G,
+                                        ROTATION_THRESHOLD_DPS, INACTIVITY_THRESHOLD_MS,
+                                        PRESSURE_CHANGE_THRESHOLD_M};
+    Fall_Pipeline pipeline;
+    pipeline.begin(thresholds);
+
+    ScenarioStats_t stats[MOTION_SCENARIO_COUNT];
+    memset(stats, 0, sizeof(stats));
+    Motion_Generator evaluated(params, seed);
+    uint64_t processed = 0;
+    uint32_t clock_ms = 0;
+
+    start = std::chrono::steady_clock::now();
+    for (uint32_t e = 0; e < events; e++) {
+        for (uint8_t s = 0; s < MOTION_SCENARIO_COUNT; s++) {
+            ScenarioStats_t& st = stats[s];
+            evaluated.plan((MotionScenario_t)s, clock_ms);
+            pipeline.reset();
+
+            FallVerdict_t verdict;
+            bool detected = false;
+            uint8_t best = 0;
+            while (evaluated.read(data)) {
+                if (pipeline.process(data, verdict)) {
+                    detected = true;
+                    if (verdict.score > best) best = verdict.score;
+                }
+                processed++;
+            }
+            clock_ms = data.timestamp + EVENT_GAP_MS;
+
+            st.events++;
+            if (detected) {
+                st.detected++;
+                st.score_sum += best;
+                if (best >= POTENTIAL_THRESHOLD) st.potential++;
+                if (best >= CONFIRMED_THRESHOLD) st.confirmed++;
+                if (best >= HIGH_CONFIDENCE_THRESHOLD) st.high++;
+            }
+        }
+    }
+    double pipeline_s = elapsedSeconds(start);
+
+    printf("%-16s %7s %9s %6s%2u %6s%2u %6s%2u %6s\n", "Scenario", "Events", "Detected", ">=",
+           POTENTIAL_THRESHOLD, ">=", CONFIRMED_THRESHOLD, ">=", HIGH_CONFIDENCE_THRESHOLD, "Score");
+    ScenarioStats_t falls = {0, 0, 0, 0, 0, 0}, adls = {0, 0, 0, 0, 0, 0};
+    for (uint8_t s = 0; s < MOTION_SCENARIO_COUNT; s++) {
+        ScenarioStats_t& st = stats[s];
+        printf("%-16s %7u %8.1f%% %7.1f%% %7.1f%% %7.1f%% %6.1f\n",
+               Motion_Generator::getScenarioName((MotionScenario_t)s), st.events,
+               percent(st.detected, st.events), percent(st.potential, st.events),
+               percent(st.confirmed, st.events), percent(st.high, st.events),
+               st.detected ? (double)st.score_sum / st.detected : 0.0);
+
+        ScenarioStats_t& sum = Motion_Generator::isFall((MotionScenario_t)s) ? falls : adls;
+        sum.events += st.events;
+        sum.detected += st.detected;
+        sum.potential += st.potential;
+        sum.confirmed += st.confirmed;
+        sum.high += st.high;
+    }
+
+    printf("\n%-16s %7s %9s %6s%2u %6s%2u %6s%2u\n", "", "", "Detected", ">=", POTENTIAL_THRESHOLD,
+           ">=", CONFIRMED_THRESHOLD, ">=", HIGH_CONFIDENCE_THRESHOLD);
+    printf("%-16s %7s %8.1f%% %7.1f%% %7.1f%% %7.1f%%\n", "Sensitivity", "",
+           percent(falls.detected, falls.events), percent(falls.potential, falls.events),
+           percent(falls.confirmed, falls.events), percent(falls.high, falls.events));
+    printf("%-16s %7s %8.1f%% %7.1f%% %7.1f%% %7.1f%%\n", "False alarms", "",
+           percent(adls.detected, adls.events), percent(adls.potential, adls.events),
+           percent(adls.confirmed, adls.events), percent(adls.high, adls.events));
+
+    double generate_rate = generated / generate_s;
+    printf("\nGenerator:  %llu samples in %.1f ms, %.2f M samples/s\n",
+           (unsigned long long)generated, generate_s * 1e3, generate_rate / 1e6);
+    printf("Pipeline:   %llu samples in %.1f ms, %.2f M samples/s (%.0fx real time)\n",
+           (unsigned long long)processed, pipeline_s * 1e3, processed / pipeline_s / 1e6,
+           processed / (double)params.rate_hz / pipeline_s);
+
+    // Checks
+    Motion_Generator checker(params, seed);
+    bool replay_ok = checkReplay(checker);
+    bool timing_ok = checkTiming(checker, params);
+    bool rate_ok = generate_rate >= MIN_SAMPLE_RATE;
+    printf("\nReplay exact:            %s\n", replay_ok ? "ok" : "FAILED");
+    printf("Jittered time monotonic: %s\n", timing_ok ? "ok" : "FAILED");
+    printf("Readings within range:   %s\n", ranges_ok ? "ok" : "FAILED");
+    printf("Generator >= 1M/s:       %s\n", rate_ok ? "ok" : "FAILED");
+    printf("(checksum %.1f)\n", checksum);
+    ok &= replay_ok && timing_ok && ranges_ok && rate_ok && processed == generated;
+
+    printf("\n%s\n", ok ? "ALL CHECKS PASSED" : "CHECKS FAILED");
+    return ok ? 0 : 1;
+}
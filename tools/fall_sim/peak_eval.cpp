@@ -0,0 +1,354 @@
+/*
+ * SmartFall - High-Rate IMU Peak Evaluation
+ *
+ * Replays 1 kHz traces through both IMU acquisition profiles, frame for
+ * frame:
+ *   register  94 Hz DLPF, one register read per 10 ms tick (the old path)
+ *   FIFO      184 Hz DLPF, every frame through IMU_Decimator, one sample
+ *             per tick with the peak held
+ * The DLPFs are modelled as one-pole filters at their cutoff. Both paths
+ * quantize at ±16 g and ±1000 °/s, and each feeds its own FallDetector.
+ * Against the unfiltered peak of each trace the tool reports how far the
+ * sampled peak and the detector's max impact fall short, and how often
+ * each detector saw an impact. It also times IMU_Decimator::push() and
+ * works out the I2C load of each FIFO rate with the driver's own byte
+ * accounting.
+ *
+ * Traces are Motion_Generator events rendered at IMU_SAMPLE_RATE_HZ,
+ * plus any log_decode CSVs given on the command line, recorded at that
+ * rate (one event per file).
+ *
+ * Build (from the repository root):
+ *   g++ -std=c++17 -O2 -Itools/host -ISmartFall -o peak_eval \
+ *       tools/fall_sim/peak_eval.cpp tools/fall_sim/Motion_Generator.cpp \
+ *       SmartFall/sensors/Accel_Ranger.cpp SmartFall/sensors/IMU_Decimator.cpp \
+ *       SmartFall/detection/fall_detector.cpp SmartFall/diagnostics/Deferred_Log.cpp
+ *
+ * Usage: peak_eval [events_per_scenario] [seed] [trace.csv ...]
+ */
+
+#include <Arduino.h>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include "Motion_Generator.h"
+#include "sensors/IMU_Decimator.h"
+#include "detection/fall_detector.h"
+
+HostSerial Serial;
+
+#define DEFAULT_EVENTS        300
+#define DEFAULT_SEED          1
+#define DECIMATION            (IMU_SAMPLE_RATE_HZ / SENSOR_SAMPLE_RATE_HZ)
+#define REGISTER_DLPF_HZ      94.0f
+#define FIFO_DLPF_HZ          184.0f
+#define RANGE_G               16
+#define GYRO_COUNTS_PER_DPS   32.8f     // ±1000 °/s
+#define TRUTH_RANGE_G         250.0f    // Generator never clips
+#define TRUTH_RANGE_DPS       4000.0f
+#define MAX_FIFO_SHORTFALL    10.0      // Mean peak shortfall allowed for the FIFO path (%)
+#define MAX_BUS_LOAD          50.0      // I2C load allowed at IMU_SAMPLE_RATE_HZ (%)
+#define TIMING_FRAMES         2000000
+
+static_assert(DECIMATION >= 1, "IMU_SAMPLE_RATE_HZ below the sample rate");
+
+typedef enum {
+    PATH_REGISTER,
+    PATH_FIFO,
+    PATH_COUNT
+} AcquisitionPath_t;
+
+typedef struct {
+    uint32_t events;                // Traces whose true peak passes IMPACT_THRESHOLD_G
+    double truth_sum;
+    double shortfall_sum[PATH_COUNT];      // % of the true peak, sampled peak
+    double shortfall_max[PATH_COUNT];
+    double impact_shortfall_sum[PATH_COUNT];   // % of the true peak, detector max impact
+    uint32_t detected[PATH_COUNT];         // Detector saw an impact
+} PeakStats_t;
+
+typedef struct {
+    float truth_peak;
+    float peak[PATH_COUNT];
+    float impact[PATH_COUNT];
+} TraceResult_t;
+
+// One-pole low-pass per axis, standing in for the MPU6050 DLPF
+class Axis_Filter {
+private:
+    float alpha;
+    float state[6];
+    bool primed;
+
+public:
+    Axis_Filter(float cutoff_hz) : alpha(1.0f - expf(-2.0f * (float)M_PI * cutoff_hz / IMU_SAMPLE_RATE_HZ)),
+                                   primed(false) {}
+
+    void reset() { primed = false; }
+
+    void apply(const SensorData_t& in, int16_t accel[3], int16_t gyro[3]) {
+        const float raw[6] = {in.accel_x, in.accel_y, in.accel_z, in.gyro_x, in.gyro_y, in.gyro_z};
+        for (uint8_t i = 0; i < 6; i++) {
+            state[i] = primed ? state[i] + alpha * (raw[i] - state[i]) : raw[i];
+        }
+        primed = true;
+        for (uint8_t axis = 0; axis < 3; axis++) {
+            accel[axis] = Accel_Ranger::toCounts(state[axis], RANGE_G);
+            float counts = state[3 + axis] * GYRO_COUNTS_PER_DPS;
+            gyro[axis] = (int16_t)constrain(lroundf(counts), -32768L, 32767L);
+        }
+    }
+};
+
+static float magnitude(float x, float y, float z) {
+    return sqrtf(x * x + y * y + z * z);
+}
+
+static double elapsedSeconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool loadCSV(const char* path, std::vector<SensorData_t>& trace) {
+    FILE* in = fopen(path, "r");
+    if (in == nullptr) return false;
+
+    char line[256];
+    if (fgets(line, sizeof(line), in) == nullptr) {   // Header
+        fclose(in);
+        return false;
+    }
+
+    while (fgets(line, sizeof(line), in) != nullptr) {
+        SensorData_t data;
+        unsigned sequence, timestamp, fsr;
+        if (sscanf(line, "%u,%u,%f,%f,%f,%f,%f,%f,%f,%f,%u", &sequence, &timestamp,
+                   &data.accel_x, &data.accel_y, &data.accel_z,
+                   &data.gyro_x, &data.gyro_y, &data.gyro_z,
+                   &data.pressure, &data.heart_rate, &fsr) != 11) {
+            continue;
+        }
+        data.timestamp = timestamp;
+        data.fsr_value = (uint16_t)fsr;
+        data.valid = true;
+        data.accel_range_g = 0;   // Not in the log_decode format
+        data.accel_peak_g = 0;
+        data.accel_peak_clipped = false;
+        data.gyro_peak_dps = 0;
+        trace.push_back(data);
+    }
+    fclose(in);
+    return !trace.empty();
+}
+
+// Both paths over one trace of IMU_SAMPLE_RATE_HZ frames
+static void replay(const std::vector<SensorData_t>& frames, FallDetector* detectors,
+                   TraceResult_t& result) {
+    static Axis_Filter register_filter(REGISTER_DLPF_HZ);
+    static Axis_Filter fifo_filter(FIFO_DLPF_HZ);
+    static IMU_Decimator decimator;
+    register_filter.reset();
+    fifo_filter.reset();
+    decimator.reset();
+    memset(&result, 0, sizeof(result));
+    for (uint8_t p = 0; p < PATH_COUNT; p++) detectors[p].resetDetection();
+
+    int16_t accel[3], gyro[3];
+    for (size_t i = 0; i < frames.size(); i++) {
+        const SensorData_t& frame = frames[i];
+        result.truth_peak = std::max(result.truth_peak,
+                                     magnitude(frame.accel_x, frame.accel_y, frame.accel_z));
+
+        // The register path filters every frame but reads only on the tick
+        register_filter.apply(frame, accel, gyro);
+        bool tick = i % DECIMATION == DECIMATION - 1;
+        SensorData_t sample[PATH_COUNT] = {frame, frame};
+        if (tick) {
+            SensorData_t& s = sample[PATH_REGISTER];
+            s.accel_x = Accel_Ranger::toG(accel[0], RANGE_G);
+            s.accel_y = Accel_Ranger::toG(accel[1], RANGE_G);
+            s.accel_z = Accel_Ranger::toG(accel[2], RANGE_G);
+            s.gyro_x = gyro[0] / GYRO_COUNTS_PER_DPS;
+            s.gyro_y = gyro[1] / GYRO_COUNTS_PER_DPS;
+            s.gyro_z = gyro[2] / GYRO_COUNTS_PER_DPS;
+            s.accel_range_g = RANGE_G;
+            result.peak[PATH_REGISTER] = std::max(result.peak[PATH_REGISTER],
+                                                  magnitude(s.accel_x, s.accel_y, s.accel_z));
+        }
+
+        fifo_filter.apply(frame, accel, gyro);
+        decimator.push(accel, gyro, RANGE_G, GYRO_COUNTS_PER_DPS);
+        if (!tick) continue;
+        decimator.take(sample[PATH_FIFO]);
+        result.peak[PATH_FIFO] = std::max(result.peak[PATH_FIFO], sample[PATH_FIFO].accel_peak_g);
+
+        // The detector resets max impact on timeout; keep the largest seen
+        for (uint8_t p = 0; p < PATH_COUNT; p++) {
+            detectors[p].processSensorData(sample[p]);
+            result.impact[p] = std::max(result.impact[p], detectors[p].getMaxImpact());
+        }
+    }
+}
+
+static void addResult(PeakStats_t& st, const TraceResult_t& r) {
+    if (r.truth_peak < IMPACT_THRESHOLD_G) return;
+    st.events++;
+    st.truth_sum += r.truth_peak;
+    for (uint8_t p = 0; p < PATH_COUNT; p++) {
+        double shortfall = 100.0 * (r.truth_peak - r.peak[p]) / r.truth_peak;
+        st.shortfall_sum[p] += shortfall;
+        st.shortfall_max[p] = std::max(st.shortfall_max[p], shortfall);
+        if (r.impact[p] > 0) {
+            st.detected[p]++;
+            st.impact_shortfall_sum[p] += 100.0 * (r.truth_peak - r.impact[p]) / r.truth_peak;
+        }
+    }
+}
+
+static void printRow(const char* name, const PeakStats_t& st) {
+    if (st.events == 0) {
+        printf("%-16s %6u\n", name, 0u);
+        return;
+    }
+    printf("%-16s %6u %7.1f", name, st.events, st.truth_sum / st.events);
+    for (uint8_t p = 0; p < PATH_COUNT; p++) {
+        printf(" %6.1f%% %6.1f%%", st.shortfall_sum[p] / st.events, st.shortfall_max[p]);
+    }
+    for (uint8_t p = 0; p < PATH_COUNT; p++) {
+        printf(" %6.1f%%", st.detected[p] ? st.impact_shortfall_sum[p] / st.detected[p] : 0.0);
+    }
+    for (uint8_t p = 0; p < PATH_COUNT; p++) {
+        printf(" %6.1f%%", 100.0 * st.detected[p] / st.events);
+    }
+    printf("\n");
+}
+
+// Bits on the bus per second, counted as MPU6050_Sensor counts them
+static double busLoad(uint16_t rate_hz) {
+    double frames_per_tick = (double)rate_hz / SENSOR_SAMPLE_RATE_HZ;
+    double bursts = ceil(frames_per_tick / IMU_FIFO_BURST_FRAMES);
+    double bytes = (3 + 2) + bursts * 3 + frames_per_tick * 12;   // Count read, then bursts
+    double transactions = 2 + bursts * 2;
+    double bits_per_s = (bytes * 9.0 + transactions * 2.0) * SENSOR_SAMPLE_RATE_HZ;
+    return 100.0 * bits_per_s / IMU_I2C_CLOCK_HZ;
+}
+
+int main(int argc, char** argv) {
+    uint32_t events = argc > 1 ? (uint32_t)atoi(argv[1]) : DEFAULT_EVENTS;
+    uint32_t seed = argc > 2 ? (uint32_t)atoi(argv[2]) : DEFAULT_SEED;
+    if (events == 0) events = DEFAULT_EVENTS;
+    Serial.stream = nullptr;   // Detector debug output
+
+    MotionParams_t params;
+    Motion_Generator::defaultParams(params);
+    params.rate_hz = IMU_SAMPLE_RATE_HZ;
+    params.jitter_ms = 0;                // FIFO frames are on the sensor clock
+    params.accel_range_g = TRUTH_RANGE_G;
+    params.accel_autorange = false;
+    params.gyro_range_dps = TRUTH_RANGE_DPS;
+    Motion_Generator generator(params, seed);
+
+    DetectionThresholds_t thresholds = {FREEFALL_THRESHOLD_G, IMPACT_THRESHOLD_G,
+                                        ROTATION_THRESHOLD_DPS, INACTIVITY_THRESHOLD_MS,
+                                        PRESSURE_CHANGE_THRESHOLD_M};
+    static FallDetector detectors[PATH_COUNT];
+    for (uint8_t p = 0; p < PATH_COUNT; p++) {
+        detectors[p].setThresholds(thresholds);
+        detectors[p].init();
+    }
+
+    printf("Events: %u per scenario, seed %u; %u Hz frames, %u per sample\n\n", events, seed,
+           IMU_SAMPLE_RATE_HZ, DECIMATION);
+
+    PeakStats_t scenario_stats[MOTION_SCENARIO_COUNT];
+    PeakStats_t falls, adls, recorded, total;
+    memset(scenario_stats, 0, sizeof(scenario_stats));
+    memset(&falls, 0, sizeof(falls));
+    memset(&adls, 0, sizeof(adls));
+    memset(&recorded, 0, sizeof(recorded));
+    memset(&total, 0, sizeof(total));
+
+    std::vector<SensorData_t> frames;
+    TraceResult_t result;
+    uint32_t clock_ms = 0;
+    for (uint32_t e = 0; e < events; e++) {
+        for (uint8_t s = 0; s < MOTION_SCENARIO_COUNT; s++) {
+            generator.plan((MotionScenario_t)s, clock_ms);
+            frames.clear();
+            SensorData_t data;
+            while (generator.read(data)) frames.push_back(data);
+            clock_ms = frames.back().timestamp + 1000;
+
+            replay(frames, detectors, result);
+            addResult(scenario_stats[s], result);
+            addResult(Motion_Generator::isFall((MotionScenario_t)s) ? falls : adls, result);
+            addResult(total, result);
+        }
+    }
+
+    uint32_t traces = 0;
+    for (int i = 3; i < argc; i++) {
+        frames.clear();
+        if (!loadCSV(argv[i], frames)) {
+            printf("Cannot read %s\n", argv[i]);
+            return 1;
+        }
+        replay(frames, detectors, result);
+        addResult(recorded, result);
+        addResult(total, result);
+        traces++;
+    }
+
+    printf("Traces with a true peak above %.1f g; peak shortfall vs the unfiltered 1 kHz peak\n\n",
+           IMPACT_THRESHOLD_G);
+    printf("%-16s %6s %7s %15s %15s %7s %7s %7s %7s\n", "", "", "True", "Register peak", "FIFO peak",
+           "Impact", "", "Impact", "seen");
+    printf("%-16s %6s %7s %7s %7s %7s %7s %7s %7s %7s %7s\n", "Scenario", "Events", "(g)", "mean",
+           "max", "mean", "max", "reg.", "FIFO", "reg.", "FIFO");
+    for (uint8_t s = 0; s < MOTION_SCENARIO_COUNT; s++) {
+        printRow(Motion_Generator::getScenarioName((MotionScenario_t)s), scenario_stats[s]);
+    }
+    printRow("all falls", falls);
+    printRow("all ADLs", adls);
+    if (traces > 0) printRow("recorded", recorded);
+    printRow("all", total);
+
+    // Decimator cost per frame, cache-hot
+    std::vector<int16_t> raw(6 * 1024);
+    for (size_t i = 0; i < raw.size(); i++) raw[i] = (int16_t)((i * 2654435761u) >> 17);
+    IMU_Decimator decimator;
+    SensorData_t sink_sample;
+    double sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t f = 0; f < TIMING_FRAMES; f++) {
+        const int16_t* frame = &raw[6 * (f & 1023)];
+        decimator.push(frame, frame + 3, RANGE_G, GYRO_COUNTS_PER_DPS);
+        if (f % DECIMATION == DECIMATION - 1 && decimator.take(sink_sample)) sink += sink_sample.accel_peak_g;
+    }
+    double push_ns = 1e9 * elapsedSeconds(start) / TIMING_FRAMES;
+
+    printf("\nDecimator: %.1f ns per frame on the host, %.3f%% of a core at %u Hz (checksum %.1f)\n",
+           push_ns, push_ns * IMU_SAMPLE_RATE_HZ / 1e7, IMU_SAMPLE_RATE_HZ, sink);
+    printf("\nI2C load at %u kHz (FIFO count read plus %u-frame bursts, every %u ms)\n",
+           IMU_I2C_CLOCK_HZ / 1000, IMU_FIFO_BURST_FRAMES, 1000 / SENSOR_SAMPLE_RATE_HZ);
+    static const uint16_t RATES[] = {200, 250, 500, 1000};
+    for (uint8_t i = 0; i < sizeof(RATES) / sizeof(RATES[0]); i++) {
+        printf("  %4u Hz: %5.1f%%%s\n", RATES[i], busLoad(RATES[i]),
+               RATES[i] == IMU_SAMPLE_RATE_HZ ? "  (configured)" : "");
+    }
+
+    double register_mean = total.events ? total.shortfall_sum[PATH_REGISTER] / total.events : 0;
+    double fifo_mean = total.events ? total.shortfall_sum[PATH_FIFO] / total.events : 0;
+    bool peak_ok = total.events > 0 && fifo_mean < register_mean;
+    bool accuracy_ok = fifo_mean <= MAX_FIFO_SHORTFALL;
+    bool detect_ok = falls.detected[PATH_FIFO] >= falls.detected[PATH_REGISTER];
+    bool bus_ok = busLoad(IMU_SAMPLE_RATE_HZ) <= MAX_BUS_LOAD;
+
+    printf("\nFIFO peak closer than register:  %s\n", peak_ok ? "ok" : "FAILED");
+    printf("FIFO mean shortfall <= %.0f%%:     %s\n", MAX_FIFO_SHORTFALL, accuracy_ok ? "ok" : "FAILED");
+    printf("Fall impacts seen as often:      %s\n", detect_ok ? "ok" : "FAILED");
+    printf("I2C load <= %.0f%%:                %s\n", MAX_BUS_LOAD, bus_ok ? "ok" : "FAILED");
+    bool ok = peak_ok && accuracy_ok && detect_ok && bus_ok;
+
+    printf("\n%s\n", ok ? "ALL CHECKS PASSED" : "CHECKS FAILED");
+    return ok ? 0 : 1;
+}
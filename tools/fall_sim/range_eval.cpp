@@ -0,0 +1,249 @@
+/*
+ * SmartFall - Accelerometer Range Evaluation
+ *
+ * Renders the same Motion_Generator events through four accelerometer
+ * models, sample for sample:
+ *   truth     no clipping
+ *   fixed 8   clipped at ±8 g (the old MPU6050_Sensor::configure())
+ *   fixed 16  clipped at ±16 g
+ *   auto      quantized at the scale Accel_Ranger picks, 8 or 16 g
+ * Each model feeds its own FallDetector. For every model the tool reports:
+ *   - how often the impact peak clipped
+ *   - how far the peak and the detector's max impact fall short of the truth
+ *   - how often the impact score tier (SCORE_IMPACT) still matches the truth
+ * For auto-ranging it also reports how fast the scale went up on the
+ * way into an impact, and how much of the time it stayed at the high scale.
+ *
+ * Build (from the repository root):
+ *   g++ -std=c++17 -O2 -Itools/host -ISmartFall -o range_eval \
+ *       tools/fall_sim/range_eval.cpp tools/fall_sim/Motion_Generator.cpp \
+ *       SmartFall/sensors/Accel_Ranger.cpp SmartFall/detection/fall_detector.cpp \
+ *       SmartFall/diagnostics/Deferred_Log.cpp
+ *
+ * Usage: range_eval [events_per_scenario] [seed]
+ */
+
+#include <Arduino.h>
+#include <vector>
+#include <algorithm>
+#include "Motion_Generator.h"
+#include "detection/fall_detector.h"
+#include "detection/score_tiers.h"
+
+HostSerial Serial;
+
+#define DEFAULT_EVENTS      500
+#define DEFAULT_SEED        1
+#define TRUTH_RANGE_G       250.0f     // Never reached
+#define MAX_LATE_SWITCHES   0.01       // Share of clipping impacts the auto scale may miss
+
+typedef enum {
+    MODEL_TRUTH,
+    MODEL_FIXED_8,
+    MODEL_FIXED_16,
+    MODEL_AUTO,
+    MODEL_COUNT
+} RangeModel_t;
+
+static const char* MODEL_NAMES[MODEL_COUNT] = {"truth", "fixed 8", "fixed 16", "auto"};
+
+typedef struct {
+    uint32_t events;               // Events where a true axis reaches ACCEL_RANGE_LOW_G
+    uint32_t peak_clipped;         // ... and whose peak sample clipped here
+    uint32_t detector_clipped;     // ... and the detector flagged its max impact
+    double peak_error_sum;         // g, truth minus model, over those events
+    double peak_error_max;
+    uint32_t detected;             // Events where the truth detector saw an impact
+    uint32_t tier_matches;         // ... and this model scored the same impact tier
+} ModelStats_t;
+
+typedef struct {
+    uint32_t samples;
+    uint32_t high_samples;
+    uint32_t switches_up;
+    uint32_t switches_down;
+    uint32_t ended_high;           // Events still at the high scale at the end
+    uint32_t walk_switches;        // Switches while walking
+    uint32_t prearmed;             // Impacts already at the high scale before clipping range
+    uint32_t late[3];              // Samples clipped at the low scale first: 1, 2, more
+    uint32_t scale_errors;         // Sample outside its own scale, or an unknown scale
+} AutoStats_t;
+
+static float magnitude(const SensorData_t& d) {
+    return sqrtf(d.accel_x * d.accel_x + d.accel_y * d.accel_y + d.accel_z * d.accel_z);
+}
+
+static float largestAxis(const SensorData_t& d) {
+    return std::max(fabsf(d.accel_x), std::max(fabsf(d.accel_y), fabsf(d.accel_z)));
+}
+
+static bool clipped(const SensorData_t& d) {
+    return largestAxis(d) >= d.accel_range_g * 32767.0f / 32768.0f;
+}
+
+int main(int argc, char** argv) {
+    uint32_t events = argc > 1 ? (uint32_t)atoi(argv[1]) : DEFAULT_EVENTS;
+    uint32_t seed = argc > 2 ? (uint32_t)atoi(argv[2]) : DEFAULT_SEED;
+    if (events == 0) events = DEFAULT_EVENTS;
+    Serial.stream = nullptr;   // Detector debug output
+
+    MotionParams_t params[MODEL_COUNT];
+    for (uint8_t m = 0; m < MODEL_COUNT; m++) {
+        Motion_Generator::defaultParams(params[m]);
+        params[m].accel_autorange = m == MODEL_AUTO;
+    }
+    params[MODEL_TRUTH].accel_range_g = TRUTH_RANGE_G;
+    params[MODEL_FIXED_8].accel_range_g = ACCEL_RANGE_LOW_G;
+    params[MODEL_FIXED_16].accel_range_g = ACCEL_RANGE_HIGH_G;
+
+    std::vector<Motion_Generator> generators;
+    DetectionThresholds_t thresholds = {FREEFALL_THRESHOLD_G, IMPACT_THRESHOLD_G,
+                                        ROTATION_THRESHOLD_DPS, INACTIVITY_THRESHOLD_MS,
+                                        PRESSURE_CHANGE_THRESHOLD_M};
+    static FallDetector detectors[MODEL_COUNT];
+    for (uint8_t m = 0; m < MODEL_COUNT; m++) {
+        generators.emplace_back(params[m], seed);
+        detectors[m].setThresholds(thresholds);
+        detectors[m].init();
+    }
+
+    printf("Events: %u per scenario, seed %u; auto-ranging %u/%u g, up at %.1f g, "
+           "down after %u samples within %.1f g\n\n",
+           events, seed, ACCEL_RANGE_LOW_G, ACCEL_RANGE_HIGH_G, ACCEL_RANGE_UP_G,
+           ACCEL_RANGE_QUIET_SAMPLES, ACCEL_RANGE_DOWN_G);
+
+    ModelStats_t stats[MODEL_COUNT];
+    memset(stats, 0, sizeof(stats));
+    AutoStats_t autos;
+    memset(&autos, 0, sizeof(autos));
+    const ScoreTable_t& impact_tiers = DEFAULT_SCORE_TIERS.tables[SCORE_IMPACT];
+
+    uint32_t clock_ms = 0;
+    SensorData_t data[MODEL_COUNT];
+    for (uint32_t e = 0; e < events; e++) {
+        for (uint8_t s = 0; s < MOTION_SCENARIO_COUNT; s++) {
+            float peak[MODEL_COUNT] = {0};
+            bool peak_clipped[MODEL_COUNT] = {false};
+            float impact[MODEL_COUNT] = {0};         // Detector max impact; reset on timeout
+            bool impact_clipped[MODEL_COUNT] = {false};
+            float truth_axis = 0;
+            for (uint8_t m = 0; m < MODEL_COUNT; m++) {
+                generators[m].plan((MotionScenario_t)s, clock_ms);
+                detectors[m].resetDetection();
+            }
+
+            bool entered_clipping = false;   // True signal has passed the low scale
+            uint32_t low_clips = 0;
+            bool running = true;
+            while (running) {
+                for (uint8_t m = 0; m < MODEL_COUNT; m++) {
+                    running &= generators[m].read(data[m]);
+                }
+                if (!running) break;
+
+                for (uint8_t m = 0; m < MODEL_COUNT; m++) {
+                    detectors[m].processSensorData(data[m]);
+                    if (detectors[m].getMaxImpact() > impact[m]) {
+                        impact[m] = detectors[m].getMaxImpact();
+                        impact_clipped[m] = detectors[m].isImpactClipped();
+                    }
+                    float mg = magnitude(data[m]);
+                    if (mg > peak[m]) {
+                        peak[m] = mg;
+                        peak_clipped[m] = clipped(data[m]);
+                    }
+                }
+
+                // Auto scale against the true signal
+                const SensorData_t& a = data[MODEL_AUTO];
+                autos.samples++;
+                if (a.accel_range_g == ACCEL_RANGE_HIGH_G) autos.high_samples++;
+                if ((a.accel_range_g != ACCEL_RANGE_LOW_G && a.accel_range_g != ACCEL_RANGE_HIGH_G) ||
+                    largestAxis(a) > a.accel_range_g) {
+                    autos.scale_errors++;
+                }
+                truth_axis = std::max(truth_axis, largestAxis(data[MODEL_TRUTH]));
+                if (!entered_clipping && largestAxis(data[MODEL_TRUTH]) >= ACCEL_RANGE_LOW_G) {
+                    if (a.accel_range_g == ACCEL_RANGE_HIGH_G) {
+                        entered_clipping = true;
+                        if (low_clips == 0) autos.prearmed++;
+                        else autos.late[std::min<uint32_t>(low_clips, 3) - 1]++;
+                    } else {
+                        low_clips++;
+                    }
+                }
+            }
+            clock_ms = data[MODEL_TRUTH].timestamp + 1000;
+
+            Accel_Ranger& ranger = generators[MODEL_AUTO].getRanger();
+            autos.switches_up += ranger.getSwitchesUp();
+            autos.switches_down += ranger.getSwitchesDown();
+            if (ranger.isHigh()) autos.ended_high++;
+            if (s == MOTION_ADL_WALK) autos.walk_switches += ranger.getSwitchesUp();
+
+            float truth_impact = impact[MODEL_TRUTH];
+            bool truth_reaches = truth_axis >= ACCEL_RANGE_LOW_G;
+            for (uint8_t m = 0; m < MODEL_COUNT; m++) {
+                ModelStats_t& st = stats[m];
+                if (truth_reaches) {
+                    st.events++;
+                    st.peak_clipped += peak_clipped[m];
+                    st.detector_clipped += impact_clipped[m];
+                    double error = peak[MODEL_TRUTH] - peak[m];
+                    st.peak_error_sum += error;
+                    st.peak_error_max = std::max(st.peak_error_max, error);
+                }
+                if (truth_impact > 0) {
+                    st.detected++;
+                    st.tier_matches += scoreTier(impact_tiers, impact[m]) ==
+                                       scoreTier(impact_tiers, truth_impact);
+                }
+            }
+        }
+    }
+
+    uint32_t reaching = stats[MODEL_TRUTH].events;
+    printf("Axis reaching %u g: %u of %u events; impacts detected: %u\n\n", ACCEL_RANGE_LOW_G,
+           reaching, events * MOTION_SCENARIO_COUNT, stats[MODEL_TRUTH].detected);
+    printf("%-9s %12s %12s %14s %14s %11s\n", "Model", "Peak clipped", "Flagged", "Mean short (g)",
+           "Max short (g)", "Impact tier");
+    for (uint8_t m = 0; m < MODEL_COUNT; m++) {
+        const ModelStats_t& st = stats[m];
+        printf("%-9s %11.1f%% %11.1f%% %14.2f %14.2f %10.1f%%\n", MODEL_NAMES[m],
+               reaching ? 100.0 * st.peak_clipped / reaching : 0.0,
+               reaching ? 100.0 * st.detector_clipped / reaching : 0.0,
+               reaching ? st.peak_error_sum / reaching : 0.0, st.peak_error_max,
+               st.detected ? 100.0 * st.tier_matches / st.detected : 0.0);
+    }
+
+    uint32_t entered = autos.prearmed + autos.late[0] + autos.late[1] + autos.late[2];
+    printf("\nAuto-ranging\n");
+    printf("  Into clipping range: %u pre-armed, %u after 1 clipped sample, %u after 2, %u later\n",
+           autos.prearmed, autos.late[0], autos.late[1], autos.late[2]);
+    printf("  Switches:            %u up, %u down (%u while walking)\n", autos.switches_up,
+           autos.switches_down, autos.walk_switches);
+    printf("  High scale:          %.1f%% of %u samples\n",
+           autos.samples ? 100.0 * autos.high_samples / autos.samples : 0.0, autos.samples);
+    printf("  Still high at end:   %u events\n", autos.ended_high);
+
+    const ModelStats_t& fixed = stats[MODEL_FIXED_8];
+    const ModelStats_t& wide = stats[MODEL_FIXED_16];
+    const ModelStats_t& autor = stats[MODEL_AUTO];
+    bool clips_ok = fixed.peak_clipped > 0;
+    bool switch_ok = entered == reaching && autos.late[1] + autos.late[2] == 0 &&
+                     autos.late[0] <= MAX_LATE_SWITCHES * reaching;
+    bool peak_ok = autor.peak_clipped <= wide.peak_clipped + autos.late[0] &&
+                   autor.tier_matches >= fixed.tier_matches;
+    bool back_ok = autos.ended_high == 0 && autos.walk_switches == 0;
+    bool scale_ok = autos.scale_errors == 0;
+
+    printf("\nTraces include clipped impacts:  %s\n", clips_ok ? "ok" : "FAILED");
+    printf("Scale up within one sample:      %s\n", switch_ok ? "ok" : "FAILED");
+    printf("Peaks kept as well as fixed 16:  %s\n", peak_ok ? "ok" : "FAILED");
+    printf("Back to low scale when quiet:    %s\n", back_ok ? "ok" : "FAILED");
+    printf("Samples within their own scale:  %s\n", scale_ok ? "ok" : "FAILED");
+    bool ok = clips_ok && switch_ok && peak_ok && back_ok && scale_ok;
+
+    printf("\n%s\n", ok ? "ALL CHECKS PASSED" : "CHECKS FAILED");
+    return ok ? 0 : 1;
+}
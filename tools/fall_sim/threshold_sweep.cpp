@@ -0,0 +1,478 @@
+/*
+ * SmartFall - Detection Threshold Sweep / ROC
+ *
+ * Runs the device FallDetector and ConfidenceScorer (Fall_Pipeline.h)
+ * over a labelled trace corpus for many DetectionThresholds_t settings,
+ * each paired with a variant of the score tiers, either a grid or a
+ * random search. A tier variant scales every DEFAULT_SCORE_TIERS
+ * breakpoint (above 1 is harder to meet) and every tier's points. For
+ * each setting it reports:
+ *   - sensitivity and specificity when every detection alerts
+ *   - sensitivity and specificity at the CONFIRMED score cutoff
+ *   - the ROC curve over the score cutoff, and its AUC
+ *   - median detection latency after the impact
+ *
+ * The corpus is synthetic (Motion_Generator, spread evenly over all fall
+ * and ADL scenarios) and/or recorded CSV traces in log_decode format.
+ * A CSV whose file name contains "fall" is labelled a fall. Work is split
+ * into blocks of traces and run on a work-stealing pool (Work_Pool.h).
+ * Each trace is rendered once per block and then run under every setting.
+ *
+ * Build (from the repository root):
+ *   g++ -std=c++17 -O2 -pthread -Itools/host -ISmartFall -o threshold_sweep \
+ *       tools/fall_sim/threshold_sweep.cpp tools/fall_sim/Motion_Generator.cpp \
+ *       SmartFall/sensors/Accel_Ranger.cpp SmartFall/detection/fall_detector.cpp \
+ *       SmartFall/detection/confidence_scorer.cpp SmartFall/detection/fall_classifier.cpp \
+ *       SmartFall/sensors/Altitude_Filter.cpp SmartFall/diagnostics/Deferred_Log.cpp
+ *
+ * Usage: threshold_sweep [--traces N] [--random K] [--threads T] [--seed S]
+ *                        [--roc roc.csv] [trace.csv ...]
+ */
+
+#include <Arduino.h>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include "Motion_Generator.h"
+#include "Fall_Pipeline.h"
+#include "Work_Pool.h"
+
+HostSerial Serial;
+
+#define DEFAULT_TRACES     1000
+#define DEFAULT_SEED       1
+#define TRACES_PER_TASK    16
+#define NO_LATENCY         0xFFFF
+#define CHECK_TRACES       200        // Re-run single-threaded for the parity check
+
+typedef struct {
+    bool fall;
+    MotionScenario_t scenario;        // MOTION_SCENARIO_COUNT for recorded traces
+    uint32_t seed;                    // Synthetic traces are rendered from this
+    std::vector<SensorData_t> samples;   // Recorded traces only
+} CorpusTrace_t;
+
+typedef struct {
+    uint8_t score;                    // 0 if the detector never fired
+    bool detected;
+    uint16_t latency_ms;              // After the impact; NO_LATENCY if unknown
+} TraceResult_t;
+
+typedef struct {
+    DetectionThresholds_t thresholds;
+    float breakpoint_scale;           // Against DEFAULT_SCORE_TIERS; > 1 is stricter
+    float points_scale;
+    ScoreTiers_t tiers;
+} SweepSetting_t;
+
+typedef struct {
+    SweepSetting_t setting;
+    double auc;
+    double detect_tpr, detect_fpr;    // Every detection alerts
+    double confirmed_tpr, confirmed_fpr;
+    uint32_t median_latency_ms;
+    std::vector<double> tpr, fpr;     // Indexed by score cutoff
+} SettingReport_t;
+
+// Splitmix: independent generator seed per trace
+static uint32_t traceSeed(uint32_t seed, uint32_t index) {
+    uint64_t z = ((uint64_t)seed << 32 | index) + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return (uint32_t)(z ^ (z >> 31)) | 1;
+}
+
+static double elapsedSeconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static bool loadCSV(const char* path, std::vector<SensorData_t>& trace) {
+    FILE* in = fopen(path, "r");
+    if (in == nullptr) return false;
+
+    char line[256];
+    if (fgets(line, sizeof(line), in) == nullptr) {   // Header
+        fclose(in);
+        return false;
+    }
+
+    while (fgets(line, sizeof(line), in) != nullptr) {
+        SensorData_t data;
+        unsigned sequence, timestamp, fsr;
+        if (sscanf(line, "%u,%u,%f,%f,%f,%f,%f,%f,%f,%f,%u", &sequence, &timestamp,
+                   &data.accel_x, &data.accel_y, &data.accel_z,
+                   &data.gyro_x, &data.gyro_y, &data.gyro_z,
+                   &data.pressure, &data.heart_rate, &fsr) != 11) {
+            continue;
+        }
+        data.timestamp = timestamp;
+        data.fsr_value = (uint16_t)fsr;
+        data.valid = true;
+        data.accel_range_g = 0;   // Not in the log_decode format
+        data.accel_peak_g = 0;
+        data.accel_peak_clipped = false;
+        data.gyro_peak_dps = 0;
+        trace.push_back(data);
+    }
+    fclose(in);
+    return !trace.empty();
+}
+
+static void defaultThresholds(DetectionThresholds_t& t) {
+    t.freefall_threshold_g = FREEFALL_THRESHOLD_G;
+    t.impact_threshold_g = IMPACT_THRESHOLD_G;
+    t.rotation_threshold_dps = ROTATION_THRESHOLD_DPS;
+    t.inactivity_threshold_ms = INACTIVITY_THRESHOLD_MS;
+    t.pressure_change_threshold_m = PRESSURE_CHANGE_THRESHOLD_M;
+}
+
+// Scales DEFAULT_SCORE_TIERS; false if the result is not a valid table set
+static bool scaleTiers(float breakpoint_scale, float points_scale, ScoreTiers_t& tiers) {
+    tiers = DEFAULT_SCORE_TIERS;
+    for (uint8_t m = 0; m < SCORE_METRIC_COUNT; m++) {
+        ScoreTable_t& table = tiers.tables[m];
+        for (uint8_t i = 0; i < table.count; i++) {
+            ScoreTier_t& tier = table.tiers[i];
+            tier.breakpoint = table.at_most ? tier.breakpoint / breakpoint_scale
+                                            : tier.breakpoint * breakpoint_scale;
+            tier.points = (uint8_t)std::min(lroundf(tier.points * points_scale),
+                                            (long)SCORE_TIER_POINTS_MAX);
+        }
+    }
+    return isValidScoreTiers(tiers);
+}
+
+static void addSetting(std::vector<SweepSetting_t>& settings, const DetectionThresholds_t& t,
+                       float breakpoint_scale, float points_scale) {
+    SweepSetting_t setting;
+    setting.thresholds = t;
+    setting.breakpoint_scale = breakpoint_scale;
+    setting.points_scale = points_scale;
+    if (scaleTiers(breakpoint_scale, points_scale, setting.tiers)) settings.push_back(setting);
+}
+
+static void gridSettings(std::vector<SweepSetting_t>& settings) {
+    static const float freefall[] = {0.4f, 0.5f, 0.6f, 0.7f};
+    static const float impact[] = {2.0f, 2.5f, 3.0f, 3.5f};
+    static const float rotation[] = {150.0f, 200.0f, 250.0f, 300.0f};
+    static const uint32_t inactivity[] = {1000, 2000, 3000};
+    static const float breakpoints[] = {0.8f, 1.0f, 1.25f};
+    static const float points[] = {0.8f, 1.0f, 1.2f};
+
+    DetectionThresholds_t t;
+    defaultThresholds(t);
+    for (float f : freefall) {
+        for (float i : impact) {
+            for (float r : rotation) {
+                for (uint32_t n : inactivity) {
+                    t.freefall_threshold_g = f;
+                    t.impact_threshold_g = i;
+                    t.rotation_threshold_dps = r;
+                    t.inactivity_threshold_ms = n;
+                    for (float b : breakpoints) {
+                        for (float p : points) addSetting(settings, t, b, p);
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void randomSettings(std::vector<SweepSetting_t>& settings, uint32_t count,
+                           uint32_t seed) {
+    uint32_t state = traceSeed(seed, 0xFFFFFFFF);
+    auto uniform = [&state](float low, float high) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return low + (high - low) * ((state >> 8) * (1.0f / 16777216.0f));
+    };
+
+    DetectionThresholds_t t;
+    defaultThresholds(t);
+    addSetting(settings, t, 1.0f, 1.0f);   // Always include what ships
+    for (uint32_t i = 1; i < count; i++) {
+        t.freefall_threshold_g = uniform(0.3f, 0.8f);
+        t.impact_threshold_g = uniform(1.5f, 4.5f);
+        t.rotation_threshold_dps = uniform(100.0f, 400.0f);
+        t.inactivity_threshold_ms = (uint32_t)uniform(500.0f, 4000.0f);
+        float breakpoint_scale = uniform(0.7f, 1.4f);
+        addSetting(settings, t, breakpoint_scale, uniform(0.7f, 1.3f));
+    }
+}
+
+// Runs one trace under one setting
+static TraceResult_t evaluate(Fall_Pipeline& pipeline, SweepSetting_t& setting,
+                              const SensorData_t* samples, size_t count, uint32_t impact_ms) {
+    TraceResult_t result = {0, false, NO_LATENCY};
+    pipeline.begin(setting.thresholds, setting.tiers);
+
+    FallVerdict_t verdict;
+    for (size_t i = 0; i < count; i++) {
+        SensorData_t data = samples[i];
+        if (!pipeline.process(data, verdict)) continue;
+
+        if (!result.detected && impact_ms > 0 && verdict.timestamp >= impact_ms) {
+            uint32_t latency = verdict.timestamp - impact_ms;
+            result.latency_ms = latency < NO_LATENCY ? latency : NO_LATENCY - 1;
+        }
+        result.detected = true;
+        if (verdict.score > result.score) result.score = verdict.score;
+    }
+    return result;
+}
+
+// Renders a synthetic trace; returns its impact time (0 for recorded traces)
+static uint32_t renderTrace(const CorpusTrace_t& trace, const MotionParams_t& params,
+                            std::vector<SensorData_t>& out) {
+    if (trace.scenario == MOTION_SCENARIO_COUNT) return 0;
+
+    Motion_Generator generator(params, trace.seed);
+    generator.plan(trace.scenario, 0);
+    const MotionEvent_t& event = generator.getEvent();
+    out.resize(event.samples);
+    size_t n = 0;
+    while (n < out.size() && generator.read(out[n])) n++;
+    out.resize(n);
+    return params.lead_ms + (uint32_t)(event.descent_ms + event.impact_ms);
+}
+
+static void buildReport(const std::vector<TraceResult_t>& results,
+                        const std::vector<CorpusTrace_t>& corpus, size_t setting,
+                        SettingReport_t& report) {
+    uint32_t falls = 0, adls = 0;
+    std::vector<uint32_t> tp(MAX_CONFIDENCE_SCORE + 2, 0), fp(MAX_CONFIDENCE_SCORE + 2, 0);
+    std::vector<uint32_t> latencies;
+
+    for (size_t i = 0; i < corpus.size(); i++) {
+        const TraceResult_t& r = results[setting * corpus.size() + i];
+        if (corpus[i].fall) falls++; else adls++;
+        if (!r.detected) continue;
+
+        // Counted as an alert at every cutoff up to its score
+        std::vector<uint32_t>& hits = corpus[i].fall ? tp : fp;
+        for (uint32_t c = 0; c <= r.score && c <= MAX_CONFIDENCE_SCORE; c++) hits[c]++;
+        if (corpus[i].fall && r.latency_ms != NO_LATENCY) latencies.push_back(r.latency_ms);
+    }
+
+    report.tpr.assign(MAX_CONFIDENCE_SCORE + 1, 0);
+    report.fpr.assign(MAX_CONFIDENCE_SCORE + 1, 0);
+    for (uint32_t c = 0; c <= MAX_CONFIDENCE_SCORE; c++) {
+        report.tpr[c] = falls ? (double)tp[c] / falls : 0;
+        report.fpr[c] = adls ? (double)fp[c] / adls : 0;
+    }
+    report.detect_tpr = report.tpr[0];
+    report.detect_fpr = report.fpr[0];
+    report.confirmed_tpr = report.tpr[CONFIRMED_THRESHOLD];
+    report.confirmed_fpr = report.fpr[CONFIRMED_THRESHOLD];
+
+    // Trapezoids from (0,0) through decreasing cutoffs, closed at (1,1)
+    double auc = 0, x = 0, y = 0;
+    for (int c = MAX_CONFIDENCE_SCORE; c >= 0; c--) {
+        auc += (report.fpr[c] - x) * (report.tpr[c] + y) / 2;
+        x = report.fpr[c];
+        y = report.tpr[c];
+    }
+    auc += (1.0 - x) * (1.0 + y) / 2;
+    report.auc = auc;
+
+    if (latencies.empty()) {
+        report.median_latency_ms = 0;
+    } else {
+        std::nth_element(latencies.begin(), latencies.begin() + latencies.size() / 2, latencies.end());
+        report.median_latency_ms = latencies[latencies.size() / 2];
+    }
+}
+
+static void printSetting(const SettingReport_t& r, bool shipped) {
+    const DetectionThresholds_t& t = r.setting.thresholds;
+    printf("%5.2f %5.2f %5.0f %6u | %5.2f %5.2f | %5.1f%% %5.1f%% | %5.1f%% %5.1f%% | %.3f | %5u%s\n",
+           t.freefall_threshold_g, t.impact_threshold_g, t.rotation_threshold_dps,
+           t.inactivity_threshold_ms, r.setting.breakpoint_scale, r.setting.points_scale,
+           100 * r.detect_tpr, 100 * (1 - r.detect_fpr), 100 * r.confirmed_tpr,
+           100 * (1 - r.confirmed_fpr), r.auc, r.median_latency_ms, shipped ? "  <- config.h" : "");
+}
+
+static bool isShipped(const SweepSetting_t& s) {
+    const DetectionThresholds_t& t = s.thresholds;
+    DetectionThresholds_t d;
+    defaultThresholds(d);
+    return s.breakpoint_scale == 1.0f && s.points_scale == 1.0f &&
+           t.freefall_threshold_g == d.freefall_threshold_g &&
+           t.impact_threshold_g == d.impact_threshold_g &&
+           t.rotation_threshold_dps == d.rotation_threshold_dps &&
+           t.inactivity_threshold_ms == d.inactivity_threshold_ms;
+}
+
+int main(int argc, char** argv) {
+    uint32_t synthetic_traces = DEFAULT_TRACES;
+    uint32_t random_count = 0;
+    uint32_t seed = DEFAULT_SEED;
+    unsigned threads = std::thread::hardware_concurrency();
+    const char* roc_path = nullptr;
+    std::vector<const char*> files;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--traces" && has_value) synthetic_traces = atoi(argv[++i]);
+        else if (arg == "--random" && has_value) random_count = atoi(argv[++i]);
+        else if (arg == "--threads" && has_value) threads = atoi(argv[++i]);
+        else if (arg == "--seed" && has_value) seed = atoi(argv[++i]);
+        else if (arg == "--roc" && has_value) roc_path = argv[++i];
+        else if (arg[0] != '-') files.push_back(argv[i]);
+        else {
+            fprintf(stderr, "Usage: %s [--traces N] [--random K] [--threads T] [--seed S] "
+                            "[--roc roc.csv] [trace.csv ...]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    MotionParams_t params;
+    Motion_Generator::defaultParams(params);
+    Serial.stream = nullptr;   // Detector debug output
+
+    // Corpus
+    std::vector<CorpusTrace_t> corpus(synthetic_traces);
+    for (uint32_t i = 0; i < synthetic_traces; i++) {
+        corpus[i].scenario = (MotionScenario_t)(i % MOTION_SCENARIO_COUNT);
+        corpus[i].fall = Motion_Generator::isFall(corpus[i].scenario);
+        corpus[i].seed = traceSeed(seed, i);
+    }
+    for (const char* path : files) {
+        CorpusTrace_t trace;
+        trace.scenario = MOTION_SCENARIO_COUNT;
+        trace.fall = strstr(path, "fall") != nullptr;
+        trace.seed = 0;
+        if (!loadCSV(path, trace.samples)) {
+            fprintf(stderr, "Cannot read trace %s\n", path);
+            return 1;
+        }
+        corpus.push_back(std::move(trace));
+    }
+    if (corpus.empty()) {
+        fprintf(stderr, "Empty corpus\n");
+        return 1;
+    }
+    uint32_t fall_count = 0;
+    for (const CorpusTrace_t& trace : corpus) fall_count += trace.fall;
+
+    std::vector<SweepSetting_t> settings;
+    if (random_count > 0) {
+        randomSettings(settings, random_count, seed);
+    } else {
+        gridSettings(settings);
+    }
+
+    Work_Pool pool(threads);
+    printf("Corpus: %zu traces (%u falls, %zu ADLs, %zu recorded), %zu settings, %u threads\n",
+           corpus.size(), fall_count, corpus.size() - fall_count, files.size(), settings.size(),
+           pool.getThreadCount());
+
+    // One task per block of traces; every setting runs on each rendered trace
+    std::vector<TraceResult_t> results(settings.size() * corpus.size());
+    std::vector<std::vector<SensorData_t>> scratch(pool.getThreadCount());
+    std::vector<Fall_Pipeline> pipelines(pool.getThreadCount());
+    std::atomic<uint64_t> samples_run(0);
+
+    std::vector<Work_Pool::Task_t> tasks;
+    for (size_t first = 0; first < corpus.size(); first += TRACES_PER_TASK) {
+        size_t last = std::min(first + TRACES_PER_TASK, corpus.size());
+        tasks.push_back([&, first, last](unsigned worker) {
+            uint64_t samples = 0;
+            for (size_t i = first; i < last; i++) {
+                const CorpusTrace_t& trace = corpus[i];
+                uint32_t impact_ms = renderTrace(trace, params, scratch[worker]);
+                const std::vector<SensorData_t>& data =
+                    (trace.scenario == MOTION_SCENARIO_COUNT) ? trace.samples : scratch[worker];
+
+                for (size_t s = 0; s < settings.size(); s++) {
+                    results[s * corpus.size() + i] =
+                        evaluate(pipelines[worker], settings[s], data.data(), data.size(), impact_ms);
+                }
+                samples += data.size() * settings.size();
+            }
+            samples_run += samples;
+        });
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    pool.run(tasks);
+    double seconds = elapsedSeconds(start);
+
+    std::vector<SettingReport_t> reports(settings.size());
+    for (size_t s = 0; s < settings.size(); s++) {
+        reports[s].setting = settings[s];
+        buildReport(results, corpus, s, reports[s]);
+    }
+
+    if (roc_path != nullptr) {
+        FILE* out = fopen(roc_path, "w");
+        if (out == nullptr) {
+            fprintf(stderr, "Cannot create %s\n", roc_path);
+            return 1;
+        }
+        fprintf(out, "setting,freefall_g,impact_g,rotation_dps,inactivity_ms,tier_breakpoints,"
+                     "tier_points,cutoff,tpr,fpr\n");
+        for (size_t s = 0; s < reports.size(); s++) {
+            const SweepSetting_t& setting = reports[s].setting;
+            const DetectionThresholds_t& t = setting.thresholds;
+            for (uint32_t c = 0; c <= MAX_CONFIDENCE_SCORE; c++) {
+                fprintf(out, "%zu,%.3f,%.3f,%.1f,%u,%.3f,%.3f,%u,%.5f,%.5f\n", s,
+                        t.freefall_threshold_g, t.impact_threshold_g, t.rotation_threshold_dps,
+                        t.inactivity_threshold_ms, setting.breakpoint_scale, setting.points_scale, c,
+                        reports[s].tpr[c], reports[s].fpr[c]);
+            }
+        }
+        fclose(out);
+        printf("ROC curves written to %s\n", roc_path);
+    }
+
+    // Best settings by AUC, plus what ships if it is not among them
+    std::vector<size_t> order(reports.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::sort(order.begin(), order.end(),
+              [&reports](size_t a, size_t b) { return reports[a].auc > reports[b].auc; });
+
+    printf("\n%5s %5s %5s %6s | %-11s | %-12s | Score >= %-3u | %5s | %s\n", "Free", "Impct", "Rot",
+           "Inact", "Tiers x", " Detections", CONFIRMED_THRESHOLD, "", "Latency");
+    printf("%5s %5s %5s %6s | %5s %5s | %6s %6s | %6s %6s | %5s | %s\n", "g", "g", "dps", "ms", "Bkpt",
+           "Pts", "Sens", "Spec", "Sens", "Spec", "AUC", "ms");
+    size_t shown = std::min<size_t>(15, order.size());
+    bool shipped_shown = false;
+    for (size_t i = 0; i < shown; i++) {
+        bool shipped = isShipped(reports[order[i]].setting);
+        shipped_shown |= shipped;
+        printSetting(reports[order[i]], shipped);
+    }
+    for (size_t i = shown; i < order.size() && !shipped_shown; i++) {
+        if (isShipped(reports[order[i]].setting)) {
+            printf("  ... (#%zu of %zu)\n", i + 1, order.size());
+            printSetting(reports[order[i]], true);
+            shipped_shown = true;
+        }
+    }
+
+    printf("\nSweep: %.1f s, %.2f M samples/s, %llu steals\n", seconds, samples_run / seconds / 1e6,
+           (unsigned long long)pool.getSteals());
+
+    // The pool must not change results: re-run part of the corpus on this thread
+    bool ok = true;
+    Fall_Pipeline pipeline;
+    std::vector<SensorData_t> buffer;
+    size_t check_traces = std::min<size_t>(CHECK_TRACES, corpus.size());
+    for (size_t i = 0; i < check_traces && ok; i++) {
+        uint32_t impact_ms = renderTrace(corpus[i], params, buffer);
+        const std::vector<SensorData_t>& data =
+            (corpus[i].scenario == MOTION_SCENARIO_COUNT) ? corpus[i].samples : buffer;
+        TraceResult_t single = evaluate(pipeline, settings[0], data.data(), data.size(), impact_ms);
+        const TraceResult_t& pooled = results[i];
+        ok = single.score == pooled.score && single.detected == pooled.detected &&
+             single.latency_ms == pooled.latency_ms;
+    }
+    printf("Pooled = single-thread: %s\n", ok ? "ok" : "FAILED");
+
+    printf("\n%s\n", ok ? "ALL CHECKS PASSED" : "CHECKS FAILED");
+    return ok ? 0 : 1;
+}
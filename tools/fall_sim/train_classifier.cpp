@@ -0,0 +1,538 @@
+/*
+ * SmartFall - Fall Classifier Trainer
+ *
+ * Trains the quantized tree ensemble in detection/fall_classifier.h on
+ * synthetic events from Motion_Generator. Each event runs through the
+ * device FallDetector. Every impact the detector reports yields one
+ * window, cut the same way the firmware cuts it (FallClassifier::observe
+ * and FallDetector::copyHistory). The label is the event's scenario.
+ *
+ * Boosting is on the logistic loss, one depth-3 tree per round. Splits
+ * are on the integer features, and leaves are rounded to Q8 log-odds as
+ * each tree is added, so training sees exactly what the device will
+ * compute. A second seed gives the held-out set.
+ *
+ * Without --write the tool only checks the model compiled into
+ * fall_classifier.cpp:
+ *   - it must match a fresh training run;
+ *   - it must meet the held-out accuracy floor.
+ * It also reports the time per inference. --write regenerates
+ * detection/fall_classifier_model.h and the golden windows used by
+ * tests/Classifier.
+ *
+ * Build (from the repository root):
+ *   g++ -std=c++17 -O2 -Itools/host -ISmartFall -o train_classifier \
+ *       tools/fall_sim/train_classifier.cpp tools/fall_sim/Motion_Generator.cpp \
+ *       SmartFall/sensors/Accel_Ranger.cpp SmartFall/detection/fall_detector.cpp \
+ *       SmartFall/detection/fall_classifier.cpp SmartFall/diagnostics/Deferred_Log.cpp
+ *
+ * Usage: train_classifier [events_per_scenario] [seed] [--write]
+ */
+
+#include <Arduino.h>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include "Motion_Generator.h"
+#include "detection/fall_detector.h"
+#include "detection/fall_classifier.h"
+#include "detection/fall_classifier_model.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define HAVE_TSC 1
+#endif
+
+HostSerial Serial;
+
+#define DEFAULT_EVENTS      1000
+#define DEFAULT_SEED        1
+#define HOLDOUT_SEED_OFFSET 1000
+#define EVENT_GAP_MS        1000
+
+#define TREES               24
+#define DEPTH               FALL_MODEL_DEPTH
+#define NODES               ((1 << DEPTH) - 1)
+#define LEAVES              (1 << DEPTH)
+#define LEARNING_RATE       0.3
+#define L2_LAMBDA           1.0
+#define MIN_CHILD_HESSIAN   2.0
+#define MAX_CANDIDATES      64        // Thresholds tried per feature
+#define SIGMOID_SIZE        256
+#define SIGMOID_SHIFT       4         // Q8 logit per table step: 1/16
+#define NO_SPLIT            32767     // Every value goes left
+
+#define MIN_HOLDOUT_ACCURACY 0.85
+#define GOLDEN_PER_CLASS    2
+#define TIMING_ROUNDS       20        // Inferences per held-out window
+
+#define MODEL_PATH          "SmartFall/detection/fall_classifier_model.h"
+#define GOLDEN_PATH         "SmartFall/tests/Classifier/classifier_golden.h"
+
+typedef struct {
+    FallImuSample_t samples[FALL_CLASSIFIER_WINDOW];
+    uint8_t count;
+    int16_t features[FALL_FEATURE_COUNT];
+    bool fall;
+    MotionScenario_t scenario;
+} Window_t;
+
+typedef struct {
+    int32_t bias;
+    uint8_t feature[TREES][NODES];
+    int16_t threshold[TREES][NODES];
+    int16_t leaf[TREES][LEAVES];
+} Model_t;
+
+typedef struct {
+    double auc;
+    double accuracy;
+    double sensitivity;
+    double specificity;
+} Metrics_t;
+
+static double elapsedSeconds(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void collect(uint32_t seed, uint32_t events, std::vector<Window_t>& windows) {
+    MotionParams_t params;
+    Motion_Generator::defaultParams(params);
+    Motion_Generator generator(params, seed);
+
+    DetectionThresholds_t thresholds = {FREEFALL_THRESHOLD_G, IMPACT_THRESHOLD_G,
+                                        ROTATION_THRESHOLD_DPS, INACTIVITY_THRESHOLD_MS,
+                                        PRESSURE_CHANGE_THRESHOLD_M};
+    FallDetector detector;
+    detector.setThresholds(thresholds);
+    detector.init();
+    FallClassifier classifier;
+
+    static SensorData_t history[FALL_CLASSIFIER_WINDOW];
+    SensorData_t data;
+    uint32_t clock_ms = 0;
+    for (uint32_t e = 0; e < events; e++) {
+        for (uint8_t s = 0; s < MOTION_SCENARIO_COUNT; s++) {
+            generator.plan((MotionScenario_t)s, clock_ms);
+            detector.resetDetection();
+            classifier.reset();
+
+            while (generator.read(data)) {
+                detector.processSensorData(data);
+                if (!classifier.observe(detector.getCurrentStatus())) continue;
+
+                Window_t window;
+                window.count = detector.copyHistory(history, FALL_CLASSIFIER_WINDOW);
+                for (uint8_t i = 0; i < window.count; i++) {
+                    FallClassifier::quantize(history[i], window.samples[i]);
+                }
+                FallClassifier::extractFeatures(window.samples, window.count, window.features);
+                window.fall = Motion_Generator::isFall((MotionScenario_t)s);
+                window.scenario = (MotionScenario_t)s;
+                windows.push_back(window);
+            }
+            clock_ms = data.timestamp + EVENT_GAP_MS;
+        }
+    }
+}
+
+// Same arithmetic as FallClassifier::predictLogit, on a model in memory
+static int32_t predict(const Model_t& model, const int16_t* values) {
+    int32_t sum = model.bias;
+    for (uint8_t t = 0; t < TREES; t++) {
+        uint8_t node = 0;
+        for (uint8_t d = 0; d < DEPTH; d++) {
+            node = 2 * node + 1 + (values[model.feature[t][node]] > model.threshold[t][node]);
+        }
+        sum += model.leaf[t][node - NODES];
+    }
+    return sum;
+}
+
+static int16_t toQ8(double value) {
+    return (int16_t)std::max(-32767.0, std::min(32767.0, std::round(value * 256.0)));
+}
+
+// Fits node `node` of tree `t` on the windows in `members`, then its children
+static void grow(Model_t& model, uint8_t t, uint8_t node, const std::vector<uint32_t>& members,
+                 const std::vector<Window_t>& data, const std::vector<double>& grad,
+                 const std::vector<double>& hess, const std::vector<int16_t>* candidates) {
+    if (node >= NODES) {
+        double g = 0, h = 0;
+        for (uint32_t i : members) {
+            g += grad[i];
+            h += hess[i];
+        }
+        model.leaf[t][node - NODES] = toQ8(-g / (h + L2_LAMBDA) * LEARNING_RATE);
+        return;
+    }
+
+    double g_total = 0, h_total = 0;
+    for (uint32_t i : members) {
+        g_total += grad[i];
+        h_total += hess[i];
+    }
+    double parent = g_total * g_total / (h_total + L2_LAMBDA);
+
+    double best_gain = 1e-9;
+    uint8_t best_feature = 0;
+    int16_t best_threshold = NO_SPLIT;
+    for (uint8_t f = 0; f < FALL_FEATURE_COUNT; f++) {
+        // Left-side sums for every candidate in one pass over the members
+        const std::vector<int16_t>& cuts = candidates[f];
+        std::vector<double> g_left(cuts.size() + 1, 0.0), h_left(cuts.size() + 1, 0.0);
+        for (uint32_t i : members) {
+            size_t slot = std::lower_bound(cuts.begin(), cuts.end(), data[i].features[f]) - cuts.begin();
+            g_left[slot] += grad[i];
+            h_left[slot] += hess[i];
+        }
+        double gl = 0, hl = 0;
+        for (size_t c = 0; c < cuts.size(); c++) {
+            gl += g_left[c];
+            hl += h_left[c];
+            double gr = g_total - gl, hr = h_total - hl;
+            if (hl < MIN_CHILD_HESSIAN || hr < MIN_CHILD_HESSIAN) continue;
+            double gain = gl * gl / (hl + L2_LAMBDA) + gr * gr / (hr + L2_LAMBDA) - parent;
+            if (gain > best_gain) {
+                best_gain = gain;
+                best_feature = f;
+                best_threshold = cuts[c];
+            }
+        }
+    }
+
+    model.feature[t][node] = best_feature;
+    model.threshold[t][node] = best_threshold;
+    std::vector<uint32_t> left, right;
+    for (uint32_t i : members) {
+        (data[i].features[best_feature] > best_threshold ? right : left).push_back(i);
+    }
+    grow(model, t, 2 * node + 1, left, data, grad, hess, candidates);
+    grow(model, t, 2 * node + 2, right, data, grad, hess, candidates);
+}
+
+static void train(const std::vector<Window_t>& data, Model_t& model) {
+    memset(&model, 0, sizeof(model));
+    size_t falls = 0;
+    for (const Window_t& w : data) falls += w.fall;
+    double prior = (falls + 1.0) / (data.size() - falls + 1.0);
+    model.bias = toQ8(std::log(prior));
+
+    // Candidate thresholds: quantiles of each feature
+    std::vector<int16_t> candidates[FALL_FEATURE_COUNT];
+    for (uint8_t f = 0; f < FALL_FEATURE_COUNT; f++) {
+        std::vector<int16_t> values;
+        for (const Window_t& w : data) values.push_back(w.features[f]);
+        std::sort(values.begin(), values.end());
+        for (uint32_t q = 1; q < MAX_CANDIDATES; q++) {
+            candidates[f].push_back(values[values.size() * q / MAX_CANDIDATES]);
+        }
+        candidates[f].erase(std::unique(candidates[f].begin(), candidates[f].end()), candidates[f].end());
+    }
+
+    std::vector<int32_t> margin(data.size(), model.bias);
+    std::vector<double> grad(data.size()), hess(data.size());
+    std::vector<uint32_t> all(data.size());
+    for (uint32_t i = 0; i < data.size(); i++) all[i] = i;
+
+    for (uint8_t t = 0; t < TREES; t++) {
+        for (size_t i = 0; i < data.size(); i++) {
+            double p = 1.0 / (1.0 + std::exp(-margin[i] / 256.0));
+            grad[i] = p - (data[i].fall ? 1.0 : 0.0);
+            hess[i] = std::max(p * (1.0 - p), 1e-6);
+        }
+        grow(model, t, 0, all, data, grad, hess, candidates);
+
+        // Margins advance by the rounded leaves, as on the device
+        for (size_t i = 0; i < data.size(); i++) {
+            uint8_t node = 0;
+            for (uint8_t d = 0; d < DEPTH; d++) {
+                node = 2 * node + 1 + (data[i].features[model.feature[t][node]] > model.threshold[t][node]);
+            }
+            margin[i] += model.leaf[t][node - NODES];
+        }
+    }
+}
+
+static uint8_t sigmoidEntry(uint32_t index) {
+    // Lowest logit of the entry, so logit 0 reads exactly 50%
+    double logit = ((double)index - SIGMOID_SIZE / 2) * (1 << SIGMOID_SHIFT) / 256.0;
+    return (uint8_t)std::lround(100.0 / (1.0 + std::exp(-logit)));
+}
+
+static Metrics_t evaluate(const std::vector<int32_t>& logits, const std::vector<Window_t>& data) {
+    Metrics_t m = {0, 0, 0, 0};
+    size_t pos = 0, neg = 0, tp = 0, tn = 0;
+    for (size_t i = 0; i < data.size(); i++) {
+        bool predicted = logits[i] >= 0;
+        if (data[i].fall) {
+            pos++;
+            tp += predicted;
+        } else {
+            neg++;
+            tn += !predicted;
+        }
+    }
+    // AUC: probability a fall outranks an ADL, ties count half
+    std::vector<size_t> order(data.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return logits[a] < logits[b]; });
+    double rank_sum = 0;
+    for (size_t i = 0; i < order.size();) {
+        size_t j = i;
+        while (j < order.size() && logits[order[j]] == logits[order[i]]) j++;
+        double rank = (i + j + 1) / 2.0;
+        for (size_t k = i; k < j; k++) {
+            if (data[order[k]].fall) rank_sum += rank;
+        }
+        i = j;
+    }
+    if (pos && neg) m.auc = (rank_sum - pos * (pos + 1) / 2.0) / ((double)pos * neg);
+    m.accuracy = data.empty() ? 0 : (double)(tp + tn) / data.size();
+    m.sensitivity = pos ? (double)tp / pos : 0;
+    m.specificity = neg ? (double)tn / neg : 0;
+    return m;
+}
+
+static void printMetrics(const char* name, size_t windows, const Metrics_t& m) {
+    printf("%-10s %8zu %7.3f %8.1f%% %8.1f%% %8.1f%%\n", name, windows, m.auc, m.accuracy * 100,
+           m.sensitivity * 100, m.specificity * 100);
+}
+
+static void writeArray2D(FILE* out, const char* decl, const void* values, bool wide, int rows, int cols) {
+    fprintf(out, "%s = {\n", decl);
+    for (int r = 0; r < rows; r++) {
+        fprintf(out, "    {");
+        for (int c = 0; c < cols; c++) {
+            int v = wide ? ((const int16_t*)values)[r * cols + c] : ((const uint8_t*)values)[r * cols + c];
+            fprintf(out, "%s%d", c ? ", " : "", v);
+        }
+        fprintf(out, "}%s\n", r + 1 < rows ? "," : "");
+    }
+    fprintf(out, "};\n");
+}
+
+static bool writeModel(const Model_t& model, uint32_t seed, uint32_t events, size_t windows,
+                       size_t falls, const Metrics_t& holdout) {
+    FILE* out = fopen(MODEL_PATH, "w");
+    if (out == nullptr) return false;
+
+    fprintf(out, "#ifndef FALL_CLASSIFIER_MODEL_H\n#define FALL_CLASSIFIER_MODEL_H\n\n");
+    fprintf(out, "// Generated by tools/fall_sim/train_classifier.cpp --write; do not edit.\n");
+    fprintf(out, "// Trained on seed %u, %u events per scenario: %zu impact windows, %zu falls.\n",
+            seed, events, windows, falls);
+    fprintf(out, "// Held out (seed %u): AUC %.3f, accuracy %.1f%% at 50%%.\n\n",
+            seed + HOLDOUT_SEED_OFFSET, holdout.auc, holdout.accuracy * 100);
+    fprintf(out, "#define FALL_MODEL_TREES          %d\n", TREES);
+    fprintf(out, "#define FALL_MODEL_DEPTH          %d\n", DEPTH);
+    fprintf(out, "#define FALL_MODEL_NODES          %d     // Split nodes per tree; leaves follow\n", NODES);
+    fprintf(out, "#define FALL_MODEL_SIGMOID_SIZE   %d\n", SIGMOID_SIZE);
+    fprintf(out, "#define FALL_MODEL_SIGMOID_SHIFT  %d     // Q8 logit >> shift indexes the table\n\n", SIGMOID_SHIFT);
+    fprintf(out, "static const int32_t FALL_MODEL_BIAS = %d;   // Q8 log-odds\n\n", model.bias);
+    writeArray2D(out, "static const uint8_t FALL_MODEL_FEATURE[FALL_MODEL_TREES][FALL_MODEL_NODES]",
+                 model.feature, false, TREES, NODES);
+    fprintf(out, "\n");
+    writeArray2D(out, "static const int16_t FALL_MODEL_THRESHOLD[FALL_MODEL_TREES][FALL_MODEL_NODES]",
+                 model.threshold, true, TREES, NODES);
+    fprintf(out, "\n// Q8 log-odds\n");
+    writeArray2D(out, "static const int16_t FALL_MODEL_LEAF[FALL_MODEL_TREES][FALL_MODEL_NODES + 1]",
+                 model.leaf, true, TREES, LEAVES);
+
+    fprintf(out, "\n// Fall probability (%%) per logit step\n");
+    fprintf(out, "static const uint8_t FALL_MODEL_SIGMOID[FALL_MODEL_SIGMOID_SIZE] = {\n");
+    for (uint32_t i = 0; i < SIGMOID_SIZE; i++) {
+        fprintf(out, "%s%u%s", i % 16 == 0 ? "    " : "", sigmoidEntry(i),
+                i + 1 < SIGMOID_SIZE ? (i % 16 == 15 ? ",\n" : ", ") : "\n");
+    }
+    fprintf(out, "};\n\n#endif // FALL_CLASSIFIER_MODEL_H\n");
+    fclose(out);
+    return true;
+}
+
+// Golden windows are scored by the freshly trained model, which --write
+// also compiles into fall_classifier.cpp on the next build
+static bool writeGolden(const Model_t& model, const std::vector<Window_t>& holdout) {
+    std::vector<const Window_t*> picked;
+    for (int fall = 1; fall >= 0; fall--) {
+        int taken = 0;
+        for (const Window_t& w : holdout) {
+            if (w.fall == (bool)fall && w.count == FALL_CLASSIFIER_WINDOW && taken < GOLDEN_PER_CLASS) {
+                picked.push_back(&w);
+                taken++;
+            }
+        }
+    }
+
+    FILE* out = fopen(GOLDEN_PATH, "w");
+    if (out == nullptr) return false;
+    fprintf(out, "#ifndef CLASSIFIER_GOLDEN_H\n#define CLASSIFIER_GOLDEN_H\n\n");
+    fprintf(out, "// Generated by tools/fall_sim/train_classifier.cpp --write; do not edit.\n");
+    fprintf(out, "// Held-out impact windows (mg, dps) and the reference classifier output.\n\n");
+    fprintf(out, "#define GOLDEN_WINDOWS %zu\n\n", picked.size());
+
+    fprintf(out, "static const bool GOLDEN_FALL[GOLDEN_WINDOWS] = {");
+    for (size_t i = 0; i < picked.size(); i++) fprintf(out, "%s%s", i ? ", " : "", picked[i]->fall ? "true" : "false");
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "static const int16_t GOLDEN_SAMPLES[GOLDEN_WINDOWS][FALL_CLASSIFIER_WINDOW][6] = {\n");
+    for (size_t i = 0; i < picked.size(); i++) {
+        fprintf(out, "    {  // %s\n", Motion_Generator::getScenarioName(picked[i]->scenario));
+        for (uint8_t s = 0; s < picked[i]->count; s++) {
+            const FallImuSample_t& q = picked[i]->samples[s];
+            fprintf(out, "        {%d, %d, %d, %d, %d, %d}%s\n", q.accel[0], q.accel[1], q.accel[2],
+                    q.gyro[0], q.gyro[1], q.gyro[2], s + 1 < picked[i]->count ? "," : "");
+        }
+        fprintf(out, "    }%s\n", i + 1 < picked.size() ? "," : "");
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "static const int16_t GOLDEN_FEATURES[GOLDEN_WINDOWS][FALL_FEATURE_COUNT] = {\n");
+    for (size_t i = 0; i < picked.size(); i++) {
+        fprintf(out, "    {");
+        for (uint8_t f = 0; f < FALL_FEATURE_COUNT; f++) fprintf(out, "%s%d", f ? ", " : "", picked[i]->features[f]);
+        fprintf(out, "}%s\n", i + 1 < picked.size() ? "," : "");
+    }
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "static const int32_t GOLDEN_LOGIT[GOLDEN_WINDOWS] = {");
+    for (size_t i = 0; i < picked.size(); i++) fprintf(out, "%s%d", i ? ", " : "", predict(model, picked[i]->features));
+    fprintf(out, "};\n\n");
+
+    fprintf(out, "static const uint8_t GOLDEN_PROBABILITY[GOLDEN_WINDOWS] = {");
+    for (size_t i = 0; i < picked.size(); i++) {
+        int32_t logit = std::max(-(SIGMOID_SIZE / 2 << SIGMOID_SHIFT),
+                                 std::min((SIGMOID_SIZE / 2 << SIGMOID_SHIFT) - 1, predict(model, picked[i]->features)));
+        fprintf(out, "%s%u", i ? ", " : "", sigmoidEntry((logit + (SIGMOID_SIZE / 2 << SIGMOID_SHIFT)) >> SIGMOID_SHIFT));
+    }
+    fprintf(out, "};\n\n#endif // CLASSIFIER_GOLDEN_H\n");
+    fclose(out);
+    return true;
+}
+
+static bool sameAsCompiled(const Model_t& model) {
+    if (FALL_MODEL_TREES != TREES || FALL_MODEL_BIAS != model.bias) return false;
+    return memcmp(FALL_MODEL_FEATURE, model.feature, sizeof(model.feature)) == 0 &&
+           memcmp(FALL_MODEL_THRESHOLD, model.threshold, sizeof(model.threshold)) == 0 &&
+           memcmp(FALL_MODEL_LEAF, model.leaf, sizeof(model.leaf)) == 0;
+}
+
+int main(int argc, char** argv) {
+    uint32_t events = DEFAULT_EVENTS;
+    uint32_t seed = DEFAULT_SEED;
+    bool write = false;
+    int positional = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--write") == 0) {
+            write = true;
+        } else if (positional++ == 0) {
+            events = (uint32_t)atoi(argv[i]);
+        } else {
+            seed = (uint32_t)atoi(argv[i]);
+        }
+    }
+    if (events == 0) events = DEFAULT_EVENTS;
+    Serial.stream = nullptr;   // Detector debug output
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<Window_t> training, holdout;
+    collect(seed, events, training);
+    collect(seed + HOLDOUT_SEED_OFFSET, events, holdout);
+    double collect_s = elapsedSeconds(start);
+
+    size_t falls = 0;
+    for (const Window_t& w : training) falls += w.fall;
+    printf("Events: %u per scenario, seed %u (held out: seed %u)\n", events, seed, seed + HOLDOUT_SEED_OFFSET);
+    printf("Impact windows: %zu training (%zu falls), %zu held out, collected in %.1f s\n\n",
+           training.size(), falls, holdout.size(), collect_s);
+    if (falls == 0 || falls == training.size()) {
+        printf("Need windows of both classes\n");
+        return 1;
+    }
+
+    start = std::chrono::steady_clock::now();
+    Model_t model;
+    train(training, model);
+    printf("Trained %d trees of depth %d in %.2f s\n\n", TREES, DEPTH, elapsedSeconds(start));
+
+    std::vector<int32_t> train_logits, holdout_logits, compiled_logits;
+    for (const Window_t& w : training) train_logits.push_back(predict(model, w.features));
+    for (const Window_t& w : holdout) {
+        holdout_logits.push_back(predict(model, w.features));
+        compiled_logits.push_back(FallClassifier::predictLogit(w.features));
+    }
+
+    printf("%-10s %8s %7s %9s %9s %9s\n", "Set", "Windows", "AUC", "Accuracy", "Sensitiv.", "Specific.");
+    Metrics_t train_metrics = evaluate(train_logits, training);
+    Metrics_t holdout_metrics = evaluate(holdout_logits, holdout);
+    printMetrics("training", training.size(), train_metrics);
+    printMetrics("held out", holdout.size(), holdout_metrics);
+
+    // Where the held-out windows come from and how they score
+    printf("\n%-16s %8s %12s\n", "Scenario", "Windows", "Mean prob.");
+    for (uint8_t s = 0; s < MOTION_SCENARIO_COUNT; s++) {
+        uint32_t count = 0, sum = 0;
+        for (size_t i = 0; i < holdout.size(); i++) {
+            if (holdout[i].scenario != s) continue;
+            count++;
+            sum += FallClassifier::toProbability(holdout_logits[i]);
+        }
+        printf("%-16s %8u %11.1f%%\n", Motion_Generator::getScenarioName((MotionScenario_t)s), count,
+               count ? (double)sum / count : 0.0);
+    }
+
+    bool ok = true;
+    if (write) {
+        ok &= writeModel(model, seed, events, training.size(), falls, holdout_metrics);
+        ok &= writeGolden(model, holdout);
+        printf("\nWrote %s and %s%s\n", MODEL_PATH, GOLDEN_PATH, ok ? "" : " (FAILED)");
+        printf("Rebuild and run without --write to check the compiled-in model.\n");
+        return ok ? 0 : 1;
+    }
+
+    // Inference cost through the device entry point: quantize, features, trees
+    std::vector<SensorData_t> replay(holdout.size() * FALL_CLASSIFIER_WINDOW);
+    for (size_t i = 0; i < holdout.size(); i++) {
+        for (uint8_t s = 0; s < holdout[i].count; s++) {
+            const FallImuSample_t& q = holdout[i].samples[s];
+            SensorData_t& d = replay[i * FALL_CLASSIFIER_WINDOW + s];
+            d.accel_x = q.accel[0] / 1000.0f;
+            d.accel_y = q.accel[1] / 1000.0f;
+            d.accel_z = q.accel[2] / 1000.0f;
+            d.gyro_x = q.gyro[0];
+            d.gyro_y = q.gyro[1];
+            d.gyro_z = q.gyro[2];
+        }
+    }
+    static FallClassifier classifier;
+    bool replay_exact = true;
+    uint64_t inferences = 0;
+    uint32_t checksum = 0;
+#ifdef HAVE_TSC
+    uint64_t cycles_start = __rdtsc();
+#endif
+    start = std::chrono::steady_clock::now();
+    // Repeats stay on one window, which is cache-hot on the device too
+    for (size_t i = 0; i < holdout.size(); i++) {
+        for (uint32_t r = 0; r < TIMING_ROUNDS; r++) {
+            checksum += classifier.classify(&replay[i * FALL_CLASSIFIER_WINDOW], holdout[i].count);
+            if (r == 0) replay_exact &= classifier.getLogit() == compiled_logits[i];
+            inferences++;
+        }
+    }
+    double inference_ns = elapsedSeconds(start) * 1e9 / inferences;
+    printf("\nInference:  %.0f ns per window (%llu windows, checksum %u)", inference_ns,
+           (unsigned long long)inferences, checksum);
+#ifdef HAVE_TSC
+    printf(", %.0f TSC cycles", (double)(__rdtsc() - cycles_start) / inferences);
+#endif
+    printf("\n");
+
+    bool compiled_ok = sameAsCompiled(model);
+    bool accuracy_ok = holdout_metrics.accuracy >= MIN_HOLDOUT_ACCURACY;
+    printf("\nCompiled-in model matches training: %s\n", compiled_ok ? "ok" : "FAILED (run with --write)");
+    printf("Device path matches reference:      %s\n", replay_exact ? "ok" : "FAILED");
+    printf("Held-out accuracy >= %.0f%%:          %s\n", MIN_HOLDOUT_ACCURACY * 100, accuracy_ok ? "ok" : "FAILED");
+    ok &= compiled_ok && replay_exact && accuracy_ok;
+
+    printf("\n%s\n", ok ? "ALL CHECKS PASSED" : "CHECKS FAILED");
+    return ok ? 0 : 1;
+}
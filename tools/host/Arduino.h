@@ -0,0 +1,71 @@
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+/*
+ * Minimal Arduino stand-in for building SmartFall modules on a desktop
+ * host (tools and benchmarks). Only what the shared modules use: integer
+ * types, millis/micros/delay and a stdout-backed Serial. ARDUINO is left
+ * undefined so ESP-specific code paths compile out.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <chrono>
+#include <thread>
+
+#define HEX 16
+#define DEC 10
+#define IRAM_ATTR                 // No flash cache on the host
+
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+inline uint32_t micros() {
+    static const auto origin = std::chrono::steady_clock::now();
+    return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - origin).count();
+}
+
+inline uint32_t millis() {
+    return micros() / 1000;
+}
+
+inline void delay(uint32_t ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+class HostSerial {
+public:
+    FILE* stream = stdout;      // nullptr mutes device logging in benchmarks
+
+    void begin(unsigned long) {}
+    void flush() { if (stream) fflush(stream); }
+    size_t write(const uint8_t* data, size_t length) {
+        return stream ? fwrite(data, 1, length, stream) : length;
+    }
+
+    void print(const char* s) { if (stream) fputs(s, stream); }
+    void print(char c) { if (stream) fputc(c, stream); }
+    void print(bool b) { print(b ? 1 : 0); }
+    void print(int v, int base = DEC) { print((long)v, base); }
+    void print(unsigned int v, int base = DEC) { print((unsigned long)v, base); }
+    void print(long v, int base = DEC) { if (stream) fprintf(stream, base == HEX ? "%lX" : "%ld", v); }
+    void print(unsigned long v, int base = DEC) {
+        if (stream) fprintf(stream, base == HEX ? "%lX" : "%lu", v);
+    }
+    void print(double v, int digits = 2) { if (stream) fprintf(stream, "%.*f", digits, v); }
+
+    template <typename T> void println(T v) { print(v); println(); }
+    template <typename T> void println(T v, int format) { print(v, format); println(); }
+    void println() { if (stream) fputc('\n', stream); }
+};
+
+extern HostSerial Serial;
+
+#endif // HOST_ARDUINO_H
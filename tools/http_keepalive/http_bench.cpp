@@ -0,0 +1,413 @@
+/*
+ * SmartFall - HTTP Keep-Alive Benchmark
+ *
+ * Runs the device-side HTTP_Connection against a stand-in alert server on
+ * the loopback interface and measures alert first-byte latency (request()
+ * call -> first response byte, including any connect) with one connection
+ * per request (the old HTTPClient begin/end behaviour) and with the
+ * persistent, pre-warmed connection. Also checks the protocol edge cases:
+ * chunked bodies, HEAD, Connection: close, a server dropping an idle
+ * socket, stale-socket retry and response timeouts.
+ *
+ * Link model: loopback is ~0 ms, so the client socket adds one RTT per
+ * TCP connect and the server adds one RTT before each response. For
+ * https:// URLs the socket adds a TLS 1.2 handshake of 2 RTT plus the
+ * ESP32 mbedTLS crypto time (ECDHE-P256 + certificate verify, ~450 ms at
+ * 240 MHz) without encrypting anything; what matters here is how often
+ * that cost is paid, not the cipher.
+ *
+ * Build (from the repository root):
+ *   g++ -std=c++17 -O2 -pthread -Itools/host -ISmartFall -o http_bench \
+ *       tools/http_keepalive/http_bench.cpp SmartFall/communication/HTTP_Connection.cpp
+ *
+ * Usage: http_bench [rtt_ms]
+ */
+
+#include <Arduino.h>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+#include <errno.h>
+#include "communication/HTTP_Connection.h"
+
+HostSerial Serial;
+
+#define DEFAULT_RTT_MS       60
+#define TLS_CRYPTO_MS        450
+#define ALERT_COUNT          8
+#define ALERT_SPACING_MS     600    // Longer than the server idle timeout
+#define SERVER_IDLE_MS       400    // Stand-in for a server keep-alive timeout
+#define HEARTBEAT_MS         250
+#define SERVICE_INTERVAL_MS  10
+#define RESPONSE_TIMEOUT_MS  300
+
+static uint32_t link_rtt_ms = DEFAULT_RTT_MS;
+static int failures = 0;
+
+static void check(bool condition, const char* what) {
+    if (!condition) {
+        printf("  FAIL: %s\n", what);
+        failures++;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Stand-in alert server
+// ---------------------------------------------------------------------------
+
+static std::atomic<uint32_t> server_connections(0);
+static std::atomic<uint32_t> server_requests(0);
+static uint16_t server_port = 0;
+
+static bool writeAll(int fd, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        ssize_t n = ::send(fd, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        sent += n;
+    }
+    return true;
+}
+
+static void serveConnection(int fd) {
+    std::string buffer;
+    bool drop_next = false;
+    char chunk[1024];
+
+    while (true) {
+        // Read one request (headers + Content-Length body), closing when idle
+        size_t header_end;
+        while ((header_end = buffer.find("\r\n\r\n")) == std::string::npos) {
+            pollfd pfd = {fd, POLLIN, 0};
+            if (poll(&pfd, 1, SERVER_IDLE_MS) <= 0) { close(fd); return; }
+            ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+            if (n <= 0) { close(fd); return; }
+            buffer.append(chunk, n);
+        }
+
+        std::string head = buffer.substr(0, header_end);
+        size_t content_length = 0;
+        size_t cl = head.find("Content-Length: ");
+        if (cl != std::string::npos) content_length = strtoul(head.c_str() + cl + 16, nullptr, 10);
+        while (buffer.size() < header_end + 4 + content_length) {
+            ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+            if (n <= 0) { close(fd); return; }
+            buffer.append(chunk, n);
+        }
+        buffer.erase(0, header_end + 4 + content_length);
+
+        std::string method = head.substr(0, head.find(' '));
+        size_t path_start = head.find(' ') + 1;
+        std::string path = head.substr(path_start, head.find(' ', path_start) - path_start);
+        server_requests++;
+
+        if (drop_next) {
+            close(fd);    // Server gave up on the socket just as a request arrived
+            return;
+        }
+        if (path == "/silent") {
+            delay(RESPONSE_TIMEOUT_MS * 2);
+            close(fd);
+            return;
+        }
+
+        delay(link_rtt_ms);   // Request + response flight time
+
+        std::string response;
+        bool close_after = head.find("Connection: close") != std::string::npos;
+        if (path == "/chunked") {
+            response = "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n"
+                       "5\r\nhello\r\n6\r\n world\r\n0\r\n\r\n";
+        } else if (path == "/close") {
+            response = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\nConnection: close\r\n\r\nok";
+            close_after = true;
+        } else if (path == "/arm-drop") {
+            response = "HTTP/1.1 200 OK\r\nContent-Length: 0\r\n\r\n";
+            drop_next = true;
+        } else if (method == "HEAD") {
+            response = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\n";   // HEAD: no body follows
+        } else if (path == "/api/emergency") {
+            response = "HTTP/1.1 201 Created\r\nContent-Length: 11\r\n\r\n{\"ok\":true}";
+        } else {
+            response = "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n";
+        }
+
+        if (!writeAll(fd, response) || close_after) {
+            close(fd);
+            return;
+        }
+    }
+}
+
+static void startServer() {
+    int listener = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+    if (bind(listener, (sockaddr*)&address, sizeof(address)) != 0 || listen(listener, 8) != 0) {
+        perror("server");
+        exit(1);
+    }
+    socklen_t length = sizeof(address);
+    getsockname(listener, (sockaddr*)&address, &length);
+    server_port = ntohs(address.sin_port);
+
+    std::thread([listener]() {
+        while (true) {
+            int fd = accept(listener, nullptr, nullptr);
+            if (fd < 0) continue;
+            server_connections++;
+            std::thread(serveConnection, fd).detach();
+        }
+    }).detach();
+}
+
+// ---------------------------------------------------------------------------
+// Client socket with the link model
+// ---------------------------------------------------------------------------
+
+class Posix_Socket : public HTTP_Socket {
+private:
+    int fd = -1;
+
+public:
+    ~Posix_Socket() { close(); }
+
+    bool open(const char* host, uint16_t port, bool tls, uint32_t timeout_ms) override {
+        (void)timeout_ms;
+        close();
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        // Handshake time is spent before the server sees the socket, so it
+        // does not eat into the server's idle timeout
+        delay(link_rtt_ms);                                  // SYN / SYN-ACK
+        if (tls) delay(2 * link_rtt_ms + TLS_CRYPTO_MS);     // TLS 1.2 full handshake
+
+        sockaddr_in address = {};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        if (inet_pton(AF_INET, strcmp(host, "localhost") == 0 ? "127.0.0.1" : host, &address.sin_addr) != 1 ||
+            connect(fd, (sockaddr*)&address, sizeof(address)) != 0) {
+            close();
+            return false;
+        }
+        return true;
+    }
+
+    bool isOpen() override {
+        if (fd < 0) return false;
+        char probe;
+        ssize_t n = recv(fd, &probe, 1, MSG_PEEK | MSG_DONTWAIT);
+        return n > 0 || (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK));
+    }
+
+    bool send(const uint8_t* data, size_t length) override {
+        return fd >= 0 && writeAll(fd, std::string((const char*)data, length));
+    }
+
+    int receive(uint8_t* buffer, size_t length) override {
+        if (fd < 0) return -1;
+        ssize_t n = recv(fd, buffer, length, MSG_DONTWAIT);
+        if (n > 0) return (int)n;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return 0;
+        return -1;
+    }
+
+    void close() override {
+        if (fd >= 0) {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Scenarios
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    const char* name;
+    bool tls;
+    bool keep_alive;
+    bool heartbeat;
+} Scenario_t;
+
+typedef struct {
+    float mean_ms;
+    float max_ms;
+    uint32_t connects;
+    uint32_t ok;
+} Result_t;
+
+static void serviceFor(HTTP_Connection& connection, uint32_t duration_ms) {
+    uint32_t start = millis();
+    while (millis() - start < duration_ms) {
+        connection.service();
+        delay(SERVICE_INTERVAL_MS);
+    }
+}
+
+static Result_t runScenario(const Scenario_t& scenario) {
+    char server[64];
+    char endpoint[96];
+    snprintf(server, sizeof(server), "%s://127.0.0.1:%u", scenario.tls ? "https" : "http", server_port);
+    snprintf(endpoint, sizeof(endpoint), "%s/api/emergency", server);
+
+    Posix_Socket socket;
+    HTTP_Connection connection(&socket);
+    connection.setKeepAlive(scenario.keep_alive);
+    connection.setHeartbeat(scenario.heartbeat ? HEARTBEAT_MS : 0xFFFFFFFF, "/api/ping");
+    connection.setTimeouts(2000, 2000);
+    connection.setServer(server);
+    connection.warm();   // WiFi just came up
+
+    static const uint8_t alert[950] = {0};   // Typical binary alert size
+    std::vector<float> latencies;
+    Result_t result = {};
+
+    for (int i = 0; i < ALERT_COUNT; i++) {
+        serviceFor(connection, ALERT_SPACING_MS);
+        int status = connection.post(endpoint, alert, sizeof(alert), "application/x-smartfall-alert");
+        if (status == 201) result.ok++;
+        latencies.push_back(connection.getStats().last_first_byte_us / 1000.0f);
+    }
+
+    float sum = 0;
+    for (float latency : latencies) sum += latency;
+    result.mean_ms = sum / latencies.size();
+    result.max_ms = *std::max_element(latencies.begin(), latencies.end());
+    result.connects = connection.getStats().connects;
+    return result;
+}
+
+static void testProtocol() {
+    printf("\nProtocol checks\n");
+    char base[64];
+    char url[128];
+    char body[64];
+    snprintf(base, sizeof(base), "http://127.0.0.1:%u", server_port);
+
+    Posix_Socket socket;
+    HTTP_Connection connection(&socket);
+    connection.setTimeouts(1000, RESPONSE_TIMEOUT_MS);
+    connection.setServer(base);
+    check(connection.warm(), "warm opens the server socket");
+
+    snprintf(url, sizeof(url), "%s/chunked", base);
+    check(connection.get(url, body, sizeof(body)) == 200 && strcmp(body, "hello world") == 0,
+          "chunked body decoded");
+
+    snprintf(url, sizeof(url), "%s/api/ping", base);
+    check(connection.request("HEAD", url, nullptr, nullptr, 0) == 200, "HEAD answered");
+    snprintf(url, sizeof(url), "%s/api/emergency", base);
+    check(connection.get(url, body, sizeof(body)) == 201 && strcmp(body, "{\"ok\":true}") == 0,
+          "HEAD Content-Length not read as body");
+    check(connection.getStats().connects == 1 && connection.getStats().reuses == 3,
+          "all requests on the warmed socket");
+
+    // Server says Connection: close -> next request reconnects
+    snprintf(url, sizeof(url), "%s/close", base);
+    check(connection.get(url, body, sizeof(body)) == 200 && strcmp(body, "ok") == 0, "close response read");
+    check(!connection.isOpen(), "socket closed after Connection: close");
+    snprintf(url, sizeof(url), "%s/api/emergency", base);
+    check(connection.get(url, body, sizeof(body)) == 201, "request after close");
+    check(connection.getStats().connects == 2, "reconnected once");
+
+    // Server drops the socket as the next request arrives -> one transparent resend
+    snprintf(url, sizeof(url), "%s/arm-drop", base);
+    check(connection.get(url, body, sizeof(body)) == 200, "arm drop");
+    snprintf(url, sizeof(url), "%s/api/emergency", base);
+    check(connection.post(url, (const uint8_t*)"x", 1, "text/plain") == 201, "stale socket retried");
+    check(connection.getStats().stale_retries == 1, "one stale retry counted");
+
+    // Idle close noticed by service() and reopened before the next request
+    uint32_t connects = connection.getStats().connects;
+    connection.setHeartbeat(0xFFFFFFFF, "/api/ping");
+    delay(SERVER_IDLE_MS + 100);
+    check(!connection.isOpen(), "server idle timeout closed the socket");
+    connection.setHeartbeat(0, "/api/ping");
+    connection.service();
+    check(connection.isOpen() && connection.getStats().server_closes == 1, "service() reopened the socket");
+    check(connection.getStats().connects == connects + 1, "reopen counted as a connect");
+
+    // No response -> timeout, not a resend
+    snprintf(url, sizeof(url), "%s/silent", base);
+    uint32_t start = millis();
+    uint32_t requests = server_requests;
+    int status = connection.get(url, body, sizeof(body));
+    uint32_t elapsed = millis() - start;
+    check(status == HTTP_ERR_TIMEOUT, "silent server times out");
+    check(elapsed >= RESPONSE_TIMEOUT_MS && elapsed < RESPONSE_TIMEOUT_MS + 100, "timeout honoured");
+    check(server_requests == requests + 1, "timed-out request not resent");
+
+    // Nothing listening
+    snprintf(url, sizeof(url), "http://127.0.0.1:1/api/emergency");
+    check(connection.post(url, (const uint8_t*)"x", 1, "text/plain") == HTTP_ERR_CONNECT, "connect failure reported");
+
+    // URL parsing
+    bool tls;
+    char host[HTTP_HOST_MAX_LENGTH];
+    uint16_t port;
+    const char* path;
+    check(HTTP_Connection::parseURL("https://alerts.example.com/api/x", tls, host, sizeof(host), port, path) &&
+          tls && port == 443 && strcmp(host, "alerts.example.com") == 0 && strcmp(path, "/api/x") == 0,
+          "https URL parsed");
+    check(HTTP_Connection::parseURL("http://10.0.0.2:8080", tls, host, sizeof(host), port, path) &&
+          !tls && port == 8080 && strcmp(path, "/") == 0, "port and empty path parsed");
+    check(!HTTP_Connection::parseURL("ftp://x", tls, host, sizeof(host), port, path), "unknown scheme rejected");
+    check(!HTTP_Connection::parseURL("http://x:99999/", tls, host, sizeof(host), port, path), "bad port rejected");
+
+    printf("  %s\n", failures == 0 ? "ok" : "failed");
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1) link_rtt_ms = strtoul(argv[1], nullptr, 10);
+    startServer();
+
+    printf("SmartFall HTTP keep-alive benchmark\n");
+    printf("RTT %u ms, TLS crypto %u ms, %d alerts %u ms apart, server idle timeout %u ms\n\n",
+           link_rtt_ms, TLS_CRYPTO_MS, ALERT_COUNT, ALERT_SPACING_MS, SERVER_IDLE_MS);
+
+    const Scenario_t scenarios[] = {
+        {"http  per-request",          false, false, false},
+        {"http  keep-alive",           false, true,  true},
+        {"https per-request",          true,  false, false},
+        {"https keep-alive",           true,  true,  true},
+        {"https keep-alive, no beat",  true,  true,  false},
+    };
+    Result_t results[5];
+
+    printf("%-28s %10s %10s %9s %6s\n", "scenario", "mean ms", "max ms", "connects", "ok");
+    for (int i = 0; i < 5; i++) {
+        results[i] = runScenario(scenarios[i]);
+        printf("%-28s %10.1f %10.1f %9u %4u/%d\n", scenarios[i].name, results[i].mean_ms,
+               results[i].max_ms, results[i].connects, results[i].ok, ALERT_COUNT);
+        check(results[i].ok == ALERT_COUNT, "every alert delivered");
+    }
+
+    // Keep-alive: one connect at warm-up, every alert on the open socket
+    check(results[1].connects == 1 && results[3].connects == 1, "keep-alive connects once");
+    check(results[3].max_ms < 2 * link_rtt_ms, "warm https alert is one round trip");
+    check(results[2].mean_ms - results[3].mean_ms > TLS_CRYPTO_MS, "keep-alive saves the TLS handshake");
+    check(results[0].mean_ms > results[1].mean_ms + link_rtt_ms / 2, "keep-alive saves the TCP handshake");
+    // Without heartbeats the server's idle timeout closes the socket between alerts
+    check(results[4].connects > 1, "idle close without heartbeat");
+
+    testProtocol();
+
+    printf("\n%s\n", failures == 0 ? "ALL CHECKS PASSED" : "CHECKS FAILED");
+    return failures == 0 ? 0 : 1;
+}
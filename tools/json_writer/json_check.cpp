@@ -0,0 +1,341 @@
+/*
+ * SmartFall - JSON_Writer Host Check
+ *
+ * Serializes fixed documents with every JSON_Writer payload layout and
+ * compares the bytes with what ArduinoJson 6.21 serializeJson() writes
+ * for the same JsonDocument: key order, string escaping, and the
+ * FloatParts formatting of widened floats (9 significant decimals,
+ * exponent outside [1e-5, 1e7), NaN/Inf as null, -0 as 0).
+ *
+ * The expected strings were produced offline by a separate port of
+ * ArduinoJson's TextFormatter/FloatParts rules, not by JSON_Writer, so
+ * the two implementations check each other. tests/JSON/ compares against
+ * the real library on the device.
+ *
+ * Every operator new and malloc is counted while a payload is written;
+ * the writer must not allocate.
+ *
+ * Build (from the repository root):
+ *   g++ -std=c++17 -O2 -Itools/host -ISmartFall -o json_check \
+ *       tools/json_writer/json_check.cpp SmartFall/communication/JSON_Writer.cpp
+ *
+ * Usage: json_check
+ */
+
+#include <Arduino.h>
+#include <new>
+#include "communication/JSON_Writer.h"
+
+HostSerial Serial;
+
+// Allocation hook
+
+static bool counting = false;
+static uint32_t allocations = 0;
+
+#if defined(__GLIBC__)
+// Interpose the C allocator, so a stray strdup or stdio buffer shows up too
+extern "C" void* __libc_malloc(size_t size);
+extern "C" void* __libc_calloc(size_t count, size_t size);
+extern "C" void* __libc_realloc(void* p, size_t size);
+
+extern "C" void* malloc(size_t size) {
+    if (counting) allocations++;
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(size_t count, size_t size) {
+    if (counting) allocations++;
+    return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void* p, size_t size) {
+    if (counting) allocations++;
+    return __libc_realloc(p, size);
+}
+#endif
+
+void* operator new(size_t size) {
+#if !defined(__GLIBC__)
+    if (counting) allocations++;    // Otherwise counted by malloc above
+#endif
+    void* p = malloc(size ? size : 1);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+// Out of line, so GCC does not pair the inlined free() with operator new
+__attribute__((noinline)) void operator delete(void* p) noexcept { free(p); }
+__attribute__((noinline)) void operator delete[](void* p) noexcept { free(p); }
+__attribute__((noinline)) void operator delete(void* p, size_t) noexcept { free(p); }
+__attribute__((noinline)) void operator delete[](void* p, size_t) noexcept { free(p); }
+
+// Fixed documents
+
+typedef struct {
+    uint32_t timestamp;
+    float accel_x, accel_y, accel_z;
+    float gyro_x, gyro_y, gyro_z;
+    float pressure;
+    float heart_rate;
+    uint16_t fsr_value;
+} SampleRow_t;
+
+// Float edge cases: zero, negative zero, float rounding, both exponent
+// thresholds, the float range limits, NaN and infinities
+static const SampleRow_t EDGE_ROWS[] = {
+    {0u, 0.0f, -0.0f, 1.0f, 0.1f, 9.81f, 1013.25f, 1e7f, 9999999.5f, 0},
+    {4294967295u, 1e-5f, 1.5e-5f, 3.4e38f, 1.2e-38f, -123.456f, NAN, INFINITY, -INFINITY, 65535},
+    {123456u, -0.012f, 0.981f, 1.234f, 12.5f, -3.75f, 250.0f, 1013.2f, 72.0f, 512},
+};
+
+// Twelve samples, so the WiFi layout must drop the oldest two
+static const SampleRow_t HISTORY_ROWS[] = {
+    {5000u, -0.05f, 0.02f, 0.98f, -4.0f, -2.25f, 0.0f, 1013.25f, 70.0f, 300},
+    {5010u, -0.037f, 0.013f, 0.991f, -2.5f, -1.5f, 0.3f, 1013.24f, 70.5f, 301},
+    {5020u, -0.024f, 0.006f, 1.002f, -1.0f, -0.75f, 0.6f, 1013.23f, 71.0f, 302},
+    {5030u, -0.011f, -0.001f, 1.013f, 0.5f, 0.0f, 0.9f, 1013.22f, 71.5f, 303},
+    {5040u, 0.002f, -0.008f, 1.024f, 2.0f, 0.75f, 1.2f, 1013.21f, 72.0f, 304},
+    {5050u, 0.015f, -0.015f, 1.035f, 3.5f, 1.5f, 1.5f, 1013.2f, 72.5f, 305},
+    {5060u, 0.028f, -0.022f, 1.046f, 5.0f, 2.25f, 1.8f, 1013.19f, 73.0f, 306},
+    {5070u, 0.041f, -0.029f, 1.057f, 6.5f, 3.0f, 2.1f, 1013.18f, 73.5f, 307},
+    {5080u, 0.054f, -0.036f, 1.068f, 8.0f, 3.75f, 2.4f, 1013.17f, 74.0f, 308},
+    {5090u, 0.067f, -0.043f, 1.079f, 9.5f, 4.5f, 2.7f, 1013.16f, 74.5f, 309},
+    {5100u, 0.08f, -0.05f, 1.09f, 11.0f, 5.25f, 3.0f, 1013.15f, 75.0f, 310},
+    {5110u, 0.093f, -0.057f, 1.101f, 12.5f, 6.0f, 3.3f, 1013.14f, 75.5f, 311}
+};
+
+static const char* const EXPECTED_SENSOR[] = {
+        "{\"timestamp\":0,\"accel_x\":0,\"accel_y\":0,\"accel_z\":1,\"gyro_x\":0.100000001,"
+        "\"gyro_y\":9.81000042,\"gyro_z\":1013.25,\"pressure\":1e7,\"heart_rate\":1e7,"
+        "\"fsr_value\":0}",
+        "{\"timestamp\":4294967295,\"accel_x\":9.999999747e-6,\"accel_y\":0.000015,"
+        "\"accel_z\":3.399999952e38,\"gyro_x\":1.199999978e-38,\"gyro_y\":-123.4560013,"
+        "\"gyro_z\":null,\"pressure\":null,\"heart_rate\":null,\"fsr_value\":65535}",
+        "{\"timestamp\":123456,\"accel_x\":-0.012,\"accel_y\":0.981000006,"
+        "\"accel_z\":1.233999968,\"gyro_x\":12.5,\"gyro_y\":-3.75,\"gyro_z\":250,"
+        "\"pressure\":1013.200012,\"heart_rate\":72,\"fsr_value\":512}",
+};
+
+static const char EXPECTED_BLE_SENSOR[] =
+        "{\"type\":\"sensor\",\"timestamp\":123456,\"accel_x\":-0.012,\"accel_y\":0.981000006,"
+        "\"accel_z\":1.233999968,\"gyro_x\":12.5,\"gyro_y\":-3.75,\"gyro_z\":250,"
+        "\"heart_rate\":72,\"pressure\":1013.200012}";
+
+static const char EXPECTED_EMERGENCY[] =
+        "{\"timestamp\":987654,\"confidence_score\":92,\"confidence_level\":4,"
+        "\"battery_level\":76.5,\"sos_triggered\":false,"
+        "\"device_id\":\"SF-\\\"A1\\\"\\\\B2\\tC3\",\"sensor_history\":[{\"timestamp\":5020,"
+        "\"accel_x\":-0.024,\"accel_y\":0.006,\"accel_z\":1.001999974,\"gyro_x\":-1,"
+        "\"gyro_y\":-0.75,\"gyro_z\":0.600000024,\"heart_rate\":71},{\"timestamp\":5030,"
+        "\"accel_x\":-0.011,\"accel_y\":-0.001,\"accel_z\":1.013000011,\"gyro_x\":0.5,"
+        "\"gyro_y\":0,\"gyro_z\":0.899999976,\"heart_rate\":71.5},{\"timestamp\":5040,"
+        "\"accel_x\":0.002,\"accel_y\":-0.008,\"accel_z\":1.024000049,\"gyro_x\":2,"
+        "\"gyro_y\":0.75,\"gyro_z\":1.200000048,\"heart_rate\":72},{\"timestamp\":5050,"
+        "\"accel_x\":0.015,\"accel_y\":-0.015,\"accel_z\":1.034999967,\"gyro_x\":3.5,"
+        "\"gyro_y\":1.5,\"gyro_z\":1.5,\"heart_rate\":72.5},{\"timestamp\":5060,"
+        "\"accel_x\":0.028000001,\"accel_y\":-0.022,\"accel_z\":1.046000004,\"gyro_x\":5,"
+        "\"gyro_y\":2.25,\"gyro_z\":1.799999952,\"heart_rate\":73},{\"timestamp\":5070,"
+        "\"accel_x\":0.041000001,\"accel_y\":-0.028999999,\"accel_z\":1.057000041,\"gyro_x\":6.5,"
+        "\"gyro_y\":3,\"gyro_z\":2.099999905,\"heart_rate\":73.5},{\"timestamp\":5080,"
+        "\"accel_x\":0.054000001,\"accel_y\":-0.035999998,\"accel_z\":1.067999959,\"gyro_x\":8,"
+        "\"gyro_y\":3.75,\"gyro_z\":2.400000095,\"heart_rate\":74},{\"timestamp\":5090,"
+        "\"accel_x\":0.067000002,\"accel_y\":-0.043000001,\"accel_z\":1.078999996,\"gyro_x\":9.5,"
+        "\"gyro_y\":4.5,\"gyro_z\":2.700000048,\"heart_rate\":74.5},{\"timestamp\":5100,"
+        "\"accel_x\":0.079999998,\"accel_y\":-0.050000001,\"accel_z\":1.090000033,\"gyro_x\":11,"
+        "\"gyro_y\":5.25,\"gyro_z\":3,\"heart_rate\":75},{\"timestamp\":5110,"
+        "\"accel_x\":0.093000002,\"accel_y\":-0.057,\"accel_z\":1.100999951,\"gyro_x\":12.5,"
+        "\"gyro_y\":6,\"gyro_z\":3.299999952,\"heart_rate\":75.5}]}";
+
+static const char EXPECTED_BLE_EMERGENCY[] =
+        "{\"type\":\"emergency\",\"timestamp\":987654,\"confidence_score\":92,"
+        "\"confidence_level\":4,\"battery_level\":76.5,\"sos_triggered\":false,"
+        "\"device_id\":\"SF-\\\"A1\\\"\\\\B2\\tC3\"}";
+
+static const char EXPECTED_STATUS[] =
+        "{\"timestamp\":60000,\"battery_level\":87.25,\"system_health\":true,\"uptime\":60000,"
+        "\"status_message\":\"OK: \\\"all\\\" up\\n\",\"memory\":{\"free_heap\":183244,"
+        "\"min_free_heap\":171020,\"largest_free_block\":110580,\"fragmentation_pct\":39,"
+        "\"psram_free\":2091000,\"min_stack_headroom\":612,\"window_heap_min\":176000,"
+        "\"window_heap_max\":185000,\"window_block_min\":108000,\"heap_trend\":[181000,180500,"
+        "179900]},\"boot\":{\"monitoring_ms\":412,\"complete_ms\":2380,\"failed\":1,"
+        "\"steps\":{\"imu\":[12,180],\"pressure\":[200,95],\"wifi\":[300,2080]}}}";
+
+static const char EXPECTED_BLE_STATUS[] =
+        "{\"type\":\"status\",\"sensors_initialized\":true,\"wifi_connected\":false,"
+        "\"bluetooth_connected\":true,\"battery_percentage\":87.25,\"current_status\":2,"
+        "\"uptime_ms\":60000,\"memory\":{\"free_heap\":183244,\"min_free_heap\":171020,"
+        "\"largest_free_block\":110580,\"fragmentation_pct\":39,\"psram_free\":2091000,"
+        "\"min_stack_headroom\":612,\"window_heap_min\":176000,\"window_heap_max\":185000,"
+        "\"window_block_min\":108000,\"heap_trend\":[181000,180500,179900]},"
+        "\"boot\":{\"monitoring_ms\":412,\"complete_ms\":2380,\"failed\":1,"
+        "\"steps\":{\"imu\":[12,180],\"pressure\":[200,95],\"wifi\":[300,2080]}}}";
+
+static void toSample(const SampleRow_t& row, SensorData_t& sample) {
+    memset(&sample, 0, sizeof(sample));
+    sample.timestamp = row.timestamp;
+    sample.accel_x = row.accel_x;
+    sample.accel_y = row.accel_y;
+    sample.accel_z = row.accel_z;
+    sample.gyro_x = row.gyro_x;
+    sample.gyro_y = row.gyro_y;
+    sample.gyro_z = row.gyro_z;
+    sample.pressure = row.pressure;
+    sample.heart_rate = row.heart_rate;
+    sample.fsr_value = row.fsr_value;
+    sample.valid = true;
+}
+
+static void buildEmergency(EmergencyData_t& data) {
+    memset(&data, 0, sizeof(data));
+    data.timestamp = 987654;
+    data.confidence = CONFIDENCE_HIGH;
+    data.confidence_score = 92;
+    data.history_count = sizeof(HISTORY_ROWS) / sizeof(HISTORY_ROWS[0]);
+    for (uint8_t i = 0; i < data.history_count; i++) {
+        toSample(HISTORY_ROWS[i], data.sensor_history[i]);
+    }
+    data.battery_level = 76.5f;
+    data.sos_triggered = false;
+    strncpy(data.device_id, "SF-\"A1\"\\B2\tC3", sizeof(data.device_id));
+}
+
+static void buildMemory(MemoryStats_t& memory) {
+    memset(&memory, 0, sizeof(memory));
+    memory.free_heap = 183244;
+    memory.min_free_heap = 171020;
+    memory.largest_free_block = 110580;
+    memory.fragmentation_pct = 39;
+    memory.psram_free = 2091000;
+    memory.min_stack_headroom = 612;
+    memory.window_heap_min = 176000;
+    memory.window_heap_max = 185000;
+    memory.window_block_min = 108000;
+    memory.heap_trend[0] = 181000;
+    memory.heap_trend[1] = 180500;
+    memory.heap_trend[2] = 179900;
+    memory.trend_count = 3;
+}
+
+static void buildBoot(BootStats_t& boot) {
+    memset(&boot, 0, sizeof(boot));
+    boot.monitoring_ms = 412;
+    boot.complete_ms = 2380;
+    boot.failed_steps = 1;
+    boot.steps[0] = {"imu", 12, 180, true};
+    boot.steps[1] = {"pressure", 200, 95, false};
+    boot.steps[2] = {"wifi", 300, 2080, true};
+    boot.step_count = 3;
+}
+
+// Checks
+
+static uint32_t failures = 0;
+
+// The hook must see both allocators, or zero below proves nothing
+static void checkHook() {
+    void* (*volatile c_alloc)(size_t) = malloc;
+
+    allocations = 0;
+    counting = true;
+    void* a = ::operator new(32);
+    void* b = c_alloc(32);
+    counting = false;
+    ::operator delete(a);
+    free(b);
+
+    bool ok = allocations == 2;
+    printf("%-16s %5s    %u allocations  %s\n", "hook", "", allocations, ok ? "ok" : "FAILED");
+    if (!ok) failures++;
+}
+
+// Writes one payload with allocations counted and compares it byte for byte
+template <typename T>
+static void check(const char* name, size_t (*write)(const T&, char*, size_t), const T& data,
+                  const char* expected) {
+    static char buffer[JSON_EMERGENCY_BUFFER_SIZE];
+
+    allocations = 0;
+    counting = true;
+    size_t length = write(data, buffer, sizeof(buffer));
+    counting = false;
+
+    bool match = length == strlen(expected) && strcmp(buffer, expected) == 0;
+    bool ok = match && allocations == 0;
+    printf("%-16s %5zu B  %u allocations  %s\n", name, length, allocations, ok ? "ok" : "FAILED");
+    if (!match) {
+        printf("  expected: %s\n  actual:   %s\n", expected, buffer);
+    }
+    if (!ok) failures++;
+}
+
+// A buffer one byte short must yield nothing, an exact one the whole payload
+static void checkOverflow(const SensorData_t& sample, const char* expected) {
+    char buffer[JSON_SENSOR_BUFFER_SIZE];
+    size_t needed = strlen(expected) + 1;
+
+    bool short_ok = writeSensorJSON(sample, buffer, needed - 1) == 0;
+
+    size_t exact_length = writeSensorJSON(sample, buffer, needed);
+    bool exact_ok = exact_length == needed - 1 && strcmp(buffer, expected) == 0;
+
+    JSON_Writer empty(nullptr, 0);
+    empty.beginObject();
+    bool null_ok = !empty.ok() && empty.size() == 0 && empty.c_str()[0] == '\0';
+
+    bool ok = short_ok && exact_ok && null_ok;
+    printf("%-16s %5zu B  short %s, exact %s, null %s  %s\n", "overflow", needed,
+           short_ok ? "ok" : "bad", exact_ok ? "ok" : "bad", null_ok ? "ok" : "bad",
+           ok ? "ok" : "FAILED");
+    if (!ok) failures++;
+}
+
+int main() {
+    static SensorData_t sample;
+    static EmergencyData_t emergency;
+    static StatusData_t status;
+    static SystemStatus_t system;
+
+    checkHook();
+
+    for (size_t i = 0; i < sizeof(EDGE_ROWS) / sizeof(EDGE_ROWS[0]); i++) {
+        char name[16];
+        snprintf(name, sizeof(name), "sensor[%zu]", i);
+        toSample(EDGE_ROWS[i], sample);
+        check(name, writeSensorJSON, sample, EXPECTED_SENSOR[i]);
+    }
+    check("ble sensor", writeBLESensorJSON, sample, EXPECTED_BLE_SENSOR);
+    checkOverflow(sample, EXPECTED_SENSOR[2]);
+
+    buildEmergency(emergency);
+    check("emergency", writeEmergencyJSON, emergency, EXPECTED_EMERGENCY);
+    check("ble emergency", writeBLEEmergencyJSON, emergency, EXPECTED_BLE_EMERGENCY);
+
+    memset(&status, 0, sizeof(status));
+    status.timestamp = 60000;
+    status.battery_level = 87.25f;
+    status.system_health = true;
+    status.uptime = 60000;
+    strncpy(status.status_message, "OK: \"all\" up\n", sizeof(status.status_message));
+    buildMemory(status.memory);
+    buildBoot(status.boot);
+    check("status", writeStatusJSON, status, EXPECTED_STATUS);
+
+    memset(&system, 0, sizeof(system));
+    system.sensors_initialized = true;
+    system.wifi_connected = false;
+    system.bluetooth_connected = true;
+    system.battery_percentage = 87.25f;
+    system.current_status = FALL_STATUS_STAGE2_IMPACT;
+    system.uptime_ms = 60000;
+    buildMemory(system.memory);
+    buildBoot(system.boot);
+    check("ble status", writeBLEStatusJSON, system, EXPECTED_BLE_STATUS);
+
+    printf(failures == 0 ? "ALL CHECKS PASSED\n" : "CHECKS FAILED\n");
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,102 @@
+#ifndef FILE_FLASH_H
+#define FILE_FLASH_H
+
+#include <vector>
+#include "storage/Flash_Storage.h"
+
+/*
+ * File-backed NOR flash emulator for the host tools.
+ *
+ * Behaves like the ESP32 SPI flash: erase sets a sector to 0xFF and a
+ * write can only clear bits (programming a 0 back to 1 is reported as an
+ * error). Erase counts are tracked per sector for wear checks, and a
+ * simple timing model (datasheet typicals) estimates device flash time.
+ */
+
+#define FLASH_SECTOR_SIZE        4096
+#define FLASH_PAGE_SIZE          256
+#define FLASH_ERASE_US_TYPICAL   45000   // 4 KB sector erase
+#define FLASH_PROGRAM_US_TYPICAL 700     // 256 B page program
+
+class File_Flash : public Flash_Storage {
+private:
+    FILE* file;
+    uint32_t size;
+    std::vector<uint32_t> erase_counts;
+    uint64_t modelled_us;
+    uint32_t write_violations;
+
+public:
+    File_Flash() : file(nullptr), size(0), modelled_us(0), write_violations(0) {}
+    ~File_Flash() { close(); }
+
+    // Opens (or creates, erased) an image of the given size
+    bool open(const char* path, uint32_t image_size) {
+        close();
+        size = image_size;
+        erase_counts.assign(size / FLASH_SECTOR_SIZE, 0);
+
+        file = fopen(path, "r+b");
+        if (file == nullptr) {
+            file = fopen(path, "w+b");
+            if (file == nullptr) return false;
+            std::vector<uint8_t> erased(FLASH_SECTOR_SIZE, 0xFF);
+            for (uint32_t i = 0; i < size / FLASH_SECTOR_SIZE; i++) {
+                fwrite(erased.data(), 1, erased.size(), file);
+            }
+            fflush(file);
+        }
+        return true;
+    }
+
+    void close() {
+        if (file != nullptr) {
+            fclose(file);
+            file = nullptr;
+        }
+    }
+
+    bool read(uint32_t offset, uint8_t* buffer, size_t length) override {
+        if (file == nullptr || offset + length > size) return false;
+        fseek(file, offset, SEEK_SET);
+        return fread(buffer, 1, length, file) == length;
+    }
+
+    bool write(uint32_t offset, const uint8_t* data, size_t length) override {
+        if (file == nullptr || offset + length > size) return false;
+
+        std::vector<uint8_t> current(length);
+        if (!read(offset, current.data(), length)) return false;
+
+        // NOR semantics: new = old & data; setting a cleared bit is an error
+        for (size_t i = 0; i < length; i++) {
+            if ((current[i] & data[i]) != data[i]) write_violations++;
+            current[i] &= data[i];
+        }
+
+        fseek(file, offset, SEEK_SET);
+        modelled_us += ((length + FLASH_PAGE_SIZE - 1) / FLASH_PAGE_SIZE) * FLASH_PROGRAM_US_TYPICAL;
+        return fwrite(current.data(), 1, length, file) == length;
+    }
+
+    bool eraseSector(uint32_t sector) override {
+        if (file == nullptr || sector >= erase_counts.size()) return false;
+
+        std::vector<uint8_t> erased(FLASH_SECTOR_SIZE, 0xFF);
+        fseek(file, sector * FLASH_SECTOR_SIZE, SEEK_SET);
+        erase_counts[sector]++;
+        modelled_us += FLASH_ERASE_US_TYPICAL;
+        return fwrite(erased.data(), 1, erased.size(), file) == erased.size();
+    }
+
+    uint32_t getSize() override { return size; }
+    uint32_t getSectorSize() override { return FLASH_SECTOR_SIZE; }
+
+    // Emulator statistics
+    const std::vector<uint32_t>& getEraseCounts() const { return erase_counts; }
+    uint64_t getModelledMicros() const { return modelled_us; }
+    uint32_t getWriteViolations() const { return write_violations; }
+    void resetModel() { modelled_us = 0; }
+};
+
+#endif // FILE_FLASH_H
@@ -0,0 +1,142 @@
+/*
+ * SmartFall - Sensor Log Decoder
+ *
+ * Converts a data logger capture into CSV. Accepts either a raw image of
+ * the spiffs partition:
+ *
+ *   esptool.py read_flash 0x290000 0x160000 log.bin
+ *
+ * or a Serial capture of BLE_CMD_DUMP_LOG. Blocks are found by magic and
+ * CRC at any byte offset, so text interleaved in a Serial capture and
+ * torn blocks are skipped. Output is ordered by block sequence.
+ *
+ * Build (from the repository root):
+ *   g++ -std=c++17 -O2 -Itools/host -ISmartFall -o log_decode \
+ *       tools/log_tool/log_decode.cpp SmartFall/storage/Sample_Codec.cpp
+ *
+ * Usage: log_decode <capture.bin> [out.csv]
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
+#include "storage/Sample_Codec.h"
+
+typedef struct {
+    uint32_t sequence;
+    size_t offset;
+} BlockRef_t;
+
+static const char* field_names[LOG_FIELD_COUNT] = {
+    "timestamp", "accel_x", "accel_y", "accel_z", "gyro_x", "gyro_y", "gyro_z",
+    "pressure", "heart_rate", "fsr_value"
+};
+
+static const uint8_t field_decimals[LOG_FIELD_COUNT] = {0, 3, 3, 3, 1, 1, 1, 3, 1, 0};
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <capture.bin> [out.csv]\n", argv[0]);
+        return 1;
+    }
+
+    FILE* in = fopen(argv[1], "rb");
+    if (in == nullptr) {
+        fprintf(stderr, "Cannot open %s\n", argv[1]);
+        return 1;
+    }
+
+    std::vector<uint8_t> data;
+    uint8_t chunk[65536];
+    size_t got;
+    while ((got = fread(chunk, 1, sizeof(chunk), in)) > 0) {
+        data.insert(data.end(), chunk, chunk + got);
+    }
+    fclose(in);
+
+    FILE* out = stdout;
+    if (argc >= 3) {
+        out = fopen(argv[2], "w");
+        if (out == nullptr) {
+            fprintf(stderr, "Cannot create %s\n", argv[2]);
+            return 1;
+        }
+    }
+
+    // Locate valid blocks
+    std::vector<BlockRef_t> blocks;
+    LogBlockHeader_t header;
+    size_t rejected = 0;
+    size_t offset = 0;
+    while (offset + LOG_BLOCK_SIZE <= data.size()) {
+        uint32_t magic;
+        memcpy(&magic, &data[offset], sizeof(magic));
+        if (magic != LOG_BLOCK_MAGIC) {
+            offset++;
+            continue;
+        }
+
+        if (validateBlock(&data[offset], header)) {
+            blocks.push_back({header.sequence, offset});
+            offset += LOG_BLOCK_SIZE;
+        } else {
+            rejected++;
+            offset++;
+        }
+    }
+
+    std::sort(blocks.begin(), blocks.end(),
+              [](const BlockRef_t& a, const BlockRef_t& b) { return a.sequence < b.sequence; });
+
+    // CSV
+    fprintf(out, "sequence");
+    for (uint8_t i = 0; i < LOG_FIELD_COUNT; i++) {
+        fprintf(out, ",%s", field_names[i]);
+    }
+    fprintf(out, "\n");
+
+    static LogSample_t samples[LOG_BLOCK_PAYLOAD_SIZE / LOG_FIELD_COUNT];
+    uint64_t total_samples = 0;
+    uint64_t payload_bytes = 0;
+    uint32_t gaps = 0;
+    uint32_t duplicates = 0;
+
+    for (size_t b = 0; b < blocks.size(); b++) {
+        if (b > 0 && blocks[b].sequence == blocks[b - 1].sequence) {
+            duplicates++;
+            continue;
+        }
+        if (b > 0 && blocks[b].sequence != blocks[b - 1].sequence + 1) {
+            gaps++;
+        }
+
+        const uint8_t* block = &data[blocks[b].offset];
+        readBlockHeader(block, header);
+        uint16_t count = decodeBlock(block, samples, sizeof(samples) / sizeof(samples[0]));
+        payload_bytes += header.payload_bytes;
+
+        for (uint16_t s = 0; s < count; s++) {
+            fprintf(out, "%u", blocks[b].sequence);
+            for (uint8_t i = 0; i < LOG_FIELD_COUNT; i++) {
+                if (i == LOG_FIELD_TIMESTAMP) {
+                    fprintf(out, ",%u", (uint32_t)samples[s].values[i]);
+                } else if (field_decimals[i] == 0) {
+                    fprintf(out, ",%d", samples[s].values[i]);
+                } else {
+                    fprintf(out, ",%.*f", field_decimals[i], logDequantize(i, samples[s].values[i]));
+                }
+            }
+            fprintf(out, "\n");
+        }
+        total_samples += count;
+    }
+
+    if (out != stdout) fclose(out);
+
+    fprintf(stderr, "Blocks: %zu valid, %zu rejected, %u sequence gaps, %u duplicates\n",
+            blocks.size(), rejected, gaps, duplicates);
+    fprintf(stderr, "Samples: %llu (%.2f bytes/sample)\n", (unsigned long long)total_samples,
+            total_samples ? (double)payload_bytes / total_samples : 0.0);
+    return 0;
+}